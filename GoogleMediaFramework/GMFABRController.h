@@ -0,0 +1,141 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFBandwidthEstimator.h"
+
+@class GMFABRController;
+
+// What the backend is told to do.
+typedef struct {
+  // Index of the chosen variant in the controller's bitrates, or NSNotFound without a ladder.
+  NSUInteger variantIndex;
+  // Highest bitrate the backend may pick, in bits per second. 0 leaves it unconstrained.
+  double peakBitrate;
+  // How far ahead of the playhead the backend should buffer. 0 leaves it to the backend.
+  NSTimeInterval forwardBufferDuration;
+} GMFABRDecision;
+
+extern const GMFABRDecision kGMFABRDecisionNone;
+
+// What a policy decides from.
+typedef struct {
+  // Throughput estimate in bits per second, and whether it comes from samples or is the
+  // estimator's default.
+  double estimatedBitrate;
+  BOOL hasEstimate;
+  // Seconds buffered ahead of the playhead, and the most that has been buffered since the stream
+  // started. A policy can tell startup from a drained buffer with the latter.
+  NSTimeInterval bufferLevel;
+  NSTimeInterval maximumBufferLevel;
+  // Playback stalled and hasn't recovered yet.
+  BOOL rebuffering;
+} GMFABRStatus;
+
+// Chooses a variant. |bitrates| is sorted in ascending order and may be empty, in which case the
+// policy can only cap the peak bitrate. Policies are stateless: anything they need to remember is
+// in |previousDecision|.
+@protocol GMFABRPolicy<NSObject>
+
+- (GMFABRDecision)decisionWithStatus:(const GMFABRStatus *)status
+                            bitrates:(const double *)bitrates
+                               count:(NSUInteger)count
+                    previousDecision:(GMFABRDecision)previousDecision;
+
+@end
+
+// Picks the highest variant that fits in a fraction of the throughput estimate.
+@interface GMFThroughputABRPolicy : NSObject<GMFABRPolicy>
+
+// Fraction of the estimate that may be used. Defaults to 0.8.
+@property(nonatomic, assign) double safetyFactor;
+
+// Passed on as the decision's forward buffer duration. Defaults to 0.
+@property(nonatomic, assign) NSTimeInterval forwardBufferDuration;
+
+@end
+
+// Buffer-based policy: the buffer level is mapped linearly onto the bitrate ladder, from the
+// lowest variant at |reservoir| seconds to the highest at |reservoir| + |cushion|. A variant is
+// only left once the mapped rate passes the next variant up or falls below the next one down, so
+// small buffer changes don't cause switches. During startup, until the buffer has first reached
+// the reservoir, the buffer says nothing yet and the throughput estimate is used instead. After a
+// stall the lowest variant is used until the stream recovers.
+@interface GMFBufferABRPolicy : NSObject<GMFABRPolicy>
+
+// Default to 8 and 22 seconds.
+@property(nonatomic, assign) NSTimeInterval reservoir;
+@property(nonatomic, assign) NSTimeInterval cushion;
+
+// Fraction of the throughput estimate used during startup and without a ladder. Defaults to 0.8.
+@property(nonatomic, assign) double safetyFactor;
+
+@end
+
+@protocol GMFABRControllerDelegate<NSObject>
+
+// Called when the decision changes. Apply it to the backend.
+- (void)abrController:(GMFABRController *)controller didChangeDecision:(GMFABRDecision)decision;
+
+@end
+
+// Adaptive bitrate controller. Feed it transfers and buffer telemetry; it keeps a throughput
+// estimate and asks |policy| for a new decision whenever either changes, telling the delegate
+// when the decision differs. Main thread only.
+@interface GMFABRController : NSObject
+
+@property(nonatomic, weak) id<GMFABRControllerDelegate> delegate;
+
+// Defaults to a GMFBufferABRPolicy.
+@property(nonatomic, strong) id<GMFABRPolicy> policy;
+
+@property(nonatomic, readonly) GMFBandwidthEstimator *estimator;
+
+@property(nonatomic, readonly) GMFABRDecision currentDecision;
+
+@property(nonatomic, readonly) NSTimeInterval bufferLevel;
+
+// Changes of variant, or of peak bitrate without a ladder, since the session started.
+@property(nonatomic, readonly) NSUInteger switchCount;
+
+- (instancetype)init;
+
+- (instancetype)initWithPolicy:(id<GMFABRPolicy>)policy estimator:(GMFBandwidthEstimator *)estimator;
+
+// Variant bitrates of the stream in bits per second, in any order.
+- (void)setBitrates:(const double *)bitrates count:(NSUInteger)count;
+
+- (NSUInteger)bitrateCount;
+- (double)bitrateAtIndex:(NSUInteger)index;
+
+// Bitrate of the current decision's variant, or its peak bitrate without a ladder.
+- (double)currentBitrate;
+
+- (double)estimatedBitrate;
+
+- (void)addTransferWithBytes:(uint64_t)bytes duration:(NSTimeInterval)duration;
+
+- (void)updateBufferLevel:(NSTimeInterval)bufferLevel;
+
+- (void)setRebuffering:(BOOL)rebuffering;
+
+// Asks the policy again and notifies the delegate if the decision changed.
+- (void)updateDecision;
+
+// Starts over for a new stream: forgets the ladder, buffer and decision. The throughput estimate
+// is kept, since the network usually outlives the stream.
+- (void)resetSession;
+
+@end
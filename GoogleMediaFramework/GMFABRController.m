@@ -0,0 +1,297 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFABRController.h"
+
+const GMFABRDecision kGMFABRDecisionNone = { NSNotFound, 0, 0 };
+
+// Without a ladder the peak bitrate follows the estimate continuously; changes smaller than this
+// fraction aren't worth reconfiguring the backend for.
+static const double kGMFABRPeakBitrateTolerance = 0.1;
+
+// Highest index whose bitrate is at most |limit|, or 0 if none is.
+static NSUInteger GMFHighestBitrateIndexAtOrBelow(const double *bitrates,
+                                                  NSUInteger count,
+                                                  double limit) {
+  NSUInteger index = 0;
+  while (index + 1 < count && bitrates[index + 1] <= limit) {
+    index++;
+  }
+  return index;
+}
+
+// Lowest index whose bitrate is at least |limit|, or the highest index if none is.
+static NSUInteger GMFLowestBitrateIndexAtOrAbove(const double *bitrates,
+                                                 NSUInteger count,
+                                                 double limit) {
+  NSUInteger index = 0;
+  while (index + 1 < count && bitrates[index] < limit) {
+    index++;
+  }
+  return index;
+}
+
+static int GMFCompareBitrates(const void *a, const void *b) {
+  double lhs = *(const double *)a;
+  double rhs = *(const double *)b;
+  return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+}
+
+#pragma mark -
+#pragma mark GMFThroughputABRPolicy
+
+@implementation GMFThroughputABRPolicy
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _safetyFactor = 0.8;
+  }
+  return self;
+}
+
+- (GMFABRDecision)decisionWithStatus:(const GMFABRStatus *)status
+                            bitrates:(const double *)bitrates
+                               count:(NSUInteger)count
+                    previousDecision:(GMFABRDecision)previousDecision {
+  GMFABRDecision decision = kGMFABRDecisionNone;
+  decision.forwardBufferDuration = _forwardBufferDuration;
+  double usableBitrate = status->estimatedBitrate * _safetyFactor;
+  if (!count) {
+    decision.peakBitrate = usableBitrate;
+    return decision;
+  }
+  decision.variantIndex = GMFHighestBitrateIndexAtOrBelow(bitrates, count, usableBitrate);
+  decision.peakBitrate = bitrates[decision.variantIndex];
+  return decision;
+}
+
+@end
+
+#pragma mark GMFBufferABRPolicy
+
+@implementation GMFBufferABRPolicy
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _reservoir = 8;
+    _cushion = 22;
+    _safetyFactor = 0.8;
+  }
+  return self;
+}
+
+- (GMFABRDecision)decisionWithStatus:(const GMFABRStatus *)status
+                            bitrates:(const double *)bitrates
+                               count:(NSUInteger)count
+                    previousDecision:(GMFABRDecision)previousDecision {
+  GMFABRDecision decision = kGMFABRDecisionNone;
+  decision.forwardBufferDuration = _reservoir + _cushion;
+  double usableBitrate = status->estimatedBitrate * _safetyFactor;
+  if (!count) {
+    decision.peakBitrate = usableBitrate;
+    return decision;
+  }
+
+  NSUInteger index = 0;
+  if (!status->rebuffering) {
+    index = [self bufferIndexWithLevel:status->bufferLevel
+                              bitrates:bitrates
+                                 count:count
+                         previousIndex:previousDecision.variantIndex];
+    // Until the buffer has filled once, it lags behind what the network can do.
+    if (status->maximumBufferLevel < _reservoir + _cushion) {
+      index = MAX(index, GMFHighestBitrateIndexAtOrBelow(bitrates, count, usableBitrate));
+    }
+  }
+  decision.variantIndex = index;
+  decision.peakBitrate = bitrates[index];
+  return decision;
+}
+
+#pragma mark Private Methods
+
+- (NSUInteger)bufferIndexWithLevel:(NSTimeInterval)bufferLevel
+                          bitrates:(const double *)bitrates
+                             count:(NSUInteger)count
+                     previousIndex:(NSUInteger)previousIndex {
+  if (bufferLevel <= _reservoir) {
+    return 0;
+  }
+  if (bufferLevel >= _reservoir + _cushion) {
+    return count - 1;
+  }
+  double mappedBitrate = bitrates[0] + (bitrates[count - 1] - bitrates[0]) *
+                                           (bufferLevel - _reservoir) / _cushion;
+  NSUInteger index = previousIndex < count ? previousIndex : 0;
+  if (index + 1 < count && mappedBitrate >= bitrates[index + 1]) {
+    return GMFHighestBitrateIndexAtOrBelow(bitrates, count, mappedBitrate);
+  }
+  if (index > 0 && mappedBitrate <= bitrates[index - 1]) {
+    return GMFLowestBitrateIndexAtOrAbove(bitrates, count, mappedBitrate);
+  }
+  return index;
+}
+
+@end
+
+#pragma mark GMFABRController
+
+@implementation GMFABRController {
+  double *_bitrates;
+  NSUInteger _bitrateCount;
+  NSTimeInterval _maximumBufferLevel;
+  BOOL _rebuffering;
+  BOOL _hasDecision;
+}
+
+- (instancetype)init {
+  return [self initWithPolicy:[[GMFBufferABRPolicy alloc] init]
+                    estimator:[[GMFBandwidthEstimator alloc] init]];
+}
+
+- (instancetype)initWithPolicy:(id<GMFABRPolicy>)policy estimator:(GMFBandwidthEstimator *)estimator {
+  self = [super init];
+  if (self) {
+    _policy = policy;
+    _estimator = estimator;
+    _currentDecision = kGMFABRDecisionNone;
+  }
+  return self;
+}
+
+- (void)dealloc {
+  free(_bitrates);
+}
+
+- (void)setPolicy:(id<GMFABRPolicy>)policy {
+  _policy = policy;
+  [self updateDecision];
+}
+
+- (void)setBitrates:(const double *)bitrates count:(NSUInteger)count {
+  free(_bitrates);
+  _bitrates = malloc(MAX(count, 1) * sizeof(double));
+  _bitrateCount = 0;
+  for (NSUInteger i = 0; i < count; i++) {
+    if (bitrates[i] > 0) {
+      _bitrates[_bitrateCount++] = bitrates[i];
+    }
+  }
+  qsort(_bitrates, _bitrateCount, sizeof(double), GMFCompareBitrates);
+  // Indexes into the previous ladder mean nothing now.
+  _currentDecision = kGMFABRDecisionNone;
+  _hasDecision = NO;
+  [self updateDecision];
+}
+
+- (NSUInteger)bitrateCount {
+  return _bitrateCount;
+}
+
+- (double)bitrateAtIndex:(NSUInteger)index {
+  NSAssert(index < _bitrateCount, @"Bitrate index out of bounds");
+  return _bitrates[index];
+}
+
+- (double)currentBitrate {
+  if (_currentDecision.variantIndex < _bitrateCount) {
+    return _bitrates[_currentDecision.variantIndex];
+  }
+  return _currentDecision.peakBitrate;
+}
+
+- (double)estimatedBitrate {
+  return [_estimator estimatedBitrate];
+}
+
+- (void)addTransferWithBytes:(uint64_t)bytes duration:(NSTimeInterval)duration {
+  if ([_estimator addSampleWithBytes:bytes duration:duration]) {
+    [self updateDecision];
+  }
+}
+
+- (void)updateBufferLevel:(NSTimeInterval)bufferLevel {
+  _bufferLevel = MAX(bufferLevel, 0);
+  _maximumBufferLevel = MAX(_maximumBufferLevel, _bufferLevel);
+  [self updateDecision];
+}
+
+- (void)setRebuffering:(BOOL)rebuffering {
+  if (rebuffering != _rebuffering) {
+    _rebuffering = rebuffering;
+    [self updateDecision];
+  }
+}
+
+- (void)updateDecision {
+  if (!_policy) {
+    return;
+  }
+  GMFABRStatus status;
+  status.estimatedBitrate = [_estimator estimatedBitrate];
+  status.hasEstimate = [_estimator hasEstimate];
+  status.bufferLevel = _bufferLevel;
+  status.maximumBufferLevel = _maximumBufferLevel;
+  status.rebuffering = _rebuffering;
+  GMFABRDecision decision = [_policy decisionWithStatus:&status
+                                               bitrates:_bitrates
+                                                  count:_bitrateCount
+                                       previousDecision:_currentDecision];
+  if (_hasDecision && [self isDecisionEquivalentToCurrent:decision]) {
+    return;
+  }
+  if (_hasDecision && (decision.variantIndex != _currentDecision.variantIndex ||
+                       decision.peakBitrate != _currentDecision.peakBitrate)) {
+    _switchCount++;
+  }
+  _hasDecision = YES;
+  _currentDecision = decision;
+  [_delegate abrController:self didChangeDecision:decision];
+}
+
+- (void)resetSession {
+  free(_bitrates);
+  _bitrates = NULL;
+  _bitrateCount = 0;
+  _bufferLevel = 0;
+  _maximumBufferLevel = 0;
+  _rebuffering = NO;
+  _switchCount = 0;
+  _hasDecision = NO;
+  _currentDecision = kGMFABRDecisionNone;
+  [self updateDecision];
+}
+
+#pragma mark Private Methods
+
+- (BOOL)isDecisionEquivalentToCurrent:(GMFABRDecision)decision {
+  if (decision.variantIndex != _currentDecision.variantIndex ||
+      decision.forwardBufferDuration != _currentDecision.forwardBufferDuration) {
+    return NO;
+  }
+  if (decision.variantIndex != NSNotFound) {
+    return YES;
+  }
+  double difference = fabs(decision.peakBitrate - _currentDecision.peakBitrate);
+  return difference <= kGMFABRPeakBitrateTolerance *
+                           MAX(decision.peakBitrate, _currentDecision.peakBitrate);
+}
+
+@end
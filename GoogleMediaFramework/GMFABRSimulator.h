@@ -0,0 +1,85 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFABRController.h"
+
+// Recorded network throughput: consecutive periods of constant bandwidth. Replays loop back to
+// the start when they run past the end.
+@interface GMFBandwidthTrace : NSObject
+
+// Parses one period per line, "<duration in seconds> <bandwidth in kbps>", separated by
+// whitespace. Blank lines and lines starting with # are skipped. Returns nil if a line is
+// malformed or there are no periods.
++ (instancetype)traceWithString:(NSString *)string;
+
+// |bitrates| are in bits per second.
+- (instancetype)initWithDurations:(const NSTimeInterval *)durations
+                         bitrates:(const double *)bitrates
+                            count:(NSUInteger)count;
+
+- (NSUInteger)count;
+
+- (NSTimeInterval)totalDuration;
+
+// Bandwidth in bits per second at |time|.
+- (double)bitrateAtTime:(NSTimeInterval)time;
+
+// How long it takes to transfer |bits| starting at |time|. INFINITY if the trace has no bandwidth
+// at all.
+- (NSTimeInterval)transferDurationForBits:(double)bits startingAtTime:(NSTimeInterval)time;
+
+@end
+
+typedef struct {
+  // Time from the first request until playback started.
+  NSTimeInterval startupDelay;
+  // Time spent stalled after playback started, and how many times it stalled.
+  NSTimeInterval rebufferDuration;
+  NSUInteger rebufferCount;
+  // |rebufferDuration| over the time from playback start until the end of the content.
+  double rebufferRatio;
+  // Bitrate of the downloaded segments, averaged over content time, in bits per second.
+  double averageBitrate;
+  NSUInteger switchCount;
+} GMFABRSimulationResult;
+
+// Plays a stream segment by segment against a bandwidth trace without any media stack or real
+// time, driving a GMFABRController with the same telemetry the player gives it: one transfer per
+// segment and the buffer level after each one. Results are deterministic, so policies can be
+// compared on recorded traces in unit tests.
+@interface GMFABRSimulator : NSObject
+
+// Defaults to 4 seconds.
+@property(nonatomic, assign) NSTimeInterval segmentDuration;
+
+// Defaults to 10 minutes.
+@property(nonatomic, assign) NSTimeInterval contentDuration;
+
+// Buffer needed before playback starts, and resumes after a stall. Defaults to 2 seconds.
+@property(nonatomic, assign) NSTimeInterval playbackStartBuffer;
+
+// Round trip added to every segment request. Defaults to 0.1 seconds.
+@property(nonatomic, assign) NSTimeInterval requestLatency;
+
+// Forward buffer target used when a decision leaves it to the backend. Defaults to 30 seconds.
+@property(nonatomic, assign) NSTimeInterval defaultForwardBufferDuration;
+
+// |bitrates| are the variant bitrates of the simulated stream, in bits per second.
+- (instancetype)initWithBitrates:(const double *)bitrates count:(NSUInteger)count;
+
+- (GMFABRSimulationResult)runWithTrace:(GMFBandwidthTrace *)trace policy:(id<GMFABRPolicy>)policy;
+
+@end
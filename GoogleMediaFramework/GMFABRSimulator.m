@@ -0,0 +1,278 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFABRSimulator.h"
+
+#pragma mark GMFBandwidthTrace
+
+@implementation GMFBandwidthTrace {
+  NSTimeInterval *_durations;
+  double *_bitrates;
+  // Start of each period, so lookups are binary searches.
+  NSTimeInterval *_startTimes;
+  NSUInteger _count;
+  NSTimeInterval _totalDuration;
+  double _totalBits;
+}
+
++ (instancetype)traceWithString:(NSString *)string {
+  NSMutableData *durations = [NSMutableData data];
+  NSMutableData *bitrates = [NSMutableData data];
+  NSCharacterSet *whitespace = [NSCharacterSet whitespaceCharacterSet];
+  for (NSString *rawLine in [string componentsSeparatedByCharactersInSet:
+                                        [NSCharacterSet newlineCharacterSet]]) {
+    NSString *line = [rawLine stringByTrimmingCharactersInSet:whitespace];
+    if (![line length] || [line hasPrefix:@"#"]) {
+      continue;
+    }
+    NSScanner *scanner = [NSScanner scannerWithString:line];
+    double duration = 0;
+    double kilobits = 0;
+    if (![scanner scanDouble:&duration] || ![scanner scanDouble:&kilobits] ||
+        ![scanner isAtEnd] || !(duration > 0) || kilobits < 0) {
+      return nil;
+    }
+    double bitrate = kilobits * 1000;
+    [durations appendBytes:&duration length:sizeof(duration)];
+    [bitrates appendBytes:&bitrate length:sizeof(bitrate)];
+  }
+  NSUInteger count = [durations length] / sizeof(NSTimeInterval);
+  if (!count) {
+    return nil;
+  }
+  return [[self alloc] initWithDurations:[durations bytes] bitrates:[bitrates bytes] count:count];
+}
+
+- (instancetype)initWithDurations:(const NSTimeInterval *)durations
+                         bitrates:(const double *)bitrates
+                            count:(NSUInteger)count {
+  self = [super init];
+  if (self) {
+    _count = count;
+    _durations = malloc(MAX(count, 1) * sizeof(NSTimeInterval));
+    _bitrates = malloc(MAX(count, 1) * sizeof(double));
+    _startTimes = malloc(MAX(count, 1) * sizeof(NSTimeInterval));
+    for (NSUInteger i = 0; i < count; i++) {
+      _durations[i] = MAX(durations[i], 0);
+      _bitrates[i] = MAX(bitrates[i], 0);
+      _startTimes[i] = _totalDuration;
+      _totalDuration += _durations[i];
+      _totalBits += _durations[i] * _bitrates[i];
+    }
+  }
+  return self;
+}
+
+- (void)dealloc {
+  free(_durations);
+  free(_bitrates);
+  free(_startTimes);
+}
+
+- (NSUInteger)count {
+  return _count;
+}
+
+- (NSTimeInterval)totalDuration {
+  return _totalDuration;
+}
+
+- (double)bitrateAtTime:(NSTimeInterval)time {
+  if (!(_totalDuration > 0)) {
+    return 0;
+  }
+  NSTimeInterval offset = 0;
+  return _bitrates[[self periodIndexForTime:time offset:&offset]];
+}
+
+- (NSTimeInterval)transferDurationForBits:(double)bits startingAtTime:(NSTimeInterval)time {
+  if (!(bits > 0)) {
+    return 0;
+  }
+  if (!(_totalBits > 0)) {
+    return INFINITY;
+  }
+  NSTimeInterval elapsed = 0;
+  // Whole passes over the trace first, so huge transfers don't walk it period by period.
+  double loops = floor(bits / _totalBits);
+  if (loops >= 1) {
+    // Keep a remainder so the walk below ends inside a period.
+    loops -= 1;
+    elapsed += loops * _totalDuration;
+    bits -= loops * _totalBits;
+  }
+  NSTimeInterval offset = 0;
+  NSUInteger index = [self periodIndexForTime:time offset:&offset];
+  while (YES) {
+    NSTimeInterval remainingDuration = _durations[index] - offset;
+    double available = remainingDuration * _bitrates[index];
+    if (available >= bits) {
+      return elapsed + bits / _bitrates[index];
+    }
+    bits -= available;
+    elapsed += remainingDuration;
+    offset = 0;
+    index = (index + 1) % _count;
+  }
+}
+
+#pragma mark Private Methods
+
+// Index of the period playing at |time|, wrapped into the trace, and how far into it |time| is.
+- (NSUInteger)periodIndexForTime:(NSTimeInterval)time offset:(NSTimeInterval *)offset {
+  NSTimeInterval wrapped = fmod(time, _totalDuration);
+  if (wrapped < 0) {
+    wrapped += _totalDuration;
+  }
+  // Last period starting at or before |wrapped|.
+  NSUInteger low = 0;
+  NSUInteger high = _count;
+  while (low + 1 < high) {
+    NSUInteger mid = low + (high - low) / 2;
+    if (_startTimes[mid] <= wrapped) {
+      low = mid;
+    } else {
+      high = mid;
+    }
+  }
+  *offset = MIN(wrapped - _startTimes[low], _durations[low]);
+  return low;
+}
+
+@end
+
+#pragma mark GMFABRSimulator
+
+@implementation GMFABRSimulator {
+  double *_bitrates;
+  NSUInteger _bitrateCount;
+}
+
+- (instancetype)initWithBitrates:(const double *)bitrates count:(NSUInteger)count {
+  self = [super init];
+  if (self) {
+    _segmentDuration = 4;
+    _contentDuration = 600;
+    _playbackStartBuffer = 2;
+    _requestLatency = 0.1;
+    _defaultForwardBufferDuration = 30;
+    _bitrates = malloc(MAX(count, 1) * sizeof(double));
+    memcpy(_bitrates, bitrates, count * sizeof(double));
+    _bitrateCount = count;
+  }
+  return self;
+}
+
+- (void)dealloc {
+  free(_bitrates);
+}
+
+- (GMFABRSimulationResult)runWithTrace:(GMFBandwidthTrace *)trace policy:(id<GMFABRPolicy>)policy {
+  GMFABRController *controller =
+      [[GMFABRController alloc] initWithPolicy:policy estimator:[[GMFBandwidthEstimator alloc] init]];
+  [controller setBitrates:_bitrates count:_bitrateCount];
+
+  GMFABRSimulationResult result;
+  memset(&result, 0, sizeof(result));
+  NSTimeInterval time = 0;
+  NSTimeInterval buffer = 0;
+  NSTimeInterval downloaded = 0;
+  double bitsDownloaded = 0;
+  BOOL playing = NO;
+  BOOL stalled = NO;
+
+  while (downloaded < _contentDuration) {
+    NSTimeInterval segmentLength = MIN(_segmentDuration, _contentDuration - downloaded);
+    GMFABRDecision decision = [controller currentDecision];
+    NSTimeInterval forwardBuffer = decision.forwardBufferDuration > 0 ?
+        decision.forwardBufferDuration : _defaultForwardBufferDuration;
+    if (playing && !stalled && buffer + segmentLength > forwardBuffer) {
+      // The buffer is full; play until there is room for the next segment.
+      NSTimeInterval wait = MIN(buffer + segmentLength - forwardBuffer, buffer);
+      time += wait;
+      buffer -= wait;
+      [controller updateBufferLevel:buffer];
+      decision = [controller currentDecision];
+    }
+
+    double bitrate = [self bitrateForDecision:decision controller:controller];
+    double bits = bitrate * segmentLength;
+    NSTimeInterval transferDuration =
+        _requestLatency + [trace transferDurationForBits:bits startingAtTime:time + _requestLatency];
+    if (isinf(transferDuration)) {
+      // Nothing will ever arrive; the result only covers what was played.
+      break;
+    }
+
+    if (!playing) {
+      result.startupDelay += transferDuration;
+    } else if (stalled) {
+      result.rebufferDuration += transferDuration;
+    } else if (transferDuration > buffer) {
+      stalled = YES;
+      result.rebufferCount++;
+      result.rebufferDuration += transferDuration - buffer;
+      buffer = 0;
+      [controller setRebuffering:YES];
+    } else {
+      buffer -= transferDuration;
+    }
+    time += transferDuration;
+    buffer += segmentLength;
+    downloaded += segmentLength;
+    bitsDownloaded += bits;
+    [controller addTransferWithBytes:(uint64_t)(bits / 8) duration:transferDuration];
+
+    if (buffer >= _playbackStartBuffer || downloaded >= _contentDuration) {
+      playing = YES;
+      if (stalled) {
+        stalled = NO;
+        [controller setRebuffering:NO];
+      }
+    }
+    [controller updateBufferLevel:buffer];
+  }
+
+  if (downloaded > 0) {
+    result.averageBitrate = bitsDownloaded / downloaded;
+    result.rebufferRatio = result.rebufferDuration / (downloaded + result.rebufferDuration);
+  }
+  result.switchCount = [controller switchCount];
+  return result;
+}
+
+#pragma mark Private Methods
+
+- (double)bitrateForDecision:(GMFABRDecision)decision controller:(GMFABRController *)controller {
+  NSUInteger count = [controller bitrateCount];
+  if (!count) {
+    return decision.peakBitrate;
+  }
+  if (decision.variantIndex < count) {
+    return [controller bitrateAtIndex:decision.variantIndex];
+  }
+  // A peak bitrate only: the backend picks the highest variant under it, or the lowest.
+  NSUInteger index = 0;
+  while (index + 1 < count &&
+         (decision.peakBitrate <= 0 || [controller bitrateAtIndex:index + 1] <= decision.peakBitrate)) {
+    index++;
+  }
+  return [controller bitrateAtIndex:index];
+}
+
+@end
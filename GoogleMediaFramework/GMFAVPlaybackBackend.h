@@ -0,0 +1,32 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <AVFoundation/AVFoundation.h>
+
+#import "GMFPlaybackBackend.h"
+
+// The production backend: |playerItem| as played by |player|. Observes the item's status and
+// buffer, the player's rate and the item's stall and end notifications, and stops observing when
+// released. GMFVideoPlayer makes one whenever its item or player changes.
+@interface GMFAVPlaybackBackend : NSObject<GMFPlaybackBackend>
+
+@property(nonatomic, weak) id<GMFPlaybackBackendDelegate> delegate;
+
+@property(nonatomic, readonly) AVPlayer *player;
+
+@property(nonatomic, readonly) AVPlayerItem *playerItem;
+
+- (instancetype)initWithPlayer:(AVPlayer *)player playerItem:(AVPlayerItem *)playerItem;
+
+@end
@@ -0,0 +1,238 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFAVPlaybackBackend.h"
+#import "GMFTrace.h"
+
+static void *kGMFBackendItemStatusContext = &kGMFBackendItemStatusContext;
+static void *kGMFBackendItemBufferContext = &kGMFBackendItemBufferContext;
+static void *kGMFBackendRateContext = &kGMFBackendRateContext;
+
+static NSString * const kStatusKey = @"status";
+static NSString * const kPlaybackBufferEmptyKey = @"playbackBufferEmpty";
+static NSString * const kPlaybackLikelyToKeepUpKey = @"playbackLikelyToKeepUp";
+static NSString * const kRateKey = @"rate";
+
+// Trace span name for a KVO callback with |context|.
+static const char *GMFTraceNameForBackendKVOContext(void *context) {
+  if (context == kGMFBackendItemStatusContext) {
+    return "kvo.status";
+  } else if (context == kGMFBackendItemBufferContext) {
+    return "kvo.buffer";
+  } else if (context == kGMFBackendRateContext) {
+    return "kvo.rate";
+  }
+  return "kvo.other";
+}
+
+static NSTimeInterval GMFSecondsWithCMTime(CMTime time) {
+  return CMTIME_IS_NUMERIC(time) ? CMTimeGetSeconds(time) : 0;
+}
+
+@implementation GMFAVPlaybackBackend {
+  // Observer tokens of the stall, end and failure notifications, which are delivered on the main
+  // queue.
+  id _stallObserver;
+  id _endObserver;
+  id _failureObserver;
+  // The item stopped short of its end, e.g. when its server went away mid-stream. Its status
+  // doesn't always change when that happens.
+  BOOL _failedToPlayToEnd;
+  float _playbackRate;
+}
+
+- (instancetype)initWithPlayer:(AVPlayer *)player playerItem:(AVPlayerItem *)playerItem {
+  self = [super init];
+  if (self) {
+    _player = player;
+    _playerItem = playerItem;
+    _playbackRate = 1;
+    [_playerItem addObserver:self
+                  forKeyPath:kStatusKey
+                     options:0
+                     context:kGMFBackendItemStatusContext];
+    // Stalls and resumes are observed directly instead of being inferred from a media time
+    // poller, so they are reported as soon as AVFoundation notices them.
+    [_playerItem addObserver:self
+                  forKeyPath:kPlaybackBufferEmptyKey
+                     options:0
+                     context:kGMFBackendItemBufferContext];
+    [_playerItem addObserver:self
+                  forKeyPath:kPlaybackLikelyToKeepUpKey
+                     options:0
+                     context:kGMFBackendItemBufferContext];
+    [_player addObserver:self
+              forKeyPath:kRateKey
+                 options:0
+                 context:kGMFBackendRateContext];
+    __weak GMFAVPlaybackBackend *weakSelf = self;
+    // AVFoundation may post the stall notification on a background thread.
+    _stallObserver = [[NSNotificationCenter defaultCenter]
+        addObserverForName:AVPlayerItemPlaybackStalledNotification
+                    object:_playerItem
+                     queue:[NSOperationQueue mainQueue]
+                usingBlock:^(NSNotification *note) {
+                    GMFAVPlaybackBackend *strongSelf = weakSelf;
+                    [[strongSelf delegate] playbackBackendDidStall:strongSelf];
+                }];
+    _endObserver = [[NSNotificationCenter defaultCenter]
+        addObserverForName:AVPlayerItemDidPlayToEndTimeNotification
+                    object:_playerItem
+                     queue:[NSOperationQueue mainQueue]
+                usingBlock:^(NSNotification *note) {
+                    GMFAVPlaybackBackend *strongSelf = weakSelf;
+                    [[strongSelf delegate] playbackBackendDidPlayToEnd:strongSelf];
+                }];
+    _failureObserver = [[NSNotificationCenter defaultCenter]
+        addObserverForName:AVPlayerItemFailedToPlayToEndTimeNotification
+                    object:_playerItem
+                     queue:[NSOperationQueue mainQueue]
+                usingBlock:^(NSNotification *note) {
+                    GMFAVPlaybackBackend *strongSelf = weakSelf;
+                    [strongSelf playerItemFailedToPlayToEnd];
+                }];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [_playerItem removeObserver:self forKeyPath:kStatusKey];
+  [_playerItem removeObserver:self forKeyPath:kPlaybackBufferEmptyKey];
+  [_playerItem removeObserver:self forKeyPath:kPlaybackLikelyToKeepUpKey];
+  [_player removeObserver:self forKeyPath:kRateKey];
+  [[NSNotificationCenter defaultCenter] removeObserver:_stallObserver];
+  [[NSNotificationCenter defaultCenter] removeObserver:_endObserver];
+  [[NSNotificationCenter defaultCenter] removeObserver:_failureObserver];
+}
+
+- (GMFPlaybackBackendStatus)status {
+  if (_failedToPlayToEnd) {
+    return kGMFPlaybackBackendStatusFailed;
+  }
+  switch ([_playerItem status]) {
+    case AVPlayerItemStatusReadyToPlay:
+      return kGMFPlaybackBackendStatusReadyToPlay;
+    case AVPlayerItemStatusFailed:
+      return kGMFPlaybackBackendStatusFailed;
+    default:
+      return kGMFPlaybackBackendStatusUnknown;
+  }
+}
+
+- (float)rate {
+  return [_player rate];
+}
+
+- (void)setPlaybackRate:(float)playbackRate {
+  if (playbackRate == _playbackRate) {
+    return;
+  }
+  _playbackRate = playbackRate;
+  // The default algorithm only plays a few fixed rates, such as 0.5 and 1.25; the time domain one
+  // takes any rate, which small live latency corrections need.
+  if (playbackRate != 1 &&
+      [_playerItem respondsToSelector:@selector(setAudioTimePitchAlgorithm:)]) {
+    [_playerItem setAudioTimePitchAlgorithm:AVAudioTimePitchAlgorithmTimeDomain];
+  }
+  if ([_player rate] > 0) {
+    [_player setRate:playbackRate];
+  }
+}
+
+- (void)play {
+  if (_playbackRate == 1) {
+    [_player play];
+  } else {
+    [_player setRate:_playbackRate];
+  }
+}
+
+- (void)pause {
+  [_player pause];
+}
+
+- (BOOL)isPlaybackBufferEmpty {
+  return [_playerItem isPlaybackBufferEmpty];
+}
+
+- (BOOL)isPlaybackLikelyToKeepUp {
+  return [_playerItem isPlaybackLikelyToKeepUp];
+}
+
+- (NSTimeInterval)currentTime {
+  return GMFSecondsWithCMTime([_playerItem currentTime]);
+}
+
+- (NSTimeInterval)duration {
+  // |_playerItem| duration is indefinite if the video is a live stream.
+  return GMFSecondsWithCMTime([_playerItem duration]);
+}
+
+- (GMFTimeRange)seekableTimeRange {
+  // Live streams have a single range, the sliding window.
+  NSValue *lastRange = [[_playerItem seekableTimeRanges] lastObject];
+  if (!lastRange) {
+    return GMFTimeRangeMake(0, 0);
+  }
+  CMTimeRange range = [lastRange CMTimeRangeValue];
+  return GMFTimeRangeMake(GMFSecondsWithCMTime(range.start),
+                          GMFSecondsWithCMTime(CMTimeRangeGetEnd(range)));
+}
+
+- (void)seekToTime:(NSTimeInterval)time
+            tolerance:(NSTimeInterval)tolerance
+    completionHandler:(void (^)(BOOL finished))completionHandler {
+  // Nanosecond timescale, so the target isn't rounded to whole seconds.
+  CMTime toleranceTime = isinf(tolerance) ? kCMTimePositiveInfinity
+                                          : CMTimeMakeWithSeconds(tolerance, NSEC_PER_SEC);
+  [_playerItem seekToTime:CMTimeMakeWithSeconds(time, NSEC_PER_SEC)
+          toleranceBefore:toleranceTime
+           toleranceAfter:toleranceTime
+        completionHandler:completionHandler];
+}
+
+- (void)observeValueForKeyPath:(NSString *)keyPath
+                      ofObject:(id)object
+                        change:(NSDictionary *)change
+                       context:(void *)context {
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_INFO, GMFTraceNameForBackendKVOContext(context));
+  if (context == kGMFBackendItemStatusContext) {
+    [_delegate playbackBackendStatusDidChange:self];
+  } else if (context == kGMFBackendItemBufferContext) {
+    [_delegate playbackBackendBufferStatusDidChange:self];
+  } else if (context == kGMFBackendRateContext) {
+    [_delegate playbackBackendRateDidChange:self];
+  } else {
+    [super observeValueForKeyPath:keyPath
+                         ofObject:object
+                           change:change
+                          context:context];
+  }
+}
+
+#pragma mark Private Methods
+
+- (void)playerItemFailedToPlayToEnd {
+  if (_failedToPlayToEnd) {
+    return;
+  }
+  _failedToPlayToEnd = YES;
+  [_delegate playbackBackendStatusDidChange:self];
+}
+
+@end
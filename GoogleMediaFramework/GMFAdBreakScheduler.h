@@ -0,0 +1,87 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+@class GMFAdBreakScheduler;
+
+// What to do with the breaks a forward seek jumps over.
+typedef enum {
+  // Play only the break closest before the seek target; skip the others. The default.
+  kGMFAdBreakCatchUpPlayLast = 0,
+  // Play every skipped break, in cue order.
+  kGMFAdBreakCatchUpPlayAll,
+  // Play none of them.
+  kGMFAdBreakCatchUpSkipAll
+} GMFAdBreakCatchUpPolicy;
+
+@protocol GMFAdBreakSchedulerDelegate<NSObject>
+
+// Content playback reached the break at |cueTime|: pause the content and play the break.
+- (void)adBreakScheduler:(GMFAdBreakScheduler *)scheduler
+    shouldStartBreakAtTime:(NSTimeInterval)cueTime;
+
+@optional
+// The break at |cueTime| is |leadTime| away, or less after a seek. Start fetching its ad media.
+- (void)adBreakScheduler:(GMFAdBreakScheduler *)scheduler
+    breakWillStartAtTime:(NSTimeInterval)cueTime;
+
+// A seek jumped over the break at |cueTime| and the catch-up policy does not play it.
+- (void)adBreakScheduler:(GMFAdBreakScheduler *)scheduler
+    didSkipBreakAtTime:(NSTimeInterval)cueTime;
+
+@end
+
+// Decides when mid-roll breaks start from the content playhead. Cue points are kept sorted, so
+// each playhead update costs a binary search plus the breaks it actually crosses. Each break
+// plays at most once; seeking back over a played break does not play it again. Feed it media
+// times with |updatePlayheadTime:|, e.g. from kGMFPlayerEventMediaTime. Main thread only.
+@interface GMFAdBreakScheduler : NSObject
+
+@property(nonatomic, weak) id<GMFAdBreakSchedulerDelegate> delegate;
+
+// How long before a cue the delegate hears about it. Defaults to 5 seconds.
+@property(nonatomic, assign) NSTimeInterval leadTime;
+
+@property(nonatomic, assign) GMFAdBreakCatchUpPolicy catchUpPolicy;
+
+// Forward playhead moves longer than this are treated as seeks and go through the catch-up
+// policy. Should exceed the interval between playhead updates. Defaults to 1 second.
+@property(nonatomic, assign) NSTimeInterval maximumPlaybackStep;
+
+// Last time passed to |updatePlayheadTime:| or |seekToTime:|, or -Infinity before the first.
+@property(nonatomic, readonly) NSTimeInterval playheadTime;
+
+// Replaces the cue points and forgets which breaks were played. Negative and non-finite times
+// are ignored; duplicates are merged.
+- (void)setCueTimes:(const NSTimeInterval *)cueTimes count:(NSUInteger)count;
+
+- (NSUInteger)cueCount;
+- (NSTimeInterval)cueTimeAtIndex:(NSUInteger)index;
+
+// First unplayed cue after the playhead, or NaN if there is none. Lets the player arm a
+// boundary observer so content pauses exactly on the cue.
+- (NSTimeInterval)nextCueTime;
+
+// Advances the playhead, starting or skipping the breaks crossed and announcing those coming up.
+- (void)updatePlayheadTime:(NSTimeInterval)time;
+
+// Like |updatePlayheadTime:| but always applies the catch-up policy, for players that know a
+// seek happened.
+- (void)seekToTime:(NSTimeInterval)time;
+
+// Marks every break unplayed and rewinds the playhead to before the start.
+- (void)reset;
+
+@end
@@ -0,0 +1,218 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFAdBreakScheduler.h"
+
+static const NSTimeInterval kGMFAdBreakDefaultLeadTime = 5;
+static const NSTimeInterval kGMFAdBreakDefaultMaximumPlaybackStep = 1;
+
+typedef struct {
+  NSTimeInterval time;
+  BOOL announced;
+  BOOL played;
+} GMFCuePoint;
+
+static int GMFCompareTimeIntervals(const void *a, const void *b) {
+  NSTimeInterval lhs = *(const NSTimeInterval *)a;
+  NSTimeInterval rhs = *(const NSTimeInterval *)b;
+  return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+}
+
+// Index of the first cue in [from, count) later than |time|, or |count|.
+static NSUInteger GMFFirstCueAfter(const GMFCuePoint *cues,
+                                   NSUInteger from,
+                                   NSUInteger count,
+                                   NSTimeInterval time) {
+  NSUInteger low = from;
+  NSUInteger high = count;
+  while (low < high) {
+    NSUInteger mid = low + (high - low) / 2;
+    if (cues[mid].time <= time) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+@implementation GMFAdBreakScheduler {
+  GMFCuePoint *_cues;
+  NSUInteger _count;
+  // First cue later than the playhead.
+  NSUInteger _nextCueIndex;
+  // Bumped whenever the cue list is replaced, so a delegate that does so mid-dispatch stops it.
+  NSUInteger _generation;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _leadTime = kGMFAdBreakDefaultLeadTime;
+    _maximumPlaybackStep = kGMFAdBreakDefaultMaximumPlaybackStep;
+    _catchUpPolicy = kGMFAdBreakCatchUpPlayLast;
+    _playheadTime = -INFINITY;
+  }
+  return self;
+}
+
+- (void)dealloc {
+  free(_cues);
+}
+
+- (void)setCueTimes:(const NSTimeInterval *)cueTimes count:(NSUInteger)count {
+  NSTimeInterval *sorted = count ? malloc(count * sizeof(NSTimeInterval)) : NULL;
+  NSUInteger sortedCount = 0;
+  for (NSUInteger i = 0; i < count; i++) {
+    if (isfinite(cueTimes[i]) && cueTimes[i] >= 0) {
+      sorted[sortedCount++] = cueTimes[i];
+    }
+  }
+  qsort(sorted, sortedCount, sizeof(NSTimeInterval), GMFCompareTimeIntervals);
+
+  free(_cues);
+  _cues = sortedCount ? calloc(sortedCount, sizeof(GMFCuePoint)) : NULL;
+  _count = 0;
+  for (NSUInteger i = 0; i < sortedCount; i++) {
+    if (_count == 0 || _cues[_count - 1].time != sorted[i]) {
+      _cues[_count++].time = sorted[i];
+    }
+  }
+  free(sorted);
+  _nextCueIndex = GMFFirstCueAfter(_cues, 0, _count, _playheadTime);
+  _generation++;
+}
+
+- (NSUInteger)cueCount {
+  return _count;
+}
+
+- (NSTimeInterval)cueTimeAtIndex:(NSUInteger)index {
+  NSAssert(index < _count, @"Cue index %lu out of bounds.", (unsigned long)index);
+  return _cues[index].time;
+}
+
+- (NSTimeInterval)nextCueTime {
+  for (NSUInteger i = _nextCueIndex; i < _count; i++) {
+    if (!_cues[i].played) {
+      return _cues[i].time;
+    }
+  }
+  return NAN;
+}
+
+- (void)updatePlayheadTime:(NSTimeInterval)time {
+  // Before the first update the playhead counts as being at the start of the content.
+  NSTimeInterval from = MAX(_playheadTime, 0);
+  [self movePlayheadToTime:time isSeek:(time - from > _maximumPlaybackStep)];
+}
+
+- (void)seekToTime:(NSTimeInterval)time {
+  [self movePlayheadToTime:time isSeek:YES];
+}
+
+- (void)reset {
+  for (NSUInteger i = 0; i < _count; i++) {
+    _cues[i].announced = NO;
+    _cues[i].played = NO;
+  }
+  _playheadTime = -INFINITY;
+  _nextCueIndex = 0;
+  _generation++;
+}
+
+#pragma mark Private Methods
+
+- (void)movePlayheadToTime:(NSTimeInterval)time isSeek:(BOOL)isSeek {
+  if (!isfinite(time)) {
+    return;
+  }
+  NSUInteger generation = _generation;
+  if (time < _playheadTime) {
+    // Moving back never starts a break; played breaks stay played.
+    _playheadTime = time;
+    _nextCueIndex = GMFFirstCueAfter(_cues, 0, _nextCueIndex, time);
+  } else {
+    NSUInteger firstCrossed = _nextCueIndex;
+    NSUInteger end = GMFFirstCueAfter(_cues, firstCrossed, _count, time);
+    _playheadTime = time;
+    _nextCueIndex = end;
+    if (![self dispatchCrossedCuesFrom:firstCrossed to:end isSeek:isSeek] ||
+        generation != _generation) {
+      return;
+    }
+  }
+  [self announceUpcomingBreaks];
+}
+
+// Starts or skips the unplayed cues in [from, to). Returns NO if the delegate replaced the cues.
+- (BOOL)dispatchCrossedCuesFrom:(NSUInteger)from to:(NSUInteger)to isSeek:(BOOL)isSeek {
+  NSUInteger lastUnplayed = NSNotFound;
+  for (NSUInteger i = from; i < to; i++) {
+    if (!_cues[i].played) {
+      lastUnplayed = i;
+    }
+  }
+  if (lastUnplayed == NSNotFound) {
+    return YES;
+  }
+
+  NSUInteger generation = _generation;
+  id<GMFAdBreakSchedulerDelegate> delegate = _delegate;
+  for (NSUInteger i = from; i <= lastUnplayed; i++) {
+    if (_cues[i].played) {
+      continue;
+    }
+    _cues[i].played = YES;
+    NSTimeInterval cueTime = _cues[i].time;
+    BOOL shouldPlay = !isSeek ||
+                      _catchUpPolicy == kGMFAdBreakCatchUpPlayAll ||
+                      (_catchUpPolicy == kGMFAdBreakCatchUpPlayLast && i == lastUnplayed);
+    if (shouldPlay) {
+      [delegate adBreakScheduler:self shouldStartBreakAtTime:cueTime];
+    } else if ([delegate respondsToSelector:@selector(adBreakScheduler:didSkipBreakAtTime:)]) {
+      [delegate adBreakScheduler:self didSkipBreakAtTime:cueTime];
+    }
+    if (generation != _generation) {
+      return NO;
+    }
+  }
+  return YES;
+}
+
+- (void)announceUpcomingBreaks {
+  id<GMFAdBreakSchedulerDelegate> delegate = _delegate;
+  BOOL respondsToAnnouncement =
+      [delegate respondsToSelector:@selector(adBreakScheduler:breakWillStartAtTime:)];
+  NSUInteger generation = _generation;
+  NSTimeInterval horizon = _playheadTime + _leadTime;
+  for (NSUInteger i = _nextCueIndex; i < _count && _cues[i].time <= horizon; i++) {
+    if (_cues[i].announced || _cues[i].played) {
+      continue;
+    }
+    _cues[i].announced = YES;
+    if (respondsToAnnouncement) {
+      [delegate adBreakScheduler:self breakWillStartAtTime:_cues[i].time];
+      if (generation != _generation) {
+        return;
+      }
+    }
+  }
+}
+
+@end
@@ -0,0 +1,90 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFClock.h"
+
+extern NSString *const kGMFAdResponseCacheErrorDomain;
+
+typedef enum {
+  // The ad server returned an error or no ads. The localized description has the details.
+  kGMFAdResponseCacheErrorLoadFailed = 1,
+  // The ad tag was served |frequencyCap| times within the last |frequencyCapInterval|.
+  kGMFAdResponseCacheErrorFrequencyCapped
+} GMFAdResponseCacheError;
+
+// Exactly one of |response| and |error| is non-nil.
+typedef void (^GMFAdResponseCompletion)(id response, NSError *error);
+
+@protocol GMFAdResponseLoader<NSObject>
+
+// Requests the ad response for |adTag| from the ad server. |completion| must be called exactly
+// once, on the main thread.
+- (void)loadAdResponseForAdTag:(NSString *)adTag completion:(GMFAdResponseCompletion)completion;
+
+@end
+
+// Resolves ad tags ahead of playback so that pre-rolls don't wait on the ad server. Responses are
+// single use: each one is handed out once, then dropped. Unused responses expire after
+// |timeToLive|. Requests for a tag that is already being loaded share that load instead of
+// starting another. Main thread only.
+@interface GMFAdResponseCache : NSObject
+
+@property(nonatomic, readonly) id<GMFAdResponseLoader> loader;
+
+// How long a prefetched response stays usable. Defaults to 5 minutes.
+@property(nonatomic, assign) NSTimeInterval timeToLive;
+
+// Maximum number of unused responses kept. The one closest to expiring is dropped first.
+// Defaults to 4.
+@property(nonatomic, assign) NSUInteger countLimit;
+
+// Maximum number of times one ad tag is served within |frequencyCapInterval|. Capped tags are
+// neither prefetched nor served. 0, the default, means no cap.
+@property(nonatomic, assign) NSUInteger frequencyCap;
+
+// Defaults to one hour.
+@property(nonatomic, assign) NSTimeInterval frequencyCapInterval;
+
+// Responses served straight from the cache, and those that had to wait on the loader.
+@property(nonatomic, readonly) NSUInteger hitCount;
+@property(nonatomic, readonly) NSUInteger missCount;
+
+// Prefetched responses dropped unused because they expired or were evicted.
+@property(nonatomic, readonly) NSUInteger expiredCount;
+
+// Uses the shared GMFTimerWheel.
+- (instancetype)initWithLoader:(id<GMFAdResponseLoader>)loader;
+
+- (instancetype)initWithLoader:(id<GMFAdResponseLoader>)loader clock:(id<GMFClock>)clock;
+
+// Starts loading |adTag| in the background unless a usable response is already cached or loading,
+// or the tag is frequency capped.
+- (void)prefetchAdTag:(NSString *)adTag;
+
+// Hands out a response for |adTag|. Calls |completion| before returning on a hit, otherwise once
+// the loader (or a prefetch already in flight) finishes.
+- (void)takeResponseForAdTag:(NSString *)adTag completion:(GMFAdResponseCompletion)completion;
+
+- (BOOL)hasResponseForAdTag:(NSString *)adTag;
+
+- (BOOL)isFrequencyCappedForAdTag:(NSString *)adTag;
+
+// Drops cached responses. Loads in flight still complete for anyone waiting on them.
+- (void)removeAllResponses;
+
+- (void)resetStatistics;
+
+@end
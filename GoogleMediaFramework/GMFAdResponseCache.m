@@ -0,0 +1,223 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFAdResponseCache.h"
+#import "GMFTimerWheel.h"
+
+NSString *const kGMFAdResponseCacheErrorDomain = @"GMFAdResponseCacheErrorDomain";
+
+static const NSTimeInterval kGMFAdResponseDefaultTimeToLive = 5 * 60;
+static const NSUInteger kGMFAdResponseDefaultCountLimit = 4;
+static const NSTimeInterval kGMFAdResponseDefaultFrequencyCapInterval = 60 * 60;
+
+@interface GMFAdResponseCacheEntry : NSObject
+
+@property(nonatomic, strong) id response;
+@property(nonatomic, assign) NSTimeInterval expiryTime;
+
+@end
+
+@implementation GMFAdResponseCacheEntry
+@end
+
+@implementation GMFAdResponseCache {
+  id<GMFClock> _clock;
+  // Ad tag to GMFAdResponseCacheEntry.
+  NSMutableDictionary *_entries;
+  // Ad tag to the array of completions waiting on its load. Empty for plain prefetches.
+  NSMutableDictionary *_pendingLoads;
+  // Ad tag to the times it was served within the current frequency cap interval.
+  NSMutableDictionary *_impressionTimes;
+}
+
+- (instancetype)init {
+  NSAssert(false, @"init not available, use initWithLoader:.");
+  return nil;
+}
+
+- (instancetype)initWithLoader:(id<GMFAdResponseLoader>)loader {
+  return [self initWithLoader:loader clock:[GMFTimerWheel sharedWheel]];
+}
+
+- (instancetype)initWithLoader:(id<GMFAdResponseLoader>)loader clock:(id<GMFClock>)clock {
+  self = [super init];
+  if (self) {
+    _loader = loader;
+    _clock = clock;
+    _timeToLive = kGMFAdResponseDefaultTimeToLive;
+    _countLimit = kGMFAdResponseDefaultCountLimit;
+    _frequencyCapInterval = kGMFAdResponseDefaultFrequencyCapInterval;
+    _entries = [[NSMutableDictionary alloc] init];
+    _pendingLoads = [[NSMutableDictionary alloc] init];
+    _impressionTimes = [[NSMutableDictionary alloc] init];
+  }
+  return self;
+}
+
+- (void)prefetchAdTag:(NSString *)adTag {
+  if ([_pendingLoads objectForKey:adTag] ||
+      [self usableEntryForAdTag:adTag] ||
+      [self isFrequencyCappedForAdTag:adTag]) {
+    return;
+  }
+  [self loadAdTag:adTag completion:nil];
+}
+
+- (void)takeResponseForAdTag:(NSString *)adTag completion:(GMFAdResponseCompletion)completion {
+  if ([self usableEntryForAdTag:adTag]) {
+    _hitCount++;
+  } else if (![self isFrequencyCappedForAdTag:adTag]) {
+    _missCount++;
+  }
+  [self serveAdTag:adTag completion:completion];
+}
+
+- (BOOL)hasResponseForAdTag:(NSString *)adTag {
+  return [self usableEntryForAdTag:adTag] != nil;
+}
+
+- (BOOL)isFrequencyCappedForAdTag:(NSString *)adTag {
+  if (!_frequencyCap) {
+    return NO;
+  }
+  NSMutableArray *times = [_impressionTimes objectForKey:adTag];
+  NSTimeInterval windowStart = [_clock now] - _frequencyCapInterval;
+  while ([times count] && [[times objectAtIndex:0] doubleValue] <= windowStart) {
+    [times removeObjectAtIndex:0];
+  }
+  return [times count] >= _frequencyCap;
+}
+
+- (void)removeAllResponses {
+  [_entries removeAllObjects];
+}
+
+- (void)resetStatistics {
+  _hitCount = 0;
+  _missCount = 0;
+  _expiredCount = 0;
+}
+
+#pragma mark Private Methods
+
+// Serves a cached response, joins a load in flight or starts a new one.
+- (void)serveAdTag:(NSString *)adTag completion:(GMFAdResponseCompletion)completion {
+  if ([self isFrequencyCappedForAdTag:adTag]) {
+    completion(nil, [NSError errorWithDomain:kGMFAdResponseCacheErrorDomain
+                                        code:kGMFAdResponseCacheErrorFrequencyCapped
+                                    userInfo:nil]);
+    return;
+  }
+  GMFAdResponseCacheEntry *entry = [self usableEntryForAdTag:adTag];
+  if (entry) {
+    [_entries removeObjectForKey:adTag];
+    [self recordImpressionForAdTag:adTag];
+    completion([entry response], nil);
+    return;
+  }
+  NSMutableArray *waiters = [_pendingLoads objectForKey:adTag];
+  if (waiters) {
+    [waiters addObject:[completion copy]];
+  } else {
+    [self loadAdTag:adTag completion:completion];
+  }
+}
+
+- (void)loadAdTag:(NSString *)adTag completion:(GMFAdResponseCompletion)completion {
+  NSMutableArray *waiters = [[NSMutableArray alloc] init];
+  if (completion) {
+    [waiters addObject:[completion copy]];
+  }
+  [_pendingLoads setObject:waiters forKey:adTag];
+  __weak GMFAdResponseCache *weakSelf = self;
+  [_loader loadAdResponseForAdTag:adTag completion:^(id response, NSError *error) {
+      [weakSelf adTag:adTag didLoadResponse:response error:error];
+  }];
+}
+
+- (void)adTag:(NSString *)adTag didLoadResponse:(id)response error:(NSError *)error {
+  NSArray *waiters = [_pendingLoads objectForKey:adTag];
+  [_pendingLoads removeObjectForKey:adTag];
+  if (!response) {
+    for (GMFAdResponseCompletion waiter in waiters) {
+      waiter(nil, error);
+    }
+    return;
+  }
+  if (![waiters count]) {
+    [self storeResponse:response forAdTag:adTag];
+    return;
+  }
+  // The response is single use, so only the first waiter gets it; the rest start over.
+  [self recordImpressionForAdTag:adTag];
+  GMFAdResponseCompletion first = [waiters objectAtIndex:0];
+  first(response, nil);
+  for (NSUInteger i = 1; i < [waiters count]; i++) {
+    [self serveAdTag:adTag completion:[waiters objectAtIndex:i]];
+  }
+}
+
+- (void)storeResponse:(id)response forAdTag:(NSString *)adTag {
+  NSTimeInterval now = [_clock now];
+  for (NSString *key in [_entries allKeys]) {
+    [self usableEntryForAdTag:key];
+  }
+  GMFAdResponseCacheEntry *entry = [[GMFAdResponseCacheEntry alloc] init];
+  [entry setResponse:response];
+  [entry setExpiryTime:now + _timeToLive];
+  [_entries setObject:entry forKey:adTag];
+
+  while ([_entries count] > _countLimit) {
+    NSString *soonestKey = nil;
+    NSTimeInterval soonestExpiry = INFINITY;
+    for (NSString *key in _entries) {
+      NSTimeInterval expiry = [[_entries objectForKey:key] expiryTime];
+      if (expiry < soonestExpiry) {
+        soonestKey = key;
+        soonestExpiry = expiry;
+      }
+    }
+    [_entries removeObjectForKey:soonestKey];
+    _expiredCount++;
+  }
+}
+
+// Returns the cached entry for |adTag|, first dropping it if it has expired.
+- (GMFAdResponseCacheEntry *)usableEntryForAdTag:(NSString *)adTag {
+  GMFAdResponseCacheEntry *entry = [_entries objectForKey:adTag];
+  if (entry && [entry expiryTime] <= [_clock now]) {
+    [_entries removeObjectForKey:adTag];
+    _expiredCount++;
+    return nil;
+  }
+  return entry;
+}
+
+- (void)recordImpressionForAdTag:(NSString *)adTag {
+  if (!_frequencyCap) {
+    return;
+  }
+  NSMutableArray *times = [_impressionTimes objectForKey:adTag];
+  if (!times) {
+    times = [[NSMutableArray alloc] init];
+    [_impressionTimes setObject:times forKey:adTag];
+  }
+  [times addObject:@([_clock now])];
+}
+
+@end
@@ -14,12 +14,17 @@
 
 #import <Foundation/Foundation.h>
 
+#import "GMFAdBreakScheduler.h"
 #import "GMFPlayerViewController.h"
 
-@interface GMFAdService : NSObject
+@interface GMFAdService : NSObject<GMFAdBreakSchedulerDelegate>
 
 @property(nonatomic, weak) GMFPlayerViewController *videoPlayerController;
 
+// Driven by the content playhead, with this service as its delegate. Give it the cue points of
+// the mid-roll breaks and override the GMFAdBreakSchedulerDelegate methods to fetch and play them.
+@property(nonatomic, readonly) GMFAdBreakScheduler *adBreakScheduler;
+
 - (id)initWithGMFVideoPlayer:(GMFPlayerViewController* )videoPlayerController;
 
 @end
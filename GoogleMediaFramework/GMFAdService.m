@@ -18,7 +18,9 @@
 
 #import "GMFAdService.h"
 
-@implementation GMFAdService
+@implementation GMFAdService {
+  id _mediaTimeObserver;
+}
 
 - (id)init {
   NSAssert(false, @"init not available, use initWithGMFVideoPlayer.");
@@ -31,6 +33,15 @@
   if (self) {
     _videoPlayerController = videoPlayerController;
 
+    _adBreakScheduler = [[GMFAdBreakScheduler alloc] init];
+    [_adBreakScheduler setDelegate:self];
+    __weak GMFAdBreakScheduler *weakScheduler = _adBreakScheduler;
+    _mediaTimeObserver = [[_videoPlayerController observerRegistry]
+        addObserverForEvents:GMFPlayerEventMaskForType(kGMFPlayerEventMediaTime)
+                  usingBlock:^(const GMFPlayerEvent *event) {
+                      [weakScheduler updatePlayheadTime:event->time];
+                  }];
+
     // Listen for playback finished event. See GMFPlayerFinishReason.
     [[NSNotificationCenter defaultCenter] addObserver:self
                                              selector:@selector(playbackWillFinish:)
@@ -53,7 +64,15 @@
   // After playbackWillFinish
 }
 
+#pragma mark GMFAdBreakSchedulerDelegate
+
+- (void)adBreakScheduler:(GMFAdBreakScheduler *)scheduler
+    shouldStartBreakAtTime:(NSTimeInterval)cueTime {
+  // Override this in your AdService class to pause the content and play the break.
+}
+
 - (void)dealloc {
+  [[_videoPlayerController observerRegistry] removeObserver:_mediaTimeObserver];
   [[NSNotificationCenter defaultCenter]
       removeObserver:self
                 name:kGMFPlayerStateWillChangeToFinishedNotification
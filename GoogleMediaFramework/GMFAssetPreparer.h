@@ -0,0 +1,89 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <AVFoundation/AVFoundation.h>
+
+#import "GMFClock.h"
+#import "GMFLatencyHistogram.h"
+
+@class GMFAssetPreparation;
+
+extern NSString *const kGMFAssetPreparerErrorDomain;
+
+typedef enum {
+  // The asset loaded but can't be played.
+  kGMFAssetPreparerErrorNotPlayable = 1
+} GMFAssetPreparerError;
+
+// Called on the main thread with a player item for the prepared asset, or with the error it
+// failed with. Never called for a cancelled preparation.
+typedef void (^GMFAssetPreparationCompletion)(GMFAssetPreparation *preparation,
+                                              AVPlayerItem *playerItem,
+                                              NSError *error);
+
+// One asset being prepared by a GMFAssetPreparer.
+@interface GMFAssetPreparation : NSObject
+
+@property(nonatomic, readonly) AVURLAsset *asset;
+
+// Increases with each preparation started by the same preparer, so an owner can tell a result
+// for its latest load from one for an earlier load.
+@property(nonatomic, readonly) NSUInteger generation;
+
+// Safe to read from any thread.
+@property(atomic, readonly, getter=isCancelled) BOOL cancelled;
+
+// Stops loading the asset and drops its result. Main thread only.
+- (void)cancel;
+
+@end
+
+// Prepares assets for playback off the main thread: loads the keys AVPlayerItem would otherwise
+// block on, then validates the asset and makes its player item on a background queue, and only
+// hops to the main thread to deliver the result. Any number of preparations run in parallel, e.g.
+// for the current stream and the upcoming playlist items. Each can be cancelled on its own, and a
+// cancelled preparation never delivers. Start and cancel on the main thread.
+@interface GMFAssetPreparer : NSObject
+
+// Preparations started and neither delivered nor cancelled.
+@property(nonatomic, readonly) NSUInteger activeCount;
+
+@property(nonatomic, readonly) NSUInteger preparedCount;
+@property(nonatomic, readonly) NSUInteger failedCount;
+@property(nonatomic, readonly) NSUInteger cancelledCount;
+
+// Seconds each delivered preparation kept the main thread busy: starting it, and delivering its
+// result including the completion handler. This is the main thread cost of a load.
+@property(nonatomic, readonly) GMFLatencyHistogram *mainThreadTime;
+
+// Seconds from the start of each delivered preparation to its delivery.
+@property(nonatomic, readonly) GMFLatencyHistogram *preparationLatency;
+
+// The asset keys loaded before an asset is validated.
++ (NSArray *)assetKeys;
+
+// Uses the shared GMFTimerWheel.
+- (instancetype)init;
+
+// |clock| times the preparations.
+- (instancetype)initWithClock:(id<GMFClock>)clock;
+
+- (GMFAssetPreparation *)prepareAsset:(AVURLAsset *)asset
+                           completion:(GMFAssetPreparationCompletion)completion;
+
+- (void)cancelAllPreparations;
+
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,221 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFAssetPreparer.h"
+#import "GMFTimerWheel.h"
+#import "GMFTrace.h"
+
+NSString *const kGMFAssetPreparerErrorDomain = @"GMFAssetPreparerErrorDomain";
+
+// Asset keys loaded while preparing, so that creating and playing the player item doesn't block
+// on them later.
+static NSString * const kPlayableAssetKey = @"playable";
+static NSString * const kDurationAssetKey = @"duration";
+static NSString * const kTracksAssetKey = @"tracks";
+
+// Range of the histograms: 100 microseconds to two minutes.
+static const double kGMFAssetPreparerLowestTime = 0.0001;
+static const double kGMFAssetPreparerHighestTime = 120;
+
+@interface GMFAssetPreparer ()
+
+// Forgets |preparation|, which was cancelled.
+- (void)preparationDidCancel:(GMFAssetPreparation *)preparation;
+
+// Makes a player item for |asset| once its keys have loaded. Runs on the background queue.
++ (AVPlayerItem *)playerItemWithLoadedAsset:(AVURLAsset *)asset error:(NSError **)error;
+
+// Delivers the result of |preparation| unless it was cancelled meanwhile. Main thread only.
+- (void)finishPreparation:(GMFAssetPreparation *)preparation
+               playerItem:(AVPlayerItem *)playerItem
+                    error:(NSError *)error;
+
+@end
+
+@interface GMFAssetPreparation ()
+
+@property(atomic, assign, getter=isCancelled) BOOL cancelled;
+@property(nonatomic, weak) GMFAssetPreparer *preparer;
+@property(nonatomic, copy) GMFAssetPreparationCompletion completion;
+
+// Clock time when the preparation started, and how long starting it took.
+@property(nonatomic, assign) NSTimeInterval startTime;
+@property(nonatomic, assign) NSTimeInterval startDuration;
+
+- (instancetype)initWithAsset:(AVURLAsset *)asset generation:(NSUInteger)generation;
+
+@end
+
+@implementation GMFAssetPreparation
+
+- (instancetype)initWithAsset:(AVURLAsset *)asset generation:(NSUInteger)generation {
+  self = [super init];
+  if (self) {
+    _asset = asset;
+    _generation = generation;
+  }
+  return self;
+}
+
+- (void)cancel {
+  if ([self isCancelled]) {
+    return;
+  }
+  [self setCancelled:YES];
+  _completion = nil;
+  [_asset cancelLoading];
+  [_preparer preparationDidCancel:self];
+}
+
+@end
+
+@implementation GMFAssetPreparer {
+  id<GMFClock> _clock;
+  dispatch_queue_t _queue;
+  NSUInteger _nextGeneration;
+  NSMutableArray *_activePreparations;
+}
+
++ (NSArray *)assetKeys {
+  return @[ kPlayableAssetKey, kDurationAssetKey, kTracksAssetKey ];
+}
+
+- (instancetype)init {
+  return [self initWithClock:[GMFTimerWheel sharedWheel]];
+}
+
+- (instancetype)initWithClock:(id<GMFClock>)clock {
+  self = [super init];
+  if (self) {
+    _clock = clock;
+    // Concurrent, so one slow asset doesn't hold up the others.
+    _queue = dispatch_queue_create("com.google.GMFAssetPreparer", DISPATCH_QUEUE_CONCURRENT);
+    _activePreparations = [NSMutableArray array];
+    _mainThreadTime =
+        [[GMFLatencyHistogram alloc] initWithLowestValue:kGMFAssetPreparerLowestTime
+                                            highestValue:kGMFAssetPreparerHighestTime];
+    _preparationLatency =
+        [[GMFLatencyHistogram alloc] initWithLowestValue:kGMFAssetPreparerLowestTime
+                                            highestValue:kGMFAssetPreparerHighestTime];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [self cancelAllPreparations];
+}
+
+- (GMFAssetPreparation *)prepareAsset:(AVURLAsset *)asset
+                           completion:(GMFAssetPreparationCompletion)completion {
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_INFO, "prepare.start");
+  NSTimeInterval startTime = [_clock now];
+  GMFAssetPreparation *preparation =
+      [[GMFAssetPreparation alloc] initWithAsset:asset generation:++_nextGeneration];
+  [preparation setPreparer:self];
+  [preparation setCompletion:completion];
+  [preparation setStartTime:startTime];
+  [_activePreparations addObject:preparation];
+  _activeCount = [_activePreparations count];
+
+  __weak GMFAssetPreparer *weakSelf = self;
+  dispatch_queue_t queue = _queue;
+  [asset loadValuesAsynchronouslyForKeys:[GMFAssetPreparer assetKeys] completionHandler:^{
+      // Called on an arbitrary thread, and right away if the asset is cancelled.
+      if ([preparation isCancelled]) {
+        return;
+      }
+      dispatch_async(queue, ^{
+          if ([preparation isCancelled]) {
+            return;
+          }
+          NSError *error = nil;
+          AVPlayerItem *playerItem = [GMFAssetPreparer playerItemWithLoadedAsset:[preparation asset]
+                                                                           error:&error];
+          dispatch_async(dispatch_get_main_queue(), ^{
+              [weakSelf finishPreparation:preparation playerItem:playerItem error:error];
+          });
+      });
+  }];
+  [preparation setStartDuration:[_clock now] - startTime];
+  return preparation;
+}
+
+- (void)cancelAllPreparations {
+  for (GMFAssetPreparation *preparation in [_activePreparations copy]) {
+    [preparation cancel];
+  }
+}
+
+- (void)resetStatistics {
+  _preparedCount = 0;
+  _failedCount = 0;
+  _cancelledCount = 0;
+  [_mainThreadTime reset];
+  [_preparationLatency reset];
+}
+
+#pragma mark Private Methods
+
+- (void)preparationDidCancel:(GMFAssetPreparation *)preparation {
+  if (![_activePreparations containsObject:preparation]) {
+    return;
+  }
+  [_activePreparations removeObjectIdenticalTo:preparation];
+  _activeCount = [_activePreparations count];
+  _cancelledCount++;
+  GMF_TRACE_COUNTER(GMF_TRACE_LEVEL_VERBOSE, "prepare.active", _activeCount);
+}
+
++ (AVPlayerItem *)playerItemWithLoadedAsset:(AVURLAsset *)asset error:(NSError **)error {
+  // Only the playable key has to load; the others are loaded ahead so the item doesn't wait for
+  // them, but an HLS stream may legitimately fail them.
+  NSError *keyError = nil;
+  if ([asset statusOfValueForKey:kPlayableAssetKey error:&keyError] != AVKeyValueStatusLoaded ||
+      ![asset isPlayable]) {
+    NSDictionary *userInfo = keyError ? @{ NSUnderlyingErrorKey : keyError } : nil;
+    *error = [NSError errorWithDomain:kGMFAssetPreparerErrorDomain
+                                 code:kGMFAssetPreparerErrorNotPlayable
+                             userInfo:userInfo];
+    return nil;
+  }
+  return [AVPlayerItem playerItemWithAsset:asset];
+}
+
+- (void)finishPreparation:(GMFAssetPreparation *)preparation
+               playerItem:(AVPlayerItem *)playerItem
+                    error:(NSError *)error {
+  if ([preparation isCancelled]) {
+    return;
+  }
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_INFO, "prepare.deliver");
+  NSTimeInterval deliveryTime = [_clock now];
+  [_activePreparations removeObjectIdenticalTo:preparation];
+  _activeCount = [_activePreparations count];
+  if (playerItem) {
+    _preparedCount++;
+  } else {
+    _failedCount++;
+  }
+  [_preparationLatency recordValue:deliveryTime - [preparation startTime]];
+  GMFAssetPreparationCompletion completion = [preparation completion];
+  [preparation setCompletion:nil];
+  completion(preparation, playerItem, error);
+  [_mainThreadTime recordValue:[preparation startDuration] + [_clock now] - deliveryTime];
+}
+
+@end
@@ -0,0 +1,54 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+// Estimates network throughput from completed transfers with two exponentially weighted moving
+// averages, a fast one that reacts to drops and a slow one that ignores short bursts, and reports
+// the lower of the two. Samples are weighted by their transfer duration, so a long download
+// counts for more than a short one. Transfers smaller than |minimumSampleBytes| are dominated by
+// latency rather than throughput and are ignored.
+@interface GMFBandwidthEstimator : NSObject
+
+// Half-lives, in seconds of transfer time, of the fast and slow averages. Default to 2 and 5.
+@property(nonatomic, assign) NSTimeInterval fastHalfLife;
+@property(nonatomic, assign) NSTimeInterval slowHalfLife;
+
+// Defaults to 16 KB.
+@property(nonatomic, assign) NSUInteger minimumSampleBytes;
+
+// Reported until |minimumTransferDuration| worth of samples has been seen, in bits per second.
+// Defaults to 500 kbps, a conservative cellular start.
+@property(nonatomic, assign) double defaultEstimate;
+
+// Defaults to 0.5 seconds.
+@property(nonatomic, assign) NSTimeInterval minimumTransferDuration;
+
+// Number of samples taken into account.
+@property(nonatomic, readonly) NSUInteger sampleCount;
+
+// Adds a completed transfer. Returns NO if it was too small or too short to be used.
+- (BOOL)addSampleWithBytes:(uint64_t)bytes duration:(NSTimeInterval)duration;
+
+// Estimated throughput in bits per second.
+- (double)estimatedBitrate;
+
+// Whether enough has been transferred for |estimatedBitrate| to come from samples rather than
+// |defaultEstimate|.
+- (BOOL)hasEstimate;
+
+// Forgets all samples. Settings are kept.
+- (void)reset;
+
+@end
@@ -0,0 +1,102 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFBandwidthEstimator.h"
+
+// Duration-weighted EWMA. Starting from 0 biases the average low until enough weight has been
+// added, so the estimate is divided by the weight actually accumulated (1 - alpha^total).
+typedef struct {
+  double alpha;
+  double estimate;
+  double totalWeight;
+} GMFEWMA;
+
+static void GMFEWMASetHalfLife(GMFEWMA *average, NSTimeInterval halfLife) {
+  average->alpha = exp(log(0.5) / MAX(halfLife, 1e-3));
+}
+
+static void GMFEWMAAddSample(GMFEWMA *average, double weight, double value) {
+  double adjustedAlpha = pow(average->alpha, weight);
+  average->estimate = value * (1 - adjustedAlpha) + adjustedAlpha * average->estimate;
+  average->totalWeight += weight;
+}
+
+static double GMFEWMAEstimate(const GMFEWMA *average) {
+  double zeroFactor = 1 - pow(average->alpha, average->totalWeight);
+  return zeroFactor > 0 ? average->estimate / zeroFactor : 0;
+}
+
+@implementation GMFBandwidthEstimator {
+  GMFEWMA _fast;
+  GMFEWMA _slow;
+  NSTimeInterval _totalDuration;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _minimumSampleBytes = 16 * 1024;
+    _defaultEstimate = 500 * 1000;
+    _minimumTransferDuration = 0.5;
+    [self setFastHalfLife:2];
+    [self setSlowHalfLife:5];
+  }
+  return self;
+}
+
+- (void)setFastHalfLife:(NSTimeInterval)fastHalfLife {
+  _fastHalfLife = fastHalfLife;
+  GMFEWMASetHalfLife(&_fast, fastHalfLife);
+}
+
+- (void)setSlowHalfLife:(NSTimeInterval)slowHalfLife {
+  _slowHalfLife = slowHalfLife;
+  GMFEWMASetHalfLife(&_slow, slowHalfLife);
+}
+
+- (BOOL)addSampleWithBytes:(uint64_t)bytes duration:(NSTimeInterval)duration {
+  if (bytes < _minimumSampleBytes || !(duration > 0)) {
+    return NO;
+  }
+  double bitrate = bytes * 8.0 / duration;
+  GMFEWMAAddSample(&_fast, duration, bitrate);
+  GMFEWMAAddSample(&_slow, duration, bitrate);
+  _totalDuration += duration;
+  _sampleCount++;
+  return YES;
+}
+
+- (double)estimatedBitrate {
+  if (![self hasEstimate]) {
+    return _defaultEstimate;
+  }
+  return MIN(GMFEWMAEstimate(&_fast), GMFEWMAEstimate(&_slow));
+}
+
+- (BOOL)hasEstimate {
+  return _sampleCount > 0 && _totalDuration >= _minimumTransferDuration;
+}
+
+- (void)reset {
+  _fast.estimate = _fast.totalWeight = 0;
+  _slow.estimate = _slow.totalWeight = 0;
+  _totalDuration = 0;
+  _sampleCount = 0;
+}
+
+@end
@@ -0,0 +1,74 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+// Frame layout of the control bar and the top bar, computed in one pass from the sizes of their
+// contents instead of by solving constraints. Pure functions of their input, so the views can keep
+// the input of their last layout and skip laying out again while it holds.
+
+// Space between the control bar's items, and between them and its ends.
+extern const CGFloat kGMFControlBarPadding;
+
+// Insets of the logo and of the first action button from the ends of the top bar, and the gaps
+// after the logo and between action buttons.
+extern const CGFloat kGMFTopBarLogoInset;
+extern const CGFloat kGMFTopBarActionButtonInset;
+extern const CGFloat kGMFTopBarTitleSpacing;
+extern const CGFloat kGMFTopBarActionButtonSpacing;
+
+typedef struct {
+  CGSize barSize;
+  // Widths the labels need for their current text.
+  CGFloat secondsPlayedLabelWidth;
+  CGFloat totalSecondsLabelWidth;
+  CGFloat minimizeButtonWidth;
+} GMFControlBarLayoutInput;
+
+typedef struct {
+  CGRect background;
+  CGRect secondsPlayedLabel;
+  CGRect scrubber;
+  CGRect totalSecondsLabel;
+  CGRect minimizeButton;
+} GMFControlBarLayout;
+
+typedef struct {
+  CGSize barSize;
+  // CGSizeZero without a logo image.
+  CGSize logoSize;
+  // Width the title needs for its current text.
+  CGFloat titleWidth;
+  NSUInteger actionButtonCount;
+} GMFTopBarLayoutInput;
+
+typedef struct {
+  CGRect background;
+  CGRect logo;
+  CGRect title;
+} GMFTopBarLayout;
+
+BOOL GMFControlBarLayoutInputsEqual(GMFControlBarLayoutInput a, GMFControlBarLayoutInput b);
+BOOL GMFTopBarLayoutInputsEqual(GMFTopBarLayoutInput a, GMFTopBarLayoutInput b);
+
+// Lays out, from the left, the played time, the scrubber, the total time and the minimize button,
+// all as tall as the bar. The scrubber gets whatever width the others leave, if any.
+GMFControlBarLayout GMFLayoutControlBar(GMFControlBarLayoutInput input);
+
+// Lays out the logo, a square as wide as the bar is tall, and the title after it from the left,
+// and the action buttons, squares as tall as the bar, from the right in the order they were added.
+// The title is cut short before the action buttons. |actionButtonFrames| must have room for
+// |actionButtonCount| frames.
+GMFTopBarLayout GMFLayoutTopBar(GMFTopBarLayoutInput input, CGRect *actionButtonFrames);
@@ -0,0 +1,86 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFBarLayout.h"
+
+const CGFloat kGMFControlBarPadding = 8;
+
+const CGFloat kGMFTopBarLogoInset = 4;
+const CGFloat kGMFTopBarActionButtonInset = 15;
+const CGFloat kGMFTopBarTitleSpacing = 8;
+const CGFloat kGMFTopBarActionButtonSpacing = 10;
+
+BOOL GMFControlBarLayoutInputsEqual(GMFControlBarLayoutInput a, GMFControlBarLayoutInput b) {
+  return CGSizeEqualToSize(a.barSize, b.barSize) &&
+         a.secondsPlayedLabelWidth == b.secondsPlayedLabelWidth &&
+         a.totalSecondsLabelWidth == b.totalSecondsLabelWidth &&
+         a.minimizeButtonWidth == b.minimizeButtonWidth;
+}
+
+BOOL GMFTopBarLayoutInputsEqual(GMFTopBarLayoutInput a, GMFTopBarLayoutInput b) {
+  return CGSizeEqualToSize(a.barSize, b.barSize) &&
+         CGSizeEqualToSize(a.logoSize, b.logoSize) &&
+         a.titleWidth == b.titleWidth &&
+         a.actionButtonCount == b.actionButtonCount;
+}
+
+GMFControlBarLayout GMFLayoutControlBar(GMFControlBarLayoutInput input) {
+  CGFloat width = input.barSize.width;
+  CGFloat height = input.barSize.height;
+  GMFControlBarLayout layout;
+  layout.background = CGRectMake(0, 0, width, height);
+
+  CGFloat minimizeX = width - kGMFControlBarPadding - input.minimizeButtonWidth;
+  layout.minimizeButton = CGRectMake(minimizeX, 0, input.minimizeButtonWidth, height);
+
+  CGFloat totalX = minimizeX - kGMFControlBarPadding - input.totalSecondsLabelWidth;
+  layout.totalSecondsLabel = CGRectMake(totalX, 0, input.totalSecondsLabelWidth, height);
+
+  layout.secondsPlayedLabel =
+      CGRectMake(kGMFControlBarPadding, 0, input.secondsPlayedLabelWidth, height);
+
+  CGFloat scrubberX = CGRectGetMaxX(layout.secondsPlayedLabel) + kGMFControlBarPadding;
+  CGFloat scrubberWidth = MAX(0, totalX - kGMFControlBarPadding - scrubberX);
+  layout.scrubber = CGRectMake(scrubberX, 0, scrubberWidth, height);
+  return layout;
+}
+
+GMFTopBarLayout GMFLayoutTopBar(GMFTopBarLayoutInput input, CGRect *actionButtonFrames) {
+  CGFloat width = input.barSize.width;
+  CGFloat height = input.barSize.height;
+  GMFTopBarLayout layout;
+  layout.background = CGRectMake(0, 0, width, height);
+
+  // Aspect fit within a square as wide as the bar is tall, and never taller than the bar.
+  CGFloat logoHeight = input.logoSize.height > 0 ? MIN(input.logoSize.height, height) : height;
+  layout.logo = CGRectMake(kGMFTopBarLogoInset, (height - logoHeight) / 2, height, logoHeight);
+
+  CGFloat buttonsMinX = width;
+  for (NSUInteger i = 0; i < input.actionButtonCount; i++) {
+    CGFloat maxX = i ? buttonsMinX - kGMFTopBarActionButtonSpacing
+                     : width - kGMFTopBarActionButtonInset;
+    actionButtonFrames[i] = CGRectMake(maxX - height, 0, height, height);
+    buttonsMinX = maxX - height;
+  }
+
+  CGFloat titleX = CGRectGetMaxX(layout.logo) + kGMFTopBarTitleSpacing;
+  CGFloat titleRoom = input.actionButtonCount ? buttonsMinX - kGMFTopBarTitleSpacing - titleX
+                                              : width - titleX;
+  layout.title = CGRectMake(titleX, 0, MAX(0, MIN(input.titleWidth, titleRoom)), height);
+  return layout;
+}
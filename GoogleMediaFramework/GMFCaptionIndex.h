@@ -0,0 +1,45 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+@class GMFCaptionCue;
+
+// Interval index of caption cues, answering which cues are showing at a media time.
+//
+// Cues are kept sorted by start time in an array laid out as an implicit binary search tree, each
+// node holding the latest end time under it, so a lookup only descends into subtrees that can
+// still hold a showing cue and costs O(log n + k) for k showing cues. Adding cues, which mostly
+// arrive in start time order, appends them; the tree is rebuilt in one linear pass, after a sort
+// if they came out of order, on the next lookup.
+@interface GMFCaptionIndex : NSObject
+
+- (NSUInteger)cueCount;
+
+// Returns NO, and leaves the index as it is, if an equal cue is already indexed.
+- (BOOL)addCue:(GMFCaptionCue *)cue;
+
+- (void)removeAllCues;
+
+// Removes the cues that end at or before |time|, e.g. those a live window has slid past, in one
+// linear pass. Returns how many were removed.
+- (NSUInteger)removeCuesEndingBeforeTime:(NSTimeInterval)time;
+
+// Cues with startTime <= |time| < endTime, by start time.
+- (NSArray *)cuesAtTime:(NSTimeInterval)time;
+
+// Earliest start time after |time|, or DBL_MAX if no cue starts after it.
+- (NSTimeInterval)nextCueStartTimeAfterTime:(NSTimeInterval)time;
+
+@end
@@ -0,0 +1,234 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFCaptionIndex.h"
+#import "GMFWebVTTParser.h"
+
+static const NSUInteger kGMFCaptionIndexInitialCapacity = 64;
+
+// Subtrees this small are scanned rather than descended into.
+static const int kGMFCaptionIndexScanLevel = 3;
+
+typedef struct {
+  NSTimeInterval startTime;
+  NSTimeInterval endTime;
+  // Latest end time in the subtree rooted here.
+  NSTimeInterval maxEndTime;
+  // Index of the cue in |_cues|.
+  NSUInteger cueIndex;
+} GMFCaptionIndexEntry;
+
+// A subtree still to visit during a lookup.
+typedef struct {
+  NSUInteger node;
+  int level;
+  BOOL visitedLeft;
+} GMFCaptionIndexFrame;
+
+static int GMFCompareEntryStartTimes(const void *a, const void *b) {
+  NSTimeInterval first = ((const GMFCaptionIndexEntry *)a)->startTime;
+  NSTimeInterval second = ((const GMFCaptionIndexEntry *)b)->startTime;
+  return first < second ? -1 : first > second ? 1 : 0;
+}
+
+// Fills in |maxEndTime| of the sorted |entries|, seen as an implicit tree: the nodes of level k are
+// the indexes whose k lowest bits are set and the next bit is clear, and the children of node i at
+// level k > 0 are i - 2^(k-1) and i + 2^(k-1). Leaves are the even indexes. Children past the end
+// of the array stand for the last subtree that does exist. Returns the level of the root, which
+// is node 2^level - 1.
+static int GMFBuildImplicitTree(GMFCaptionIndexEntry *entries, NSUInteger count) {
+  NSUInteger lastNode = 0;
+  NSTimeInterval lastMaxEndTime = 0;
+  for (NSUInteger i = 0; i < count; i += 2) {
+    lastNode = i;
+    lastMaxEndTime = entries[i].maxEndTime = entries[i].endTime;
+  }
+  int level = 1;
+  for (; ((NSUInteger)1 << level) <= count; level++) {
+    NSUInteger half = (NSUInteger)1 << (level - 1);
+    for (NSUInteger i = (half << 1) - 1; i < count; i += half << 2) {
+      NSTimeInterval maxEndTime = MAX(entries[i].endTime, entries[i - half].maxEndTime);
+      entries[i].maxEndTime =
+          MAX(maxEndTime, i + half < count ? entries[i + half].maxEndTime : lastMaxEndTime);
+    }
+    // Move up to the parent of the last node.
+    lastNode = (lastNode >> level & 1) ? lastNode - half : lastNode + half;
+    if (lastNode < count) {
+      lastMaxEndTime = MAX(lastMaxEndTime, entries[lastNode].maxEndTime);
+    }
+  }
+  return level - 1;
+}
+
+@implementation GMFCaptionIndex {
+  // Cues in the order they were added, or kept by the last removal.
+  NSMutableArray *_cues;
+  NSMutableSet *_cueSet;
+  GMFCaptionIndexEntry *_entries;
+  NSUInteger _entryCount;
+  NSUInteger _entryCapacity;
+  BOOL _sorted;
+  BOOL _needsRebuild;
+  int _rootLevel;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _cues = [NSMutableArray array];
+    _cueSet = [NSMutableSet set];
+    _sorted = YES;
+  }
+  return self;
+}
+
+- (void)dealloc {
+  free(_entries);
+}
+
+- (NSUInteger)cueCount {
+  return _entryCount;
+}
+
+- (BOOL)addCue:(GMFCaptionCue *)cue {
+  if ([_cueSet containsObject:cue]) {
+    return NO;
+  }
+  [_cueSet addObject:cue];
+  if (_entryCount == _entryCapacity) {
+    _entryCapacity = MAX(kGMFCaptionIndexInitialCapacity, _entryCapacity * 2);
+    _entries = realloc(_entries, _entryCapacity * sizeof(GMFCaptionIndexEntry));
+  }
+  if (_entryCount && [cue startTime] < _entries[_entryCount - 1].startTime) {
+    _sorted = NO;
+  }
+  _entries[_entryCount++] = (GMFCaptionIndexEntry) {
+    [cue startTime], [cue endTime], [cue endTime], [_cues count]
+  };
+  [_cues addObject:cue];
+  _needsRebuild = YES;
+  return YES;
+}
+
+- (void)removeAllCues {
+  [_cues removeAllObjects];
+  [_cueSet removeAllObjects];
+  _entryCount = 0;
+  _sorted = YES;
+  _needsRebuild = NO;
+}
+
+- (NSUInteger)removeCuesEndingBeforeTime:(NSTimeInterval)time {
+  NSUInteger first = 0;
+  while (first < _entryCount && _entries[first].endTime > time) {
+    first++;
+  }
+  if (first == _entryCount) {
+    return 0;
+  }
+  // Compacts the entries in place, keeping their order, and renumbers the cues they point to.
+  NSMutableArray *keptCues = [NSMutableArray arrayWithCapacity:_entryCount];
+  NSUInteger keptCount = 0;
+  for (NSUInteger i = 0; i < _entryCount; i++) {
+    GMFCaptionIndexEntry entry = _entries[i];
+    GMFCaptionCue *cue = [_cues objectAtIndex:entry.cueIndex];
+    if (entry.endTime <= time) {
+      [_cueSet removeObject:cue];
+      continue;
+    }
+    entry.cueIndex = [keptCues count];
+    [keptCues addObject:cue];
+    _entries[keptCount++] = entry;
+  }
+  NSUInteger removedCount = _entryCount - keptCount;
+  _cues = keptCues;
+  _entryCount = keptCount;
+  _needsRebuild = YES;
+  return removedCount;
+}
+
+- (NSArray *)cuesAtTime:(NSTimeInterval)time {
+  if (!_entryCount) {
+    return @[];
+  }
+  [self rebuildIfNeeded];
+  NSMutableArray *cues = [NSMutableArray array];
+  // The tree is at most 64 levels deep, and the stack holds at most two frames per level.
+  GMFCaptionIndexFrame stack[128];
+  int depth = 0;
+  stack[depth++] = (GMFCaptionIndexFrame) {((NSUInteger)1 << _rootLevel) - 1, _rootLevel, NO};
+  while (depth) {
+    GMFCaptionIndexFrame frame = stack[--depth];
+    if (frame.level <= kGMFCaptionIndexScanLevel) {
+      NSUInteger first = frame.node >> frame.level << frame.level;
+      NSUInteger last = MIN(first + ((NSUInteger)1 << (frame.level + 1)) - 1, _entryCount);
+      for (NSUInteger i = first; i < last && _entries[i].startTime <= time; i++) {
+        if (time < _entries[i].endTime) {
+          [cues addObject:[_cues objectAtIndex:_entries[i].cueIndex]];
+        }
+      }
+    } else if (!frame.visitedLeft) {
+      // Come back for the node itself and its right subtree once the left one is done.
+      NSUInteger left = frame.node - ((NSUInteger)1 << (frame.level - 1));
+      stack[depth++] = (GMFCaptionIndexFrame) {frame.node, frame.level, YES};
+      if (left >= _entryCount || _entries[left].maxEndTime > time) {
+        stack[depth++] = (GMFCaptionIndexFrame) {left, frame.level - 1, NO};
+      }
+    } else if (frame.node < _entryCount && _entries[frame.node].startTime <= time) {
+      // Cues to the right all start later, so there is nothing there once one starts too late.
+      if (time < _entries[frame.node].endTime) {
+        [cues addObject:[_cues objectAtIndex:_entries[frame.node].cueIndex]];
+      }
+      NSUInteger right = frame.node + ((NSUInteger)1 << (frame.level - 1));
+      stack[depth++] = (GMFCaptionIndexFrame) {right, frame.level - 1, NO};
+    }
+  }
+  return cues;
+}
+
+- (NSTimeInterval)nextCueStartTimeAfterTime:(NSTimeInterval)time {
+  [self rebuildIfNeeded];
+  NSUInteger low = 0;
+  NSUInteger high = _entryCount;
+  while (low < high) {
+    NSUInteger mid = low + (high - low) / 2;
+    if (_entries[mid].startTime <= time) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low < _entryCount ? _entries[low].startTime : DBL_MAX;
+}
+
+#pragma mark Private Methods
+
+- (void)rebuildIfNeeded {
+  if (!_needsRebuild) {
+    return;
+  }
+  if (!_sorted) {
+    // Cues must be in start time order within a file, but segments can overlap.
+    qsort(_entries, _entryCount, sizeof(GMFCaptionIndexEntry), GMFCompareEntryStartTimes);
+    _sorted = YES;
+  }
+  _rootLevel = GMFBuildImplicitTree(_entries, _entryCount);
+  _needsRebuild = NO;
+}
+
+@end
@@ -0,0 +1,80 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFCaptionIndex.h"
+#import "GMFClock.h"
+#import "GMFWebVTTParser.h"
+
+@class GMFCaptionTrack;
+
+@protocol GMFCaptionTrackDelegate<NSObject>
+
+// Only called when cues come or go. Both arrays are by start time; either may be empty.
+- (void)captionTrack:(GMFCaptionTrack *)captionTrack
+        didEnterCues:(NSArray *)enteredCues
+            exitCues:(NSArray *)exitedCues;
+
+@end
+
+// Captions of a stream, following its playhead.
+//
+// WebVTT data goes through a GMFWebVTTParser into a GMFCaptionIndex, either streamed as one file
+// or as the segments of a segmented track. Each media time update, whether from playback, a seek
+// or a replay, looks up the showing cues and tells the delegate only which ones entered and
+// exited. After a lookup the track knows when the showing cues can next change, the earliest of
+// their end times and the next start time, so updates before then cost a comparison.
+//
+// |loadWithURL:| takes either a WebVTT file or an HLS subtitle media playlist. The segments of a
+// playlist are fetched in order; a live playlist is refreshed every target duration, and only new
+// segments are fetched. Cues a live window has slid past are dropped from the index on each
+// refresh. Main thread only.
+@interface GMFCaptionTrack : NSObject
+
+@property(nonatomic, weak) id<GMFCaptionTrackDelegate> delegate;
+
+@property(nonatomic, readonly) GMFCaptionIndex *index;
+
+// Cues showing at the last media time, by start time.
+@property(nonatomic, readonly) NSArray *activeCues;
+
+// Media time updates, and the index lookups they took.
+@property(nonatomic, readonly) NSUInteger updateCount;
+@property(nonatomic, readonly) NSUInteger lookupCount;
+
+// Uses the shared GMFTimerWheel to refresh live playlists.
+- (instancetype)init;
+
+- (instancetype)initWithClock:(id<GMFClock>)clock;
+
+// Appends the next chunk of a WebVTT file.
+- (void)appendData:(NSData *)data;
+
+// Parses what is left of the file after the last chunk.
+- (void)finishAppending;
+
+// Appends a complete segment of a segmented track.
+- (void)appendSegmentData:(NSData *)data;
+
+// Looks up the cues at |time| and tells the delegate of any change.
+- (void)updateWithMediaTime:(NSTimeInterval)time;
+
+// Loads a WebVTT file or an HLS subtitle media playlist, instead of anything loading already.
+- (void)loadWithURL:(NSURL *)URL;
+
+// Stops loading and refreshing the playlist. The cues loaded so far stay.
+- (void)stopLoading;
+
+@end
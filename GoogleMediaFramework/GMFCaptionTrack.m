@@ -0,0 +1,314 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFCaptionTrack.h"
+#import "GMFHLSPlaylist.h"
+#import "GMFTimerWheel.h"
+
+// Refresh interval of a live playlist without EXT-X-TARGETDURATION.
+static const NSTimeInterval kGMFCaptionPlaylistRefreshInterval = 5;
+
+@interface GMFCaptionTrack ()
+
+@property(nonatomic, assign) NSUInteger loadGeneration;
+
+@end
+
+@implementation GMFCaptionTrack {
+  id<GMFClock> _clock;
+  GMFWebVTTParser *_parser;
+  // Whether the parser added any cue to the index since the last lookup.
+  BOOL _cuesAdded;
+
+  NSTimeInterval _mediaTime;
+  BOOL _hasMediaTime;
+  // Media times from the last lookup to the next change of |activeCues|.
+  NSTimeInterval _activeSince;
+  NSTimeInterval _activeUntil;
+  BOOL _activeRangeValid;
+
+  GMFHLSPlaylist *_playlist;
+  NSURL *_playlistURL;
+  id _playlistRefreshHandle;
+  // Sequence number of the last segment queued for loading, if |_hasQueuedSegment|.
+  int64_t _lastQueuedSequenceNumber;
+  BOOL _hasQueuedSegment;
+  NSMutableArray *_pendingSegmentURLs;
+  NSMutableArray *_pendingSegmentSequenceNumbers;
+  BOOL _loadingSegment;
+  // Sequence number of the playlist segment being appended, if |_appendingPlaylistSegment|.
+  int64_t _appendingSequenceNumber;
+  BOOL _appendingPlaylistSegment;
+  // Earliest start time of the cues parsed from each segment, by sequence number.
+  NSMutableDictionary *_segmentCueStartTimes;
+}
+
+- (instancetype)init {
+  return [self initWithClock:[GMFTimerWheel sharedWheel]];
+}
+
+- (instancetype)initWithClock:(id<GMFClock>)clock {
+  self = [super init];
+  if (self) {
+    _clock = clock;
+    _index = [[GMFCaptionIndex alloc] init];
+    _activeCues = @[];
+    _pendingSegmentURLs = [NSMutableArray array];
+    _pendingSegmentSequenceNumbers = [NSMutableArray array];
+    _segmentCueStartTimes = [NSMutableDictionary dictionary];
+    __weak GMFCaptionTrack *weakSelf = self;
+    _parser = [[GMFWebVTTParser alloc] initWithCueHandler:^(GMFCaptionCue *cue) {
+        [weakSelf addParsedCue:cue];
+    }];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [self stopLoading];
+}
+
+- (void)appendData:(NSData *)data {
+  [_parser appendData:data];
+  [self didAppendCues];
+}
+
+- (void)finishAppending {
+  [_parser finishFile];
+  [self didAppendCues];
+}
+
+- (void)appendSegmentData:(NSData *)data {
+  [_parser appendData:data];
+  [_parser finishFile];
+  [self didAppendCues];
+}
+
+- (void)updateWithMediaTime:(NSTimeInterval)time {
+  _updateCount++;
+  _mediaTime = time;
+  _hasMediaTime = YES;
+  if (_activeRangeValid && time >= _activeSince && time < _activeUntil) {
+    return;
+  }
+  [self lookUpCuesAtTime:time];
+}
+
+- (void)loadWithURL:(NSURL *)URL {
+  [self stopLoading];
+  [self loadPlaylistOrFileWithURL:URL];
+}
+
+- (void)stopLoading {
+  _loadGeneration++;
+  if (_playlistRefreshHandle) {
+    [_clock cancelScheduledBlock:_playlistRefreshHandle];
+    _playlistRefreshHandle = nil;
+  }
+  [_pendingSegmentURLs removeAllObjects];
+  [_pendingSegmentSequenceNumbers removeAllObjects];
+  [_segmentCueStartTimes removeAllObjects];
+  _loadingSegment = NO;
+  _playlist = nil;
+  _playlistURL = nil;
+  _hasQueuedSegment = NO;
+}
+
+#pragma mark Private Methods
+
+- (void)addParsedCue:(GMFCaptionCue *)cue {
+  if (_appendingPlaylistSegment) {
+    // Repeated cues count too: they belong to this segment as much as to the one before.
+    NSNumber *key = @(_appendingSequenceNumber);
+    NSNumber *startTime = [_segmentCueStartTimes objectForKey:key];
+    if (!startTime || [cue startTime] < [startTime doubleValue]) {
+      [_segmentCueStartTimes setObject:@([cue startTime]) forKey:key];
+    }
+  }
+  if ([_index addCue:cue]) {
+    _cuesAdded = YES;
+  }
+}
+
+// New cues may show at the current time, so look again rather than wait for the next update,
+// which doesn't come while paused.
+- (void)didAppendCues {
+  if (!_cuesAdded) {
+    return;
+  }
+  _cuesAdded = NO;
+  _activeRangeValid = NO;
+  if (_hasMediaTime) {
+    [self lookUpCuesAtTime:_mediaTime];
+  }
+}
+
+- (void)lookUpCuesAtTime:(NSTimeInterval)time {
+  _lookupCount++;
+  NSArray *cues = [_index cuesAtTime:time];
+  // Nothing enters before the next start time, and nothing exits before the first end time.
+  NSTimeInterval activeUntil = [_index nextCueStartTimeAfterTime:time];
+  for (GMFCaptionCue *cue in cues) {
+    activeUntil = MIN(activeUntil, [cue endTime]);
+  }
+  _activeSince = time;
+  _activeUntil = activeUntil;
+  _activeRangeValid = YES;
+
+  NSMutableArray *enteredCues = [NSMutableArray array];
+  for (GMFCaptionCue *cue in cues) {
+    if ([_activeCues indexOfObjectIdenticalTo:cue] == NSNotFound) {
+      [enteredCues addObject:cue];
+    }
+  }
+  NSMutableArray *exitedCues = [NSMutableArray array];
+  for (GMFCaptionCue *cue in _activeCues) {
+    if ([cues indexOfObjectIdenticalTo:cue] == NSNotFound) {
+      [exitedCues addObject:cue];
+    }
+  }
+  _activeCues = cues;
+  if ([enteredCues count] || [exitedCues count]) {
+    [_delegate captionTrack:self didEnterCues:enteredCues exitCues:exitedCues];
+  }
+}
+
+#pragma mark Loading
+
+- (void)loadPlaylistOrFileWithURL:(NSURL *)URL {
+  NSUInteger generation = _loadGeneration;
+  __weak GMFCaptionTrack *weakSelf = self;
+  [NSURLConnection sendAsynchronousRequest:[NSURLRequest requestWithURL:URL]
+                                     queue:[NSOperationQueue mainQueue]
+                         completionHandler:^(NSURLResponse *response,
+                                             NSData *data,
+                                             NSError *error) {
+      GMFCaptionTrack *strongSelf = weakSelf;
+      if (!strongSelf || [strongSelf loadGeneration] != generation || !data) {
+        return;
+      }
+      [strongSelf didLoadData:data fromURL:[response URL] ?: URL];
+  }];
+}
+
+- (void)didLoadData:(NSData *)data fromURL:(NSURL *)URL {
+  _playlistRefreshHandle = nil;
+  GMFHLSPlaylist *previous = [URL isEqual:_playlistURL] ? _playlist : nil;
+  GMFHLSPlaylist *playlist = [GMFHLSPlaylist playlistWithData:data
+                                                      baseURL:URL
+                                             previousPlaylist:previous];
+  if (!playlist) {
+    // A whole WebVTT file.
+    [self appendSegmentData:data];
+    return;
+  }
+  if ([playlist isMasterPlaylist]) {
+    // Subtitle renditions are listed in EXT-X-MEDIA tags; the app picks one and loads its URL.
+    return;
+  }
+  _playlist = playlist;
+  _playlistURL = URL;
+  if (previous) {
+    [self removeCuesBeforePlaylist:playlist];
+  }
+  for (NSUInteger i = 0; i < [playlist segmentCount]; i++) {
+    int64_t sequenceNumber = [playlist segmentAtIndex:i].sequenceNumber;
+    if (!_hasQueuedSegment || sequenceNumber > _lastQueuedSequenceNumber) {
+      [_pendingSegmentURLs addObject:[playlist URLForSegmentAtIndex:i]];
+      [_pendingSegmentSequenceNumbers addObject:@(sequenceNumber)];
+      _lastQueuedSequenceNumber = sequenceNumber;
+      _hasQueuedSegment = YES;
+    }
+  }
+  [self loadNextSegment];
+  if ([playlist isLive]) {
+    NSTimeInterval interval = [playlist targetDuration] ?: kGMFCaptionPlaylistRefreshInterval;
+    __weak GMFCaptionTrack *weakSelf = self;
+    _playlistRefreshHandle = [_clock scheduleBlock:^{
+        GMFCaptionTrack *strongSelf = weakSelf;
+        if (strongSelf) {
+          strongSelf->_playlistRefreshHandle = nil;
+          [strongSelf loadPlaylistOrFileWithURL:strongSelf->_playlistURL];
+        }
+    } afterDelay:interval];
+  }
+}
+
+// One segment at a time, so their X-TIMESTAMP-MAP headers are seen in order.
+- (void)loadNextSegment {
+  if (_loadingSegment || ![_pendingSegmentURLs count]) {
+    return;
+  }
+  NSURL *URL = [_pendingSegmentURLs firstObject];
+  int64_t sequenceNumber = [[_pendingSegmentSequenceNumbers firstObject] longLongValue];
+  [_pendingSegmentURLs removeObjectAtIndex:0];
+  [_pendingSegmentSequenceNumbers removeObjectAtIndex:0];
+  _loadingSegment = YES;
+  NSUInteger generation = _loadGeneration;
+  __weak GMFCaptionTrack *weakSelf = self;
+  [NSURLConnection sendAsynchronousRequest:[NSURLRequest requestWithURL:URL]
+                                     queue:[NSOperationQueue mainQueue]
+                         completionHandler:^(NSURLResponse *response,
+                                             NSData *data,
+                                             NSError *error) {
+      GMFCaptionTrack *strongSelf = weakSelf;
+      if (!strongSelf || [strongSelf loadGeneration] != generation) {
+        return;
+      }
+      strongSelf->_loadingSegment = NO;
+      if (data) {
+        // A segment that failed to load only loses its own cues.
+        [strongSelf appendPlaylistSegmentData:data sequenceNumber:sequenceNumber];
+      }
+      [strongSelf loadNextSegment];
+  }];
+}
+
+- (void)appendPlaylistSegmentData:(NSData *)data sequenceNumber:(int64_t)sequenceNumber {
+  _appendingPlaylistSegment = YES;
+  _appendingSequenceNumber = sequenceNumber;
+  [self appendSegmentData:data];
+  _appendingPlaylistSegment = NO;
+}
+
+// Removes the cues a live window has slid past, so the index of a long-running stream stays the
+// size of its window: those ending before the start of |playlist|'s first segment. In cue time,
+// that start is taken as the earliest cue parsed from a segment still in the playlist; a cue that
+// runs into the window is repeated in its first segment, so it is kept.
+- (void)removeCuesBeforePlaylist:(GMFHLSPlaylist *)playlist {
+  int64_t firstSequenceNumber = [playlist mediaSequence];
+  NSTimeInterval windowStartTime = DBL_MAX;
+  for (NSNumber *sequenceNumber in [_segmentCueStartTimes allKeys]) {
+    if ([sequenceNumber longLongValue] < firstSequenceNumber) {
+      [_segmentCueStartTimes removeObjectForKey:sequenceNumber];
+    } else {
+      NSTimeInterval startTime = [[_segmentCueStartTimes objectForKey:sequenceNumber] doubleValue];
+      windowStartTime = MIN(windowStartTime, startTime);
+    }
+  }
+  if (windowStartTime == DBL_MAX || ![_index removeCuesEndingBeforeTime:windowStartTime]) {
+    return;
+  }
+  // A showing cue may be gone, e.g. when paused far behind live.
+  _activeRangeValid = NO;
+  if (_hasMediaTime) {
+    [self lookUpCuesAtTime:_mediaTime];
+  }
+}
+
+@end
@@ -0,0 +1,40 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+// Source of time and one-shot delayed execution for the framework's timers. Playback logic goes
+// through this protocol instead of NSTimer directly so it can be driven by a virtual clock in
+// tests.
+@protocol GMFClock<NSObject>
+
+// Monotonic time in seconds. Only differences between values are meaningful.
+- (NSTimeInterval)now;
+
+// Runs |block| once, on the main thread, after |delay| seconds. Returns a handle which can be
+// passed to |cancelScheduledBlock:| until the block has run.
+- (id)scheduleBlock:(dispatch_block_t)block afterDelay:(NSTimeInterval)delay;
+
+- (void)cancelScheduledBlock:(id)handle;
+
+@end
+
+// Clock of the main run loop. Blocks are scheduled as one-shot timers on the main run loop in
+// NSRunLoopCommonModes so they also fire during UI events such as scrolling. The framework's
+// timers go through the shared GMFTimerWheel, which keeps a single one of these timers.
+@interface GMFRunLoopClock : NSObject<GMFClock>
+
++ (instancetype)sharedClock;
+
+@end
@@ -0,0 +1,58 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFClock.h"
+
+@implementation GMFRunLoopClock
+
++ (instancetype)sharedClock {
+  static GMFRunLoopClock *sharedClock;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    sharedClock = [[GMFRunLoopClock alloc] init];
+  });
+  return sharedClock;
+}
+
+- (NSTimeInterval)now {
+  return [[NSProcessInfo processInfo] systemUptime];
+}
+
+- (id)scheduleBlock:(dispatch_block_t)block afterDelay:(NSTimeInterval)delay {
+  NSTimer *timer = [NSTimer timerWithTimeInterval:MAX(delay, 0)
+                                           target:self
+                                         selector:@selector(timerDidFire:)
+                                         userInfo:[block copy]
+                                          repeats:NO];
+  // Ensure timer fires during UI events such as scrolling.
+  [[NSRunLoop mainRunLoop] addTimer:timer forMode:NSRunLoopCommonModes];
+  return timer;
+}
+
+- (void)cancelScheduledBlock:(id)handle {
+  [(NSTimer *)handle invalidate];
+}
+
+#pragma mark Private Methods
+
+- (void)timerDidFire:(NSTimer *)timer {
+  dispatch_block_t block = [timer userInfo];
+  block();
+}
+
+@end
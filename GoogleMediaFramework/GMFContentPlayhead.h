@@ -8,6 +8,10 @@
 
 @property(nonatomic, readonly) NSTimeInterval currentTime;
 
+// The player whose media time is reported. May be nil, and may be changed later, so that ads can
+// be requested before the player that shows them exists.
+@property(nonatomic, weak) GMFPlayerViewController *playerViewController;
+
 - (instancetype)initWithGMFPlayerViewController:(GMFPlayerViewController *)playerViewController;
 
 @end
@@ -2,13 +2,8 @@
 
 #import "GMFContentPlayhead.h"
 
-@interface GMFContentPlayhead ()
-
-@property (nonatomic, weak) GMFPlayerViewController * playerViewController;
-
-@end
-
 @implementation GMFContentPlayhead {
+  id _mediaTimeObserver;
 }
 
 - (instancetype)init {
@@ -19,19 +14,31 @@
 - (instancetype)initWithGMFPlayerViewController:(GMFPlayerViewController *)playerViewController {
   self = [super init];
   if (self) {
-    _playerViewController = playerViewController;
-    [[NSNotificationCenter defaultCenter]
-        addObserver:self
-           selector:@selector(currentMediaTimeDidChange)
-               name:kGMFPlayerCurrentMediaTimeDidChangeNotification
-             object:_playerViewController];
+    [self setPlayerViewController:playerViewController];
   }
   return self;
 }
 
-- (void)currentMediaTimeDidChange {
+- (void)setPlayerViewController:(GMFPlayerViewController *)playerViewController {
+  if (_playerViewController == playerViewController) {
+    return;
+  }
+  [[_playerViewController observerRegistry] removeObserver:_mediaTimeObserver];
+  _mediaTimeObserver = nil;
+  _playerViewController = playerViewController;
+  __weak GMFContentPlayhead *weakSelf = self;
+  _mediaTimeObserver = [[_playerViewController observerRegistry]
+      addObserverForEvents:GMFPlayerEventMaskForType(kGMFPlayerEventMediaTime)
+                usingBlock:^(const GMFPlayerEvent *event) {
+                    [weakSelf currentMediaTimeDidChangeToTime:event->time];
+                }];
+  [self currentMediaTimeDidChangeToTime:[_playerViewController currentMediaTime]];
+}
+
+// The IMA SDK observes |currentTime| through KVO, so keep notifying manually.
+- (void)currentMediaTimeDidChangeToTime:(NSTimeInterval)time {
   [self willChangeValueForKey:@"currentTime"];
-  _currentTime = _playerViewController.currentMediaTime;
+  _currentTime = time;
   [self didChangeValueForKey:@"currentTime"];
 }
 
@@ -47,10 +54,7 @@
 }
 
 - (void)dealloc {
-  [[NSNotificationCenter defaultCenter]
-      removeObserver:self
-                name:kGMFPlayerCurrentMediaTimeDidChangeNotification
-              object:nil];
+  [[_playerViewController observerRegistry] removeObserver:_mediaTimeObserver];
 }
 
 @end
@@ -0,0 +1,26 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+// Enough for any value GMFFormatDuration can produce.
+#define kGMFDurationFormatterMaxLength 32
+
+// Whole seconds shown for |seconds|: rounded to nearest, with NaN, infinite and negative values
+// shown as 0. Compare these to skip rebuilding a label whose text would not change.
+NSInteger GMFDurationDisplaySeconds(NSTimeInterval seconds);
+
+// Writes |displaySeconds| as M:SS, or H:MM:SS from one hour up, into |buffer| without allocating.
+// Returns the number of characters written, which is 0 if |capacity| is too small.
+NSUInteger GMFFormatDuration(NSInteger displaySeconds, unichar *buffer, NSUInteger capacity);
@@ -0,0 +1,65 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFDurationFormatter.h"
+
+NSInteger GMFDurationDisplaySeconds(NSTimeInterval seconds) {
+  if (!isfinite(seconds) || seconds <= 0) {
+    return 0;
+  }
+  // Clamp before converting so lround never sees a value it can't represent.
+  return seconds >= (NSTimeInterval)NSIntegerMax ? NSIntegerMax : lround(seconds);
+}
+
+// Writes |value| in decimal, zero padded to |minDigits|, backwards from |end|. Returns the new
+// start.
+static unichar *GMFWriteDigitsBackwards(unichar *end, NSUInteger value, NSUInteger minDigits) {
+  NSUInteger digits = 0;
+  do {
+    *--end = (unichar)('0' + value % 10);
+    value /= 10;
+    digits++;
+  } while (value || digits < minDigits);
+  return end;
+}
+
+NSUInteger GMFFormatDuration(NSInteger displaySeconds, unichar *buffer, NSUInteger capacity) {
+  unichar scratch[kGMFDurationFormatterMaxLength];
+  unichar *end = scratch + kGMFDurationFormatterMaxLength;
+  NSUInteger total = displaySeconds > 0 ? (NSUInteger)displaySeconds : 0;
+  NSUInteger seconds = total % 60;
+  NSUInteger minutes = (total / 60) % 60;
+  NSUInteger hours = total / 3600;
+
+  unichar *start = GMFWriteDigitsBackwards(end, seconds, 2);
+  *--start = ':';
+  if (hours) {
+    start = GMFWriteDigitsBackwards(start, minutes, 2);
+    *--start = ':';
+    start = GMFWriteDigitsBackwards(start, hours, 1);
+  } else {
+    start = GMFWriteDigitsBackwards(start, minutes, 1);
+  }
+
+  NSUInteger length = (NSUInteger)(end - start);
+  if (length > capacity) {
+    return 0;
+  }
+  memcpy(buffer, start, length * sizeof(unichar));
+  return length;
+}
@@ -0,0 +1,35 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+// Runs a commit block at most once per display frame, however many times |setNeedsCommit| is
+// called in between. Driven by a CADisplayLink that is paused whenever nothing is pending, so an
+// idle view costs no wakeups. Main thread only.
+@interface GMFFrameCoalescer : NSObject
+
+// |commitBlock| should capture its owner weakly; the coalescer holds it strongly.
+- (instancetype)initWithCommitBlock:(dispatch_block_t)commitBlock;
+
+// Schedules the commit block for the next display frame.
+- (void)setNeedsCommit;
+
+// Runs the commit block now if a commit is pending.
+- (void)commitIfNeeded;
+
+// Stops the display link. Must be called before the owner goes away; the display link retains
+// the coalescer until then.
+- (void)invalidate;
+
+@end
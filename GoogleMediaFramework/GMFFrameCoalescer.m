@@ -0,0 +1,73 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import <QuartzCore/QuartzCore.h>
+
+#import "GMFFrameCoalescer.h"
+
+@implementation GMFFrameCoalescer {
+  dispatch_block_t _commitBlock;
+  CADisplayLink *_displayLink;
+  BOOL _needsCommit;
+}
+
+- (instancetype)initWithCommitBlock:(dispatch_block_t)commitBlock {
+  NSAssert(commitBlock, @"Commit block must not be nil.");
+  self = [super init];
+  if (self) {
+    _commitBlock = [commitBlock copy];
+  }
+  return self;
+}
+
+- (void)setNeedsCommit {
+  if (_needsCommit) {
+    return;
+  }
+  _needsCommit = YES;
+  if (!_displayLink) {
+    _displayLink = [CADisplayLink displayLinkWithTarget:self
+                                               selector:@selector(displayLinkDidFire:)];
+    // Common modes so commits keep flowing while the user drags the scrubber.
+    [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+  }
+  [_displayLink setPaused:NO];
+}
+
+- (void)commitIfNeeded {
+  if (!_needsCommit) {
+    return;
+  }
+  _needsCommit = NO;
+  [_displayLink setPaused:YES];
+  _commitBlock();
+}
+
+- (void)invalidate {
+  [_displayLink invalidate];
+  _displayLink = nil;
+  _needsCommit = NO;
+}
+
+#pragma mark Private Methods
+
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink {
+  [self commitIfNeeded];
+}
+
+@end
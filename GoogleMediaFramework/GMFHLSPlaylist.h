@@ -0,0 +1,111 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFTimeRangeSet.h"
+
+typedef enum {
+  // A master playlist; the type is decided by its media playlists.
+  kGMFHLSStreamTypeUnknown = 0,
+  // Complete presentation: EXT-X-ENDLIST or EXT-X-PLAYLIST-TYPE:VOD.
+  kGMFHLSStreamTypeVOD,
+  // Sliding window too short to seek in meaningfully.
+  kGMFHLSStreamTypeLive,
+  // Live, but seekable: an EVENT playlist, or a sliding window of at least
+  // kGMFHLSMinimumDVRWindow seconds.
+  kGMFHLSStreamTypeDVR
+} GMFHLSStreamType;
+
+// Shortest sliding window treated as DVR rather than plain live.
+extern const NSTimeInterval kGMFHLSMinimumDVRWindow;
+
+// A media segment. |URIRange| is a byte range in the playlist's |data|.
+typedef struct {
+  NSRange URIRange;
+  // Offset from the start of the playlist's first segment.
+  NSTimeInterval startTime;
+  NSTimeInterval duration;
+  int64_t sequenceNumber;
+  // Whether an EXT-X-DISCONTINUITY tag precedes the segment.
+  BOOL discontinuity;
+} GMFHLSSegment;
+
+// A variant stream of a master playlist. |URIRange| is a byte range in the playlist's |data|.
+// Absent attributes are 0.
+typedef struct {
+  NSRange URIRange;
+  NSUInteger bandwidth;
+  NSUInteger averageBandwidth;
+  NSUInteger width;
+  NSUInteger height;
+} GMFHLSVariant;
+
+// Parsed M3U8 master or media playlist. Parsing scans the bytes of |data| in place: segments and
+// variants are plain structs pointing back into it, and no string is built per line. Strings and
+// URLs are only made on request.
+@interface GMFHLSPlaylist : NSObject
+
+@property(nonatomic, readonly) NSData *data;
+@property(nonatomic, readonly) NSURL *baseURL;
+
+@property(nonatomic, readonly, getter=isMasterPlaylist) BOOL masterPlaylist;
+@property(nonatomic, readonly) GMFHLSStreamType streamType;
+
+// EXT-X-TARGETDURATION, or 0 if absent.
+@property(nonatomic, readonly) NSTimeInterval targetDuration;
+
+// EXT-X-MEDIA-SEQUENCE: the sequence number of the first segment.
+@property(nonatomic, readonly) int64_t mediaSequence;
+
+@property(nonatomic, readonly) BOOL hasEndList;
+
+// Sum of the segment durations.
+@property(nonatomic, readonly) NSTimeInterval totalDuration;
+
+// Whether the segments of the playlist this was refreshed from were reused rather than parsed
+// again.
+@property(nonatomic, readonly, getter=isIncrementallyParsed) BOOL incrementallyParsed;
+
+// Returns nil unless |data| starts with #EXTM3U.
++ (instancetype)playlistWithData:(NSData *)data baseURL:(NSURL *)baseURL;
+
+// Parses a refresh of |previousPlaylist|. When |data| extends the previous bytes, as EVENT and
+// other append-only playlists do, only the appended part is parsed. Otherwise, e.g. for a sliding
+// window, the whole playlist is parsed again.
++ (instancetype)playlistWithData:(NSData *)data
+                         baseURL:(NSURL *)baseURL
+                previousPlaylist:(GMFHLSPlaylist *)previousPlaylist;
+
+- (BOOL)isLive;
+
+- (NSUInteger)segmentCount;
+- (GMFHLSSegment)segmentAtIndex:(NSUInteger)index;
+- (NSURL *)URLForSegmentAtIndex:(NSUInteger)index;
+
+// Index of the segment playing at |time|, clamped to the first and last segments. NSNotFound if
+// there are no segments.
+- (NSUInteger)segmentIndexForTime:(NSTimeInterval)time;
+
+- (NSUInteger)discontinuityCount;
+
+- (NSUInteger)variantCount;
+- (GMFHLSVariant)variantAtIndex:(NSUInteger)index;
+- (NSURL *)URLForVariantAtIndex:(NSUInteger)index;
+
+// Where playback may be positioned. The whole presentation for VOD; for live streams, up to three
+// target durations from the end of the playlist, the default hold back before the live edge.
+- (GMFTimeRange)seekableRange;
+
+@end
@@ -0,0 +1,365 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFHLSPlaylist.h"
+
+const NSTimeInterval kGMFHLSMinimumDVRWindow = 120;
+
+// Live playback stays this many target durations behind the end of the playlist.
+static const NSTimeInterval kGMFHLSHoldBackTargetDurations = 3;
+
+static const NSUInteger kGMFHLSInitialCapacity = 16;
+
+typedef enum {
+  kGMFHLSPlaylistTypeNone = 0,
+  kGMFHLSPlaylistTypeVOD,
+  kGMFHLSPlaylistTypeEvent
+} GMFHLSPlaylistType;
+
+// Everything needed to carry on parsing from |offset|, which is always the start of a line.
+typedef struct {
+  NSUInteger offset;
+  NSTimeInterval nextStartTime;
+  int64_t nextSequenceNumber;
+  NSUInteger discontinuityCount;
+  BOOL pendingDiscontinuity;
+  BOOL hasPendingSegment;
+  NSTimeInterval pendingDuration;
+  BOOL hasPendingVariant;
+  GMFHLSVariant pendingVariant;
+} GMFHLSParserState;
+
+#pragma mark Byte scanning
+
+// Whether the line [line, end) starts with the NUL-terminated |tag|.
+static BOOL GMFLineHasPrefix(const char *line, const char *end, const char *tag, size_t tagLength) {
+  return (size_t)(end - line) >= tagLength && memcmp(line, tag, tagLength) == 0;
+}
+
+#define GMF_TAG(line, end, tag) GMFLineHasPrefix((line), (end), (tag), sizeof(tag) - 1)
+
+static BOOL GMFLineEquals(const char *line, const char *end, const char *tag, size_t tagLength) {
+  return (size_t)(end - line) == tagLength && memcmp(line, tag, tagLength) == 0;
+}
+
+#define GMF_TAG_EQUALS(line, end, tag) GMFLineEquals((line), (end), (tag), sizeof(tag) - 1)
+
+static uint64_t GMFParseUnsigned(const char *p, const char *end, const char **next) {
+  uint64_t value = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    value = value * 10 + (uint64_t)(*p - '0');
+    p++;
+  }
+  if (next) {
+    *next = p;
+  }
+  return value;
+}
+
+// Parses a decimal-floating-point as used by EXTINF, e.g. "9.009". No exponent form.
+static NSTimeInterval GMFParseDecimal(const char *p, const char *end) {
+  const char *next = p;
+  NSTimeInterval value = (NSTimeInterval)GMFParseUnsigned(p, end, &next);
+  if (next < end && *next == '.') {
+    NSTimeInterval scale = 0.1;
+    for (p = next + 1; p < end && *p >= '0' && *p <= '9'; p++) {
+      value += (*p - '0') * scale;
+      scale *= 0.1;
+    }
+  }
+  return value;
+}
+
+// Reads the EXT-X-STREAM-INF attributes that |variant| keeps from the list [p, end).
+static void GMFParseVariantAttributes(const char *p, const char *end, GMFHLSVariant *variant) {
+  while (p < end) {
+    const char *name = p;
+    while (p < end && *p != '=') {
+      p++;
+    }
+    const char *nameEnd = p;
+    const char *value = ++p;
+    BOOL quoted = NO;
+    while (p < end && (quoted || *p != ',')) {
+      if (*p == '"') {
+        quoted = !quoted;
+      }
+      p++;
+    }
+    if (GMF_TAG_EQUALS(name, nameEnd, "BANDWIDTH")) {
+      variant->bandwidth = (NSUInteger)GMFParseUnsigned(value, p, NULL);
+    } else if (GMF_TAG_EQUALS(name, nameEnd, "AVERAGE-BANDWIDTH")) {
+      variant->averageBandwidth = (NSUInteger)GMFParseUnsigned(value, p, NULL);
+    } else if (GMF_TAG_EQUALS(name, nameEnd, "RESOLUTION")) {
+      const char *separator = value;
+      variant->width = (NSUInteger)GMFParseUnsigned(value, p, &separator);
+      if (separator < p && (*separator == 'x' || *separator == 'X')) {
+        variant->height = (NSUInteger)GMFParseUnsigned(separator + 1, p, NULL);
+      }
+    }
+    p++;
+  }
+}
+
+@implementation GMFHLSPlaylist {
+  GMFHLSSegment *_segments;
+  NSUInteger _segmentCount;
+  NSUInteger _segmentCapacity;
+  GMFHLSVariant *_variants;
+  NSUInteger _variantCount;
+  NSUInteger _variantCapacity;
+  GMFHLSPlaylistType _playlistType;
+  NSUInteger _discontinuityCount;
+  // Parser state just after the last segment URI line, where a refresh can resume.
+  GMFHLSParserState _resumeState;
+}
+
++ (instancetype)playlistWithData:(NSData *)data baseURL:(NSURL *)baseURL {
+  return [self playlistWithData:data baseURL:baseURL previousPlaylist:nil];
+}
+
++ (instancetype)playlistWithData:(NSData *)data
+                         baseURL:(NSURL *)baseURL
+                previousPlaylist:(GMFHLSPlaylist *)previousPlaylist {
+  return [[self alloc] initWithData:data baseURL:baseURL previousPlaylist:previousPlaylist];
+}
+
+- (instancetype)initWithData:(NSData *)data
+                     baseURL:(NSURL *)baseURL
+            previousPlaylist:(GMFHLSPlaylist *)previousPlaylist {
+  self = [super init];
+  if (self) {
+    _data = [data copy];
+    _baseURL = baseURL;
+    GMFHLSParserState state;
+    if ([self canResumeFromPlaylist:previousPlaylist]) {
+      [self copyHeaderAndSegmentsFromPlaylist:previousPlaylist];
+      state = previousPlaylist->_resumeState;
+      _incrementallyParsed = YES;
+    } else {
+      const char *bytes = [_data bytes];
+      if (!GMF_TAG(bytes, bytes + [_data length], "#EXTM3U")) {
+        return nil;
+      }
+      memset(&state, 0, sizeof(state));
+    }
+    [self parseFromState:&state];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  free(_segments);
+  free(_variants);
+}
+
+- (BOOL)isLive {
+  return _streamType == kGMFHLSStreamTypeLive || _streamType == kGMFHLSStreamTypeDVR;
+}
+
+- (NSUInteger)segmentCount {
+  return _segmentCount;
+}
+
+- (GMFHLSSegment)segmentAtIndex:(NSUInteger)index {
+  NSAssert(index < _segmentCount, @"Segment index %lu out of bounds.", (unsigned long)index);
+  return _segments[index];
+}
+
+- (NSURL *)URLForSegmentAtIndex:(NSUInteger)index {
+  return [self URLWithRange:[self segmentAtIndex:index].URIRange];
+}
+
+- (NSUInteger)segmentIndexForTime:(NSTimeInterval)time {
+  if (!_segmentCount) {
+    return NSNotFound;
+  }
+  // Last segment starting at or before |time|.
+  NSUInteger low = 0;
+  NSUInteger high = _segmentCount;
+  while (low < high) {
+    NSUInteger mid = low + (high - low) / 2;
+    if (_segments[mid].startTime <= time) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low ? low - 1 : 0;
+}
+
+- (NSUInteger)discontinuityCount {
+  return _discontinuityCount;
+}
+
+- (NSUInteger)variantCount {
+  return _variantCount;
+}
+
+- (GMFHLSVariant)variantAtIndex:(NSUInteger)index {
+  NSAssert(index < _variantCount, @"Variant index %lu out of bounds.", (unsigned long)index);
+  return _variants[index];
+}
+
+- (NSURL *)URLForVariantAtIndex:(NSUInteger)index {
+  return [self URLWithRange:[self variantAtIndex:index].URIRange];
+}
+
+- (GMFTimeRange)seekableRange {
+  if (![self isLive]) {
+    return GMFTimeRangeMake(0, _totalDuration);
+  }
+  NSTimeInterval holdBack = kGMFHLSHoldBackTargetDurations * _targetDuration;
+  return GMFTimeRangeMake(0, MAX(0, _totalDuration - holdBack));
+}
+
+#pragma mark Private Methods
+
+- (NSURL *)URLWithRange:(NSRange)range {
+  NSString *URI = [[NSString alloc] initWithBytes:(const char *)[_data bytes] + range.location
+                                           length:range.length
+                                         encoding:NSUTF8StringEncoding];
+  return URI ? [NSURL URLWithString:URI relativeToURL:_baseURL] : nil;
+}
+
+// A refresh can pick up where |previous| stopped if it is a media playlist and |_data| starts
+// with the same bytes up to that point.
+- (BOOL)canResumeFromPlaylist:(GMFHLSPlaylist *)previous {
+  if (!previous || previous->_variantCount || !previous->_segmentCount) {
+    return NO;
+  }
+  NSUInteger prefixLength = previous->_resumeState.offset;
+  return [_data length] >= prefixLength &&
+         memcmp([_data bytes], [previous->_data bytes], prefixLength) == 0;
+}
+
+- (void)copyHeaderAndSegmentsFromPlaylist:(GMFHLSPlaylist *)previous {
+  _targetDuration = previous->_targetDuration;
+  _mediaSequence = previous->_mediaSequence;
+  _playlistType = previous->_playlistType;
+  // Ranges into the previous bytes are valid in |_data| too, since the prefix is identical.
+  [self reserveSegments:previous->_segmentCount + kGMFHLSInitialCapacity];
+  memcpy(_segments, previous->_segments, previous->_segmentCount * sizeof(GMFHLSSegment));
+  _segmentCount = previous->_segmentCount;
+}
+
+- (void)reserveSegments:(NSUInteger)capacity {
+  if (capacity <= _segmentCapacity) {
+    return;
+  }
+  _segmentCapacity = MAX(capacity, _segmentCapacity * 2);
+  _segments = realloc(_segments, _segmentCapacity * sizeof(GMFHLSSegment));
+}
+
+- (void)appendVariant:(GMFHLSVariant)variant {
+  if (_variantCount == _variantCapacity) {
+    _variantCapacity = MAX(kGMFHLSInitialCapacity, _variantCapacity * 2);
+    _variants = realloc(_variants, _variantCapacity * sizeof(GMFHLSVariant));
+  }
+  _variants[_variantCount++] = variant;
+}
+
+- (void)parseFromState:(GMFHLSParserState *)state {
+  const char *bytes = [_data bytes];
+  const char *dataEnd = bytes + [_data length];
+  const char *line = bytes + state->offset;
+  _resumeState = *state;
+
+  while (line < dataEnd) {
+    const char *newline = memchr(line, '\n', (size_t)(dataEnd - line));
+    const char *next = newline ? newline + 1 : dataEnd;
+    const char *end = newline ? newline : dataEnd;
+    if (end > line && end[-1] == '\r') {
+      end--;
+    }
+
+    if (end == line) {
+      // Blank line.
+    } else if (*line != '#') {
+      NSRange URIRange = NSMakeRange((NSUInteger)(line - bytes), (NSUInteger)(end - line));
+      if (state->hasPendingVariant) {
+        state->pendingVariant.URIRange = URIRange;
+        [self appendVariant:state->pendingVariant];
+        state->hasPendingVariant = NO;
+      } else if (state->hasPendingSegment) {
+        [self reserveSegments:_segmentCount + 1];
+        GMFHLSSegment *segment = &_segments[_segmentCount++];
+        segment->URIRange = URIRange;
+        segment->startTime = state->nextStartTime;
+        segment->duration = state->pendingDuration;
+        segment->sequenceNumber = _mediaSequence + state->nextSequenceNumber;
+        segment->discontinuity = state->pendingDiscontinuity;
+        state->nextStartTime += state->pendingDuration;
+        state->nextSequenceNumber++;
+        state->pendingDiscontinuity = NO;
+        state->hasPendingSegment = NO;
+        if (newline) {
+          state->offset = (NSUInteger)(next - bytes);
+          _resumeState = *state;
+        }
+      }
+    } else if (GMF_TAG(line, end, "#EXTINF:")) {
+      state->hasPendingSegment = YES;
+      state->pendingDuration = GMFParseDecimal(line + sizeof("#EXTINF:") - 1, end);
+    } else if (GMF_TAG(line, end, "#EXT-X-STREAM-INF:")) {
+      state->hasPendingVariant = YES;
+      memset(&state->pendingVariant, 0, sizeof(GMFHLSVariant));
+      GMFParseVariantAttributes(line + sizeof("#EXT-X-STREAM-INF:") - 1,
+                                end,
+                                &state->pendingVariant);
+    } else if (GMF_TAG_EQUALS(line, end, "#EXT-X-DISCONTINUITY")) {
+      state->pendingDiscontinuity = YES;
+      state->discontinuityCount++;
+    } else if (GMF_TAG_EQUALS(line, end, "#EXT-X-ENDLIST")) {
+      _hasEndList = YES;
+    } else if (GMF_TAG(line, end, "#EXT-X-TARGETDURATION:")) {
+      _targetDuration = GMFParseDecimal(line + sizeof("#EXT-X-TARGETDURATION:") - 1, end);
+    } else if (GMF_TAG(line, end, "#EXT-X-MEDIA-SEQUENCE:")) {
+      _mediaSequence = (int64_t)GMFParseUnsigned(line + sizeof("#EXT-X-MEDIA-SEQUENCE:") - 1,
+                                                 end,
+                                                 NULL);
+    } else if (GMF_TAG(line, end, "#EXT-X-PLAYLIST-TYPE:")) {
+      const char *value = line + sizeof("#EXT-X-PLAYLIST-TYPE:") - 1;
+      if (GMF_TAG_EQUALS(value, end, "VOD")) {
+        _playlistType = kGMFHLSPlaylistTypeVOD;
+      } else if (GMF_TAG_EQUALS(value, end, "EVENT")) {
+        _playlistType = kGMFHLSPlaylistTypeEvent;
+      }
+    }
+    line = next;
+  }
+
+  _totalDuration = state->nextStartTime;
+  _discontinuityCount = state->discontinuityCount;
+  [self updateStreamType];
+}
+
+- (void)updateStreamType {
+  if (_variantCount) {
+    _streamType = kGMFHLSStreamTypeUnknown;
+  } else if (_hasEndList || _playlistType == kGMFHLSPlaylistTypeVOD) {
+    _streamType = kGMFHLSStreamTypeVOD;
+  } else if (_playlistType == kGMFHLSPlaylistTypeEvent ||
+             _totalDuration >= kGMFHLSMinimumDVRWindow) {
+    _streamType = kGMFHLSStreamTypeDVR;
+  } else {
+    _streamType = kGMFHLSStreamTypeLive;
+  }
+}
+
+@end
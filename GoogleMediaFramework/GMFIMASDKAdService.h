@@ -15,20 +15,29 @@
 #import <GoogleMediaFramework/GoogleMediaFramework.h>
 #import <GoogleInteractiveMediaAds/GoogleInteractiveMediaAds.h>
 
-@interface GMFIMASDKAdService : GMFAdService<IMAAdsLoaderDelegate,
-                                             IMAAdsManagerDelegate,
+@interface GMFIMASDKAdService : GMFAdService<IMAAdsManagerDelegate,
                                              GMFPlayerOverlayViewControllerDelegate> {
  @private
   UIView* _adView;
 }
 
+// Shared by all instances; ad requests go through |sharedAdResponseCache|.
 @property(nonatomic, strong) IMAAdsLoader *adsLoader;
 
 @property(nonatomic, strong) IMAAdsManager *adsManager;
 
 @property(nonatomic, strong) IMAAdDisplayContainer *adDisplayContainer;
 
-// Initiate a request to the ads server for ads associated with the given adtag.
+// Resolved IMA ad responses, shared by all players. Responses are single use and expire after
+// the cache's time to live.
++ (GMFAdResponseCache *)sharedAdResponseCache;
+
+// Resolves the ad tag in the background, so that a later |requestAdsWithRequest:| for it can
+// start the ads without waiting on the ad server. Call for items the user is likely to play next.
++ (void)prefetchAdsWithRequest:(NSString *)request;
+
+// Initiate a request to the ads server for ads associated with the given adtag. Uses a prefetched
+// response if there is one.
 - (void)requestAdsWithRequest:(NSString *)request;
 
 - (void)reset;
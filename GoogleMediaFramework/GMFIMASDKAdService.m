@@ -14,9 +14,116 @@
 
 #import "GMFIMASDKAdService.h"
 #import "GMFContentPlayhead.h"
+#import "GMFTrace.h"
 
 @class GMFPlayerOverlayView;
 
+#pragma mark GMFIMAAdResponse
+
+// An ads manager together with the container and playhead it was requested with. Those are
+// attached to whichever player ends up showing the ads.
+@interface GMFIMAAdResponse : NSObject
+
+@property(nonatomic, strong) IMAAdsManager *adsManager;
+@property(nonatomic, strong) IMAAdDisplayContainer *adDisplayContainer;
+@property(nonatomic, strong) UIView *adContainerView;
+@property(nonatomic, strong) GMFContentPlayhead *contentPlayhead;
+
+@end
+
+@implementation GMFIMAAdResponse
+@end
+
+#pragma mark GMFIMAAdResponseLoader
+
+// Loads ad tags for the shared GMFAdResponseCache through a single IMAAdsLoader. Requests are
+// matched to their results through the request's user context.
+@interface GMFIMAAdResponseLoader : NSObject<GMFAdResponseLoader, IMAAdsLoaderDelegate>
+
+@property(nonatomic, readonly) IMAAdsLoader *adsLoader;
+
+@end
+
+@implementation GMFIMAAdResponseLoader {
+  NSUInteger _lastRequestID;
+  // Request ID to the GMFIMAAdResponse being filled in, and to its completion.
+  NSMutableDictionary *_responses;
+  NSMutableDictionary *_completions;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _adsLoader = [[IMAAdsLoader alloc] initWithSettings:[self createIMASettings]];
+    [_adsLoader setDelegate:self];
+    _responses = [[NSMutableDictionary alloc] init];
+    _completions = [[NSMutableDictionary alloc] init];
+  }
+  return self;
+}
+
+- (IMASettings *)createIMASettings {
+  IMASettings *settings = [[IMASettings alloc] init];
+  settings.language = @"en";
+  settings.playerType = @"google/gmf-ios";
+  settings.playerVersion = @"1.0.0";
+  return settings;
+}
+
+- (void)loadAdResponseForAdTag:(NSString *)adTag completion:(GMFAdResponseCompletion)completion {
+  // The player isn't known yet, so the container and playhead are attached to it later.
+  GMFIMAAdResponse *response = [[GMFIMAAdResponse alloc] init];
+  response.adContainerView = [[UIView alloc] initWithFrame:CGRectZero];
+  response.adDisplayContainer =
+      [[IMAAdDisplayContainer alloc] initWithAdContainer:response.adContainerView
+                                          companionSlots:nil];
+  response.contentPlayhead = [[GMFContentPlayhead alloc] initWithGMFPlayerViewController:nil];
+
+  NSNumber *requestID = @(++_lastRequestID);
+  [_responses setObject:response forKey:requestID];
+  [_completions setObject:[completion copy] forKey:requestID];
+  IMAAdsRequest *adsRequest =
+      [[IMAAdsRequest alloc] initWithAdTagUrl:adTag
+                           adDisplayContainer:response.adDisplayContainer
+                              contentPlayhead:response.contentPlayhead
+                                  userContext:requestID];
+  [_adsLoader requestAdsWithRequest:adsRequest];
+}
+
+#pragma mark IMAAdsLoaderDelegate
+
+- (void)adsLoader:(IMAAdsLoader *)loader adsLoadedWithData:(IMAAdsLoadedData *)adsLoadedData {
+  GMFIMAAdResponse *response = [_responses objectForKey:adsLoadedData.userContext];
+  response.adsManager = adsLoadedData.adsManager;
+  [self finishRequest:adsLoadedData.userContext withResponse:response error:nil];
+}
+
+- (void)adsLoader:(IMAAdsLoader *)loader failedWithErrorData:(IMAAdLoadingErrorData *)adErrorData {
+  NSString *message = adErrorData.adError.message ?: @"";
+  NSError *error = [NSError errorWithDomain:kGMFAdResponseCacheErrorDomain
+                                       code:kGMFAdResponseCacheErrorLoadFailed
+                                   userInfo:@{ NSLocalizedDescriptionKey: message }];
+  [self finishRequest:adErrorData.userContext withResponse:nil error:error];
+}
+
+#pragma mark Private Methods
+
+- (void)finishRequest:(id)requestID
+         withResponse:(GMFIMAAdResponse *)response
+                error:(NSError *)error {
+  GMFAdResponseCompletion completion = [_completions objectForKey:requestID];
+  if (!completion) {
+    return;
+  }
+  [_completions removeObjectForKey:requestID];
+  [_responses removeObjectForKey:requestID];
+  completion(response, error);
+}
+
+@end
+
+#pragma mark GMFIMASDKAdService
+
 @interface GMFIMASDKAdService ()
 @property (nonatomic, strong) UIColor *originalPlayPauseResetBackgroundColor;
 @property (nonatomic, strong) GMFContentPlayhead *contentPlayhead;
@@ -24,50 +131,96 @@
 
 @implementation GMFIMASDKAdService {
   BOOL _hasVideoPlayerControl;
+  NSString *_adTag;
+  // Bumped on every request and reset so that late responses for an old tag are dropped.
+  NSUInteger _requestGeneration;
+}
+
++ (GMFAdResponseCache *)sharedAdResponseCache {
+  static GMFAdResponseCache *sharedCache;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+      sharedCache = [[GMFAdResponseCache alloc] initWithLoader:
+          [[GMFIMAAdResponseLoader alloc] init]];
+  });
+  return sharedCache;
+}
+
++ (void)prefetchAdsWithRequest:(NSString *)request {
+  [[self sharedAdResponseCache] prefetchAdTag:request];
 }
 
 // Designated initializer
 - (instancetype)initWithGMFVideoPlayer:(GMFPlayerViewController *)videoPlayerController {
   self = [super initWithGMFVideoPlayer:videoPlayerController];
   if (self) {
-    self.adsLoader = [[IMAAdsLoader alloc] initWithSettings:[self createIMASettings]];
-    self.adsLoader.delegate = self;
+    GMFIMAAdResponseLoader *loader = [[GMFIMASDKAdService sharedAdResponseCache] loader];
+    self.adsLoader = [loader adsLoader];
   }
   return self;
 }
 
 - (void)requestAdsWithRequest:(NSString *)request {
-  // If there is no view above the rendering view, then there is no ads display container.
-  // Thus, we create one and add it to the video player.
-  if (self.videoPlayerController.playerView.aboveRenderingView == nil) {
-    UIView *view = [[UIView alloc] initWithFrame:self.videoPlayerController.view.bounds];
-    [self.videoPlayerController setAboveRenderingView:view];
-    self.adDisplayContainer = [[IMAAdDisplayContainer alloc] initWithAdContainer:view
-                                                                  companionSlots:nil];
+  _adTag = [request copy];
+  NSUInteger generation = ++_requestGeneration;
+  __weak GMFIMASDKAdService *weakSelf = self;
+  // Resolves synchronously if the tag was prefetched.
+  [[GMFIMASDKAdService sharedAdResponseCache]
+      takeResponseForAdTag:request
+                completion:^(id response, NSError *error) {
+                    [weakSelf adResponseDidLoad:response error:error generation:generation];
+                }];
+}
+
+- (void)adResponseDidLoad:(GMFIMAAdResponse *)response
+                    error:(NSError *)error
+               generation:(NSUInteger)generation {
+  if (generation != _requestGeneration) {
+    return;
   }
+  if (!response) {
+    // Loading failed. The error code is in the trace; export it with GMFTraceExporter.
+    GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "ads.loadError", [error code]);
+
+    // Tell video content to play/resume.
+    [self.videoPlayerController play];
+    return;
+  }
+
+  // The ads display container was created with the request; show it above the content.
+  [self.videoPlayerController setAboveRenderingView:response.adContainerView];
+  self.adDisplayContainer = response.adDisplayContainer;
 
   // GMFContentPlayhead handles listening for time updates from the video player and passing those
   // to the AdsManager.
-  self.contentPlayhead =
-  [[GMFContentPlayhead alloc] initWithGMFPlayerViewController:self.videoPlayerController];
+  self.contentPlayhead = response.contentPlayhead;
+  [self.contentPlayhead setPlayerViewController:self.videoPlayerController];
 
-  IMAAdsRequest *adsRequest = [[IMAAdsRequest alloc] initWithAdTagUrl:request
-                                                   adDisplayContainer:self.adDisplayContainer
-                                                      contentPlayhead:self.contentPlayhead
-                                                          userContext:nil];
+  self.adsManager = response.adsManager;
 
-  [self.adsLoader requestAdsWithRequest:adsRequest];
+  [self.adsManager initializeWithAdsRenderingSettings:nil];
+
+  self.adsManager.delegate = self;
+
+  // The SDK starts its own breaks, but the scheduler still gives subclasses lead-time notice of
+  // each mid-roll. Postrolls are reported as -1 and are dropped by the scheduler.
+  [self scheduleCuePoints:self.adsManager.adCuePoints];
+
+  [self.adsManager start];
 }
 
-- (IMASettings *)createIMASettings {
-  IMASettings *settings = [[IMASettings alloc] init];
-  settings.language = @"en";
-  settings.playerType = @"google/gmf-ios";
-  settings.playerVersion = @"1.0.0";
-  return settings;
+- (void)scheduleCuePoints:(NSArray *)cuePoints {
+  NSUInteger count = [cuePoints count];
+  NSTimeInterval *cueTimes = count ? malloc(count * sizeof(NSTimeInterval)) : NULL;
+  for (NSUInteger i = 0; i < count; i++) {
+    cueTimes[i] = [[cuePoints objectAtIndex:i] doubleValue];
+  }
+  [self.adBreakScheduler setCueTimes:cueTimes count:count];
+  free(cueTimes);
 }
 
 - (void)reset {
+  _requestGeneration++;
   if (self.adsManager) {
     [self.adsManager destroy];
   }
@@ -94,28 +247,6 @@
   }
 }
 
-#pragma mark IMAAdsLoaderDelegate
-
-- (void)adsLoader:(IMAAdsLoader *)loader failedWithErrorData:(IMAAdLoadingErrorData *)adErrorData {
-  // Loading failed, you probably want to log it when this happens.
-  NSLog(@"Ad loading error: %@", adErrorData.adError.message);
-
-  // Tell video content to play/resume.
-  [self.videoPlayerController play];
-}
-
-// Ads are loaded, create the AdsManager and set up the ad frame for displaying ads
-- (void)adsLoader:(IMAAdsLoader *)loader adsLoadedWithData:(IMAAdsLoadedData *)adsLoadedData {
-  // Get the ads manager from ads loaded data.
-  self.adsManager = adsLoadedData.adsManager;
-
-  [self.adsManager initializeWithAdsRenderingSettings:nil];
-
-  self.adsManager.delegate = self;
-
-  [self.adsManager start];
-}
-
 #pragma mark IMAAdsManagerDelegate
 
 - (void)adsManagerDidRequestContentPause:(IMAAdsManager *)adsManager {
@@ -133,7 +264,7 @@
 // Process ad events.
 - (void)adsManager:(IMAAdsManager *)adsManager didReceiveAdEvent:(IMAAdEvent *)event {
   // Perform different actions based on the event type.
-  NSLog(@"** Ad event **: %@", [self adEventAsString:event.type]);
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "ads.event", event.type);
 
   switch (event.type) {
     case kIMAAdEvent_LOADED:
@@ -159,6 +290,10 @@
       // When all ads are done, give control back to the video player.
       [self relinquishControlToVideoPlayer];
       [self.adsManager destroy];
+      // Have a response ready in case the same item is replayed or revisited.
+      if (_adTag) {
+        [GMFIMASDKAdService prefetchAdsWithRequest:_adTag];
+      }
       // TODO: destroy loader (pending IMA SDK bugfix)
       //[self.adsLoader destroy];
       break;
@@ -208,6 +343,7 @@
                                                                       alpha:0.5f]];
   
   _hasVideoPlayerControl = YES;
+  [[playerVc qoeMonitor] adBreakDidStart];
   [self.videoPlayerController pause];
   [self.videoPlayerController setVideoPlayerOverlayDelegate:self];
 }
@@ -230,6 +366,9 @@
   // Show the top bar again.
   [overlayView enableTopBar];
   
+  if (_hasVideoPlayerControl) {
+    [[playerVc qoeMonitor] adBreakDidEnd];
+  }
   _hasVideoPlayerControl = NO;
 }
 
@@ -264,48 +403,5 @@
   // Noop
 }
 
-#pragma mark Debug Methods
-
-// Helper/debug method for displaying ad events in the application log.
-- (NSString *)adEventAsString:(IMAAdEventType)adEventType {
-  switch(adEventType) {
-    case kIMAAdEvent_ALL_ADS_COMPLETED:
-      // All ads managed by the ads manager have completed.
-      return @"All Ads Completed";
-    case kIMAAdEvent_CLICKED:
-      // Ad clicked.
-      return @"Ad Clicked";
-    case kIMAAdEvent_COMPLETE:
-      // Single ad has finished.
-      return @"Complete";
-    case kIMAAdEvent_FIRST_QUARTILE:
-      // First quartile of a linear ad was reached.
-      return @"First quartile reached";
-    case kIMAAdEvent_LOADED:
-      // An ad was loaded.
-      return @"Loaded";
-    case kIMAAdEvent_MIDPOINT:
-      // Midpoint of a linear ad was reached.
-      return @"Midpoint reached";
-    case kIMAAdEvent_PAUSE:
-      // Ad paused.
-      return @"Ad Paused";
-    case kIMAAdEvent_RESUME:
-      // Ad resumed.
-      return @"Ad Resumed";
-    case kIMAAdEvent_TAPPED:
-      // Ad Tapped.
-      return @"Ad Tapped";
-    case kIMAAdEvent_THIRD_QUARTILE:
-      // Third quartile of a linear ad was reached.
-      return @"Third quartile reached";
-    case kIMAAdEvent_STARTED:
-      // Ad has started.
-      return @"Ad Started";
-    default:
-      return @"Invalid Event type";
-  }
-}
-
 @end
 
@@ -0,0 +1,58 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFMemoryGovernor.h"
+
+// Key-value cache bounded by the total cost of its entries. When an insertion takes the total
+// over |costLimit|, least recently used entries are evicted until it fits again. Lookups and
+// insertions are O(1). Unlike NSCache, eviction order is deterministic and hits and misses are
+// counted. Safe to use from any thread.
+//
+// Under memory pressure a warning evicts the least recently used half of the cost and a critical
+// level empties the cache; the cost limit stays. Owners decide whether to register it with a
+// GMFMemoryGovernor.
+@interface GMFLRUCache : NSObject<GMFMemoryPressureResponder>
+
+// Setting a lower limit evicts entries immediately. An entry costing more than the limit is not
+// stored at all.
+@property(nonatomic, assign) NSUInteger costLimit;
+
+@property(nonatomic, readonly) NSUInteger totalCost;
+@property(nonatomic, readonly) NSUInteger count;
+
+@property(nonatomic, readonly) NSUInteger hitCount;
+@property(nonatomic, readonly) NSUInteger missCount;
+@property(nonatomic, readonly) NSUInteger evictionCount;
+
+- (instancetype)initWithCostLimit:(NSUInteger)costLimit;
+
+// Returns nil on a miss. A hit marks the entry as most recently used.
+- (id)objectForKey:(id<NSCopying>)key;
+
+- (void)setObject:(id)object forKey:(id<NSCopying>)key cost:(NSUInteger)cost;
+
+- (void)removeObjectForKey:(id<NSCopying>)key;
+
+- (void)removeAllObjects;
+
+// Evicts least recently used entries until the total cost is at most |cost|, without changing
+// |costLimit|.
+- (void)trimToCost:(NSUInteger)cost;
+
+// Zeroes the hit, miss and eviction counters.
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,213 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import <pthread.h>
+
+#import "GMFLRUCache.h"
+
+// Node of the recency list. The dictionary owns the entries; the list links are unretained.
+@interface GMFLRUCacheEntry : NSObject {
+ @public
+  id<NSCopying> _key;
+  id _object;
+  NSUInteger _cost;
+  __unsafe_unretained GMFLRUCacheEntry *_previous;
+  __unsafe_unretained GMFLRUCacheEntry *_next;
+}
+@end
+
+@implementation GMFLRUCacheEntry
+@end
+
+@implementation GMFLRUCache {
+  pthread_mutex_t _lock;
+  NSMutableDictionary *_entries;
+  // Most recently used end of the list.
+  __unsafe_unretained GMFLRUCacheEntry *_head;
+  // Least recently used end of the list; evicted first.
+  __unsafe_unretained GMFLRUCacheEntry *_tail;
+}
+
+- (instancetype)init {
+  return [self initWithCostLimit:NSUIntegerMax];
+}
+
+- (instancetype)initWithCostLimit:(NSUInteger)costLimit {
+  self = [super init];
+  if (self) {
+    pthread_mutex_init(&_lock, NULL);
+    _entries = [[NSMutableDictionary alloc] init];
+    _costLimit = costLimit;
+  }
+  return self;
+}
+
+- (void)dealloc {
+  pthread_mutex_destroy(&_lock);
+}
+
+- (void)setCostLimit:(NSUInteger)costLimit {
+  pthread_mutex_lock(&_lock);
+  _costLimit = costLimit;
+  [self evictToFitCost:0];
+  pthread_mutex_unlock(&_lock);
+}
+
+- (NSUInteger)count {
+  pthread_mutex_lock(&_lock);
+  NSUInteger count = [_entries count];
+  pthread_mutex_unlock(&_lock);
+  return count;
+}
+
+- (id)objectForKey:(id<NSCopying>)key {
+  pthread_mutex_lock(&_lock);
+  GMFLRUCacheEntry *entry = [_entries objectForKey:key];
+  id object = nil;
+  if (entry) {
+    _hitCount++;
+    [self unlinkEntry:entry];
+    [self linkEntryAtHead:entry];
+    object = entry->_object;
+  } else {
+    _missCount++;
+  }
+  pthread_mutex_unlock(&_lock);
+  return object;
+}
+
+- (void)setObject:(id)object forKey:(id<NSCopying>)key cost:(NSUInteger)cost {
+  NSAssert(object, @"Cannot cache a nil object.");
+  pthread_mutex_lock(&_lock);
+  [self removeEntryForKey:key];
+  if (cost <= _costLimit) {
+    [self evictToFitCost:cost];
+    GMFLRUCacheEntry *entry = [[GMFLRUCacheEntry alloc] init];
+    entry->_key = [key copyWithZone:NULL];
+    entry->_object = object;
+    entry->_cost = cost;
+    [_entries setObject:entry forKey:entry->_key];
+    [self linkEntryAtHead:entry];
+    _totalCost += cost;
+  }
+  pthread_mutex_unlock(&_lock);
+}
+
+- (void)removeObjectForKey:(id<NSCopying>)key {
+  pthread_mutex_lock(&_lock);
+  [self removeEntryForKey:key];
+  pthread_mutex_unlock(&_lock);
+}
+
+- (void)removeAllObjects {
+  pthread_mutex_lock(&_lock);
+  _head = nil;
+  _tail = nil;
+  _totalCost = 0;
+  [_entries removeAllObjects];
+  pthread_mutex_unlock(&_lock);
+}
+
+- (void)trimToCost:(NSUInteger)cost {
+  pthread_mutex_lock(&_lock);
+  [self evictToTotalCost:cost];
+  pthread_mutex_unlock(&_lock);
+}
+
+- (void)resetStatistics {
+  pthread_mutex_lock(&_lock);
+  _hitCount = 0;
+  _missCount = 0;
+  _evictionCount = 0;
+  pthread_mutex_unlock(&_lock);
+}
+
+#pragma mark GMFMemoryPressureResponder
+
+- (void)trimMemoryForPressureLevel:(GMFMemoryPressureLevel)level {
+  if (level == kGMFMemoryPressureLevelCritical) {
+    [self removeAllObjects];
+  } else if (level == kGMFMemoryPressureLevelWarning) {
+    pthread_mutex_lock(&_lock);
+    [self evictToTotalCost:_totalCost / 2];
+    pthread_mutex_unlock(&_lock);
+  }
+}
+
+- (uint64_t)estimatedMemoryCost {
+  pthread_mutex_lock(&_lock);
+  NSUInteger cost = _totalCost;
+  pthread_mutex_unlock(&_lock);
+  return cost;
+}
+
+#pragma mark Private Methods
+
+// The methods below expect |_lock| to be held.
+
+- (void)evictToFitCost:(NSUInteger)cost {
+  [self evictToTotalCost:cost <= _costLimit ? _costLimit - cost : 0];
+}
+
+- (void)evictToTotalCost:(NSUInteger)totalCost {
+  while (_tail && _totalCost > totalCost) {
+    _evictionCount++;
+    // Hold on to the key; removing the entry releases it.
+    id<NSCopying> key = _tail->_key;
+    [self removeEntryForKey:key];
+  }
+}
+
+- (void)removeEntryForKey:(id<NSCopying>)key {
+  GMFLRUCacheEntry *entry = [_entries objectForKey:key];
+  if (!entry) {
+    return;
+  }
+  [self unlinkEntry:entry];
+  _totalCost -= entry->_cost;
+  [_entries removeObjectForKey:key];
+}
+
+- (void)linkEntryAtHead:(GMFLRUCacheEntry *)entry {
+  entry->_previous = nil;
+  entry->_next = _head;
+  if (_head) {
+    _head->_previous = entry;
+  }
+  _head = entry;
+  if (!_tail) {
+    _tail = entry;
+  }
+}
+
+- (void)unlinkEntry:(GMFLRUCacheEntry *)entry {
+  if (entry->_previous) {
+    entry->_previous->_next = entry->_next;
+  } else {
+    _head = entry->_next;
+  }
+  if (entry->_next) {
+    entry->_next->_previous = entry->_previous;
+  } else {
+    _tail = entry->_previous;
+  }
+  entry->_previous = nil;
+  entry->_next = nil;
+}
+
+@end
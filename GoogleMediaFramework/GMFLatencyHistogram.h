@@ -0,0 +1,67 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+// Summary of a histogram at one point in time. All fields are 0 for an empty histogram.
+typedef struct {
+  uint64_t count;
+  double minimum;
+  double maximum;
+  double mean;
+  double p50;
+  double p95;
+  double p99;
+} GMFHistogramSnapshot;
+
+// Histogram of non-negative values in log-scaled buckets: each power of two above
+// |lowestValue| is split into 16 linear sub-buckets, so any recorded value is reported to within
+// about 3% wherever it falls in the range. Values below |lowestValue| share one bucket and values
+// above |highestValue| are counted in the top bucket; minimum, maximum and mean are exact.
+// Percentiles that fall below |lowestValue| are reported as the minimum, and those that fall in
+// the top bucket after a value past |highestValue| as the maximum.
+//
+// The buckets are allocated once at init, so recording is a few arithmetic operations and an
+// increment, with no allocation. Not thread safe.
+@interface GMFLatencyHistogram : NSObject
+
+@property(nonatomic, readonly) double lowestValue;
+@property(nonatomic, readonly) double highestValue;
+
+@property(nonatomic, readonly) uint64_t count;
+@property(nonatomic, readonly) double sum;
+@property(nonatomic, readonly) double minimum;
+@property(nonatomic, readonly) double maximum;
+
+// Both must be positive and |highestValue| larger than |lowestValue|.
+- (instancetype)initWithLowestValue:(double)lowestValue highestValue:(double)highestValue;
+
+// Negative values are recorded as 0.
+- (void)recordValue:(double)value;
+
+// Adds the counts of |histogram|, which must have the same lowest and highest values.
+- (void)addHistogram:(GMFLatencyHistogram *)histogram;
+
+- (double)mean;
+
+// Value at or below which |percentile| percent of the recorded values fall, for |percentile| in
+// [0, 100]. Returns 0 for an empty histogram.
+- (double)valueAtPercentile:(double)percentile;
+
+// Walks the buckets once to fill in all percentiles.
+- (GMFHistogramSnapshot)snapshot;
+
+- (void)reset;
+
+@end
@@ -0,0 +1,173 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import <math.h>
+
+#import "GMFLatencyHistogram.h"
+
+// Linear sub-buckets per power of two.
+static const int kGMFSubBucketCount = 16;
+
+@implementation GMFLatencyHistogram {
+  // Bucket 0 holds values below |_lowestValue|; bucket 1 + k * 16 + s holds values in the s-th
+  // sixteenth of [lowest * 2^k, lowest * 2^(k + 1)).
+  uint64_t *_buckets;
+  NSUInteger _bucketCount;
+}
+
+- (instancetype)initWithLowestValue:(double)lowestValue highestValue:(double)highestValue {
+  NSParameterAssert(lowestValue > 0 && highestValue > lowestValue);
+  self = [super init];
+  if (self) {
+    _lowestValue = lowestValue;
+    _highestValue = highestValue;
+    NSUInteger powers = (NSUInteger)ceil(log2(highestValue / lowestValue));
+    _bucketCount = 1 + MAX(powers, (NSUInteger)1) * kGMFSubBucketCount;
+    _buckets = calloc(_bucketCount, sizeof(uint64_t));
+  }
+  return self;
+}
+
+- (void)dealloc {
+  free(_buckets);
+}
+
+- (void)recordValue:(double)value {
+  if (!(value > 0)) {
+    // Also catches NaN.
+    value = 0;
+  }
+  _buckets[[self bucketIndexForValue:value]]++;
+  if (!_count || value < _minimum) {
+    _minimum = value;
+  }
+  if (!_count || value > _maximum) {
+    _maximum = value;
+  }
+  _count++;
+  _sum += value;
+}
+
+- (void)addHistogram:(GMFLatencyHistogram *)histogram {
+  NSParameterAssert([histogram lowestValue] == _lowestValue &&
+                    [histogram highestValue] == _highestValue);
+  if (![histogram count]) {
+    return;
+  }
+  for (NSUInteger i = 0; i < _bucketCount; i++) {
+    _buckets[i] += histogram->_buckets[i];
+  }
+  _minimum = _count ? MIN(_minimum, [histogram minimum]) : [histogram minimum];
+  _maximum = _count ? MAX(_maximum, [histogram maximum]) : [histogram maximum];
+  _count += [histogram count];
+  _sum += [histogram sum];
+}
+
+- (double)mean {
+  return _count ? _sum / _count : 0;
+}
+
+- (double)valueAtPercentile:(double)percentile {
+  double percentiles[] = { percentile };
+  double value = 0;
+  [self fillValues:&value atPercentiles:percentiles count:1];
+  return value;
+}
+
+- (GMFHistogramSnapshot)snapshot {
+  GMFHistogramSnapshot snapshot = { 0, 0, 0, 0, 0, 0, 0 };
+  if (!_count) {
+    return snapshot;
+  }
+  double percentiles[] = { 50, 95, 99 };
+  double values[3];
+  [self fillValues:values atPercentiles:percentiles count:3];
+  snapshot.count = _count;
+  snapshot.minimum = _minimum;
+  snapshot.maximum = _maximum;
+  snapshot.mean = [self mean];
+  snapshot.p50 = values[0];
+  snapshot.p95 = values[1];
+  snapshot.p99 = values[2];
+  return snapshot;
+}
+
+- (void)reset {
+  memset(_buckets, 0, _bucketCount * sizeof(uint64_t));
+  _count = 0;
+  _sum = 0;
+  _minimum = 0;
+  _maximum = 0;
+}
+
+#pragma mark Private Methods
+
+- (NSUInteger)bucketIndexForValue:(double)value {
+  if (value < _lowestValue) {
+    return 0;
+  }
+  // value / lowest = mantissa * 2^exponent, with mantissa in [0.5, 1).
+  int exponent;
+  double mantissa = frexp(value / _lowestValue, &exponent);
+  NSUInteger index = 1 + (NSUInteger)(exponent - 1) * kGMFSubBucketCount +
+                     (NSUInteger)((mantissa * 2 - 1) * kGMFSubBucketCount);
+  return MIN(index, _bucketCount - 1);
+}
+
+- (double)lowerBoundOfBucket:(NSUInteger)index {
+  if (index == 0) {
+    return 0;
+  }
+  NSUInteger power = (index - 1) / kGMFSubBucketCount;
+  NSUInteger subBucket = (index - 1) % kGMFSubBucketCount;
+  return ldexp(_lowestValue * (1 + (double)subBucket / kGMFSubBucketCount), (int)power);
+}
+
+// |percentiles| must be ascending. Each value is the midpoint of the bucket holding the value of
+// that rank, clamped to the exact minimum and maximum.
+- (void)fillValues:(double *)values atPercentiles:(const double *)percentiles count:(NSUInteger)count {
+  if (!_count) {
+    for (NSUInteger i = 0; i < count; i++) {
+      values[i] = 0;
+    }
+    return;
+  }
+  uint64_t seen = 0;
+  NSUInteger bucket = 0;
+  for (NSUInteger i = 0; i < count; i++) {
+    double fraction = MIN(MAX(percentiles[i], 0), 100) / 100;
+    uint64_t rank = MAX((uint64_t)ceil(fraction * _count), (uint64_t)1);
+    while (seen + _buckets[bucket] < rank) {
+      seen += _buckets[bucket];
+      bucket++;
+    }
+    double value;
+    if (bucket == 0) {
+      // Everything below |_lowestValue| is reported as the minimum, so counts of 0 stay 0.
+      value = _minimum;
+    } else if (bucket == _bucketCount - 1 && _maximum >= [self lowerBoundOfBucket:bucket + 1]) {
+      // The top bucket holds everything past |_highestValue|, so its midpoint means nothing.
+      value = _maximum;
+    } else {
+      value = ([self lowerBoundOfBucket:bucket] + [self lowerBoundOfBucket:bucket + 1]) / 2;
+    }
+    values[i] = MIN(MAX(value, _minimum), _maximum);
+  }
+}
+
+@end
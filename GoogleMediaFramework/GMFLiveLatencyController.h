@@ -0,0 +1,114 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#import <Foundation/Foundation.h>
+
+#import "GMFClock.h"
+#import "GMFLatencyHistogram.h"
+#import "GMFTimeRangeSet.h"
+
+@class GMFLiveLatencyController;
+
+@protocol GMFLiveLatencyControllerDelegate<NSObject>
+
+// Play at |rate| from now on; 1 outside of a correction.
+- (void)liveLatencyController:(GMFLiveLatencyController *)controller
+        didChangePlaybackRate:(float)rate;
+
+// Playback fell too far behind to catch up by speeding up. Seek to |time|, the target latency
+// behind the live edge, and keep playing.
+- (void)liveLatencyController:(GMFLiveLatencyController *)controller
+             shouldJumpToTime:(NSTimeInterval)time;
+
+@end
+
+// Holds live playback at a target latency behind the live edge. Feed it the item's seekable
+// window and the playhead, e.g. every second while playing. Playback a little off the target is
+// nudged back by playing slightly faster or slower, within |minimumRate| and |maximumRate|;
+// playback more than |jumpThreshold| behind it, after stalls, jumps back to it.
+//
+// The live edge is the end of the seekable window, the live point AVFoundation joins at. The
+// window grows a segment at a time as the playlist is refreshed, so between refreshes the edge is
+// estimated to advance with the clock, by at most the last step the window took, or 10 seconds
+// before the first. Latency is measured against that estimate and doesn't jump with every
+// refresh.
+//
+// A viewer who seeks or pauses further behind than |jumpThreshold| is watching the DVR window on
+// purpose: playback is left alone until the viewer comes back within it. Main thread only.
+@interface GMFLiveLatencyController : NSObject
+
+@property(nonatomic, weak) id<GMFLiveLatencyControllerDelegate> delegate;
+
+// Seconds behind the live edge to hold playback at. Defaults to 0, the live point itself.
+@property(nonatomic, assign) NSTimeInterval targetLatency;
+
+// Latency within this of the target is left alone. Once a correction starts, it carries on
+// until the latency is back on the target. Defaults to 0.5 seconds.
+@property(nonatomic, assign) NSTimeInterval tolerance;
+
+// Bounds of the correcting playback rate. Default to 0.95 and 1.05, too close to 1 to be heard.
+@property(nonatomic, assign) float minimumRate;
+@property(nonatomic, assign) float maximumRate;
+
+// Seconds behind the target beyond which playback jumps instead of catching up. Defaults to 10.
+@property(nonatomic, assign) NSTimeInterval jumpThreshold;
+
+// Whether the controller holds playback at the target: NO until the seekable window is known and
+// while the viewer watches further behind, until the viewer moves the playhead near live again.
+@property(nonatomic, readonly, getter=isTracking) BOOL tracking;
+
+@property(nonatomic, readonly) float playbackRate;
+
+// Last window passed to |updateSeekableRange:|; empty before the first.
+@property(nonatomic, readonly) GMFTimeRange seekableRange;
+
+// Seconds between the estimated live edge and the last playhead update; 0 before both are known.
+@property(nonatomic, readonly) NSTimeInterval latency;
+
+// Latency at each playhead update while tracking, in seconds.
+@property(nonatomic, readonly) GMFLatencyHistogram *latencyHistogram;
+
+// Jumps asked for and playback rate changes since the last reset.
+@property(nonatomic, readonly) NSUInteger jumpCount;
+@property(nonatomic, readonly) NSUInteger rateChangeCount;
+
+// Uses the shared GMFTimerWheel.
+- (instancetype)init;
+
+// |clock| times the growth of the live edge.
+- (instancetype)initWithClock:(id<GMFClock>)clock;
+
+// The item's current seekable window. Empty windows are ignored.
+- (void)updateSeekableRange:(GMFTimeRange)range;
+
+// Where playback is. Adjusts the rate or asks for a jump, once the playhead is seen to move: an
+// update at the same media time as the last, e.g. while stalled, only measures the latency.
+- (void)updateWithMediaTime:(NSTimeInterval)mediaTime;
+
+// The viewer sought or paused. The next update decides from where playback then is whether the
+// viewer is still watching live.
+- (void)viewerDidMovePlayhead;
+
+// Live edge estimated for now; 0 before the seekable window is known.
+- (NSTimeInterval)liveEdgeTime;
+
+// Where to seek to join the stream at the target latency, within the seekable window.
+- (NSTimeInterval)liveTargetTime;
+
+// Forgets the window, the playhead, the counts and the histogram, and goes back to rate 1 without
+// telling the delegate, for a new stream.
+- (void)reset;
+
+@end
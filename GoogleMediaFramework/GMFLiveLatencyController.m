@@ -0,0 +1,197 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFLiveLatencyController.h"
+#import "GMFTimerWheel.h"
+
+static const NSTimeInterval kGMFLiveLatencyDefaultTargetLatency = 0;
+static const NSTimeInterval kGMFLiveLatencyDefaultTolerance = 0.5;
+static const float kGMFLiveLatencyDefaultMinimumRate = 0.95f;
+static const float kGMFLiveLatencyDefaultMaximumRate = 1.05f;
+static const NSTimeInterval kGMFLiveLatencyDefaultJumpThreshold = 10;
+
+// Rate change per second of drift while correcting, before the rate bounds apply.
+static const double kGMFLiveLatencyCorrectionGain = 0.1;
+
+// Drift at which a correction is done.
+static const NSTimeInterval kGMFLiveLatencySettledDrift = 0.1;
+
+// Rates are rounded to this, so a correction changes the rate a handful of times rather than on
+// every update.
+static const float kGMFLiveLatencyRateStep = 0.01f;
+
+// Cap on how far the live edge is estimated past the end of the window, however large the last
+// step was, e.g. after playback resumed from a long stall, and before the first step.
+static const NSTimeInterval kGMFLiveEdgeMaximumExtrapolation = 10;
+
+static const double kGMFLiveLatencyLowestValue = 0.01;
+static const double kGMFLiveLatencyHighestValue = 3600;
+
+@implementation GMFLiveLatencyController {
+  id<GMFClock> _clock;
+  BOOL _hasSeekableRange;
+  // End of the window when it last moved, and the clock time then.
+  NSTimeInterval _edgeAnchorTime;
+  NSTimeInterval _edgeAnchorClockTime;
+  // How far the edge may be estimated past |_edgeAnchorTime|: the window's last step.
+  NSTimeInterval _edgeExtrapolationLimit;
+  BOOL _correcting;
+  // Playhead at the last update, to tell whether playback is moving.
+  NSTimeInterval _lastMediaTime;
+  BOOL _hasMediaTime;
+  // Set by |viewerDidMovePlayhead| until the next update.
+  BOOL _viewerMovedPlayhead;
+  // The viewer last moved the playhead further behind than the jump threshold.
+  BOOL _watchingBehindLive;
+}
+
+- (instancetype)init {
+  return [self initWithClock:[GMFTimerWheel sharedWheel]];
+}
+
+- (instancetype)initWithClock:(id<GMFClock>)clock {
+  self = [super init];
+  if (self) {
+    _clock = clock;
+    _targetLatency = kGMFLiveLatencyDefaultTargetLatency;
+    _tolerance = kGMFLiveLatencyDefaultTolerance;
+    _minimumRate = kGMFLiveLatencyDefaultMinimumRate;
+    _maximumRate = kGMFLiveLatencyDefaultMaximumRate;
+    _jumpThreshold = kGMFLiveLatencyDefaultJumpThreshold;
+    _playbackRate = 1;
+    _latencyHistogram =
+        [[GMFLatencyHistogram alloc] initWithLowestValue:kGMFLiveLatencyLowestValue
+                                            highestValue:kGMFLiveLatencyHighestValue];
+  }
+  return self;
+}
+
+- (void)updateSeekableRange:(GMFTimeRange)range {
+  if (!(range.end > range.start)) {
+    return;
+  }
+  NSTimeInterval now = [_clock now];
+  if (!_hasSeekableRange || range.end != _seekableRange.end) {
+    if (!_hasSeekableRange) {
+      // The segment duration isn't known until the window steps.
+      _edgeExtrapolationLimit = kGMFLiveEdgeMaximumExtrapolation;
+    } else if (range.end > _seekableRange.end) {
+      _edgeExtrapolationLimit =
+          MIN(range.end - _seekableRange.end, kGMFLiveEdgeMaximumExtrapolation);
+    }
+    _edgeAnchorTime = range.end;
+    _edgeAnchorClockTime = now;
+  }
+  _seekableRange = range;
+  _hasSeekableRange = YES;
+}
+
+- (void)updateWithMediaTime:(NSTimeInterval)mediaTime {
+  if (!_hasSeekableRange) {
+    return;
+  }
+  _latency = [self liveEdgeTime] - mediaTime;
+  NSTimeInterval drift = _latency - _targetLatency;
+  BOOL playheadMoved = _hasMediaTime && mediaTime != _lastMediaTime;
+  _lastMediaTime = mediaTime;
+  _hasMediaTime = YES;
+  if (_viewerMovedPlayhead) {
+    _viewerMovedPlayhead = NO;
+    _watchingBehindLive = drift > _jumpThreshold;
+    _correcting = NO;
+  }
+  if (_watchingBehindLive) {
+    [self setPlaybackRate:1];
+    return;
+  }
+  [_latencyHistogram recordValue:_latency];
+  if (!playheadMoved) {
+    // Stalled or seeking: neither a rate nor a jump would get playback going sooner.
+    return;
+  }
+
+  if (drift > _jumpThreshold) {
+    _correcting = NO;
+    [self setPlaybackRate:1];
+    _jumpCount++;
+    [_delegate liveLatencyController:self shouldJumpToTime:[self liveTargetTime]];
+    return;
+  }
+  if (!_correcting && fabs(drift) > _tolerance) {
+    _correcting = YES;
+  } else if (_correcting && fabs(drift) < kGMFLiveLatencySettledDrift) {
+    _correcting = NO;
+  }
+  float rate = 1;
+  if (_correcting) {
+    rate = (float)(1 + kGMFLiveLatencyCorrectionGain * drift);
+    rate = roundf(rate / kGMFLiveLatencyRateStep) * kGMFLiveLatencyRateStep;
+    rate = MIN(MAX(rate, _minimumRate), _maximumRate);
+  }
+  [self setPlaybackRate:rate];
+}
+
+- (BOOL)isTracking {
+  return _hasSeekableRange && !_watchingBehindLive;
+}
+
+- (void)viewerDidMovePlayhead {
+  _viewerMovedPlayhead = YES;
+}
+
+- (NSTimeInterval)liveEdgeTime {
+  if (!_hasSeekableRange) {
+    return 0;
+  }
+  NSTimeInterval elapsed = MAX(0, [_clock now] - _edgeAnchorClockTime);
+  return _edgeAnchorTime + MIN(elapsed, _edgeExtrapolationLimit);
+}
+
+- (NSTimeInterval)liveTargetTime {
+  NSTimeInterval time = [self liveEdgeTime] - _targetLatency;
+  return MIN(MAX(time, _seekableRange.start), _seekableRange.end);
+}
+
+- (void)reset {
+  _hasSeekableRange = NO;
+  _seekableRange = GMFTimeRangeMake(0, 0);
+  _edgeExtrapolationLimit = 0;
+  _latency = 0;
+  _hasMediaTime = NO;
+  _watchingBehindLive = NO;
+  _correcting = NO;
+  _viewerMovedPlayhead = NO;
+  _playbackRate = 1;
+  _jumpCount = 0;
+  _rateChangeCount = 0;
+  [_latencyHistogram reset];
+}
+
+#pragma mark Private Methods
+
+- (void)setPlaybackRate:(float)playbackRate {
+  if (playbackRate == _playbackRate) {
+    return;
+  }
+  _playbackRate = playbackRate;
+  _rateChangeCount++;
+  [_delegate liveLatencyController:self didChangePlaybackRate:playbackRate];
+}
+
+@end
@@ -0,0 +1,153 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFMemoryGovernor.h"
+
+extern NSString *const kGMFMediaCacheErrorDomain;
+
+typedef enum {
+  // The server answered with an HTTP error status. The status code is in the userInfo under
+  // kGMFMediaCacheHTTPStatusCodeKey.
+  kGMFMediaCacheErrorHTTPStatus = 1,
+  // The server's answer didn't cover the requested range.
+  kGMFMediaCacheErrorBadRange
+} GMFMediaCacheError;
+
+extern NSString *const kGMFMediaCacheHTTPStatusCodeKey;
+
+// |length| of a range that extends to the end of the resource.
+extern const int64_t kGMFByteRangeToEnd;
+
+typedef struct {
+  int64_t offset;
+  int64_t length;
+} GMFByteRange;
+
+static inline GMFByteRange GMFByteRangeMake(int64_t offset, int64_t length) {
+  GMFByteRange range = { offset, length };
+  return range;
+}
+
+@interface GMFMediaCacheResponse : NSObject
+
+// For a hit, maps the cache file directly rather than copying it.
+@property(nonatomic, readonly) NSData *data;
+@property(nonatomic, readonly) NSString *MIMEType;
+
+// Length of the whole resource, or -1 if the server didn't say.
+@property(nonatomic, readonly) int64_t totalLength;
+
+@property(nonatomic, readonly, getter=isFromCache) BOOL fromCache;
+
+@end
+
+// Exactly one of |response| and |error| is non-nil.
+typedef void (^GMFMediaCacheCompletion)(GMFMediaCacheResponse *response, NSError *error);
+
+// Handlers of a streamed load. |totalLength| is -1 if the server didn't say. |error| is nil once
+// the whole range has been handed out.
+typedef void (^GMFMediaCacheResponseHandler)(NSString *MIMEType, int64_t totalLength);
+typedef void (^GMFMediaCacheDataHandler)(NSData *data);
+typedef void (^GMFMediaCacheStreamCompletion)(NSError *error);
+
+// Persistent cache of media responses keyed by URL and byte range, so replays, seeks back and
+// reopened videos are served from disk instead of the network.
+//
+// Responses are appended to large fixed-size slab files that are memory-mapped, so a write is a
+// memcpy and a hit hands out the mapped bytes without reading or copying them. Eviction is LRU
+// at slab granularity: when a new slab would take the cache over |diskBudget|, the least recently
+// read slab is deleted with all its responses. A slab file is only unmapped once no response
+// data handed out from it is alive. The index is rebuilt from the slabs when the cache is
+// opened, so it survives relaunches.
+//
+// Playlists are never stored, since live ones change on every refresh. Responses larger than a
+// slab aren't stored either; a streamed load stops keeping a copy of the body once it outgrows a
+// slab. Main thread only.
+//
+// The memory it holds is the resident pages of the mapped slabs. Registers with the shared
+// GMFMemoryGovernor: a warning writes back and drops the pages of all slabs but the one being
+// written, and a critical level those of every slab. Nothing is deleted; dropped pages are read
+// from the files again on the next hit.
+@interface GMFMediaCache : NSObject<GMFMemoryPressureResponder>
+
+@property(nonatomic, readonly) NSString *directory;
+
+@property(nonatomic, readonly) NSUInteger slabSize;
+
+// Setting a lower budget evicts slabs immediately. Budgets below one slab disable storing.
+@property(nonatomic, assign) uint64_t diskBudget;
+
+// Space taken by slab files.
+@property(nonatomic, readonly) uint64_t diskUsage;
+
+@property(nonatomic, readonly) NSUInteger responseCount;
+
+// Lookups answered from disk and lookups that went to the network.
+@property(nonatomic, readonly) NSUInteger hitCount;
+@property(nonatomic, readonly) NSUInteger missCount;
+
+// Bytes served from disk, i.e. not downloaded again.
+@property(nonatomic, readonly) uint64_t bytesSaved;
+
+// Bytes written to disk.
+@property(nonatomic, readonly) uint64_t bytesStored;
+
+// In the Caches directory, with a 256 MB budget.
++ (instancetype)sharedCache;
+
+// Uses 16 MB slabs.
+- (instancetype)initWithDirectory:(NSString *)directory diskBudget:(uint64_t)diskBudget;
+
+- (instancetype)initWithDirectory:(NSString *)directory
+                       diskBudget:(uint64_t)diskBudget
+                         slabSize:(NSUInteger)slabSize;
+
+// |hitCount| over all lookups; 0 before the first one.
+- (double)hitRatio;
+
+// Returns the stored response for exactly this URL and range, or nil. Counts as a hit or miss.
+- (GMFMediaCacheResponse *)cachedResponseForURL:(NSURL *)URL range:(GMFByteRange)range;
+
+// Returns NO if the response wasn't stored because it is a playlist, empty or too large.
+- (BOOL)storeData:(NSData *)data
+         MIMEType:(NSString *)MIMEType
+      totalLength:(int64_t)totalLength
+           forURL:(NSURL *)URL
+            range:(GMFByteRange)range;
+
+// Answers from disk if possible, synchronously; otherwise requests the range from the network,
+// stores the response and calls |completion| on the main thread.
+- (void)loadURL:(NSURL *)URL range:(GMFByteRange)range completion:(GMFMediaCacheCompletion)completion;
+
+// Like |loadURL:range:completion:|, but hands out the body as it arrives instead of once it is
+// complete: |responseHandler| once, then |dataHandler| for each part of the range in order, then
+// |completion|. A hit calls all three synchronously and returns nil. Otherwise returns a handle
+// for |cancelLoad:|. An error before the response calls |completion| alone.
+- (id)streamURL:(NSURL *)URL
+              range:(GMFByteRange)range
+    responseHandler:(GMFMediaCacheResponseHandler)responseHandler
+        dataHandler:(GMFMediaCacheDataHandler)dataHandler
+         completion:(GMFMediaCacheStreamCompletion)completion;
+
+// Stops a streamed load without calling its handlers again. Nothing is stored.
+- (void)cancelLoad:(id)handle;
+
+// Deletes every slab.
+- (void)removeAllResponses;
+
+- (void)resetStatistics;
+
+@end
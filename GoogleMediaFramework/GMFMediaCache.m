@@ -0,0 +1,901 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFMediaCache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+NSString *const kGMFMediaCacheErrorDomain = @"GMFMediaCacheErrorDomain";
+NSString *const kGMFMediaCacheHTTPStatusCodeKey = @"GMFMediaCacheHTTPStatusCode";
+const int64_t kGMFByteRangeToEnd = -1;
+
+static const NSUInteger kGMFMediaCacheDefaultSlabSize = 16 * 1024 * 1024;
+static const uint64_t kGMFMediaCacheSharedDiskBudget = 256 * 1024 * 1024;
+
+static NSString *const kGMFSlabExtension = @"slab";
+
+// Marks a completely written record. Written last, so a record cut short by a crash ends the
+// slab's scan instead of being read.
+static const uint32_t kGMFSlabRecordMagic = 0x31454d47;
+
+// A slab's modification date is its last access across launches. Updating it on every hit would
+// cost a syscall per segment, so it is updated at most this often.
+static const NSTimeInterval kGMFSlabTouchInterval = 10;
+
+// Followed by the key and MIME type, then the data at the next 8 byte boundary.
+typedef struct {
+  uint32_t magic;
+  uint32_t keyLength;
+  uint32_t MIMETypeLength;
+  uint32_t reserved;
+  int64_t dataLength;
+  int64_t totalLength;
+} GMFSlabRecordHeader;
+
+static size_t GMFAlign8(size_t size) {
+  return (size + 7) & ~(size_t)7;
+}
+
+static NSTimeInterval GMFCurrentTime(void) {
+  return [NSDate timeIntervalSinceReferenceDate];
+}
+
+#pragma mark -
+#pragma mark GMFMediaCacheResponse
+
+@interface GMFMediaCacheResponse ()
+
+- (instancetype)initWithData:(NSData *)data
+                    MIMEType:(NSString *)MIMEType
+                 totalLength:(int64_t)totalLength
+                   fromCache:(BOOL)fromCache;
+
+@end
+
+@implementation GMFMediaCacheResponse
+
+- (instancetype)initWithData:(NSData *)data
+                    MIMEType:(NSString *)MIMEType
+                 totalLength:(int64_t)totalLength
+                   fromCache:(BOOL)fromCache {
+  self = [super init];
+  if (self) {
+    _data = data;
+    _MIMEType = [MIMEType copy];
+    _totalLength = totalLength;
+    _fromCache = fromCache;
+  }
+  return self;
+}
+
+@end
+
+#pragma mark GMFMediaSlab
+
+// One memory-mapped slab file. Records are appended at |writeOffset| and never rewritten.
+@interface GMFMediaSlab : NSObject
+
+@property(nonatomic, readonly) NSString *path;
+@property(nonatomic, readonly) uint64_t sequence;
+@property(nonatomic, readonly) uint8_t *bytes;
+@property(nonatomic, readonly) size_t size;
+@property(nonatomic, readonly) size_t writeOffset;
+@property(nonatomic, readonly) NSTimeInterval lastAccess;
+
+// Index keys of the records in this slab.
+@property(nonatomic, readonly) NSMutableArray *keys;
+
+// Creates the file if |create| is YES, otherwise opens it and takes its size and last access
+// from it.
+- (instancetype)initWithPath:(NSString *)path
+                    sequence:(uint64_t)sequence
+                        size:(size_t)size
+                      create:(BOOL)create;
+
+// Returns the offset the data was written at, or NSNotFound if the record doesn't fit.
+- (NSUInteger)appendRecordWithKey:(NSData *)key
+                         MIMEType:(NSData *)MIMEType
+                             data:(NSData *)data
+                      totalLength:(int64_t)totalLength;
+
+// Calls |block| for each complete record and moves |writeOffset| past the last one.
+- (void)scanRecordsUsingBlock:(void (^)(NSString *key,
+                                        NSString *MIMEType,
+                                        size_t dataOffset,
+                                        int64_t dataLength,
+                                        int64_t totalLength))block;
+
+- (void)touch;
+
+// Writes dirty pages back to the file and lets the kernel drop the resident ones. The mapping
+// stays valid; its pages are read from the file again when next touched.
+- (void)purgeResidentPages;
+
+// Bytes of the mapping currently in memory.
+- (size_t)residentSize;
+
+// Deletes the file. The mapping stays valid until the slab is deallocated.
+- (void)removeFile;
+
+@end
+
+@implementation GMFMediaSlab {
+  int _fileDescriptor;
+  NSTimeInterval _lastTouch;
+}
+
+- (instancetype)initWithPath:(NSString *)path
+                    sequence:(uint64_t)sequence
+                        size:(size_t)size
+                      create:(BOOL)create {
+  self = [super init];
+  if (self) {
+    _path = [path copy];
+    _sequence = sequence;
+    _keys = [NSMutableArray array];
+    int flags = create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR;
+    _fileDescriptor = open([path fileSystemRepresentation], flags, 0600);
+    if (_fileDescriptor < 0) {
+      return nil;
+    }
+    struct stat status;
+    if (create) {
+      if (ftruncate(_fileDescriptor, (off_t)size) != 0) {
+        return nil;
+      }
+      _lastAccess = GMFCurrentTime();
+    } else {
+      if (fstat(_fileDescriptor, &status) != 0 || status.st_size <= 0) {
+        return nil;
+      }
+      size = (size_t)status.st_size;
+      _lastAccess = status.st_mtime - NSTimeIntervalSince1970;
+    }
+    _lastTouch = _lastAccess;
+    void *bytes = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fileDescriptor, 0);
+    if (bytes == MAP_FAILED) {
+      return nil;
+    }
+    _bytes = bytes;
+    _size = size;
+  }
+  return self;
+}
+
+- (void)dealloc {
+  if (_bytes) {
+    munmap(_bytes, _size);
+  }
+  if (_fileDescriptor >= 0) {
+    close(_fileDescriptor);
+  }
+}
+
+- (NSUInteger)appendRecordWithKey:(NSData *)key
+                         MIMEType:(NSData *)MIMEType
+                             data:(NSData *)data
+                      totalLength:(int64_t)totalLength {
+  size_t headerOffset = _writeOffset;
+  size_t keyOffset = headerOffset + sizeof(GMFSlabRecordHeader);
+  size_t MIMETypeOffset = keyOffset + [key length];
+  size_t dataOffset = GMFAlign8(MIMETypeOffset + [MIMEType length]);
+  size_t end = GMFAlign8(dataOffset + [data length]);
+  if (end > _size) {
+    return NSNotFound;
+  }
+  memcpy(_bytes + keyOffset, [key bytes], [key length]);
+  memcpy(_bytes + MIMETypeOffset, [MIMEType bytes], [MIMEType length]);
+  memcpy(_bytes + dataOffset, [data bytes], [data length]);
+  GMFSlabRecordHeader *header = (GMFSlabRecordHeader *)(_bytes + headerOffset);
+  header->keyLength = (uint32_t)[key length];
+  header->MIMETypeLength = (uint32_t)[MIMEType length];
+  header->reserved = 0;
+  header->dataLength = (int64_t)[data length];
+  header->totalLength = totalLength;
+  header->magic = kGMFSlabRecordMagic;
+  _writeOffset = end;
+  [self touch];
+  return dataOffset;
+}
+
+- (void)scanRecordsUsingBlock:(void (^)(NSString *key,
+                                        NSString *MIMEType,
+                                        size_t dataOffset,
+                                        int64_t dataLength,
+                                        int64_t totalLength))block {
+  size_t offset = 0;
+  while (offset + sizeof(GMFSlabRecordHeader) <= _size) {
+    const GMFSlabRecordHeader *header = (const GMFSlabRecordHeader *)(_bytes + offset);
+    if (header->magic != kGMFSlabRecordMagic || header->dataLength < 0) {
+      break;
+    }
+    size_t keyOffset = offset + sizeof(GMFSlabRecordHeader);
+    size_t MIMETypeOffset = keyOffset + header->keyLength;
+    size_t dataOffset = GMFAlign8(MIMETypeOffset + header->MIMETypeLength);
+    size_t end = GMFAlign8(dataOffset + (size_t)header->dataLength);
+    if (end > _size) {
+      break;
+    }
+    NSString *key = [[NSString alloc] initWithBytes:_bytes + keyOffset
+                                             length:header->keyLength
+                                           encoding:NSUTF8StringEncoding];
+    NSString *MIMEType = [[NSString alloc] initWithBytes:_bytes + MIMETypeOffset
+                                                  length:header->MIMETypeLength
+                                                encoding:NSUTF8StringEncoding];
+    if (key) {
+      block(key, MIMEType, dataOffset, header->dataLength, header->totalLength);
+    }
+    offset = end;
+  }
+  _writeOffset = offset;
+}
+
+- (void)touch {
+  _lastAccess = GMFCurrentTime();
+  if (_lastAccess - _lastTouch >= kGMFSlabTouchInterval) {
+    _lastTouch = _lastAccess;
+    futimes(_fileDescriptor, NULL);
+  }
+}
+
+- (void)purgeResidentPages {
+  msync(_bytes, _size, MS_ASYNC);
+  madvise(_bytes, _size, MADV_DONTNEED);
+}
+
+- (size_t)residentSize {
+  size_t pageSize = (size_t)getpagesize();
+  size_t pageCount = (_size + pageSize - 1) / pageSize;
+  char *pages = malloc(pageCount);
+  size_t residentSize = 0;
+  if (pages && mincore(_bytes, _size, pages) == 0) {
+    for (size_t i = 0; i < pageCount; i++) {
+      if (pages[i] & MINCORE_INCORE) {
+        residentSize += pageSize;
+      }
+    }
+  }
+  free(pages);
+  return MIN(residentSize, _size);
+}
+
+- (void)removeFile {
+  unlink([_path fileSystemRepresentation]);
+}
+
+@end
+
+#pragma mark GMFMediaCacheEntry
+
+@interface GMFMediaCacheEntry : NSObject
+
+@property(nonatomic, strong) GMFMediaSlab *slab;
+@property(nonatomic, assign) size_t dataOffset;
+@property(nonatomic, assign) int64_t dataLength;
+@property(nonatomic, copy) NSString *MIMEType;
+@property(nonatomic, assign) int64_t totalLength;
+
+@end
+
+@implementation GMFMediaCacheEntry
+@end
+
+#pragma mark GMFMediaCacheLoad
+
+// A load from the network, and what is left of its range to hand out.
+@interface GMFMediaCacheLoad : NSObject {
+ @public
+  NSURL *_URL;
+  GMFByteRange _range;
+  GMFMediaCacheResponseHandler _responseHandler;
+  GMFMediaCacheDataHandler _dataHandler;
+  GMFMediaCacheStreamCompletion _completion;
+  NSURLSessionDataTask *_task;
+  NSString *_MIMEType;
+  int64_t _totalLength;
+  // Body bytes before the range, when the server ignored the Range header and sends everything.
+  int64_t _bytesToSkip;
+  // Bytes of the range still to come, or kGMFByteRangeToEnd.
+  int64_t _bytesRemaining;
+  // The range so far, kept for storing; nil for playlists and once it outgrows a slab.
+  NSMutableData *_storedData;
+}
+@end
+
+@implementation GMFMediaCacheLoad
+@end
+
+#pragma mark GMFMediaCacheSessionDelegate
+
+// An NSURLSession keeps its delegate until it is invalidated. This one only holds the cache
+// weakly, so the cache can go away first and invalidate the session.
+@interface GMFMediaCacheSessionDelegate : NSObject<NSURLSessionDataDelegate>
+
+@property(nonatomic, weak) GMFMediaCache *cache;
+
+@end
+
+@interface GMFMediaCache ()
+
+// Returns NO if the load ended with |response|.
+- (BOOL)dataTask:(NSURLSessionDataTask *)task
+    shouldContinueAfterResponse:(NSURLResponse *)response;
+- (void)dataTask:(NSURLSessionDataTask *)task didReceiveData:(NSData *)data;
+- (void)task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error;
+
+@end
+
+@implementation GMFMediaCacheSessionDelegate
+
+- (void)URLSession:(NSURLSession *)session
+              dataTask:(NSURLSessionDataTask *)dataTask
+    didReceiveResponse:(NSURLResponse *)response
+     completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler {
+  BOOL shouldContinue = [_cache dataTask:dataTask shouldContinueAfterResponse:response];
+  completionHandler(shouldContinue ? NSURLSessionResponseAllow : NSURLSessionResponseCancel);
+}
+
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+    didReceiveData:(NSData *)data {
+  [_cache dataTask:dataTask didReceiveData:data];
+}
+
+- (void)URLSession:(NSURLSession *)session
+                    task:(NSURLSessionTask *)task
+    didCompleteWithError:(NSError *)error {
+  [_cache task:task didCompleteWithError:error];
+}
+
+@end
+
+#pragma mark GMFMediaCache
+
+@implementation GMFMediaCache {
+  NSMutableDictionary *_entries;
+  // Ordered by sequence number, i.e. creation.
+  NSMutableArray *_slabs;
+  GMFMediaSlab *_activeSlab;
+  uint64_t _nextSequence;
+  // Delivers on the main queue.
+  NSURLSession *_session;
+  // GMFMediaCacheLoad for each task identifier.
+  NSMutableDictionary *_loads;
+}
+
++ (instancetype)sharedCache {
+  static GMFMediaCache *sharedCache;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+      NSString *caches =
+          [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+      sharedCache = [[GMFMediaCache alloc]
+          initWithDirectory:[caches stringByAppendingPathComponent:@"GMFMediaCache"]
+                 diskBudget:kGMFMediaCacheSharedDiskBudget];
+  });
+  return sharedCache;
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory diskBudget:(uint64_t)diskBudget {
+  return [self initWithDirectory:directory
+                      diskBudget:diskBudget
+                        slabSize:kGMFMediaCacheDefaultSlabSize];
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory
+                       diskBudget:(uint64_t)diskBudget
+                         slabSize:(NSUInteger)slabSize {
+  self = [super init];
+  if (self) {
+    _directory = [directory copy];
+    _diskBudget = diskBudget;
+    _slabSize = slabSize;
+    _entries = [NSMutableDictionary dictionary];
+    _slabs = [NSMutableArray array];
+    _loads = [NSMutableDictionary dictionary];
+    NSURLSessionConfiguration *configuration =
+        [NSURLSessionConfiguration defaultSessionConfiguration];
+    // Responses are kept here, not a second time in the URL cache.
+    [configuration setURLCache:nil];
+    GMFMediaCacheSessionDelegate *sessionDelegate = [[GMFMediaCacheSessionDelegate alloc] init];
+    [sessionDelegate setCache:self];
+    _session = [NSURLSession sessionWithConfiguration:configuration
+                                             delegate:sessionDelegate
+                                        delegateQueue:[NSOperationQueue mainQueue]];
+    [[NSFileManager defaultManager] createDirectoryAtPath:_directory
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:NULL];
+    [self openSlabs];
+    [self evictSlabsToFitAdditionalBytes:0];
+    [[GMFMemoryGovernor sharedGovernor] addResponder:self];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [_session invalidateAndCancel];
+}
+
+- (void)setDiskBudget:(uint64_t)diskBudget {
+  _diskBudget = diskBudget;
+  [self evictSlabsToFitAdditionalBytes:0];
+}
+
+- (uint64_t)diskUsage {
+  uint64_t usage = 0;
+  for (GMFMediaSlab *slab in _slabs) {
+    usage += [slab size];
+  }
+  return usage;
+}
+
+- (NSUInteger)responseCount {
+  return [_entries count];
+}
+
+- (double)hitRatio {
+  NSUInteger lookups = _hitCount + _missCount;
+  return lookups ? (double)_hitCount / lookups : 0;
+}
+
+- (GMFMediaCacheResponse *)cachedResponseForURL:(NSURL *)URL range:(GMFByteRange)range {
+  GMFMediaCacheEntry *entry = [_entries objectForKey:[self keyForURL:URL range:range]];
+  if (!entry) {
+    _missCount++;
+    return nil;
+  }
+  _hitCount++;
+  _bytesSaved += (uint64_t)[entry dataLength];
+  GMFMediaSlab *slab = [entry slab];
+  [slab touch];
+  NSData *data = [[NSData alloc] initWithBytesNoCopy:[slab bytes] + [entry dataOffset]
+                                              length:(NSUInteger)[entry dataLength]
+                                         deallocator:^(void *bytes, NSUInteger length) {
+      // Keeps the mapping alive for as long as the data is.
+      (void)slab;
+  }];
+  return [[GMFMediaCacheResponse alloc] initWithData:data
+                                            MIMEType:[entry MIMEType]
+                                         totalLength:[entry totalLength]
+                                           fromCache:YES];
+}
+
+- (BOOL)storeData:(NSData *)data
+         MIMEType:(NSString *)MIMEType
+      totalLength:(int64_t)totalLength
+           forURL:(NSURL *)URL
+            range:(GMFByteRange)range {
+  if (![data length] || [self isPlaylistMIMEType:MIMEType] || _diskBudget < _slabSize) {
+    return NO;
+  }
+  NSString *key = [self keyForURL:URL range:range];
+  NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+  NSData *MIMETypeData = [(MIMEType ?: @"") dataUsingEncoding:NSUTF8StringEncoding];
+  size_t recordSize = GMFAlign8(sizeof(GMFSlabRecordHeader) + [keyData length] +
+                                [MIMETypeData length]) + GMFAlign8([data length]);
+  if (recordSize > _slabSize) {
+    return NO;
+  }
+
+  NSUInteger dataOffset = [_activeSlab appendRecordWithKey:keyData
+                                                  MIMEType:MIMETypeData
+                                                      data:data
+                                               totalLength:totalLength];
+  if (!_activeSlab || dataOffset == NSNotFound) {
+    GMFMediaSlab *slab = [self createSlab];
+    if (!slab) {
+      return NO;
+    }
+    dataOffset = [slab appendRecordWithKey:keyData
+                                  MIMEType:MIMETypeData
+                                      data:data
+                               totalLength:totalLength];
+  }
+
+  GMFMediaCacheEntry *entry = [[GMFMediaCacheEntry alloc] init];
+  [entry setSlab:_activeSlab];
+  [entry setDataOffset:dataOffset];
+  [entry setDataLength:(int64_t)[data length]];
+  [entry setMIMEType:MIMEType];
+  [entry setTotalLength:totalLength];
+  [_entries setObject:entry forKey:key];
+  [[_activeSlab keys] addObject:key];
+  _bytesStored += [data length];
+  return YES;
+}
+
+- (void)loadURL:(NSURL *)URL range:(GMFByteRange)range completion:(GMFMediaCacheCompletion)completion {
+  if (![self isPlaylistURL:URL]) {
+    GMFMediaCacheResponse *response = [self cachedResponseForURL:URL range:range];
+    if (response) {
+      completion(response, nil);
+      return;
+    }
+  }
+  // Gathers the streamed body into one response.
+  NSMutableData *body = [NSMutableData data];
+  __block NSString *responseMIMEType = nil;
+  __block int64_t responseTotalLength = -1;
+  GMFMediaCacheResponseHandler responseHandler = ^(NSString *MIMEType, int64_t totalLength) {
+      responseMIMEType = MIMEType;
+      responseTotalLength = totalLength;
+  };
+  GMFMediaCacheDataHandler dataHandler = ^(NSData *data) {
+      [body appendData:data];
+  };
+  GMFMediaCacheStreamCompletion streamCompletion = ^(NSError *error) {
+      if (error) {
+        completion(nil, error);
+        return;
+      }
+      completion([[GMFMediaCacheResponse alloc] initWithData:body
+                                                    MIMEType:responseMIMEType
+                                                 totalLength:responseTotalLength
+                                                   fromCache:NO],
+                 nil);
+  };
+  [self startLoadWithURL:URL
+                   range:range
+         responseHandler:responseHandler
+             dataHandler:dataHandler
+              completion:streamCompletion];
+}
+
+- (id)streamURL:(NSURL *)URL
+              range:(GMFByteRange)range
+    responseHandler:(GMFMediaCacheResponseHandler)responseHandler
+        dataHandler:(GMFMediaCacheDataHandler)dataHandler
+         completion:(GMFMediaCacheStreamCompletion)completion {
+  if (![self isPlaylistURL:URL]) {
+    GMFMediaCacheResponse *response = [self cachedResponseForURL:URL range:range];
+    if (response) {
+      responseHandler([response MIMEType], [response totalLength]);
+      dataHandler([response data]);
+      completion(nil);
+      return nil;
+    }
+  }
+  return [self startLoadWithURL:URL
+                          range:range
+                responseHandler:responseHandler
+                    dataHandler:dataHandler
+                     completion:completion];
+}
+
+- (void)cancelLoad:(id)handle {
+  GMFMediaCacheLoad *load = handle;
+  if (!load) {
+    return;
+  }
+  [_loads removeObjectForKey:@([load->_task taskIdentifier])];
+  [load->_task cancel];
+}
+
+- (void)removeAllResponses {
+  while ([_slabs count]) {
+    [self removeSlab:[_slabs lastObject]];
+  }
+}
+
+- (void)resetStatistics {
+  _hitCount = 0;
+  _missCount = 0;
+  _bytesSaved = 0;
+  _bytesStored = 0;
+}
+
+#pragma mark GMFMemoryPressureResponder
+
+- (void)trimMemoryForPressureLevel:(GMFMemoryPressureLevel)level {
+  if (level == kGMFMemoryPressureLevelNormal) {
+    return;
+  }
+  for (GMFMediaSlab *slab in _slabs) {
+    if (slab != _activeSlab || level == kGMFMemoryPressureLevelCritical) {
+      [slab purgeResidentPages];
+    }
+  }
+}
+
+- (uint64_t)estimatedMemoryCost {
+  uint64_t cost = 0;
+  for (GMFMediaSlab *slab in _slabs) {
+    cost += [slab residentSize];
+  }
+  return cost;
+}
+
+#pragma mark Private Methods
+
+- (NSString *)keyForURL:(NSURL *)URL range:(GMFByteRange)range {
+  return [NSString stringWithFormat:@"%lld+%lld %@", range.offset, range.length, [URL absoluteString]];
+}
+
+- (BOOL)isPlaylistURL:(NSURL *)URL {
+  NSString *extension = [[URL pathExtension] lowercaseString];
+  return [extension isEqualToString:@"m3u8"] || [extension isEqualToString:@"m3u"];
+}
+
+- (BOOL)isPlaylistMIMEType:(NSString *)MIMEType {
+  return [[MIMEType lowercaseString] rangeOfString:@"mpegurl"].location != NSNotFound;
+}
+
+- (NSString *)pathForSlabWithSequence:(uint64_t)sequence {
+  NSString *name = [NSString stringWithFormat:@"%llu", sequence];
+  return [_directory stringByAppendingPathComponent:
+                         [name stringByAppendingPathExtension:kGMFSlabExtension]];
+}
+
+- (void)openSlabs {
+  NSMutableArray *sequences = [NSMutableArray array];
+  NSArray *names = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:_directory error:NULL];
+  for (NSString *name in names) {
+    if ([[name pathExtension] isEqualToString:kGMFSlabExtension]) {
+      [sequences addObject:@([[name stringByDeletingPathExtension] longLongValue])];
+    }
+  }
+  [sequences sortUsingSelector:@selector(compare:)];
+  for (NSNumber *sequence in sequences) {
+    NSString *path = [self pathForSlabWithSequence:[sequence unsignedLongLongValue]];
+    GMFMediaSlab *slab = [[GMFMediaSlab alloc] initWithPath:path
+                                                   sequence:[sequence unsignedLongLongValue]
+                                                       size:0
+                                                     create:NO];
+    if (!slab) {
+      unlink([path fileSystemRepresentation]);
+      continue;
+    }
+    [slab scanRecordsUsingBlock:^(NSString *key,
+                                  NSString *MIMEType,
+                                  size_t dataOffset,
+                                  int64_t dataLength,
+                                  int64_t totalLength) {
+        GMFMediaCacheEntry *entry = [[GMFMediaCacheEntry alloc] init];
+        [entry setSlab:slab];
+        [entry setDataOffset:dataOffset];
+        [entry setDataLength:dataLength];
+        [entry setMIMEType:MIMEType];
+        [entry setTotalLength:totalLength];
+        // Later slabs hold newer responses.
+        [_entries setObject:entry forKey:key];
+        [[slab keys] addObject:key];
+    }];
+    [_slabs addObject:slab];
+    _nextSequence = [sequence unsignedLongLongValue] + 1;
+  }
+  // Keep appending to the newest slab.
+  _activeSlab = [_slabs lastObject];
+}
+
+- (GMFMediaSlab *)createSlab {
+  [self evictSlabsToFitAdditionalBytes:_slabSize];
+  uint64_t sequence = _nextSequence++;
+  GMFMediaSlab *slab = [[GMFMediaSlab alloc] initWithPath:[self pathForSlabWithSequence:sequence]
+                                                 sequence:sequence
+                                                     size:_slabSize
+                                                   create:YES];
+  if (slab) {
+    [_slabs addObject:slab];
+  }
+  _activeSlab = slab;
+  return slab;
+}
+
+- (void)evictSlabsToFitAdditionalBytes:(uint64_t)additionalBytes {
+  while ([_slabs count] && [self diskUsage] + additionalBytes > _diskBudget) {
+    GMFMediaSlab *leastRecentlyUsed = nil;
+    for (GMFMediaSlab *slab in _slabs) {
+      if (!leastRecentlyUsed || [slab lastAccess] < [leastRecentlyUsed lastAccess]) {
+        leastRecentlyUsed = slab;
+      }
+    }
+    [self removeSlab:leastRecentlyUsed];
+  }
+}
+
+- (void)removeSlab:(GMFMediaSlab *)slab {
+  for (NSString *key in [slab keys]) {
+    // The key may have been stored again in a newer slab.
+    if ([[_entries objectForKey:key] slab] == slab) {
+      [_entries removeObjectForKey:key];
+    }
+  }
+  [slab removeFile];
+  [_slabs removeObject:slab];
+  if (_activeSlab == slab) {
+    _activeSlab = nil;
+  }
+}
+
+- (GMFMediaCacheLoad *)startLoadWithURL:(NSURL *)URL
+                                   range:(GMFByteRange)range
+                         responseHandler:(GMFMediaCacheResponseHandler)responseHandler
+                             dataHandler:(GMFMediaCacheDataHandler)dataHandler
+                              completion:(GMFMediaCacheStreamCompletion)completion {
+  NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:URL];
+  if (range.offset > 0 || range.length != kGMFByteRangeToEnd) {
+    NSString *value = range.length == kGMFByteRangeToEnd ?
+        [NSString stringWithFormat:@"bytes=%lld-", range.offset] :
+        [NSString stringWithFormat:@"bytes=%lld-%lld", range.offset, range.offset + range.length - 1];
+    [request setValue:value forHTTPHeaderField:@"Range"];
+  }
+  GMFMediaCacheLoad *load = [[GMFMediaCacheLoad alloc] init];
+  load->_URL = URL;
+  load->_range = range;
+  load->_responseHandler = [responseHandler copy];
+  load->_dataHandler = [dataHandler copy];
+  load->_completion = [completion copy];
+  load->_totalLength = -1;
+  load->_bytesRemaining = range.length;
+  if (![self isPlaylistURL:URL] && _diskBudget >= _slabSize) {
+    load->_storedData = [NSMutableData data];
+  }
+  load->_task = [_session dataTaskWithRequest:request];
+  [_loads setObject:load forKey:@([load->_task taskIdentifier])];
+  [load->_task resume];
+  return load;
+}
+
+- (BOOL)dataTask:(NSURLSessionDataTask *)task
+    shouldContinueAfterResponse:(NSURLResponse *)response {
+  GMFMediaCacheLoad *load = [_loads objectForKey:@([task taskIdentifier])];
+  if (!load) {
+    return NO;
+  }
+  NSError *error = nil;
+  if (![GMFMediaCache prepareLoad:load withURLResponse:response error:&error]) {
+    [self finishLoad:load error:error];
+    return NO;
+  }
+  load->_responseHandler(load->_MIMEType, load->_totalLength);
+  return YES;
+}
+
+- (void)dataTask:(NSURLSessionDataTask *)task didReceiveData:(NSData *)data {
+  NSNumber *key = @([task taskIdentifier]);
+  GMFMediaCacheLoad *load = [_loads objectForKey:key];
+  if (!load) {
+    return;
+  }
+  NSUInteger start = (NSUInteger)MIN(load->_bytesToSkip, (int64_t)[data length]);
+  load->_bytesToSkip -= start;
+  NSUInteger length = [data length] - start;
+  if (load->_bytesRemaining != kGMFByteRangeToEnd) {
+    length = (NSUInteger)MIN((int64_t)length, load->_bytesRemaining);
+    load->_bytesRemaining -= length;
+  }
+  if (length) {
+    NSData *part =
+        length == [data length] ? data : [data subdataWithRange:NSMakeRange(start, length)];
+    if (load->_storedData) {
+      if ([load->_storedData length] + length > _slabSize) {
+        load->_storedData = nil;
+      } else {
+        [load->_storedData appendData:part];
+      }
+    }
+    load->_dataHandler(part);
+  }
+  // The handler may have cancelled the load.
+  if (load->_bytesRemaining == 0 && [_loads objectForKey:key] == load) {
+    // Only left when the server ignored the Range header; the rest of the body isn't needed.
+    [task cancel];
+    [self finishLoad:load error:nil];
+  }
+}
+
+- (void)task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error {
+  GMFMediaCacheLoad *load = [_loads objectForKey:@([task taskIdentifier])];
+  if (!load) {
+    return;
+  }
+  if (!error && load->_bytesToSkip > 0) {
+    // The whole body was shorter than the range's offset.
+    error = [NSError errorWithDomain:kGMFMediaCacheErrorDomain
+                                code:kGMFMediaCacheErrorBadRange
+                            userInfo:nil];
+  }
+  [self finishLoad:load error:error];
+}
+
+- (void)finishLoad:(GMFMediaCacheLoad *)load error:(NSError *)error {
+  [_loads removeObjectForKey:@([load->_task taskIdentifier])];
+  if (!error && load->_storedData) {
+    [self storeData:load->_storedData
+           MIMEType:load->_MIMEType
+        totalLength:load->_totalLength
+             forURL:load->_URL
+              range:load->_range];
+  }
+  load->_completion(error);
+}
+
+// Checks the status and range of |response| and sets up |load| to hand out its range.
++ (BOOL)prepareLoad:(GMFMediaCacheLoad *)load
+    withURLResponse:(NSURLResponse *)URLResponse
+              error:(NSError **)error {
+  NSInteger statusCode = 200;
+  NSDictionary *headers = nil;
+  if ([URLResponse isKindOfClass:[NSHTTPURLResponse class]]) {
+    statusCode = [(NSHTTPURLResponse *)URLResponse statusCode];
+    headers = [(NSHTTPURLResponse *)URLResponse allHeaderFields];
+  }
+  if (statusCode != 200 && statusCode != 206) {
+    if (error) {
+      *error = [NSError errorWithDomain:kGMFMediaCacheErrorDomain
+                                   code:kGMFMediaCacheErrorHTTPStatus
+                               userInfo:@{ kGMFMediaCacheHTTPStatusCodeKey : @(statusCode) }];
+    }
+    return NO;
+  }
+
+  GMFByteRange range = load->_range;
+  int64_t totalLength = -1;
+  if (statusCode == 206) {
+    // "bytes <first>-<last>/<total or *>"
+    long long first = -1;
+    long long last = -1;
+    NSString *contentRange = [self valueForHeaderField:@"Content-Range" inHeaders:headers];
+    NSScanner *scanner = [NSScanner scannerWithString:contentRange ?: @""];
+    [scanner scanString:@"bytes" intoString:NULL];
+    if (![scanner scanLongLong:&first] || first != range.offset ||
+        ![scanner scanString:@"-" intoString:NULL] || ![scanner scanLongLong:&last]) {
+      if (error) {
+        *error = [NSError errorWithDomain:kGMFMediaCacheErrorDomain
+                                     code:kGMFMediaCacheErrorBadRange
+                                 userInfo:nil];
+      }
+      return NO;
+    }
+    long long total = -1;
+    if ([scanner scanString:@"/" intoString:NULL] && [scanner scanLongLong:&total]) {
+      totalLength = total;
+    }
+  } else {
+    // The server ignored the Range header and sends everything.
+    totalLength = [URLResponse expectedContentLength];
+    if (totalLength >= 0 && range.offset > totalLength) {
+      if (error) {
+        *error = [NSError errorWithDomain:kGMFMediaCacheErrorDomain
+                                     code:kGMFMediaCacheErrorBadRange
+                                 userInfo:nil];
+      }
+      return NO;
+    }
+    load->_bytesToSkip = range.offset;
+  }
+  load->_MIMEType = [URLResponse MIMEType];
+  load->_totalLength = totalLength;
+  return YES;
+}
+
++ (NSString *)valueForHeaderField:(NSString *)field inHeaders:(NSDictionary *)headers {
+  for (NSString *name in headers) {
+    if ([name caseInsensitiveCompare:field] == NSOrderedSame) {
+      return [headers objectForKey:name];
+    }
+  }
+  return nil;
+}
+
+@end
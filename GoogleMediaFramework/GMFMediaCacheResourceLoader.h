@@ -0,0 +1,52 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <AVFoundation/AVFoundation.h>
+
+#import "GMFMediaCache.h"
+
+// Puts a GMFMediaCache between AVFoundation and the network. Assets made by |assetWithURL:| use a
+// private URL scheme, so AVFoundation hands their loads to this resource loader. Progressive
+// files are answered from the cache or streamed from the network as the bytes arrive.
+//
+// AVFoundation doesn't let a resource loader serve HLS media segments, only playlists and keys.
+// Playlists are fetched through the loader and rewritten on the way through: variant URIs use the
+// private scheme, and segment URIs are made absolute with their own scheme, so segments go to the
+// network directly. Any other load of an HLS asset, e.g. a relative EXT-X-MAP or EXT-X-KEY URI,
+// is answered with a redirect to its real URL.
+//
+// AVFoundation only holds its resource loader delegate weakly; keep the loader alive for as long
+// as its assets play.
+@interface GMFMediaCacheResourceLoader : NSObject<AVAssetResourceLoaderDelegate>
+
+@property(nonatomic, readonly) GMFMediaCache *cache;
+
+- (instancetype)initWithCache:(GMFMediaCache *)cache;
+
+// Whether |URL| can go through the cache: only http and https can.
++ (BOOL)canCacheURL:(NSURL *)URL;
+
+// |URL| with the private scheme, and back. |originalURLForURL:| returns nil for other URLs.
++ (NSURL *)cacheURLForURL:(NSURL *)URL;
++ (NSURL *)originalURLForURL:(NSURL *)URL;
+
+// An asset for |URL| loaded through the cache, or a plain asset if |URL| can't be cached.
+- (AVURLAsset *)assetWithURL:(NSURL *)URL;
+
+// Returns |data|, an HLS playlist fetched from |URL|, with its variant URIs replaced by absolute
+// cache URLs and its segment URIs by absolute ones. Returns |data| unchanged if it isn't a
+// playlist.
++ (NSData *)rewritePlaylistData:(NSData *)data fromURL:(NSURL *)URL;
+
+@end
@@ -0,0 +1,281 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFHLSPlaylist.h"
+#import "GMFMediaCacheResourceLoader.h"
+
+// Prepended to the original scheme, e.g. gmfcache-https.
+static NSString *const kGMFCacheSchemePrefix = @"gmfcache-";
+
+// Uniform type identifiers AVFoundation expects as content types, for the MIME types streams are
+// served with. Avoids linking MobileCoreServices for UTTypeCreatePreferredIdentifierForTag.
+static NSString *GMFContentTypeForMIMEType(NSString *MIMEType) {
+  static NSDictionary *contentTypes;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+      contentTypes = @{
+        @"application/vnd.apple.mpegurl" : @"public.m3u-playlist",
+        @"application/x-mpegurl" : @"public.m3u-playlist",
+        @"audio/mpegurl" : @"public.m3u-playlist",
+        @"audio/x-mpegurl" : @"public.m3u-playlist",
+        @"video/mp2t" : @"public.mpeg-2-transport-stream",
+        @"video/mp4" : AVFileTypeMPEG4,
+        @"video/x-m4v" : AVFileTypeAppleM4V,
+        @"video/quicktime" : AVFileTypeQuickTimeMovie,
+        @"audio/mp4" : AVFileTypeAppleM4A,
+        @"audio/aac" : @"public.aac-audio",
+        @"audio/mpeg" : @"public.mp3"
+      };
+  });
+  // Drop parameters such as "; charset=utf-8".
+  NSString *type = [[[MIMEType componentsSeparatedByString:@";"] firstObject] lowercaseString];
+  type = [type stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+  return [contentTypes objectForKey:type];
+}
+
+@implementation GMFMediaCacheResourceLoader {
+  // Absolute strings of the original URLs of progressive assets, whose loads are streamed.
+  NSMutableSet *_progressiveURLs;
+  // Handle of the streamed cache load answering each loading request.
+  NSMapTable *_loads;
+}
+
+- (instancetype)initWithCache:(GMFMediaCache *)cache {
+  self = [super init];
+  if (self) {
+    _cache = cache;
+    _progressiveURLs = [NSMutableSet set];
+    _loads = [NSMapTable strongToStrongObjectsMapTable];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  for (AVAssetResourceLoadingRequest *loadingRequest in _loads) {
+    [_cache cancelLoad:[_loads objectForKey:loadingRequest]];
+  }
+}
+
++ (BOOL)canCacheURL:(NSURL *)URL {
+  NSString *scheme = [[URL scheme] lowercaseString];
+  return [scheme isEqualToString:@"http"] || [scheme isEqualToString:@"https"];
+}
+
++ (NSURL *)cacheURLForURL:(NSURL *)URL {
+  if (![self canCacheURL:URL]) {
+    return URL;
+  }
+  NSURLComponents *components = [NSURLComponents componentsWithURL:URL resolvingAgainstBaseURL:YES];
+  [components setScheme:[kGMFCacheSchemePrefix stringByAppendingString:[URL scheme]]];
+  return [components URL];
+}
+
++ (NSURL *)originalURLForURL:(NSURL *)URL {
+  NSString *scheme = [URL scheme];
+  if (![scheme hasPrefix:kGMFCacheSchemePrefix]) {
+    return nil;
+  }
+  NSURLComponents *components = [NSURLComponents componentsWithURL:URL resolvingAgainstBaseURL:YES];
+  [components setScheme:[scheme substringFromIndex:[kGMFCacheSchemePrefix length]]];
+  return [components URL];
+}
+
+- (AVURLAsset *)assetWithURL:(NSURL *)URL {
+  if (![GMFMediaCacheResourceLoader canCacheURL:URL]) {
+    return [AVURLAsset URLAssetWithURL:URL options:nil];
+  }
+  if (![self isPlaylistURL:URL]) {
+    [_progressiveURLs addObject:[URL absoluteString]];
+  }
+  AVURLAsset *asset =
+      [AVURLAsset URLAssetWithURL:[GMFMediaCacheResourceLoader cacheURLForURL:URL] options:nil];
+  // The cache is main thread only.
+  [[asset resourceLoader] setDelegate:self queue:dispatch_get_main_queue()];
+  return asset;
+}
+
++ (NSData *)rewritePlaylistData:(NSData *)data fromURL:(NSURL *)URL {
+  GMFHLSPlaylist *playlist = [GMFHLSPlaylist playlistWithData:data baseURL:URL];
+  if (!playlist) {
+    return data;
+  }
+  BOOL master = [playlist isMasterPlaylist];
+  NSUInteger count = master ? [playlist variantCount] : [playlist segmentCount];
+  const uint8_t *bytes = [data bytes];
+  NSMutableData *rewritten = [NSMutableData dataWithCapacity:[data length] + count * 16];
+  NSUInteger copied = 0;
+  // URIs are in the order they appear in |data|.
+  for (NSUInteger i = 0; i < count; i++) {
+    NSRange URIRange =
+        master ? [playlist variantAtIndex:i].URIRange : [playlist segmentAtIndex:i].URIRange;
+    NSURL *URIURL = master ? [playlist URLForVariantAtIndex:i] : [playlist URLForSegmentAtIndex:i];
+    if (!URIURL) {
+      continue;
+    }
+    // The playlist is served from a cache URL, so relative segment URIs would resolve to one too.
+    NSURL *rewrittenURL = master ? [self cacheURLForURL:URIURL] : URIURL;
+    NSData *URI = [[rewrittenURL absoluteString] dataUsingEncoding:NSUTF8StringEncoding];
+    [rewritten appendBytes:bytes + copied length:URIRange.location - copied];
+    [rewritten appendData:URI];
+    copied = NSMaxRange(URIRange);
+  }
+  [rewritten appendBytes:bytes + copied length:[data length] - copied];
+  return rewritten;
+}
+
+#pragma mark AVAssetResourceLoaderDelegate
+
+- (BOOL)resourceLoader:(AVAssetResourceLoader *)resourceLoader
+    shouldWaitForLoadingOfRequestedResource:(AVAssetResourceLoadingRequest *)loadingRequest {
+  NSURL *URL = [GMFMediaCacheResourceLoader originalURLForURL:[[loadingRequest request] URL]];
+  if (!URL) {
+    return NO;
+  }
+  if ([self isPlaylistURL:URL]) {
+    [self loadPlaylistForLoadingRequest:loadingRequest URL:URL];
+  } else if ([_progressiveURLs containsObject:[URL absoluteString]]) {
+    [self streamLoadingRequest:loadingRequest URL:URL];
+  } else {
+    [self redirectLoadingRequest:loadingRequest toURL:URL];
+  }
+  return YES;
+}
+
+- (void)resourceLoader:(AVAssetResourceLoader *)resourceLoader
+    didCancelLoadingRequest:(AVAssetResourceLoadingRequest *)loadingRequest {
+  [_cache cancelLoad:[_loads objectForKey:loadingRequest]];
+  [_loads removeObjectForKey:loadingRequest];
+}
+
+#pragma mark Private Methods
+
+// Playlists are rewritten, so ranges of the rewritten bytes don't match the server's. Fetches them
+// whole and cuts the range out afterwards.
+- (void)loadPlaylistForLoadingRequest:(AVAssetResourceLoadingRequest *)loadingRequest
+                                  URL:(NSURL *)URL {
+  GMFByteRange requestedRange = [self rangeForDataRequest:[loadingRequest dataRequest]];
+  [_cache loadURL:URL
+            range:GMFByteRangeMake(0, kGMFByteRangeToEnd)
+       completion:^(GMFMediaCacheResponse *response, NSError *error) {
+      if ([loadingRequest isFinished] || [loadingRequest isCancelled]) {
+        return;
+      }
+      if (!response) {
+        [loadingRequest finishLoadingWithError:error];
+        return;
+      }
+      NSData *data = [GMFMediaCacheResourceLoader rewritePlaylistData:[response data] fromURL:URL];
+      int64_t contentLength = (int64_t)[data length];
+      int64_t offset = MIN(requestedRange.offset, contentLength);
+      int64_t end = requestedRange.length == kGMFByteRangeToEnd ?
+          contentLength : MIN(contentLength, offset + requestedRange.length);
+      [GMFMediaCacheResourceLoader fillContentInformationOfLoadingRequest:loadingRequest
+                                                              contentType:@"public.m3u-playlist"
+                                                            contentLength:contentLength];
+      [[loadingRequest dataRequest]
+          respondWithData:[data subdataWithRange:NSMakeRange((NSUInteger)offset,
+                                                             (NSUInteger)(end - offset))]];
+      [loadingRequest finishLoading];
+  }];
+}
+
+// Hands the requested range of a progressive file to AVFoundation as it arrives, so playback can
+// start long before a request to the end of the file completes.
+- (void)streamLoadingRequest:(AVAssetResourceLoadingRequest *)loadingRequest URL:(NSURL *)URL {
+  GMFByteRange range = [self rangeForDataRequest:[loadingRequest dataRequest]];
+  GMFMediaCacheResponseHandler responseHandler = ^(NSString *MIMEType, int64_t totalLength) {
+      [GMFMediaCacheResourceLoader
+          fillContentInformationOfLoadingRequest:loadingRequest
+                                     contentType:GMFContentTypeForMIMEType(MIMEType)
+                                   contentLength:totalLength];
+  };
+  GMFMediaCacheDataHandler dataHandler = ^(NSData *data) {
+      [[loadingRequest dataRequest] respondWithData:data];
+  };
+  __weak GMFMediaCacheResourceLoader *weakSelf = self;
+  GMFMediaCacheStreamCompletion completion = ^(NSError *error) {
+      [weakSelf didFinishStreamingLoadingRequest:loadingRequest];
+      if ([loadingRequest isFinished] || [loadingRequest isCancelled]) {
+        return;
+      }
+      if (error) {
+        [loadingRequest finishLoadingWithError:error];
+      } else {
+        [loadingRequest finishLoading];
+      }
+  };
+  id load = [_cache streamURL:URL
+                        range:range
+              responseHandler:responseHandler
+                  dataHandler:dataHandler
+                   completion:completion];
+  if (load) {
+    [_loads setObject:load forKey:loadingRequest];
+  }
+}
+
+- (void)didFinishStreamingLoadingRequest:(AVAssetResourceLoadingRequest *)loadingRequest {
+  [_loads removeObjectForKey:loadingRequest];
+}
+
+// Sends AVFoundation to |URL| on the network itself, for loads it only takes from there.
+- (void)redirectLoadingRequest:(AVAssetResourceLoadingRequest *)loadingRequest
+                         toURL:(NSURL *)URL {
+  [loadingRequest setRedirect:[NSURLRequest requestWithURL:URL]];
+  [loadingRequest setResponse:[[NSHTTPURLResponse alloc]
+                                   initWithURL:[[loadingRequest request] URL]
+                                    statusCode:302
+                                   HTTPVersion:nil
+                                  headerFields:@{ @"Location" : [URL absoluteString] }]];
+  [loadingRequest finishLoading];
+}
+
++ (void)fillContentInformationOfLoadingRequest:(AVAssetResourceLoadingRequest *)loadingRequest
+                                   contentType:(NSString *)contentType
+                                 contentLength:(int64_t)contentLength {
+  AVAssetResourceLoadingContentInformationRequest *information =
+      [loadingRequest contentInformationRequest];
+  if (!information) {
+    return;
+  }
+  [information setContentType:contentType];
+  if (contentLength >= 0) {
+    [information setContentLength:contentLength];
+  }
+  [information setByteRangeAccessSupported:YES];
+}
+
+- (GMFByteRange)rangeForDataRequest:(AVAssetResourceLoadingDataRequest *)dataRequest {
+  GMFByteRange range = GMFByteRangeMake(0, kGMFByteRangeToEnd);
+  if (dataRequest) {
+    range.offset = [dataRequest requestedOffset];
+    BOOL toEnd = [dataRequest respondsToSelector:@selector(requestsAllDataToEndOfResource)] &&
+                 [dataRequest requestsAllDataToEndOfResource];
+    if (!toEnd) {
+      range.length = [dataRequest requestedLength];
+    }
+  }
+  return range;
+}
+
+- (BOOL)isPlaylistURL:(NSURL *)URL {
+  NSString *extension = [[URL pathExtension] lowercaseString];
+  return [extension isEqualToString:@"m3u8"] || [extension isEqualToString:@"m3u"];
+}
+
+@end
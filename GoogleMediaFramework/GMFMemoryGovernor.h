@@ -0,0 +1,80 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFClock.h"
+
+typedef enum {
+  kGMFMemoryPressureLevelNormal,
+  // Trim what is cheap to get back, e.g. caches and buffers beyond the next few seconds.
+  kGMFMemoryPressureLevelWarning,
+  // Free everything that isn't needed to keep the playing video going.
+  kGMFMemoryPressureLevelCritical
+} GMFMemoryPressureLevel;
+
+// Seconds without a further warning after which the level drops back to normal.
+extern const NSTimeInterval kGMFMemoryGovernorDefaultRelaxInterval;
+
+// Something holding memory that can be given back under pressure.
+@protocol GMFMemoryPressureResponder<NSObject>
+
+// Frees memory in proportion to |level|. Also called with kGMFMemoryPressureLevelNormal once the
+// pressure is gone, so limits imposed under pressure can be lifted.
+- (void)trimMemoryForPressureLevel:(GMFMemoryPressureLevel)level;
+
+// Best guess at the bytes held right now.
+- (uint64_t)estimatedMemoryCost;
+
+@end
+
+// Tells the registered responders about memory pressure, in tiers, before the system has to
+// terminate the app for it. The shared governor listens to UIKit memory warnings, which count as
+// critical, and on iOS 8.0+ to the kernel's memory pressure notifications, which also report
+// warnings and the return to normal. A warning the kernel doesn't follow up with normal, e.g. a
+// UIKit one, relaxes back to normal after |relaxInterval|. Responders are held weakly and called
+// on the main thread in no particular order. Main thread only.
+@interface GMFMemoryGovernor : NSObject
+
+@property(nonatomic, readonly) GMFMemoryPressureLevel currentLevel;
+
+// Defaults to kGMFMemoryGovernorDefaultRelaxInterval.
+@property(nonatomic, assign) NSTimeInterval relaxInterval;
+
+// Pressure events handled, by level.
+@property(nonatomic, readonly) NSUInteger warningCount;
+@property(nonatomic, readonly) NSUInteger criticalCount;
+
+// The framework's players and caches register with it when they are created.
++ (instancetype)sharedGovernor;
+
+// Uses the shared GMFTimerWheel and doesn't listen to the system; pressure has to be reported
+// with |handleMemoryPressureLevel:|.
+- (instancetype)init;
+
+// |clock| times the relaxation; pass a GMFVirtualClock in tests.
+- (instancetype)initWithClock:(id<GMFClock>)clock;
+
+- (void)addResponder:(id<GMFMemoryPressureResponder>)responder;
+- (void)removeResponder:(id<GMFMemoryPressureResponder>)responder;
+
+- (NSArray *)responders;
+
+// Moves to |level| and has every responder trim for it. Also how tests inject pressure.
+- (void)handleMemoryPressureLevel:(GMFMemoryPressureLevel)level;
+
+// Sum of the estimates of all responders.
+- (uint64_t)estimatedMemoryCost;
+
+@end
@@ -0,0 +1,162 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import <UIKit/UIKit.h>
+
+#import "GMFMemoryGovernor.h"
+#import "GMFTimerWheel.h"
+#import "GMFTrace.h"
+
+const NSTimeInterval kGMFMemoryGovernorDefaultRelaxInterval = 30;
+
+@implementation GMFMemoryGovernor {
+  id<GMFClock> _clock;
+  NSHashTable *_responders;
+  id _relaxHandle;
+  dispatch_source_t _pressureSource;
+}
+
++ (instancetype)sharedGovernor {
+  static GMFMemoryGovernor *sharedGovernor;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+      sharedGovernor = [[GMFMemoryGovernor alloc] init];
+      [sharedGovernor observeSystemMemoryPressure];
+  });
+  return sharedGovernor;
+}
+
+- (instancetype)init {
+  return [self initWithClock:[GMFTimerWheel sharedWheel]];
+}
+
+- (instancetype)initWithClock:(id<GMFClock>)clock {
+  self = [super init];
+  if (self) {
+    _clock = clock;
+    _relaxInterval = kGMFMemoryGovernorDefaultRelaxInterval;
+    _responders = [NSHashTable weakObjectsHashTable];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+  if (_pressureSource) {
+    dispatch_source_cancel(_pressureSource);
+  }
+  if (_relaxHandle) {
+    [_clock cancelScheduledBlock:_relaxHandle];
+  }
+}
+
+- (void)addResponder:(id<GMFMemoryPressureResponder>)responder {
+  [_responders addObject:responder];
+}
+
+- (void)removeResponder:(id<GMFMemoryPressureResponder>)responder {
+  [_responders removeObject:responder];
+}
+
+- (NSArray *)responders {
+  return [_responders allObjects];
+}
+
+- (void)handleMemoryPressureLevel:(GMFMemoryPressureLevel)level {
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "memory.pressure", level);
+  _currentLevel = level;
+  if (level == kGMFMemoryPressureLevelWarning) {
+    _warningCount++;
+  } else if (level == kGMFMemoryPressureLevelCritical) {
+    _criticalCount++;
+  }
+  if (_relaxHandle) {
+    [_clock cancelScheduledBlock:_relaxHandle];
+    _relaxHandle = nil;
+  }
+  if (level != kGMFMemoryPressureLevelNormal) {
+    __weak GMFMemoryGovernor *weakSelf = self;
+    _relaxHandle = [_clock scheduleBlock:^{
+        GMFMemoryGovernor *strongSelf = weakSelf;
+        if (strongSelf) {
+          strongSelf->_relaxHandle = nil;
+          [strongSelf handleMemoryPressureLevel:kGMFMemoryPressureLevelNormal];
+        }
+    } afterDelay:_relaxInterval];
+  }
+  // A responder may register or unregister others while trimming.
+  for (id<GMFMemoryPressureResponder> responder in [self responders]) {
+    [responder trimMemoryForPressureLevel:level];
+  }
+}
+
+- (uint64_t)estimatedMemoryCost {
+  uint64_t cost = 0;
+  for (id<GMFMemoryPressureResponder> responder in [self responders]) {
+    cost += [responder estimatedMemoryCost];
+  }
+  return cost;
+}
+
+#pragma mark Private Methods
+
+// Only the shared governor listens, so tests can drive their own without the system interfering.
+- (void)observeSystemMemoryPressure {
+  [[NSNotificationCenter defaultCenter]
+      addObserver:self
+         selector:@selector(applicationDidReceiveMemoryWarning:)
+             name:UIApplicationDidReceiveMemoryWarningNotification
+           object:nil];
+  // The memory pressure source is iOS 8.0+; before that, UIKit's warnings are all there is.
+  // -[NSProcessInfo isOperatingSystemAtLeastVersion:] arrived in the same release.
+  NSProcessInfo *processInfo = [NSProcessInfo processInfo];
+  if (![processInfo respondsToSelector:@selector(isOperatingSystemAtLeastVersion:)]) {
+    return;
+  }
+  _pressureSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE,
+                                           0,
+                                           DISPATCH_MEMORYPRESSURE_NORMAL |
+                                               DISPATCH_MEMORYPRESSURE_WARN |
+                                               DISPATCH_MEMORYPRESSURE_CRITICAL,
+                                           dispatch_get_main_queue());
+  if (!_pressureSource) {
+    return;
+  }
+  __weak GMFMemoryGovernor *weakSelf = self;
+  dispatch_source_set_event_handler(_pressureSource, ^{
+      GMFMemoryGovernor *strongSelf = weakSelf;
+      if (!strongSelf) {
+        return;
+      }
+      unsigned long flags = dispatch_source_get_data(strongSelf->_pressureSource);
+      GMFMemoryPressureLevel level = kGMFMemoryPressureLevelNormal;
+      if (flags & DISPATCH_MEMORYPRESSURE_CRITICAL) {
+        level = kGMFMemoryPressureLevelCritical;
+      } else if (flags & DISPATCH_MEMORYPRESSURE_WARN) {
+        level = kGMFMemoryPressureLevelWarning;
+      }
+      [strongSelf handleMemoryPressureLevel:level];
+  });
+  dispatch_resume(_pressureSource);
+}
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification {
+  [self handleMemoryPressureLevel:kGMFMemoryPressureLevelCritical];
+}
+
+@end
@@ -0,0 +1,75 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFSeekEngine.h"
+#import "GMFTimeRangeSet.h"
+
+@protocol GMFPlaybackBackend;
+
+typedef enum {
+  kGMFPlaybackBackendStatusUnknown = 0,
+  kGMFPlaybackBackendStatusReadyToPlay,
+  // The item failed to load, or stopped short of its end during playback.
+  kGMFPlaybackBackendStatusFailed
+} GMFPlaybackBackendStatus;
+
+// Events of a backend, in the order the media pipeline produces them. Called on the main thread.
+@protocol GMFPlaybackBackendDelegate<NSObject>
+
+- (void)playbackBackendStatusDidChange:(id<GMFPlaybackBackend>)backend;
+
+- (void)playbackBackendRateDidChange:(id<GMFPlaybackBackend>)backend;
+
+// |isPlaybackBufferEmpty| or |isPlaybackLikelyToKeepUp| changed.
+- (void)playbackBackendBufferStatusDidChange:(id<GMFPlaybackBackend>)backend;
+
+// Playback ran out of data, possibly before the buffer status says so.
+- (void)playbackBackendDidStall:(id<GMFPlaybackBackend>)backend;
+
+- (void)playbackBackendDidPlayToEnd:(id<GMFPlaybackBackend>)backend;
+
+@end
+
+// The media pipeline behind GMFPlaybackStateMachine: one item and the player rendering it.
+// GMFAVPlaybackBackend wraps AVFoundation; GMFSimulatedPlaybackBackend plays a scripted item on a
+// GMFClock so the state machine can be tested without media or a network.
+@protocol GMFPlaybackBackend<GMFSeekBackend>
+
+@property(nonatomic, weak) id<GMFPlaybackBackendDelegate> delegate;
+
+- (GMFPlaybackBackendStatus)status;
+
+// 0 while paused, stalled or finished.
+- (float)rate;
+
+// Rate |play| starts playback at, 1 by default. Changes a rate already playing right away.
+- (void)setPlaybackRate:(float)playbackRate;
+
+- (void)play;
+- (void)pause;
+
+- (BOOL)isPlaybackBufferEmpty;
+- (BOOL)isPlaybackLikelyToKeepUp;
+
+// In seconds. The duration is 0 while unknown and for live streams.
+- (NSTimeInterval)currentTime;
+- (NSTimeInterval)duration;
+
+// Where the item can be positioned, in seconds. Slides forward as a live stream grows; its end is
+// the live point playback joins at. Empty while unknown.
+- (GMFTimeRange)seekableTimeRange;
+
+@end
@@ -0,0 +1,87 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFClock.h"
+#import "GMFPlaybackBackend.h"
+#import "GMFPlayerState.h"
+#import "GMFSeekEngine.h"
+
+@class GMFPlaybackStateMachine;
+
+@protocol GMFPlaybackStateMachineDelegate<NSObject>
+
+- (void)stateMachine:(GMFPlaybackStateMachine *)stateMachine
+    stateDidChangeFrom:(GMFPlayerState)fromState
+                    to:(GMFPlayerState)toState;
+
+@optional
+// The backend landed on a new position, at the end of a seek or of the stream, and the state is
+// about to change.
+- (void)stateMachineDidJumpInTime:(GMFPlaybackStateMachine *)stateMachine;
+
+// The backend played to the end. Return NO to handle it instead, e.g. by moving on to the next
+// playlist item; otherwise the state machine enters the finished state.
+- (BOOL)stateMachineShouldFinish:(GMFPlaybackStateMachine *)stateMachine;
+
+// The backend failed, while loading or during playback. Return NO to handle it instead, e.g. by
+// switching to another source of the stream; otherwise the state machine enters the error state.
+- (BOOL)stateMachineShouldFail:(GMFPlaybackStateMachine *)stateMachine;
+
+@end
+
+// The player state logic of GMFVideoPlayer, independent of AVFoundation: turns play, pause and
+// seek requests into backend commands, and backend events into GMFPlayerState transitions. Drive
+// it with a GMFSimulatedPlaybackBackend and a GMFVirtualClock to reproduce stalls, slow loads,
+// seek races and end of stream deterministically. Main thread only.
+@interface GMFPlaybackStateMachine : NSObject<GMFPlaybackBackendDelegate, GMFSeekEngineDelegate>
+
+@property(nonatomic, weak) id<GMFPlaybackStateMachineDelegate> delegate;
+
+// The current item. Replacing it cancels any seek in progress but keeps the state; the owner
+// sets the state that goes with the new item.
+@property(nonatomic, strong) id<GMFPlaybackBackend> backend;
+
+// Set directly by the owner when it loads, resets or fails; transitions during playback follow
+// the backend.
+@property(nonatomic, assign) GMFPlayerState state;
+
+// Play was requested before the backend could start, i.e. while loading or seeking.
+@property(nonatomic, assign) BOOL pendingPlay;
+
+// Set by |pause| and cleared by |play|, so an interruption that ends doesn't resume playback the
+// user paused.
+@property(nonatomic, readonly) BOOL manuallyPaused;
+
+// Issues the seeks of |seekToTime:mode:| to |backend|.
+@property(nonatomic, readonly) GMFSeekEngine *seekEngine;
+
+// Uses the shared GMFTimerWheel.
+- (instancetype)init;
+
+// |clock| times the seeks.
+- (instancetype)initWithClock:(id<GMFClock>)clock;
+
+- (void)play;
+- (void)pause;
+
+// Seeks to |time|, which the caller has clamped, once the backend is ready to play. Does
+// nothing before that.
+- (void)seekToTime:(NSTimeInterval)time mode:(GMFSeekMode)mode;
+
+// Clears the pending play and pause flags and cancels any seek. The state is left alone.
+- (void)clear;
+
+@end
@@ -0,0 +1,207 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFPlaybackStateMachine.h"
+#import "GMFTimerWheel.h"
+#import "GMFTrace.h"
+
+@implementation GMFPlaybackStateMachine
+
+- (instancetype)init {
+  return [self initWithClock:[GMFTimerWheel sharedWheel]];
+}
+
+- (instancetype)initWithClock:(id<GMFClock>)clock {
+  self = [super init];
+  if (self) {
+    _state = kGMFPlayerStateEmpty;
+    _seekEngine = [[GMFSeekEngine alloc] initWithClock:clock];
+    [_seekEngine setDelegate:self];
+  }
+  return self;
+}
+
+- (void)setBackend:(id<GMFPlaybackBackend>)backend {
+  if (backend == _backend) {
+    return;
+  }
+  [_backend setDelegate:nil];
+  _backend = backend;
+  [_backend setDelegate:self];
+  [_seekEngine setBackend:backend];
+}
+
+- (void)setState:(GMFPlayerState)state {
+  if (state != _state) {
+    GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "player.setState", state);
+    GMFPlayerState prevState = _state;
+    _state = state;
+    // Call this last in case the delegate removes references/destroys self.
+    [_delegate stateMachine:self stateDidChangeFrom:prevState to:state];
+  }
+}
+
+- (void)play {
+  _manuallyPaused = NO;
+  if (_state == kGMFPlayerStateLoadingContent || _state == kGMFPlayerStateSeeking) {
+    _pendingPlay = YES;
+  } else if (![_backend rate]) {
+    _pendingPlay = YES;
+    [_backend play];
+  }
+}
+
+- (void)pause {
+  _pendingPlay = NO;
+  _manuallyPaused = YES;
+  if (_state == kGMFPlayerStatePlaying ||
+      _state == kGMFPlayerStateBuffering ||
+      _state == kGMFPlayerStateSeeking) {
+    [_backend pause];
+    // Setting paused state here rather than from the rate change, since the rate can drop to 0
+    // because of buffer issues too.
+    [self setState:kGMFPlayerStatePaused];
+  }
+}
+
+- (void)seekToTime:(NSTimeInterval)time mode:(GMFSeekMode)mode {
+  if ([_backend status] != kGMFPlaybackBackendStatusReadyToPlay) {
+    // Calling [AVPlayerItem seekToTime:] before it is in the "ready to play" state
+    // causes a crash.
+    // TODO(tensafefrogs): Dev assert here instead of silent return.
+    return;
+  }
+  [self setState:kGMFPlayerStateSeeking];
+  [_seekEngine seekToTime:time mode:mode];
+}
+
+- (void)clear {
+  _pendingPlay = NO;
+  _manuallyPaused = NO;
+  [_seekEngine cancel];
+}
+
+#pragma mark GMFPlaybackBackendDelegate
+
+- (void)playbackBackendStatusDidChange:(id<GMFPlaybackBackend>)backend {
+  if ([_backend status] == kGMFPlaybackBackendStatusReadyToPlay &&
+      _state == kGMFPlayerStateLoadingContent) {
+    // TODO(tensafefrogs): It seems like additional AVPlayerItemStatusReadyToPlay
+    // events indicate HLS stream switching. Investigate.
+    [self setState:kGMFPlayerStateReadyToPlay];
+    if (_pendingPlay) {
+      _pendingPlay = NO;
+      // Let's buffer some more data; playback starts once the item is likely to keep up.
+      [self setState:kGMFPlayerStateBuffering];
+      [self playbackBackendBufferStatusDidChange:backend];
+    } else {
+      [self setState:kGMFPlayerStatePaused];
+    }
+  } else if ([_backend status] == kGMFPlaybackBackendStatusFailed &&
+             _state != kGMFPlayerStateError) {
+    if ([_delegate respondsToSelector:@selector(stateMachineShouldFail:)] &&
+        ![_delegate stateMachineShouldFail:self]) {
+      return;
+    }
+    [_seekEngine cancel];
+    _pendingPlay = NO;
+    [self setState:kGMFPlayerStateError];
+  }
+}
+
+- (void)playbackBackendRateDidChange:(id<GMFPlaybackBackend>)backend {
+  if (_state == kGMFPlayerStateError) {
+    // A failed item stops; that isn't a pause.
+    return;
+  }
+  if ([_backend rate] > 0) {
+    [self setState:kGMFPlayerStatePlaying];
+  } else if (_state == kGMFPlayerStateFinished) {
+    // Stopping a stream that doesn't pause by itself at the end, see
+    // |playbackBackendDidPlayToEnd:|.
+  } else if (!_manuallyPaused && [_backend isPlaybackBufferEmpty] &&
+             (_state == kGMFPlayerStatePlaying || _state == kGMFPlayerStateBuffering)) {
+    // AVPlayer drops the rate to 0 when it runs out of data.
+    [self setState:kGMFPlayerStateBuffering];
+  } else {
+    [self setState:kGMFPlayerStatePaused];
+  }
+}
+
+- (void)playbackBackendBufferStatusDidChange:(id<GMFPlaybackBackend>)backend {
+  if (_state == kGMFPlayerStatePlaying && [_backend isPlaybackBufferEmpty]) {
+    [self setState:kGMFPlayerStateBuffering];
+  } else if (_state == kGMFPlayerStateBuffering && [_backend isPlaybackLikelyToKeepUp]) {
+    if ([_backend rate]) {
+      // Player resumed playback from buffering state.
+      [self setState:kGMFPlayerStatePlaying];
+    } else {
+      [_backend play];
+    }
+  }
+}
+
+- (void)playbackBackendDidStall:(id<GMFPlaybackBackend>)backend {
+  if (_state == kGMFPlayerStatePlaying) {
+    [self setState:kGMFPlayerStateBuffering];
+  }
+}
+
+- (void)playbackBackendDidPlayToEnd:(id<GMFPlaybackBackend>)backend {
+  if ([_backend status] != kGMFPlaybackBackendStatusReadyToPlay) {
+    // In some cases, |AVPlayerItemDidPlayToEndTimeNotification| is fired while
+    // the player is being initialized. Ignore such notifications.
+    return;
+  }
+  if ([_delegate respondsToSelector:@selector(stateMachineShouldFinish:)] &&
+      ![_delegate stateMachineShouldFinish:self]) {
+    return;
+  }
+  // Make sure the final media time is reported before playback stops.
+  if ([_delegate respondsToSelector:@selector(stateMachineDidJumpInTime:)]) {
+    [_delegate stateMachineDidJumpInTime:self];
+  }
+  [self setState:kGMFPlayerStateFinished];
+  // For HLS videos, the rate isn't set to 0 on video end, so we have to do it
+  // explicitly.
+  if ([_backend rate]) {
+    [_backend pause];
+  }
+}
+
+#pragma mark GMFSeekEngineDelegate
+
+- (void)seekEngine:(GMFSeekEngine *)engine
+    didFinishSeekingToTime:(NSTimeInterval)time
+                  finished:(BOOL)finished {
+  if (!finished) {
+    return;
+  }
+  // Report the new position now rather than on the next tick.
+  if ([_delegate respondsToSelector:@selector(stateMachineDidJumpInTime:)]) {
+    [_delegate stateMachineDidJumpInTime:self];
+  }
+  if (_pendingPlay) {
+    _pendingPlay = NO;
+    [_backend play];
+  } else {
+    [self setState:kGMFPlayerStatePaused];
+  }
+}
+
+@end
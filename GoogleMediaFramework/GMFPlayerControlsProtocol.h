@@ -14,6 +14,7 @@
 
 #import <Foundation/Foundation.h>
 #import "GMFPlayerControlsView.h"
+#import "GMFTimeRangeSet.h"
 
 @protocol GMFPlayerControlsProtocol<NSObject>
 
@@ -43,5 +44,14 @@
 - (void)applyControlTintColor:(UIColor *)color;
 - (void)setVideoTitle:(NSString *)videoTitle;
 - (void)setLogoImage:(UIImage *)logoImage;
+// Loaded time ranges to draw behind the seekbar. Pass nil to clear them.
+- (void)setBufferedRanges:(GMFTimeRangeSet *)bufferedRanges;
+// DVR window of a live stream for the seekbar to span. Pass an empty range for the total time.
+- (void)setSeekableRange:(GMFTimeRange)seekableRange;
+// Thumbnail shown over the seekbar while scrubbing, see GMFPlayerControlsView.
+- (void)setScrubPreviewImage:(UIImage *)image region:(CGRect)region;
+// Caption cues coming on and off screen, see GMFCaptionTrack. The text of every cue entered and
+// not yet exited is shown.
+- (void)updateCaptionsWithEnteredCues:(NSArray *)enteredCues exitedCues:(NSArray *)exitedCues;
 
 @end
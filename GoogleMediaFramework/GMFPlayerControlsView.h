@@ -15,6 +15,8 @@
 #import <Foundation/Foundation.h>
 #import <UIKit/UIKit.h>
 
+#import "GMFTimeRangeSet.h"
+
 @protocol GMFPlayerControlsViewDelegate <NSObject>
 
 - (void)didPressPlay;
@@ -27,6 +29,11 @@
 - (void)didStartScrubbing;
 - (void)didEndScrubbing;
 
+@optional
+
+// The scrubber moved to |time| while being dragged. |didSeekToTime:| follows when it is let go.
+- (void)didScrubToTime:(NSTimeInterval)time;
+
 @end
 
 @interface GMFPlayerControlsView : UIView
@@ -35,16 +42,41 @@
 // total time is unknown. Call updateScrubberAndTime to make the change visible.
 - (void)setTotalTime:(NSTimeInterval)totalTime;
 
+// Set the seekable window of a live stream, which the scrubber then spans instead of
+// [0, total time], with the total time label showing its end. Pass an empty range to go back to
+// the total time. Call updateScrubberAndTime to make the change visible.
+- (void)setSeekableRange:(GMFTimeRange)seekableRange;
+
 // Set the amount of video downloaded. Call updateScrubberAndTime to make
 // the change visible.
 - (void)setDownloadedTime:(NSTimeInterval)downloadedTime;
 
+// Set the loaded time ranges, drawn as segments behind the scrubber track. Takes precedence
+// over the downloaded time when non-empty. Call updateScrubberAndTime to make the change visible.
+- (void)setBufferedRanges:(GMFTimeRangeSet *)bufferedRanges;
+
 // Set the current position of the scrubber within the total video duration.
 // Call updateScrubberAndTime to make the change visible.
 - (void)setMediaTime:(NSTimeInterval)mediaTime;
 
+// Schedules the changes made through the setters above to be shown on the next display frame.
+// Any number of calls within a frame result in a single commit, which touches only the fields
+// whose values changed.
 - (void)updateScrubberAndTime;
 
+// Shows any changes scheduled by updateScrubberAndTime now instead of on the next frame.
+- (void)commitPendingUpdates;
+
+// Commits applied and label texts rebuilt since init or the last resetUpdateStatistics.
+- (NSUInteger)commitCount;
+- (NSUInteger)labelRebuildCount;
+
+// The same counts averaged over the time since init or the last resetUpdateStatistics.
+- (double)commitsPerSecond;
+- (double)labelRebuildsPerSecond;
+
+- (void)resetUpdateStatistics;
+
 - (CGFloat)preferredHeight;
 
 - (void)setDelegate:(id<GMFPlayerControlsViewDelegate>)delegate;
@@ -56,5 +88,9 @@
 
 - (void)applyControlTintColor:(UIColor *)color;
 
+// Shows |region| of |image|, in pixels, above the scrubber thumb until scrubbing ends. Pass
+// CGRectNull for the whole image and a nil image to hide it.
+- (void)setScrubPreviewImage:(UIImage *)image region:(CGRect)region;
+
 @end
 
@@ -16,12 +16,99 @@
 #error "This file requires ARC support."
 #endif
 
+#import <QuartzCore/QuartzCore.h>
+
+#import "GMFBarLayout.h"
+#import "GMFDurationFormatter.h"
+#import "GMFFrameCoalescer.h"
 #import "GMFPlayerControlsView.h"
 #import "GMFResources.h"
 #import "UILabel+GMFLabels.h"
 #import "UIButton+GMFTintableButton.h"
 
-static const CGFloat kGMFBarPaddingX = 8;
+static const CGFloat kGMFBufferedBarHeight = 2;
+// Width of the scrub preview; its height follows the thumbnail's aspect ratio.
+static const CGFloat kGMFScrubPreviewWidth = 160;
+// Gap between the scrub preview and the top of the bar.
+static const CGFloat kGMFScrubPreviewMargin = 8;
+
+// Fields changed since the last commit.
+typedef NS_OPTIONS(NSUInteger, GMFControlsDirtyFields) {
+  kGMFControlsDirtyTotalTime = 1 << 0,
+  kGMFControlsDirtyMediaTime = 1 << 1,
+  kGMFControlsDirtyBufferedRanges = 1 << 2,
+};
+
+// Treats two NaNs as equal, so an unknown duration doesn't dirty every tick.
+static BOOL GMFTimeIntervalsEqual(NSTimeInterval a, NSTimeInterval b) {
+  return a == b || (isnan(a) && isnan(b));
+}
+
+#pragma mark GMFBufferedRangesView
+
+// Draws each loaded time range as a segment of the scrubber track.
+@interface GMFBufferedRangesView : UIView
+
+@property(nonatomic, strong) UIColor *segmentColor;
+
+// Draws |ranges| over the track spanning |window|, e.g. [0, duration] or a live stream's DVR
+// window. Redraws only if either differs from what is currently drawn.
+- (void)setRanges:(GMFTimeRangeSet *)ranges window:(GMFTimeRange)window;
+
+@end
+
+@implementation GMFBufferedRangesView {
+  GMFTimeRangeSet *_ranges;
+  GMFTimeRange _window;
+}
+
+- (id)initWithFrame:(CGRect)frame {
+  self = [super initWithFrame:frame];
+  if (self) {
+    [self setOpaque:NO];
+    [self setUserInteractionEnabled:NO];
+    [self setContentMode:UIViewContentModeRedraw];
+    _segmentColor = [UIColor colorWithWhite:200/255.0 alpha:1.0];
+  }
+  return self;
+}
+
+- (void)setRanges:(GMFTimeRangeSet *)ranges window:(GMFTimeRange)window {
+  if (_window.start == window.start && _window.end == window.end &&
+      (_ranges == ranges || [_ranges isEqualToTimeRangeSet:ranges])) {
+    return;
+  }
+  _ranges = ranges;
+  _window = window;
+  [self setNeedsDisplay];
+}
+
+- (void)drawRect:(CGRect)rect {
+  // Unloaded items and live streams without a window have no usable duration to scale against.
+  NSTimeInterval windowDuration = _window.end - _window.start;
+  if (!isfinite(windowDuration) || windowDuration <= 0) {
+    return;
+  }
+  CGRect bounds = [self bounds];
+  CGFloat pointsPerSecond = bounds.size.width / windowDuration;
+  [_segmentColor setFill];
+  NSUInteger count = [_ranges count];
+  for (NSUInteger i = 0; i < count; i++) {
+    GMFTimeRange range = [_ranges rangeAtIndex:i];
+    CGFloat minX = MAX(0, (range.start - _window.start) * pointsPerSecond);
+    CGFloat maxX = MIN(bounds.size.width, (range.end - _window.start) * pointsPerSecond);
+    if (maxX > minX) {
+      UIRectFill(CGRectMake(bounds.origin.x + minX,
+                            bounds.origin.y,
+                            maxX - minX,
+                            bounds.size.height));
+    }
+  }
+}
+
+@end
+
+#pragma mark GMFPlayerControlsView
 
 @implementation GMFPlayerControlsView {
   UIImageView *_backgroundView;
@@ -29,11 +116,31 @@ static const CGFloat kGMFBarPaddingX = 8;
   UILabel *_secondsPlayedLabel;
   UILabel *_totalSecondsLabel;
   UISlider *_scrubber;
+  GMFBufferedRangesView *_bufferedRangesView;
+  // Shows a region of a sprite sheet above the scrubber thumb through its layer's contentsRect,
+  // so the thumbnail isn't cropped into an image of its own.
+  UIView *_scrubPreviewView;
+  CGFloat _minimizeButtonWidth;
+  // What the subviews' frames were last laid out for.
+  GMFControlBarLayoutInput _layoutInput;
+  BOOL _hasLayout;
+  GMFTimeRangeSet *_bufferedRanges;
   NSTimeInterval _totalSeconds;
+  // Empty unless the stream is live; the scrubber then spans it instead of the total time.
+  GMFTimeRange _seekableRange;
   NSTimeInterval _mediaTime;
   NSTimeInterval _downloadedSeconds;
   BOOL _userScrubbing;
 
+  GMFFrameCoalescer *_updateCoalescer;
+  GMFControlsDirtyFields _dirtyFields;
+  // Seconds currently shown by each label, so unchanged text isn't rebuilt.
+  NSInteger _displayedMediaSeconds;
+  NSInteger _displayedTotalSeconds;
+  NSUInteger _commitCount;
+  NSUInteger _labelRebuildCount;
+  CFTimeInterval _statisticsStartTime;
+
   __weak id<GMFPlayerControlsViewDelegate> _delegate;
 }
 
@@ -61,7 +168,8 @@ static const CGFloat kGMFBarPaddingX = 8;
     [_scrubber setAccessibilityLabel:
         NSLocalizedStringFromTable(@"Seek bar", @"GoogleMediaFramework", nil)];
     [self setSeekbarThumbToDefaultImage];
-    [_scrubber setMaximumTrackTintColor:[UIColor colorWithWhite:122/255.0 alpha:1.0]];
+    // Translucent so the buffered segments drawn underneath show through.
+    [_scrubber setMaximumTrackTintColor:[UIColor colorWithWhite:122/255.0 alpha:0.6]];
     [_scrubber addTarget:self
                   action:@selector(didScrubbingProgress:)
         forControlEvents:UIControlEventValueChanged];
@@ -75,8 +183,17 @@ static const CGFloat kGMFBarPaddingX = 8;
     [_scrubber addTarget:self
                   action:@selector(didScrubbingEnd:)
         forControlEvents:UIControlEventTouchUpOutside];
+    _bufferedRangesView = [[GMFBufferedRangesView alloc] initWithFrame:CGRectZero];
+    [self addSubview:_bufferedRangesView];
     [self addSubview:_scrubber];
 
+    _scrubPreviewView = [[UIView alloc] initWithFrame:CGRectZero];
+    [_scrubPreviewView setHidden:YES];
+    [_scrubPreviewView setUserInteractionEnabled:NO];
+    [[_scrubPreviewView layer] setBorderColor:[[UIColor whiteColor] CGColor]];
+    [[_scrubPreviewView layer] setBorderWidth:1];
+    [self addSubview:_scrubPreviewView];
+
     _minimizeButton = [self playerButtonWithImage:[GMFResources playerBarMinimizeButtonImage]
                                            action:@selector(didPressMinimize:)
                                accessibilityLabel:
@@ -84,8 +201,19 @@ static const CGFloat kGMFBarPaddingX = 8;
                                                               @"GoogleMediaFramework",
                                                               nil)];
     [self addSubview:_minimizeButton];
-
-    [self setupLayoutConstraints];
+    _minimizeButtonWidth = [_minimizeButton sizeThatFits:CGSizeZero].width;
+
+    // Everything is stale until the first commit.
+    _dirtyFields = kGMFControlsDirtyTotalTime |
+                   kGMFControlsDirtyMediaTime |
+                   kGMFControlsDirtyBufferedRanges;
+    _displayedMediaSeconds = NSIntegerMin;
+    _displayedTotalSeconds = NSIntegerMin;
+    _statisticsStartTime = CACurrentMediaTime();
+    __weak GMFPlayerControlsView *weakSelf = self;
+    _updateCoalescer = [[GMFFrameCoalescer alloc] initWithCommitBlock:^{
+        [weakSelf applyDirtyFields];
+    }];
   }
   return self;
 }
@@ -96,6 +224,7 @@ static const CGFloat kGMFBarPaddingX = 8;
 }
 
 - (void)dealloc {
+  [_updateCoalescer invalidate];
   [_scrubber removeTarget:self
                    action:NULL
          forControlEvents:UIControlEventAllEvents];
@@ -104,126 +233,45 @@ static const CGFloat kGMFBarPaddingX = 8;
             forControlEvents:UIControlEventTouchUpInside];
 }
 
-
-- (void)setupLayoutConstraints {
-  [_backgroundView setTranslatesAutoresizingMaskIntoConstraints:NO];
-  [_secondsPlayedLabel setTranslatesAutoresizingMaskIntoConstraints:NO];
-  [_totalSecondsLabel setTranslatesAutoresizingMaskIntoConstraints:NO];
-  [_scrubber setTranslatesAutoresizingMaskIntoConstraints:NO];
-  [_minimizeButton setTranslatesAutoresizingMaskIntoConstraints:NO];
-
-  NSDictionary *viewsDictionary = NSDictionaryOfVariableBindings(_backgroundView,
-                                                                 _secondsPlayedLabel,
-                                                                 _scrubber,
-                                                                 _totalSecondsLabel,
-                                                                 _minimizeButton);
-  
-  NSArray *constraints = [[NSArray alloc] init];
-  
-  // Make the background view occupy the full height of the view.
-  constraints = [constraints arrayByAddingObjectsFromArray:
-                 [NSLayoutConstraint constraintsWithVisualFormat:@"V:|[_backgroundView]|"
-                                                         options:NSLayoutFormatAlignAllBaseline
-                                                         metrics:nil
-                                                           views:viewsDictionary]];
-  
-  // Make the background view occupy the full width of the view.
-  constraints = [constraints arrayByAddingObjectsFromArray:
-                 [NSLayoutConstraint constraintsWithVisualFormat:@"H:|[_backgroundView]|"
-                                                         options:NSLayoutFormatAlignAllBaseline
-                                                         metrics:nil
-                                                           views:viewsDictionary]];
-  
-  // Make the minimize button occupy the full height of the view.
-  constraints = [constraints arrayByAddingObjectsFromArray:
-                 [NSLayoutConstraint constraintsWithVisualFormat:@"V:|[_minimizeButton]|"
-                                                         options:NSLayoutFormatAlignAllBaseline
-                                                         metrics:nil
-                                                           views:viewsDictionary]];
-  
-  // Position the minimize button kGMFBarPaddingX from the right of the background view.
-  constraints = [constraints arrayByAddingObject:
-                 [NSLayoutConstraint constraintWithItem:_minimizeButton
-                                              attribute:NSLayoutAttributeRight
-                                              relatedBy:NSLayoutRelationEqual
-                                                 toItem:_backgroundView
-                                              attribute:NSLayoutAttributeRight
-                                             multiplier:1.0f
-                                               constant:-1*kGMFBarPaddingX]];
-  
-  // Make the total seconds label occupy the full height of the view.
-  constraints = [constraints arrayByAddingObjectsFromArray:
-                 [NSLayoutConstraint constraintsWithVisualFormat:@"V:|[_totalSecondsLabel]|"
-                                                         options:NSLayoutFormatAlignAllBaseline
-                                                         metrics:nil
-                                                           views:viewsDictionary]];
-
-  // Position the total seconds label kGMFBarPaddingX from the left of the minimize button
-  constraints = [constraints arrayByAddingObject:
-                 [NSLayoutConstraint constraintWithItem:_totalSecondsLabel
-                                              attribute:NSLayoutAttributeRight
-                                              relatedBy:NSLayoutRelationEqual
-                                                 toItem:_minimizeButton
-                                              attribute:NSLayoutAttributeLeft
-                                             multiplier:1.0f
-                                               constant:-1*kGMFBarPaddingX]];
-  
-  // Make the scrubber occupy the full height of the view.
-  constraints = [constraints arrayByAddingObjectsFromArray:
-                 [NSLayoutConstraint constraintsWithVisualFormat:@"V:|[_scrubber]|"
-                                                         options:NSLayoutFormatAlignAllBaseline
-                                                         metrics:nil
-                                                           views:viewsDictionary]];
-  
-  // Position the scrubber kGMFBarPaddingX to the left of the total seconds label.
-  constraints = [constraints arrayByAddingObject:
-                 [NSLayoutConstraint constraintWithItem:_scrubber
-                                              attribute:NSLayoutAttributeRight
-                                              relatedBy:NSLayoutRelationEqual
-                                                 toItem:_totalSecondsLabel
-                                              attribute:NSLayoutAttributeLeft
-                                             multiplier:1.0f
-                                               constant:-8.0f]];
-  
-  // Position the scrubber kGMFBarPaddingX to the right of the seconds played label.
-  constraints = [constraints arrayByAddingObject:
-                 [NSLayoutConstraint constraintWithItem:_scrubber
-                                              attribute:NSLayoutAttributeLeft
-                                              relatedBy:NSLayoutRelationEqual
-                                                 toItem:_secondsPlayedLabel
-                                              attribute:NSLayoutAttributeRight
-                                             multiplier:1.0f
-                                               constant:8.0f]];
-  
-  // Make the seconds played label occupy the full height of the view
-  constraints = [constraints arrayByAddingObjectsFromArray:
-                 [NSLayoutConstraint constraintsWithVisualFormat:@"V:|[_secondsPlayedLabel]|"
-                                                         options:NSLayoutFormatAlignAllBaseline
-                                                         metrics:nil
-                                                           views:viewsDictionary]];
-  
-  // Position the seconds played label kGMFBarPaddingX to the right of the background view.
-  constraints = [constraints arrayByAddingObject:
-                 [NSLayoutConstraint constraintWithItem:_secondsPlayedLabel
-                                              attribute:NSLayoutAttributeLeft
-                                              relatedBy:NSLayoutRelationEqual
-                                                 toItem:_backgroundView
-                                              attribute:NSLayoutAttributeLeft
-                                             multiplier:1.0f
-                                               constant:8.0f]];
-  [self addConstraints:constraints];
-}
-
 - (void)setTotalTime:(NSTimeInterval)totalTime {
+  if (GMFTimeIntervalsEqual(_totalSeconds, totalTime)) {
+    return;
+  }
   _totalSeconds = totalTime;
+  _dirtyFields |= kGMFControlsDirtyTotalTime;
+}
+
+- (void)setSeekableRange:(GMFTimeRange)seekableRange {
+  if (GMFTimeIntervalsEqual(_seekableRange.start, seekableRange.start) &&
+      GMFTimeIntervalsEqual(_seekableRange.end, seekableRange.end)) {
+    return;
+  }
+  _seekableRange = seekableRange;
+  _dirtyFields |= kGMFControlsDirtyTotalTime;
 }
 
 - (void)setDownloadedTime:(NSTimeInterval)downloadedTime {
+  if (GMFTimeIntervalsEqual(_downloadedSeconds, downloadedTime)) {
+    return;
+  }
   _downloadedSeconds = downloadedTime;
+  _dirtyFields |= kGMFControlsDirtyBufferedRanges;
+}
+
+- (void)setBufferedRanges:(GMFTimeRangeSet *)bufferedRanges {
+  if (_bufferedRanges == bufferedRanges || [_bufferedRanges isEqualToTimeRangeSet:bufferedRanges]) {
+    return;
+  }
+  _bufferedRanges = [bufferedRanges copy];
+  _dirtyFields |= kGMFControlsDirtyBufferedRanges;
 }
 
 - (void)setMediaTime:(NSTimeInterval)mediaTime {
+  if (GMFTimeIntervalsEqual(_mediaTime, mediaTime)) {
+    return;
+  }
   _mediaTime = mediaTime;
+  _dirtyFields |= kGMFControlsDirtyMediaTime;
 }
 
 - (CGFloat)preferredHeight {
@@ -234,15 +282,150 @@ static const CGFloat kGMFBarPaddingX = 8;
   _delegate = delegate;
 }
 
+- (void)layoutSubviews {
+  [super layoutSubviews];
+  GMFControlBarLayoutInput input = {
+    [self bounds].size,
+    ceil([_secondsPlayedLabel sizeThatFits:CGSizeZero].width),
+    ceil([_totalSecondsLabel sizeThatFits:CGSizeZero].width),
+    _minimizeButtonWidth
+  };
+  if (_hasLayout && GMFControlBarLayoutInputsEqual(input, _layoutInput)) {
+    return;
+  }
+  _layoutInput = input;
+  _hasLayout = YES;
+  GMFControlBarLayout layout = GMFLayoutControlBar(input);
+  [_backgroundView setFrame:layout.background];
+  [_secondsPlayedLabel setFrame:layout.secondsPlayedLabel];
+  [_scrubber setFrame:layout.scrubber];
+  [_totalSecondsLabel setFrame:layout.totalSecondsLabel];
+  [_minimizeButton setFrame:layout.minimizeButton];
+
+  // Line the buffered segments up with the slider's track, which is inset from its bounds.
+  CGRect trackRect = [_scrubber trackRectForBounds:[_scrubber bounds]];
+  trackRect = [self convertRect:trackRect fromView:_scrubber];
+  [_bufferedRangesView setFrame:CGRectMake(CGRectGetMinX(trackRect),
+                                           CGRectGetMidY(trackRect) - kGMFBufferedBarHeight / 2,
+                                           CGRectGetWidth(trackRect),
+                                           kGMFBufferedBarHeight)];
+}
+
 - (void)updateScrubberAndTime {
-  // TODO(tensafefrogs): Handle live streams
-  [_scrubber setMaximumValue:_totalSeconds];
-  [_totalSecondsLabel setText:[self stringWithDurationSeconds:_totalSeconds]];
-  [_secondsPlayedLabel setText:[self stringWithDurationSeconds:_mediaTime]];
+  if (_dirtyFields || _userScrubbing) {
+    [_updateCoalescer setNeedsCommit];
+  }
+}
+
+- (void)commitPendingUpdates {
+  [_updateCoalescer commitIfNeeded];
+}
+
+- (NSUInteger)commitCount {
+  return _commitCount;
+}
+
+- (NSUInteger)labelRebuildCount {
+  return _labelRebuildCount;
+}
+
+- (double)commitsPerSecond {
+  return _commitCount / [self secondsSinceStatisticsReset];
+}
+
+- (double)labelRebuildsPerSecond {
+  return _labelRebuildCount / [self secondsSinceStatisticsReset];
+}
+
+- (void)resetUpdateStatistics {
+  _commitCount = 0;
+  _labelRebuildCount = 0;
+  _statisticsStartTime = CACurrentMediaTime();
+}
+
+- (void)applyControlTintColor:(UIColor *)color {
+  [_scrubber setMinimumTrackTintColor:color];
+  [_scrubber setThumbTintColor:color];
+  [_minimizeButton GMF_applyTintColor:color];
+}
+
+- (void)setScrubPreviewImage:(UIImage *)image region:(CGRect)region {
+  CGImageRef cgImage = [image CGImage];
+  if (!cgImage) {
+    [_scrubPreviewView setHidden:YES];
+    [[_scrubPreviewView layer] setContents:nil];
+    return;
+  }
+  CGFloat width = CGImageGetWidth(cgImage);
+  CGFloat height = CGImageGetHeight(cgImage);
+  if (CGRectIsNull(region)) {
+    region = CGRectMake(0, 0, width, height);
+  }
+  [CATransaction begin];
+  [CATransaction setDisableActions:YES];
+  CALayer *layer = [_scrubPreviewView layer];
+  [layer setContents:(__bridge id)cgImage];
+  // Unit coordinates of the sheet.
+  [layer setContentsRect:CGRectMake(CGRectGetMinX(region) / width,
+                                    CGRectGetMinY(region) / height,
+                                    CGRectGetWidth(region) / width,
+                                    CGRectGetHeight(region) / height)];
+  CGFloat previewHeight = CGRectGetWidth(region) > 0 ?
+      kGMFScrubPreviewWidth * CGRectGetHeight(region) / CGRectGetWidth(region) : 0;
+  [_scrubPreviewView setBounds:CGRectMake(0, 0, kGMFScrubPreviewWidth, previewHeight)];
+  [self positionScrubPreview];
+  [_scrubPreviewView setHidden:NO];
+  [CATransaction commit];
+}
+
+#pragma mark Private Methods
+
+// Centers the scrub preview above the scrubber thumb, kept within the bar's width.
+- (void)positionScrubPreview {
+  CGRect bounds = [_scrubber bounds];
+  CGRect thumbRect = [_scrubber thumbRectForBounds:bounds
+                                         trackRect:[_scrubber trackRectForBounds:bounds]
+                                             value:[_scrubber value]];
+  thumbRect = [self convertRect:thumbRect fromView:_scrubber];
+  CGSize size = [_scrubPreviewView bounds].size;
+  CGFloat halfWidth = size.width / 2;
+  CGFloat x = MIN(MAX(CGRectGetMidX(thumbRect), halfWidth),
+                  MAX(halfWidth, CGRectGetWidth([self bounds]) - halfWidth));
+  [_scrubPreviewView setCenter:CGPointMake(x, -kGMFScrubPreviewMargin - size.height / 2)];
+}
+
+// Commits only the fields that changed since the last commit. Runs at most once per frame.
+- (void)applyDirtyFields {
   if (_userScrubbing) {
     [self setMediaTime:[_scrubber value]];
+  }
+  GMFControlsDirtyFields dirtyFields = _dirtyFields;
+  if (!dirtyFields && !_userScrubbing) {
+    return;
+  }
+  _dirtyFields = 0;
+  _commitCount++;
+
+  GMFTimeRange window = [self scrubberWindow];
+  if (dirtyFields & kGMFControlsDirtyTotalTime) {
+    [_scrubber setMinimumValue:window.start];
+    [_scrubber setMaximumValue:window.end];
+    [self updateLabel:_totalSecondsLabel
+          withSeconds:window.end
+     displayedSeconds:&_displayedTotalSeconds];
+  }
+  if (dirtyFields & kGMFControlsDirtyMediaTime) {
+    [self updateLabel:_secondsPlayedLabel
+          withSeconds:_mediaTime
+     displayedSeconds:&_displayedMediaSeconds];
+  }
+  if (dirtyFields & (kGMFControlsDirtyBufferedRanges | kGMFControlsDirtyTotalTime)) {
+    [_bufferedRangesView setRanges:[self rangesToDraw] window:window];
+  }
+  if (_userScrubbing) {
+    // The slider already shows where the user's finger is.
     _userScrubbing = NO;
-  } else {
+  } else if (dirtyFields & (kGMFControlsDirtyMediaTime | kGMFControlsDirtyTotalTime)) {
     // If time is this low, we might be resetting the slider after a video completes, so don't want
     // it to slide back to zero animated.
     BOOL animated = _mediaTime <= 0.5;
@@ -250,25 +433,46 @@ static const CGFloat kGMFBarPaddingX = 8;
   }
 }
 
-- (void)applyControlTintColor:(UIColor *)color {
-  [_scrubber setMinimumTrackTintColor:color];
-  [_scrubber setThumbTintColor:color];
-  [_minimizeButton GMF_applyTintColor:color];
+// The seekable range of a live stream, otherwise [0, total time].
+- (GMFTimeRange)scrubberWindow {
+  if (_seekableRange.end > _seekableRange.start) {
+    return _seekableRange;
+  }
+  return GMFTimeRangeMake(0, _totalSeconds);
 }
 
-#pragma mark Private Methods
+// Falls back to a single segment from the start when only the downloaded time is known.
+- (GMFTimeRangeSet *)rangesToDraw {
+  if ([_bufferedRanges count] || _downloadedSeconds <= 0) {
+    return _bufferedRanges;
+  }
+  GMFTimeRangeSet *ranges = [[GMFTimeRangeSet alloc] init];
+  [ranges addRange:GMFTimeRangeMake(0, _downloadedSeconds)];
+  return ranges;
+}
 
-// Formats media time into a more readable format of HH:MM:SS.
-- (NSString *)stringWithDurationSeconds:(NSTimeInterval)durationSeconds {
-  NSInteger durationSecondsRounded = lround(durationSeconds);
-  NSInteger seconds = (durationSecondsRounded) % 60;
-  NSInteger minutes = (durationSecondsRounded / 60) % 60;
-  NSInteger hours = durationSecondsRounded / 3600;
-  if (hours) {
-    return [NSString stringWithFormat:@"%ld:%02ld:%02ld", (long) hours, (long) minutes, (long) seconds];
-  } else {
-    return [NSString stringWithFormat:@"%ld:%02ld", (long) minutes, (long) seconds];
+// Rebuilds |label|'s text only if the whole second it shows has changed.
+- (void)updateLabel:(UILabel *)label
+        withSeconds:(NSTimeInterval)seconds
+   displayedSeconds:(NSInteger *)displayedSeconds {
+  NSInteger secondsToDisplay = GMFDurationDisplaySeconds(seconds);
+  if (secondsToDisplay == *displayedSeconds) {
+    return;
+  }
+  *displayedSeconds = secondsToDisplay;
+  unichar buffer[kGMFDurationFormatterMaxLength];
+  NSUInteger length = GMFFormatDuration(secondsToDisplay, buffer, kGMFDurationFormatterMaxLength);
+  // Digits are all as wide, so the label only needs a new width when the text's length changes.
+  if ([[label text] length] != length) {
+    [self setNeedsLayout];
   }
+  [label setText:[NSString stringWithCharacters:buffer length:length]];
+  _labelRebuildCount++;
+}
+
+- (CFTimeInterval)secondsSinceStatisticsReset {
+  // Avoid dividing by zero straight after a reset.
+  return MAX(CACurrentMediaTime() - _statisticsStartTime, 1e-3);
 }
 
 - (void)setSeekbarThumbToDefaultImage {
@@ -299,11 +503,18 @@ static const CGFloat kGMFBarPaddingX = 8;
 
 - (void)didScrubbingProgress:(id)sender {
   _userScrubbing = YES;
+  if ([_delegate respondsToSelector:@selector(didScrubToTime:)]) {
+    [_delegate didScrubToTime:[_scrubber value]];
+  }
+  if (![_scrubPreviewView isHidden]) {
+    [self positionScrubPreview];
+  }
   [self updateScrubberAndTime];
 }
 
 - (void)didScrubbingEnd:(id)sender {
   _userScrubbing = YES;
+  [self setScrubPreviewImage:nil region:CGRectNull];
   [_delegate didSeekToTime:[_scrubber value]];
   [_delegate didEndScrubbing];
   [self updateScrubberAndTime];
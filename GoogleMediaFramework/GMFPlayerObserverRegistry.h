@@ -0,0 +1,66 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFPlayerState.h"
+
+typedef enum {
+  kGMFPlayerEventStateChange = 0,
+  kGMFPlayerEventMediaTime,
+  kGMFPlayerEventTotalTime,
+  kGMFPlayerEventBufferedTime,
+  kGMFPlayerEventTypeCount
+} GMFPlayerEventType;
+
+// Bitwise OR of GMFPlayerEventMaskForType() values.
+typedef NSUInteger GMFPlayerEventMask;
+
+#define GMFPlayerEventMaskForType(type) ((GMFPlayerEventMask)1 << (type))
+#define kGMFPlayerEventMaskAll (GMFPlayerEventMaskForType(kGMFPlayerEventTypeCount) - 1)
+
+typedef struct {
+  GMFPlayerEventType type;
+  // Media time, total time or buffered time depending on |type|. Unused for state changes.
+  NSTimeInterval time;
+  // Only set for kGMFPlayerEventStateChange.
+  GMFPlayerState fromState;
+  GMFPlayerState toState;
+} GMFPlayerEvent;
+
+// |event| is only valid for the duration of the call.
+typedef void (^GMFPlayerEventBlock)(const GMFPlayerEvent *event);
+
+// Per-player registry that fans playback events out to observers with the new value attached, so
+// observers don't need to call back into the player. Observers only receive the event types they
+// subscribed to. Registration and removal are O(1). The registry is not thread safe and takes no
+// locks; use it from the main thread like the rest of the player.
+@interface GMFPlayerObserverRegistry : NSObject
+
+// Returns an opaque token to pass to |removeObserver:|. The registry holds |block| strongly, so
+// capture observers weakly.
+- (id)addObserverForEvents:(GMFPlayerEventMask)events usingBlock:(GMFPlayerEventBlock)block;
+
+// Safe to call from within an observer block, including for the observer being called.
+- (void)removeObserver:(id)observer;
+
+- (NSUInteger)observerCountForEvent:(GMFPlayerEventType)type;
+
+- (void)publishEvent:(const GMFPlayerEvent *)event;
+
+// Convenience wrappers around |publishEvent:|.
+- (void)publishStateChangeFrom:(GMFPlayerState)fromState to:(GMFPlayerState)toState;
+- (void)publishTime:(NSTimeInterval)time forEvent:(GMFPlayerEventType)type;
+
+@end
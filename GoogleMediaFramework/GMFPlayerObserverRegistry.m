@@ -0,0 +1,160 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFPlayerObserverRegistry.h"
+#import "GMFTrace.h"
+
+@interface GMFPlayerObserverToken : NSObject {
+ @public
+  GMFPlayerEventMask _events;
+  GMFPlayerEventBlock _block;
+  // Position of this token in each per-type observer list it belongs to.
+  NSUInteger _indices[kGMFPlayerEventTypeCount];
+  BOOL _removed;
+}
+@end
+
+@implementation GMFPlayerObserverToken
+@end
+
+@implementation GMFPlayerObserverRegistry {
+  NSMutableArray *_observers[kGMFPlayerEventTypeCount];
+  // Non-zero while observers are being called. Removals are then deferred so the lists being
+  // iterated keep their order.
+  NSUInteger _publishDepth;
+  NSMutableArray *_pendingRemovals;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    for (NSUInteger type = 0; type < kGMFPlayerEventTypeCount; type++) {
+      _observers[type] = [[NSMutableArray alloc] init];
+    }
+    _pendingRemovals = [[NSMutableArray alloc] init];
+  }
+  return self;
+}
+
+- (id)addObserverForEvents:(GMFPlayerEventMask)events usingBlock:(GMFPlayerEventBlock)block {
+  NSAssert(block, @"Observer block must not be nil.");
+  GMFPlayerObserverToken *token = [[GMFPlayerObserverToken alloc] init];
+  token->_events = events & kGMFPlayerEventMaskAll;
+  token->_block = [block copy];
+  for (NSUInteger type = 0; type < kGMFPlayerEventTypeCount; type++) {
+    if (token->_events & GMFPlayerEventMaskForType(type)) {
+      token->_indices[type] = [_observers[type] count];
+      [_observers[type] addObject:token];
+    }
+  }
+  return token;
+}
+
+- (void)removeObserver:(id)observer {
+  GMFPlayerObserverToken *token = observer;
+  if (!token || token->_removed) {
+    return;
+  }
+  token->_removed = YES;
+  if (_publishDepth) {
+    [_pendingRemovals addObject:token];
+  } else {
+    [self detachToken:token];
+  }
+}
+
+- (NSUInteger)observerCountForEvent:(GMFPlayerEventType)type {
+  return [_observers[type] count] - [self pendingRemovalCountForEvent:type];
+}
+
+- (void)publishEvent:(const GMFPlayerEvent *)event {
+  NSMutableArray *observers = _observers[event->type];
+  // Observers added while publishing are not called for this event.
+  NSUInteger count = [observers count];
+  if (!count) {
+    return;
+  }
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_INFO, "observers.publish");
+  GMF_TRACE_COUNTER(GMF_TRACE_LEVEL_VERBOSE, "observers.count", count);
+  _publishDepth++;
+  for (NSUInteger i = 0; i < count; i++) {
+    GMFPlayerObserverToken *token = [observers objectAtIndex:i];
+    if (!token->_removed) {
+      token->_block(event);
+    }
+  }
+  _publishDepth--;
+  if (!_publishDepth && [_pendingRemovals count]) {
+    for (GMFPlayerObserverToken *token in _pendingRemovals) {
+      [self detachToken:token];
+    }
+    [_pendingRemovals removeAllObjects];
+  }
+}
+
+- (void)publishStateChangeFrom:(GMFPlayerState)fromState to:(GMFPlayerState)toState {
+  GMFPlayerEvent event = {
+    .type = kGMFPlayerEventStateChange,
+    .time = 0,
+    .fromState = fromState,
+    .toState = toState
+  };
+  [self publishEvent:&event];
+}
+
+- (void)publishTime:(NSTimeInterval)time forEvent:(GMFPlayerEventType)type {
+  GMFPlayerEvent event = {
+    .type = type,
+    .time = time,
+    .fromState = kGMFPlayerStateEmpty,
+    .toState = kGMFPlayerStateEmpty
+  };
+  [self publishEvent:&event];
+}
+
+#pragma mark Private Methods
+
+// Removes |token| from every list it is in by moving the last entry into its slot.
+- (void)detachToken:(GMFPlayerObserverToken *)token {
+  for (NSUInteger type = 0; type < kGMFPlayerEventTypeCount; type++) {
+    if (!(token->_events & GMFPlayerEventMaskForType(type))) {
+      continue;
+    }
+    NSMutableArray *observers = _observers[type];
+    NSUInteger index = token->_indices[type];
+    NSUInteger lastIndex = [observers count] - 1;
+    if (index != lastIndex) {
+      GMFPlayerObserverToken *last = [observers objectAtIndex:lastIndex];
+      last->_indices[type] = index;
+      [observers replaceObjectAtIndex:index withObject:last];
+    }
+    [observers removeLastObject];
+  }
+}
+
+- (NSUInteger)pendingRemovalCountForEvent:(GMFPlayerEventType)type {
+  NSUInteger count = 0;
+  for (GMFPlayerObserverToken *token in _pendingRemovals) {
+    if (token->_events & GMFPlayerEventMaskForType(type)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+@end
@@ -18,10 +18,13 @@
 
 #import "GMFPlayerOverlayView.h"
 #import "GMFResources.h"
+#import "GMFWebVTTParser.h"
 #import "UIButton+GMFTintableButton.h"
 #import "GMFTopBarView.h"
-#import "UIImage+GMFTintableImage.h"
 
+static const CGFloat kGMFCaptionFontSize = 16;
+// Space between the captions and the control bar, and the sides of the view.
+static const CGFloat kGMFCaptionMargin = 8;
 
 @implementation GMFPlayerOverlayView {
   UIActivityIndicatorView *_spinner;
@@ -34,6 +37,9 @@
   UIButton *_playPauseReplayButton;
   BOOL _isTopBarEnabled;
   CurrentPlayPauseReplayIcon _currentPlayPauseReplayIcon;
+  UILabel *_captionLabel;
+  // GMFCaptionCues on screen, by start time.
+  NSMutableArray *_captionCues;
 }
 
 - (id)initWithFrame:(CGRect)frame {
@@ -86,6 +92,18 @@
 
     [self addSubview:_topBarView];
 
+    // Captions stay on screen while the controls are hidden.
+    _captionCues = [[NSMutableArray alloc] init];
+    _captionLabel = [[UILabel alloc] init];
+    [_captionLabel setNumberOfLines:0];
+    [_captionLabel setTextAlignment:NSTextAlignmentCenter];
+    [_captionLabel setFont:[UIFont systemFontOfSize:kGMFCaptionFontSize]];
+    [_captionLabel setTextColor:[UIColor whiteColor]];
+    [_captionLabel setBackgroundColor:[UIColor colorWithWhite:0 alpha:0.6]];
+    [_captionLabel setUserInteractionEnabled:NO];
+    [_captionLabel setHidden:YES];
+    [self addSubview:_captionLabel];
+
     [self setupLayoutConstraints];
   }
   return self;
@@ -97,6 +115,7 @@
   [_playerControlsView setTranslatesAutoresizingMaskIntoConstraints:NO];
   [_playPauseReplayButton setTranslatesAutoresizingMaskIntoConstraints:NO];
   [_topBarView setTranslatesAutoresizingMaskIntoConstraints:NO];
+  [_captionLabel setTranslatesAutoresizingMaskIntoConstraints:NO];
 
   NSDictionary *viewsDictionary = NSDictionaryOfVariableBindings(_spinner,
                                                                  _playerControlsView,
@@ -173,8 +192,33 @@
                                                          options:NSLayoutFormatAlignAllTop
                                                          metrics:nil
                                                            views:viewsDictionary]];
-  
-  
+
+  // Captions sit centered just above the control bar.
+  constraints = [constraints arrayByAddingObject:
+      [NSLayoutConstraint constraintWithItem:_captionLabel
+                                   attribute:NSLayoutAttributeCenterX
+                                   relatedBy:NSLayoutRelationEqual
+                                      toItem:self
+                                   attribute:NSLayoutAttributeCenterX
+                                  multiplier:1.0f
+                                    constant:0]];
+  constraints = [constraints arrayByAddingObject:
+      [NSLayoutConstraint constraintWithItem:_captionLabel
+                                   attribute:NSLayoutAttributeBottom
+                                   relatedBy:NSLayoutRelationEqual
+                                      toItem:_playerControlsView
+                                   attribute:NSLayoutAttributeTop
+                                  multiplier:1.0f
+                                    constant:-kGMFCaptionMargin]];
+  constraints = [constraints arrayByAddingObject:
+      [NSLayoutConstraint constraintWithItem:_captionLabel
+                                   attribute:NSLayoutAttributeWidth
+                                   relatedBy:NSLayoutRelationLessThanOrEqual
+                                      toItem:self
+                                   attribute:NSLayoutAttributeWidth
+                                  multiplier:1.0f
+                                    constant:-2 * kGMFCaptionMargin]];
+
   [self addConstraints:constraints];
 }
 
@@ -266,6 +310,40 @@
   [_playerControlsView updateScrubberAndTime];
 }
 
+- (void)setBufferedRanges:(GMFTimeRangeSet *)bufferedRanges {
+  [_playerControlsView setBufferedRanges:bufferedRanges];
+  [_playerControlsView updateScrubberAndTime];
+}
+
+- (void)setSeekableRange:(GMFTimeRange)seekableRange {
+  [_playerControlsView setSeekableRange:seekableRange];
+  [_playerControlsView updateScrubberAndTime];
+}
+
+- (void)setScrubPreviewImage:(UIImage *)image region:(CGRect)region {
+  [_playerControlsView setScrubPreviewImage:image region:region];
+}
+
+- (void)updateCaptionsWithEnteredCues:(NSArray *)enteredCues exitedCues:(NSArray *)exitedCues {
+  for (GMFCaptionCue *cue in exitedCues) {
+    [_captionCues removeObjectIdenticalTo:cue];
+  }
+  for (GMFCaptionCue *cue in enteredCues) {
+    if ([_captionCues indexOfObjectIdenticalTo:cue] == NSNotFound) {
+      [_captionCues addObject:cue];
+    }
+  }
+  [_captionCues sortUsingComparator:^NSComparisonResult(GMFCaptionCue *first,
+                                                         GMFCaptionCue *second) {
+    if ([first startTime] == [second startTime]) {
+      return NSOrderedSame;
+    }
+    return [first startTime] < [second startTime] ? NSOrderedAscending : NSOrderedDescending;
+  }];
+  [_captionLabel setText:[[_captionCues valueForKey:@"text"] componentsJoinedByString:@"\n"]];
+  [_captionLabel setHidden:![_captionCues count]];
+}
+
 - (void)setSeekbarTrackColor:(UIColor *)color {
   [_playerControlsView setSeekbarTrackColor:color];
 }
@@ -288,9 +366,9 @@
 
 - (void)applyControlTintColor:(UIColor *)color {
   // Tint the images for play, pause, and replay.
-  _playImage = [_playImage GMF_createTintedImage:color];
-  _pauseImage = [_pauseImage GMF_createTintedImage:color];
-  _replayImage = [_replayImage GMF_createTintedImage:color];
+  _playImage = [GMFResources tintedImage:_playImage color:color];
+  _pauseImage = [GMFResources tintedImage:_pauseImage color:color];
+  _replayImage = [GMFResources tintedImage:_replayImage color:color];
   
   // Tint the play/pause/replay button and the controls view.
   [_playPauseReplayButton GMF_applyTintColor:color];
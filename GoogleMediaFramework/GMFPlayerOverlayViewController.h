@@ -42,6 +42,10 @@
 - (void) playerStateDidChangeToState:(GMFPlayerState) toState;
 - (void) reset;
 
+@optional
+- (void) setBufferedRanges:(GMFTimeRangeSet *) bufferedRanges;
+- (void) setSeekableRange:(GMFTimeRange) seekableRange;
+
 @end
 
 @interface GMFPlayerOverlayViewController : UIViewController <GMFPlayerOverlayViewControllerProtocol> {
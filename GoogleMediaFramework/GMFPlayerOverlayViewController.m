@@ -18,6 +18,7 @@
 
 #import "GMFPlayerOverlayView.h"
 #import "GMFPlayerOverlayViewController.h"
+#import "GMFTimerWheel.h"
 
 static const NSInteger kPaddingTop = 60;
 static const NSTimeInterval kAutoHideUserForcedAnimationDuration = 0.2;
@@ -26,6 +27,12 @@ static const NSTimeInterval kAutoHideAnimationDelay = 2.0;
 
 @interface GMFPlayerOverlayViewController ()
 
+// Pending auto-hide animation on the shared GMFTimerWheel.
+@property(nonatomic, strong) id autoHideHandle;
+
+// Drops the pending auto-hide animation, if any.
+- (void)cancelAutoHide;
+
 @end
 
 @implementation GMFPlayerOverlayViewController
@@ -129,6 +136,18 @@ static const NSTimeInterval kAutoHideAnimationDelay = 2.0;
   [_playerOverlayView setMediaTime:mediaTime];
 }
 
+- (void)setBufferedRanges:(GMFTimeRangeSet *)bufferedRanges {
+  if ([_playerOverlayView respondsToSelector:@selector(setBufferedRanges:)]) {
+    [_playerOverlayView setBufferedRanges:bufferedRanges];
+  }
+}
+
+- (void)setSeekableRange:(GMFTimeRange)seekableRange {
+  if ([_playerOverlayView respondsToSelector:@selector(setSeekableRange:)]) {
+    [_playerOverlayView setSeekableRange:seekableRange];
+  }
+}
+
 - (void)updatePlayerControlsVisibility {
   if (!_playerControlsHidden) {
     [self showPlayerControlsAnimated:YES];
@@ -207,7 +226,7 @@ static const NSTimeInterval kAutoHideAnimationDelay = 2.0;
   if (_autoHideEnabled != enabled) {
     _autoHideEnabled = enabled;
     if (!enabled) {
-      [NSObject cancelPreviousPerformRequestsWithTarget:self];
+      [self cancelAutoHide];
     } else {
       [self animatePlayerControlsToHidden:YES
                         animationDuration:kAutoHideFadeAnimationDuration
@@ -247,20 +266,20 @@ static const NSTimeInterval kAutoHideAnimationDelay = 2.0;
                      }];
   };
 
-  [NSObject cancelPreviousPerformRequestsWithTarget:self];
+  [self cancelAutoHide];
   if (delay) {
-    [self performSelector:@selector(performVoidBlock:)
-               withObject:animateAutoHideViewBlock
-               afterDelay:delay];
+    _autoHideHandle = [[GMFTimerWheel sharedWheel] scheduleBlock:^{
+        [self setAutoHideHandle:nil];
+        animateAutoHideViewBlock();
+    } afterDelay:delay];
   } else {
     animateAutoHideViewBlock();
   }
 }
 
-// Simply executes the block passed to it.
-// Used to execute a block after a delay using performSelector.
-- (void)performVoidBlock:(void (^)(void))block {
-  block();
+- (void)cancelAutoHide {
+  [[GMFTimerWheel sharedWheel] cancelScheduledBlock:_autoHideHandle];
+  _autoHideHandle = nil;
 }
 
 - (void)updatePlayerBarViewButtonWithState:(GMFPlayerState)playerState {
@@ -284,6 +303,8 @@ static const NSTimeInterval kAutoHideAnimationDelay = 2.0;
 - (void)reset {
   [self setTotalTime:0.0];
   [self setMediaTime:0.0];
+  [self setBufferedRanges:nil];
+  [self setSeekableRange:GMFTimeRangeMake(0, 0)];
   [self playerStateDidChangeToState:kGMFPlayerStateEmpty];
 }
 
@@ -291,7 +312,7 @@ static const NSTimeInterval kAutoHideAnimationDelay = 2.0;
   if (!_autoHideEnabled) {
     return;
   }
-  [NSObject cancelPreviousPerformRequestsWithTarget:self];
+  [self cancelAutoHide];
   [self animatePlayerControlsToHidden:YES
                     animationDuration:kAutoHideFadeAnimationDuration
                            afterDelay:kAutoHideAnimationDelay];
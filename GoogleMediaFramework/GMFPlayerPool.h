@@ -0,0 +1,84 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFMemoryGovernor.h"
+
+@class GMFVideoPlayer;
+
+// Default number of idle players kept for reuse.
+extern const NSUInteger kGMFPlayerPoolDefaultCapacity;
+
+// Default number of players decoding at once.
+extern const NSUInteger kGMFPlayerPoolDefaultMaxDecodingPlayers;
+
+// Priority of a player that was never given one.
+extern const double kGMFPlayerPoolDefaultPriority;
+
+// Recycles GMFVideoPlayers for feeds with many inline players, and caps how many of the players
+// in use decode at once.
+//
+// A reused player keeps its audio session listener, notification observers and engines, which a
+// new one would have to set up again. Players in use are ranked by priority, e.g. the visible
+// fraction of their view: the |maxDecodingPlayers| highest with a priority above 0 decode, and
+// the rest have their decoding suspended until they rank high enough again. Main thread only.
+//
+// Registers with the shared GMFMemoryGovernor: a warning releases half of the idle players and a
+// critical level all of them. Live players respond to pressure themselves.
+@interface GMFPlayerPool : NSObject<GMFMemoryPressureResponder>
+
+// Idle players kept; players recycled beyond it are released.
+@property(nonatomic, readonly) NSUInteger capacity;
+
+// Lowering it suspends the lowest priority players right away.
+@property(nonatomic, assign) NSUInteger maxDecodingPlayers;
+
+// Dequeues answered with an idle player, and with a new one.
+@property(nonatomic, readonly) NSUInteger hitCount;
+@property(nonatomic, readonly) NSUInteger missCount;
+
+// Players dequeued and not yet recycled, and the most there have been at once.
+@property(nonatomic, readonly) NSUInteger livePlayerCount;
+@property(nonatomic, readonly) NSUInteger peakLivePlayerCount;
+
+// Live players whose decoding isn't suspended, and the most there have been at once.
+@property(nonatomic, readonly) NSUInteger decodingPlayerCount;
+@property(nonatomic, readonly) NSUInteger peakDecodingPlayerCount;
+
++ (instancetype)sharedPool;
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+              maxDecodingPlayers:(NSUInteger)maxDecodingPlayers;
+
+// An idle player if there is one, otherwise a new one. Either way it is empty, has no delegate
+// and has the default priority.
+- (GMFVideoPlayer *)dequeuePlayer;
+
+// Resets |player| and keeps it for a later dequeue. Its decoder goes to the next player in line.
+- (void)recyclePlayer:(GMFVideoPlayer *)player;
+
+// Reranks the live players. 0 or less means |player| mustn't decode, e.g. when it is off screen.
+// When priorities tie, the player whose priority was set last wins.
+- (void)setPriority:(double)priority forPlayer:(GMFVideoPlayer *)player;
+
+- (double)priorityForPlayer:(GMFVideoPlayer *)player;
+
+// Hits over all dequeues; 0 before the first one.
+- (double)hitRate;
+
+// Zeroes the hit and miss counters, and sets the peaks to the current counts.
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,206 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFPlayerPool.h"
+#import "GMFTrace.h"
+#import "GMFVideoPlayer.h"
+
+const NSUInteger kGMFPlayerPoolDefaultCapacity = 4;
+const NSUInteger kGMFPlayerPoolDefaultMaxDecodingPlayers = 2;
+const double kGMFPlayerPoolDefaultPriority = 1;
+
+// A live player and its rank.
+@interface GMFPlayerPoolEntry : NSObject {
+ @public
+  GMFVideoPlayer *_player;
+  double _priority;
+  // When the priority was last set, to break ties in favour of the latest.
+  NSUInteger _sequence;
+}
+@end
+
+@implementation GMFPlayerPoolEntry
+@end
+
+@implementation GMFPlayerPool {
+  NSMutableArray *_idlePlayers;
+  // GMFPlayerPoolEntry for each live player.
+  NSMutableArray *_liveEntries;
+  NSUInteger _nextSequence;
+}
+
++ (instancetype)sharedPool {
+  static GMFPlayerPool *sharedPool;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+      sharedPool = [[GMFPlayerPool alloc] initWithCapacity:kGMFPlayerPoolDefaultCapacity
+                                        maxDecodingPlayers:kGMFPlayerPoolDefaultMaxDecodingPlayers];
+  });
+  return sharedPool;
+}
+
+- (instancetype)init {
+  return [self initWithCapacity:kGMFPlayerPoolDefaultCapacity
+             maxDecodingPlayers:kGMFPlayerPoolDefaultMaxDecodingPlayers];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+              maxDecodingPlayers:(NSUInteger)maxDecodingPlayers {
+  self = [super init];
+  if (self) {
+    _capacity = capacity;
+    _maxDecodingPlayers = maxDecodingPlayers;
+    _idlePlayers = [NSMutableArray arrayWithCapacity:capacity];
+    _liveEntries = [NSMutableArray array];
+    [[GMFMemoryGovernor sharedGovernor] addResponder:self];
+  }
+  return self;
+}
+
+- (void)setMaxDecodingPlayers:(NSUInteger)maxDecodingPlayers {
+  _maxDecodingPlayers = maxDecodingPlayers;
+  [self rebalance];
+}
+
+- (GMFVideoPlayer *)dequeuePlayer {
+  GMFVideoPlayer *player = [_idlePlayers lastObject];
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "pool.dequeue", player != nil);
+  if (player) {
+    [_idlePlayers removeLastObject];
+    _hitCount++;
+  } else {
+    player = [[GMFVideoPlayer alloc] init];
+    _missCount++;
+  }
+  GMFPlayerPoolEntry *entry = [[GMFPlayerPoolEntry alloc] init];
+  entry->_player = player;
+  entry->_priority = kGMFPlayerPoolDefaultPriority;
+  entry->_sequence = _nextSequence++;
+  [_liveEntries addObject:entry];
+  _livePlayerCount = [_liveEntries count];
+  _peakLivePlayerCount = MAX(_peakLivePlayerCount, _livePlayerCount);
+  [self rebalance];
+  return player;
+}
+
+- (void)recyclePlayer:(GMFVideoPlayer *)player {
+  GMFPlayerPoolEntry *entry = [self entryForPlayer:player];
+  if (!entry) {
+    return;
+  }
+  [_liveEntries removeObjectIdenticalTo:entry];
+  _livePlayerCount = [_liveEntries count];
+  [player setDelegate:nil];
+  [player reset];
+  [[player playlistQueue] removeAllItems];
+  [player setDecodingSuspended:NO];
+  if ([_idlePlayers count] < _capacity) {
+    [_idlePlayers addObject:player];
+  }
+  [self rebalance];
+}
+
+- (void)setPriority:(double)priority forPlayer:(GMFVideoPlayer *)player {
+  GMFPlayerPoolEntry *entry = [self entryForPlayer:player];
+  if (!entry) {
+    return;
+  }
+  entry->_priority = priority;
+  entry->_sequence = _nextSequence++;
+  [self rebalance];
+}
+
+- (double)priorityForPlayer:(GMFVideoPlayer *)player {
+  GMFPlayerPoolEntry *entry = [self entryForPlayer:player];
+  return entry ? entry->_priority : 0;
+}
+
+- (double)hitRate {
+  NSUInteger dequeues = _hitCount + _missCount;
+  return dequeues ? (double)_hitCount / dequeues : 0;
+}
+
+- (void)resetStatistics {
+  _hitCount = 0;
+  _missCount = 0;
+  _peakLivePlayerCount = _livePlayerCount;
+  _peakDecodingPlayerCount = _decodingPlayerCount;
+}
+
+#pragma mark GMFMemoryPressureResponder
+
+- (void)trimMemoryForPressureLevel:(GMFMemoryPressureLevel)level {
+  NSUInteger keptCount = [_idlePlayers count];
+  if (level == kGMFMemoryPressureLevelCritical) {
+    keptCount = 0;
+  } else if (level == kGMFMemoryPressureLevelWarning) {
+    keptCount /= 2;
+  }
+  // The most recently recycled players are at the end and are dequeued first; keep those.
+  [_idlePlayers removeObjectsInRange:NSMakeRange(0, [_idlePlayers count] - keptCount)];
+}
+
+- (uint64_t)estimatedMemoryCost {
+  uint64_t cost = 0;
+  for (GMFVideoPlayer *player in _idlePlayers) {
+    cost += [player estimatedMemoryCost];
+  }
+  return cost;
+}
+
+#pragma mark Private Methods
+
+- (GMFPlayerPoolEntry *)entryForPlayer:(GMFVideoPlayer *)player {
+  for (GMFPlayerPoolEntry *entry in _liveEntries) {
+    if (entry->_player == player) {
+      return entry;
+    }
+  }
+  return nil;
+}
+
+// Lets the highest ranked players decode and suspends the rest. Players are suspended before any
+// is resumed, so there are never more than |maxDecodingPlayers| decoders at once.
+- (void)rebalance {
+  NSArray *ranked = [_liveEntries sortedArrayUsingComparator:^NSComparisonResult(
+      GMFPlayerPoolEntry *first, GMFPlayerPoolEntry *second) {
+    if (first->_priority != second->_priority) {
+      return first->_priority > second->_priority ? NSOrderedAscending : NSOrderedDescending;
+    }
+    if (first->_sequence != second->_sequence) {
+      return first->_sequence > second->_sequence ? NSOrderedAscending : NSOrderedDescending;
+    }
+    return NSOrderedSame;
+  }];
+  NSMutableArray *decodingEntries = [NSMutableArray arrayWithCapacity:_maxDecodingPlayers];
+  for (GMFPlayerPoolEntry *entry in ranked) {
+    if (entry->_priority > 0 && [decodingEntries count] < _maxDecodingPlayers) {
+      [decodingEntries addObject:entry];
+    } else {
+      [entry->_player setDecodingSuspended:YES];
+    }
+  }
+  for (GMFPlayerPoolEntry *entry in decodingEntries) {
+    [entry->_player setDecodingSuspended:NO];
+  }
+  _decodingPlayerCount = [decodingEntries count];
+  _peakDecodingPlayerCount = MAX(_peakDecodingPlayerCount, _decodingPlayerCount);
+  GMF_TRACE_COUNTER(GMF_TRACE_LEVEL_VERBOSE, "pool.decoding", _decodingPlayerCount);
+}
+
+@end
@@ -12,13 +12,22 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#import "GMFCaptionTrack.h"
+#import "GMFPlayerObserverRegistry.h"
+#import "GMFPlayerPool.h"
 #import "GMFPlayerView.h"
+#import "GMFQoEMonitor.h"
+#import "GMFThumbnailCache.h"
 #import "GMFVideoPlayer.h"
+#import "GMFWatchProgressStore.h"
 #import "GMFPlayerOverlayViewController.h"
 
 @class GMFAdService;
 @class GMFPlayerControlsViewDelegate;
 
+// Posted on every media time change without the new value. Prefer observing
+// kGMFPlayerEventMediaTime through |observerRegistry|, which carries the value and avoids the
+// notification center.
 extern NSString * const kGMFPlayerCurrentMediaTimeDidChangeNotification;
 extern NSString * const kGMFPlayerCurrentTotalTimeDidChangeNotification;
 extern NSString * const kGMFPlayerDidMinimizeNotification;
@@ -30,7 +39,8 @@ extern NSString * const kGMFPlayerPlaybackDidFinishReasonUserInfoKey;
 extern NSString * const kGMFPlayerPlaybackWillFinishReasonUserInfoKey;
 
 
-@interface GMFPlayerViewController : UIViewController<GMFVideoPlayerDelegate,
+@interface GMFPlayerViewController : UIViewController<GMFCaptionTrackDelegate,
+                                                      GMFVideoPlayerDelegate,
                                                       GMFPlayerOverlayViewControllerDelegate,
                                                       GMFPlayerControlsViewDelegate,
                                                       UIGestureRecognizerDelegate> {
@@ -43,6 +53,30 @@ extern NSString * const kGMFPlayerPlaybackWillFinishReasonUserInfoKey;
 
 @property(nonatomic, strong) GMFAdService *adService;
 
+// Per-player observers for state, media time, total time and buffered time changes.
+@property(nonatomic, readonly) GMFPlayerObserverRegistry *observerRegistry;
+
+// Playback quality metrics of this player, fed from |observerRegistry| and the ad service.
+@property(nonatomic, readonly) GMFQoEMonitor *qoeMonitor;
+
+// Scrubber previews of the current stream, once a thumbnail track has loaded.
+@property(nonatomic, readonly) GMFThumbnailCache *thumbnailCache;
+
+// Captions of the current stream, once a caption track is loaded. The overlay shows them.
+@property(nonatomic, readonly) GMFCaptionTrack *captionTrack;
+
+// Pool the player came from, or nil if it has a player of its own.
+@property(nonatomic, readonly) GMFPlayerPool *playerPool;
+
+// Keeps the playback position of each stream, keyed by its URL, so loading a stream again
+// continues where it was left, and finishing it starts it over next time. Nil by default, e.g.
+// set it to [GMFWatchProgressStore sharedStore]. Live streams aren't tracked.
+@property(nonatomic, strong) GMFWatchProgressStore *watchProgressStore;
+
+// Rank of this player among the pool's players for decoding, e.g. the visible fraction of its
+// view in a feed; 0 when off screen. Ignored without a pool.
+@property(nonatomic, assign) double playbackPriority;
+
 @property(nonatomic, readonly, getter=isVideoFinished) BOOL videoFinished;
 
 // Default: No tint color.
@@ -54,12 +88,37 @@ extern NSString * const kGMFPlayerPlaybackWillFinishReasonUserInfoKey;
 // Default: No logo.
 @property(nonatomic, strong) UIImage *logoImage;
 
+// Decodes the player's control images on a background queue. Call early, e.g. at launch, so the
+// first player doesn't decode them on the main thread.
++ (void)preloadResources;
+
 - (id)init;
 
+// Takes its player from |playerPool| and returns it there when deallocated, for feeds that create
+// and drop many players.
+- (id)initWithPlayerPool:(GMFPlayerPool *)playerPool;
+
 - (void)loadStreamWithURL:(NSURL *)URL;
 
+// Loads whichever of several equivalent sources of the stream answers first, e.g. the same
+// stream on different CDNs, and fails over to the others if it breaks. Watch progress is kept
+// under the first URL, whichever source plays.
+- (void)loadStreamWithSourceURLs:(NSArray *)URLs;
+
 - (void)loadStreamWithURL:(NSURL *)URL imaTag:(NSString *)tag;
 
+// Requests the ads for |tag| ahead of time, so a later loadStreamWithURL:imaTag: with the same
+// tag, in any player, starts the pre-roll without waiting on the ad server.
++ (void)prefetchAdsWithIMATag:(NSString *)tag;
+
+// Loads a WebVTT thumbnail track for previews while scrubbing. Call after loading the stream,
+// which forgets the previous stream's track.
+- (void)loadThumbnailTrackWithURL:(NSURL *)URL;
+
+// Loads captions from a WebVTT file or an HLS subtitle media playlist, live or not. Call after
+// loading the stream, which forgets the previous stream's captions.
+- (void)loadCaptionTrackWithURL:(NSURL *)URL;
+
 - (void)play;
 
 - (void)pause;
@@ -80,6 +139,17 @@ extern NSString * const kGMFPlayerPlaybackWillFinishReasonUserInfoKey;
 
 - (void)registerAdService:(GMFAdService *)adService;
 
+// The player's adaptive bitrate controller, for choosing a policy and reading its throughput
+// estimate and current decision.
+- (GMFABRController *)abrController;
+
+// The player's live latency controller, for setting the target latency behind the live edge and
+// reading the latency of live streams.
+- (GMFLiveLatencyController *)liveLatencyController;
+
+// Jumps back to the live edge of a live stream, e.g. from a "live" button.
+- (void)seekToLive;
+
 - (void)setAboveRenderingView:(UIView *)view;
 
 - (void)setControlsVisibility:(BOOL)visible animated:(BOOL)animated;
@@ -20,6 +20,8 @@
 #import "GMFPlayerFinishReason.h"
 #import "GMFPlayerViewController.h"
 #import "GMFPlayerOverlayViewController.h"
+#import "GMFResources.h"
+#import "GMFThumbnailImageLoader.h"
 
 NSString * const kGMFPlayerCurrentMediaTimeDidChangeNotification =
     @"kGMFPlayerCurrentMediaTimeDidChangeNotification";
@@ -50,6 +52,33 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
 
 @property(nonatomic, strong) GMFVideoPlayer *player;
 
+@property(nonatomic, strong) GMFThumbnailCache *thumbnailCache;
+
+@property(nonatomic, strong) GMFCaptionTrack *captionTrack;
+
+// Bumped whenever the stream or its thumbnail track changes, so a track that loads too late is
+// dropped.
+@property(nonatomic, assign) NSUInteger thumbnailLoadGeneration;
+
+// Shows the thumbnail for |time| above the scrubber once its sheet is decoded.
+- (void)showScrubPreviewForTime:(NSTimeInterval)time;
+
+// Hides the scrub preview and drops any request for one.
+- (void)hideScrubPreview;
+
+// Forgets the thumbnail track and any load of one in progress.
+- (void)clearThumbnailTrack;
+
+// Stops loading the caption track, takes its captions off screen and forgets it.
+- (void)clearCaptionTrack;
+
+// Passes caption changes on to the overlay view, if it shows captions.
+- (void)updateOverlayCaptionsWithEnteredCues:(NSArray *)enteredCues
+                                  exitedCues:(NSArray *)exitedCues;
+
+// Position stored for |URL| in |watchProgressStore|, or 0.
+- (NSTimeInterval)resumePositionForURL:(NSURL *)URL;
+
 @end
 
 @implementation GMFPlayerViewController {
@@ -64,21 +93,54 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
   // action buttons when the overlay view is created.
   // This mutable array stores the dictionaries.
   NSMutableArray *_actionButtonDictionaries;
+
+  // Feeds |qoeMonitor| from |observerRegistry|.
+  id _qoeObserver;
+}
+
++ (void)preloadResources {
+  [GMFResources preloadControlImages];
 }
 
 // Perhaps you'd like to init a player with no content?
 - (id)init {
+  return [self initWithPlayerPool:nil];
+}
+
+- (id)initWithPlayerPool:(GMFPlayerPool *)playerPool {
   self = [super init];
   if (self) {
+    _playerPool = playerPool;
     _actionButtonDictionaries = [[NSMutableArray alloc] init];
+    _observerRegistry = [[GMFPlayerObserverRegistry alloc] init];
+    _qoeMonitor = [[GMFQoEMonitor alloc] init];
+    __weak GMFQoEMonitor *weakMonitor = _qoeMonitor;
+    _qoeObserver = [_observerRegistry
+        addObserverForEvents:GMFPlayerEventMaskForType(kGMFPlayerEventStateChange) |
+                             GMFPlayerEventMaskForType(kGMFPlayerEventMediaTime)
+                  usingBlock:^(const GMFPlayerEvent *event) {
+                      if (event->type == kGMFPlayerEventStateChange) {
+                        [weakMonitor playerStateDidChangeFrom:event->fromState to:event->toState];
+                      } else {
+                        [weakMonitor playheadDidMoveToTime:event->time];
+                      }
+                  }];
     if (!_player) {
-      _player = [[GMFVideoPlayer alloc] init];
+      _player = _playerPool ? [_playerPool dequeuePlayer] : [[GMFVideoPlayer alloc] init];
       [_player setDelegate:self];
     }
   }
   return self;
 }
 
+- (void)setPlaybackPriority:(double)priority {
+  [_playerPool setPriority:priority forPlayer:_player];
+}
+
+- (double)playbackPriority {
+  return _playerPool ? [_playerPool priorityForPlayer:_player] : kGMFPlayerPoolDefaultPriority;
+}
+
 - (void)setControlsVisibility:(BOOL)visible animated:(BOOL)animated {
   if (visible) {
     [_videoPlayerOverlayViewController showPlayerControlsAnimated:animated];
@@ -88,13 +150,27 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
 }
 
 - (void)loadStreamWithURL:(NSURL *)URL {
-  [_player loadStreamWithURL:URL];
+  [self clearThumbnailTrack];
+  [self clearCaptionTrack];
+  _currentMediaURL = URL;
+  [_player loadStreamWithURL:URL startTime:[self resumePositionForURL:URL]];
+}
+
+- (void)loadStreamWithSourceURLs:(NSArray *)URLs {
+  [self clearThumbnailTrack];
+  [self clearCaptionTrack];
+  _currentMediaURL = [URLs firstObject];
+  [_player loadStreamWithSourceURLs:URLs
+                          startTime:[self resumePositionForURL:_currentMediaURL]];
 }
 
 // Loads a video stream with the provided URL and requests ads via the IMA SDK with the provided
 // ad tag.
 - (void)loadStreamWithURL:(NSURL *)URL imaTag:(NSString *)tag {
-  [_player loadStreamWithURL:URL];
+  [self clearThumbnailTrack];
+  [self clearCaptionTrack];
+  _currentMediaURL = URL;
+  [_player loadStreamWithURL:URL startTime:[self resumePositionForURL:URL]];
   if (_adService && [_adService class] == [GMFIMASDKAdService class]) {
     [(GMFIMASDKAdService *)_adService reset];
   } else {
@@ -103,6 +179,45 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
   [(GMFIMASDKAdService*)_adService requestAdsWithRequest:tag];
 }
 
++ (void)prefetchAdsWithIMATag:(NSString *)tag {
+  [GMFIMASDKAdService prefetchAdsWithRequest:tag];
+}
+
+- (void)loadThumbnailTrackWithURL:(NSURL *)URL {
+  [self clearThumbnailTrack];
+  NSUInteger generation = _thumbnailLoadGeneration;
+  __weak GMFPlayerViewController *weakSelf = self;
+  [NSURLConnection sendAsynchronousRequest:[NSURLRequest requestWithURL:URL]
+                                     queue:[NSOperationQueue mainQueue]
+                         completionHandler:^(NSURLResponse *response,
+                                             NSData *data,
+                                             NSError *error) {
+      GMFPlayerViewController *strongSelf = weakSelf;
+      if (!strongSelf || [strongSelf thumbnailLoadGeneration] != generation) {
+        return;
+      }
+      GMFThumbnailIndex *index =
+          data ? [GMFThumbnailIndex indexWithData:data baseURL:[response URL] ?: URL] : nil;
+      if (!index) {
+        // Scrubbing just goes without previews.
+        return;
+      }
+      GMFThumbnailImageLoader *loader = [[GMFThumbnailImageLoader alloc] init];
+      [strongSelf setThumbnailCache:
+          [[GMFThumbnailCache alloc] initWithIndex:index
+                                            loader:loader
+                                         costLimit:kGMFThumbnailCacheDefaultCostLimit]];
+  }];
+}
+
+- (void)loadCaptionTrackWithURL:(NSURL *)URL {
+  [self clearCaptionTrack];
+  _captionTrack = [[GMFCaptionTrack alloc] init];
+  [_captionTrack setDelegate:self];
+  [_captionTrack updateWithMediaTime:[_player currentMediaTime]];
+  [_captionTrack loadWithURL:URL];
+}
+
 - (void)play {
   [_player play];
 }
@@ -150,6 +265,11 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
 
 // Allows outside classes take over or act as proxies for the video player controls.
 - (void)setVideoPlayerOverlayDelegate:(id<GMFPlayerOverlayViewControllerDelegate>)delegate {
+  // Content buffer ranges, DVR window and captions mean nothing to whoever takes over the
+  // controls.
+  [self updateOverlayBufferedRanges:nil];
+  [self updateOverlaySeekableRange:GMFTimeRangeMake(0, 0)];
+  [self updateOverlayCaptionsWithEnteredCues:nil exitedCues:[_captionTrack activeCues]];
   [_videoPlayerOverlayViewController setDelegate:delegate];
 }
 
@@ -157,7 +277,23 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
   // Duration was probably changed by whatever delegate took over, so reset it here.
   [_videoPlayerOverlayViewController setTotalTime:[_player totalMediaTime]];
   [_videoPlayerOverlayViewController setMediaTime:[_player currentMediaTime]];
+  [self updateOverlayBufferedRanges:[_player bufferedTimeRanges]];
+  [self updateOverlaySeekableRange:[_player isLive] ? [_player seekableTimeRange]
+                                                    : GMFTimeRangeMake(0, 0)];
   [_videoPlayerOverlayViewController setDelegate:self];
+  [self updateOverlayCaptionsWithEnteredCues:[_captionTrack activeCues] exitedCues:nil];
+}
+
+- (void)updateOverlayBufferedRanges:(GMFTimeRangeSet *)bufferedRanges {
+  if ([_videoPlayerOverlayViewController respondsToSelector:@selector(setBufferedRanges:)]) {
+    [_videoPlayerOverlayViewController setBufferedRanges:bufferedRanges];
+  }
+}
+
+- (void)updateOverlaySeekableRange:(GMFTimeRange)seekableRange {
+  if ([_videoPlayerOverlayViewController respondsToSelector:@selector(setSeekableRange:)]) {
+    [_videoPlayerOverlayViewController setSeekableRange:seekableRange];
+  }
 }
 
 - (void)setVideoPlayerOverlayViewController:(UIViewController <GMFPlayerOverlayViewControllerProtocol> *)videoPlayerOverlayViewController {
@@ -220,6 +356,18 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
   [_player replay];
 }
 
+- (GMFABRController *)abrController {
+  return [_player abrController];
+}
+
+- (GMFLiveLatencyController *)liveLatencyController {
+  return [_player liveLatencyController];
+}
+
+- (void)seekToLive {
+  [_player seekToLive];
+}
+
 - (GMFVideoPlayer *)videoPlayer {
   return _player;
 }
@@ -289,6 +437,7 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
 }
 
 - (void)playerStateDidChangeToFinished {
+  [_watchProgressStore removePositionForContentID:[_currentMediaURL absoluteString]];
   NSDictionary *userInfo = @{
                              kGMFPlayerPlaybackDidFinishReasonUserInfoKey:
                                [NSNumber numberWithInt:GMFPlayerFinishReasonPlaybackEnded]
@@ -336,6 +485,7 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
       // TODO(tensafefrogs): Do something with error state.
       break;
   }
+  [_observerRegistry publishStateChangeFrom:fromState to:toState];
   [[NSNotificationCenter defaultCenter]
       postNotificationName:kGMFPlayerPlaybackStateDidChangeNotification
                     object:self];
@@ -344,11 +494,21 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
 - (void)videoPlayer:(GMFVideoPlayer *)videoPlayer
     currentMediaTimeDidChangeToTime:(NSTimeInterval)time {
   [_videoPlayerOverlayViewController setMediaTime:time];
+  if ([_player isLive] && [_videoPlayerOverlayViewController.delegate isEqual:self]) {
+    // The DVR window slides as the stream grows.
+    [self updateOverlaySeekableRange:[_player seekableTimeRange]];
+  }
+  [_captionTrack updateWithMediaTime:time];
+  [_observerRegistry publishTime:time forEvent:kGMFPlayerEventMediaTime];
+  if (_watchProgressStore && _currentMediaURL && ![_player isLive]) {
+    [_watchProgressStore setPosition:time forContentID:[_currentMediaURL absoluteString]];
+  }
   [self notifyCurrentMediaTimeDidChange];
 }
 
 - (void)videoPlayer:(GMFVideoPlayer *)videoPlayer
     currentTotalTimeDidChangeToTime:(NSTimeInterval)time {
+  [_observerRegistry publishTime:time forEvent:kGMFPlayerEventTotalTime];
   if([_videoPlayerOverlayViewController.delegate isEqual:self]) {
     [_videoPlayerOverlayViewController setTotalTime:time];
     [self notifyCurrenTotalTimeDidChange];
@@ -357,6 +517,24 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
 
 - (void)videoPlayer:(GMFVideoPlayer *)videoPlayer
   bufferedMediaTimeDidChangeToTime:(NSTimeInterval)time {
+  [_observerRegistry publishTime:time forEvent:kGMFPlayerEventBufferedTime];
+}
+
+- (void)videoPlayer:(GMFVideoPlayer *)videoPlayer
+    bufferedTimeRangesDidChange:(GMFTimeRangeSet *)ranges {
+  if ([_videoPlayerOverlayViewController.delegate isEqual:self]) {
+    [self updateOverlayBufferedRanges:ranges];
+  }
+}
+
+#pragma mark GMFCaptionTrackDelegate
+
+- (void)captionTrack:(GMFCaptionTrack *)captionTrack
+        didEnterCues:(NSArray *)enteredCues
+            exitCues:(NSArray *)exitedCues {
+  if ([_videoPlayerOverlayViewController.delegate isEqual:self]) {
+    [self updateOverlayCaptionsWithEnteredCues:enteredCues exitedCues:exitedCues];
+  }
 }
 
 #pragma mark YTPlayerOverlayViewDelegate
@@ -376,6 +554,11 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
   }
 }
 
+- (void)didScrubToTime:(NSTimeInterval)time {
+  [_player scrubToTime:time];
+  [self showScrubPreviewForTime:time];
+}
+
 - (void)didStartScrubbing {
   // We don't want to override this flag if we're in the middle of another
   // seek.
@@ -390,6 +573,7 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
 }
 
 - (void)didEndScrubbing {
+  [self hideScrubPreview];
   _isUserScrubbing = NO;
   [_videoPlayerOverlayViewController setUserScrubbing:_isUserScrubbing];
 }
@@ -432,8 +616,8 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
 
 // Notifies a listener that the curent media time has changed. The listener is expected to check
 // GMFVideoPlayerViewController.currentMediaTime to get the new value. Only dispatches a
-// notification when the value changes, not on a set time interval.
-// TODO(tensafefrogs): Include the new value in the userInfo dictionary with this notification.
+// notification when the value changes, not on a set time interval. Kept for existing listeners;
+// |observerRegistry| delivers the new value directly.
 - (void)notifyCurrentMediaTimeDidChange {
   [[NSNotificationCenter defaultCenter]
       postNotificationName:kGMFPlayerCurrentMediaTimeDidChangeNotification
@@ -448,10 +632,63 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
                   userInfo:nil];
 }
 
+#pragma mark Scrub previews
+
+- (void)showScrubPreviewForTime:(NSTimeInterval)time {
+  UIView<GMFPlayerControlsProtocol> *overlayView = [self playerOverlayView];
+  if (!_thumbnailCache ||
+      ![overlayView respondsToSelector:@selector(setScrubPreviewImage:region:)]) {
+    return;
+  }
+  __weak GMFPlayerViewController *weakSelf = self;
+  [_thumbnailCache requestThumbnailForTime:time
+                                completion:^(id sprite, GMFThumbnail thumbnail) {
+      GMFPlayerViewController *strongSelf = weakSelf;
+      if (strongSelf && strongSelf->_isUserScrubbing) {
+        [[strongSelf playerOverlayView] setScrubPreviewImage:sprite region:thumbnail.region];
+      }
+  }];
+}
+
+- (void)hideScrubPreview {
+  [_thumbnailCache cancelRequest];
+  UIView<GMFPlayerControlsProtocol> *overlayView = [self playerOverlayView];
+  if ([overlayView respondsToSelector:@selector(setScrubPreviewImage:region:)]) {
+    [overlayView setScrubPreviewImage:nil region:CGRectNull];
+  }
+}
+
+- (void)clearThumbnailTrack {
+  _thumbnailLoadGeneration++;
+  [self hideScrubPreview];
+  _thumbnailCache = nil;
+}
+
+- (void)clearCaptionTrack {
+  [_captionTrack stopLoading];
+  [_captionTrack setDelegate:nil];
+  [self updateOverlayCaptionsWithEnteredCues:nil exitedCues:[_captionTrack activeCues]];
+  _captionTrack = nil;
+}
+
+- (void)updateOverlayCaptionsWithEnteredCues:(NSArray *)enteredCues
+                                  exitedCues:(NSArray *)exitedCues {
+  UIView<GMFPlayerControlsProtocol> *overlayView = [self playerOverlayView];
+  if ([overlayView respondsToSelector:@selector(updateCaptionsWithEnteredCues:exitedCues:)]) {
+    [overlayView updateCaptionsWithEnteredCues:enteredCues exitedCues:exitedCues];
+  }
+}
+
+- (NSTimeInterval)resumePositionForURL:(NSURL *)URL {
+  return [_watchProgressStore positionForContentID:[URL absoluteString]];
+}
+
 #pragma mark -
 
 // Reset these together, else playerView might retain a reference to the player's renderingView.
 - (void)resetPlayerAndPlayerView {
+  [self clearThumbnailTrack];
+  [self clearCaptionTrack];
   [_videoPlayerOverlayViewController reset];
   [_playerView reset];
   [_player reset];
@@ -462,6 +699,7 @@ NSString *const kActionButtonSelectorKey = @"kActionButtonSelectorKey";
   // Call this first to give things a chance to remove observers.
   [self notifyUserDidMinimize];
   [self resetPlayerAndPlayerView];
+  [_playerPool recyclePlayer:_player];
 
   [_tapRecognizer setDelegate:nil];
   [_tapRecognizer removeTarget:self action:@selector(didTapGestureCapturingView:)];
@@ -0,0 +1,66 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFClock.h"
+
+@class GMFPlayheadEngine;
+
+@protocol GMFPlayheadEngineDataSource<NSObject>
+
+// Returns the current playback position. Called at most once per engine wakeup.
+- (NSTimeInterval)mediaTimeForPlayheadEngine:(GMFPlayheadEngine *)engine;
+
+@end
+
+typedef void (^GMFPlayheadTickBlock)(NSTimeInterval mediaTime);
+
+// Delivers playhead updates to any number of consumers, each at its own rate (e.g. 30 Hz for a
+// scrubber, 1 Hz for analytics). A single one-shot timer is armed for the earliest due consumer
+// and disarmed entirely while the engine is stopped, so paused, buffering or offscreen players
+// cause no wakeups. Consumers are only called when the media time differs from the value they
+// last received.
+@interface GMFPlayheadEngine : NSObject
+
+@property(nonatomic, weak) id<GMFPlayheadEngineDataSource> dataSource;
+
+@property(nonatomic, readonly, getter=isRunning) BOOL running;
+
+// Number of timer wakeups since the engine was created.
+@property(nonatomic, readonly) NSUInteger wakeupCount;
+
+// Uses the shared GMFTimerWheel.
+- (instancetype)init;
+
+- (instancetype)initWithClock:(id<GMFClock>)clock;
+
+// Registers |block| to receive the media time every |interval| seconds while the engine is
+// running. Returns a token to pass to |removeConsumer:|.
+- (id)addConsumerWithInterval:(NSTimeInterval)interval block:(GMFPlayheadTickBlock)block;
+
+- (void)removeConsumer:(id)consumer;
+
+// Starts periodic delivery. Call when playback starts progressing.
+- (void)start;
+
+// Stops periodic delivery and disarms the timer. Call when playback stops progressing.
+- (void)stop;
+
+// Delivers the current media time to all consumers right away, whether or not the engine is
+// running, and restarts their intervals. Use for seeks, stalls and other state changes that must
+// not wait for the next tick.
+- (void)notifyDiscontinuity;
+
+@end
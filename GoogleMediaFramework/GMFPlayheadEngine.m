@@ -0,0 +1,166 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFPlayheadEngine.h"
+#import "GMFTimerWheel.h"
+#import "GMFTrace.h"
+
+// Consumers due within this window of a wakeup are served by it instead of arming their own
+// timer, so e.g. a 1 Hz consumer rides along with a 30 Hz one.
+static const NSTimeInterval kGMFPlayheadCoalescingLeeway = 0.01;
+
+@interface GMFPlayheadConsumer : NSObject
+
+@property(nonatomic, assign) NSTimeInterval interval;
+@property(nonatomic, assign) NSTimeInterval nextFireTime;
+@property(nonatomic, assign) NSTimeInterval lastDeliveredTime;
+@property(nonatomic, copy) GMFPlayheadTickBlock block;
+// Set when removed so a consumer dropped mid-dispatch is not called again.
+@property(nonatomic, assign, getter=isRemoved) BOOL removed;
+
+@end
+
+@implementation GMFPlayheadConsumer
+@end
+
+@implementation GMFPlayheadEngine {
+  id<GMFClock> _clock;
+  NSMutableArray *_consumers;
+  id _timerHandle;
+}
+
+- (instancetype)init {
+  return [self initWithClock:[GMFTimerWheel sharedWheel]];
+}
+
+- (instancetype)initWithClock:(id<GMFClock>)clock {
+  self = [super init];
+  if (self) {
+    _clock = clock;
+    _consumers = [[NSMutableArray alloc] init];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [_clock cancelScheduledBlock:_timerHandle];
+}
+
+- (id)addConsumerWithInterval:(NSTimeInterval)interval block:(GMFPlayheadTickBlock)block {
+  NSAssert(interval > 0, @"Playhead consumer interval must be positive.");
+  GMFPlayheadConsumer *consumer = [[GMFPlayheadConsumer alloc] init];
+  [consumer setInterval:interval];
+  [consumer setNextFireTime:[_clock now] + interval];
+  [consumer setLastDeliveredTime:NAN];
+  [consumer setBlock:block];
+  [_consumers addObject:consumer];
+  [self rearmTimer];
+  return consumer;
+}
+
+- (void)removeConsumer:(id)consumer {
+  if (!consumer) {
+    return;
+  }
+  [(GMFPlayheadConsumer *)consumer setRemoved:YES];
+  [_consumers removeObjectIdenticalTo:consumer];
+  [self rearmTimer];
+}
+
+- (void)start {
+  if (_running) {
+    return;
+  }
+  _running = YES;
+  NSTimeInterval now = [_clock now];
+  for (GMFPlayheadConsumer *consumer in _consumers) {
+    [consumer setNextFireTime:now + [consumer interval]];
+  }
+  [self rearmTimer];
+}
+
+- (void)stop {
+  _running = NO;
+  [self rearmTimer];
+}
+
+- (void)notifyDiscontinuity {
+  NSTimeInterval now = [_clock now];
+  NSTimeInterval mediaTime = [_dataSource mediaTimeForPlayheadEngine:self];
+  for (GMFPlayheadConsumer *consumer in [_consumers copy]) {
+    [consumer setNextFireTime:now + [consumer interval]];
+    [self deliverMediaTime:mediaTime toConsumer:consumer];
+  }
+  [self rearmTimer];
+}
+
+#pragma mark Private Methods
+
+- (void)rearmTimer {
+  [_clock cancelScheduledBlock:_timerHandle];
+  _timerHandle = nil;
+  if (!_running || ![_consumers count]) {
+    return;
+  }
+
+  NSTimeInterval earliestFireTime = INFINITY;
+  for (GMFPlayheadConsumer *consumer in _consumers) {
+    earliestFireTime = MIN(earliestFireTime, [consumer nextFireTime]);
+  }
+  __weak GMFPlayheadEngine *weakSelf = self;
+  _timerHandle = [_clock scheduleBlock:^{
+      [weakSelf timerDidFire];
+  } afterDelay:earliestFireTime - [_clock now]];
+}
+
+- (void)timerDidFire {
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_INFO, "playhead.tick");
+  _timerHandle = nil;
+  _wakeupCount++;
+
+  NSTimeInterval now = [_clock now];
+  NSTimeInterval mediaTime = [_dataSource mediaTimeForPlayheadEngine:self];
+  for (GMFPlayheadConsumer *consumer in [_consumers copy]) {
+    if ([consumer nextFireTime] > now + kGMFPlayheadCoalescingLeeway) {
+      continue;
+    }
+    // Advance on the consumer's own grid so its rate doesn't drift with timer latency.
+    NSTimeInterval nextFireTime = [consumer nextFireTime];
+    while (nextFireTime <= now + kGMFPlayheadCoalescingLeeway) {
+      nextFireTime += [consumer interval];
+    }
+    [consumer setNextFireTime:nextFireTime];
+    [self deliverMediaTime:mediaTime toConsumer:consumer];
+    if (!_running) {
+      // A consumer stopped the engine.
+      return;
+    }
+  }
+  [self rearmTimer];
+}
+
+- (void)deliverMediaTime:(NSTimeInterval)mediaTime toConsumer:(GMFPlayheadConsumer *)consumer {
+  if ([consumer isRemoved] || [consumer lastDeliveredTime] == mediaTime) {
+    return;
+  }
+  [consumer setLastDeliveredTime:mediaTime];
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_VERBOSE, "playhead.deliverMs", mediaTime * 1000);
+  [consumer block](mediaTime);
+}
+
+@end
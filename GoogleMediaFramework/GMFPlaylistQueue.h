@@ -0,0 +1,86 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+@class GMFPlaylistQueue;
+
+typedef enum {
+  kGMFPlaylistItemStateIdle = 0,
+  kGMFPlaylistItemStatePreparing,
+  kGMFPlaylistItemStatePrepared,
+  kGMFPlaylistItemStateFailed
+} GMFPlaylistItemState;
+
+@interface GMFPlaylistItem : NSObject
+
+@property(nonatomic, readonly) NSURL *URL;
+
+@property(nonatomic, readonly) GMFPlaylistItemState state;
+
+// Whatever the delegate produced when preparing this item, e.g. an AVPlayerItem. Only set while
+// the item is prepared.
+@property(nonatomic, readonly) id preparedObject;
+
+@end
+
+@protocol GMFPlaylistQueueDelegate<NSObject>
+
+// Start preparing |item| and report the result with |item:didPrepareWithObject:| or
+// |itemDidFailToPrepare:|, synchronously or later.
+- (void)playlistQueue:(GMFPlaylistQueue *)queue prepareItem:(GMFPlaylistItem *)item;
+
+// Stop preparing |item|, or release what was prepared for it. The item has already been moved
+// back to the idle state when this is called.
+- (void)playlistQueue:(GMFPlaylistQueue *)queue cancelItem:(GMFPlaylistItem *)item;
+
+@optional
+// Called after the items were added, removed or reordered, or the queue advanced.
+- (void)playlistQueueDidChangeItems:(GMFPlaylistQueue *)queue;
+
+@end
+
+// Ordered list of items to play. The first item is the current one; |advance| drops it. The
+// current item and the next |lookAheadCount| items are kept prepared by the delegate, and items
+// that fall out of that window (because they were removed or reordered) are cancelled so their
+// buffers are released.
+@interface GMFPlaylistQueue : NSObject
+
+@property(nonatomic, weak) id<GMFPlaylistQueueDelegate> delegate;
+
+// Number of items after the current one to prepare ahead of time. Defaults to 1.
+@property(nonatomic, assign) NSUInteger lookAheadCount;
+
+- (NSArray *)items;
+- (NSUInteger)count;
+
+// nil when the queue is empty.
+- (GMFPlaylistItem *)currentItem;
+- (GMFPlaylistItem *)nextItem;
+
+- (GMFPlaylistItem *)enqueueURL:(NSURL *)URL;
+- (GMFPlaylistItem *)insertURL:(NSURL *)URL atIndex:(NSUInteger)index;
+- (void)removeItem:(GMFPlaylistItem *)item;
+- (void)removeAllItems;
+- (void)moveItemAtIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex;
+
+// Drops the current item and returns the new current item, or nil if the queue is now empty.
+- (GMFPlaylistItem *)advance;
+
+// Called by the delegate when preparation of |item| completes. Ignored if |item| was cancelled
+// in the meantime.
+- (void)item:(GMFPlaylistItem *)item didPrepareWithObject:(id)preparedObject;
+- (void)itemDidFailToPrepare:(GMFPlaylistItem *)item;
+
+@end
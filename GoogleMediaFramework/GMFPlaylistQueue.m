@@ -0,0 +1,194 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFPlaylistQueue.h"
+
+@interface GMFPlaylistItem ()
+
+@property(nonatomic, readwrite) GMFPlaylistItemState state;
+@property(nonatomic, strong, readwrite) id preparedObject;
+
+- (instancetype)initWithURL:(NSURL *)URL;
+
+@end
+
+@implementation GMFPlaylistItem
+
+- (instancetype)initWithURL:(NSURL *)URL {
+  self = [super init];
+  if (self) {
+    _URL = URL;
+    _state = kGMFPlaylistItemStateIdle;
+  }
+  return self;
+}
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p %@ state=%d>",
+      [self class], self, _URL, _state];
+}
+
+@end
+
+@implementation GMFPlaylistQueue {
+  NSMutableArray *_items;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _items = [[NSMutableArray alloc] init];
+    _lookAheadCount = 1;
+  }
+  return self;
+}
+
+- (void)setDelegate:(id<GMFPlaylistQueueDelegate>)delegate {
+  _delegate = delegate;
+  [self updatePreparationWindow];
+}
+
+- (void)setLookAheadCount:(NSUInteger)lookAheadCount {
+  _lookAheadCount = lookAheadCount;
+  [self updatePreparationWindow];
+}
+
+- (NSArray *)items {
+  return [_items copy];
+}
+
+- (NSUInteger)count {
+  return [_items count];
+}
+
+- (GMFPlaylistItem *)currentItem {
+  return [_items count] ? [_items objectAtIndex:0] : nil;
+}
+
+- (GMFPlaylistItem *)nextItem {
+  return [_items count] > 1 ? [_items objectAtIndex:1] : nil;
+}
+
+- (GMFPlaylistItem *)enqueueURL:(NSURL *)URL {
+  return [self insertURL:URL atIndex:[_items count]];
+}
+
+- (GMFPlaylistItem *)insertURL:(NSURL *)URL atIndex:(NSUInteger)index {
+  NSAssert(URL, @"Cannot enqueue a nil URL.");
+  GMFPlaylistItem *item = [[GMFPlaylistItem alloc] initWithURL:URL];
+  [_items insertObject:item atIndex:index];
+  [self itemsDidChange];
+  return item;
+}
+
+- (void)removeItem:(GMFPlaylistItem *)item {
+  NSUInteger index = [_items indexOfObjectIdenticalTo:item];
+  if (index == NSNotFound) {
+    return;
+  }
+  [_items removeObjectAtIndex:index];
+  [self cancelItem:item];
+  [self itemsDidChange];
+}
+
+- (void)removeAllItems {
+  NSArray *items = _items;
+  _items = [[NSMutableArray alloc] init];
+  for (GMFPlaylistItem *item in items) {
+    [self cancelItem:item];
+  }
+  [self itemsDidChange];
+}
+
+- (void)moveItemAtIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex {
+  if (fromIndex == toIndex) {
+    return;
+  }
+  GMFPlaylistItem *item = [_items objectAtIndex:fromIndex];
+  [_items removeObjectAtIndex:fromIndex];
+  [_items insertObject:item atIndex:toIndex];
+  [self itemsDidChange];
+}
+
+- (GMFPlaylistItem *)advance {
+  if (![_items count]) {
+    return nil;
+  }
+  GMFPlaylistItem *finishedItem = [_items objectAtIndex:0];
+  [_items removeObjectAtIndex:0];
+  [self cancelItem:finishedItem];
+  [self itemsDidChange];
+  return [self currentItem];
+}
+
+- (void)item:(GMFPlaylistItem *)item didPrepareWithObject:(id)preparedObject {
+  if ([item state] != kGMFPlaylistItemStatePreparing) {
+    return;
+  }
+  [item setPreparedObject:preparedObject];
+  [item setState:kGMFPlaylistItemStatePrepared];
+}
+
+- (void)itemDidFailToPrepare:(GMFPlaylistItem *)item {
+  if ([item state] != kGMFPlaylistItemStatePreparing) {
+    return;
+  }
+  [item setState:kGMFPlaylistItemStateFailed];
+}
+
+#pragma mark Private Methods
+
+- (void)itemsDidChange {
+  [self updatePreparationWindow];
+  if ([_delegate respondsToSelector:@selector(playlistQueueDidChangeItems:)]) {
+    [_delegate playlistQueueDidChangeItems:self];
+  }
+}
+
+// Prepares idle items inside the look-ahead window, in play order, and cancels the ones outside.
+- (void)updatePreparationWindow {
+  if (!_delegate) {
+    return;
+  }
+  // The delegate may prepare synchronously and mutate the queue, so walk a snapshot.
+  NSArray *items = [_items copy];
+  NSUInteger index = 0;
+  for (GMFPlaylistItem *item in items) {
+    if (index <= _lookAheadCount) {
+      if ([item state] == kGMFPlaylistItemStateIdle) {
+        [item setState:kGMFPlaylistItemStatePreparing];
+        [_delegate playlistQueue:self prepareItem:item];
+      }
+    } else {
+      [self cancelItem:item];
+    }
+    index++;
+  }
+}
+
+- (void)cancelItem:(GMFPlaylistItem *)item {
+  GMFPlaylistItemState state = [item state];
+  if (state != kGMFPlaylistItemStatePreparing && state != kGMFPlaylistItemStatePrepared) {
+    return;
+  }
+  [item setState:kGMFPlaylistItemStateIdle];
+  [item setPreparedObject:nil];
+  [_delegate playlistQueue:self cancelItem:item];
+}
+
+@end
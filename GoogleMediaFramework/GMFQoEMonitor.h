@@ -0,0 +1,119 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFClock.h"
+#import "GMFLatencyHistogram.h"
+#import "GMFPlayerState.h"
+
+@class GMFQoEMonitor;
+@class GMFQoESession;
+
+// Aggregate QoE over all sessions so far. Durations are in seconds.
+typedef struct {
+  NSUInteger sessionCount;
+  // Loading content to the first playing state.
+  GMFHistogramSnapshot timeToFirstFrame;
+  // Seeking to paused or playing.
+  GMFHistogramSnapshot seekLatency;
+  // Length of each stall during playback.
+  GMFHistogramSnapshot rebufferDuration;
+  // End of an ad break to content playing again.
+  GMFHistogramSnapshot adToContentSwitchTime;
+  // Stalls per ended session that reached its first frame.
+  GMFHistogramSnapshot rebufferCount;
+  // Share of each ended session's watch time spent stalled, in [0, 1].
+  GMFHistogramSnapshot rebufferRatio;
+  NSTimeInterval totalPlayingDuration;
+  NSTimeInterval totalRebufferDuration;
+} GMFQoESnapshot;
+
+@protocol GMFQoEMonitorDelegate<NSObject>
+
+// |session| is final; hand it to analytics.
+- (void)qoeMonitor:(GMFQoEMonitor *)monitor didEndSession:(GMFQoESession *)session;
+
+@end
+
+// Metrics of one load of content, from the loading state until the next load, the end of
+// playback, an error or a reset.
+@interface GMFQoESession : NSObject
+
+// Negative until the first frame, and if an ad break started before the first frame; the ad
+// switch time covers that start instead.
+@property(nonatomic, readonly) NSTimeInterval timeToFirstFrame;
+
+@property(nonatomic, readonly) NSUInteger rebufferCount;
+
+// Time spent playing and stalled after the first frame, up to the last event. Ad breaks are not
+// included.
+@property(nonatomic, readonly) NSTimeInterval playingDuration;
+@property(nonatomic, readonly) NSTimeInterval rebufferDuration;
+
+@property(nonatomic, readonly) GMFLatencyHistogram *seekLatency;
+@property(nonatomic, readonly) GMFLatencyHistogram *rebufferDurations;
+@property(nonatomic, readonly) GMFLatencyHistogram *adToContentSwitchTime;
+
+// |rebufferDuration| over playing plus rebuffer time; 0 before the first frame.
+- (double)rebufferRatio;
+
+@end
+
+// Derives playback quality of experience from player state transitions and playhead ticks:
+// time to first frame, seek latency, rebuffer count, duration and ratio, and ad to content
+// switch time. Every value is recorded both in the current session and in aggregate
+// histograms, which never allocate after init, so |snapshot| with percentiles is cheap enough
+// to pull on every analytics beat. Main thread only.
+@interface GMFQoEMonitor : NSObject
+
+@property(nonatomic, weak) id<GMFQoEMonitorDelegate> delegate;
+
+// Nil between sessions.
+@property(nonatomic, readonly) GMFQoESession *currentSession;
+
+@property(nonatomic, readonly) NSUInteger sessionCount;
+
+// Aggregate histograms over every session.
+@property(nonatomic, readonly) GMFLatencyHistogram *timeToFirstFrame;
+@property(nonatomic, readonly) GMFLatencyHistogram *seekLatency;
+@property(nonatomic, readonly) GMFLatencyHistogram *rebufferDuration;
+@property(nonatomic, readonly) GMFLatencyHistogram *adToContentSwitchTime;
+@property(nonatomic, readonly) GMFLatencyHistogram *rebufferCount;
+@property(nonatomic, readonly) GMFLatencyHistogram *rebufferRatio;
+
+// Uses the shared GMFTimerWheel.
+- (instancetype)init;
+
+- (instancetype)initWithClock:(id<GMFClock>)clock;
+
+- (void)playerStateDidChangeFrom:(GMFPlayerState)fromState to:(GMFPlayerState)toState;
+
+// Brings the current session's playing and rebuffer durations up to date.
+- (void)playheadDidMoveToTime:(NSTimeInterval)mediaTime;
+
+// Content is paused for an ad break, and resumed after it. |adBreakDidEnd| outside a break is
+// ignored.
+- (void)adBreakDidStart;
+- (void)adBreakDidEnd;
+
+// Ends the current session, as a reset of the player does.
+- (void)endSession;
+
+- (GMFQoESnapshot)snapshot;
+
+// Clears the aggregate histograms and totals. The current session is kept.
+- (void)resetAggregates;
+
+@end
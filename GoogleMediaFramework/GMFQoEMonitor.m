@@ -0,0 +1,305 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFQoEMonitor.h"
+#import "GMFTimerWheel.h"
+
+// Range of the latency histograms: a millisecond to an hour.
+static const double kGMFLatencyLowest = 0.001;
+static const double kGMFLatencyHighest = 3600;
+
+static const double kGMFRebufferCountHighest = 1024;
+
+// Ratios below a hundredth of a percent are reported as the minimum.
+static const double kGMFRebufferRatioLowest = 0.0001;
+
+static GMFLatencyHistogram *GMFLatencyHistogramMake(void) {
+  return [[GMFLatencyHistogram alloc] initWithLowestValue:kGMFLatencyLowest
+                                             highestValue:kGMFLatencyHighest];
+}
+
+@interface GMFQoESession ()
+
+@property(nonatomic, assign) NSTimeInterval timeToFirstFrame;
+@property(nonatomic, assign) NSUInteger rebufferCount;
+@property(nonatomic, assign) NSTimeInterval playingDuration;
+@property(nonatomic, assign) NSTimeInterval rebufferDuration;
+
+// Set once content has played.
+@property(nonatomic, assign) BOOL reachedFirstFrame;
+
+// Set if an ad break started before the first frame, which makes the first frame time
+// meaningless.
+@property(nonatomic, assign) BOOL timeToFirstFrameAbandoned;
+
+@property(nonatomic, assign) NSTimeInterval startTime;
+
+@end
+
+@implementation GMFQoESession
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _timeToFirstFrame = -1;
+    _seekLatency = GMFLatencyHistogramMake();
+    _rebufferDurations = GMFLatencyHistogramMake();
+    _adToContentSwitchTime = GMFLatencyHistogramMake();
+  }
+  return self;
+}
+
+- (double)rebufferRatio {
+  NSTimeInterval watched = _playingDuration + _rebufferDuration;
+  return watched > 0 ? _rebufferDuration / watched : 0;
+}
+
+@end
+
+@implementation GMFQoEMonitor {
+  id<GMFClock> _clock;
+  GMFPlayerState _state;
+  BOOL _inAdBreak;
+  // Start times of the pending seek, stall and ad to content switch, or negative if there is
+  // none.
+  NSTimeInterval _seekStartTime;
+  NSTimeInterval _rebufferStartTime;
+  NSTimeInterval _adBreakEndTime;
+  // When playing and rebuffer durations were last brought up to date.
+  NSTimeInterval _lastAccountedTime;
+  NSTimeInterval _totalPlayingDuration;
+  NSTimeInterval _totalRebufferDuration;
+}
+
+- (instancetype)init {
+  return [self initWithClock:[GMFTimerWheel sharedWheel]];
+}
+
+- (instancetype)initWithClock:(id<GMFClock>)clock {
+  self = [super init];
+  if (self) {
+    _clock = clock;
+    _state = kGMFPlayerStateEmpty;
+    _timeToFirstFrame = GMFLatencyHistogramMake();
+    _seekLatency = GMFLatencyHistogramMake();
+    _rebufferDuration = GMFLatencyHistogramMake();
+    _adToContentSwitchTime = GMFLatencyHistogramMake();
+    _rebufferCount = [[GMFLatencyHistogram alloc] initWithLowestValue:1
+                                                         highestValue:kGMFRebufferCountHighest];
+    _rebufferRatio = [[GMFLatencyHistogram alloc] initWithLowestValue:kGMFRebufferRatioLowest
+                                                         highestValue:1];
+    [self clearPendingIntervals];
+  }
+  return self;
+}
+
+- (void)playerStateDidChangeFrom:(GMFPlayerState)fromState to:(GMFPlayerState)toState {
+  [self accountTime];
+  NSTimeInterval now = [_clock now];
+  _state = toState;
+
+  switch (toState) {
+    case kGMFPlayerStateLoadingContent:
+      [self endSession];
+      [self startSession];
+      return;
+    case kGMFPlayerStateEmpty:
+    case kGMFPlayerStateFinished:
+    case kGMFPlayerStateError:
+      [self endSession];
+      return;
+    default:
+      break;
+  }
+  if (!_currentSession) {
+    return;
+  }
+
+  // Any way out of a stall ends it, including pausing or seeking.
+  if (toState != kGMFPlayerStateBuffering) {
+    [self endRebufferAtTime:now];
+  }
+
+  switch (toState) {
+    case kGMFPlayerStateSeeking:
+      // Seeks issued before the last one completed count from the first.
+      if (_seekStartTime < 0 && !_inAdBreak) {
+        _seekStartTime = now;
+      }
+      break;
+    case kGMFPlayerStateBuffering:
+      if (fromState == kGMFPlayerStatePlaying && [_currentSession reachedFirstFrame] &&
+          !_inAdBreak && _seekStartTime < 0) {
+        _rebufferStartTime = now;
+      }
+      break;
+    case kGMFPlayerStatePaused:
+      [self endSeekAtTime:now];
+      break;
+    case kGMFPlayerStatePlaying:
+      [self endSeekAtTime:now];
+      if (![_currentSession reachedFirstFrame]) {
+        [_currentSession setReachedFirstFrame:YES];
+        if (![_currentSession timeToFirstFrameAbandoned]) {
+          NSTimeInterval timeToFirstFrame = now - [_currentSession startTime];
+          [_currentSession setTimeToFirstFrame:timeToFirstFrame];
+          [_timeToFirstFrame recordValue:timeToFirstFrame];
+        }
+      }
+      if (_adBreakEndTime >= 0 && !_inAdBreak) {
+        NSTimeInterval switchTime = now - _adBreakEndTime;
+        [[_currentSession adToContentSwitchTime] recordValue:switchTime];
+        [_adToContentSwitchTime recordValue:switchTime];
+        _adBreakEndTime = -1;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+- (void)playheadDidMoveToTime:(NSTimeInterval)mediaTime {
+  [self accountTime];
+}
+
+- (void)adBreakDidStart {
+  [self accountTime];
+  _inAdBreak = YES;
+  if (!_currentSession) {
+    return;
+  }
+  [self endRebufferAtTime:[_clock now]];
+  _seekStartTime = -1;
+  _adBreakEndTime = -1;
+  if (![_currentSession reachedFirstFrame]) {
+    [_currentSession setTimeToFirstFrameAbandoned:YES];
+  }
+}
+
+- (void)adBreakDidEnd {
+  if (!_inAdBreak) {
+    return;
+  }
+  [self accountTime];
+  _inAdBreak = NO;
+  if (_currentSession) {
+    _adBreakEndTime = [_clock now];
+  }
+}
+
+- (void)endSession {
+  GMFQoESession *session = _currentSession;
+  if (!session) {
+    return;
+  }
+  [self accountTime];
+  // A stall the viewer gave up on counts up to the moment they left.
+  [self endRebufferAtTime:[_clock now]];
+  [self clearPendingIntervals];
+  _currentSession = nil;
+  if ([session reachedFirstFrame]) {
+    [_rebufferCount recordValue:[session rebufferCount]];
+    [_rebufferRatio recordValue:[session rebufferRatio]];
+  }
+  [_delegate qoeMonitor:self didEndSession:session];
+}
+
+- (GMFQoESnapshot)snapshot {
+  [self accountTime];
+  GMFQoESnapshot snapshot;
+  snapshot.sessionCount = _sessionCount;
+  snapshot.timeToFirstFrame = [_timeToFirstFrame snapshot];
+  snapshot.seekLatency = [_seekLatency snapshot];
+  snapshot.rebufferDuration = [_rebufferDuration snapshot];
+  snapshot.adToContentSwitchTime = [_adToContentSwitchTime snapshot];
+  snapshot.rebufferCount = [_rebufferCount snapshot];
+  snapshot.rebufferRatio = [_rebufferRatio snapshot];
+  snapshot.totalPlayingDuration = _totalPlayingDuration;
+  snapshot.totalRebufferDuration = _totalRebufferDuration;
+  return snapshot;
+}
+
+- (void)resetAggregates {
+  [_timeToFirstFrame reset];
+  [_seekLatency reset];
+  [_rebufferDuration reset];
+  [_adToContentSwitchTime reset];
+  [_rebufferCount reset];
+  [_rebufferRatio reset];
+  _sessionCount = 0;
+  _totalPlayingDuration = 0;
+  _totalRebufferDuration = 0;
+}
+
+#pragma mark Private Methods
+
+- (void)startSession {
+  _currentSession = [[GMFQoESession alloc] init];
+  [_currentSession setStartTime:[_clock now]];
+  // A load requested during an ad break starts with the break still running.
+  if (_inAdBreak) {
+    [_currentSession setTimeToFirstFrameAbandoned:YES];
+  }
+  _sessionCount++;
+}
+
+- (void)clearPendingIntervals {
+  _seekStartTime = -1;
+  _rebufferStartTime = -1;
+  _adBreakEndTime = -1;
+}
+
+// Adds the time since the last call to the current session's playing or rebuffer duration.
+- (void)accountTime {
+  NSTimeInterval now = [_clock now];
+  NSTimeInterval elapsed = now - _lastAccountedTime;
+  _lastAccountedTime = now;
+  if (!_currentSession || _inAdBreak || ![_currentSession reachedFirstFrame] || elapsed <= 0) {
+    return;
+  }
+  if (_rebufferStartTime >= 0) {
+    [_currentSession setRebufferDuration:[_currentSession rebufferDuration] + elapsed];
+    _totalRebufferDuration += elapsed;
+  } else if (_state == kGMFPlayerStatePlaying) {
+    [_currentSession setPlayingDuration:[_currentSession playingDuration] + elapsed];
+    _totalPlayingDuration += elapsed;
+  }
+}
+
+- (void)endRebufferAtTime:(NSTimeInterval)now {
+  if (_rebufferStartTime < 0) {
+    return;
+  }
+  NSTimeInterval duration = now - _rebufferStartTime;
+  _rebufferStartTime = -1;
+  [_currentSession setRebufferCount:[_currentSession rebufferCount] + 1];
+  [[_currentSession rebufferDurations] recordValue:duration];
+  [_rebufferDuration recordValue:duration];
+}
+
+- (void)endSeekAtTime:(NSTimeInterval)now {
+  if (_seekStartTime < 0) {
+    return;
+  }
+  NSTimeInterval latency = now - _seekStartTime;
+  _seekStartTime = -1;
+  [[_currentSession seekLatency] recordValue:latency];
+  [_seekLatency recordValue:latency];
+}
+
+@end
@@ -15,6 +15,12 @@
 #import <UIKit/UIKit.h>
 #import <Foundation/Foundation.h>
 
+@class GMFLRUCache;
+
+// Vends the framework's images. Each image is decoded once and kept in a shared cache bounded by
+// decoded bytes and keyed by name, tint color and scale, so building another player doesn't read
+// or rasterize them again. The control images are packed into a single atlas bitmap the first time
+// any of them is needed.
 @interface GMFResources : NSObject
 
 + (UIImage *)playerBarPlayButtonImage;
@@ -29,5 +35,25 @@
 + (UIImage *)playerBarBackgroundImage;
 + (UIImage *)playerTitleBarBackgroundImage;
 
+// |image| tinted with |color|. Tinted versions of images vended by this class are cached; other
+// images are tinted on every call.
++ (UIImage *)tintedImage:(UIImage *)image color:(UIColor *)color;
+
+// Decodes the control atlas on a background queue. Call early so the first player doesn't decode
+// it on the main thread. Later calls do nothing.
++ (void)preloadControlImages;
+
+// |image| drawn into a bitmap, so it isn't decoded lazily on the main thread when first shown.
+// Safe to call from any thread.
++ (UIImage *)decodeImage:(UIImage *)image;
+
+// The shared cache, e.g. to read its hit and miss counters or change its byte budget. It is
+// trimmed under memory pressure by the shared GMFMemoryGovernor.
++ (GMFLRUCache *)imageCache;
+
+// When disabled, every request reads and decodes the image from disk and every tint is rendered
+// again, as before the cache existed. Enabled by default; meant for benchmarks.
++ (void)setCachingEnabled:(BOOL)enabled;
+
 @end
 
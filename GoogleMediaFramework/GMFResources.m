@@ -16,69 +16,192 @@
 #error "This file requires ARC support."
 #endif
 
+#import <objc/runtime.h>
+
 #import "GMFResources.h"
+#import "GMFLRUCache.h"
+#import "GMFMemoryGovernor.h"
 #import "GMFVideoPlayer.h"
+#import "UIImage+GMFTintableImage.h"
+
+static NSString * const kGMFPlayImageName = @"player_control_play@2x";
+static NSString * const kGMFPlayLargeImageName = @"player_control_play_large@2x";
+static NSString * const kGMFPauseImageName = @"player_control_pause@2x";
+static NSString * const kGMFPauseLargeImageName = @"player_control_pause_large@2x";
+static NSString * const kGMFReplayImageName = @"player_control_replay@2x";
+static NSString * const kGMFReplayLargeImageName = @"player_control_replay_large@2x";
+static NSString * const kGMFMaximizeImageName = @"player_control_maximize@2x";
+static NSString * const kGMFMinimizeImageName = @"player_control_minimize@2x";
+static NSString * const kGMFScrubberThumbImageName = @"player_scrubber_thumb@2x";
+static NSString * const kGMFBarBackgroundImageName = @"player_controls_background@2x";
+static NSString * const kGMFTitleBarBackgroundImageName =
+    @"player_controls_title_bar_background@2x";
+
+// Decoded bytes the shared cache may hold. The untinted control atlas is about a tenth of this.
+static const NSUInteger kGMFImageCacheDefaultCostLimit = 4 * 1024 * 1024;
+
+// Widest row of the control atlas, in pixels.
+static const size_t kGMFAtlasMaxRowWidth = 1024;
+// Gap between atlas cells so filtering never samples a neighbour.
+static const size_t kGMFAtlasPadding = 1;
+
+// Associated object key tagging images vended by GMFResources with their resource name.
+static char kGMFResourceNameKey;
+
+static BOOL gGMFImageCachingEnabled = YES;
+
+// Decoded size in bytes. Atlas cells report the atlas' row stride, so count pixels instead.
+static NSUInteger GMFImageCost(UIImage *image) {
+  CGImageRef cgImage = [image CGImage];
+  return CGImageGetWidth(cgImage) * CGImageGetHeight(cgImage) * 4;
+}
+
+static UIImage *GMFTagImageWithName(UIImage *image, NSString *name) {
+  objc_setAssociatedObject(image, &kGMFResourceNameKey, name, OBJC_ASSOCIATION_COPY_NONATOMIC);
+  return image;
+}
+
+// Returns nil for colors without RGBA components, e.g. pattern colors, which are not cached.
+static NSString *GMFTintedImageCacheKey(NSString *name, UIColor *color, CGFloat scale) {
+  CGFloat red, green, blue, alpha;
+  if (![color getRed:&red green:&green blue:&blue alpha:&alpha]) {
+    return nil;
+  }
+  return [NSString stringWithFormat:@"%@|%.4f,%.4f,%.4f,%.4f|%.1f",
+      name, red, green, blue, alpha, scale];
+}
 
 @implementation GMFResources
 
 + (UIImage *)playerBarPlayButtonImage {
-  return [self imageNamed:@"player_control_play@2x"];
+  return [self imageNamed:kGMFPlayImageName];
 }
 
 + (UIImage *)playerBarPlayLargeButtonImage {
-  return [self imageNamed:@"player_control_play_large@2x"];
+  return [self imageNamed:kGMFPlayLargeImageName];
 }
 
 + (UIImage *)playerBarPauseButtonImage {
-  return [self imageNamed:@"player_control_pause@2x"];
+  return [self imageNamed:kGMFPauseImageName];
 }
 
 + (UIImage *)playerBarPauseLargeButtonImage {
-  return [self imageNamed:@"player_control_pause_large@2x"];
+  return [self imageNamed:kGMFPauseLargeImageName];
 }
 
 + (UIImage *)playerBarReplayButtonImage {
-  return [self imageNamed:@"player_control_replay@2x"];
+  return [self imageNamed:kGMFReplayImageName];
 }
 
 + (UIImage *)playerBarReplayLargeButtonImage {
-  return [self imageNamed:@"player_control_replay_large@2x"];
+  return [self imageNamed:kGMFReplayLargeImageName];
 }
 
 + (UIImage *)playerBarMaximizeButtonImage {
-  return [self imageNamed:@"player_control_maximize@2x"];
+  return [self imageNamed:kGMFMaximizeImageName];
 }
 
 + (UIImage *)playerBarMinimizeButtonImage {
-  return [self imageNamed:@"player_control_minimize@2x"];
+  return [self imageNamed:kGMFMinimizeImageName];
 }
 
 + (UIImage *)playerBarScrubberThumbImage {
-  return [self imageNamed:@"player_scrubber_thumb@2x"];
+  return [self imageNamed:kGMFScrubberThumbImageName];
 }
 
 + (UIImage *)playerBarBackgroundImage {
-  return [self imageNamed:@"player_controls_background@2x"];
+  return [self imageNamed:kGMFBarBackgroundImageName];
 }
 
 + (UIImage *)playerTitleBarBackgroundImage {
-  return [self imageNamed:@"player_controls_title_bar_background@2x"];
+  return [self imageNamed:kGMFTitleBarBackgroundImageName];
+}
+
++ (UIImage *)tintedImage:(UIImage *)image color:(UIColor *)color {
+  if (!image || !color) {
+    return image;
+  }
+  NSString *name = objc_getAssociatedObject(image, &kGMFResourceNameKey);
+  NSString *key = nil;
+  if (name && gGMFImageCachingEnabled) {
+    key = GMFTintedImageCacheKey(name, color, [image scale]);
+  }
+  if (!key) {
+    return [image GMF_createTintedImage:color];
+  }
+  GMFLRUCache *cache = [self imageCache];
+  UIImage *tintedImage = [cache objectForKey:key];
+  if (!tintedImage) {
+    // Tint the original so that re-tinting an already tinted image gives the same result.
+    UIImage *baseImage = [self decodedImageNamed:name] ?: image;
+    tintedImage = GMFTagImageWithName([baseImage GMF_createTintedImage:color], name);
+    [cache setObject:tintedImage forKey:key cost:GMFImageCost(tintedImage)];
+  }
+  return tintedImage;
+}
+
++ (void)preloadControlImages {
+  dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+      [self controlAtlasImages];
+  });
+}
+
++ (GMFLRUCache *)imageCache {
+  static GMFLRUCache *imageCache;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+      imageCache = [[GMFLRUCache alloc] initWithCostLimit:kGMFImageCacheDefaultCostLimit];
+      [[GMFMemoryGovernor sharedGovernor] addResponder:imageCache];
+  });
+  return imageCache;
+}
+
++ (void)setCachingEnabled:(BOOL)enabled {
+  gGMFImageCachingEnabled = enabled;
+  if (!enabled) {
+    [[self imageCache] removeAllObjects];
+  }
+}
+
+// |imageWithContentsOfFile:| defers decoding until the image is first drawn, which happens on the
+// main thread. Drawing it into a bitmap here decodes it on the calling thread instead.
++ (UIImage *)decodeImage:(UIImage *)image {
+  if (!image) {
+    return nil;
+  }
+  CGImageRef cgImage = [image CGImage];
+  size_t width = CGImageGetWidth(cgImage);
+  size_t height = CGImageGetHeight(cgImage);
+  CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+  CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace,
+      kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst);
+  CGColorSpaceRelease(colorSpace);
+  if (!context) {
+    return image;
+  }
+  CGContextDrawImage(context, CGRectMake(0, 0, width, height), cgImage);
+  CGImageRef decodedImage = CGBitmapContextCreateImage(context);
+  CGContextRelease(context);
+  UIImage *result = [UIImage imageWithCGImage:decodedImage
+                                        scale:[image scale]
+                                  orientation:UIImageOrientationUp];
+  CGImageRelease(decodedImage);
+  return result;
 }
 
 #pragma mark Private Methods
 
 + (UIImage *)imageNamed:(NSString *)name
             stretchable:(BOOL)stretchable {
-  NSBundle *frameworkBundle = [NSBundle bundleForClass:[self class]];
-  NSString *resourcePath = [frameworkBundle pathForResource:name ofType:@"png"];
-  UIImage *image = [UIImage imageWithContentsOfFile:resourcePath];
+  UIImage *image = [self decodedImageNamed:name];
 
   NSAssert(image, @"There is no image called %@", name);
   if (stretchable) {
     // Stretching the image by using a center cap.
     CGSize size = [image size];
-    return [image stretchableImageWithLeftCapWidth:size.width / 2.0
-                                      topCapHeight:size.height / 2.0];
+    return GMFTagImageWithName([image stretchableImageWithLeftCapWidth:size.width / 2.0
+                                                          topCapHeight:size.height / 2.0],
+                               name);
   } else {
     return image;
   }
@@ -88,5 +211,135 @@
   return [self imageNamed:name stretchable:NO];
 }
 
-@end
+// Cache, then atlas, then disk.
++ (UIImage *)decodedImageNamed:(NSString *)name {
+  if (!gGMFImageCachingEnabled) {
+    return GMFTagImageWithName([self imageFromDiskNamed:name], name);
+  }
+  GMFLRUCache *cache = [self imageCache];
+  UIImage *image = [cache objectForKey:name];
+  if (!image) {
+    image = [[self controlAtlasImages] objectForKey:name];
+    if (!image) {
+      image = GMFTagImageWithName([self decodeImage:[self imageFromDiskNamed:name]], name);
+    }
+    if (image) {
+      [cache setObject:image forKey:name cost:GMFImageCost(image)];
+    }
+  }
+  return image;
+}
+
++ (UIImage *)imageFromDiskNamed:(NSString *)name {
+  NSBundle *frameworkBundle = [NSBundle bundleForClass:[self class]];
+  NSString *resourcePath = [frameworkBundle pathForResource:name ofType:@"png"];
+  return [UIImage imageWithContentsOfFile:resourcePath];
+}
+
+// Control images keyed by name. Each one is a view into the same decoded atlas bitmap.
++ (NSDictionary *)controlAtlasImages {
+  static NSDictionary *atlasImages;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+      atlasImages = [self atlasImagesWithNames:@[ kGMFPlayImageName,
+                                                  kGMFPlayLargeImageName,
+                                                  kGMFPauseImageName,
+                                                  kGMFPauseLargeImageName,
+                                                  kGMFReplayImageName,
+                                                  kGMFReplayLargeImageName,
+                                                  kGMFMaximizeImageName,
+                                                  kGMFMinimizeImageName,
+                                                  kGMFScrubberThumbImageName,
+                                                  kGMFBarBackgroundImageName,
+                                                  kGMFTitleBarBackgroundImageName ]];
+  });
+  return atlasImages;
+}
 
+// Packs the images into rows ordered by height, draws them all into one bitmap and cuts the
+// result back up with CGImageCreateWithImageInRect, which shares the bitmap's memory.
++ (NSDictionary *)atlasImagesWithNames:(NSArray *)names {
+  NSMutableArray *sourceImages = [NSMutableArray arrayWithCapacity:[names count]];
+  NSMutableArray *sourceNames = [NSMutableArray arrayWithCapacity:[names count]];
+  for (NSString *name in names) {
+    UIImage *image = [self imageFromDiskNamed:name];
+    if (image) {
+      [sourceImages addObject:image];
+      [sourceNames addObject:name];
+    }
+  }
+  NSUInteger count = [sourceImages count];
+  if (!count) {
+    return @{};
+  }
+
+  NSMutableArray *order = [NSMutableArray arrayWithCapacity:count];
+  for (NSUInteger i = 0; i < count; i++) {
+    [order addObject:@(i)];
+  }
+  [order sortUsingComparator:^NSComparisonResult(NSNumber *a, NSNumber *b) {
+      size_t heightA = CGImageGetHeight([[sourceImages objectAtIndex:[a unsignedIntegerValue]] CGImage]);
+      size_t heightB = CGImageGetHeight([[sourceImages objectAtIndex:[b unsignedIntegerValue]] CGImage]);
+      return heightA > heightB ? NSOrderedAscending : (heightA < heightB ? NSOrderedDescending
+                                                                         : NSOrderedSame);
+  }];
+
+  // Shelf packing; cell origins are top-left, in pixels.
+  CGRect *cells = calloc(count, sizeof(CGRect));
+  size_t x = 0;
+  size_t y = 0;
+  size_t rowHeight = 0;
+  size_t atlasWidth = 0;
+  for (NSNumber *index in order) {
+    CGImageRef cgImage = [[sourceImages objectAtIndex:[index unsignedIntegerValue]] CGImage];
+    size_t width = CGImageGetWidth(cgImage);
+    size_t height = CGImageGetHeight(cgImage);
+    if (x > 0 && x + width > kGMFAtlasMaxRowWidth) {
+      x = 0;
+      y += rowHeight + kGMFAtlasPadding;
+      rowHeight = 0;
+    }
+    cells[[index unsignedIntegerValue]] = CGRectMake(x, y, width, height);
+    x += width + kGMFAtlasPadding;
+    rowHeight = MAX(rowHeight, height);
+    atlasWidth = MAX(atlasWidth, x);
+  }
+  size_t atlasHeight = y + rowHeight;
+
+  CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+  CGContextRef context = CGBitmapContextCreate(NULL, atlasWidth, atlasHeight, 8, 0, colorSpace,
+      kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst);
+  CGColorSpaceRelease(colorSpace);
+  if (!context) {
+    free(cells);
+    return @{};
+  }
+  for (NSUInteger i = 0; i < count; i++) {
+    // Core Graphics draws with a bottom-left origin.
+    CGRect cell = cells[i];
+    CGContextDrawImage(context,
+                       CGRectMake(cell.origin.x,
+                                  atlasHeight - cell.origin.y - cell.size.height,
+                                  cell.size.width,
+                                  cell.size.height),
+                       [[sourceImages objectAtIndex:i] CGImage]);
+  }
+  CGImageRef atlas = CGBitmapContextCreateImage(context);
+  CGContextRelease(context);
+
+  NSMutableDictionary *images = [NSMutableDictionary dictionaryWithCapacity:count];
+  for (NSUInteger i = 0; i < count; i++) {
+    CGImageRef cellImage = CGImageCreateWithImageInRect(atlas, cells[i]);
+    UIImage *image = [UIImage imageWithCGImage:cellImage
+                                         scale:[[sourceImages objectAtIndex:i] scale]
+                                   orientation:UIImageOrientationUp];
+    CGImageRelease(cellImage);
+    NSString *name = [sourceNames objectAtIndex:i];
+    [images setObject:GMFTagImageWithName(image, name) forKey:name];
+  }
+  CGImageRelease(atlas);
+  free(cells);
+  return images;
+}
+
+@end
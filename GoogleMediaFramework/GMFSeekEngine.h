@@ -0,0 +1,92 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFClock.h"
+#import "GMFLatencyHistogram.h"
+
+@class GMFSeekEngine;
+
+typedef enum {
+  // Lands on the nearest keyframe; quick enough to follow a drag.
+  kGMFSeekModeFast = 0,
+  // Lands on the exact frame; may need to decode from the previous keyframe.
+  kGMFSeekModePrecise
+} GMFSeekMode;
+
+// Whatever performs the seeks, e.g. GMFAVPlaybackBackend on its AVPlayerItem. Times are in
+// seconds, so the engine and its backends don't need CoreMedia.
+@protocol GMFSeekBackend<NSObject>
+
+// Seeks to |time|, landing anywhere up to |tolerance| seconds either side of it. INFINITY lets
+// the backend pick the nearest keyframe.
+- (void)seekToTime:(NSTimeInterval)time
+            tolerance:(NSTimeInterval)tolerance
+    completionHandler:(void (^)(BOOL finished))completionHandler;
+
+@end
+
+@protocol GMFSeekEngineDelegate<NSObject>
+
+// The last requested seek completed and none is pending. |finished| is NO if the backend
+// interrupted it.
+- (void)seekEngine:(GMFSeekEngine *)engine
+    didFinishSeekingToTime:(NSTimeInterval)time
+                  finished:(BOOL)finished;
+
+@end
+
+// Keeps at most one seek in flight on the backend. Requests made meanwhile replace each other,
+// so only the latest target is issued once the current seek completes and the ones in between
+// are dropped without reaching the backend. A drag can request fast seeks on every move and a
+// precise one when it ends without seeks piling up behind each other. Main thread only.
+@interface GMFSeekEngine : NSObject
+
+@property(nonatomic, weak) id<GMFSeekEngineDelegate> delegate;
+
+// Setting a new backend cancels any seek in progress.
+@property(nonatomic, weak) id<GMFSeekBackend> backend;
+
+// Latest requested target; NAN before the first request.
+@property(nonatomic, readonly) NSTimeInterval targetTime;
+
+@property(nonatomic, readonly) NSUInteger requestedCount;
+
+// Seeks handed to the backend.
+@property(nonatomic, readonly) NSUInteger issuedCount;
+
+// Requests replaced by a later one before they were issued.
+@property(nonatomic, readonly) NSUInteger droppedCount;
+
+// Seconds from each issued seek's request to its completion.
+@property(nonatomic, readonly) GMFLatencyHistogram *seekLatency;
+
+// Uses the shared GMFTimerWheel.
+- (instancetype)init;
+
+- (instancetype)initWithClock:(id<GMFClock>)clock;
+
+// Whether a seek is in flight or pending.
+- (BOOL)isSeeking;
+
+- (void)seekToTime:(NSTimeInterval)time mode:(GMFSeekMode)mode;
+
+// Forgets the pending seek and ignores the completion of the one in flight. The delegate isn't
+// told.
+- (void)cancel;
+
+- (void)resetStatistics;
+
+@end
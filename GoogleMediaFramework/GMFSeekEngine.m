@@ -0,0 +1,138 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFSeekEngine.h"
+#import "GMFTimerWheel.h"
+#import "GMFTrace.h"
+
+// Range of the latency histogram: a millisecond to a minute.
+static const double kGMFSeekLatencyLowest = 0.001;
+static const double kGMFSeekLatencyHighest = 60;
+
+typedef struct {
+  NSTimeInterval time;
+  GMFSeekMode mode;
+  // Clock time of the request.
+  NSTimeInterval requestTime;
+} GMFSeekRequest;
+
+@implementation GMFSeekEngine {
+  id<GMFClock> _clock;
+  BOOL _inFlight;
+  GMFSeekRequest _inFlightRequest;
+  BOOL _hasPending;
+  GMFSeekRequest _pendingRequest;
+  // Bumped by |cancel| so completions of seeks issued before it are ignored.
+  NSUInteger _generation;
+}
+
+- (instancetype)init {
+  return [self initWithClock:[GMFTimerWheel sharedWheel]];
+}
+
+- (instancetype)initWithClock:(id<GMFClock>)clock {
+  self = [super init];
+  if (self) {
+    _clock = clock;
+    _targetTime = NAN;
+    _seekLatency = [[GMFLatencyHistogram alloc] initWithLowestValue:kGMFSeekLatencyLowest
+                                                       highestValue:kGMFSeekLatencyHighest];
+  }
+  return self;
+}
+
+- (void)setBackend:(id<GMFSeekBackend>)backend {
+  if (backend != _backend) {
+    [self cancel];
+    _backend = backend;
+  }
+}
+
+- (BOOL)isSeeking {
+  return _inFlight || _hasPending;
+}
+
+- (void)seekToTime:(NSTimeInterval)time mode:(GMFSeekMode)mode {
+  _requestedCount++;
+  _targetTime = time;
+  GMFSeekRequest request = { time, mode, [_clock now] };
+  if (!_inFlight) {
+    [self issueRequest:request];
+    return;
+  }
+  if (_hasPending) {
+    _droppedCount++;
+    GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_VERBOSE, "seek.drop", _droppedCount);
+  }
+  _hasPending = YES;
+  _pendingRequest = request;
+}
+
+- (void)cancel {
+  _generation++;
+  _inFlight = NO;
+  _hasPending = NO;
+}
+
+- (void)resetStatistics {
+  _requestedCount = 0;
+  _issuedCount = 0;
+  _droppedCount = 0;
+  [_seekLatency reset];
+}
+
+#pragma mark Private Methods
+
+- (void)issueRequest:(GMFSeekRequest)request {
+  _inFlight = YES;
+  _inFlightRequest = request;
+  _issuedCount++;
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "seek.issue", request.mode);
+  // Fast seeks may land anywhere up to the neighbouring keyframes.
+  NSTimeInterval tolerance = request.mode == kGMFSeekModeFast ? INFINITY : 0;
+  NSUInteger generation = _generation;
+  __weak GMFSeekEngine *weakSelf = self;
+  [_backend seekToTime:request.time
+              tolerance:tolerance
+      completionHandler:^(BOOL finished) {
+          // AVPlayerItem may call back on any thread.
+          if ([NSThread isMainThread]) {
+            [weakSelf seekDidComplete:finished generation:generation];
+          } else {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [weakSelf seekDidComplete:finished generation:generation];
+            });
+          }
+      }];
+}
+
+- (void)seekDidComplete:(BOOL)finished generation:(NSUInteger)generation {
+  if (generation != _generation || !_inFlight) {
+    return;
+  }
+  _inFlight = NO;
+  [_seekLatency recordValue:[_clock now] - _inFlightRequest.requestTime];
+  if (_hasPending) {
+    _hasPending = NO;
+    [self issueRequest:_pendingRequest];
+    return;
+  }
+  [_delegate seekEngine:self didFinishSeekingToTime:_inFlightRequest.time finished:finished];
+}
+
+@end
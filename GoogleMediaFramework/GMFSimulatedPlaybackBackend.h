@@ -0,0 +1,79 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GMFClock.h"
+#import "GMFPlaybackBackend.h"
+
+// A GMFPlaybackBackend that plays a scripted item on a GMFClock, without media, decoding or a
+// network. With a GMFVirtualClock, loads, stalls, seeks and the end of the item happen exactly
+// when the clock is advanced past them, so player state tests run in milliseconds and never
+// flake. Events are delivered in the order AVFoundation delivers them: a stall empties the buffer
+// and then drops the rate to 0, and an item that pauses at its end drops the rate before it
+// reports the end.
+//
+// Script it before calling |load|.
+@interface GMFSimulatedPlaybackBackend : NSObject<GMFPlaybackBackend>
+
+@property(nonatomic, weak) id<GMFPlaybackBackendDelegate> delegate;
+
+// Seconds from |load| until the status changes.
+@property(nonatomic, assign) NSTimeInterval loadDelay;
+
+// Whether the load ends in the failed status instead of ready to play.
+@property(nonatomic, assign) BOOL failsToLoad;
+
+// Seconds from ready to play until the buffer is likely to keep up. At 0 it already is when the
+// status changes.
+@property(nonatomic, assign) NSTimeInterval startupBufferDelay;
+
+// Seconds each seek takes, unless one was queued with |enqueueSeekDelay:|.
+@property(nonatomic, assign) NSTimeInterval seekDelay;
+
+// YES, the default, stops at the end like a file does; NO keeps the rate like an HLS stream,
+// leaving it to the state machine to pause.
+@property(nonatomic, assign) BOOL pausesAtEnd;
+
+// For a live stream, the media time of its live point when the item loads, where playback starts.
+// The live point then advances with the clock: by |liveSegmentDuration| at a time, as playlist
+// refreshes move it, or continuously if that is 0.
+@property(nonatomic, assign) NSTimeInterval liveEdgeStartTime;
+@property(nonatomic, assign) NSTimeInterval liveSegmentDuration;
+
+// How far behind the live point a live stream stays seekable. 0, the default, keeps all of it, as
+// an event playlist does.
+@property(nonatomic, assign) NSTimeInterval liveWindowDuration;
+
+// Seeks started, and those interrupted by a later seek before completing.
+@property(nonatomic, readonly) NSUInteger seekCount;
+@property(nonatomic, readonly) NSUInteger interruptedSeekCount;
+
+// |duration| 0 simulates a live stream, which never ends.
+- (instancetype)initWithClock:(id<GMFClock>)clock duration:(NSTimeInterval)duration;
+
+// The buffer runs dry when playback reaches |time| and refills |duration| seconds later. Each
+// stall happens once.
+- (void)addStallAtTime:(NSTimeInterval)time duration:(NSTimeInterval)duration;
+
+// Delay of the next seek that doesn't have one yet. Queue several to script the order in which
+// seeks and other events complete.
+- (void)enqueueSeekDelay:(NSTimeInterval)delay;
+
+// Starts loading the item.
+- (void)load;
+
+// Fails the item now, as a server going away mid-stream does: playback stops and the status
+// changes to failed.
+- (void)fail;
+
+@end
@@ -0,0 +1,349 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFSimulatedPlaybackBackend.h"
+
+typedef struct {
+  NSTimeInterval time;
+  NSTimeInterval duration;
+  BOOL happened;
+} GMFSimulatedStall;
+
+@implementation GMFSimulatedPlaybackBackend {
+  id<GMFClock> _clock;
+  NSTimeInterval _duration;
+  GMFPlaybackBackendStatus _status;
+  float _rate;
+  float _playbackRate;
+  BOOL _bufferEmpty;
+  BOOL _likelyToKeepUp;
+  // Media time at |_anchorTime|, from which it advances at |_rate| while |_advancing|.
+  NSTimeInterval _mediaTime;
+  NSTimeInterval _anchorTime;
+  BOOL _advancing;
+  // Clock time of the load, from which a live point advances.
+  NSTimeInterval _loadTime;
+  GMFSimulatedStall *_stalls;
+  NSUInteger _stallCount;
+  NSMutableArray *_seekDelays;
+  void (^_seekCompletionHandler)(BOOL finished);
+  // Scheduled on |_clock|; nil when nothing is due.
+  id _loadHandle;
+  id _bufferHandle;
+  id _seekHandle;
+  // The next stall or the end, whichever playback reaches first, and its media time.
+  id _playbackHandle;
+  NSTimeInterval _playbackEventTime;
+}
+
+- (instancetype)initWithClock:(id<GMFClock>)clock duration:(NSTimeInterval)duration {
+  self = [super init];
+  if (self) {
+    _clock = clock;
+    _duration = duration;
+    _pausesAtEnd = YES;
+    _playbackRate = 1;
+    // Like AVPlayerItem, the buffer is empty until the item has loaded.
+    _bufferEmpty = YES;
+    _seekDelays = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [_clock cancelScheduledBlock:_loadHandle];
+  [_clock cancelScheduledBlock:_bufferHandle];
+  [_clock cancelScheduledBlock:_seekHandle];
+  [_clock cancelScheduledBlock:_playbackHandle];
+  free(_stalls);
+}
+
+- (void)addStallAtTime:(NSTimeInterval)time duration:(NSTimeInterval)duration {
+  _stalls = realloc(_stalls, (_stallCount + 1) * sizeof(GMFSimulatedStall));
+  _stalls[_stallCount++] = (GMFSimulatedStall){ time, duration, NO };
+  [self updateProgress];
+}
+
+- (void)enqueueSeekDelay:(NSTimeInterval)delay {
+  [_seekDelays addObject:@(delay)];
+}
+
+- (void)load {
+  [_clock cancelScheduledBlock:_loadHandle];
+  __weak GMFSimulatedPlaybackBackend *weakSelf = self;
+  _loadHandle = [_clock scheduleBlock:^{
+      [weakSelf didLoad];
+  } afterDelay:_loadDelay];
+}
+
+- (void)fail {
+  [_clock cancelScheduledBlock:_loadHandle];
+  _loadHandle = nil;
+  _status = kGMFPlaybackBackendStatusFailed;
+  [self updateProgress];
+  [_delegate playbackBackendStatusDidChange:self];
+  [self setRate:0];
+}
+
+#pragma mark GMFPlaybackBackend
+
+- (GMFPlaybackBackendStatus)status {
+  return _status;
+}
+
+- (float)rate {
+  return _rate;
+}
+
+- (void)setPlaybackRate:(float)playbackRate {
+  _playbackRate = playbackRate;
+  if (_rate > 0) {
+    [self setRate:playbackRate];
+  }
+}
+
+- (void)play {
+  [self setRate:_playbackRate];
+}
+
+- (void)pause {
+  [self setRate:0];
+}
+
+- (BOOL)isPlaybackBufferEmpty {
+  return _bufferEmpty;
+}
+
+- (BOOL)isPlaybackLikelyToKeepUp {
+  return _likelyToKeepUp;
+}
+
+- (NSTimeInterval)currentTime {
+  if (!_advancing) {
+    return _mediaTime;
+  }
+  NSTimeInterval time = _mediaTime + ([_clock now] - _anchorTime) * _rate;
+  return _duration > 0 ? MIN(time, _duration) : time;
+}
+
+- (NSTimeInterval)duration {
+  return _status == kGMFPlaybackBackendStatusReadyToPlay ? _duration : 0;
+}
+
+- (GMFTimeRange)seekableTimeRange {
+  if (_status != kGMFPlaybackBackendStatusReadyToPlay) {
+    return GMFTimeRangeMake(0, 0);
+  }
+  if (_duration > 0) {
+    return GMFTimeRangeMake(0, _duration);
+  }
+  NSTimeInterval liveEdge = [self liveEdgeTime];
+  NSTimeInterval start = _liveWindowDuration > 0 ? MAX(0, liveEdge - _liveWindowDuration) : 0;
+  return GMFTimeRangeMake(start, liveEdge);
+}
+
+- (void)seekToTime:(NSTimeInterval)time
+            tolerance:(NSTimeInterval)tolerance
+    completionHandler:(void (^)(BOOL finished))completionHandler {
+  if (_seekCompletionHandler) {
+    // AVPlayerItem interrupts the seek in flight.
+    _interruptedSeekCount++;
+    [_clock cancelScheduledBlock:_seekHandle];
+    _seekHandle = nil;
+    void (^interruptedHandler)(BOOL) = _seekCompletionHandler;
+    _seekCompletionHandler = nil;
+    interruptedHandler(NO);
+  }
+  _seekCount++;
+  // Playback holds while seeking.
+  _seekCompletionHandler = [completionHandler copy];
+  [self updateProgress];
+
+  NSTimeInterval delay = _seekDelay;
+  if ([_seekDelays count]) {
+    delay = [[_seekDelays firstObject] doubleValue];
+    [_seekDelays removeObjectAtIndex:0];
+  }
+  NSTimeInterval target = MAX(time, 0);
+  GMFTimeRange seekableRange = [self seekableTimeRange];
+  if (_duration > 0) {
+    target = MIN(target, _duration);
+  } else if (seekableRange.end > seekableRange.start) {
+    // Live streams only seek within their window.
+    target = MIN(MAX(target, seekableRange.start), seekableRange.end);
+  }
+  __weak GMFSimulatedPlaybackBackend *weakSelf = self;
+  _seekHandle = [_clock scheduleBlock:^{
+      [weakSelf didSeekToTime:target];
+  } afterDelay:delay];
+}
+
+#pragma mark Private Methods
+
+- (NSTimeInterval)liveEdgeTime {
+  NSTimeInterval elapsed = [_clock now] - _loadTime;
+  if (_liveSegmentDuration > 0) {
+    // A little slack, so a segment due exactly now isn't lost to rounding.
+    elapsed = floor((elapsed + 1e-9) / _liveSegmentDuration) * _liveSegmentDuration;
+  }
+  return _liveEdgeStartTime + elapsed;
+}
+
+- (void)setRate:(float)rate {
+  if (rate == _rate) {
+    return;
+  }
+  float previousRate = _rate;
+  _rate = rate;
+  [self updateProgress];
+  if (previousRate == 0 && rate > 0 && _status == kGMFPlaybackBackendStatusReadyToPlay &&
+      !_seekCompletionHandler && _duration > 0 && _mediaTime >= _duration) {
+    // Playing an item that is already at its end, e.g. after a seek there, ends it right away.
+    _playbackEventTime = _duration;
+    __weak GMFSimulatedPlaybackBackend *weakSelf = self;
+    _playbackHandle = [_clock scheduleBlock:^{
+        [weakSelf didReachPlaybackEvent];
+    } afterDelay:0];
+  }
+  [_delegate playbackBackendRateDidChange:self];
+}
+
+- (void)didLoad {
+  _loadHandle = nil;
+  if (_failsToLoad) {
+    _status = kGMFPlaybackBackendStatusFailed;
+    [_delegate playbackBackendStatusDidChange:self];
+    return;
+  }
+  _status = kGMFPlaybackBackendStatusReadyToPlay;
+  _loadTime = [_clock now];
+  if (_duration <= 0) {
+    // Live streams start at the live point.
+    _mediaTime = _liveEdgeStartTime;
+  }
+  if (_startupBufferDelay <= 0) {
+    _bufferEmpty = NO;
+    _likelyToKeepUp = YES;
+    [self updateProgress];
+  } else {
+    __weak GMFSimulatedPlaybackBackend *weakSelf = self;
+    _bufferHandle = [_clock scheduleBlock:^{
+        [weakSelf didFillBuffer];
+    } afterDelay:_startupBufferDelay];
+  }
+  [_delegate playbackBackendStatusDidChange:self];
+}
+
+- (void)didFillBuffer {
+  _bufferHandle = nil;
+  _bufferEmpty = NO;
+  _likelyToKeepUp = YES;
+  [self updateProgress];
+  [_delegate playbackBackendBufferStatusDidChange:self];
+}
+
+- (void)didSeekToTime:(NSTimeInterval)time {
+  _seekHandle = nil;
+  void (^completionHandler)(BOOL) = _seekCompletionHandler;
+  _seekCompletionHandler = nil;
+  _mediaTime = time;
+  _anchorTime = [_clock now];
+  [self updateProgress];
+  completionHandler(YES);
+}
+
+- (void)didReachPlaybackEvent {
+  _playbackHandle = nil;
+  // Exactly, rather than as accumulated from the clock.
+  _mediaTime = _playbackEventTime;
+  _anchorTime = [_clock now];
+  _advancing = NO;
+  NSUInteger stallIndex = [self indexOfNextStall];
+  if (stallIndex != NSNotFound && _stalls[stallIndex].time <= _mediaTime) {
+    [self beginStallAtIndex:stallIndex];
+  } else if (_duration > 0 && _mediaTime >= _duration) {
+    if (_pausesAtEnd) {
+      [self setRate:0];
+    }
+    [_delegate playbackBackendDidPlayToEnd:self];
+  } else {
+    [self updateProgress];
+  }
+}
+
+- (void)beginStallAtIndex:(NSUInteger)index {
+  _stalls[index].happened = YES;
+  _bufferEmpty = YES;
+  _likelyToKeepUp = NO;
+  [self updateProgress];
+  [_delegate playbackBackendBufferStatusDidChange:self];
+  [_delegate playbackBackendDidStall:self];
+  // AVPlayer drops the rate to 0 when it runs out of data.
+  [self setRate:0];
+  [_clock cancelScheduledBlock:_bufferHandle];
+  __weak GMFSimulatedPlaybackBackend *weakSelf = self;
+  _bufferHandle = [_clock scheduleBlock:^{
+      [weakSelf didFillBuffer];
+  } afterDelay:_stalls[index].duration];
+}
+
+// The stall playback reaches next from |_mediaTime|, or NSNotFound.
+- (NSUInteger)indexOfNextStall {
+  NSUInteger next = NSNotFound;
+  for (NSUInteger i = 0; i < _stallCount; i++) {
+    if (!_stalls[i].happened && _stalls[i].time >= _mediaTime &&
+        (next == NSNotFound || _stalls[i].time < _stalls[next].time)) {
+      next = i;
+    }
+  }
+  return next;
+}
+
+// Freezes the media time, and lets it advance again from now if playback can go on, scheduling
+// the next stall or the end.
+- (void)updateProgress {
+  _mediaTime = [self currentTime];
+  _anchorTime = [_clock now];
+  [_clock cancelScheduledBlock:_playbackHandle];
+  _playbackHandle = nil;
+
+  BOOL ended = _duration > 0 && _mediaTime >= _duration;
+  _advancing = _rate > 0 &&
+               _status == kGMFPlaybackBackendStatusReadyToPlay &&
+               !_bufferEmpty &&
+               !_seekCompletionHandler &&
+               !ended;
+  if (!_advancing) {
+    return;
+  }
+  NSTimeInterval eventTime = _duration > 0 ? _duration : INFINITY;
+  NSUInteger stallIndex = [self indexOfNextStall];
+  if (stallIndex != NSNotFound) {
+    eventTime = MIN(eventTime, _stalls[stallIndex].time);
+  }
+  if (isinf(eventTime)) {
+    return;
+  }
+  _playbackEventTime = eventTime;
+  __weak GMFSimulatedPlaybackBackend *weakSelf = self;
+  _playbackHandle = [_clock scheduleBlock:^{
+      [weakSelf didReachPlaybackEvent];
+  } afterDelay:(eventTime - _mediaTime) / _rate];
+}
+
+@end
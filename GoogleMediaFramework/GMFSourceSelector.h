@@ -0,0 +1,134 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#import <Foundation/Foundation.h>
+
+#import "GMFClock.h"
+#import "GMFLatencyHistogram.h"
+
+extern NSString *const kGMFSourceSelectorErrorDomain;
+
+typedef enum {
+  // The server answered the probe with an HTTP error status. The status code is in the userInfo
+  // under kGMFSourceSelectorHTTPStatusCodeKey.
+  kGMFSourceSelectorErrorHTTPStatus = 1,
+  // The probe didn't complete within |probeTimeout|.
+  kGMFSourceSelectorErrorTimedOut,
+  // There were no sources to select from.
+  kGMFSourceSelectorErrorNoSources
+} GMFSourceSelectorError;
+
+extern NSString *const kGMFSourceSelectorHTTPStatusCodeKey;
+
+// Default number of sources probed at once.
+extern const NSUInteger kGMFSourceSelectorDefaultRaceWidth;
+
+// Requests the start of a source to see whether, and how fast, its server answers.
+@protocol GMFSourceProber<NSObject>
+
+// |completion| must be called exactly once, on the main thread, with the number of bytes received
+// or the error the probe failed with.
+- (void)probeSourceWithURL:(NSURL *)URL
+                completion:(void (^)(uint64_t bytes, NSError *error))completion;
+
+@end
+
+// Probes with a GET of the first |probeLength| bytes of the source: the playlist of an HLS
+// stream, or the header of a file, which AVFoundation requests first anyway.
+@interface GMFHTTPSourceProber : NSObject<GMFSourceProber>
+
+// Defaults to 16 KB.
+@property(nonatomic, assign) NSUInteger probeLength;
+
+@end
+
+// Picks one of several equivalent sources of a stream, e.g. the same stream on different CDNs.
+//
+// A selection probes the best ranked |raceWidth| sources at once and picks whichever answers
+// first; a probe that fails or times out is replaced by the next source in line. So a slow or
+// dead CDN costs the viewer nothing while another one answers, instead of a long spinner.
+//
+// Scores are kept per host (and port) across selections: the probe latency, the throughput of
+// the transfers reported with |recordTransferWithBytes:duration:fromSource:|, and when the host
+// last failed. Hosts that failed within |failurePenalty| rank last, then hosts with a measured
+// throughput, fastest first, then hosts with a probe latency, quickest first, then the rest in
+// the order given. During playback, |failoverSourceAfterFailureOfSource:| hands out the next
+// source to switch to. Main thread only.
+@interface GMFSourceSelector : NSObject
+
+@property(nonatomic, readonly) id<GMFSourceProber> prober;
+
+// Sources probed at once. Defaults to 3.
+@property(nonatomic, assign) NSUInteger raceWidth;
+
+// Seconds after which a probe counts as failed. Defaults to 4.
+@property(nonatomic, assign) NSTimeInterval probeTimeout;
+
+// Seconds a host that failed ranks last. Defaults to 60.
+@property(nonatomic, assign) NSTimeInterval failurePenalty;
+
+// Sources of the current stream, as passed to the last selection.
+@property(nonatomic, readonly) NSArray *sources;
+
+// Source picked by the last selection or failover; nil while selecting.
+@property(nonatomic, readonly) NSURL *selectedSource;
+
+// Selections delivered, probes that failed or timed out, and failovers handed out.
+@property(nonatomic, readonly) NSUInteger selectionCount;
+@property(nonatomic, readonly) NSUInteger probeFailureCount;
+@property(nonatomic, readonly) NSUInteger failoverCount;
+
+// Seconds from the start of each delivered selection to its delivery: what it added to the time
+// to first frame.
+@property(nonatomic, readonly) GMFLatencyHistogram *selectionLatency;
+
+// Uses a GMFHTTPSourceProber and the shared GMFTimerWheel.
+- (instancetype)init;
+
+// |clock| times the probes.
+- (instancetype)initWithProber:(id<GMFSourceProber>)prober clock:(id<GMFClock>)clock;
+
+// Probes |URLs| and calls |completion| on the main thread with the first one to answer, or with
+// nil and the last probe's error if none did. Cancels any selection in progress. Never called for
+// a cancelled selection.
+- (void)selectSourceFromURLs:(NSArray *)URLs
+                  completion:(void (^)(NSURL *URL, NSError *error))completion;
+
+- (void)cancelSelection;
+
+// |URL| failed during playback. Penalises its host and returns the best ranked source of
+// |sources| that hasn't failed since the last selection, or nil if there is none.
+- (NSURL *)failoverSourceAfterFailureOfSource:(NSURL *)URL;
+
+// Adds a completed transfer from the host of |URL| to its throughput score.
+- (void)recordTransferWithBytes:(uint64_t)bytes
+                       duration:(NSTimeInterval)duration
+                     fromSource:(NSURL *)URL;
+
+// |URLs| best first.
+- (NSArray *)rankedSources:(NSArray *)URLs;
+
+// The throughput score of the host of |URL| in bits per second, or 0 without one.
+- (double)estimatedBitrateForSource:(NSURL *)URL;
+
+// The probe latency score of the host of |URL|, or NAN without one.
+- (NSTimeInterval)probeLatencyForSource:(NSURL *)URL;
+
+// Forgets all host scores.
+- (void)resetScores;
+
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,397 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFBandwidthEstimator.h"
+#import "GMFSourceSelector.h"
+#import "GMFTimerWheel.h"
+#import "GMFTrace.h"
+
+NSString *const kGMFSourceSelectorErrorDomain = @"GMFSourceSelectorErrorDomain";
+NSString *const kGMFSourceSelectorHTTPStatusCodeKey = @"GMFSourceSelectorHTTPStatusCode";
+
+const NSUInteger kGMFSourceSelectorDefaultRaceWidth = 3;
+
+static const NSUInteger kGMFHTTPSourceProberDefaultProbeLength = 16 * 1024;
+
+static const NSTimeInterval kGMFSourceSelectorDefaultProbeTimeout = 4;
+static const NSTimeInterval kGMFSourceSelectorDefaultFailurePenalty = 60;
+
+// Weight of a new probe latency in a host's score.
+static const double kGMFSourceProbeLatencyWeight = 0.3;
+
+// Range of the selection latency histogram: 1 millisecond to two minutes.
+static const double kGMFSourceSelectionLowestLatency = 0.001;
+static const double kGMFSourceSelectionHighestLatency = 120;
+
+// Scores are kept per host and port, so two CDNs on one host name with different ports, e.g.
+// stand-ins on the loopback interface, are told apart.
+static NSString *GMFSourceHostKey(NSURL *URL) {
+  NSString *host = [[URL host] lowercaseString] ?: @"";
+  NSNumber *port = [URL port];
+  return port ? [NSString stringWithFormat:@"%@:%@", host, port] : host;
+}
+
+@implementation GMFHTTPSourceProber
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _probeLength = kGMFHTTPSourceProberDefaultProbeLength;
+  }
+  return self;
+}
+
+- (void)probeSourceWithURL:(NSURL *)URL
+                completion:(void (^)(uint64_t bytes, NSError *error))completion {
+  NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:URL];
+  [request setValue:[NSString stringWithFormat:@"bytes=0-%lu", (unsigned long)_probeLength - 1]
+      forHTTPHeaderField:@"Range"];
+  [NSURLConnection sendAsynchronousRequest:request
+                                     queue:[NSOperationQueue mainQueue]
+                         completionHandler:^(NSURLResponse *response,
+                                             NSData *data,
+                                             NSError *error) {
+      NSInteger statusCode = [response isKindOfClass:[NSHTTPURLResponse class]]
+          ? [(NSHTTPURLResponse *)response statusCode]
+          : 0;
+      if (!error && statusCode >= 400) {
+        error = [NSError errorWithDomain:kGMFSourceSelectorErrorDomain
+                                    code:kGMFSourceSelectorErrorHTTPStatus
+                                userInfo:@{ kGMFSourceSelectorHTTPStatusCodeKey : @(statusCode) }];
+      }
+      completion(error ? 0 : [data length], error);
+  }];
+}
+
+@end
+
+// What is known of one host.
+@interface GMFSourceHostScore : NSObject {
+ @public
+  GMFBandwidthEstimator *_bandwidthEstimator;
+  // NAN until a probe answered.
+  NSTimeInterval _probeLatency;
+  BOOL _hasFailed;
+  NSTimeInterval _failureTime;
+}
+@end
+
+@implementation GMFSourceHostScore
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _bandwidthEstimator = [[GMFBandwidthEstimator alloc] init];
+    _probeLatency = NAN;
+  }
+  return self;
+}
+
+@end
+
+// One probe of a selection.
+@interface GMFSourceProbe : NSObject {
+ @public
+  NSURL *_URL;
+  // Generation of the selection it belongs to.
+  NSUInteger _generation;
+  NSTimeInterval _startTime;
+  id _timeoutHandle;
+  // Set once the probe answered or timed out.
+  BOOL _finished;
+}
+@end
+
+@implementation GMFSourceProbe
+@end
+
+@implementation GMFSourceSelector {
+  id<GMFClock> _clock;
+  // GMFSourceHostScore by host key.
+  NSMutableDictionary *_scores;
+  // Bumped by every selection and cancellation, so late probe answers are only scored.
+  NSUInteger _generation;
+  void (^_completion)(NSURL *URL, NSError *error);
+  NSTimeInterval _selectionStartTime;
+  // Ranked sources of the current selection not probed yet, and probes not finished yet.
+  NSMutableArray *_queuedSources;
+  NSMutableArray *_runningProbes;
+  // Sources that failed since the last selection started.
+  NSMutableSet *_failedSources;
+  NSError *_lastError;
+}
+
+- (instancetype)init {
+  return [self initWithProber:[[GMFHTTPSourceProber alloc] init]
+                        clock:[GMFTimerWheel sharedWheel]];
+}
+
+- (instancetype)initWithProber:(id<GMFSourceProber>)prober clock:(id<GMFClock>)clock {
+  self = [super init];
+  if (self) {
+    _prober = prober;
+    _clock = clock;
+    _raceWidth = kGMFSourceSelectorDefaultRaceWidth;
+    _probeTimeout = kGMFSourceSelectorDefaultProbeTimeout;
+    _failurePenalty = kGMFSourceSelectorDefaultFailurePenalty;
+    _scores = [NSMutableDictionary dictionary];
+    _queuedSources = [NSMutableArray array];
+    _runningProbes = [NSMutableArray array];
+    _failedSources = [NSMutableSet set];
+    _selectionLatency =
+        [[GMFLatencyHistogram alloc] initWithLowestValue:kGMFSourceSelectionLowestLatency
+                                            highestValue:kGMFSourceSelectionHighestLatency];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [self cancelSelection];
+}
+
+- (void)selectSourceFromURLs:(NSArray *)URLs
+                  completion:(void (^)(NSURL *URL, NSError *error))completion {
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_INFO, "source.select");
+  [self cancelSelection];
+  _sources = [URLs copy];
+  _selectedSource = nil;
+  [_failedSources removeAllObjects];
+  _lastError = nil;
+  _completion = [completion copy];
+  _selectionStartTime = [_clock now];
+  if (![_sources count]) {
+    [self finishSelectionWithSource:nil
+                              error:[NSError errorWithDomain:kGMFSourceSelectorErrorDomain
+                                                        code:kGMFSourceSelectorErrorNoSources
+                                                    userInfo:nil]];
+    return;
+  }
+  [_queuedSources setArray:[self rankedSources:_sources]];
+  [self startProbes];
+}
+
+- (void)cancelSelection {
+  _generation++;
+  for (GMFSourceProbe *probe in _runningProbes) {
+    [_clock cancelScheduledBlock:probe->_timeoutHandle];
+    probe->_timeoutHandle = nil;
+    probe->_finished = YES;
+  }
+  [_runningProbes removeAllObjects];
+  [_queuedSources removeAllObjects];
+  _completion = nil;
+}
+
+- (NSURL *)failoverSourceAfterFailureOfSource:(NSURL *)URL {
+  if (URL) {
+    [self recordFailureOfSource:URL];
+    [_failedSources addObject:URL];
+  }
+  for (NSURL *source in [self rankedSources:_sources]) {
+    if (![_failedSources containsObject:source]) {
+      _selectedSource = source;
+      _failoverCount++;
+      GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "source.failover", _failoverCount);
+      return source;
+    }
+  }
+  return nil;
+}
+
+- (void)recordTransferWithBytes:(uint64_t)bytes
+                       duration:(NSTimeInterval)duration
+                     fromSource:(NSURL *)URL {
+  [[self scoreForSource:URL]->_bandwidthEstimator addSampleWithBytes:bytes duration:duration];
+}
+
+- (NSArray *)rankedSources:(NSArray *)URLs {
+  NSUInteger count = [URLs count];
+  NSTimeInterval now = [_clock now];
+  // Sort keys: penalised hosts last, then by tier, then by value within the tier, then by index.
+  BOOL *penalised = malloc(MAX(count, 1) * sizeof(BOOL));
+  int *tiers = malloc(MAX(count, 1) * sizeof(int));
+  double *values = malloc(MAX(count, 1) * sizeof(double));
+  NSMutableArray *indices = [NSMutableArray arrayWithCapacity:count];
+  for (NSUInteger i = 0; i < count; i++) {
+    GMFSourceHostScore *score = [_scores objectForKey:GMFSourceHostKey([URLs objectAtIndex:i])];
+    penalised[i] = score && score->_hasFailed && now - score->_failureTime < _failurePenalty;
+    if (score && [score->_bandwidthEstimator hasEstimate]) {
+      tiers[i] = 0;
+      values[i] = -[score->_bandwidthEstimator estimatedBitrate];
+    } else if (score && !isnan(score->_probeLatency)) {
+      tiers[i] = 1;
+      values[i] = score->_probeLatency;
+    } else {
+      tiers[i] = 2;
+      values[i] = 0;
+    }
+    [indices addObject:@(i)];
+  }
+  [indices sortUsingComparator:^NSComparisonResult(NSNumber *first, NSNumber *second) {
+    NSUInteger a = [first unsignedIntegerValue];
+    NSUInteger b = [second unsignedIntegerValue];
+    if (penalised[a] != penalised[b]) {
+      return penalised[a] ? NSOrderedDescending : NSOrderedAscending;
+    }
+    if (tiers[a] != tiers[b]) {
+      return tiers[a] < tiers[b] ? NSOrderedAscending : NSOrderedDescending;
+    }
+    if (values[a] != values[b]) {
+      return values[a] < values[b] ? NSOrderedAscending : NSOrderedDescending;
+    }
+    return a < b ? NSOrderedAscending : NSOrderedDescending;
+  }];
+  free(penalised);
+  free(tiers);
+  free(values);
+  NSMutableArray *ranked = [NSMutableArray arrayWithCapacity:count];
+  for (NSNumber *index in indices) {
+    [ranked addObject:[URLs objectAtIndex:[index unsignedIntegerValue]]];
+  }
+  return ranked;
+}
+
+- (double)estimatedBitrateForSource:(NSURL *)URL {
+  GMFSourceHostScore *score = [_scores objectForKey:GMFSourceHostKey(URL)];
+  return score && [score->_bandwidthEstimator hasEstimate]
+      ? [score->_bandwidthEstimator estimatedBitrate]
+      : 0;
+}
+
+- (NSTimeInterval)probeLatencyForSource:(NSURL *)URL {
+  GMFSourceHostScore *score = [_scores objectForKey:GMFSourceHostKey(URL)];
+  return score ? score->_probeLatency : NAN;
+}
+
+- (void)resetScores {
+  [_scores removeAllObjects];
+}
+
+- (void)resetStatistics {
+  _selectionCount = 0;
+  _probeFailureCount = 0;
+  _failoverCount = 0;
+  [_selectionLatency reset];
+}
+
+#pragma mark Private Methods
+
+- (GMFSourceHostScore *)scoreForSource:(NSURL *)URL {
+  NSString *key = GMFSourceHostKey(URL);
+  GMFSourceHostScore *score = [_scores objectForKey:key];
+  if (!score) {
+    score = [[GMFSourceHostScore alloc] init];
+    [_scores setObject:score forKey:key];
+  }
+  return score;
+}
+
+- (void)recordFailureOfSource:(NSURL *)URL {
+  GMFSourceHostScore *score = [self scoreForSource:URL];
+  score->_hasFailed = YES;
+  score->_failureTime = [_clock now];
+}
+
+// Fills the race up to |raceWidth| probes from the queued sources.
+- (void)startProbes {
+  NSUInteger generation = _generation;
+  while (generation == _generation && [_runningProbes count] < MAX(_raceWidth, 1) &&
+         [_queuedSources count]) {
+    GMFSourceProbe *probe = [[GMFSourceProbe alloc] init];
+    probe->_URL = [_queuedSources firstObject];
+    probe->_generation = _generation;
+    probe->_startTime = [_clock now];
+    [_queuedSources removeObjectAtIndex:0];
+    [_runningProbes addObject:probe];
+
+    __weak GMFSourceSelector *weakSelf = self;
+    probe->_timeoutHandle = [_clock scheduleBlock:^{
+        [weakSelf probeDidTimeOut:probe];
+    } afterDelay:_probeTimeout];
+    [_prober probeSourceWithURL:probe->_URL completion:^(uint64_t bytes, NSError *error) {
+        [weakSelf probe:probe didFinishWithError:error];
+    }];
+  }
+}
+
+- (void)probe:(GMFSourceProbe *)probe didFinishWithError:(NSError *)error {
+  [_clock cancelScheduledBlock:probe->_timeoutHandle];
+  probe->_timeoutHandle = nil;
+  // Scored even if the selection moved on without it, e.g. after it timed out or lost the race.
+  if (error) {
+    [self recordFailureOfSource:probe->_URL];
+  } else {
+    GMFSourceHostScore *score = [self scoreForSource:probe->_URL];
+    NSTimeInterval latency = [_clock now] - probe->_startTime;
+    score->_probeLatency = isnan(score->_probeLatency)
+        ? latency
+        : score->_probeLatency + kGMFSourceProbeLatencyWeight * (latency - score->_probeLatency);
+  }
+  if (probe->_finished || probe->_generation != _generation) {
+    return;
+  }
+  probe->_finished = YES;
+  [_runningProbes removeObjectIdenticalTo:probe];
+  if (error) {
+    [self probe:probe didFailWithError:error];
+  } else {
+    [self finishSelectionWithSource:probe->_URL error:nil];
+  }
+}
+
+- (void)probeDidTimeOut:(GMFSourceProbe *)probe {
+  probe->_timeoutHandle = nil;
+  if (probe->_finished || probe->_generation != _generation) {
+    return;
+  }
+  probe->_finished = YES;
+  [_runningProbes removeObjectIdenticalTo:probe];
+  [self recordFailureOfSource:probe->_URL];
+  [self probe:probe
+      didFailWithError:[NSError errorWithDomain:kGMFSourceSelectorErrorDomain
+                                           code:kGMFSourceSelectorErrorTimedOut
+                                       userInfo:nil]];
+}
+
+// Replaces a failed probe with the next source, or ends the selection if none is left.
+- (void)probe:(GMFSourceProbe *)probe didFailWithError:(NSError *)error {
+  _probeFailureCount++;
+  [_failedSources addObject:probe->_URL];
+  _lastError = error;
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "source.probeFailed", [error code]);
+  NSUInteger generation = _generation;
+  [self startProbes];
+  // A prober answering synchronously may already have ended the selection.
+  if (generation == _generation && ![_runningProbes count]) {
+    [self finishSelectionWithSource:nil error:_lastError];
+  }
+}
+
+- (void)finishSelectionWithSource:(NSURL *)URL error:(NSError *)error {
+  void (^completion)(NSURL *, NSError *) = _completion;
+  [self cancelSelection];
+  _selectedSource = URL;
+  if (URL) {
+    _selectionCount++;
+    [_selectionLatency recordValue:[_clock now] - _selectionStartTime];
+  }
+  completion(URL, error);
+}
+
+@end
@@ -0,0 +1,70 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFLRUCache.h"
+#import "GMFThumbnailIndex.h"
+
+// Default total cost of decoded sprite sheets kept: 16 MB of pixels.
+extern const NSUInteger kGMFThumbnailCacheDefaultCostLimit;
+
+// Fetches and decodes sprite sheets for a GMFThumbnailCache.
+@protocol GMFThumbnailSpriteLoader<NSObject>
+
+// Calls |completion| on the main thread with the decoded sheet at |URL| and its cost in bytes,
+// or with nil if it couldn't be loaded.
+- (void)loadSpriteWithURL:(NSURL *)URL
+               completion:(void (^)(id sprite, NSUInteger cost))completion;
+
+@end
+
+// Decoded sprite sheets of a thumbnail index, kept in a GMFLRUCache bounded by their decoded
+// size. Each request also decodes the next |lookAheadCount| sheets in the direction the requests
+// are moving, so a drag along the scrubber mostly finds its sheets already decoded. Main thread
+// only.
+@interface GMFThumbnailCache : NSObject
+
+@property(nonatomic, readonly) GMFThumbnailIndex *index;
+
+// The decoded sheets, keyed by sprite index. Its cost limit can be changed. It is trimmed under
+// memory pressure by the shared GMFMemoryGovernor.
+@property(nonatomic, readonly) GMFLRUCache *sprites;
+
+// Sheets decoded ahead of the requests. Defaults to 2.
+@property(nonatomic, assign) NSUInteger lookAheadCount;
+
+// Sheets asked of the loader, including look-ahead.
+@property(nonatomic, readonly) NSUInteger loadCount;
+
+// Requests answered without waiting for a load.
+@property(nonatomic, readonly) NSUInteger immediateCount;
+
+- (instancetype)initWithIndex:(GMFThumbnailIndex *)index
+                       loader:(id<GMFThumbnailSpriteLoader>)loader
+                    costLimit:(NSUInteger)costLimit;
+
+// Calls |completion| with the thumbnail for |time| and its decoded sheet: right away if the
+// sheet is decoded, otherwise once it loads, unless a later request comes first. Only the latest
+// request is answered, so a fast drag doesn't replay a queue of stale thumbnails. Never called if
+// there are no thumbnails or the sheet fails to load.
+- (void)requestThumbnailForTime:(NSTimeInterval)time
+                     completion:(void (^)(id sprite, GMFThumbnail thumbnail))completion;
+
+// Drops the pending request, if any.
+- (void)cancelRequest;
+
+- (BOOL)isLoadingSpriteAtIndex:(NSUInteger)spriteIndex;
+
+@end
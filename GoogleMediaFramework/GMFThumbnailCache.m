@@ -0,0 +1,144 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFMemoryGovernor.h"
+#import "GMFThumbnailCache.h"
+
+const NSUInteger kGMFThumbnailCacheDefaultCostLimit = 16 * 1024 * 1024;
+
+static const NSUInteger kGMFThumbnailDefaultLookAheadCount = 2;
+
+@implementation GMFThumbnailCache {
+  id<GMFThumbnailSpriteLoader> _loader;
+  NSMutableIndexSet *_loadingSprites;
+  // The latest request, while its sheet loads.
+  void (^_pendingCompletion)(id sprite, GMFThumbnail thumbnail);
+  GMFThumbnail _pendingThumbnail;
+  // Time of the previous request, which gives the direction to decode ahead in.
+  NSTimeInterval _lastRequestTime;
+  BOOL _movingBackward;
+}
+
+- (instancetype)initWithIndex:(GMFThumbnailIndex *)index
+                       loader:(id<GMFThumbnailSpriteLoader>)loader
+                    costLimit:(NSUInteger)costLimit {
+  self = [super init];
+  if (self) {
+    _index = index;
+    _loader = loader;
+    _sprites = [[GMFLRUCache alloc] initWithCostLimit:costLimit];
+    [[GMFMemoryGovernor sharedGovernor] addResponder:_sprites];
+    _lookAheadCount = kGMFThumbnailDefaultLookAheadCount;
+    _loadingSprites = [NSMutableIndexSet indexSet];
+    _lastRequestTime = -1;
+  }
+  return self;
+}
+
+- (void)requestThumbnailForTime:(NSTimeInterval)time
+                     completion:(void (^)(id sprite, GMFThumbnail thumbnail))completion {
+  _pendingCompletion = nil;
+  NSUInteger thumbnailIndex = [_index thumbnailIndexForTime:time];
+  if (thumbnailIndex == NSNotFound) {
+    return;
+  }
+  // Keep the previous direction while the time stands still.
+  if (_lastRequestTime >= 0 && time != _lastRequestTime) {
+    _movingBackward = time < _lastRequestTime;
+  }
+  _lastRequestTime = time;
+
+  GMFThumbnail thumbnail = [_index thumbnailAtIndex:thumbnailIndex];
+  id sprite = [_sprites objectForKey:@(thumbnail.spriteIndex)];
+  if (sprite) {
+    _immediateCount++;
+    completion(sprite, thumbnail);
+  } else {
+    _pendingCompletion = [completion copy];
+    _pendingThumbnail = thumbnail;
+    [self loadSpriteAtIndex:thumbnail.spriteIndex];
+  }
+  [self loadSpritesAheadOfThumbnailAtIndex:thumbnailIndex];
+}
+
+- (void)cancelRequest {
+  _pendingCompletion = nil;
+}
+
+- (BOOL)isLoadingSpriteAtIndex:(NSUInteger)spriteIndex {
+  return [_loadingSprites containsIndex:spriteIndex];
+}
+
+#pragma mark Private Methods
+
+// Starts loading the next |lookAheadCount| distinct sheets after, or before when moving
+// backward, the thumbnail at |thumbnailIndex|. Sheets already decoded become the most recently
+// used, so the ones about to be needed are evicted last.
+- (void)loadSpritesAheadOfThumbnailAtIndex:(NSUInteger)thumbnailIndex {
+  NSUInteger count = [_index thumbnailCount];
+  NSUInteger lastSpriteIndex = [_index thumbnailAtIndex:thumbnailIndex].spriteIndex;
+  NSUInteger found = 0;
+  NSInteger step = _movingBackward ? -1 : 1;
+  for (NSInteger i = (NSInteger)thumbnailIndex + step;
+       found < _lookAheadCount && i >= 0 && i < (NSInteger)count;
+       i += step) {
+    NSUInteger spriteIndex = [_index thumbnailAtIndex:(NSUInteger)i].spriteIndex;
+    if (spriteIndex == lastSpriteIndex) {
+      continue;
+    }
+    lastSpriteIndex = spriteIndex;
+    found++;
+    if (![_sprites objectForKey:@(spriteIndex)]) {
+      [self loadSpriteAtIndex:spriteIndex];
+    }
+  }
+}
+
+- (void)loadSpriteAtIndex:(NSUInteger)spriteIndex {
+  if ([_loadingSprites containsIndex:spriteIndex]) {
+    return;
+  }
+  NSURL *URL = [_index URLForSpriteAtIndex:spriteIndex];
+  if (!URL) {
+    return;
+  }
+  [_loadingSprites addIndex:spriteIndex];
+  _loadCount++;
+  __weak GMFThumbnailCache *weakSelf = self;
+  [_loader loadSpriteWithURL:URL completion:^(id sprite, NSUInteger cost) {
+      [weakSelf spriteAtIndex:spriteIndex didLoad:sprite cost:cost];
+  }];
+}
+
+- (void)spriteAtIndex:(NSUInteger)spriteIndex didLoad:(id)sprite cost:(NSUInteger)cost {
+  [_loadingSprites removeIndex:spriteIndex];
+  if (!sprite) {
+    if (_pendingCompletion && _pendingThumbnail.spriteIndex == spriteIndex) {
+      _pendingCompletion = nil;
+    }
+    return;
+  }
+  [_sprites setObject:sprite forKey:@(spriteIndex) cost:cost];
+  if (_pendingCompletion && _pendingThumbnail.spriteIndex == spriteIndex) {
+    void (^completion)(id, GMFThumbnail) = _pendingCompletion;
+    _pendingCompletion = nil;
+    completion(sprite, _pendingThumbnail);
+  }
+}
+
+@end
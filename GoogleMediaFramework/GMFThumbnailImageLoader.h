@@ -1,4 +1,4 @@
-// Copyright 2013 Google Inc. All rights reserved.
+// Copyright 2026 Google Inc. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,12 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#import <XCTest/XCTest.h>
+#import <UIKit/UIKit.h>
 
-#import <GoogleMediaFramework/GoogleMediaFramework.h>
+#import "GMFThumbnailCache.h"
 
-@interface GoogleMediaFrameworkDemoTests : XCTestCase<GMFVideoPlayerDelegate>
-
-+ (NSString *)stringWithState:(GMFPlayerState)state;
+// Loads sprite sheets as UIImages, downloading and decoding them off the main thread. The cost
+// of a sheet is its decoded size in bytes.
+@interface GMFThumbnailImageLoader : NSObject<GMFThumbnailSpriteLoader>
 
 @end
@@ -0,0 +1,55 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFResources.h"
+#import "GMFThumbnailImageLoader.h"
+
+// Sheets downloaded and decoded at once.
+static const NSInteger kGMFThumbnailMaxConcurrentLoads = 2;
+
+@implementation GMFThumbnailImageLoader {
+  NSOperationQueue *_queue;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _queue = [[NSOperationQueue alloc] init];
+    [_queue setMaxConcurrentOperationCount:kGMFThumbnailMaxConcurrentLoads];
+  }
+  return self;
+}
+
+- (void)loadSpriteWithURL:(NSURL *)URL
+               completion:(void (^)(id sprite, NSUInteger cost))completion {
+  // The completion handler runs on |_queue|, so the image is decoded there too.
+  [NSURLConnection sendAsynchronousRequest:[NSURLRequest requestWithURL:URL]
+                                     queue:_queue
+                         completionHandler:^(NSURLResponse *response,
+                                             NSData *data,
+                                             NSError *error) {
+      UIImage *image = data ? [GMFResources decodeImage:[UIImage imageWithData:data]] : nil;
+      CGImageRef cgImage = [image CGImage];
+      NSUInteger cost = CGImageGetWidth(cgImage) * CGImageGetHeight(cgImage) * 4;
+      dispatch_async(dispatch_get_main_queue(), ^{
+          completion(image, cost);
+      });
+  }];
+}
+
+@end
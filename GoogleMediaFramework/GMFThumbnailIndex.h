@@ -0,0 +1,56 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+// A thumbnail cue: the region of a sprite sheet to show for times in [startTime, endTime).
+typedef struct {
+  NSTimeInterval startTime;
+  NSTimeInterval endTime;
+  // Index of the sprite sheet, see |URLForSpriteAtIndex:|.
+  NSUInteger spriteIndex;
+  // In pixels of the sprite sheet. CGRectNull when the cue shows the whole image.
+  CGRect region;
+} GMFThumbnail;
+
+// Parsed WebVTT thumbnail track, as used for scrubber previews. Each cue's payload is an image
+// URL, usually a sprite sheet with a media fragment selecting one tile:
+//
+//   00:00:05.000 --> 00:00:10.000
+//   sprites/0001.jpg#xywh=160,0,160,90
+//
+// Parsing scans the bytes of |data| in place and builds one URL string per sprite sheet rather
+// than one per cue. Thumbnails are sorted by start time, so the one for a given time is found
+// with a binary search.
+@interface GMFThumbnailIndex : NSObject
+
+@property(nonatomic, readonly) NSData *data;
+@property(nonatomic, readonly) NSURL *baseURL;
+
+// Returns nil unless |data| starts with WEBVTT.
++ (instancetype)indexWithData:(NSData *)data baseURL:(NSURL *)baseURL;
+
+- (NSUInteger)thumbnailCount;
+- (GMFThumbnail)thumbnailAtIndex:(NSUInteger)index;
+
+// Index of the last thumbnail starting at or before |time|, or the first one if |time| comes
+// before all of them. NSNotFound if there are no thumbnails.
+- (NSUInteger)thumbnailIndexForTime:(NSTimeInterval)time;
+
+// Distinct sprite sheets, in order of first use.
+- (NSUInteger)spriteCount;
+- (NSURL *)URLForSpriteAtIndex:(NSUInteger)index;
+
+@end
@@ -0,0 +1,267 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFThumbnailIndex.h"
+
+static const NSUInteger kGMFThumbnailInitialCapacity = 64;
+
+static const char kGMFWebVTTSignature[] = "WEBVTT";
+static const char kGMFUTF8ByteOrderMark[] = "\xEF\xBB\xBF";
+
+#pragma mark Byte scanning
+
+#define GMF_HAS_PREFIX(p, end, prefix) \
+  ((size_t)((end) - (p)) >= sizeof(prefix) - 1 && memcmp((p), (prefix), sizeof(prefix) - 1) == 0)
+
+static uint64_t GMFParseUnsigned(const char *p, const char *end, const char **next) {
+  uint64_t value = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    value = value * 10 + (uint64_t)(*p - '0');
+    p++;
+  }
+  if (next) {
+    *next = p;
+  }
+  return value;
+}
+
+// Parses a WebVTT timestamp, "hh:mm:ss.ttt" or "mm:ss.ttt", starting at |p|.
+static NSTimeInterval GMFParseTimestamp(const char *p, const char *end, const char **next) {
+  NSTimeInterval seconds = (NSTimeInterval)GMFParseUnsigned(p, end, &p);
+  while (p < end && *p == ':') {
+    seconds = seconds * 60 + (NSTimeInterval)GMFParseUnsigned(p + 1, end, &p);
+  }
+  if (p < end && *p == '.') {
+    NSTimeInterval scale = 0.1;
+    for (p++; p < end && *p >= '0' && *p <= '9'; p++) {
+      seconds += (*p - '0') * scale;
+      scale *= 0.1;
+    }
+  }
+  if (next) {
+    *next = p;
+  }
+  return seconds;
+}
+
+// Reads the pixel region of a "xywh=[pixel:]x,y,w,h" media fragment. Percentages and malformed
+// fragments select the whole image.
+static CGRect GMFParseSpatialFragment(const char *p, const char *end) {
+  if (!GMF_HAS_PREFIX(p, end, "xywh=")) {
+    return CGRectNull;
+  }
+  p += sizeof("xywh=") - 1;
+  if (GMF_HAS_PREFIX(p, end, "pixel:")) {
+    p += sizeof("pixel:") - 1;
+  } else if (p < end && (*p < '0' || *p > '9')) {
+    return CGRectNull;
+  }
+  uint64_t values[4];
+  for (int i = 0; i < 4; i++) {
+    const char *start = p;
+    values[i] = GMFParseUnsigned(p, end, &p);
+    if (p == start || (i < 3 && (p == end || *p++ != ','))) {
+      return CGRectNull;
+    }
+  }
+  return CGRectMake(values[0], values[1], values[2], values[3]);
+}
+
+static int GMFCompareThumbnailStartTimes(const void *a, const void *b) {
+  NSTimeInterval first = ((const GMFThumbnail *)a)->startTime;
+  NSTimeInterval second = ((const GMFThumbnail *)b)->startTime;
+  return first < second ? -1 : first > second ? 1 : 0;
+}
+
+@implementation GMFThumbnailIndex {
+  GMFThumbnail *_thumbnails;
+  NSUInteger _thumbnailCount;
+  NSUInteger _thumbnailCapacity;
+  // Byte range in |_data| of each sprite sheet's URL.
+  NSRange *_spriteRanges;
+  NSUInteger _spriteCount;
+  NSUInteger _spriteCapacity;
+}
+
++ (instancetype)indexWithData:(NSData *)data baseURL:(NSURL *)baseURL {
+  const char *bytes = [data bytes];
+  const char *end = bytes + [data length];
+  if (GMF_HAS_PREFIX(bytes, end, kGMFUTF8ByteOrderMark)) {
+    bytes += sizeof(kGMFUTF8ByteOrderMark) - 1;
+  }
+  if (!GMF_HAS_PREFIX(bytes, end, kGMFWebVTTSignature)) {
+    return nil;
+  }
+  return [[self alloc] initWithData:data baseURL:baseURL];
+}
+
+- (instancetype)initWithData:(NSData *)data baseURL:(NSURL *)baseURL {
+  self = [super init];
+  if (self) {
+    _data = [data copy];
+    _baseURL = baseURL;
+    [self parse];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  free(_thumbnails);
+  free(_spriteRanges);
+}
+
+- (NSUInteger)thumbnailCount {
+  return _thumbnailCount;
+}
+
+- (GMFThumbnail)thumbnailAtIndex:(NSUInteger)index {
+  NSAssert(index < _thumbnailCount, @"Thumbnail index %lu out of bounds.", (unsigned long)index);
+  return _thumbnails[index];
+}
+
+- (NSUInteger)thumbnailIndexForTime:(NSTimeInterval)time {
+  if (!_thumbnailCount) {
+    return NSNotFound;
+  }
+  // Last thumbnail starting at or before |time|.
+  NSUInteger low = 0;
+  NSUInteger high = _thumbnailCount;
+  while (low < high) {
+    NSUInteger mid = low + (high - low) / 2;
+    if (_thumbnails[mid].startTime <= time) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low ? low - 1 : 0;
+}
+
+- (NSUInteger)spriteCount {
+  return _spriteCount;
+}
+
+- (NSURL *)URLForSpriteAtIndex:(NSUInteger)index {
+  NSAssert(index < _spriteCount, @"Sprite index %lu out of bounds.", (unsigned long)index);
+  NSString *URI = [[NSString alloc] initWithBytes:(const char *)[_data bytes] +
+                                                  _spriteRanges[index].location
+                                           length:_spriteRanges[index].length
+                                         encoding:NSUTF8StringEncoding];
+  return URI ? [NSURL URLWithString:URI relativeToURL:_baseURL] : nil;
+}
+
+#pragma mark Private Methods
+
+- (void)parse {
+  const char *bytes = [_data bytes];
+  const char *dataEnd = bytes + [_data length];
+  const char *line = bytes;
+  // Sprite indexes keyed by URL, for sheets that come back after another one was used.
+  NSMutableDictionary *spriteIndexes = [NSMutableDictionary dictionary];
+  BOOL sorted = YES;
+  BOOL hasPendingCue = NO;
+  GMFThumbnail pendingCue = { 0, 0, 0, CGRectNull };
+
+  while (line < dataEnd) {
+    const char *newline = memchr(line, '\n', (size_t)(dataEnd - line));
+    const char *next = newline ? newline + 1 : dataEnd;
+    const char *end = newline ? newline : dataEnd;
+    if (end > line && end[-1] == '\r') {
+      end--;
+    }
+
+    const char *arrow = end - line >= 3 ? memchr(line, '-', (size_t)(end - line)) : NULL;
+    while (arrow && !GMF_HAS_PREFIX(arrow, end, "-->")) {
+      arrow = memchr(arrow + 1, '-', (size_t)(end - arrow - 1));
+    }
+    if (end == line) {
+      // A blank line ends the cue, even one without a payload.
+      hasPendingCue = NO;
+    } else if (arrow) {
+      // Timing line. Cue settings after the end time don't apply to thumbnails.
+      const char *p = line;
+      while (p < arrow && (*p == ' ' || *p == '\t')) {
+        p++;
+      }
+      pendingCue.startTime = GMFParseTimestamp(p, arrow, NULL);
+      p = arrow + 3;
+      while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+      }
+      pendingCue.endTime = GMFParseTimestamp(p, end, NULL);
+      hasPendingCue = YES;
+    } else if (hasPendingCue) {
+      // First payload line. Cue identifiers, NOTE blocks and the header come before any timing
+      // line of their block, so they never get here.
+      const char *hash = memchr(line, '#', (size_t)(end - line));
+      const char *URIEnd = hash ?: end;
+      NSRange URIRange = NSMakeRange((NSUInteger)(line - bytes), (NSUInteger)(URIEnd - line));
+      pendingCue.region = hash ? GMFParseSpatialFragment(hash + 1, end) : CGRectNull;
+      pendingCue.spriteIndex = [self spriteIndexForRange:URIRange indexes:spriteIndexes];
+      if (_thumbnailCount && pendingCue.startTime < _thumbnails[_thumbnailCount - 1].startTime) {
+        sorted = NO;
+      }
+      [self appendThumbnail:pendingCue];
+      hasPendingCue = NO;
+    }
+    line = next;
+  }
+
+  if (!sorted) {
+    // Cues must be in start time order, but don't let one that isn't break lookups.
+    qsort(_thumbnails, _thumbnailCount, sizeof(GMFThumbnail), GMFCompareThumbnailStartTimes);
+  }
+}
+
+// Consecutive cues mostly share a sheet, so the previous cue's URL is compared first and a
+// string is only built when the sheet changes.
+- (NSUInteger)spriteIndexForRange:(NSRange)range indexes:(NSMutableDictionary *)indexes {
+  const char *bytes = [_data bytes];
+  if (_thumbnailCount) {
+    NSUInteger previousIndex = _thumbnails[_thumbnailCount - 1].spriteIndex;
+    NSRange previous = _spriteRanges[previousIndex];
+    if (previous.length == range.length &&
+        memcmp(bytes + previous.location, bytes + range.location, range.length) == 0) {
+      return previousIndex;
+    }
+  }
+  NSString *key = [[NSString alloc] initWithBytes:bytes + range.location
+                                           length:range.length
+                                         encoding:NSUTF8StringEncoding] ?: @"";
+  NSNumber *existing = [indexes objectForKey:key];
+  if (existing) {
+    return [existing unsignedIntegerValue];
+  }
+  if (_spriteCount == _spriteCapacity) {
+    _spriteCapacity = MAX(kGMFThumbnailInitialCapacity, _spriteCapacity * 2);
+    _spriteRanges = realloc(_spriteRanges, _spriteCapacity * sizeof(NSRange));
+  }
+  _spriteRanges[_spriteCount] = range;
+  [indexes setObject:@(_spriteCount) forKey:key];
+  return _spriteCount++;
+}
+
+- (void)appendThumbnail:(GMFThumbnail)thumbnail {
+  if (_thumbnailCount == _thumbnailCapacity) {
+    _thumbnailCapacity = MAX(kGMFThumbnailInitialCapacity, _thumbnailCapacity * 2);
+    _thumbnails = realloc(_thumbnails, _thumbnailCapacity * sizeof(GMFThumbnail));
+  }
+  _thumbnails[_thumbnailCount++] = thumbnail;
+}
+
+@end
@@ -0,0 +1,68 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+// Half-open interval [start, end) in seconds.
+typedef struct {
+  NSTimeInterval start;
+  NSTimeInterval end;
+} GMFTimeRange;
+
+static inline GMFTimeRange GMFTimeRangeMake(NSTimeInterval start, NSTimeInterval end) {
+  GMFTimeRange range = { start, end };
+  return range;
+}
+
+// A set of disjoint time ranges kept sorted in one contiguous array of GMFTimeRange, so lookups
+// are binary searches over plain doubles rather than scans over boxed values. Overlapping or
+// touching ranges are merged when added and ranges are split when a hole is removed. Queries are
+// O(log n); updates are O(log n) plus a memmove of the tail.
+//
+// Depends only on Foundation so it can be tested without a media stack.
+@interface GMFTimeRangeSet : NSObject<NSCopying>
+
+- (NSUInteger)count;
+
+- (GMFTimeRange)rangeAtIndex:(NSUInteger)index;
+
+// Adds |range|, merging it with any ranges it overlaps or touches. Empty ranges are ignored.
+- (void)addRange:(GMFTimeRange)range;
+
+// Removes |range|, trimming or splitting the ranges it overlaps.
+- (void)removeRange:(GMFTimeRange)range;
+
+- (void)removeAllRanges;
+
+// Replaces the contents with |ranges|, which may be unsorted and overlapping. Returns NO, and
+// leaves the set untouched, if the normalized result equals the current contents.
+- (BOOL)setRanges:(const GMFTimeRange *)ranges count:(NSUInteger)count;
+
+- (BOOL)containsTime:(NSTimeInterval)time;
+
+// End of the range containing |time|, or NAN if |time| is not in the set.
+- (NSTimeInterval)endOfRangeContainingTime:(NSTimeInterval)time;
+
+// Contiguous duration available from |time| onwards; 0 if |time| is not in the set.
+- (NSTimeInterval)durationAheadOfTime:(NSTimeInterval)time;
+
+// First time at or after |time| that is not in the set.
+- (NSTimeInterval)nextGapAfterTime:(NSTimeInterval)time;
+
+// Sum of the durations of all ranges.
+- (NSTimeInterval)totalDuration;
+
+- (BOOL)isEqualToTimeRangeSet:(GMFTimeRangeSet *)other;
+
+@end
@@ -0,0 +1,243 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFTimeRangeSet.h"
+
+static const NSUInteger kGMFTimeRangeSetInitialCapacity = 4;
+
+// Index of the first range whose end is >= |time| (or > |time| if |strict|).
+static NSUInteger GMFFirstRangeEndingAfter(const GMFTimeRange *ranges,
+                                           NSUInteger count,
+                                           NSTimeInterval time,
+                                           BOOL strict) {
+  NSUInteger low = 0;
+  NSUInteger high = count;
+  while (low < high) {
+    NSUInteger mid = low + (high - low) / 2;
+    BOOL before = strict ? ranges[mid].end <= time : ranges[mid].end < time;
+    if (before) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+// Index of the first range whose start is > |time| (or >= |time| if |inclusive|).
+static NSUInteger GMFFirstRangeStartingAfter(const GMFTimeRange *ranges,
+                                             NSUInteger count,
+                                             NSTimeInterval time,
+                                             BOOL inclusive) {
+  NSUInteger low = 0;
+  NSUInteger high = count;
+  while (low < high) {
+    NSUInteger mid = low + (high - low) / 2;
+    BOOL before = inclusive ? ranges[mid].start < time : ranges[mid].start <= time;
+    if (before) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+static int GMFCompareTimeRangeStarts(const void *a, const void *b) {
+  NSTimeInterval startA = ((const GMFTimeRange *)a)->start;
+  NSTimeInterval startB = ((const GMFTimeRange *)b)->start;
+  return (startA > startB) - (startA < startB);
+}
+
+@implementation GMFTimeRangeSet {
+  GMFTimeRange *_ranges;
+  NSUInteger _count;
+  NSUInteger _capacity;
+}
+
+- (void)dealloc {
+  free(_ranges);
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+  GMFTimeRangeSet *copy = [[[self class] allocWithZone:zone] init];
+  [copy replaceRangesFrom:0 to:0 withRanges:_ranges count:_count];
+  return copy;
+}
+
+- (NSUInteger)count {
+  return _count;
+}
+
+- (GMFTimeRange)rangeAtIndex:(NSUInteger)index {
+  NSAssert(index < _count, @"Index %lu out of bounds.", (unsigned long)index);
+  return _ranges[index];
+}
+
+- (void)addRange:(GMFTimeRange)range {
+  if (!(range.end > range.start)) {
+    return;
+  }
+  // Ranges in [first, last) overlap or touch |range| and collapse into one.
+  NSUInteger first = GMFFirstRangeEndingAfter(_ranges, _count, range.start, NO);
+  NSUInteger last = GMFFirstRangeStartingAfter(_ranges, _count, range.end, NO);
+  if (first < last) {
+    range.start = MIN(range.start, _ranges[first].start);
+    range.end = MAX(range.end, _ranges[last - 1].end);
+  }
+  [self replaceRangesFrom:first to:last withRanges:&range count:1];
+}
+
+- (void)removeRange:(GMFTimeRange)range {
+  if (!(range.end > range.start)) {
+    return;
+  }
+  // Ranges in [first, last) intersect |range|; at most their outer ends survive.
+  NSUInteger first = GMFFirstRangeEndingAfter(_ranges, _count, range.start, YES);
+  NSUInteger last = GMFFirstRangeStartingAfter(_ranges, _count, range.end, YES);
+  if (first >= last) {
+    return;
+  }
+  GMFTimeRange remainders[2];
+  NSUInteger remainderCount = 0;
+  if (_ranges[first].start < range.start) {
+    remainders[remainderCount++] = GMFTimeRangeMake(_ranges[first].start, range.start);
+  }
+  if (_ranges[last - 1].end > range.end) {
+    remainders[remainderCount++] = GMFTimeRangeMake(range.end, _ranges[last - 1].end);
+  }
+  [self replaceRangesFrom:first to:last withRanges:remainders count:remainderCount];
+}
+
+- (void)removeAllRanges {
+  _count = 0;
+}
+
+- (BOOL)setRanges:(const GMFTimeRange *)ranges count:(NSUInteger)count {
+  GMFTimeRange *sorted = malloc(MAX(count, 1) * sizeof(GMFTimeRange));
+  memcpy(sorted, ranges, count * sizeof(GMFTimeRange));
+  qsort(sorted, count, sizeof(GMFTimeRange), GMFCompareTimeRangeStarts);
+
+  NSUInteger merged = 0;
+  for (NSUInteger i = 0; i < count; i++) {
+    if (!(sorted[i].end > sorted[i].start)) {
+      continue;
+    }
+    if (merged && sorted[i].start <= sorted[merged - 1].end) {
+      sorted[merged - 1].end = MAX(sorted[merged - 1].end, sorted[i].end);
+    } else {
+      sorted[merged++] = sorted[i];
+    }
+  }
+
+  BOOL changed = merged != _count ||
+      (merged && memcmp(sorted, _ranges, merged * sizeof(GMFTimeRange)) != 0);
+  if (changed) {
+    [self replaceRangesFrom:0 to:_count withRanges:sorted count:merged];
+  }
+  free(sorted);
+  return changed;
+}
+
+- (BOOL)containsTime:(NSTimeInterval)time {
+  return [self indexOfRangeContainingTime:time] != NSNotFound;
+}
+
+- (NSTimeInterval)endOfRangeContainingTime:(NSTimeInterval)time {
+  NSUInteger index = [self indexOfRangeContainingTime:time];
+  return index == NSNotFound ? NAN : _ranges[index].end;
+}
+
+- (NSTimeInterval)durationAheadOfTime:(NSTimeInterval)time {
+  NSUInteger index = [self indexOfRangeContainingTime:time];
+  return index == NSNotFound ? 0 : _ranges[index].end - time;
+}
+
+- (NSTimeInterval)nextGapAfterTime:(NSTimeInterval)time {
+  NSUInteger index = [self indexOfRangeContainingTime:time];
+  return index == NSNotFound ? time : _ranges[index].end;
+}
+
+- (NSTimeInterval)totalDuration {
+  NSTimeInterval total = 0;
+  for (NSUInteger i = 0; i < _count; i++) {
+    total += _ranges[i].end - _ranges[i].start;
+  }
+  return total;
+}
+
+- (BOOL)isEqualToTimeRangeSet:(GMFTimeRangeSet *)other {
+  if (!other || other->_count != _count) {
+    return NO;
+  }
+  return !_count || memcmp(other->_ranges, _ranges, _count * sizeof(GMFTimeRange)) == 0;
+}
+
+- (BOOL)isEqual:(id)object {
+  return self == object ||
+      ([object isKindOfClass:[GMFTimeRangeSet class]] && [self isEqualToTimeRangeSet:object]);
+}
+
+- (NSUInteger)hash {
+  return _count ? _count ^ (NSUInteger)_ranges[0].start : 0;
+}
+
+- (NSString *)description {
+  NSMutableString *description = [NSMutableString stringWithString:@"{"];
+  for (NSUInteger i = 0; i < _count; i++) {
+    [description appendFormat:@"%@[%.3f, %.3f)", i ? @", " : @"", _ranges[i].start, _ranges[i].end];
+  }
+  [description appendString:@"}"];
+  return description;
+}
+
+#pragma mark Private Methods
+
+- (NSUInteger)indexOfRangeContainingTime:(NSTimeInterval)time {
+  // Last range starting at or before |time|.
+  NSUInteger index = GMFFirstRangeStartingAfter(_ranges, _count, time, NO);
+  if (index == 0 || !(time < _ranges[index - 1].end)) {
+    return NSNotFound;
+  }
+  return index - 1;
+}
+
+// Replaces the ranges at indices [from, to) with |count| ranges from |ranges|.
+- (void)replaceRangesFrom:(NSUInteger)from
+                       to:(NSUInteger)to
+               withRanges:(const GMFTimeRange *)ranges
+                    count:(NSUInteger)count {
+  NSUInteger newCount = _count - (to - from) + count;
+  if (newCount > _capacity) {
+    NSUInteger capacity = MAX(_capacity * 2, kGMFTimeRangeSetInitialCapacity);
+    while (capacity < newCount) {
+      capacity *= 2;
+    }
+    _ranges = realloc(_ranges, capacity * sizeof(GMFTimeRange));
+    _capacity = capacity;
+  }
+  if (to != from + count) {
+    memmove(&_ranges[from + count], &_ranges[to], (_count - to) * sizeof(GMFTimeRange));
+  }
+  if (count) {
+    memcpy(&_ranges[from], ranges, count * sizeof(GMFTimeRange));
+  }
+  _count = newCount;
+}
+
+@end
@@ -0,0 +1,71 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+#import "GMFClock.h"
+
+// Default slot length: one frame at 60 Hz.
+extern const NSTimeInterval kGMFTimerWheelDefaultResolution;
+
+// Default slot count, so one turn of the wheel covers about four seconds.
+extern const NSUInteger kGMFTimerWheelDefaultSlotCount;
+
+// Hashed timer wheel carrying any number of one-shot timers on top of a single timer of another
+// clock.
+//
+// Time is cut into slots of |resolution| seconds, and a timer goes into the slot its deadline
+// rounds up to, modulo |slotCount|; timers further out than one turn share slots with nearer
+// ones and are skipped until their turn comes. Scheduling links the timer into its slot and
+// cancelling unlinks it, both O(1) through the returned handle. The wheel keeps exactly one timer
+// of the underlying clock, set for the earliest slot with a due timer, so timers falling into the
+// same slot cost one wakeup between them. Timers due in the same wakeup run in order of deadline,
+// then of scheduling.
+//
+// Deadlines are rounded up to the next slot boundary, so a timer may run up to |resolution| late,
+// never early. On a GMFVirtualClock the wheel runs entirely in virtual time, with each virtual
+// clock block standing for one wakeup. Main thread only.
+@interface GMFTimerWheel : NSObject<GMFClock>
+
+// Gives the time and the wakeups.
+@property(nonatomic, readonly) id<GMFClock> clock;
+
+@property(nonatomic, readonly) NSTimeInterval resolution;
+
+// Always a power of two.
+@property(nonatomic, readonly) NSUInteger slotCount;
+
+// Timers scheduled and neither run nor cancelled.
+@property(nonatomic, readonly) NSUInteger timerCount;
+
+// Timers run, and wakeups of |clock| it took to run them.
+@property(nonatomic, readonly) NSUInteger firedCount;
+@property(nonatomic, readonly) NSUInteger wakeupCount;
+
+// The wheel on the main run loop, carrying the framework's timers: control auto-hide, playhead
+// ticks, ad and playlist schedules, and watchdogs. It sits on the shared GMFRunLoopClock.
++ (instancetype)sharedWheel;
+
+// Uses the shared GMFRunLoopClock and the default resolution and slot count.
+- (instancetype)init;
+
+// Uses the default resolution and slot count; pass a GMFVirtualClock in tests.
+- (instancetype)initWithClock:(id<GMFClock>)clock;
+
+// |slotCount| is rounded up to a power of two.
+- (instancetype)initWithClock:(id<GMFClock>)clock
+                   resolution:(NSTimeInterval)resolution
+                    slotCount:(NSUInteger)slotCount;
+
+@end
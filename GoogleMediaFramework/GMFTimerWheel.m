@@ -0,0 +1,302 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#include <math.h>
+
+#import "GMFTimerWheel.h"
+#import "GMFTrace.h"
+
+const NSTimeInterval kGMFTimerWheelDefaultResolution = 1.0 / 60;
+const NSUInteger kGMFTimerWheelDefaultSlotCount = 256;
+
+// Tolerance when turning times into slot ticks, so a wakeup delivered exactly at a slot boundary
+// isn't taken for the slot before it.
+static const double kGMFTimerWheelTickEpsilon = 1e-6;
+
+typedef enum {
+  // Linked into its slot.
+  kGMFTimerWheelEntryStateScheduled,
+  // Taken out of its slot by a wakeup, about to run.
+  kGMFTimerWheelEntryStateDue,
+  // Ran or was cancelled.
+  kGMFTimerWheelEntryStateDone
+} GMFTimerWheelEntryState;
+
+// A timer, and the handle handed out for it. Each slot is a doubly linked list owned from its
+// head through |_next|.
+@interface GMFTimerWheelEntry : NSObject {
+ @public
+  // Only compared, never messaged, so a handle outliving its wheel is harmless.
+  __unsafe_unretained GMFTimerWheel *_wheel;
+  GMFTimerWheelEntryState _state;
+  dispatch_block_t _block;
+  NSTimeInterval _deadline;
+  // Slot boundary the deadline rounds up to, counted from the wheel's origin.
+  int64_t _tick;
+  NSUInteger _sequence;
+  GMFTimerWheelEntry *_next;
+  __unsafe_unretained GMFTimerWheelEntry *_previous;
+}
+@end
+
+@implementation GMFTimerWheelEntry
+@end
+
+@implementation GMFTimerWheel {
+  __strong GMFTimerWheelEntry **_slots;
+  NSUInteger _slotMask;
+  NSTimeInterval _origin;
+  // Last tick whose timers have run.
+  int64_t _currentTick;
+  NSUInteger _nextSequence;
+  // The one timer of |clock|, set for |_wakeupTick|.
+  id _wakeupHandle;
+  int64_t _wakeupTick;
+  // Set while due timers run, so the timers they schedule don't each move the wakeup.
+  BOOL _firing;
+}
+
++ (instancetype)sharedWheel {
+  static GMFTimerWheel *sharedWheel;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+      sharedWheel = [[GMFTimerWheel alloc] init];
+  });
+  return sharedWheel;
+}
+
+- (instancetype)init {
+  return [self initWithClock:[GMFRunLoopClock sharedClock]];
+}
+
+- (instancetype)initWithClock:(id<GMFClock>)clock {
+  return [self initWithClock:clock
+                  resolution:kGMFTimerWheelDefaultResolution
+                   slotCount:kGMFTimerWheelDefaultSlotCount];
+}
+
+- (instancetype)initWithClock:(id<GMFClock>)clock
+                   resolution:(NSTimeInterval)resolution
+                    slotCount:(NSUInteger)slotCount {
+  NSAssert(resolution > 0, @"The resolution must be positive.");
+  self = [super init];
+  if (self) {
+    _clock = clock;
+    _resolution = resolution;
+    _slotCount = 1;
+    while (_slotCount < slotCount) {
+      _slotCount <<= 1;
+    }
+    _slotMask = _slotCount - 1;
+    _slots = (__strong GMFTimerWheelEntry **)calloc(_slotCount, sizeof(GMFTimerWheelEntry *));
+    _origin = [clock now];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [_clock cancelScheduledBlock:_wakeupHandle];
+  for (NSUInteger slot = 0; slot < _slotCount; slot++) {
+    for (GMFTimerWheelEntry *entry = _slots[slot]; entry; entry = entry->_next) {
+      entry->_wheel = nil;
+      entry->_state = kGMFTimerWheelEntryStateDone;
+    }
+    // Unlink iteratively; releasing a long chain from its head would recurse through it.
+    GMFTimerWheelEntry *entry = _slots[slot];
+    _slots[slot] = nil;
+    while (entry) {
+      GMFTimerWheelEntry *next = entry->_next;
+      entry->_next = nil;
+      entry = next;
+    }
+  }
+  free(_slots);
+}
+
+#pragma mark GMFClock
+
+- (NSTimeInterval)now {
+  return [_clock now];
+}
+
+- (id)scheduleBlock:(dispatch_block_t)block afterDelay:(NSTimeInterval)delay {
+  NSTimeInterval now = [_clock now];
+  if (_timerCount == 0 && !_firing) {
+    // Nothing is waiting, so the wheel can catch up without a scan.
+    _currentTick = MAX(_currentTick, [self tickAtOrBeforeTime:now]);
+  }
+  GMFTimerWheelEntry *entry = [[GMFTimerWheelEntry alloc] init];
+  entry->_wheel = self;
+  entry->_block = [block copy];
+  entry->_deadline = now + MAX(delay, 0);
+  entry->_tick = MAX([self tickAtOrAfterTime:entry->_deadline], _currentTick + 1);
+  entry->_sequence = _nextSequence++;
+  [self linkEntry:entry];
+  if (!_firing && (!_wakeupHandle || entry->_tick < _wakeupTick)) {
+    [self scheduleWakeupAtTick:entry->_tick];
+  }
+  return entry;
+}
+
+- (void)cancelScheduledBlock:(id)handle {
+  GMFTimerWheelEntry *entry = handle;
+  if (!entry || entry->_wheel != self) {
+    return;
+  }
+  if (entry->_state == kGMFTimerWheelEntryStateScheduled) {
+    [self unlinkEntry:entry];
+  }
+  entry->_state = kGMFTimerWheelEntryStateDone;
+  entry->_wheel = nil;
+  entry->_block = nil;
+  if (_timerCount == 0 && !_firing && _wakeupHandle) {
+    [_clock cancelScheduledBlock:_wakeupHandle];
+    _wakeupHandle = nil;
+  }
+}
+
+#pragma mark Private Methods
+
+- (int64_t)tickAtOrBeforeTime:(NSTimeInterval)time {
+  return (int64_t)floor((time - _origin) / _resolution + kGMFTimerWheelTickEpsilon);
+}
+
+- (int64_t)tickAtOrAfterTime:(NSTimeInterval)time {
+  return (int64_t)ceil((time - _origin) / _resolution - kGMFTimerWheelTickEpsilon);
+}
+
+- (void)linkEntry:(GMFTimerWheelEntry *)entry {
+  NSUInteger slot = (NSUInteger)entry->_tick & _slotMask;
+  GMFTimerWheelEntry *head = _slots[slot];
+  entry->_next = head;
+  if (head) {
+    head->_previous = entry;
+  }
+  _slots[slot] = entry;
+  entry->_state = kGMFTimerWheelEntryStateScheduled;
+  _timerCount++;
+}
+
+// |entry| must be kept alive by the caller; its slot may hold the only other reference.
+- (void)unlinkEntry:(GMFTimerWheelEntry *)entry {
+  GMFTimerWheelEntry *next = entry->_next;
+  if (entry->_previous) {
+    entry->_previous->_next = next;
+  } else {
+    _slots[(NSUInteger)entry->_tick & _slotMask] = next;
+  }
+  if (next) {
+    next->_previous = entry->_previous;
+  }
+  entry->_next = nil;
+  entry->_previous = nil;
+  _timerCount--;
+}
+
+- (void)scheduleWakeupAtTick:(int64_t)tick {
+  if (_wakeupHandle) {
+    if (tick == _wakeupTick) {
+      return;
+    }
+    [_clock cancelScheduledBlock:_wakeupHandle];
+  }
+  _wakeupTick = tick;
+  NSTimeInterval delay = _origin + tick * _resolution - [_clock now];
+  __weak GMFTimerWheel *weakSelf = self;
+  _wakeupHandle = [_clock scheduleBlock:^{
+      [weakSelf wakeUp];
+  } afterDelay:delay];
+}
+
+// Runs every timer whose slot has come, then sets the next wakeup.
+- (void)wakeUp {
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_VERBOSE, "timerWheel.wakeUp");
+  _wakeupHandle = nil;
+  _wakeupCount++;
+  int64_t targetTick = [self tickAtOrBeforeTime:[_clock now]];
+  NSMutableArray *dueEntries = [NSMutableArray array];
+  if (targetTick > _currentTick) {
+    // After a long sleep every slot may hold due timers, but each only needs visiting once.
+    int64_t slotsToVisit = MIN(targetTick - _currentTick, (int64_t)_slotCount);
+    for (int64_t i = 1; i <= slotsToVisit; i++) {
+      GMFTimerWheelEntry *entry = _slots[(NSUInteger)(_currentTick + i) & _slotMask];
+      while (entry) {
+        GMFTimerWheelEntry *next = entry->_next;
+        if (entry->_tick <= targetTick) {
+          [dueEntries addObject:entry];
+          [self unlinkEntry:entry];
+          entry->_state = kGMFTimerWheelEntryStateDue;
+        }
+        entry = next;
+      }
+    }
+    _currentTick = targetTick;
+  }
+  if ([dueEntries count] > 1) {
+    [dueEntries sortUsingComparator:^NSComparisonResult(GMFTimerWheelEntry *first,
+                                                        GMFTimerWheelEntry *second) {
+      if (first->_deadline != second->_deadline) {
+        return first->_deadline < second->_deadline ? NSOrderedAscending : NSOrderedDescending;
+      }
+      if (first->_sequence != second->_sequence) {
+        return first->_sequence < second->_sequence ? NSOrderedAscending : NSOrderedDescending;
+      }
+      return NSOrderedSame;
+    }];
+  }
+  _firing = YES;
+  for (GMFTimerWheelEntry *entry in dueEntries) {
+    // An earlier timer may have cancelled it.
+    if (entry->_state != kGMFTimerWheelEntryStateDue) {
+      continue;
+    }
+    dispatch_block_t block = entry->_block;
+    entry->_state = kGMFTimerWheelEntryStateDone;
+    entry->_wheel = nil;
+    entry->_block = nil;
+    _firedCount++;
+    block();
+  }
+  _firing = NO;
+  [self scheduleNextWakeup];
+}
+
+// The first slot within one turn holding a timer for that very turn is the earliest. If there is
+// none, every timer is a turn or more away and the earliest has to be searched for.
+- (void)scheduleNextWakeup {
+  if (_timerCount == 0) {
+    [_clock cancelScheduledBlock:_wakeupHandle];
+    _wakeupHandle = nil;
+    return;
+  }
+  int64_t earliestTick = INT64_MAX;
+  for (int64_t i = 1; i <= (int64_t)_slotCount; i++) {
+    int64_t tick = _currentTick + i;
+    for (GMFTimerWheelEntry *entry = _slots[(NSUInteger)tick & _slotMask]; entry;
+         entry = entry->_next) {
+      if (entry->_tick == tick) {
+        [self scheduleWakeupAtTick:tick];
+        return;
+      }
+      earliestTick = MIN(earliestTick, entry->_tick);
+    }
+  }
+  [self scheduleWakeupAtTick:earliestTick];
+}
+
+@end
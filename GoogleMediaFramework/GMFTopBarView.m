@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#import "GMFBarLayout.h"
 #import "GMFTopBarView.h"
 #import "UILabel+GMFLabels.h"
 #import "GMFResources.h"
@@ -21,6 +22,9 @@
   UILabel *_videoTitle;
   UIImageView *_logoImageView;
   NSMutableArray *_actionButtons;
+  // What the subviews' frames were last laid out for.
+  GMFTopBarLayoutInput _layoutInput;
+  BOOL _hasLayout;
 }
 
 - (id)init {
@@ -41,60 +45,9 @@
     
     _actionButtons = [[NSMutableArray alloc] init];
   }
-  
-  [self setupLayoutConstraints];
   return self;
 }
 
-- (void)setupLayoutConstraints {
-  [_videoTitle setTranslatesAutoresizingMaskIntoConstraints:NO];
-  [_logoImageView setTranslatesAutoresizingMaskIntoConstraints:NO];
-  [_backgroundView setTranslatesAutoresizingMaskIntoConstraints:NO];
-  
-  NSDictionary *viewsDictionary = NSDictionaryOfVariableBindings(_backgroundView,
-                                                                 _videoTitle,
-                                                                 _logoImageView);
-  NSDictionary *metrics = @{@"space": [NSNumber numberWithInt:4]};
-  
-  // Lay out the elements next to each other.
-  NSArray *constraints = [NSLayoutConstraint
-      constraintsWithVisualFormat:@"H:|-space-[_logoImageView]-[_videoTitle]"
-                          options:NSLayoutFormatAlignAllCenterY
-                          metrics:metrics
-                            views:viewsDictionary];
-  
-  // Make background fill the top bar.
-  constraints = [constraints arrayByAddingObjectsFromArray:
-                 [NSLayoutConstraint constraintsWithVisualFormat:@"V:|[_backgroundView]|"
-                                                         options:0
-                                                         metrics:nil
-                                                           views:viewsDictionary]];
-  
-  constraints = [constraints arrayByAddingObjectsFromArray:
-                 [NSLayoutConstraint constraintsWithVisualFormat:@"H:|[_backgroundView]|"
-                                                         options:0
-                                                         metrics:nil
-                                                           views:viewsDictionary]];
-  
-  // Make the video title take up the full height of the top bar.
-  constraints = [constraints arrayByAddingObjectsFromArray:
-                 [NSLayoutConstraint constraintsWithVisualFormat:@"V:|[_videoTitle]|"
-                                                         options:NSLayoutFormatAlignAllCenterX
-                                                         metrics:metrics
-                                                           views:viewsDictionary]];
-  
-  // Make the logo at most as wide the height of the bar.
-  constraints = [constraints arrayByAddingObject:
-                 [NSLayoutConstraint constraintWithItem:_logoImageView
-                                              attribute:NSLayoutAttributeWidth
-                                              relatedBy:NSLayoutRelationEqual
-                                                 toItem:_logoImageView.superview
-                                              attribute:NSLayoutAttributeHeight
-                                             multiplier:1.0f
-                                               constant:0.0f]];
-  [self addConstraints:constraints];
-}
-
 - (void)addActionButtonWithImage:(UIImage *)image
                             name:(NSString *)name
                           target:(id)target
@@ -108,77 +61,46 @@
   [button addTarget:target action:selector forControlEvents:UIControlEventTouchUpInside];
   [button setShowsTouchWhenHighlighted:YES];
   [button.imageView setContentMode:UIViewContentModeScaleAspectFit];
-  [button setTranslatesAutoresizingMaskIntoConstraints:NO];
   [button setAccessibilityLabel:name];
   
   [self addSubview:button];
   [_actionButtons addObject:button];
-  
-  // Create the layout constraints.
-  NSArray *constraints = [[NSArray alloc] init];
-  
-  if ([_actionButtons count] == 1) {
-    // If this is the first action button, position it in the right of the top bar.
-    constraints = [constraints arrayByAddingObject:
-                   [NSLayoutConstraint constraintWithItem:button
-                                                attribute:NSLayoutAttributeRight
-                                                relatedBy:NSLayoutRelationEqual
-                                                   toItem:button.superview
-                                                attribute:NSLayoutAttributeRight
-                                               multiplier:1.0f
-                                                 constant:-15.0f]];
-  } else {
-    // If this is not the first button, position it to the left of the previous button that has
-    // been placed.
-    UIButton *previousButton = [_actionButtons objectAtIndex:[_actionButtons count] - 2];
-    constraints = [constraints arrayByAddingObject:
-                   [NSLayoutConstraint constraintWithItem:button
-                                                attribute:NSLayoutAttributeRight
-                                                relatedBy:NSLayoutRelationEqual
-                                                   toItem:previousButton
-                                                attribute:NSLayoutAttributeLeft
-                                               multiplier:1.0f
-                                                 constant:-10.0f]];
-  }
-  
-  // Ensure that the button has the same height as the top bar.
-  constraints = [constraints arrayByAddingObject:
-                 [NSLayoutConstraint constraintWithItem:button
-                                              attribute:NSLayoutAttributeHeight
-                                              relatedBy:NSLayoutRelationEqual
-                                                 toItem:button.superview
-                                              attribute:NSLayoutAttributeHeight
-                                             multiplier:1.0f
-                                               constant:0.0f]];
-  
-  // Ensure that the button's width is equal to the top bar's height.
-  constraints = [constraints arrayByAddingObject:
-                 [NSLayoutConstraint constraintWithItem:button
-                                              attribute:NSLayoutAttributeWidth
-                                              relatedBy:NSLayoutRelationEqual
-                                                 toItem:button.superview
-                                              attribute:NSLayoutAttributeHeight
-                                             multiplier:1.0f
-                                               constant:0.0f]];
- 
-  // Ensure that the button is aligned at the bottom of the top bar.
-  constraints = [constraints arrayByAddingObject:
-                 [NSLayoutConstraint constraintWithItem:button
-                                              attribute:NSLayoutAttributeBottom
-                                              relatedBy:NSLayoutRelationEqual
-                                                 toItem:button.superview
-                                              attribute:NSLayoutAttributeBottom
-                                             multiplier:1.0f
-                                               constant:0.0f]];
-  [self addConstraints:constraints];
+  // Laid out with the rest of the bar, rather than solving for the new button right away.
+  [self setNeedsLayout];
 }
 
 - (void)setLogoImage:(UIImage *)logoImage {
   [_logoImageView setImage:logoImage];
+  [self setNeedsLayout];
 }
 
 - (void)setVideoTitle:(NSString *)videoTitle {
   [_videoTitle setText:videoTitle];
+  [self setNeedsLayout];
+}
+
+- (void)layoutSubviews {
+  [super layoutSubviews];
+  GMFTopBarLayoutInput input = {
+    [self bounds].size,
+    [[_logoImageView image] size],
+    ceil([_videoTitle sizeThatFits:CGSizeZero].width),
+    [_actionButtons count]
+  };
+  if (_hasLayout && GMFTopBarLayoutInputsEqual(input, _layoutInput)) {
+    return;
+  }
+  _layoutInput = input;
+  _hasLayout = YES;
+  CGRect *buttonFrames = malloc(MAX(input.actionButtonCount, 1) * sizeof(CGRect));
+  GMFTopBarLayout layout = GMFLayoutTopBar(input, buttonFrames);
+  [_backgroundView setFrame:layout.background];
+  [_logoImageView setFrame:layout.logo];
+  [_videoTitle setFrame:layout.title];
+  for (NSUInteger i = 0; i < input.actionButtonCount; i++) {
+    [[_actionButtons objectAtIndex:i] setFrame:buttonFrames[i]];
+  }
+  free(buttonFrames);
 }
 
 - (CGFloat)preferredHeight {
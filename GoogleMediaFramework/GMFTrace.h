@@ -0,0 +1,129 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+// Low overhead event tracing for debugging playback in the field. Events are small fixed-size
+// records written into a process-wide ring buffer of |kGMFTraceCapacity| events, so the most
+// recent history is always available and recording never allocates, locks or does I/O. The
+// buffer can be exported as Chrome trace event JSON and opened in chrome://tracing or Perfetto.
+//
+// The buffer has a single writer: events are only recorded on the main thread, where all player
+// work happens, and are dropped elsewhere. Reading and exporting are safe from any thread.
+
+#define GMF_TRACE_LEVEL_OFF 0
+// Events worth keeping in release builds: state changes, KVO callbacks, playhead ticks, observer
+// fan-out, ad events and errors.
+#define GMF_TRACE_LEVEL_INFO 1
+// Per-observer and per-consumer detail.
+#define GMF_TRACE_LEVEL_VERBOSE 2
+
+// Events above this level are compiled out. Define it in the build settings to override.
+#ifndef GMF_TRACE_LEVEL
+#if DEBUG
+#define GMF_TRACE_LEVEL GMF_TRACE_LEVEL_VERBOSE
+#else
+#define GMF_TRACE_LEVEL GMF_TRACE_LEVEL_INFO
+#endif
+#endif
+
+// Events kept; older ones are overwritten.
+#define kGMFTraceCapacity 8192
+
+typedef enum {
+  // Start and end of a span, nested per thread like function calls.
+  kGMFTracePhaseBegin = 'B',
+  kGMFTracePhaseEnd = 'E',
+  // A point in time.
+  kGMFTracePhaseInstant = 'i',
+  // A sampled value, drawn as a graph.
+  kGMFTracePhaseCounter = 'C'
+} GMFTracePhase;
+
+typedef struct {
+  // mach_absolute_time() units on Darwin, nanoseconds of CLOCK_MONOTONIC elsewhere.
+  uint64_t timestamp;
+  // Static string of the form "category.name"; the category is the part before the first dot.
+  const char *name;
+  int64_t value;
+  GMFTracePhase phase;
+} GMFTraceEvent;
+
+// Records an event. |name| must be a string literal or otherwise live forever. Prefer the
+// macros below, which compile out by level.
+extern void GMFTraceRecord(const char *name, GMFTracePhase phase, int64_t value);
+
+// Whether events are recorded at all; on by default. For turning tracing off at run time in
+// builds where it is compiled in.
+extern void GMFTraceSetEnabled(BOOL enabled);
+extern BOOL GMFTraceIsEnabled(void);
+
+// Number of events recorded since launch or the last reset, including overwritten ones.
+extern uint64_t GMFTraceRecordedCount(void);
+
+// Copies up to |maxCount| of the most recent events, oldest first, into |events| and returns
+// how many were copied. Events overwritten while copying are left out.
+extern NSUInteger GMFTraceCopyEvents(GMFTraceEvent *events, NSUInteger maxCount);
+
+// Forgets all events. Main thread only.
+extern void GMFTraceReset(void);
+
+#define GMF_TRACE_ENABLED(level) ((level) <= GMF_TRACE_LEVEL)
+
+#define GMF_TRACE_INSTANT(level, name, value)                         \
+  do {                                                                \
+    if (GMF_TRACE_ENABLED(level)) {                                   \
+      GMFTraceRecord((name), kGMFTracePhaseInstant, (int64_t)(value)); \
+    }                                                                 \
+  } while (0)
+
+#define GMF_TRACE_COUNTER(level, name, value)                         \
+  do {                                                                \
+    if (GMF_TRACE_ENABLED(level)) {                                   \
+      GMFTraceRecord((name), kGMFTracePhaseCounter, (int64_t)(value)); \
+    }                                                                 \
+  } while (0)
+
+static inline const char *GMFTraceBeginScope(BOOL enabled, const char *name) {
+  if (!enabled) {
+    return NULL;
+  }
+  GMFTraceRecord(name, kGMFTracePhaseBegin, 0);
+  return name;
+}
+
+static inline void GMFTraceEndScope(const char **name) {
+  if (*name) {
+    GMFTraceRecord(*name, kGMFTracePhaseEnd, 0);
+  }
+}
+
+#define GMF_TRACE_CONCAT_(a, b) a##b
+#define GMF_TRACE_CONCAT(a, b) GMF_TRACE_CONCAT_(a, b)
+
+// Records a span from here to the end of the enclosing scope.
+#define GMF_TRACE_SCOPE(level, name)                                               \
+  const char *GMF_TRACE_CONCAT(gmfTraceScope, __LINE__)                            \
+      __attribute__((cleanup(GMFTraceEndScope), unused)) =                         \
+          GMFTraceBeginScope(GMF_TRACE_ENABLED(level), (name))
+
+@interface GMFTraceExporter : NSObject
+
+// The buffered events as a Chrome trace event JSON object. Timestamps are in microseconds since
+// the oldest exported event, and each event's value is in its args.
++ (NSData *)chromeTraceData;
+
++ (BOOL)writeChromeTraceToPath:(NSString *)path error:(NSError **)error;
+
+@end
@@ -0,0 +1,177 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#if defined(__APPLE__)
+#import <mach/mach_time.h>
+#import <pthread.h>
+#else
+#import <time.h>
+#endif
+#import <stdatomic.h>
+#import <unistd.h>
+
+#import "GMFTrace.h"
+
+// The capacity is a power of two so a slot is the sequence number masked.
+_Static_assert((kGMFTraceCapacity & (kGMFTraceCapacity - 1)) == 0,
+               "kGMFTraceCapacity must be a power of two");
+
+// Static storage, so its pages are only committed as they are first written.
+static GMFTraceEvent gGMFTraceEvents[kGMFTraceCapacity];
+
+// Sequence number of the next event to write. Only the writer stores it; the release store
+// publishes the event written before it to readers.
+static _Atomic uint64_t gGMFTraceHead;
+
+// Sequence number of the first event after the last reset.
+static _Atomic uint64_t gGMFTraceBase;
+
+static atomic_bool gGMFTraceEnabled = true;
+
+// Darwin has cheaper calls for these than Foundation; elsewhere, e.g. when the headless tests run
+// on a Linux Foundation runtime, the portable ones do.
+static inline BOOL GMFTraceIsMainThread(void) {
+#if defined(__APPLE__)
+  return pthread_main_np();
+#else
+  return [NSThread isMainThread];
+#endif
+}
+
+static inline uint64_t GMFTraceTimestamp(void) {
+#if defined(__APPLE__)
+  return mach_absolute_time();
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+#endif
+}
+
+static double GMFTraceMicrosecondsPerTick(void) {
+#if defined(__APPLE__)
+  mach_timebase_info_data_t timebase;
+  mach_timebase_info(&timebase);
+  return (double)timebase.numer / timebase.denom / 1000;
+#else
+  return 0.001;
+#endif
+}
+
+void GMFTraceRecord(const char *name, GMFTracePhase phase, int64_t value) {
+  if (!atomic_load_explicit(&gGMFTraceEnabled, memory_order_relaxed) || !GMFTraceIsMainThread()) {
+    return;
+  }
+  uint64_t head = atomic_load_explicit(&gGMFTraceHead, memory_order_relaxed);
+  GMFTraceEvent *event = &gGMFTraceEvents[head & (kGMFTraceCapacity - 1)];
+  event->timestamp = GMFTraceTimestamp();
+  event->name = name;
+  event->value = value;
+  event->phase = phase;
+  atomic_store_explicit(&gGMFTraceHead, head + 1, memory_order_release);
+}
+
+void GMFTraceSetEnabled(BOOL enabled) {
+  atomic_store_explicit(&gGMFTraceEnabled, enabled, memory_order_relaxed);
+}
+
+BOOL GMFTraceIsEnabled(void) {
+  return atomic_load_explicit(&gGMFTraceEnabled, memory_order_relaxed);
+}
+
+uint64_t GMFTraceRecordedCount(void) {
+  return atomic_load_explicit(&gGMFTraceHead, memory_order_acquire) -
+         atomic_load_explicit(&gGMFTraceBase, memory_order_acquire);
+}
+
+NSUInteger GMFTraceCopyEvents(GMFTraceEvent *events, NSUInteger maxCount) {
+  uint64_t base = atomic_load_explicit(&gGMFTraceBase, memory_order_acquire);
+  uint64_t head = atomic_load_explicit(&gGMFTraceHead, memory_order_acquire);
+  uint64_t available = MIN(head - base, (uint64_t)kGMFTraceCapacity);
+  uint64_t first = head - MIN(available, (uint64_t)maxCount);
+  for (uint64_t sequence = first; sequence < head; sequence++) {
+    events[sequence - first] = gGMFTraceEvents[sequence & (kGMFTraceCapacity - 1)];
+  }
+  // The writer may have lapped the oldest slots while they were copied, and may be writing the
+  // slot of event |newHead| right now. Only events whose slots it hasn't reached are intact.
+  atomic_thread_fence(memory_order_acquire);
+  uint64_t newHead = atomic_load_explicit(&gGMFTraceHead, memory_order_relaxed);
+  uint64_t firstIntact = newHead + 1 > kGMFTraceCapacity ? newHead + 1 - kGMFTraceCapacity : 0;
+  if (firstIntact <= first) {
+    return (NSUInteger)(head - first);
+  }
+  if (firstIntact >= head) {
+    return 0;
+  }
+  NSUInteger dropped = (NSUInteger)(firstIntact - first);
+  NSUInteger count = (NSUInteger)(head - firstIntact);
+  memmove(events, events + dropped, count * sizeof(GMFTraceEvent));
+  return count;
+}
+
+void GMFTraceReset(void) {
+  atomic_store_explicit(&gGMFTraceBase,
+                        atomic_load_explicit(&gGMFTraceHead, memory_order_relaxed),
+                        memory_order_release);
+}
+
+@implementation GMFTraceExporter
+
++ (NSData *)chromeTraceData {
+  GMFTraceEvent *events = malloc(kGMFTraceCapacity * sizeof(GMFTraceEvent));
+  NSUInteger count = GMFTraceCopyEvents(events, kGMFTraceCapacity);
+
+  double microsecondsPerTick = GMFTraceMicrosecondsPerTick();
+  NSNumber *pid = @(getpid());
+
+  NSMutableArray *traceEvents = [NSMutableArray arrayWithCapacity:count];
+  for (NSUInteger i = 0; i < count; i++) {
+    GMFTraceEvent *event = &events[i];
+    NSString *name = @(event->name);
+    NSRange dot = [name rangeOfString:@"."];
+    NSString *category = dot.location == NSNotFound ? @"gmf" : [name substringToIndex:dot.location];
+    NSMutableDictionary *traceEvent = [NSMutableDictionary dictionaryWithDictionary:@{
+      @"name" : name,
+      @"cat" : category,
+      @"ph" : [NSString stringWithFormat:@"%c", (char)event->phase],
+      @"ts" : @((event->timestamp - events[0].timestamp) * microsecondsPerTick),
+      @"pid" : pid,
+      // Everything is recorded on the main thread.
+      @"tid" : @1
+    }];
+    if (event->phase == kGMFTracePhaseInstant) {
+      [traceEvent setObject:@"t" forKey:@"s"];
+    }
+    if (event->phase != kGMFTracePhaseEnd) {
+      [traceEvent setObject:@{ @"value" : @(event->value) } forKey:@"args"];
+    }
+    [traceEvents addObject:traceEvent];
+  }
+  free(events);
+
+  return [NSJSONSerialization dataWithJSONObject:@{
+    @"traceEvents" : traceEvents,
+    @"displayTimeUnit" : @"ms"
+  } options:0 error:NULL];
+}
+
++ (BOOL)writeChromeTraceToPath:(NSString *)path error:(NSError **)error {
+  return [[self chromeTraceData] writeToFile:path options:NSDataWritingAtomic error:error];
+}
+
+@end
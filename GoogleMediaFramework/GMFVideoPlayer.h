@@ -15,7 +15,18 @@
 #import <AVFoundation/AVFoundation.h>
 #import <UIKit/UIKit.h>
 
+#import "GMFABRController.h"
+#import "GMFAssetPreparer.h"
+#import "GMFHLSPlaylist.h"
+#import "GMFLiveLatencyController.h"
+#import "GMFMediaCache.h"
+#import "GMFMemoryGovernor.h"
 #import "GMFPlayerState.h"
+#import "GMFPlayheadEngine.h"
+#import "GMFPlaylistQueue.h"
+#import "GMFSeekEngine.h"
+#import "GMFSourceSelector.h"
+#import "GMFTimeRangeSet.h"
 
 @class GMFVideoPlayer;
 
@@ -38,25 +49,135 @@
 - (void)videoPlayer:(GMFVideoPlayer *)videoPlayer
     bufferedMediaTimeDidChangeToTime:(NSTimeInterval)time;
 
+// Called whenever the set of loaded time ranges changes. |ranges| is a snapshot the receiver may
+// keep.
+- (void)videoPlayer:(GMFVideoPlayer *)videoPlayer
+    bufferedTimeRangesDidChange:(GMFTimeRangeSet *)ranges;
+
+// Called when playlist playback moves on to |item|, which is now the playlist queue's current
+// item. Not called for the first item loaded by |loadPlaylist|.
+- (void)videoPlayer:(GMFVideoPlayer *)videoPlayer
+    didAdvanceToPlaylistItem:(GMFPlaylistItem *)item;
+
+// Called when the HLS media playlist of the current stream was loaded or refreshed. Usually
+// arrives before the item is ready to play, in time for startup decisions based on the stream
+// type.
+- (void)videoPlayer:(GMFVideoPlayer *)videoPlayer didLoadHLSPlaylist:(GMFHLSPlaylist *)playlist;
+
 @end
 
 // Handles video playback via AVPlayer classes and AVPlayerItem management. Provides a simple API
-// to control playback of media content.
-@interface GMFVideoPlayer : NSObject
+// to control playback of media content. The player state follows a GMFPlaybackStateMachine fed by
+// the AVFoundation events of the current item, which can be tested on its own against a
+// GMFSimulatedPlaybackBackend.
+//
+// Registers with the shared GMFMemoryGovernor. Under pressure it caps the forward buffer, and
+// releases its pipeline when it isn't playing: on a warning only if its rendering view is off
+// screen, on a critical level even if it is shown. |estimatedMemoryCost| is its buffered media and
+// decoded frames.
+@interface GMFVideoPlayer : NSObject<GMFMemoryPressureResponder, GMFPlayheadEngineDataSource>
 
 @property(nonatomic, weak) id<GMFVideoPlayerDelegate> delegate;
 
 @property(nonatomic, readonly) GMFPlayerState state;
 
+// Delivers media time updates while playing. Add consumers to it to receive the playhead at a
+// rate other than the delegate's |currentMediaTimeDidChangeToTime:| cadence.
+@property(nonatomic, readonly) GMFPlayheadEngine *playheadEngine;
+
+// Items played by |loadPlaylist|. The player is the queue's delegate: it loads the assets of
+// items within the look-ahead window and hands the next one to AVQueuePlayer, which buffers it
+// while the current item plays.
+@property(nonatomic, readonly) GMFPlaylistQueue *playlistQueue;
+
+// Media playlist of the current stream when it is HLS, or nil until it has loaded. For a master
+// playlist this is the first variant's, which AVPlayer starts with. Refreshed every target
+// duration while the stream is live.
+@property(nonatomic, readonly) GMFHLSPlaylist *hlsPlaylist;
+
+// Chooses the bitrate and forward buffer of the current item from transfer and buffer
+// telemetry, and applies its decisions as the item's preferred peak bitrate and forward buffer
+// duration where the OS supports them. Set its policy to change how it adapts; its estimate and
+// current decision are there for metrics. The bitrate ladder comes from the HLS master playlist;
+// without one only the peak bitrate is capped.
+@property(nonatomic, readonly) GMFABRController *abrController;
+
+// Holds live streams at its target latency behind the live edge, adjusting the playback rate
+// and jumping ahead after long stalls; seeks and pauses far behind live leave DVR playback to the
+// viewer. Set its target and bounds to tune it; its latency and histogram are there for metrics.
+// Idle for VOD and playlists.
+@property(nonatomic, readonly) GMFLiveLatencyController *liveLatencyController;
+
+// When set, HTTP(S) streams and playlist items are loaded through this cache, e.g. the shared
+// one, so replays and revisits of progressive files don't download them again. HLS playlists go
+// through it too, but their segments go straight to the network, since AVFoundation only lets a
+// resource loader serve playlists and keys. nil by default. Set it before loading; assets already
+// loading through the old cache stop getting data when it is replaced.
+@property(nonatomic, strong) GMFMediaCache *mediaCache;
+
+// Prepares the streams loaded by |loadStreamWithURL:| and the playlist items in the look-ahead
+// window off the main thread. A new load or |reset| cancels the preparation of the previous
+// stream, so a stale item never replaces the current one. Its counts and histograms are there for
+// metrics, e.g. the main thread time each load costs.
+@property(nonatomic, readonly) GMFAssetPreparer *assetPreparer;
+
+// Picks the source of streams loaded by |loadStreamWithSourceURLs:startTime:| and the one to
+// fail over to. Its host scores carry over from stream to stream and are fed by the transfers of
+// every stream played; its counts and selection latency histogram are there for metrics.
+@property(nonatomic, readonly) GMFSourceSelector *sourceSelector;
+
+// Issues the seeks of |seekToTime:| and |scrubToTime:| to the current item, coalescing them so
+// only the latest target is sought once the seek in flight completes. Its counts and latency
+// histogram are there for metrics.
+@property(nonatomic, readonly) GMFSeekEngine *seekEngine;
+
+// Whether the player has given up its decoding pipeline. Suspending detaches the current item
+// from the AVPlayer, which stops decoding and frees the decoder while the item keeps its buffer
+// and position. Resuming reattaches it at the same position and plays on if it was playing. A
+// stream loaded while suspended starts loading once resumed. Playlists keep their pipeline.
+// GMFPlayerPool sets this to cap how many players decode at once.
+@property(nonatomic, assign, getter=isDecodingSuspended) BOOL decodingSuspended;
+
+// The level last reported by the memory governor. Above normal, the forward buffer is capped
+// below what the ABR policy asks for.
+@property(nonatomic, readonly) GMFMemoryPressureLevel memoryPressureLevel;
+
+// Whether memory pressure made the player give up its pipeline. Like suspending decoding, it
+// detaches the current item and remembers its position; it also takes the player off the
+// rendering view's layer, which drops the frames the layer holds. The pipeline is rebuilt at the
+// same position by |play|, a seek, or resuming decoding. Playlists keep their pipeline.
+@property(nonatomic, readonly, getter=isPipelineReleased) BOOL pipelineReleased;
+
 // |renderingView| will only be set after the player enters the ready to play state. After calling
 // |reset|, the player discards any previously set rendering view, so if
 // you maintain a separate reference to this rendering view, it will no longer be valid for the
 // current playback.
 @property(nonatomic, readonly) UIView *renderingView;
 
+// Uses the shared GMFTimerWheel.
+- (instancetype)init;
+
+// |clock| drives the playhead engine; pass a GMFVirtualClock in tests.
+- (instancetype)initWithClock:(id<GMFClock>)clock;
+
 // Public method to play media via url.
 - (void)loadStreamWithURL:(NSURL* )url;
 
+// Loads the stream starting at |startTime|, e.g. a resume position. The item is positioned before
+// it is handed to the AVPlayer, so it buffers from there and no seek follows once it is ready.
+- (void)loadStreamWithURL:(NSURL *)url startTime:(NSTimeInterval)startTime;
+
+// Loads one of several equivalent sources of the stream, e.g. on different CDNs, starting at
+// |startTime|. |sourceSelector| probes them and the first to answer is loaded, so a slow or dead
+// CDN doesn't hold up the start. If the item then fails to load or to play on, the player
+// switches to the next source, at the position it had reached and playing if it was; the error
+// state is only entered once every source failed. A single source is loaded directly.
+- (void)loadStreamWithSourceURLs:(NSArray *)URLs startTime:(NSTimeInterval)startTime;
+
+// Loads the current item of |playlistQueue|. When an item finishes, the queue advances and the
+// next item starts playing; the player only enters the finished state once the queue runs out.
+- (void)loadPlaylist;
+
 // Reset the playback state to enable playing a new video in an existing player instance.
 - (void)reset;
 
@@ -64,13 +185,33 @@
 - (void)play;
 - (void)pause;
 - (void)replay;
+// Seeks to exactly |time|.
 - (void)seekToTime:(NSTimeInterval)time;
 
+// Seeks to a keyframe near |time|, for following the scrubber while it is dragged. Finish the
+// drag with |seekToTime:| to land on the exact frame.
+- (void)scrubToTime:(NSTimeInterval)time;
+
 // Querying the player.
 - (NSTimeInterval)currentMediaTime;
 - (NSTimeInterval)totalMediaTime;
 - (NSTimeInterval)bufferedMediaTime;
 
+// Snapshot of the loaded time ranges of the current item.
+- (GMFTimeRangeSet *)bufferedTimeRanges;
+
+// Where the current item can be positioned. For live streams this is the DVR window, which slides
+// forward as the stream grows; seeks are clamped to it. Empty until the item is ready.
+- (GMFTimeRange)seekableTimeRange;
+
+// Seeks to the live latency controller's target behind the live edge and has it hold playback
+// there again. Does nothing unless the stream is live and ready.
+- (void)seekToLive;
+
+// Whether the stream is live, with or without DVR. Decided from |hlsPlaylist| once it has
+// loaded, otherwise from the item having no duration.
+- (BOOL)isLive;
+
 @end
 
 
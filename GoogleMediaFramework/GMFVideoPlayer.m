@@ -16,18 +16,52 @@
 #error "This file requires ARC support."
 #endif
 
+#import "GMFAVPlaybackBackend.h"
+#import "GMFMediaCacheResourceLoader.h"
+#import "GMFPlaybackStateMachine.h"
+#import "GMFTimerWheel.h"
+#import "GMFTrace.h"
 #import "GMFVideoPlayer.h"
 
-static const NSTimeInterval kGMFPollingInterval = 0.2;
+// Cadence of |videoPlayer:currentMediaTimeDidChangeToTime:| while playing.
+static const NSTimeInterval kGMFMediaTimeReportingInterval = 0.2;
 
-static void *kGMFPlayerItemStatusContext = &kGMFPlayerItemStatusContext;
-static void *kGMFPlayerRateContext = &kGMFPlayerRateContext;
+// Cadence of live latency updates while playing.
+static const NSTimeInterval kGMFLiveLatencyUpdateInterval = 1;
+
+static void *kGMFPlayerItemLoadedTimeRangesContext = &kGMFPlayerItemLoadedTimeRangesContext;
 static void *kGMFPlayerDurationContext = &kGMFPlayerDurationContext;
+static void *kGMFPlayerCurrentItemContext = &kGMFPlayerCurrentItemContext;
+
+// Trace span name for a KVO callback with |context|.
+static const char *GMFTraceNameForKVOContext(void *context) {
+  if (context == kGMFPlayerItemLoadedTimeRangesContext) {
+    return "kvo.loadedTimeRanges";
+  } else if (context == kGMFPlayerDurationContext) {
+    return "kvo.duration";
+  } else if (context == kGMFPlayerCurrentItemContext) {
+    return "kvo.currentItem";
+  }
+  return "kvo.other";
+}
 
 
-static NSString * const kStatusKey = @"status";
-static NSString * const kRateKey = @"rate";
+static NSString * const kLoadedTimeRangesKey = @"loadedTimeRanges";
 static NSString * const kDurationKey = @"currentItem.duration";
+static NSString * const kCurrentItemKey = @"currentItem";
+
+// Refresh interval for live playlists without a target duration.
+static const NSTimeInterval kGMFDefaultPlaylistRefreshInterval = 5;
+
+// Forward buffer caps under memory pressure, by level.
+static const NSTimeInterval kGMFWarningForwardBufferDuration = 10;
+static const NSTimeInterval kGMFCriticalForwardBufferDuration = 4;
+
+// Bitrate assumed for the buffered media before the ABR controller or access log know better.
+static const double kGMFDefaultEstimatedBitrate = 2000000;
+
+// Decoded frames a player holds at once, counted at 4 bytes per pixel.
+static const NSUInteger kGMFEstimatedDecodedFrameCount = 3;
 
 // Pause the video if user unplugs their headphones.
 void GMFAudioRouteChangeListenerCallback(void *inClientData,
@@ -72,7 +106,10 @@ void GMFAudioRouteChangeListenerCallback(void *inClientData,
 
 #pragma mark GMFVideoPlayer
 
-@interface GMFVideoPlayer () {
+@interface GMFVideoPlayer ()<GMFABRControllerDelegate,
+                              GMFLiveLatencyControllerDelegate,
+                              GMFPlaybackStateMachineDelegate,
+                              GMFPlaylistQueueDelegate> {
   GMFPlayerLayerView *_renderingView;
 }
 
@@ -80,44 +117,167 @@ void GMFAudioRouteChangeListenerCallback(void *inClientData,
 
 @property (nonatomic, strong) AVPlayer *player;
 
-// Polling timer for content time updates.
-@property (nonatomic, strong) NSTimer *playbackStatusPoller;
+// Decides the player state from the events of |playbackBackend|.
+@property (nonatomic, strong) GMFPlaybackStateMachine *stateMachine;
+
+// |playerItem| as played by |player|; nil while there is no item.
+@property (nonatomic, strong) GMFAVPlaybackBackend *playbackBackend;
+
+// Token for the playhead engine consumer that feeds the delegate's media time callback.
+@property (nonatomic, strong) id mediaTimeConsumer;
 
-// Track content time updates so we know when playback stalls or is paused/playing.
-@property (nonatomic, assign) NSTimeInterval lastReportedPlaybackTime;
+// Token for the playhead engine consumer that feeds |liveLatencyController|.
+@property (nonatomic, strong) id liveLatencyConsumer;
 
 @property (nonatomic, assign) NSTimeInterval lastReportedBufferTime;
 
-// Allow |[_player play]| to be called before content finishes loading.
-@property (nonatomic, assign) BOOL pendingPlay;
+// Mirror of |loadedTimeRanges|, rebuilt only when AVFoundation reports a change.
+@property (nonatomic, strong) GMFTimeRangeSet *bufferedRanges;
+
+// Set by |loadPlaylist| and cleared when a single stream is loaded or the player is reset.
+@property (nonatomic, assign) BOOL playingPlaylist;
+
+// Preparation of the stream loaded by |loadStreamWithURL:|, until it delivers.
+@property (nonatomic, strong) GMFAssetPreparation *assetPreparation;
+
+// Where the stream loaded by |loadStreamWithURL:startTime:| starts.
+@property (nonatomic, assign) NSTimeInterval startTime;
+
+// Sources of the stream loaded by |loadStreamWithSourceURLs:startTime:|, nil for other loads.
+@property (nonatomic, copy) NSArray *sourceURLs;
+
+// URL of the stream loading or playing; nil for playlists.
+@property (nonatomic, strong) NSURL *sourceURL;
+
+// Preparations of playlist items, keyed by GMFPlaylistItem.
+@property (nonatomic, strong) NSMapTable *playlistPreparations;
+
+// Drives live playlist refreshes.
+@property (nonatomic, strong) id<GMFClock> clock;
+
+@property (nonatomic, strong) GMFHLSPlaylist *hlsPlaylist;
+
+// URL of the media playlist behind |hlsPlaylist|, refreshed while the stream is live.
+@property (nonatomic, strong) NSURL *hlsPlaylistURL;
+
+// Bumped whenever the stream changes, so responses for a previous stream are dropped.
+@property (nonatomic, assign) NSUInteger hlsLoadGeneration;
+
+@property (nonatomic, strong) id hlsRefreshHandle;
+
+// Totals of the access log event last reported to |abrController|, so only the transfers since
+// then are added. AVFoundation updates the last event in place until it starts a new one.
+@property (nonatomic, assign) NSUInteger accessLogEventCount;
+@property (nonatomic, assign) int64_t accessLogBytes;
+@property (nonatomic, assign) NSTimeInterval accessLogTransferDuration;
 
-// Set when pause is invoked and cleared when player enters the playing state.
-// This is used to determine, when resuming from an audio interruption such as
-// a phone call, whether the player should be resumed or it should stay in a
-// pause state.
-@property (nonatomic, assign) BOOL manuallyPaused;
+// Answers the resource loads of assets made through |mediaCache|. AVFoundation only holds it
+// weakly.
+@property (nonatomic, strong) GMFMediaCacheResourceLoader *mediaCacheLoader;
 
-// Creates an AVPlayerItem and AVPlayer instance when preparing to play a new content URL.
-- (void)handlePlayableAsset:(AVAsset *)asset;
+// Position and play intent of the item when decoding was suspended, restored on resume.
+// |hasSuspendedMediaTime| is NO if the item wasn't ready to seek yet.
+@property (nonatomic, assign) BOOL hasSuspendedMediaTime;
+@property (nonatomic, assign) NSTimeInterval suspendedMediaTime;
+@property (nonatomic, assign) BOOL resumePlaybackAfterSuspend;
+
+// Loads |URL| as the current stream. |sourceURLs| is left alone, so a failover keeps it.
+- (void)loadSourceWithURL:(NSURL *)URL startTime:(NSTimeInterval)startTime;
+
+// Loads the source picked for |loadStreamWithSourceURLs:startTime:|, or fails without one.
+- (void)sourceSelectionDidFinishWithURL:(NSURL *)URL startTime:(NSTimeInterval)startTime;
+
+// Switches to the next source after the current one failed, at the position it had reached.
+// Returns NO if there is none left to switch to.
+- (BOOL)failOverToNextSource;
+
+// Completion of the preparation started by |loadStreamWithURL:|.
+- (void)assetPreparation:(GMFAssetPreparation *)preparation
+    didFinishWithPlayerItem:(AVPlayerItem *)playerItem;
+
+// Creates an AVPlayer instance for a prepared |playerItem| of a new content URL.
+- (void)handlePlayerItem:(AVPlayerItem *)playerItem;
 
 // Updates the current |playerItem| and |player| and removes and re-adds observers.
 - (void)setAndObservePlayerItem:(AVPlayerItem *)playerItem player:(AVPlayer *)player;
 
-// Updates the internal player state and notifies the delegate.
+// Updates the current |playerItem| only, keeping the player and its rendering view.
+- (void)setAndObservePlayerItem:(AVPlayerItem *)playerItem;
+
+// Hands |playerItem| and |player| to |stateMachine| as a new |playbackBackend|.
+- (void)updatePlaybackBackend;
+
+// Starts playback of the playlist queue's current item if it is prepared.
+- (void)loadCurrentPlaylistItem;
+
+// Hands the next prepared playlist item to the AVQueuePlayer so it buffers ahead.
+- (void)queueNextPlaylistItem;
+
+// Switches to the item AVQueuePlayer advanced to.
+- (void)playerCurrentItemDidChange;
+
+// Completion of the preparation started for |item| by the playlist queue.
+- (void)playlistItem:(GMFPlaylistItem *)item
+    didFinishPreparation:(GMFAssetPreparation *)preparation
+              playerItem:(AVPlayerItem *)playerItem;
+
+// Continues loading or queues |item| once it is prepared.
+- (void)playlistItemDidFinishPreparing:(GMFPlaylistItem *)item;
+
+// Fetches and parses the HLS playlist at |URL|, following a master playlist to its first
+// variant.
+- (void)loadHLSPlaylistWithURL:(NSURL *)URL;
+
+// Adopts a loaded media playlist, or follows a master playlist to its first variant. |playlist|
+// is nil if the response wasn't a playlist.
+- (void)didLoadHLSPlaylist:(GMFHLSPlaylist *)playlist fromURL:(NSURL *)URL;
+
+// Stops any playlist load or refresh and forgets the current playlist.
+- (void)resetHLSPlaylist;
+
+// Feeds the transfers logged since the last call to |abrController|.
+- (void)playerItemDidLogAccess;
+
+// Applies the current ABR decision to |playerItem|.
+- (void)applyABRDecision;
+
+// An asset for |URL| loaded through |mediaCache| when there is one.
+- (AVURLAsset *)assetWithURL:(NSURL *)URL;
+
+// Clamps |time| to the seekable part of the stream and has |stateMachine| seek there in |mode|.
+- (void)seekToTime:(NSTimeInterval)time mode:(GMFSeekMode)mode;
+
+// Feeds the seekable window and |mediaTime| of a live stream to |liveLatencyController|.
+- (void)updateLiveLatencyWithMediaTime:(NSTimeInterval)mediaTime;
+
+// Detaches |playerItem| from |player| so it stops decoding, remembering where it was.
+- (void)detachPlayerItem;
+
+// Reattaches |playerItem| to |player| and restores the position and play intent.
+- (void)attachPlayerItem;
+
+// Detaches |playerItem| and takes |player| off the rendering view's layer.
+- (void)releasePipeline;
+
+// Undoes |releasePipeline|, unless decoding is suspended, in which case resuming it does.
+- (void)rebuildPipeline;
+
+// Whether the player is playing or about to, so memory pressure leaves its pipeline alone.
+- (BOOL)isPlaybackIntended;
+
+// Sets the state of |stateMachine|, which reports it back through
+// |stateMachine:stateDidChangeFrom:to:|.
 - (void)setState:(GMFPlayerState)state;
 
-// Starts a polling timer to track content playback state and time.
-- (void)startPlaybackStatusPoller;
+// Reports a changed buffered media time to the delegate.
+- (void)playerItemLoadedTimeRangesDidChange;
 
-// Resets the above polling timer.
-- (void)stopPlaybackStatusPoller;
+// Rebuilds |bufferedRanges| from the player item. Returns YES if the ranges changed.
+- (BOOL)updateBufferedRanges;
 
 // Handles audio session changes, such as when a user unplugs headphones.
 - (void)onAudioSessionInterruption:(NSNotification *)notification;
 
-// Handler for |playerItem| state changes.
-- (void)playerItemStatusDidChange;
-
 // Reset the player state. Readies the player to play a new content URL.
 - (void)clearPlayer;
 
@@ -132,9 +292,49 @@ void GMFAudioRouteChangeListenerCallback(void *inClientData,
 @synthesize renderingView = _renderingView;
 
 - (instancetype)init {
+  return [self initWithClock:[GMFTimerWheel sharedWheel]];
+}
+
+- (instancetype)initWithClock:(id<GMFClock>)clock {
   self = [super init];
   if (self) {
     _state = kGMFPlayerStateEmpty;
+    _clock = clock;
+    _bufferedRanges = [[GMFTimeRangeSet alloc] init];
+    _playlistPreparations = [NSMapTable strongToStrongObjectsMapTable];
+    _playlistQueue = [[GMFPlaylistQueue alloc] init];
+    [_playlistQueue setDelegate:self];
+    _abrController = [[GMFABRController alloc] init];
+    [_abrController setDelegate:self];
+    _liveLatencyController = [[GMFLiveLatencyController alloc] initWithClock:clock];
+    [_liveLatencyController setDelegate:self];
+    _memoryPressureLevel = [[GMFMemoryGovernor sharedGovernor] currentLevel];
+    [[GMFMemoryGovernor sharedGovernor] addResponder:self];
+    _assetPreparer = [[GMFAssetPreparer alloc] initWithClock:clock];
+    _sourceSelector = [[GMFSourceSelector alloc] initWithProber:[[GMFHTTPSourceProber alloc] init]
+                                                          clock:clock];
+    _stateMachine = [[GMFPlaybackStateMachine alloc] initWithClock:clock];
+    [_stateMachine setDelegate:self];
+    _seekEngine = [_stateMachine seekEngine];
+    _playheadEngine = [[GMFPlayheadEngine alloc] initWithClock:clock];
+    [_playheadEngine setDataSource:self];
+    __weak GMFVideoPlayer *weakSelf = self;
+    _mediaTimeConsumer =
+        [_playheadEngine addConsumerWithInterval:kGMFMediaTimeReportingInterval
+                                           block:^(NSTimeInterval mediaTime) {
+            GMFVideoPlayer *strongSelf = weakSelf;
+            if (!strongSelf) {
+              return;
+            }
+            [[strongSelf delegate] videoPlayer:strongSelf
+                currentMediaTimeDidChangeToTime:mediaTime];
+        }];
+    _liveLatencyConsumer =
+        [_playheadEngine addConsumerWithInterval:kGMFLiveLatencyUpdateInterval
+                                           block:^(NSTimeInterval mediaTime) {
+            [weakSelf updateLiveLatencyWithMediaTime:mediaTime];
+        }];
+
     AudioSessionAddPropertyListener(kAudioSessionProperty_AudioRouteChange,
                                     GMFAudioRouteChangeListenerCallback,
                                     (__bridge void *)self);
@@ -151,159 +351,243 @@ void GMFAudioRouteChangeListenerCallback(void *inClientData,
 #pragma mark Public playback methods
 
 - (void)play {
-  _manuallyPaused = NO;
-  if (_state == kGMFPlayerStateLoadingContent || _state == kGMFPlayerStateSeeking) {
-    _pendingPlay = YES;
-  } else if (![_player rate]) {
-    _pendingPlay = YES;
-    [_player play];
+  if (_decodingSuspended && _playerItem && ![_player currentItem]) {
+    // Played once decoding resumes.
+    _resumePlaybackAfterSuspend = YES;
+    return;
   }
+  if (_pipelineReleased) {
+    // Played once the restoring seek lands.
+    _resumePlaybackAfterSuspend = YES;
+    [self rebuildPipeline];
+    return;
+  }
+  [_stateMachine play];
 }
 
 - (void)pause {
-  _pendingPlay = NO;
-  _manuallyPaused = YES;
-  if (_state == kGMFPlayerStatePlaying ||
-      _state == kGMFPlayerStateBuffering ||
-      _state == kGMFPlayerStateSeeking) {
-    [_player pause];
-    // Setting paused state here rather than KVO observing, since the |rate|
-    // value can change to 0 because of buffer issues too.
-    [self setState:kGMFPlayerStatePaused];
-  }
+  _resumePlaybackAfterSuspend = NO;
+  [_liveLatencyController viewerDidMovePlayhead];
+  [_stateMachine pause];
 }
 
 - (void)replay {
-  _pendingPlay = YES;
+  [_stateMachine setPendingPlay:YES];
   [self seekToTime:0.0];
 }
 
 - (void)seekToTime:(NSTimeInterval)time {
-  if ([_playerItem status] != AVPlayerItemStatusReadyToPlay) {
-    // Calling [AVPlayerItem seekToTime:] before it is in the "ready to play" state
-    // causes a crash.
-    // TODO(tensafefrogs): Dev assert here instead of silent return.
+  [_liveLatencyController viewerDidMovePlayhead];
+  [self seekToTime:time mode:kGMFSeekModePrecise];
+}
+
+- (void)scrubToTime:(NSTimeInterval)time {
+  [_liveLatencyController viewerDidMovePlayhead];
+  [self seekToTime:time mode:kGMFSeekModeFast];
+}
+
+- (void)seekToLive {
+  GMFTimeRange seekableRange = [self seekableTimeRange];
+  if (![self isLive] || !(seekableRange.end > seekableRange.start)) {
     return;
   }
-  if (![self isLive]) {
-    time = MIN(MAX(time, 0), [self totalMediaTime]);
-  } else {
-    time = MAX(time, 0);
+  [_liveLatencyController updateSeekableRange:seekableRange];
+  [_liveLatencyController viewerDidMovePlayhead];
+  [self seekToTime:[_liveLatencyController liveTargetTime] mode:kGMFSeekModePrecise];
+}
+
+- (void)loadStreamWithURL:(NSURL *)URL {
+  [self loadStreamWithURL:URL startTime:0];
+}
+
+- (void)loadStreamWithURL:(NSURL *)URL startTime:(NSTimeInterval)startTime {
+  [_sourceSelector cancelSelection];
+  _sourceURLs = nil;
+  [self loadSourceWithURL:URL startTime:startTime];
+}
+
+- (void)loadStreamWithSourceURLs:(NSArray *)URLs startTime:(NSTimeInterval)startTime {
+  if ([URLs count] == 1) {
+    [self loadStreamWithURL:[URLs firstObject] startTime:startTime];
+    return;
   }
-  [self setState:kGMFPlayerStateSeeking];
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_INFO, "player.loadSources");
+  _playingPlaylist = NO;
+  _sourceURLs = [URLs copy];
+  _sourceURL = nil;
+  [_assetPreparation cancel];
+  _assetPreparation = nil;
+  [self setAndObservePlayerItem:nil player:nil];
+  [self resetHLSPlaylist];
+  [self setState:kGMFPlayerStateLoadingContent];
   __weak GMFVideoPlayer *weakSelf = self;
-  [_playerItem seekToTime:CMTimeMake(time, 1)
-        completionHandler:^(BOOL finished) {
-            GMFVideoPlayer *strongSelf = weakSelf;
-            if (!strongSelf) {
-              return;
-            }
-            if (finished) {
-              if ([strongSelf pendingPlay]) {
-                [strongSelf setPendingPlay:NO];
-                [[strongSelf player] play];
-              } else {
-                [strongSelf setState:kGMFPlayerStatePaused];
-              }
-            }
-        }];
+  [_sourceSelector selectSourceFromURLs:URLs completion:^(NSURL *URL, NSError *error) {
+      [weakSelf sourceSelectionDidFinishWithURL:URL startTime:startTime];
+  }];
 }
 
-- (void)loadStreamWithURL:(NSURL *)URL {
+- (void)loadSourceWithURL:(NSURL *)URL startTime:(NSTimeInterval)startTime {
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_INFO, "player.loadStream");
+  _playingPlaylist = NO;
+  _sourceURL = URL;
+  _startTime = startTime;
+  // Drop the previous stream right away rather than once the new one is prepared.
+  [_assetPreparation cancel];
+  [self setAndObservePlayerItem:nil player:nil];
   [self setState:kGMFPlayerStateLoadingContent];
-  AVAsset *asset = [AVAsset assetWithURL:URL];
-  [self handlePlayableAsset:asset];
+  [_abrController resetSession];
+  [_liveLatencyController reset];
+  __weak GMFVideoPlayer *weakSelf = self;
+  _assetPreparation = [_assetPreparer prepareAsset:[self assetWithURL:URL]
+                                        completion:^(GMFAssetPreparation *preparation,
+                                                     AVPlayerItem *playerItem,
+                                                     NSError *error) {
+      [weakSelf assetPreparation:preparation didFinishWithPlayerItem:playerItem];
+  }];
+  [self resetHLSPlaylist];
+  if ([[URL pathExtension] caseInsensitiveCompare:@"m3u8"] == NSOrderedSame) {
+    [self loadHLSPlaylistWithURL:URL];
+  }
+}
+
+- (void)loadPlaylist {
+  [_sourceSelector cancelSelection];
+  _sourceURLs = nil;
+  _sourceURL = nil;
+  _playingPlaylist = YES;
+  // A stream still being prepared would otherwise replace the playlist's player when it is ready.
+  [_assetPreparation cancel];
+  _assetPreparation = nil;
+  [_liveLatencyController reset];
+  // Playlist items don't use the previous stream's HLS playlist or its live refreshes.
+  [self resetHLSPlaylist];
+  [self setState:kGMFPlayerStateLoadingContent];
+  [_abrController resetSession];
+  [self loadCurrentPlaylistItem];
+}
+
+- (void)setMediaCache:(GMFMediaCache *)mediaCache {
+  _mediaCache = mediaCache;
+  _mediaCacheLoader =
+      mediaCache ? [[GMFMediaCacheResourceLoader alloc] initWithCache:mediaCache] : nil;
 }
 
 #pragma mark Querying Player for info
 
 - (NSTimeInterval)currentMediaTime {
-  return [self isPlayableState] ?
-      [GMFVideoPlayer secondsWithCMTime:[_playerItem currentTime]] : 0.0;
+  return [self isPlayableState] ? [_playbackBackend currentTime] : 0.0;
 }
 
 - (NSTimeInterval)totalMediaTime {
-  // |_playerItem| duration is 0 if the video is a live stream.
-  return [self isPlayableState] ? [GMFVideoPlayer secondsWithCMTime:[_playerItem duration]] : 0.0;
+  // The duration is 0 if the video is a live stream.
+  return [self isPlayableState] ? [_playbackBackend duration] : 0.0;
 }
 
 - (NSTimeInterval)bufferedMediaTime {
   if ([self isPlayableState]) {
-    // Call |loadedTimeRanges| before storing |currentTime| so that the
-    // loaded time ranges don't change before we get |currentTime|.
-    // This can happen while video is playing.
-    NSArray *timeRanges = [_playerItem loadedTimeRanges];
-    CMTime currentTime = [_playerItem currentTime];
-    for (NSValue *timeRange in timeRanges) {
-      CMTimeRange range;
-      [timeRange getValue:&range];
-      if (CMTimeRangeContainsTime(range, currentTime)) {
-        return [GMFVideoPlayer secondsWithCMTime:CMTimeRangeGetEnd(range)];
-      }
+    NSTimeInterval bufferedEnd = [_bufferedRanges endOfRangeContainingTime:[self currentMediaTime]];
+    if (!isnan(bufferedEnd)) {
+      return bufferedEnd;
     }
   }
   return 0;
 }
 
+- (GMFTimeRangeSet *)bufferedTimeRanges {
+  return [_bufferedRanges copy];
+}
+
+- (GMFTimeRange)seekableTimeRange {
+  return [self isPlayableState] ? [_playbackBackend seekableTimeRange] : GMFTimeRangeMake(0, 0);
+}
+
 - (BOOL)isLive {
-  // |totalMediaTime| is 0 if the video is a live stream.
-  // TODO(tensafefrogs): Is there a better way to determine if the video is live?
+  if (_hlsPlaylist) {
+    return [_hlsPlaylist isLive];
+  }
+  // Until the playlist is known, guess from |totalMediaTime|, which is 0 for live streams.
   return [self totalMediaTime] == 0.0;
 }
 
 #pragma mark Private methods
 
-// Once an asset is playable (i.e. tracks are loaded) hand it off to this method to add observers.
-- (void)handlePlayableAsset:(AVAsset *)asset {
-  AVPlayerItem *playerItem = [AVPlayerItem playerItemWithAsset:asset];
+- (void)sourceSelectionDidFinishWithURL:(NSURL *)URL startTime:(NSTimeInterval)startTime {
+  if (!URL) {
+    [self setState:kGMFPlayerStateError];
+    return;
+  }
+  [self loadSourceWithURL:URL startTime:startTime];
+}
+
+- (BOOL)failOverToNextSource {
+  if (!_sourceURLs || !_sourceURL) {
+    return NO;
+  }
+  NSURL *nextURL = [_sourceSelector failoverSourceAfterFailureOfSource:_sourceURL];
+  if (!nextURL) {
+    return NO;
+  }
+  NSTimeInterval startTime = _startTime;
+  if ([self isPlayableState]) {
+    // Live streams rejoin at the live point, since the position may not exist on another CDN.
+    startTime = [self isLive] ? 0 : [self currentMediaTime];
+  }
+  BOOL resumePlayback = [_stateMachine pendingPlay] ||
+                        _state == kGMFPlayerStatePlaying ||
+                        _state == kGMFPlayerStateBuffering ||
+                        _state == kGMFPlayerStateSeeking;
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "player.failover", [_sourceSelector failoverCount]);
+  [self loadSourceWithURL:nextURL startTime:startTime];
+  [_stateMachine setPendingPlay:resumePlayback];
+  return YES;
+}
+
+- (void)assetPreparation:(GMFAssetPreparation *)preparation
+    didFinishWithPlayerItem:(AVPlayerItem *)playerItem {
+  // A preparation replaced by a later load is cancelled and never delivers, so this only guards
+  // against a result that was already on its way.
+  if ([preparation generation] != [_assetPreparation generation]) {
+    return;
+  }
+  _assetPreparation = nil;
+  if (!playerItem) {
+    if (![self failOverToNextSource]) {
+      [self setState:kGMFPlayerStateError];
+    }
+    return;
+  }
+  if (_startTime > 0) {
+    // An item that isn't ready yet takes a seek without a completion handler, and starts there.
+    [playerItem seekToTime:CMTimeMakeWithSeconds(_startTime, NSEC_PER_SEC)];
+  }
+  [self handlePlayerItem:playerItem];
+}
+
+// Once an asset is playable (i.e. tracks are loaded) hand its item to this method to add
+// observers.
+- (void)handlePlayerItem:(AVPlayerItem *)playerItem {
   // Recreating the AVPlayer instance because of issues when playing HLS then non-HLS back to
   // back, and vice-versa.
-  AVPlayer *player = [AVPlayer playerWithPlayerItem:playerItem];
+  // While decoding is suspended the item waits to be attached by |attachPlayerItem|.
+  AVPlayer *player = [AVPlayer playerWithPlayerItem:_decodingSuspended ? nil : playerItem];
   [self setAndObservePlayerItem:playerItem player:player];
 }
 
 - (void)setAndObservePlayerItem:(AVPlayerItem *)playerItem player:(AVPlayer *)player {
-  // Player item observers.
-  [_playerItem removeObserver:self forKeyPath:kStatusKey];
-  [[NSNotificationCenter defaultCenter] removeObserver:self
-                                                  name:AVPlayerItemDidPlayToEndTimeNotification
-                                                object:_playerItem];
-
-  _playerItem = playerItem;
-  if (_playerItem) {
-    [_playerItem addObserver:self
-                  forKeyPath:kStatusKey
-                     options:0
-                     context:kGMFPlayerItemStatusContext];
-
-    __weak GMFVideoPlayer *weakSelf = self;
-    [[NSNotificationCenter defaultCenter]
-        addObserverForName:AVPlayerItemDidPlayToEndTimeNotification
-                    object:_playerItem
-                     queue:[NSOperationQueue mainQueue]
-                usingBlock:^(NSNotification *note) {
-                    GMFVideoPlayer *strongSelf = weakSelf;
-                    if (!strongSelf) {
-                      return;
-                    }
-                    [strongSelf playbackDidReachEnd];
-                }];
-  }
-
   // Player observers.
-  [_player removeObserver:self forKeyPath:kRateKey];
   [_player removeObserver:self forKeyPath:kDurationKey];
+  [_player removeObserver:self forKeyPath:kCurrentItemKey];
 
   _player = player;
   if (_player) {
-    [_player addObserver:self
-              forKeyPath:kRateKey
-                 options:0
-                 context:kGMFPlayerRateContext];
     [_player addObserver:self
               forKeyPath:kDurationKey
                  options:0
                  context:kGMFPlayerDurationContext];
+    [_player addObserver:self
+              forKeyPath:kCurrentItemKey
+                 options:0
+                 context:kGMFPlayerCurrentItemContext];
     _renderingView = [[GMFPlayerLayerView alloc] init];
     [[_renderingView playerLayer] setVideoGravity:AVLayerVideoGravityResizeAspect];
     [[_renderingView playerLayer] setBackgroundColor:[[UIColor blackColor] CGColor]];
@@ -313,37 +597,94 @@ void GMFAudioRouteChangeListenerCallback(void *inClientData,
     // necessary than to call setPlayer:nil and reuse it for future playbacks.
     _renderingView = nil;
   }
+
+  [self setAndObservePlayerItem:playerItem];
 }
 
-- (void)setState:(GMFPlayerState)state {
-  if (state != _state) {
-    GMFPlayerState prevState = _state;
-    _state = state;
+- (void)setAndObservePlayerItem:(AVPlayerItem *)playerItem {
+  // Player item observers.
+  [_playerItem removeObserver:self forKeyPath:kLoadedTimeRangesKey];
+  [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                  name:AVPlayerItemNewAccessLogEntryNotification
+                                                object:_playerItem];
 
-    // Call this last in case the delegate removes references/destroys self.
-    [_delegate videoPlayer:self stateDidChangeFrom:prevState to:state];
+  _playerItem = playerItem;
+  [self updatePlaybackBackend];
+  _accessLogEventCount = 0;
+  _accessLogBytes = 0;
+  _accessLogTransferDuration = 0;
+  if (_playerItem) {
+    [_playerItem addObserver:self
+                  forKeyPath:kLoadedTimeRangesKey
+                     options:0
+                     context:kGMFPlayerItemLoadedTimeRangesContext];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(playerItemNewAccessLogEntry:)
+                                                 name:AVPlayerItemNewAccessLogEntryNotification
+                                               object:_playerItem];
+    [self applyABRDecision];
   }
 }
 
-- (void)startPlaybackStatusPoller {
-  if (_playbackStatusPoller) {
-    return;
+- (void)updatePlaybackBackend {
+  // The previous backend stops observing once released, so a queue player that moved on to the
+  // next playlist item no longer reports the end of the previous one.
+  _playbackBackend = _playerItem ? [[GMFAVPlaybackBackend alloc] initWithPlayer:_player
+                                                                     playerItem:_playerItem]
+                                 : nil;
+  // A new backend starts at 1x; keep any live latency correction in progress, e.g. across a
+  // playlist advance.
+  [_playbackBackend setPlaybackRate:[_liveLatencyController playbackRate]];
+  [_stateMachine setBackend:_playbackBackend];
+}
+
+- (void)setState:(GMFPlayerState)state {
+  [_stateMachine setState:state];
+}
+
+#pragma mark GMFPlaybackStateMachineDelegate
+
+- (void)stateMachine:(GMFPlaybackStateMachine *)stateMachine
+    stateDidChangeFrom:(GMFPlayerState)prevState
+                    to:(GMFPlayerState)state {
+  _state = state;
+
+  // Media time only progresses while playing, so that is the only state the playhead engine
+  // needs to tick in.
+  if (state == kGMFPlayerStatePlaying) {
+    [_playheadEngine start];
+  } else {
+    [_playheadEngine stop];
+  }
+  if ((state == kGMFPlayerStatePlaying) != (prevState == kGMFPlayerStatePlaying) &&
+      [self isPlayableState]) {
+    // Report where playback stopped or resumed, e.g. at a stall, rather than on the next tick.
+    [_playheadEngine notifyDiscontinuity];
+  }
+  if (state == kGMFPlayerStateBuffering && prevState == kGMFPlayerStatePlaying) {
+    [_abrController setRebuffering:YES];
+  } else if (state != kGMFPlayerStateBuffering) {
+    [_abrController setRebuffering:NO];
   }
-  _playbackStatusPoller = [NSTimer
-      scheduledTimerWithTimeInterval:kGMFPollingInterval
-                              target:self
-                            selector:@selector(updateStateAndReportMediaTimes)
-                            userInfo:nil
-                             repeats:YES];
-  // Ensure timer fires during UI events such as scrolling.
-  [[NSRunLoop currentRunLoop] addTimer:_playbackStatusPoller
-                               forMode:NSRunLoopCommonModes];
+
+  // Call this last in case the delegate removes references/destroys self.
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_INFO, "player.stateDelegate");
+  [_delegate videoPlayer:self stateDidChangeFrom:prevState to:state];
 }
 
-- (void)stopPlaybackStatusPoller {
-  _lastReportedBufferTime = 0;
-  [_playbackStatusPoller invalidate];
-  _playbackStatusPoller = nil;
+- (void)stateMachineDidJumpInTime:(GMFPlaybackStateMachine *)stateMachine {
+  // Report the new position now rather than on the next tick.
+  [_playheadEngine notifyDiscontinuity];
+}
+
+- (BOOL)stateMachineShouldFail:(GMFPlaybackStateMachine *)stateMachine {
+  return ![self failOverToNextSource];
+}
+
+#pragma mark GMFPlayheadEngineDataSource
+
+- (NSTimeInterval)mediaTimeForPlayheadEngine:(GMFPlayheadEngine *)engine {
+  return [self currentMediaTime];
 }
 
 #pragma mark AVAudioSession notifications
@@ -363,12 +704,14 @@ void GMFAudioRouteChangeListenerCallback(void *inClientData,
   if (type == AVAudioSessionInterruptionTypeEnded &&
       flags & AVAudioSessionInterruptionOptionShouldResume &&
       _state == kGMFPlayerStatePaused &&
-      !_manuallyPaused) {
+      ![_stateMachine manuallyPaused]) {
     [self play];
   }
 }
 
 - (void)dealloc {
+  [_playheadEngine removeConsumer:_mediaTimeConsumer];
+  [_playheadEngine removeConsumer:_liveLatencyConsumer];
   [[NSNotificationCenter defaultCenter] removeObserver:self];
   AudioSessionRemovePropertyListenerWithUserData(kAudioSessionProperty_AudioRouteChange,
                                                  GMFAudioRouteChangeListenerCallback,
@@ -380,14 +723,15 @@ void GMFAudioRouteChangeListenerCallback(void *inClientData,
                       ofObject:(id)object
                         change:(NSDictionary *)change
                        context:(void *)context {
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_INFO, GMFTraceNameForKVOContext(context));
   if (context == kGMFPlayerDurationContext) {
     // Update total duration of player
     NSTimeInterval currentTotalTime = [GMFVideoPlayer secondsWithCMTime:_playerItem.duration];
     [_delegate videoPlayer:self currentTotalTimeDidChangeToTime:currentTotalTime];
-  } else if (context == kGMFPlayerItemStatusContext) {
-    [self playerItemStatusDidChange];
-  } else if (context == kGMFPlayerRateContext) {
-    [self playerRateDidChange];
+  } else if (context == kGMFPlayerItemLoadedTimeRangesContext) {
+    [self playerItemLoadedTimeRangesDidChange];
+  } else if (context == kGMFPlayerCurrentItemContext) {
+    [self playerCurrentItemDidChange];
   } else {
     [super observeValueForKeyPath:keyPath
                          ofObject:object
@@ -396,53 +740,97 @@ void GMFAudioRouteChangeListenerCallback(void *inClientData,
   }
 }
 
-- (void)playerItemStatusDidChange {
-  if ([_playerItem status] == AVPlayerItemStatusReadyToPlay &&
-      _state == kGMFPlayerStateLoadingContent) {
-    // TODO(tensafefrogs): It seems like additional AVPlayerItemStatusReadyToPlay
-    // events indicate HLS stream switching. Investigate.
-    [self setState:kGMFPlayerStateReadyToPlay];
-    if (_pendingPlay) {
-      _pendingPlay = NO;
-      // Let's buffer some more data and let the playback poller start playback.
-      [self setState:kGMFPlayerStateBuffering];
-      [self startPlaybackStatusPoller];
-    } else {
-      [self setState:kGMFPlayerStatePaused];
-    }
-  } else if ([_playerItem status] == AVPlayerItemStatusFailed) {
-    // TODO(tensafefrogs): Better error handling: [self failWithError:[_playerItem error]];
+- (void)playerItemNewAccessLogEntry:(NSNotification *)notification {
+  // Posted on an arbitrary thread.
+  __weak GMFVideoPlayer *weakSelf = self;
+  AVPlayerItem *playerItem = [notification object];
+  dispatch_async(dispatch_get_main_queue(), ^{
+      GMFVideoPlayer *strongSelf = weakSelf;
+      if ([strongSelf playerItem] == playerItem) {
+        [strongSelf playerItemDidLogAccess];
+      }
+  });
+}
+
+- (void)playerItemDidLogAccess {
+  NSArray *events = [[_playerItem accessLog] events];
+  AVPlayerItemAccessLogEvent *event = [events lastObject];
+  if (!event) {
+    return;
+  }
+  if ([events count] != _accessLogEventCount) {
+    _accessLogEventCount = [events count];
+    _accessLogBytes = 0;
+    _accessLogTransferDuration = 0;
+  }
+  int64_t bytes = [event numberOfBytesTransferred] - _accessLogBytes;
+  NSTimeInterval transferDuration = [event transferDuration] - _accessLogTransferDuration;
+  if (bytes <= 0 || transferDuration <= 0) {
+    return;
+  }
+  _accessLogBytes = [event numberOfBytesTransferred];
+  _accessLogTransferDuration = [event transferDuration];
+  [_abrController addTransferWithBytes:(uint64_t)bytes duration:transferDuration];
+  if (_sourceURL) {
+    [_sourceSelector recordTransferWithBytes:(uint64_t)bytes
+                                    duration:transferDuration
+                                  fromSource:_sourceURL];
   }
 }
 
-- (void)playerRateDidChange {
-  // TODO(tensafefrogs): Abandon rate observing since it's inconsistent between HLS
-  // and non-HLS videos. Rely on the poller.
-  if ([_player rate] > 0) {
-    [self startPlaybackStatusPoller];
-    [self setState:kGMFPlayerStatePlaying];
-  } else if ([_player rate] == 0) {
-    // TODO(shawnbuso): Is this right? Could the rate change to 0 for states other than paused (e.g. buffering)?
-    [self setState:kGMFPlayerStatePaused];
+- (void)playerItemLoadedTimeRangesDidChange {
+  if ([self updateBufferedRanges] &&
+      [_delegate respondsToSelector:@selector(videoPlayer:bufferedTimeRangesDidChange:)]) {
+    [_delegate videoPlayer:self bufferedTimeRangesDidChange:[self bufferedTimeRanges]];
+  }
+  NSTimeInterval bufferedMediaTime = [self bufferedMediaTime];
+  [_abrController updateBufferLevel:bufferedMediaTime - [self currentMediaTime]];
+  if (_lastReportedBufferTime != bufferedMediaTime) {
+    _lastReportedBufferTime = bufferedMediaTime;
+    if ([_delegate respondsToSelector:@selector(videoPlayer:bufferedMediaTimeDidChangeToTime:)]) {
+      [_delegate videoPlayer:self bufferedMediaTimeDidChangeToTime:bufferedMediaTime];
+    }
   }
 }
 
-- (void)playbackDidReachEnd {
-  if ([_playerItem status] != AVPlayerItemStatusReadyToPlay) {
-    // In some cases, |AVPlayerItemDidPlayToEndTimeNotification| is fired while
-    // the player is being initialized. Ignore such notifications.
-    return;
+- (BOOL)updateBufferedRanges {
+  NSArray *timeRanges = [_playerItem loadedTimeRanges];
+  NSUInteger count = [timeRanges count];
+  GMFTimeRange *ranges = malloc(MAX(count, 1) * sizeof(GMFTimeRange));
+  NSUInteger index = 0;
+  for (NSValue *timeRange in timeRanges) {
+    CMTimeRange range = [timeRange CMTimeRangeValue];
+    ranges[index++] = GMFTimeRangeMake([GMFVideoPlayer secondsWithCMTime:range.start],
+                                       [GMFVideoPlayer secondsWithCMTime:CMTimeRangeGetEnd(range)]);
   }
+  BOOL changed = [_bufferedRanges setRanges:ranges count:index];
+  free(ranges);
+  return changed;
+}
 
-  // Make sure we report the final media time if necessary before stopping the poller.
-  [self updateStateAndReportMediaTimes];
-  [self stopPlaybackStatusPoller];
-  [self setState:kGMFPlayerStateFinished];
-  // For HLS videos, the rate isn't set to 0 on video end, so we have to do it
-  // explicitly.
-  if ([_player rate]) {
-    [_player setRate:0];
+- (BOOL)stateMachineShouldFinish:(GMFPlaybackStateMachine *)stateMachine {
+  if (_playingPlaylist) {
+    GMFPlaylistItem *nextItem = [_playlistQueue nextItem];
+    if ([[(AVQueuePlayer *)_player items] containsObject:[nextItem preparedObject]]) {
+      // AVQueuePlayer is already moving on to the buffered next item; see
+      // |playerCurrentItemDidChange|.
+      return NO;
+    }
+    if (nextItem) {
+      // The next item isn't ready yet, so load it the slow way.
+      [_playheadEngine notifyDiscontinuity];
+      [_playlistQueue advance];
+      [_stateMachine setPendingPlay:YES];
+      [self setState:kGMFPlayerStateLoadingContent];
+      [self loadCurrentPlaylistItem];
+      if ([_delegate respondsToSelector:@selector(videoPlayer:didAdvanceToPlaylistItem:)]) {
+        [_delegate videoPlayer:self didAdvanceToPlaylistItem:nextItem];
+      }
+      return NO;
+    }
+    _playingPlaylist = NO;
   }
+  return YES;
 }
 
 - (BOOL)isPlayableState {
@@ -455,51 +843,415 @@ void GMFAudioRouteChangeListenerCallback(void *inClientData,
       _state == kGMFPlayerStateFinished;
 }
 
-- (void)updateStateAndReportMediaTimes {
-  NSTimeInterval bufferedMediaTime = [self bufferedMediaTime];
-  if (_lastReportedBufferTime != bufferedMediaTime) {
-    _lastReportedBufferTime = bufferedMediaTime;
-    [_delegate videoPlayer:self bufferedMediaTimeDidChangeToTime:bufferedMediaTime];
+#pragma mark Cleanup
+
+- (void)clearPlayer {
+  [_assetPreparation cancel];
+  _assetPreparation = nil;
+  [_sourceSelector cancelSelection];
+  _sourceURLs = nil;
+  _sourceURL = nil;
+  [_stateMachine clear];
+  _playingPlaylist = NO;
+  [_playheadEngine stop];
+  [self setAndObservePlayerItem:nil player:nil];
+  _lastReportedBufferTime = 0;
+  _hasSuspendedMediaTime = NO;
+  _resumePlaybackAfterSuspend = NO;
+  _pipelineReleased = NO;
+  [_bufferedRanges removeAllRanges];
+  [_liveLatencyController reset];
+  [self resetHLSPlaylist];
+}
+
+- (void)reset {
+  [self clearPlayer];
+  [self setState:kGMFPlayerStateEmpty];
+}
+
+#pragma mark HLS playlist
+
+- (void)loadHLSPlaylistWithURL:(NSURL *)URL {
+  NSUInteger generation = _hlsLoadGeneration;
+  __weak GMFVideoPlayer *weakSelf = self;
+  [NSURLConnection sendAsynchronousRequest:[NSURLRequest requestWithURL:URL]
+                                     queue:[NSOperationQueue mainQueue]
+                         completionHandler:^(NSURLResponse *response,
+                                             NSData *data,
+                                             NSError *error) {
+      GMFVideoPlayer *strongSelf = weakSelf;
+      if (!strongSelf || [strongSelf hlsLoadGeneration] != generation) {
+        return;
+      }
+      NSURL *playlistURL = [response URL] ?: URL;
+      GMFHLSPlaylist *previous =
+          [playlistURL isEqual:[strongSelf hlsPlaylistURL]] ? [strongSelf hlsPlaylist] : nil;
+      GMFHLSPlaylist *playlist = data ? [GMFHLSPlaylist playlistWithData:data
+                                                                  baseURL:playlistURL
+                                                         previousPlaylist:previous]
+                                      : nil;
+      [strongSelf didLoadHLSPlaylist:playlist fromURL:playlistURL];
+  }];
+}
+
+- (void)didLoadHLSPlaylist:(GMFHLSPlaylist *)playlist fromURL:(NSURL *)URL {
+  _hlsRefreshHandle = nil;
+  if (!playlist) {
+    // Not HLS after all, or unreachable; AVFoundation reports its own errors.
+    return;
+  }
+  if ([playlist isMasterPlaylist]) {
+    NSUInteger variantCount = [playlist variantCount];
+    double *bitrates = malloc(MAX(variantCount, 1) * sizeof(double));
+    for (NSUInteger i = 0; i < variantCount; i++) {
+      bitrates[i] = [playlist variantAtIndex:i].bandwidth;
+    }
+    [_abrController setBitrates:bitrates count:variantCount];
+    free(bitrates);
+    if (variantCount) {
+      [self loadHLSPlaylistWithURL:[playlist URLForVariantAtIndex:0]];
+    }
+    return;
+  }
+  _hlsPlaylist = playlist;
+  _hlsPlaylistURL = URL;
+  if ([_delegate respondsToSelector:@selector(videoPlayer:didLoadHLSPlaylist:)]) {
+    [_delegate videoPlayer:self didLoadHLSPlaylist:playlist];
+  }
+  if ([playlist isLive]) {
+    NSTimeInterval interval = [playlist targetDuration] ?: kGMFDefaultPlaylistRefreshInterval;
+    __weak GMFVideoPlayer *weakSelf = self;
+    _hlsRefreshHandle = [_clock scheduleBlock:^{
+        GMFVideoPlayer *strongSelf = weakSelf;
+        [strongSelf setHlsRefreshHandle:nil];
+        [strongSelf loadHLSPlaylistWithURL:[strongSelf hlsPlaylistURL]];
+    } afterDelay:interval];
+  }
+}
+
+- (void)resetHLSPlaylist {
+  _hlsLoadGeneration++;
+  if (_hlsRefreshHandle) {
+    [_clock cancelScheduledBlock:_hlsRefreshHandle];
+    _hlsRefreshHandle = nil;
+  }
+  _hlsPlaylist = nil;
+  _hlsPlaylistURL = nil;
+}
+
+#pragma mark Decoder suspension
+
+- (void)setDecodingSuspended:(BOOL)decodingSuspended {
+  if (decodingSuspended == _decodingSuspended) {
+    return;
+  }
+  _decodingSuspended = decodingSuspended;
+  if (_playingPlaylist) {
+    // The queue player's upcoming items would be lost with the current one.
+    return;
+  }
+  if (decodingSuspended) {
+    [self detachPlayerItem];
+  } else if (_pipelineReleased) {
+    [self rebuildPipeline];
+  } else {
+    [self attachPlayerItem];
+  }
+}
+
+- (void)detachPlayerItem {
+  if (![_player currentItem]) {
+    return;
+  }
+  _resumePlaybackAfterSuspend = [_stateMachine pendingPlay] ||
+                                _state == kGMFPlayerStatePlaying ||
+                                _state == kGMFPlayerStateBuffering;
+  _hasSuspendedMediaTime = [_playbackBackend status] == kGMFPlaybackBackendStatusReadyToPlay;
+  _suspendedMediaTime = [self currentMediaTime];
+  [_seekEngine cancel];
+  [_stateMachine setPendingPlay:NO];
+  [_player pause];
+  [_player replaceCurrentItemWithPlayerItem:nil];
+}
+
+- (void)attachPlayerItem {
+  if (!_playerItem || [_player currentItem]) {
+    return;
+  }
+  [_player replaceCurrentItemWithPlayerItem:_playerItem];
+  if (_hasSuspendedMediaTime) {
+    // Keep a play asked for since the item was detached, e.g. by |replay|.
+    [_stateMachine setPendingPlay:_resumePlaybackAfterSuspend || [_stateMachine pendingPlay]];
+    [self seekToTime:_suspendedMediaTime];
+  } else if (_resumePlaybackAfterSuspend) {
+    // Still loading; |stateMachine| starts playback once it is ready.
+    [_stateMachine setPendingPlay:YES];
+  }
+  _hasSuspendedMediaTime = NO;
+  _resumePlaybackAfterSuspend = NO;
+}
+
+#pragma mark Seeking
+
+- (void)seekToTime:(NSTimeInterval)time mode:(GMFSeekMode)mode {
+  [self rebuildPipeline];
+  GMFTimeRange seekableRange = [self seekableTimeRange];
+  if (![self isLive]) {
+    time = MIN(MAX(time, 0), [self totalMediaTime]);
+  } else if (seekableRange.end > seekableRange.start) {
+    // The DVR window slides, so its start may be well past 0.
+    time = MIN(MAX(time, seekableRange.start), seekableRange.end);
+  } else if (_hlsPlaylist) {
+    // Stay behind the live edge rather than stalling on segments that don't exist yet.
+    time = MIN(MAX(time, 0), [_hlsPlaylist seekableRange].end);
+  } else {
+    time = MAX(time, 0);
+  }
+  [_stateMachine seekToTime:time mode:mode];
+}
+
+#pragma mark Live latency
+
+- (void)updateLiveLatencyWithMediaTime:(NSTimeInterval)mediaTime {
+  if (_playingPlaylist || ![self isLive]) {
+    return;
   }
+  [_liveLatencyController updateSeekableRange:[self seekableTimeRange]];
+  [_liveLatencyController updateWithMediaTime:mediaTime];
+}
+
+#pragma mark GMFLiveLatencyControllerDelegate
 
-  if (_state != kGMFPlayerStatePlaying && _state != kGMFPlayerStateBuffering) {
+- (void)liveLatencyController:(GMFLiveLatencyController *)controller
+        didChangePlaybackRate:(float)rate {
+  [_playbackBackend setPlaybackRate:rate];
+}
+
+- (void)liveLatencyController:(GMFLiveLatencyController *)controller
+             shouldJumpToTime:(NSTimeInterval)time {
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "live.jump", (int64_t)[controller latency]);
+  // Playing on once the seek lands.
+  [_stateMachine setPendingPlay:YES];
+  [self seekToTime:time mode:kGMFSeekModePrecise];
+}
+
+#pragma mark GMFABRControllerDelegate
+
+- (void)abrController:(GMFABRController *)controller didChangeDecision:(GMFABRDecision)decision {
+  [self applyABRDecision];
+}
+
+- (void)applyABRDecision {
+  GMFABRDecision decision = [_abrController currentDecision];
+  // Both are hints AVFoundation applies on its next variant switch or segment request; 0 means
+  // no preference.
+  if ([_playerItem respondsToSelector:@selector(setPreferredPeakBitRate:)]) {
+    [_playerItem setPreferredPeakBitRate:decision.peakBitrate];
+  }
+  NSTimeInterval forwardBufferDuration = decision.forwardBufferDuration;
+  NSTimeInterval forwardBufferCap = 0;
+  if (_memoryPressureLevel == kGMFMemoryPressureLevelWarning) {
+    forwardBufferCap = kGMFWarningForwardBufferDuration;
+  } else if (_memoryPressureLevel == kGMFMemoryPressureLevelCritical) {
+    forwardBufferCap = kGMFCriticalForwardBufferDuration;
+  }
+  if (forwardBufferCap > 0) {
+    // No preference lets AVFoundation buffer far more than the cap.
+    forwardBufferDuration = forwardBufferDuration > 0 ? MIN(forwardBufferDuration, forwardBufferCap)
+                                                      : forwardBufferCap;
+  }
+  if ([_playerItem respondsToSelector:@selector(setPreferredForwardBufferDuration:)]) {
+    [_playerItem setPreferredForwardBufferDuration:forwardBufferDuration];
+  }
+}
+
+#pragma mark GMFMemoryPressureResponder
+
+- (void)trimMemoryForPressureLevel:(GMFMemoryPressureLevel)level {
+  _memoryPressureLevel = level;
+  [self applyABRDecision];
+  if (level == kGMFMemoryPressureLevelNormal || [self isPlaybackIntended]) {
     return;
   }
+  if (level == kGMFMemoryPressureLevelCritical || ![_renderingView window]) {
+    [self releasePipeline];
+  }
+}
 
-  NSTimeInterval currentMediaTime = [self currentMediaTime];
-  // If the current media time is different from the last reported media time,
-  // the player is playing.
-  if (_lastReportedPlaybackTime != currentMediaTime) {
-    _lastReportedPlaybackTime = currentMediaTime;
-    if (_state == kGMFPlayerStatePlaying) {
-      [_delegate videoPlayer:self currentMediaTimeDidChangeToTime:currentMediaTime];
-    } else {
-      // Player resumed playback from buffering state.
-      [self setState:kGMFPlayerStatePlaying];
+- (uint64_t)estimatedMemoryCost {
+  if (!_playerItem) {
+    return 0;
+  }
+  double bitrate = [_abrController currentBitrate];
+  if (bitrate <= 0) {
+    bitrate = [[[[_playerItem accessLog] events] lastObject] indicatedBitrate];
+  }
+  if (bitrate <= 0) {
+    bitrate = kGMFDefaultEstimatedBitrate;
+  }
+  // A detached item keeps its buffer, but not its decoded frames.
+  uint64_t cost = (uint64_t)([_bufferedRanges totalDuration] * bitrate / 8);
+  if ([_player currentItem] == _playerItem) {
+    CGSize size = [_playerItem presentationSize];
+    cost += (uint64_t)(size.width * size.height) * 4 * kGMFEstimatedDecodedFrameCount;
+  }
+  return cost;
+}
+
+- (void)releasePipeline {
+  if (_playingPlaylist || _pipelineReleased || !_playerItem) {
+    return;
+  }
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "memory.releasePipeline", _memoryPressureLevel);
+  [self detachPlayerItem];
+  [[_renderingView playerLayer] setPlayer:nil];
+  _pipelineReleased = YES;
+}
+
+- (void)rebuildPipeline {
+  if (!_pipelineReleased || _decodingSuspended) {
+    return;
+  }
+  _pipelineReleased = NO;
+  [[_renderingView playerLayer] setPlayer:_player];
+  [self attachPlayerItem];
+}
+
+- (BOOL)isPlaybackIntended {
+  return [_stateMachine pendingPlay] ||
+      _state == kGMFPlayerStatePlaying ||
+      _state == kGMFPlayerStateBuffering ||
+      _resumePlaybackAfterSuspend;
+}
+
+#pragma mark Playlist playback
+
+- (void)loadCurrentPlaylistItem {
+  GMFPlaylistItem *item = [_playlistQueue currentItem];
+  if (!item) {
+    _playingPlaylist = NO;
+    [self setState:kGMFPlayerStateEmpty];
+    return;
+  }
+  if ([item state] == kGMFPlaylistItemStateFailed) {
+    [self setState:kGMFPlayerStateError];
+    return;
+  }
+  if ([item state] != kGMFPlaylistItemStatePrepared) {
+    // Loading continues from |playlistItemDidFinishPreparing:|.
+    return;
+  }
+  AVQueuePlayer *player = [AVQueuePlayer queuePlayerWithItems:@[ [item preparedObject] ]];
+  [player setActionAtItemEnd:AVPlayerActionAtItemEndAdvance];
+  [self setAndObservePlayerItem:[item preparedObject] player:player];
+  [self queueNextPlaylistItem];
+}
+
+- (void)queueNextPlaylistItem {
+  if (!_playingPlaylist || ![_player isKindOfClass:[AVQueuePlayer class]]) {
+    return;
+  }
+  AVQueuePlayer *queuePlayer = (AVQueuePlayer *)_player;
+  AVPlayerItem *currentPlayerItem = [queuePlayer currentItem];
+  AVPlayerItem *nextPlayerItem = [[_playlistQueue nextItem] preparedObject];
+  // Drop anything queued after the current item that is no longer next, e.g. after a reorder.
+  for (AVPlayerItem *queuedItem in [queuePlayer items]) {
+    if (queuedItem != currentPlayerItem && queuedItem != nextPlayerItem) {
+      [queuePlayer removeItem:queuedItem];
     }
-  } else if (![_player rate]) {
-    [_player play];
+  }
+  // AVQueuePlayer starts buffering the item after the current one as soon as it is inserted.
+  if (nextPlayerItem &&
+      ![[queuePlayer items] containsObject:nextPlayerItem] &&
+      [queuePlayer canInsertItem:nextPlayerItem afterItem:currentPlayerItem]) {
+    [queuePlayer insertItem:nextPlayerItem afterItem:currentPlayerItem];
   }
 }
 
-#pragma mark Cleanup
+- (void)playerCurrentItemDidChange {
+  AVPlayerItem *currentPlayerItem = [_player currentItem];
+  if (!_playingPlaylist || !currentPlayerItem || currentPlayerItem == _playerItem) {
+    return;
+  }
+  GMFPlaylistItem *nextItem = [_playlistQueue nextItem];
+  if (currentPlayerItem != [nextItem preparedObject]) {
+    return;
+  }
+  // Gapless transition: the queue player is already rendering the next item.
+  [_playlistQueue advance];
+  [self setAndObservePlayerItem:currentPlayerItem];
+  [_playheadEngine notifyDiscontinuity];
+  [_delegate videoPlayer:self
+      currentTotalTimeDidChangeToTime:[GMFVideoPlayer secondsWithCMTime:[currentPlayerItem duration]]];
+  [self playerItemLoadedTimeRangesDidChange];
+  [_stateMachine playbackBackendBufferStatusDidChange:_playbackBackend];
+  if ([_delegate respondsToSelector:@selector(videoPlayer:didAdvanceToPlaylistItem:)]) {
+    [_delegate videoPlayer:self didAdvanceToPlaylistItem:nextItem];
+  }
+  [self queueNextPlaylistItem];
+}
 
-- (void)clearPlayer {
-  _pendingPlay = NO;
-  _manuallyPaused = NO;
-  [self stopPlaybackStatusPoller];
-  [self setAndObservePlayerItem:nil player:nil];
-  _lastReportedPlaybackTime = 0;
-  _lastReportedBufferTime = 0;
+- (void)playlistItem:(GMFPlaylistItem *)item
+    didFinishPreparation:(GMFAssetPreparation *)preparation
+              playerItem:(AVPlayerItem *)playerItem {
+  // Ignore preparations that finish after their item was prepared again.
+  if ([_playlistPreparations objectForKey:item] != preparation) {
+    return;
+  }
+  [_playlistPreparations removeObjectForKey:item];
+  if (playerItem) {
+    [_playlistQueue item:item didPrepareWithObject:playerItem];
+  } else {
+    [_playlistQueue itemDidFailToPrepare:item];
+  }
+  [self playlistItemDidFinishPreparing:item];
 }
 
-- (void)reset {
-  [self clearPlayer];
-  [self setState:kGMFPlayerStateEmpty];
+- (void)playlistItemDidFinishPreparing:(GMFPlaylistItem *)item {
+  if (!_playingPlaylist) {
+    return;
+  }
+  if (item == [_playlistQueue currentItem] && _state == kGMFPlayerStateLoadingContent &&
+      _playerItem != [item preparedObject]) {
+    [self loadCurrentPlaylistItem];
+  } else if (item == [_playlistQueue nextItem]) {
+    [self queueNextPlaylistItem];
+  }
+}
+
+#pragma mark GMFPlaylistQueueDelegate
+
+- (void)playlistQueue:(GMFPlaylistQueue *)queue prepareItem:(GMFPlaylistItem *)item {
+  __weak GMFVideoPlayer *weakSelf = self;
+  GMFAssetPreparation *itemPreparation =
+      [_assetPreparer prepareAsset:[self assetWithURL:[item URL]]
+                        completion:^(GMFAssetPreparation *preparation,
+                                     AVPlayerItem *playerItem,
+                                     NSError *error) {
+          [weakSelf playlistItem:item didFinishPreparation:preparation playerItem:playerItem];
+      }];
+  [_playlistPreparations setObject:itemPreparation forKey:item];
+}
+
+- (void)playlistQueue:(GMFPlaylistQueue *)queue cancelItem:(GMFPlaylistItem *)item {
+  [[_playlistPreparations objectForKey:item] cancel];
+  [_playlistPreparations removeObjectForKey:item];
+  // If |item| was queued in the queue player, |playlistQueueDidChangeItems:| takes it out.
+}
+
+- (void)playlistQueueDidChangeItems:(GMFPlaylistQueue *)queue {
+  [self queueNextPlaylistItem];
 }
 
 #pragma mark Utils and Misc.
 
+- (AVURLAsset *)assetWithURL:(NSURL *)URL {
+  if (_mediaCacheLoader) {
+    return [_mediaCacheLoader assetWithURL:URL];
+  }
+  return [AVURLAsset URLAssetWithURL:URL options:nil];
+}
+
 + (NSTimeInterval)secondsWithCMTime:(CMTime)t {
   return CMTIME_IS_NUMERIC(t) ? CMTimeGetSeconds(t) : 0;
 }
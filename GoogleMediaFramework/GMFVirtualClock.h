@@ -0,0 +1,32 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import "GMFClock.h"
+
+// A GMFClock whose time only moves when told to. Scheduled blocks run synchronously from
+// |advanceBy:| / |advanceTo:|, in order of their due time, with |now| set to that due time.
+// Intended for tests; never blocks or touches the run loop.
+@interface GMFVirtualClock : NSObject<GMFClock>
+
+// Number of scheduled blocks that have run. Each one stands for an OS timer wakeup.
+@property(nonatomic, readonly) NSUInteger firedCount;
+
+// Number of blocks scheduled but not yet run or cancelled.
+- (NSUInteger)pendingCount;
+
+- (void)advanceBy:(NSTimeInterval)interval;
+
+- (void)advanceTo:(NSTimeInterval)time;
+
+@end
@@ -0,0 +1,99 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFVirtualClock.h"
+
+@interface GMFVirtualClockEntry : NSObject
+
+@property(nonatomic, assign) NSTimeInterval fireTime;
+// Breaks ties between entries due at the same time so they run in scheduling order.
+@property(nonatomic, assign) NSUInteger sequence;
+@property(nonatomic, copy) dispatch_block_t block;
+
+@end
+
+@implementation GMFVirtualClockEntry
+@end
+
+@implementation GMFVirtualClock {
+  NSTimeInterval _now;
+  NSUInteger _nextSequence;
+  NSMutableArray *_entries;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _entries = [[NSMutableArray alloc] init];
+  }
+  return self;
+}
+
+- (NSTimeInterval)now {
+  return _now;
+}
+
+- (id)scheduleBlock:(dispatch_block_t)block afterDelay:(NSTimeInterval)delay {
+  GMFVirtualClockEntry *entry = [[GMFVirtualClockEntry alloc] init];
+  [entry setFireTime:_now + MAX(delay, 0)];
+  [entry setSequence:_nextSequence++];
+  [entry setBlock:block];
+  [_entries addObject:entry];
+  return entry;
+}
+
+- (void)cancelScheduledBlock:(id)handle {
+  if (handle) {
+    [_entries removeObjectIdenticalTo:handle];
+  }
+}
+
+- (NSUInteger)pendingCount {
+  return [_entries count];
+}
+
+- (void)advanceBy:(NSTimeInterval)interval {
+  [self advanceTo:_now + interval];
+}
+
+- (void)advanceTo:(NSTimeInterval)time {
+  while (YES) {
+    GMFVirtualClockEntry *next = nil;
+    for (GMFVirtualClockEntry *entry in _entries) {
+      if ([entry fireTime] > time) {
+        continue;
+      }
+      if (!next ||
+          [entry fireTime] < [next fireTime] ||
+          ([entry fireTime] == [next fireTime] && [entry sequence] < [next sequence])) {
+        next = entry;
+      }
+    }
+    if (!next) {
+      break;
+    }
+    // Remove before running so the block may schedule or cancel freely.
+    [_entries removeObjectIdenticalTo:next];
+    _now = MAX(_now, [next fireTime]);
+    _firedCount++;
+    [next block]();
+  }
+  _now = MAX(_now, time);
+}
+
+@end
@@ -0,0 +1,72 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+// Log records are compacted once there are this many times more of them than titles.
+extern const NSUInteger kGMFWatchProgressCompactionRatio;
+
+// Persistent "continue watching" positions, cheap enough to update on every media time callback.
+//
+// Each update appends a fixed-size record (a 64-bit hash of the content ID, the position and a
+// timestamp) to a memory-mapped log file, so it is a 32-byte memcpy with no system call. The file
+// is a 32-byte header followed by the records. Pages of a shared mapping belong to the kernel, so
+// positions survive the app being killed. An in-memory hash index keyed by content hash answers
+// lookups and is rebuilt by scanning the log when the store is opened; a record torn by a crash
+// ends the scan. Once the log holds |kGMFWatchProgressCompactionRatio| times more records than
+// titles, a compacted copy with one record per title is written on a background queue and
+// swapped in, carrying over the records appended meanwhile. Main thread only.
+@interface GMFWatchProgressStore : NSObject
+
+@property(nonatomic, readonly) NSString *path;
+
+// Titles with a position.
+@property(nonatomic, readonly) NSUInteger count;
+
+// Records in the log, including superseded ones.
+@property(nonatomic, readonly) NSUInteger recordCount;
+
+@property(nonatomic, readonly) NSUInteger compactionCount;
+
+@property(nonatomic, readonly, getter=isCompacting) BOOL compacting;
+
+// In the Application Support directory.
++ (instancetype)sharedStore;
+
+// Opens the log at |path|, creating it if needed. Returns nil if it can't be opened or mapped.
+- (instancetype)initWithPath:(NSString *)path;
+
+// A negative |position| removes the title.
+- (void)setPosition:(NSTimeInterval)position forContentID:(NSString *)contentID;
+
+- (void)removePositionForContentID:(NSString *)contentID;
+
+// 0 if there is no position for |contentID|.
+- (NSTimeInterval)positionForContentID:(NSString *)contentID;
+
+// Returns NO if there is no position for |contentID|. |timestamp| is when the position was set,
+// in seconds since the reference date.
+- (BOOL)getPosition:(NSTimeInterval *)position
+          timestamp:(NSTimeInterval *)timestamp
+       forContentID:(NSString *)contentID;
+
+// Starts a background compaction unless one is running, and calls |completion| on the main thread
+// once the running or started one is swapped in.
+- (void)compactWithCompletion:(dispatch_block_t)completion;
+
+// Writes the log to disk, for when the device itself might go down, e.g. before a long background
+// period. Not needed to survive the app being killed.
+- (void)synchronize;
+
+@end
@@ -0,0 +1,471 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFTrace.h"
+#import "GMFWatchProgressStore.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const NSUInteger kGMFWatchProgressCompactionRatio = 4;
+
+// Logs with fewer records are never compacted.
+static const NSUInteger kGMFWatchProgressMinimumCompactionRecordCount = 1024;
+
+// Records a new log has room for before it has to grow.
+static const NSUInteger kGMFWatchProgressInitialRecordCapacity = 4096;
+
+// "GFMW" in little-endian byte order.
+static const uint32_t kGMFWatchProgressLogMagic = 0x574D4647;
+static const uint32_t kGMFWatchProgressLogVersion = 1;
+
+static const uint64_t kGMFFNVOffsetBasis = 0xcbf29ce484222325ULL;
+static const uint64_t kGMFFNVPrime = 0x100000001b3ULL;
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint8_t reserved[24];
+} GMFWatchProgressLogHeader;
+
+// Written field by field with |check| last, so a record torn by a crash doesn't check out.
+typedef struct {
+  uint64_t contentHash;
+  // Negative for a removed title.
+  double position;
+  double timestamp;
+  uint64_t check;
+} GMFWatchProgressRecord;
+
+// Slot of the index. A zero hash marks an empty slot; content hashes are never zero.
+typedef struct {
+  uint64_t contentHash;
+  double position;
+  double timestamp;
+} GMFWatchProgressEntry;
+
+// Open addressing with linear probing, at most half full. Removed titles keep their slot with a
+// negative position until the index is rebuilt.
+typedef struct {
+  GMFWatchProgressEntry *entries;
+  NSUInteger capacity;
+  NSUInteger usedCount;
+  NSUInteger liveCount;
+} GMFWatchProgressIndex;
+
+static uint64_t GMFMixWord(uint64_t hash, uint64_t word) {
+  for (int i = 0; i < 8; i++) {
+    hash = (hash ^ (word & 0xff)) * kGMFFNVPrime;
+    word >>= 8;
+  }
+  return hash;
+}
+
+static uint64_t GMFWatchProgressRecordCheck(const GMFWatchProgressRecord *record) {
+  uint64_t positionBits;
+  uint64_t timestampBits;
+  memcpy(&positionBits, &record->position, sizeof(positionBits));
+  memcpy(&timestampBits, &record->timestamp, sizeof(timestampBits));
+  uint64_t check = GMFMixWord(kGMFFNVOffsetBasis, record->contentHash);
+  check = GMFMixWord(check, positionBits);
+  return GMFMixWord(check, timestampBits);
+}
+
+// 64-bit FNV-1a of the UTF-8 bytes, never zero.
+static uint64_t GMFContentHash(NSString *contentID) {
+  const char *bytes = [contentID UTF8String];
+  uint64_t hash = kGMFFNVOffsetBasis;
+  for (const char *byte = bytes; byte && *byte; byte++) {
+    hash = (hash ^ (uint8_t)*byte) * kGMFFNVPrime;
+  }
+  return hash ?: 1;
+}
+
+static size_t GMFWatchProgressLogSize(NSUInteger recordCapacity) {
+  return sizeof(GMFWatchProgressLogHeader) + recordCapacity * sizeof(GMFWatchProgressRecord);
+}
+
+static GMFWatchProgressEntry *GMFWatchProgressIndexFind(const GMFWatchProgressIndex *index,
+                                                        uint64_t contentHash) {
+  NSUInteger mask = index->capacity - 1;
+  for (NSUInteger slot = (NSUInteger)contentHash & mask;; slot = (slot + 1) & mask) {
+    GMFWatchProgressEntry *entry = &index->entries[slot];
+    if (entry->contentHash == contentHash || entry->contentHash == 0) {
+      return entry;
+    }
+  }
+}
+
+static void GMFWatchProgressIndexInit(GMFWatchProgressIndex *index, NSUInteger capacity) {
+  index->entries = calloc(capacity, sizeof(GMFWatchProgressEntry));
+  index->capacity = capacity;
+  index->usedCount = 0;
+  index->liveCount = 0;
+}
+
+static void GMFWatchProgressIndexSet(GMFWatchProgressIndex *index,
+                                     uint64_t contentHash,
+                                     double position,
+                                     double timestamp) {
+  if ((index->usedCount + 1) * 2 > index->capacity) {
+    GMFWatchProgressIndex grown;
+    GMFWatchProgressIndexInit(&grown, index->capacity * 2);
+    for (NSUInteger i = 0; i < index->capacity; i++) {
+      GMFWatchProgressEntry *entry = &index->entries[i];
+      if (entry->contentHash) {
+        *GMFWatchProgressIndexFind(&grown, entry->contentHash) = *entry;
+      }
+    }
+    grown.usedCount = index->usedCount;
+    grown.liveCount = index->liveCount;
+    free(index->entries);
+    *index = grown;
+  }
+  GMFWatchProgressEntry *entry = GMFWatchProgressIndexFind(index, contentHash);
+  if (!entry->contentHash) {
+    if (position < 0) {
+      return;
+    }
+    index->usedCount++;
+    entry->contentHash = contentHash;
+  } else if (entry->position >= 0) {
+    index->liveCount--;
+  }
+  if (position >= 0) {
+    index->liveCount++;
+  }
+  entry->position = position;
+  entry->timestamp = timestamp;
+}
+
+#pragma mark GMFWatchProgressStore
+
+@implementation GMFWatchProgressStore {
+  int _fileDescriptor;
+  uint8_t *_bytes;
+  size_t _mappedSize;
+  size_t _writeOffset;
+  GMFWatchProgressIndex _index;
+  dispatch_queue_t _compactionQueue;
+  NSMutableArray *_compactionCompletions;
+  // Set after a failed compaction so every update doesn't retry it.
+  NSUInteger _nextCompactionRecordCount;
+}
+
++ (instancetype)sharedStore {
+  static GMFWatchProgressStore *sharedStore;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+      NSString *directory =
+          [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory,
+                                               NSUserDomainMask,
+                                               YES) firstObject];
+      [[NSFileManager defaultManager] createDirectoryAtPath:directory
+                                withIntermediateDirectories:YES
+                                                 attributes:nil
+                                                      error:NULL];
+      sharedStore = [[GMFWatchProgressStore alloc]
+          initWithPath:[directory stringByAppendingPathComponent:@"GMFWatchProgress.log"]];
+  });
+  return sharedStore;
+}
+
+- (instancetype)initWithPath:(NSString *)path {
+  self = [super init];
+  if (self) {
+    _path = [path copy];
+    _fileDescriptor = -1;
+    _compactionQueue = dispatch_queue_create("com.google.GMFWatchProgressStore.compaction",
+                                             DISPATCH_QUEUE_SERIAL);
+    _compactionCompletions = [NSMutableArray array];
+    GMFWatchProgressIndexInit(&_index, kGMFWatchProgressInitialRecordCapacity);
+    // Left over by a compaction the app didn't live to swap in.
+    unlink([[self compactedPath] fileSystemRepresentation]);
+    if (![self openLog]) {
+      return nil;
+    }
+  }
+  return self;
+}
+
+- (void)dealloc {
+  if (_bytes) {
+    munmap(_bytes, _mappedSize);
+  }
+  if (_fileDescriptor >= 0) {
+    close(_fileDescriptor);
+  }
+  free(_index.entries);
+}
+
+- (NSUInteger)count {
+  return _index.liveCount;
+}
+
+- (void)setPosition:(NSTimeInterval)position forContentID:(NSString *)contentID {
+  if (_writeOffset + sizeof(GMFWatchProgressRecord) > _mappedSize && ![self growLog]) {
+    return;
+  }
+  uint64_t contentHash = GMFContentHash(contentID);
+  NSTimeInterval timestamp = [NSDate timeIntervalSinceReferenceDate];
+  GMFWatchProgressRecord *record = (GMFWatchProgressRecord *)(_bytes + _writeOffset);
+  record->contentHash = contentHash;
+  record->position = position;
+  record->timestamp = timestamp;
+  record->check = GMFWatchProgressRecordCheck(record);
+  _writeOffset += sizeof(GMFWatchProgressRecord);
+  _recordCount++;
+  GMFWatchProgressIndexSet(&_index, contentHash, position, timestamp);
+  if (!_compacting &&
+      _recordCount >= MAX(kGMFWatchProgressMinimumCompactionRecordCount,
+                          _nextCompactionRecordCount) &&
+      _recordCount > kGMFWatchProgressCompactionRatio * MAX(_index.liveCount, 1)) {
+    [self compactWithCompletion:nil];
+  }
+}
+
+- (void)removePositionForContentID:(NSString *)contentID {
+  [self setPosition:-1 forContentID:contentID];
+}
+
+- (NSTimeInterval)positionForContentID:(NSString *)contentID {
+  NSTimeInterval position = 0;
+  [self getPosition:&position timestamp:NULL forContentID:contentID];
+  return position;
+}
+
+- (BOOL)getPosition:(NSTimeInterval *)position
+          timestamp:(NSTimeInterval *)timestamp
+       forContentID:(NSString *)contentID {
+  const GMFWatchProgressEntry *entry =
+      GMFWatchProgressIndexFind(&_index, GMFContentHash(contentID));
+  if (!entry->contentHash || entry->position < 0) {
+    return NO;
+  }
+  if (position) {
+    *position = entry->position;
+  }
+  if (timestamp) {
+    *timestamp = entry->timestamp;
+  }
+  return YES;
+}
+
+- (void)compactWithCompletion:(dispatch_block_t)completion {
+  if (completion) {
+    [_compactionCompletions addObject:[completion copy]];
+  }
+  if (_compacting) {
+    return;
+  }
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "watchProgress.compact", _recordCount);
+  _compacting = YES;
+  // The background queue only sees this snapshot; the index and log stay main thread only.
+  NSUInteger snapshotCount = _index.liveCount;
+  NSMutableData *snapshot =
+      [NSMutableData dataWithLength:snapshotCount * sizeof(GMFWatchProgressRecord)];
+  GMFWatchProgressRecord *records = [snapshot mutableBytes];
+  NSUInteger recordIndex = 0;
+  for (NSUInteger i = 0; i < _index.capacity; i++) {
+    const GMFWatchProgressEntry *entry = &_index.entries[i];
+    if (entry->contentHash && entry->position >= 0) {
+      GMFWatchProgressRecord *record = &records[recordIndex++];
+      record->contentHash = entry->contentHash;
+      record->position = entry->position;
+      record->timestamp = entry->timestamp;
+      record->check = GMFWatchProgressRecordCheck(record);
+    }
+  }
+  size_t snapshotOffset = _writeOffset;
+  NSString *compactedPath = [self compactedPath];
+  // Leave room for as many updates again before the log has to grow.
+  NSUInteger recordCapacity = MAX(kGMFWatchProgressInitialRecordCapacity, snapshotCount * 2);
+  __weak GMFWatchProgressStore *weakSelf = self;
+  dispatch_async(_compactionQueue, ^{
+      BOOL written = [GMFWatchProgressStore writeLogAtPath:compactedPath
+                                                   records:snapshot
+                                            recordCapacity:recordCapacity];
+      dispatch_async(dispatch_get_main_queue(), ^{
+          [weakSelf finishCompactionWithLogWritten:written
+                                     snapshotCount:snapshotCount
+                                    snapshotOffset:snapshotOffset];
+      });
+  });
+}
+
+- (void)synchronize {
+  msync(_bytes, _writeOffset, MS_SYNC);
+}
+
+#pragma mark Private Methods
+
+- (NSString *)compactedPath {
+  return [_path stringByAppendingString:@".compacting"];
+}
+
+// Maps the log, starting a new one if it is missing or not a log, and rebuilds the index.
+- (BOOL)openLog {
+  _fileDescriptor = open([_path fileSystemRepresentation], O_RDWR | O_CREAT, 0600);
+  if (_fileDescriptor < 0) {
+    return NO;
+  }
+  struct stat status;
+  if (fstat(_fileDescriptor, &status) != 0) {
+    return NO;
+  }
+  size_t size = (size_t)status.st_size;
+  BOOL valid = NO;
+  if (size >= GMFWatchProgressLogSize(0)) {
+    GMFWatchProgressLogHeader header;
+    valid = pread(_fileDescriptor, &header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+            header.magic == kGMFWatchProgressLogMagic &&
+            header.version == kGMFWatchProgressLogVersion;
+  }
+  if (!valid) {
+    size = GMFWatchProgressLogSize(kGMFWatchProgressInitialRecordCapacity);
+    GMFWatchProgressLogHeader header = {kGMFWatchProgressLogMagic, kGMFWatchProgressLogVersion};
+    if (ftruncate(_fileDescriptor, 0) != 0 ||
+        ftruncate(_fileDescriptor, (off_t)size) != 0 ||
+        pwrite(_fileDescriptor, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+      return NO;
+    }
+  }
+  void *bytes = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fileDescriptor, 0);
+  if (bytes == MAP_FAILED) {
+    return NO;
+  }
+  _bytes = bytes;
+  _mappedSize = size;
+  [self rebuildIndex];
+  return YES;
+}
+
+- (void)rebuildIndex {
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_INFO, "watchProgress.rebuildIndex");
+  size_t offset = sizeof(GMFWatchProgressLogHeader);
+  NSUInteger recordCount = 0;
+  while (offset + sizeof(GMFWatchProgressRecord) <= _mappedSize) {
+    const GMFWatchProgressRecord *record = (const GMFWatchProgressRecord *)(_bytes + offset);
+    if (!record->contentHash || record->check != GMFWatchProgressRecordCheck(record)) {
+      break;
+    }
+    GMFWatchProgressIndexSet(&_index, record->contentHash, record->position, record->timestamp);
+    offset += sizeof(GMFWatchProgressRecord);
+    recordCount++;
+  }
+  _writeOffset = offset;
+  _recordCount = recordCount;
+  // Later records go where the torn one was, so the next scan gets past it.
+  if (offset + sizeof(GMFWatchProgressRecord) <= _mappedSize) {
+    memset(_bytes + offset, 0, sizeof(GMFWatchProgressRecord));
+  }
+}
+
+// Doubles the file and maps it again.
+- (BOOL)growLog {
+  size_t size = _mappedSize * 2;
+  if (ftruncate(_fileDescriptor, (off_t)size) != 0) {
+    return NO;
+  }
+  void *bytes = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fileDescriptor, 0);
+  if (bytes == MAP_FAILED) {
+    return NO;
+  }
+  munmap(_bytes, _mappedSize);
+  _bytes = bytes;
+  _mappedSize = size;
+  return YES;
+}
+
+// Runs on the compaction queue.
++ (BOOL)writeLogAtPath:(NSString *)path
+               records:(NSData *)records
+        recordCapacity:(NSUInteger)recordCapacity {
+  int fileDescriptor = open([path fileSystemRepresentation], O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fileDescriptor < 0) {
+    return NO;
+  }
+  GMFWatchProgressLogHeader header = {kGMFWatchProgressLogMagic, kGMFWatchProgressLogVersion};
+  ssize_t recordsLength = (ssize_t)[records length];
+  BOOL written =
+      ftruncate(fileDescriptor, (off_t)GMFWatchProgressLogSize(recordCapacity)) == 0 &&
+      pwrite(fileDescriptor, &header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+      pwrite(fileDescriptor, [records bytes], recordsLength, sizeof(header)) == recordsLength &&
+      fsync(fileDescriptor) == 0;
+  close(fileDescriptor);
+  return written;
+}
+
+// Appends the records logged since the snapshot to the compacted log, then replaces the log with
+// it. The index already reflects every record, so it is left alone.
+- (void)finishCompactionWithLogWritten:(BOOL)written
+                         snapshotCount:(NSUInteger)snapshotCount
+                        snapshotOffset:(size_t)snapshotOffset {
+  NSString *compactedPath = [self compactedPath];
+  int fileDescriptor = written ? open([compactedPath fileSystemRepresentation], O_RDWR) : -1;
+  struct stat status;
+  size_t tailLength = _writeOffset - snapshotOffset;
+  size_t usedSize = GMFWatchProgressLogSize(snapshotCount) + tailLength;
+  size_t size = 0;
+  void *bytes = MAP_FAILED;
+  if (fileDescriptor >= 0 && fstat(fileDescriptor, &status) == 0) {
+    size = MAX((size_t)status.st_size, usedSize + sizeof(GMFWatchProgressRecord));
+    if (ftruncate(fileDescriptor, (off_t)size) == 0) {
+      bytes = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    }
+  }
+  BOOL swapped = NO;
+  if (bytes != MAP_FAILED) {
+    memcpy((uint8_t *)bytes + GMFWatchProgressLogSize(snapshotCount),
+           _bytes + snapshotOffset,
+           tailLength);
+    swapped =
+        rename([compactedPath fileSystemRepresentation], [_path fileSystemRepresentation]) == 0;
+  }
+  if (swapped) {
+    munmap(_bytes, _mappedSize);
+    close(_fileDescriptor);
+    _fileDescriptor = fileDescriptor;
+    _bytes = bytes;
+    _mappedSize = size;
+    _writeOffset = usedSize;
+    _recordCount = snapshotCount + tailLength / sizeof(GMFWatchProgressRecord);
+    _nextCompactionRecordCount = 0;
+    _compactionCount++;
+  } else {
+    // Keep the log as it is, and don't try again until it has doubled.
+    if (bytes != MAP_FAILED) {
+      munmap(bytes, size);
+    }
+    if (fileDescriptor >= 0) {
+      close(fileDescriptor);
+    }
+    unlink([compactedPath fileSystemRepresentation]);
+    _nextCompactionRecordCount = _recordCount * 2;
+  }
+  _compacting = NO;
+  NSArray *completions = [_compactionCompletions copy];
+  [_compactionCompletions removeAllObjects];
+  for (dispatch_block_t completion in completions) {
+    completion();
+  }
+}
+
+@end
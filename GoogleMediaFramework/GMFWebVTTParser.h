@@ -0,0 +1,73 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <Foundation/Foundation.h>
+
+// A caption cue, shown for media times in [startTime, endTime).
+@interface GMFCaptionCue : NSObject
+
+// Nil if the cue has no identifier line.
+@property(nonatomic, readonly) NSString *identifier;
+
+@property(nonatomic, readonly) NSTimeInterval startTime;
+@property(nonatomic, readonly) NSTimeInterval endTime;
+
+// Payload lines joined by newlines, with markup tags removed and character references decoded.
+@property(nonatomic, readonly) NSString *text;
+
+// Cue settings after the end time, e.g. "line:0 align:start", or nil if there are none.
+@property(nonatomic, readonly) NSString *settings;
+
+- (instancetype)initWithStartTime:(NSTimeInterval)startTime
+                          endTime:(NSTimeInterval)endTime
+                             text:(NSString *)text;
+
+- (instancetype)initWithIdentifier:(NSString *)identifier
+                         startTime:(NSTimeInterval)startTime
+                           endTime:(NSTimeInterval)endTime
+                              text:(NSString *)text
+                          settings:(NSString *)settings;
+
+// Cues with the same times and text are equal, e.g. a cue repeated in consecutive segments of a
+// segmented track.
+- (BOOL)isEqual:(id)object;
+
+@end
+
+// Streaming WebVTT parser. Bytes can be appended in chunks of any size as they arrive: complete
+// lines are parsed in place, and each cue goes to the cue handler as soon as the blank line
+// ending it is seen. Only a partial last line is copied, until the rest of it arrives.
+//
+// Consecutive files, such as the segments of an HLS subtitle playlist, are parsed by calling
+// |finishFile| after each one. A file's X-TIMESTAMP-MAP header ties its cue times to the MPEG-2
+// timestamps of the media: the first map seen is taken to line the cues up with the media as they
+// are, and the cues of later files are shifted by how far their map moved on from it, across the
+// 33-bit timestamp rollover. NOTE, STYLE and REGION blocks are skipped.
+@interface GMFWebVTTParser : NSObject
+
+// Cues handed to the cue handler.
+@property(nonatomic, readonly) NSUInteger cueCount;
+
+// Files skipped for not starting with WEBVTT.
+@property(nonatomic, readonly) NSUInteger invalidFileCount;
+
+- (instancetype)initWithCueHandler:(void (^)(GMFCaptionCue *cue))cueHandler;
+
+- (void)appendData:(NSData *)data;
+
+// Parses the rest of the current file, even without a final line break, and expects a new file
+// to follow.
+- (void)finishFile;
+
+@end
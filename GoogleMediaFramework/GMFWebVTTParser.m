@@ -0,0 +1,421 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(__has_feature) || !__has_feature(objc_arc)
+#error "This file requires ARC support."
+#endif
+
+#import "GMFWebVTTParser.h"
+
+static const char kGMFWebVTTSignature[] = "WEBVTT";
+static const char kGMFUTF8ByteOrderMark[] = "\xEF\xBB\xBF";
+
+// MPEG-2 timestamps count a 90 kHz clock in 33 bits.
+static const double kGMFMPEGTimestampFrequency = 90000;
+static const uint64_t kGMFMPEGTimestampMask = (1ULL << 33) - 1;
+
+typedef enum {
+  // Expecting the WEBVTT line of a new file.
+  kGMFWebVTTStateSignature,
+  // Header lines, up to the first blank line.
+  kGMFWebVTTStateHeader,
+  // Between blocks.
+  kGMFWebVTTStateIdle,
+  // After a cue identifier, expecting the timing line.
+  kGMFWebVTTStateTiming,
+  kGMFWebVTTStatePayload,
+  // Rest of a NOTE, STYLE or REGION block, or of a block that isn't a cue.
+  kGMFWebVTTStateSkippedBlock,
+  // Rest of a file that doesn't start with WEBVTT.
+  kGMFWebVTTStateSkippedFile
+} GMFWebVTTState;
+
+#pragma mark Byte scanning
+
+#define GMF_HAS_PREFIX(p, end, prefix) \
+  ((size_t)((end) - (p)) >= sizeof(prefix) - 1 && memcmp((p), (prefix), sizeof(prefix) - 1) == 0)
+
+static const char *GMFSkipSpaces(const char *p, const char *end) {
+  while (p < end && (*p == ' ' || *p == '\t')) {
+    p++;
+  }
+  return p;
+}
+
+// Whether |p| starts with |keyword| followed by a space, a tab or the end of the line.
+static BOOL GMFHasKeyword(const char *p, const char *end, const char *keyword, size_t length) {
+  return (size_t)(end - p) >= length && memcmp(p, keyword, length) == 0 &&
+         (p + length == end || p[length] == ' ' || p[length] == '\t');
+}
+
+static const char *GMFFindArrow(const char *p, const char *end) {
+  while (end - p >= 3) {
+    const char *dash = memchr(p, '-', (size_t)(end - p - 2));
+    if (!dash) {
+      return NULL;
+    }
+    if (dash[1] == '-' && dash[2] == '>') {
+      return dash;
+    }
+    p = dash + 1;
+  }
+  return NULL;
+}
+
+static uint64_t GMFParseUnsigned(const char *p, const char *end, const char **next) {
+  uint64_t value = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    value = value * 10 + (uint64_t)(*p - '0');
+    p++;
+  }
+  if (next) {
+    *next = p;
+  }
+  return value;
+}
+
+// Parses a WebVTT timestamp, "hh:mm:ss.ttt" or "mm:ss.ttt", starting at |p|. Returns NO if |p|
+// doesn't start with a digit.
+static BOOL GMFParseTimestamp(const char *p,
+                              const char *end,
+                              const char **next,
+                              NSTimeInterval *seconds) {
+  if (p == end || *p < '0' || *p > '9') {
+    return NO;
+  }
+  NSTimeInterval value = (NSTimeInterval)GMFParseUnsigned(p, end, &p);
+  while (p < end && *p == ':') {
+    value = value * 60 + (NSTimeInterval)GMFParseUnsigned(p + 1, end, &p);
+  }
+  if (p < end && *p == '.') {
+    NSTimeInterval scale = 0.1;
+    for (p++; p < end && *p >= '0' && *p <= '9'; p++) {
+      value += (*p - '0') * scale;
+      scale *= 0.1;
+    }
+  }
+  if (next) {
+    *next = p;
+  }
+  *seconds = value;
+  return YES;
+}
+
+// Decodes a character reference starting at the '&' at |p| into |out|. Returns the length of the
+// reference, or 0 if it isn't one of the references captions use.
+static size_t GMFDecodeCharacterReference(const char *p,
+                                          const char *end,
+                                          char *out,
+                                          size_t *outLength) {
+  static const struct {
+    const char *reference;
+    const char *bytes;
+  } kReferences[] = {
+    {"&amp;", "&"}, {"&lt;", "<"}, {"&gt;", ">"}, {"&quot;", "\""}, {"&apos;", "'"},
+    {"&nbsp;", "\xC2\xA0"}, {"&lrm;", "\xE2\x80\x8E"}, {"&rlm;", "\xE2\x80\x8F"},
+  };
+  for (size_t i = 0; i < sizeof(kReferences) / sizeof(kReferences[0]); i++) {
+    size_t length = strlen(kReferences[i].reference);
+    if ((size_t)(end - p) >= length && memcmp(p, kReferences[i].reference, length) == 0) {
+      *outLength = strlen(kReferences[i].bytes);
+      memcpy(out, kReferences[i].bytes, *outLength);
+      return length;
+    }
+  }
+  return 0;
+}
+
+// Strips the tags of a cue payload and decodes its character references, in place. Neither ever
+// makes the text longer, so the output never overtakes the input. Returns the new length.
+static size_t GMFStripCueMarkup(char *bytes, size_t length) {
+  const char *p = bytes;
+  const char *end = bytes + length;
+  char *out = bytes;
+  while (p < end) {
+    if (*p == '<') {
+      const char *close = memchr(p, '>', (size_t)(end - p));
+      p = close ? close + 1 : end;
+    } else if (*p == '&') {
+      char decoded[3];
+      size_t decodedLength = 0;
+      size_t referenceLength = GMFDecodeCharacterReference(p, end, decoded, &decodedLength);
+      if (referenceLength) {
+        memcpy(out, decoded, decodedLength);
+        out += decodedLength;
+        p += referenceLength;
+      } else {
+        *out++ = *p++;
+      }
+    } else {
+      *out++ = *p++;
+    }
+  }
+  return (size_t)(out - bytes);
+}
+
+@implementation GMFCaptionCue
+
+- (instancetype)initWithStartTime:(NSTimeInterval)startTime
+                          endTime:(NSTimeInterval)endTime
+                             text:(NSString *)text {
+  return [self initWithIdentifier:nil
+                        startTime:startTime
+                          endTime:endTime
+                             text:text
+                         settings:nil];
+}
+
+- (instancetype)initWithIdentifier:(NSString *)identifier
+                         startTime:(NSTimeInterval)startTime
+                           endTime:(NSTimeInterval)endTime
+                              text:(NSString *)text
+                          settings:(NSString *)settings {
+  self = [super init];
+  if (self) {
+    _identifier = [identifier copy];
+    _startTime = startTime;
+    _endTime = endTime;
+    _text = [text copy] ?: @"";
+    _settings = [settings copy];
+  }
+  return self;
+}
+
+- (BOOL)isEqual:(id)object {
+  if (object == self) {
+    return YES;
+  }
+  if (![object isKindOfClass:[GMFCaptionCue class]]) {
+    return NO;
+  }
+  GMFCaptionCue *cue = object;
+  return cue->_startTime == _startTime && cue->_endTime == _endTime &&
+         [cue->_text isEqualToString:_text];
+}
+
+- (NSUInteger)hash {
+  return [_text hash] ^ (NSUInteger)llround(_startTime * 1000);
+}
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@ %.3f --> %.3f %@>",
+                                    [self class], _startTime, _endTime, _text];
+}
+
+@end
+
+@implementation GMFWebVTTParser {
+  void (^_cueHandler)(GMFCaptionCue *cue);
+  GMFWebVTTState _state;
+  // Start of a line that the data appended so far ends in the middle of.
+  NSMutableData *_partialLine;
+
+  // The cue being parsed.
+  NSString *_cueIdentifier;
+  NSTimeInterval _cueStartTime;
+  NSTimeInterval _cueEndTime;
+  NSString *_cueSettings;
+  NSMutableData *_cuePayload;
+
+  // Shift of the current file's cue times, from its X-TIMESTAMP-MAP.
+  NSTimeInterval _fileTimeOffset;
+  // First X-TIMESTAMP-MAP seen.
+  BOOL _hasTimestampOrigin;
+  uint64_t _originMPEGTimestamp;
+  NSTimeInterval _originLocalTime;
+}
+
+- (instancetype)initWithCueHandler:(void (^)(GMFCaptionCue *cue))cueHandler {
+  self = [super init];
+  if (self) {
+    _cueHandler = [cueHandler copy];
+    _state = kGMFWebVTTStateSignature;
+    _partialLine = [NSMutableData data];
+    _cuePayload = [NSMutableData data];
+  }
+  return self;
+}
+
+- (void)appendData:(NSData *)data {
+  const char *line = [data bytes];
+  const char *end = line + [data length];
+  while (line < end) {
+    const char *newline = memchr(line, '\n', (size_t)(end - line));
+    if (!newline) {
+      [_partialLine appendBytes:line length:(NSUInteger)(end - line)];
+      return;
+    }
+    if ([_partialLine length]) {
+      [_partialLine appendBytes:line length:(NSUInteger)(newline - line)];
+      [self parseLine:[_partialLine bytes] end:(const char *)[_partialLine bytes] +
+                                               [_partialLine length]];
+      [_partialLine setLength:0];
+    } else {
+      [self parseLine:line end:newline];
+    }
+    line = newline + 1;
+  }
+}
+
+- (void)finishFile {
+  if ([_partialLine length]) {
+    [self parseLine:[_partialLine bytes] end:(const char *)[_partialLine bytes] +
+                                             [_partialLine length]];
+    [_partialLine setLength:0];
+  }
+  // A blank line ends the last cue.
+  const char *blankLine = "";
+  [self parseLine:blankLine end:blankLine];
+  _state = kGMFWebVTTStateSignature;
+  _fileTimeOffset = 0;
+}
+
+#pragma mark Private Methods
+
+- (void)parseLine:(const char *)line end:(const char *)end {
+  if (end > line && end[-1] == '\r') {
+    end--;
+  }
+  BOOL blank = end == line;
+  switch (_state) {
+    case kGMFWebVTTStateSignature:
+      if (GMF_HAS_PREFIX(line, end, kGMFUTF8ByteOrderMark)) {
+        line += sizeof(kGMFUTF8ByteOrderMark) - 1;
+      }
+      if (GMFHasKeyword(line, end, kGMFWebVTTSignature, sizeof(kGMFWebVTTSignature) - 1)) {
+        _state = kGMFWebVTTStateHeader;
+      } else {
+        _state = kGMFWebVTTStateSkippedFile;
+        _invalidFileCount++;
+      }
+      break;
+    case kGMFWebVTTStateHeader:
+      if (blank) {
+        _state = kGMFWebVTTStateIdle;
+      } else if (GMF_HAS_PREFIX(line, end, "X-TIMESTAMP-MAP=")) {
+        [self parseTimestampMap:line + sizeof("X-TIMESTAMP-MAP=") - 1 end:end];
+      }
+      break;
+    case kGMFWebVTTStateIdle:
+      if (blank) {
+        break;
+      }
+      if (GMFFindArrow(line, end)) {
+        _cueIdentifier = nil;
+        [self parseTiming:line end:end];
+      } else if (GMFHasKeyword(line, end, "NOTE", 4) || GMFHasKeyword(line, end, "STYLE", 5) ||
+                 GMFHasKeyword(line, end, "REGION", 6)) {
+        _state = kGMFWebVTTStateSkippedBlock;
+      } else {
+        _cueIdentifier = [[NSString alloc] initWithBytes:line
+                                                  length:(NSUInteger)(end - line)
+                                                encoding:NSUTF8StringEncoding];
+        _state = kGMFWebVTTStateTiming;
+      }
+      break;
+    case kGMFWebVTTStateTiming:
+      if (blank) {
+        _state = kGMFWebVTTStateIdle;
+      } else if (GMFFindArrow(line, end)) {
+        [self parseTiming:line end:end];
+      } else {
+        _state = kGMFWebVTTStateSkippedBlock;
+      }
+      break;
+    case kGMFWebVTTStatePayload:
+      if (blank) {
+        [self emitCue];
+        _state = kGMFWebVTTStateIdle;
+      } else {
+        if ([_cuePayload length]) {
+          [_cuePayload appendBytes:"\n" length:1];
+        }
+        [_cuePayload appendBytes:line length:(NSUInteger)(end - line)];
+      }
+      break;
+    case kGMFWebVTTStateSkippedBlock:
+      if (blank) {
+        _state = kGMFWebVTTStateIdle;
+      }
+      break;
+    case kGMFWebVTTStateSkippedFile:
+      break;
+  }
+}
+
+// "00:01.000 --> 00:04.000 line:0 align:start". A malformed timing line skips its block.
+- (void)parseTiming:(const char *)line end:(const char *)end {
+  const char *arrow = GMFFindArrow(line, end);
+  const char *p = GMFSkipSpaces(line, arrow);
+  NSTimeInterval startTime = 0;
+  NSTimeInterval endTime = 0;
+  if (!GMFParseTimestamp(p, arrow, NULL, &startTime) ||
+      !GMFParseTimestamp(GMFSkipSpaces(arrow + 3, end), end, &p, &endTime)) {
+    _state = kGMFWebVTTStateSkippedBlock;
+    return;
+  }
+  p = GMFSkipSpaces(p, end);
+  _cueStartTime = startTime + _fileTimeOffset;
+  _cueEndTime = endTime + _fileTimeOffset;
+  _cueSettings = p < end ? [[NSString alloc] initWithBytes:p
+                                                    length:(NSUInteger)(end - p)
+                                                  encoding:NSUTF8StringEncoding]
+                         : nil;
+  [_cuePayload setLength:0];
+  _state = kGMFWebVTTStatePayload;
+}
+
+// "MPEGTS:900000,LOCAL:00:00:00.000", in either order.
+- (void)parseTimestampMap:(const char *)p end:(const char *)end {
+  uint64_t MPEGTimestamp = 0;
+  NSTimeInterval localTime = 0;
+  while (p < end) {
+    if (GMF_HAS_PREFIX(p, end, "MPEGTS:")) {
+      MPEGTimestamp = GMFParseUnsigned(p + sizeof("MPEGTS:") - 1, end, &p);
+    } else if (GMF_HAS_PREFIX(p, end, "LOCAL:")) {
+      GMFParseTimestamp(p + sizeof("LOCAL:") - 1, end, &p, &localTime);
+    }
+    const char *comma = memchr(p, ',', (size_t)(end - p));
+    p = comma ? comma + 1 : end;
+  }
+  if (!_hasTimestampOrigin) {
+    _hasTimestampOrigin = YES;
+    _originMPEGTimestamp = MPEGTimestamp;
+    _originLocalTime = localTime;
+  }
+  uint64_t elapsed = (MPEGTimestamp - _originMPEGTimestamp) & kGMFMPEGTimestampMask;
+  _fileTimeOffset = elapsed / kGMFMPEGTimestampFrequency - (localTime - _originLocalTime);
+}
+
+- (void)emitCue {
+  char *bytes = [_cuePayload mutableBytes];
+  size_t length = GMFStripCueMarkup(bytes, [_cuePayload length]);
+  NSString *text = [[NSString alloc] initWithBytes:bytes
+                                            length:length
+                                          encoding:NSUTF8StringEncoding];
+  GMFCaptionCue *cue = [[GMFCaptionCue alloc] initWithIdentifier:_cueIdentifier
+                                                       startTime:_cueStartTime
+                                                         endTime:_cueEndTime
+                                                            text:text
+                                                        settings:_cueSettings];
+  _cueIdentifier = nil;
+  _cueSettings = nil;
+  [_cuePayload setLength:0];
+  _cueCount++;
+  if (_cueHandler) {
+    _cueHandler(cue);
+  }
+}
+
+@end
@@ -13,9 +13,42 @@
 // limitations under the License.
 
 // Public header files for use by apps using this framework
+#import "GMFABRController.h"
+#import "GMFABRSimulator.h"
+#import "GMFAdBreakScheduler.h"
+#import "GMFAdResponseCache.h"
 #import "GMFAdService.h"
+#import "GMFAssetPreparer.h"
+#import "GMFBandwidthEstimator.h"
+#import "GMFBarLayout.h"
+#import "GMFCaptionIndex.h"
+#import "GMFCaptionTrack.h"
+#import "GMFClock.h"
+#import "GMFHLSPlaylist.h"
 #import "GMFIMASDKAdService.h"
+#import "GMFLatencyHistogram.h"
+#import "GMFLiveLatencyController.h"
+#import "GMFMediaCache.h"
+#import "GMFMediaCacheResourceLoader.h"
+#import "GMFMemoryGovernor.h"
+#import "GMFPlaybackBackend.h"
+#import "GMFPlaybackStateMachine.h"
 #import "GMFPlayerFinishReason.h"
+#import "GMFPlayerObserverRegistry.h"
+#import "GMFPlayerPool.h"
 #import "GMFPlayerState.h"
 #import "GMFPlayerViewController.h"
+#import "GMFPlayheadEngine.h"
+#import "GMFPlaylistQueue.h"
+#import "GMFQoEMonitor.h"
+#import "GMFSeekEngine.h"
+#import "GMFSourceSelector.h"
+#import "GMFThumbnailCache.h"
+#import "GMFThumbnailImageLoader.h"
+#import "GMFThumbnailIndex.h"
+#import "GMFTimeRangeSet.h"
+#import "GMFTimerWheel.h"
+#import "GMFTrace.h"
 #import "GMFVideoPlayer.h"
+#import "GMFWatchProgressStore.h"
+#import "GMFWebVTTParser.h"
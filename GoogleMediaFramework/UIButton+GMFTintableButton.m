@@ -13,7 +13,7 @@
 // limitations under the License.
 
 #import "UIButton+GMFTintableButton.h"
-#import "UIImage+GMFTintableImage.h"
+#import "GMFResources.h"
 
 @implementation UIButton (GMFTintableButton)
 
@@ -23,7 +23,7 @@
     return;
   }
   
-  UIImage *tintedImage = [self.imageView.image GMF_createTintedImage:color];
+  UIImage *tintedImage = [GMFResources tintedImage:self.imageView.image color:color];
   [self setImage:tintedImage forState:UIControlStateNormal];
 }
 
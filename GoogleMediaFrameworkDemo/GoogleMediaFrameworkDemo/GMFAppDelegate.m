@@ -18,6 +18,8 @@
 @implementation GMFAppDelegate
 
 - (BOOL)application:(UIApplication *)application didFinishLaunchingWithOptions:(NSDictionary *)launchOptions {
+  // Decode the player controls in the background before the first video is opened.
+  [GMFPlayerViewController preloadResources];
 
   // For the purposes of this sample app, we are using a NavigationController to display
   // a few video and ad options.
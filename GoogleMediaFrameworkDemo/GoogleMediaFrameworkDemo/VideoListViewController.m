@@ -232,6 +232,14 @@
     [self.videoPlayerViewController loadStreamWithURL:[NSURL URLWithString:video.videoURL]];
   }
 
+  // (Optional): Resolve the next video's ads while this one plays, so its pre-roll starts at once.
+  if (indexPath.row + 1 < [_videos count]) {
+    VideoData *nextVideo = [_videos objectAtIndex:indexPath.row + 1];
+    if (nextVideo.adTagURL != nil) {
+      [GMFPlayerViewController prefetchAdsWithIMATag:nextVideo.adTagURL];
+    }
+  }
+
   // Show the video player.
   [self showVideoPlayer];
   
@@ -0,0 +1,301 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFABRController.h>
+#import <GoogleMediaFramework/GMFABRSimulator.h>
+#import <GoogleMediaFramework/GMFBandwidthEstimator.h>
+
+// A typical HLS ladder, in bits per second.
+static const double kLadder[] = { 235000, 375000, 750000, 1750000, 3000000, 5800000 };
+static const NSUInteger kLadderCount = sizeof(kLadder) / sizeof(kLadder[0]);
+
+// Recorded traces, "<seconds> <kbps>" per line.
+static NSString *const kSteadyTrace = @"60 4000\n";
+static NSString *const kCellularTrace =
+    @"# Commute on a cellular network.\n"
+    @"20 2500\n10 600\n15 1800\n5 200\n30 3000\n10 900\n";
+static NSString *const kDropTrace = @"60 6000\n30 400\n";
+static NSString *const kOutageTrace = @"40 5000\n8 0\n";
+
+// Always asks for the highest variant, i.e. no adaptation.
+@interface GMFHighestBitratePolicy : NSObject<GMFABRPolicy>
+@end
+
+@implementation GMFHighestBitratePolicy
+
+- (GMFABRDecision)decisionWithStatus:(const GMFABRStatus *)status
+                            bitrates:(const double *)bitrates
+                               count:(NSUInteger)count
+                    previousDecision:(GMFABRDecision)previousDecision {
+  GMFABRDecision decision = kGMFABRDecisionNone;
+  decision.variantIndex = count - 1;
+  decision.peakBitrate = bitrates[count - 1];
+  return decision;
+}
+
+@end
+
+@interface GMFABRControllerTests : XCTestCase<GMFABRControllerDelegate>
+@end
+
+@implementation GMFABRControllerTests {
+ @private
+  GMFABRController *_controller;
+  NSUInteger _decisionCount;
+  GMFABRDecision _lastDecision;
+}
+
+- (void)setUp {
+  [super setUp];
+  _controller = [[GMFABRController alloc] init];
+  [_controller setDelegate:self];
+  _decisionCount = 0;
+}
+
+- (void)tearDown {
+  _controller = nil;
+  [super tearDown];
+}
+
+- (void)abrController:(GMFABRController *)controller didChangeDecision:(GMFABRDecision)decision {
+  _decisionCount++;
+  _lastDecision = decision;
+}
+
+- (GMFABRStatus)statusWithEstimate:(double)estimate
+                       bufferLevel:(NSTimeInterval)bufferLevel
+                maximumBufferLevel:(NSTimeInterval)maximumBufferLevel {
+  GMFABRStatus status;
+  status.estimatedBitrate = estimate;
+  status.hasEstimate = YES;
+  status.bufferLevel = bufferLevel;
+  status.maximumBufferLevel = maximumBufferLevel;
+  status.rebuffering = NO;
+  return status;
+}
+
+- (GMFABRDecision)decisionWithPolicy:(id<GMFABRPolicy>)policy
+                              status:(GMFABRStatus)status
+                       previousIndex:(NSUInteger)previousIndex {
+  GMFABRDecision previous = kGMFABRDecisionNone;
+  previous.variantIndex = previousIndex;
+  return [policy decisionWithStatus:&status
+                           bitrates:kLadder
+                              count:kLadderCount
+                   previousDecision:previous];
+}
+
+#pragma mark GMFBandwidthEstimator
+
+- (void)testEstimatorFollowsDropsQuickly {
+  GMFBandwidthEstimator *estimator = [[GMFBandwidthEstimator alloc] init];
+  XCTAssertFalse([estimator hasEstimate]);
+  XCTAssertEqual([estimator estimatedBitrate], [estimator defaultEstimate]);
+
+  for (NSUInteger i = 0; i < 10; i++) {
+    XCTAssertTrue([estimator addSampleWithBytes:2000000 / 8 duration:1]);
+  }
+  XCTAssertEqualWithAccuracy([estimator estimatedBitrate], 2000000, 1);
+
+  for (NSUInteger i = 0; i < 3; i++) {
+    [estimator addSampleWithBytes:500000 / 8 duration:1];
+  }
+  // The fast average has moved most of the way down after three seconds.
+  XCTAssertLessThan([estimator estimatedBitrate], 1100000);
+  XCTAssertGreaterThan([estimator estimatedBitrate], 500000);
+}
+
+- (void)testEstimatorIgnoresSmallTransfers {
+  GMFBandwidthEstimator *estimator = [[GMFBandwidthEstimator alloc] init];
+
+  XCTAssertFalse([estimator addSampleWithBytes:1000 duration:0.001]);
+  XCTAssertFalse([estimator addSampleWithBytes:100000 duration:0]);
+  XCTAssertEqual([estimator sampleCount], (NSUInteger)0);
+
+  [estimator addSampleWithBytes:1000000 / 8 duration:1];
+  XCTAssertEqualWithAccuracy([estimator estimatedBitrate], 1000000, 1);
+  [estimator reset];
+  XCTAssertFalse([estimator hasEstimate]);
+}
+
+#pragma mark Policies
+
+- (void)testThroughputPolicyLeavesHeadroom {
+  GMFThroughputABRPolicy *policy = [[GMFThroughputABRPolicy alloc] init];
+  GMFABRStatus status = [self statusWithEstimate:2500000 bufferLevel:0 maximumBufferLevel:0];
+
+  GMFABRDecision decision = [self decisionWithPolicy:policy status:status previousIndex:NSNotFound];
+
+  XCTAssertEqual(decision.variantIndex, (NSUInteger)3);
+  XCTAssertEqual(decision.peakBitrate, 1750000.0);
+}
+
+- (void)testBufferPolicyUsesThroughputDuringStartup {
+  GMFBufferABRPolicy *policy = [[GMFBufferABRPolicy alloc] init];
+  GMFABRStatus status = [self statusWithEstimate:2500000 bufferLevel:0 maximumBufferLevel:0];
+
+  GMFABRDecision decision = [self decisionWithPolicy:policy status:status previousIndex:NSNotFound];
+
+  XCTAssertEqual(decision.variantIndex, (NSUInteger)3);
+  XCTAssertEqual(decision.forwardBufferDuration, [policy reservoir] + [policy cushion]);
+}
+
+- (void)testBufferPolicyMapsBufferLevelOntoLadder {
+  GMFBufferABRPolicy *policy = [[GMFBufferABRPolicy alloc] init];
+  NSTimeInterval full = [policy reservoir] + [policy cushion];
+  // A low estimate, so only the buffer can raise the bitrate.
+  double estimate = 300000;
+
+  GMFABRStatus drained = [self statusWithEstimate:estimate bufferLevel:5 maximumBufferLevel:full];
+  XCTAssertEqual([self decisionWithPolicy:policy status:drained previousIndex:4].variantIndex,
+                 (NSUInteger)0);
+
+  GMFABRStatus filled = [self statusWithEstimate:estimate bufferLevel:full maximumBufferLevel:full];
+  XCTAssertEqual([self decisionWithPolicy:policy status:filled previousIndex:0].variantIndex,
+                 kLadderCount - 1);
+
+  // Halfway up the cushion maps to about 3 Mbps.
+  GMFABRStatus half = [self statusWithEstimate:estimate bufferLevel:19 maximumBufferLevel:full];
+  XCTAssertEqual([self decisionWithPolicy:policy status:half previousIndex:0].variantIndex,
+                 (NSUInteger)4);
+}
+
+- (void)testBufferPolicyHysteresis {
+  GMFBufferABRPolicy *policy = [[GMFBufferABRPolicy alloc] init];
+  NSTimeInterval full = [policy reservoir] + [policy cushion];
+  // 18 seconds maps to about 2.76 Mbps, between the 1.75 and 3 Mbps variants.
+  GMFABRStatus status = [self statusWithEstimate:300000 bufferLevel:18 maximumBufferLevel:full];
+
+  XCTAssertEqual([self decisionWithPolicy:policy status:status previousIndex:4].variantIndex,
+                 (NSUInteger)4);
+  XCTAssertEqual([self decisionWithPolicy:policy status:status previousIndex:2].variantIndex,
+                 (NSUInteger)3);
+}
+
+- (void)testBufferPolicyDropsToLowestWhileRebuffering {
+  GMFBufferABRPolicy *policy = [[GMFBufferABRPolicy alloc] init];
+  GMFABRStatus status = [self statusWithEstimate:5000000 bufferLevel:20 maximumBufferLevel:30];
+  status.rebuffering = YES;
+
+  XCTAssertEqual([self decisionWithPolicy:policy status:status previousIndex:5].variantIndex,
+                 (NSUInteger)0);
+}
+
+- (void)testPoliciesCapPeakBitrateWithoutLadder {
+  GMFABRStatus status = [self statusWithEstimate:2000000 bufferLevel:10 maximumBufferLevel:10];
+
+  GMFABRDecision decision = [[[GMFBufferABRPolicy alloc] init] decisionWithStatus:&status
+                                                                         bitrates:NULL
+                                                                            count:0
+                                                                 previousDecision:kGMFABRDecisionNone];
+
+  XCTAssertEqual(decision.variantIndex, (NSUInteger)NSNotFound);
+  XCTAssertEqualWithAccuracy(decision.peakBitrate, 1600000, 1);
+}
+
+#pragma mark GMFABRController
+
+- (void)testControllerReportsOnlyChangedDecisions {
+  double unsorted[] = { 3000000, 235000, 750000 };
+  [_controller setBitrates:unsorted count:3];
+  XCTAssertEqual([_controller bitrateAtIndex:0], 235000.0);
+  XCTAssertEqual(_decisionCount, (NSUInteger)1);
+
+  [_controller addTransferWithBytes:5000000 / 8 duration:1];
+  XCTAssertEqual(_lastDecision.variantIndex, (NSUInteger)2);
+  XCTAssertEqual([_controller currentBitrate], 3000000.0);
+  NSUInteger decisionCount = _decisionCount;
+
+  [_controller updateBufferLevel:2];
+  [_controller updateBufferLevel:2.5];
+  XCTAssertEqual(_decisionCount, decisionCount);
+
+  [_controller setRebuffering:YES];
+  XCTAssertEqual(_lastDecision.variantIndex, (NSUInteger)0);
+  XCTAssertEqual([_controller switchCount], (NSUInteger)2);
+}
+
+- (void)testResetSessionKeepsEstimate {
+  [_controller addTransferWithBytes:5000000 / 8 duration:1];
+  [_controller updateBufferLevel:12];
+
+  [_controller resetSession];
+
+  XCTAssertEqual([_controller bufferLevel], 0.0);
+  XCTAssertEqual([_controller bitrateCount], (NSUInteger)0);
+  XCTAssertTrue([[_controller estimator] hasEstimate]);
+  XCTAssertEqualWithAccuracy([_controller estimatedBitrate], 5000000, 1);
+}
+
+#pragma mark GMFABRSimulator
+
+- (void)testTraceParsing {
+  GMFBandwidthTrace *trace = [GMFBandwidthTrace traceWithString:kCellularTrace];
+
+  XCTAssertEqual([trace count], (NSUInteger)6);
+  XCTAssertEqual([trace totalDuration], 90.0);
+  XCTAssertEqual([trace bitrateAtTime:25], 600000.0);
+  // Loops back to the start.
+  XCTAssertEqual([trace bitrateAtTime:95], 2500000.0);
+  // 2.5 Mbit in the first second, then 6 Mbit at 600 kbps.
+  XCTAssertEqualWithAccuracy([trace transferDurationForBits:8500000 startingAtTime:19], 11, 1e-9);
+  XCTAssertNil([GMFBandwidthTrace traceWithString:@"10 fast\n"]);
+  XCTAssertNil([GMFBandwidthTrace traceWithString:@"# empty\n"]);
+}
+
+- (void)testSimulatorComparesPolicies {
+  GMFABRSimulator *simulator = [[GMFABRSimulator alloc] initWithBitrates:kLadder count:kLadderCount];
+  NSArray *traces = @[ kSteadyTrace, kCellularTrace, kDropTrace, kOutageTrace ];
+  NSArray *policies = @[ [[GMFThroughputABRPolicy alloc] init],
+                         [[GMFBufferABRPolicy alloc] init],
+                         [[GMFHighestBitratePolicy alloc] init] ];
+  GMFABRSimulationResult results[4][3];
+  for (NSUInteger t = 0; t < [traces count]; t++) {
+    GMFBandwidthTrace *trace = [GMFBandwidthTrace traceWithString:traces[t]];
+    for (NSUInteger p = 0; p < [policies count]; p++) {
+      GMFABRSimulationResult result = [simulator runWithTrace:trace policy:policies[p]];
+      NSLog(@"Trace %lu, %@: startup %.2fs, rebuffer ratio %.4f, average bitrate %.0f kbps, "
+            @"%lu switches.",
+            (unsigned long)t,
+            NSStringFromClass([policies[p] class]),
+            result.startupDelay,
+            result.rebufferRatio,
+            result.averageBitrate / 1000,
+            (unsigned long)result.switchCount);
+      results[t][p] = result;
+    }
+  }
+
+  for (NSUInteger t = 0; t < [traces count]; t++) {
+    GMFABRSimulationResult throughput = results[t][0];
+    GMFABRSimulationResult buffer = results[t][1];
+    GMFABRSimulationResult highest = results[t][2];
+    // Adapting starts quickly and stalls far less than always streaming the top variant.
+    XCTAssertLessThan(throughput.startupDelay, 1.0);
+    XCTAssertLessThan(buffer.startupDelay, 1.0);
+    XCTAssertLessThan(throughput.rebufferRatio, 0.05);
+    XCTAssertLessThan(buffer.rebufferRatio, 0.05);
+    XCTAssertGreaterThan(highest.rebufferRatio, 0.2);
+    // The buffer policy makes use of the buffer it builds up.
+    XCTAssertGreaterThanOrEqual(buffer.averageBitrate, throughput.averageBitrate);
+  }
+  // Neither policy stalls when the network only varies, or during a short outage.
+  XCTAssertEqual(results[1][0].rebufferCount, (NSUInteger)0);
+  XCTAssertEqual(results[1][1].rebufferCount, (NSUInteger)0);
+  XCTAssertEqual(results[3][1].rebufferCount, (NSUInteger)0);
+}
+
+@end
@@ -0,0 +1,205 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFAdBreakScheduler.h>
+#import <GoogleMediaFramework/GMFPlayerObserverRegistry.h>
+
+// Interval between playhead updates, matching the player's media time reporting.
+static const NSTimeInterval kTickInterval = 0.2;
+
+// Number of cue points in the benchmark, far more than any real ad schedule.
+static const NSUInteger kBenchmarkCueCount = 10000;
+
+// The test case acts as a scripted ad source: it records what the scheduler asks for, together
+// with the playhead time at which it asked.
+@interface GMFAdBreakSchedulerTests : XCTestCase<GMFAdBreakSchedulerDelegate>
+@end
+
+@implementation GMFAdBreakSchedulerTests {
+ @private
+  GMFAdBreakScheduler *_scheduler;
+  GMFPlayerObserverRegistry *_registry;
+  NSMutableArray *_events;
+}
+
+- (void)setUp {
+  [super setUp];
+  _events = [NSMutableArray array];
+  _scheduler = [[GMFAdBreakScheduler alloc] init];
+  [_scheduler setDelegate:self];
+  NSTimeInterval cueTimes[] = { 60, 30, 90, 30 };
+  [_scheduler setCueTimes:cueTimes count:4];
+
+  // Drive the scheduler the same way GMFAdService does.
+  _registry = [[GMFPlayerObserverRegistry alloc] init];
+  __weak GMFAdBreakScheduler *weakScheduler = _scheduler;
+  [_registry addObserverForEvents:GMFPlayerEventMaskForType(kGMFPlayerEventMediaTime)
+                       usingBlock:^(const GMFPlayerEvent *event) {
+                           [weakScheduler updatePlayheadTime:event->time];
+                       }];
+}
+
+- (void)tearDown {
+  _scheduler = nil;
+  _registry = nil;
+  _events = nil;
+  [super tearDown];
+}
+
+- (void)playFrom:(NSTimeInterval)from to:(NSTimeInterval)to {
+  for (NSTimeInterval time = from; time <= to; time += kTickInterval) {
+    [_registry publishTime:time forEvent:kGMFPlayerEventMediaTime];
+  }
+}
+
+- (void)testCuePointsAreSortedAndMerged {
+  XCTAssertEqual([_scheduler cueCount], (NSUInteger)3);
+  XCTAssertEqual([_scheduler cueTimeAtIndex:0], 30.0);
+  XCTAssertEqual([_scheduler cueTimeAtIndex:2], 90.0);
+  XCTAssertEqual([_scheduler nextCueTime], 30.0);
+}
+
+- (void)testPlaybackStartsEachBreakOnceAfterAnnouncingIt {
+  [self playFrom:0 to:100];
+
+  NSArray *expected = @[ @"upcoming 30", @"start 30",
+                         @"upcoming 60", @"start 60",
+                         @"upcoming 90", @"start 90" ];
+  XCTAssertEqualObjects([self eventNames], expected);
+  XCTAssertTrue(isnan([_scheduler nextCueTime]));
+}
+
+- (void)testBreaksAreAnnouncedLeadTimeAhead {
+  [self playFrom:0 to:31];
+
+  NSTimeInterval announcedAt = [_events[0][@"playhead"] doubleValue];
+  NSTimeInterval startedAt = [_events[1][@"playhead"] doubleValue];
+  XCTAssertEqualWithAccuracy(announcedAt, 30 - [_scheduler leadTime], kTickInterval);
+  XCTAssertEqualWithAccuracy(startedAt, 30, kTickInterval);
+  XCTAssertTrue(startedAt >= 30);
+}
+
+- (void)testSeekPastBreaksPlaysOnlyTheLast {
+  [_scheduler seekToTime:86];
+
+  NSArray *expected = @[ @"skip 30", @"start 60", @"upcoming 90" ];
+  XCTAssertEqualObjects([self eventNames], expected);
+}
+
+- (void)testLargePlayheadJumpIsTreatedAsSeek {
+  [self playFrom:0 to:10];
+  [_events removeAllObjects];
+  [_registry publishTime:95 forEvent:kGMFPlayerEventMediaTime];
+
+  NSArray *expected = @[ @"skip 30", @"skip 60", @"start 90" ];
+  XCTAssertEqualObjects([self eventNames], expected);
+}
+
+- (void)testSeekCanPlayAllSkippedBreaks {
+  [_scheduler setCatchUpPolicy:kGMFAdBreakCatchUpPlayAll];
+  [_scheduler seekToTime:86];
+
+  NSArray *expected = @[ @"start 30", @"start 60", @"upcoming 90" ];
+  XCTAssertEqualObjects([self eventNames], expected);
+}
+
+- (void)testSeekCanSkipAllBreaks {
+  [_scheduler setCatchUpPolicy:kGMFAdBreakCatchUpSkipAll];
+  [_scheduler seekToTime:86];
+
+  NSArray *expected = @[ @"skip 30", @"skip 60", @"upcoming 90" ];
+  XCTAssertEqualObjects([self eventNames], expected);
+}
+
+- (void)testSeekingBackDoesNotReplayBreaks {
+  [self playFrom:0 to:40];
+  [_scheduler seekToTime:10];
+  [_events removeAllObjects];
+  [self playFrom:10 to:65];
+
+  NSArray *expected = @[ @"upcoming 60", @"start 60" ];
+  XCTAssertEqualObjects([self eventNames], expected);
+}
+
+- (void)testResetMakesBreaksPlayable {
+  [self playFrom:0 to:40];
+  [_scheduler reset];
+  [_events removeAllObjects];
+  [self playFrom:0 to:31];
+
+  NSArray *expected = @[ @"upcoming 30", @"start 30" ];
+  XCTAssertEqualObjects([self eventNames], expected);
+}
+
+- (void)testPrerollStartsOnFirstUpdate {
+  NSTimeInterval cueTimes[] = { 0, -1, 30 };
+  [_scheduler setCueTimes:cueTimes count:3];
+  [_registry publishTime:0 forEvent:kGMFPlayerEventMediaTime];
+
+  XCTAssertEqual([_scheduler cueCount], (NSUInteger)2);
+  XCTAssertEqualObjects([self eventNames], @[ @"start 0" ]);
+}
+
+#pragma mark Benchmarks
+
+- (void)testBenchmarkPlayheadUpdates {
+  NSTimeInterval *cueTimes = malloc(kBenchmarkCueCount * sizeof(NSTimeInterval));
+  for (NSUInteger i = 0; i < kBenchmarkCueCount; i++) {
+    cueTimes[i] = 30.0 * (i + 1);
+  }
+  [_scheduler setCueTimes:cueTimes count:kBenchmarkCueCount];
+  free(cueTimes);
+  [_scheduler setDelegate:nil];
+
+  [self measureBlock:^{
+      [_scheduler reset];
+      // An hour of playback, then a seek to the middle of the schedule.
+      for (NSTimeInterval time = 0; time < 3600; time += kTickInterval) {
+        [_scheduler updatePlayheadTime:time];
+      }
+      [_scheduler seekToTime:30.0 * kBenchmarkCueCount / 2];
+  }];
+}
+
+#pragma mark GMFAdBreakSchedulerDelegate
+
+- (void)adBreakScheduler:(GMFAdBreakScheduler *)scheduler
+    shouldStartBreakAtTime:(NSTimeInterval)cueTime {
+  [self recordEvent:@"start" cueTime:cueTime];
+}
+
+- (void)adBreakScheduler:(GMFAdBreakScheduler *)scheduler
+    breakWillStartAtTime:(NSTimeInterval)cueTime {
+  [self recordEvent:@"upcoming" cueTime:cueTime];
+}
+
+- (void)adBreakScheduler:(GMFAdBreakScheduler *)scheduler
+    didSkipBreakAtTime:(NSTimeInterval)cueTime {
+  [self recordEvent:@"skip" cueTime:cueTime];
+}
+
+#pragma mark Private Methods
+
+- (void)recordEvent:(NSString *)name cueTime:(NSTimeInterval)cueTime {
+  [_events addObject:@{ @"name": [NSString stringWithFormat:@"%@ %g", name, cueTime],
+                        @"playhead": @([_scheduler playheadTime]) }];
+}
+
+- (NSArray *)eventNames {
+  return [_events valueForKey:@"name"];
+}
+
+@end
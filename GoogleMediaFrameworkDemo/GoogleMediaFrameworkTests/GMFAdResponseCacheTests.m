@@ -0,0 +1,225 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFAdResponseCache.h>
+#import <GoogleMediaFramework/GMFVirtualClock.h>
+
+// Round trip to the stand-in ad server.
+static const NSTimeInterval kAdServerLatency = 0.8;
+
+// Content played per item before the user moves to the next one.
+static const NSTimeInterval kItemWatchTime = 30;
+
+static const NSUInteger kItemCount = 5;
+
+// Stand-in ad server: answers every tag on the virtual clock after |kAdServerLatency|, failing
+// tags that contain "error".
+@interface GMFStandInAdServer : NSObject<GMFAdResponseLoader>
+
+@property(nonatomic, readonly) NSUInteger requestCount;
+
+- (instancetype)initWithClock:(GMFVirtualClock *)clock;
+
+@end
+
+@implementation GMFStandInAdServer {
+  GMFVirtualClock *_clock;
+}
+
+- (instancetype)initWithClock:(GMFVirtualClock *)clock {
+  self = [super init];
+  if (self) {
+    _clock = clock;
+  }
+  return self;
+}
+
+- (void)loadAdResponseForAdTag:(NSString *)adTag completion:(GMFAdResponseCompletion)completion {
+  NSUInteger requestNumber = ++_requestCount;
+  [_clock scheduleBlock:^{
+      if ([adTag rangeOfString:@"error"].location != NSNotFound) {
+        completion(nil, [NSError errorWithDomain:kGMFAdResponseCacheErrorDomain
+                                            code:kGMFAdResponseCacheErrorLoadFailed
+                                        userInfo:nil]);
+      } else {
+        completion([NSString stringWithFormat:@"%@#%lu", adTag, (unsigned long)requestNumber],
+                   nil);
+      }
+  } afterDelay:kAdServerLatency];
+}
+
+@end
+
+@interface GMFAdResponseCacheTests : XCTestCase
+@end
+
+@implementation GMFAdResponseCacheTests {
+ @private
+  GMFVirtualClock *_clock;
+  GMFStandInAdServer *_server;
+  GMFAdResponseCache *_cache;
+}
+
+- (void)setUp {
+  [super setUp];
+  _clock = [[GMFVirtualClock alloc] init];
+  _server = [[GMFStandInAdServer alloc] initWithClock:_clock];
+  _cache = [[GMFAdResponseCache alloc] initWithLoader:_server clock:_clock];
+}
+
+- (void)tearDown {
+  _cache = nil;
+  _server = nil;
+  _clock = nil;
+  [super tearDown];
+}
+
+// Takes a response for |adTag| and returns how long it took to arrive.
+- (NSTimeInterval)latencyOfTakingAdTag:(NSString *)adTag response:(id *)response {
+  NSTimeInterval start = [_clock now];
+  __block NSTimeInterval end = NAN;
+  __block id result = nil;
+  [_cache takeResponseForAdTag:adTag completion:^(id loaded, NSError *error) {
+      result = loaded;
+      end = [_clock now];
+  }];
+  [_clock advanceBy:kAdServerLatency];
+  if (response) {
+    *response = result;
+  }
+  return end - start;
+}
+
+- (NSString *)adTagForItem:(NSUInteger)item {
+  return [NSString stringWithFormat:@"https://ads.example.com/tag?item=%lu", (unsigned long)item];
+}
+
+// Plays |kItemCount| items in a row, optionally prefetching the next item's ads while the current
+// one plays, and returns the average pre-roll start latency.
+- (NSTimeInterval)averagePrerollLatencyWithPrefetch:(BOOL)prefetch {
+  NSTimeInterval totalLatency = 0;
+  for (NSUInteger item = 0; item < kItemCount; item++) {
+    totalLatency += [self latencyOfTakingAdTag:[self adTagForItem:item] response:NULL];
+    if (prefetch) {
+      [_cache prefetchAdTag:[self adTagForItem:item + 1]];
+    }
+    [_clock advanceBy:kItemWatchTime];
+  }
+  return totalLatency / kItemCount;
+}
+
+- (void)testPrefetchRemovesPrerollLatency {
+  NSTimeInterval withoutPrefetch = [self averagePrerollLatencyWithPrefetch:NO];
+  [_cache resetStatistics];
+  NSTimeInterval withPrefetch = [self averagePrerollLatencyWithPrefetch:YES];
+  NSLog(@"Pre-roll start latency: %.2fs without prefetch, %.2fs with prefetch.",
+        withoutPrefetch,
+        withPrefetch);
+
+  XCTAssertEqualWithAccuracy(withoutPrefetch, kAdServerLatency, 1e-9);
+  // Only the first item has nothing prefetched for it.
+  XCTAssertEqualWithAccuracy(withPrefetch, kAdServerLatency / kItemCount, 1e-9);
+  XCTAssertEqual([_cache hitCount], kItemCount - 1);
+  XCTAssertEqual([_cache missCount], (NSUInteger)1);
+}
+
+- (void)testTakeJoinsPrefetchInFlight {
+  NSString *tag = [self adTagForItem:0];
+  [_cache prefetchAdTag:tag];
+  [_clock advanceBy:kAdServerLatency / 2];
+
+  NSTimeInterval latency = [self latencyOfTakingAdTag:tag response:NULL];
+
+  XCTAssertEqualWithAccuracy(latency, kAdServerLatency / 2, 1e-9);
+  XCTAssertEqual([_server requestCount], (NSUInteger)1);
+}
+
+- (void)testResponsesAreSingleUse {
+  NSString *tag = [self adTagForItem:0];
+  [_cache prefetchAdTag:tag];
+  [_clock advanceBy:kAdServerLatency];
+  id first = nil;
+  id second = nil;
+  [self latencyOfTakingAdTag:tag response:&first];
+  [self latencyOfTakingAdTag:tag response:&second];
+
+  XCTAssertNotNil(first);
+  XCTAssertNotNil(second);
+  XCTAssertNotEqualObjects(first, second);
+  XCTAssertEqual([_server requestCount], (NSUInteger)2);
+}
+
+- (void)testExpiredResponsesAreNotServed {
+  NSString *tag = [self adTagForItem:0];
+  [_cache setTimeToLive:60];
+  [_cache prefetchAdTag:tag];
+  [_clock advanceBy:kAdServerLatency];
+  XCTAssertTrue([_cache hasResponseForAdTag:tag]);
+
+  [_clock advanceBy:60];
+
+  XCTAssertFalse([_cache hasResponseForAdTag:tag]);
+  XCTAssertEqual([_cache expiredCount], (NSUInteger)1);
+  XCTAssertEqualWithAccuracy([self latencyOfTakingAdTag:tag response:NULL], kAdServerLatency, 1e-9);
+}
+
+- (void)testCountLimitDropsSoonestToExpire {
+  [_cache setCountLimit:2];
+  for (NSUInteger item = 0; item < 3; item++) {
+    [_cache prefetchAdTag:[self adTagForItem:item]];
+    [_clock advanceBy:kAdServerLatency];
+  }
+
+  XCTAssertFalse([_cache hasResponseForAdTag:[self adTagForItem:0]]);
+  XCTAssertTrue([_cache hasResponseForAdTag:[self adTagForItem:2]]);
+  XCTAssertEqual([_cache expiredCount], (NSUInteger)1);
+}
+
+- (void)testFrequencyCap {
+  NSString *tag = [self adTagForItem:0];
+  [_cache setFrequencyCap:2];
+  [_cache setFrequencyCapInterval:600];
+  [self latencyOfTakingAdTag:tag response:NULL];
+  [self latencyOfTakingAdTag:tag response:NULL];
+
+  XCTAssertTrue([_cache isFrequencyCappedForAdTag:tag]);
+  __block NSError *cappedError = nil;
+  [_cache takeResponseForAdTag:tag completion:^(id response, NSError *error) {
+      cappedError = error;
+  }];
+  XCTAssertEqual([cappedError code], (NSInteger)kGMFAdResponseCacheErrorFrequencyCapped);
+  [_cache prefetchAdTag:tag];
+  XCTAssertEqual([_server requestCount], (NSUInteger)2);
+
+  [_clock advanceBy:600];
+  XCTAssertFalse([_cache isFrequencyCappedForAdTag:tag]);
+}
+
+- (void)testLoadErrorsReachEveryWaiter {
+  __block NSUInteger errorCount = 0;
+  for (NSUInteger i = 0; i < 2; i++) {
+    [_cache takeResponseForAdTag:@"error" completion:^(id response, NSError *error) {
+        XCTAssertNil(response);
+        errorCount += error ? 1 : 0;
+    }];
+  }
+  [_clock advanceBy:kAdServerLatency];
+
+  XCTAssertEqual(errorCount, (NSUInteger)2);
+  XCTAssertFalse([_cache hasResponseForAdTag:@"error"]);
+}
+
+@end
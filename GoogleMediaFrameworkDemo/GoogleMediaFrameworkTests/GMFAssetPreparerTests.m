@@ -0,0 +1,224 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFAssetPreparer.h>
+#import <GoogleMediaFramework/GMFVideoPlayer.h>
+
+// An asset whose keys load when the test says so.
+@interface GMFScriptedAsset : AVURLAsset
+
+@property(nonatomic, assign) BOOL scriptedPlayable;
+@property(nonatomic, readonly) NSArray *requestedKeys;
+@property(nonatomic, readonly) BOOL loadingCancelled;
+
+// A playable asset for a file that doesn't exist.
++ (instancetype)scriptedAssetWithName:(NSString *)name;
+
+// Calls the pending load completion handler on a background queue, as AVFoundation does.
+- (void)finishLoading;
+
+@end
+
+@implementation GMFScriptedAsset {
+ @private
+  dispatch_block_t _completionHandler;
+}
+
++ (instancetype)scriptedAssetWithName:(NSString *)name {
+  NSURL *URL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:name]];
+  GMFScriptedAsset *asset = [[GMFScriptedAsset alloc] initWithURL:URL options:nil];
+  [asset setScriptedPlayable:YES];
+  return asset;
+}
+
+- (void)loadValuesAsynchronouslyForKeys:(NSArray *)keys completionHandler:(void (^)(void))handler {
+  _requestedKeys = keys;
+  _completionHandler = [handler copy];
+}
+
+- (AVKeyValueStatus)statusOfValueForKey:(NSString *)key error:(NSError **)outError {
+  return _loadingCancelled ? AVKeyValueStatusCancelled : AVKeyValueStatusLoaded;
+}
+
+- (BOOL)isPlayable {
+  return _scriptedPlayable;
+}
+
+- (void)cancelLoading {
+  _loadingCancelled = YES;
+  dispatch_block_t completionHandler = _completionHandler;
+  _completionHandler = nil;
+  if (completionHandler) {
+    completionHandler();
+  }
+}
+
+- (void)finishLoading {
+  dispatch_block_t completionHandler = _completionHandler;
+  _completionHandler = nil;
+  dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), completionHandler);
+}
+
+@end
+
+@interface GMFAssetPreparerTests : XCTestCase
+@end
+
+@implementation GMFAssetPreparerTests {
+ @private
+  GMFAssetPreparer *_preparer;
+  NSMutableArray *_deliveredGenerations;
+  AVPlayerItem *_lastPlayerItem;
+  NSError *_lastError;
+  BOOL _deliveredOnMainThread;
+}
+
+- (void)setUp {
+  [super setUp];
+  _preparer = [[GMFAssetPreparer alloc] init];
+  _deliveredGenerations = [NSMutableArray array];
+  _deliveredOnMainThread = YES;
+}
+
+- (GMFAssetPreparation *)prepareAsset:(GMFScriptedAsset *)asset {
+  __weak GMFAssetPreparerTests *weakSelf = self;
+  return [_preparer prepareAsset:asset
+                      completion:^(GMFAssetPreparation *preparation,
+                                   AVPlayerItem *playerItem,
+                                   NSError *error) {
+      [weakSelf preparation:preparation didFinishWithPlayerItem:playerItem error:error];
+  }];
+}
+
+- (void)preparation:(GMFAssetPreparation *)preparation
+    didFinishWithPlayerItem:(AVPlayerItem *)playerItem
+                      error:(NSError *)error {
+  _deliveredOnMainThread = _deliveredOnMainThread && [NSThread isMainThread];
+  [_deliveredGenerations addObject:@([preparation generation])];
+  _lastPlayerItem = playerItem;
+  _lastError = error;
+}
+
+// Runs the main run loop until |count| results were delivered, or for |timeout| seconds.
+- (void)waitForDeliveryCount:(NSUInteger)count timeout:(NSTimeInterval)timeout {
+  NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:timeout];
+  while ([_deliveredGenerations count] < count && [deadline timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode
+                             beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  }
+}
+
+- (void)testPreparesPlayableAsset {
+  GMFScriptedAsset *asset = [GMFScriptedAsset scriptedAssetWithName:@"playable.mp4"];
+  GMFAssetPreparation *preparation = [self prepareAsset:asset];
+  XCTAssertEqual([preparation generation], (NSUInteger)1);
+  XCTAssertEqual([_preparer activeCount], (NSUInteger)1);
+  XCTAssertEqualObjects([asset requestedKeys], [GMFAssetPreparer assetKeys]);
+
+  [asset finishLoading];
+  [self waitForDeliveryCount:1 timeout:5];
+  XCTAssertEqualObjects(_deliveredGenerations, @[ @1 ]);
+  XCTAssertTrue(_deliveredOnMainThread);
+  XCTAssertEqual([_lastPlayerItem asset], asset);
+  XCTAssertNil(_lastError);
+  XCTAssertEqual([_preparer activeCount], (NSUInteger)0);
+  XCTAssertEqual([_preparer preparedCount], (NSUInteger)1);
+  XCTAssertEqual([[_preparer mainThreadTime] count], (uint64_t)1);
+  XCTAssertEqual([[_preparer preparationLatency] count], (uint64_t)1);
+}
+
+- (void)testUnplayableAssetFails {
+  GMFScriptedAsset *asset = [GMFScriptedAsset scriptedAssetWithName:@"unplayable.mp4"];
+  [asset setScriptedPlayable:NO];
+  [self prepareAsset:asset];
+  [asset finishLoading];
+  [self waitForDeliveryCount:1 timeout:5];
+  XCTAssertNil(_lastPlayerItem);
+  XCTAssertEqualObjects([_lastError domain], kGMFAssetPreparerErrorDomain);
+  XCTAssertEqual([_lastError code], (NSInteger)kGMFAssetPreparerErrorNotPlayable);
+  XCTAssertEqual([_preparer failedCount], (NSUInteger)1);
+}
+
+- (void)testCancelledPreparationNeverDelivers {
+  GMFScriptedAsset *asset = [GMFScriptedAsset scriptedAssetWithName:@"cancelled.mp4"];
+  GMFAssetPreparation *preparation = [self prepareAsset:asset];
+  [preparation cancel];
+  XCTAssertTrue([preparation isCancelled]);
+  XCTAssertTrue([asset loadingCancelled]);
+  XCTAssertEqual([_preparer activeCount], (NSUInteger)0);
+  XCTAssertEqual([_preparer cancelledCount], (NSUInteger)1);
+
+  [self waitForDeliveryCount:1 timeout:0.2];
+  XCTAssertEqual([_deliveredGenerations count], (NSUInteger)0);
+}
+
+- (void)testCancelAfterLoadingDropsResult {
+  GMFScriptedAsset *asset = [GMFScriptedAsset scriptedAssetWithName:@"late.mp4"];
+  GMFAssetPreparation *preparation = [self prepareAsset:asset];
+  // The result is on its way to the main thread when the load is cancelled.
+  [asset finishLoading];
+  [NSThread sleepForTimeInterval:0.05];
+  [preparation cancel];
+  [self waitForDeliveryCount:1 timeout:0.2];
+  XCTAssertEqual([_deliveredGenerations count], (NSUInteger)0);
+  XCTAssertEqual([_preparer preparedCount], (NSUInteger)0);
+}
+
+- (void)testParallelPreparations {
+  NSMutableArray *assets = [NSMutableArray array];
+  for (NSUInteger i = 0; i < 3; i++) {
+    GMFScriptedAsset *asset =
+        [GMFScriptedAsset scriptedAssetWithName:[NSString stringWithFormat:@"item%lu.mp4",
+                                                                         (unsigned long)i]];
+    [assets addObject:asset];
+    [self prepareAsset:asset];
+  }
+  XCTAssertEqual([_preparer activeCount], (NSUInteger)3);
+
+  // The last one finishes first without waiting for the others.
+  [[assets lastObject] finishLoading];
+  [self waitForDeliveryCount:1 timeout:5];
+  [[assets firstObject] finishLoading];
+  [self waitForDeliveryCount:2 timeout:5];
+  XCTAssertEqualObjects(_deliveredGenerations, (@[ @3, @1 ]));
+  XCTAssertEqual([_preparer activeCount], (NSUInteger)1);
+
+  [_preparer cancelAllPreparations];
+  XCTAssertTrue([[assets objectAtIndex:1] loadingCancelled]);
+  XCTAssertEqual([_preparer activeCount], (NSUInteger)0);
+  XCTAssertEqual([_preparer cancelledCount], (NSUInteger)1);
+}
+
+// Loading a playlist while a stream is still being prepared drops the stream, so its result can't
+// replace the playlist's player or fail the player.
+- (void)testLoadingPlaylistCancelsStreamPreparation {
+  GMFVideoPlayer *player = [[GMFVideoPlayer alloc] init];
+  NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"missing.mp4"];
+  [player loadStreamWithURL:[NSURL fileURLWithPath:path]];
+  XCTAssertEqual([[player assetPreparer] activeCount], (NSUInteger)1);
+
+  [player loadPlaylist];
+  XCTAssertEqual([[player assetPreparer] activeCount], (NSUInteger)0);
+  XCTAssertEqual([[player assetPreparer] cancelledCount], (NSUInteger)1);
+  // The queue is empty.
+  XCTAssertEqual([player state], kGMFPlayerStateEmpty);
+
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+  XCTAssertEqual([player state], kGMFPlayerStateEmpty);
+  XCTAssertEqual([[player assetPreparer] failedCount], (NSUInteger)0);
+}
+
+@end
@@ -0,0 +1,231 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFBarLayout.h>
+#import <GoogleMediaFramework/GMFPlayerControlsView.h>
+#import <GoogleMediaFramework/GMFTopBarView.h>
+
+// Bars built and laid out per benchmark iteration, as when scrolling a feed of inline players.
+static const NSUInteger kBarsPerIteration = 200;
+
+@interface GMFBarLayoutTests : XCTestCase
+@end
+
+@implementation GMFBarLayoutTests
+
+- (void)testControlBarLayout {
+  GMFControlBarLayoutInput input = { CGSizeMake(320, 44), 40, 45, 30 };
+  GMFControlBarLayout layout = GMFLayoutControlBar(input);
+  XCTAssertTrue(CGRectEqualToRect(layout.background, CGRectMake(0, 0, 320, 44)));
+  XCTAssertTrue(CGRectEqualToRect(layout.minimizeButton, CGRectMake(282, 0, 30, 44)));
+  XCTAssertTrue(CGRectEqualToRect(layout.totalSecondsLabel, CGRectMake(229, 0, 45, 44)));
+  XCTAssertTrue(CGRectEqualToRect(layout.secondsPlayedLabel, CGRectMake(8, 0, 40, 44)));
+  XCTAssertTrue(CGRectEqualToRect(layout.scrubber, CGRectMake(56, 0, 165, 44)));
+
+  // Too narrow for the scrubber.
+  input.barSize = CGSizeMake(150, 44);
+  layout = GMFLayoutControlBar(input);
+  XCTAssertEqual(layout.scrubber.size.width, (CGFloat)0);
+}
+
+- (void)testTopBarLayout {
+  GMFTopBarLayoutInput input = { CGSizeMake(320, 40), CGSizeMake(30, 30), 500, 2 };
+  CGRect buttonFrames[2];
+  GMFTopBarLayout layout = GMFLayoutTopBar(input, buttonFrames);
+  XCTAssertTrue(CGRectEqualToRect(layout.logo, CGRectMake(4, 5, 40, 30)));
+  XCTAssertTrue(CGRectEqualToRect(buttonFrames[0], CGRectMake(265, 0, 40, 40)));
+  XCTAssertTrue(CGRectEqualToRect(buttonFrames[1], CGRectMake(215, 0, 40, 40)));
+  // The title stops short of the buttons.
+  XCTAssertTrue(CGRectEqualToRect(layout.title, CGRectMake(52, 0, 155, 40)));
+
+  input.actionButtonCount = 0;
+  layout = GMFLayoutTopBar(input, buttonFrames);
+  XCTAssertEqual(layout.title.size.width, (CGFloat)268);
+  input.titleWidth = 100;
+  layout = GMFLayoutTopBar(input, buttonFrames);
+  XCTAssertEqual(layout.title.size.width, (CGFloat)100);
+
+  // Without a logo image it fills the bar's height.
+  input.logoSize = CGSizeZero;
+  layout = GMFLayoutTopBar(input, buttonFrames);
+  XCTAssertTrue(CGRectEqualToRect(layout.logo, CGRectMake(4, 0, 40, 40)));
+}
+
+- (void)testViewsUseFramesWithoutConstraints {
+  GMFPlayerControlsView *controlsView = [[GMFPlayerControlsView alloc] init];
+  [controlsView setFrame:CGRectMake(0, 0, 320, 44)];
+  [controlsView layoutIfNeeded];
+  XCTAssertEqual([[controlsView constraints] count], (NSUInteger)0);
+  XCTAssertTrue(CGRectEqualToRect([[[controlsView subviews] firstObject] frame],
+                                 [controlsView bounds]));
+
+  GMFTopBarView *topBarView = [[GMFTopBarView alloc] init];
+  [topBarView setVideoTitle:@"Title"];
+  [topBarView addActionButtonWithImage:nil name:@"Share" target:nil selector:NULL];
+  [topBarView addActionButtonWithImage:nil name:@"Like" target:nil selector:NULL];
+  [topBarView setFrame:CGRectMake(0, 0, 320, 40)];
+  [topBarView layoutIfNeeded];
+  XCTAssertEqual([[topBarView constraints] count], (NSUInteger)0);
+
+  GMFTopBarLayoutInput input = { CGSizeMake(320, 40), CGSizeZero, 0, 2 };
+  CGRect buttonFrames[2];
+  GMFLayoutTopBar(input, buttonFrames);
+  NSUInteger buttonIndex = 0;
+  for (UIView *subview in [topBarView subviews]) {
+    if ([subview isKindOfClass:[UIButton class]]) {
+      XCTAssertTrue(CGRectEqualToRect([subview frame], buttonFrames[buttonIndex++]));
+    }
+  }
+  XCTAssertEqual(buttonIndex, (NSUInteger)2);
+}
+
+- (void)testLayoutIsSkippedWhileTheInputHolds {
+  GMFPlayerControlsView *controlsView = [[GMFPlayerControlsView alloc] init];
+  [controlsView setFrame:CGRectMake(0, 0, 320, 44)];
+  [controlsView layoutIfNeeded];
+  UIView *background = [[controlsView subviews] firstObject];
+  // Moved by hand; a layout with the same input leaves it there.
+  [background setFrame:CGRectZero];
+  [controlsView setNeedsLayout];
+  [controlsView layoutIfNeeded];
+  XCTAssertTrue(CGRectEqualToRect([background frame], CGRectZero));
+
+  // A new width lays it out again.
+  [controlsView setFrame:CGRectMake(0, 0, 480, 44)];
+  [controlsView layoutIfNeeded];
+  XCTAssertTrue(CGRectEqualToRect([background frame], CGRectMake(0, 0, 480, 44)));
+}
+
+#pragma mark Benchmarks
+
+// Construction and first layout of the bars, as every new player pays for them.
+- (void)testBenchmarkFrameLayout {
+  [self measureBlock:^{
+      for (NSUInteger i = 0; i < kBarsPerIteration; i++) {
+        GMFPlayerControlsView *controlsView = [[GMFPlayerControlsView alloc] init];
+        [controlsView setFrame:CGRectMake(0, 0, 320, 44)];
+        [controlsView layoutIfNeeded];
+        GMFTopBarView *topBarView = [[GMFTopBarView alloc] init];
+        [topBarView addActionButtonWithImage:nil name:@"Share" target:nil selector:NULL];
+        [topBarView setFrame:CGRectMake(0, 0, 320, 40)];
+        [topBarView layoutIfNeeded];
+      }
+  }];
+}
+
+// The same bars laid out by solving the constraints they used to carry, for comparison.
+- (void)testBenchmarkConstraintLayout {
+  [self measureBlock:^{
+      for (NSUInteger i = 0; i < kBarsPerIteration; i++) {
+        [[self constraintControlBar] layoutIfNeeded];
+        [[self constraintTopBar] layoutIfNeeded];
+      }
+  }];
+}
+
+#pragma mark Private Methods
+
+// A bar laid out like the control bar was: every item as tall as the bar, and chained from both
+// ends with 8 points between them.
+- (UIView *)constraintControlBar {
+  UIView *bar = [[UIView alloc] initWithFrame:CGRectMake(0, 0, 320, 44)];
+  UIImageView *background = [[UIImageView alloc] init];
+  UILabel *played = [[UILabel alloc] init];
+  [played setText:@"0:00"];
+  UISlider *scrubber = [[UISlider alloc] init];
+  UILabel *total = [[UILabel alloc] init];
+  [total setText:@"10:00"];
+  UIButton *minimize = [UIButton buttonWithType:UIButtonTypeCustom];
+  NSDictionary *views = NSDictionaryOfVariableBindings(background, played, scrubber, total,
+                                                       minimize);
+  for (UIView *view in [views allValues]) {
+    [view setTranslatesAutoresizingMaskIntoConstraints:NO];
+    [bar addSubview:view];
+    [bar addConstraints:[NSLayoutConstraint
+        constraintsWithVisualFormat:@"V:|[view]|"
+                            options:0
+                            metrics:nil
+                              views:NSDictionaryOfVariableBindings(view)]];
+  }
+  [bar addConstraints:[NSLayoutConstraint constraintsWithVisualFormat:@"H:|[background]|"
+                                                              options:0
+                                                              metrics:nil
+                                                                views:views]];
+  [bar addConstraints:[NSLayoutConstraint
+      constraintsWithVisualFormat:@"H:|-8-[played]-8-[scrubber]-8-[total]-8-[minimize]-8-|"
+                          options:0
+                          metrics:nil
+                            views:views]];
+  return bar;
+}
+
+// A bar laid out like the top bar was, with one action button.
+- (UIView *)constraintTopBar {
+  UIView *bar = [[UIView alloc] initWithFrame:CGRectMake(0, 0, 320, 40)];
+  UIImageView *background = [[UIImageView alloc] init];
+  UIImageView *logo = [[UIImageView alloc] init];
+  UILabel *title = [[UILabel alloc] init];
+  [title setText:@"Title"];
+  UIButton *button = [UIButton buttonWithType:UIButtonTypeCustom];
+  NSDictionary *views = NSDictionaryOfVariableBindings(background, logo, title, button);
+  for (UIView *view in [views allValues]) {
+    [view setTranslatesAutoresizingMaskIntoConstraints:NO];
+    [bar addSubview:view];
+  }
+  [bar addConstraints:[NSLayoutConstraint constraintsWithVisualFormat:@"V:|[background]|"
+                                                              options:0
+                                                              metrics:nil
+                                                                views:views]];
+  [bar addConstraints:[NSLayoutConstraint constraintsWithVisualFormat:@"H:|[background]|"
+                                                              options:0
+                                                              metrics:nil
+                                                                views:views]];
+  [bar addConstraints:[NSLayoutConstraint constraintsWithVisualFormat:@"V:|[title]|"
+                                                              options:0
+                                                              metrics:nil
+                                                                views:views]];
+  [bar addConstraints:[NSLayoutConstraint constraintsWithVisualFormat:@"V:|[button]|"
+                                                              options:0
+                                                              metrics:nil
+                                                                views:views]];
+  [bar addConstraints:[NSLayoutConstraint constraintsWithVisualFormat:@"V:|[logo]|"
+                                                              options:0
+                                                              metrics:nil
+                                                                views:views]];
+  [bar addConstraints:[NSLayoutConstraint
+      constraintsWithVisualFormat:@"H:|-4-[logo]-8-[title]-(>=8)-[button]-15-|"
+                          options:0
+                          metrics:nil
+                            views:views]];
+  [bar addConstraint:[NSLayoutConstraint constraintWithItem:logo
+                                                  attribute:NSLayoutAttributeWidth
+                                                  relatedBy:NSLayoutRelationEqual
+                                                     toItem:bar
+                                                  attribute:NSLayoutAttributeHeight
+                                                 multiplier:1
+                                                   constant:0]];
+  [bar addConstraint:[NSLayoutConstraint constraintWithItem:button
+                                                  attribute:NSLayoutAttributeWidth
+                                                  relatedBy:NSLayoutRelationEqual
+                                                     toItem:button
+                                                  attribute:NSLayoutAttributeHeight
+                                                 multiplier:1
+                                                   constant:0]];
+  return bar;
+}
+
+@end
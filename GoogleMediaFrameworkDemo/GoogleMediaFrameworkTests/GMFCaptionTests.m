@@ -0,0 +1,430 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFCaptionIndex.h>
+#import <GoogleMediaFramework/GMFCaptionTrack.h>
+#import <GoogleMediaFramework/GMFVirtualClock.h>
+#import <GoogleMediaFramework/GMFWebVTTParser.h>
+
+#import "GMFTestHTTPServer.h"
+
+// A feature-length track: two hours of subtitles, each overlapping the next.
+static const NSUInteger kFeatureCueCount = 12000;
+static const NSTimeInterval kFeatureCueInterval = 0.6;
+static const NSTimeInterval kFeatureCueDuration = 1.5;
+
+// Media time updates per second of playback in the benchmark.
+static const NSUInteger kBenchmarkUpdateRate = 60;
+static const NSUInteger kBenchmarkLookupCount = 100000;
+
+static NSString * const kSampleTrack =
+    @"\xEF\xBB\xBFWEBVTT - sample\r\n"
+    @"Kind: captions\r\n"
+    @"\r\n"
+    @"STYLE\r\n"
+    @"::cue { color: yellow }\r\n"
+    @"\r\n"
+    @"NOTE a comment\r\n"
+    @"that spans --> two lines\r\n"
+    @"\r\n"
+    @"intro\r\n"
+    @"00:01.000 --> 00:04.000 line:0 align:start\r\n"
+    @"<v Narrator>Once upon a time</v>\r\n"
+    @"in <i>a land</i> far away\r\n"
+    @"\r\n"
+    @"00:00:03.500 --> 00:00:05.250\r\n"
+    @"Fish &amp; chips &lt;3\r\n"
+    @"\r\n"
+    @"broken\r\n"
+    @"00:06.000 -> 00:07.000\r\n"
+    @"Never shown\r\n"
+    @"\r\n"
+    @"01:00:00.000 --> 01:00:02.000\r\n"
+    @"The end";
+
+@interface GMFCaptionTests : XCTestCase<GMFCaptionTrackDelegate>
+@end
+
+@implementation GMFCaptionTests {
+ @private
+  // Texts of the cues from each delegate call.
+  NSMutableArray *_enteredTexts;
+  NSMutableArray *_exitedTexts;
+}
+
+- (void)setUp {
+  [super setUp];
+  _enteredTexts = [NSMutableArray array];
+  _exitedTexts = [NSMutableArray array];
+}
+
+- (void)captionTrack:(GMFCaptionTrack *)captionTrack
+        didEnterCues:(NSArray *)enteredCues
+            exitCues:(NSArray *)exitedCues {
+  [_enteredTexts addObject:[enteredCues valueForKey:@"text"]];
+  [_exitedTexts addObject:[exitedCues valueForKey:@"text"]];
+}
+
+- (NSArray *)cuesOfTrack:(NSString *)track chunkLength:(NSUInteger)chunkLength {
+  NSMutableArray *cues = [NSMutableArray array];
+  GMFWebVTTParser *parser = [[GMFWebVTTParser alloc] initWithCueHandler:^(GMFCaptionCue *cue) {
+      [cues addObject:cue];
+  }];
+  NSData *data = [track dataUsingEncoding:NSUTF8StringEncoding];
+  for (NSUInteger offset = 0; offset < [data length]; offset += chunkLength) {
+    NSRange range = NSMakeRange(offset, MIN(chunkLength, [data length] - offset));
+    [parser appendData:[data subdataWithRange:range]];
+  }
+  [parser finishFile];
+  XCTAssertEqual([parser cueCount], [cues count]);
+  return cues;
+}
+
+- (NSString *)timestamp:(NSTimeInterval)seconds {
+  NSUInteger milliseconds = (NSUInteger)llround(seconds * 1000);
+  return [NSString stringWithFormat:@"%02lu:%02lu:%02lu.%03lu",
+                                    (unsigned long)(milliseconds / 3600000),
+                                    (unsigned long)(milliseconds / 60000 % 60),
+                                    (unsigned long)(milliseconds / 1000 % 60),
+                                    (unsigned long)(milliseconds % 1000)];
+}
+
+- (NSData *)featureLengthTrack {
+  NSMutableString *track = [NSMutableString stringWithString:@"WEBVTT\n\n"];
+  for (NSUInteger i = 0; i < kFeatureCueCount; i++) {
+    NSTimeInterval start = i * kFeatureCueInterval;
+    [track appendFormat:@"%lu\n%@ --> %@\nLine %lu of the film,\n<i>spoken</i> by someone\n\n",
+                        (unsigned long)i,
+                        [self timestamp:start],
+                        [self timestamp:start + kFeatureCueDuration],
+                        (unsigned long)i];
+  }
+  return [track dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (void)testParsesCues {
+  NSArray *cues = [self cuesOfTrack:kSampleTrack chunkLength:NSUIntegerMax];
+  XCTAssertEqual([cues count], (NSUInteger)3);
+
+  GMFCaptionCue *intro = [cues objectAtIndex:0];
+  XCTAssertEqualObjects([intro identifier], @"intro");
+  XCTAssertEqualWithAccuracy([intro startTime], 1, 1e-9);
+  XCTAssertEqualWithAccuracy([intro endTime], 4, 1e-9);
+  XCTAssertEqualObjects([intro text], @"Once upon a time\nin a land far away");
+  XCTAssertEqualObjects([intro settings], @"line:0 align:start");
+
+  GMFCaptionCue *second = [cues objectAtIndex:1];
+  XCTAssertNil([second identifier]);
+  XCTAssertNil([second settings]);
+  XCTAssertEqualWithAccuracy([second endTime], 5.25, 1e-9);
+  XCTAssertEqualObjects([second text], @"Fish & chips <3");
+
+  // Ends without a line break.
+  GMFCaptionCue *last = [cues lastObject];
+  XCTAssertEqualWithAccuracy([last startTime], 3600, 1e-9);
+  XCTAssertEqualObjects([last text], @"The end");
+}
+
+- (void)testParsesChunksSplitAnywhere {
+  NSArray *whole = [self cuesOfTrack:kSampleTrack chunkLength:NSUIntegerMax];
+  for (NSUInteger chunkLength = 1; chunkLength < 16; chunkLength++) {
+    NSArray *cues = [self cuesOfTrack:kSampleTrack chunkLength:chunkLength];
+    XCTAssertEqualObjects(cues, whole);
+    XCTAssertEqualObjects([cues valueForKey:@"identifier"], [whole valueForKey:@"identifier"]);
+  }
+}
+
+- (void)testSegmentsFollowTimestampMap {
+  NSMutableArray *cues = [NSMutableArray array];
+  GMFWebVTTParser *parser = [[GMFWebVTTParser alloc] initWithCueHandler:^(GMFCaptionCue *cue) {
+      [cues addObject:cue];
+  }];
+  NSArray *segments = @[
+      // The first map lines the cues up as they are.
+      @"WEBVTT\nX-TIMESTAMP-MAP=MPEGTS:900000,LOCAL:00:00:00.000\n\n00:01.000 --> 00:03.000\nA",
+      // Six seconds later.
+      @"WEBVTT\nX-TIMESTAMP-MAP=LOCAL:00:00:00.000,MPEGTS:1440000\n\n00:00.500 --> 00:02.000\nB",
+      // Same media time, local times counting from 10 seconds.
+      @"WEBVTT\nX-TIMESTAMP-MAP=MPEGTS:1440000,LOCAL:00:00:10.000\n\n00:10.500 --> 00:12.000\nB",
+      @"Not a caption file\n\n00:00.000 --> 00:01.000\nD",
+  ];
+  for (NSString *segment in segments) {
+    [parser appendData:[segment dataUsingEncoding:NSUTF8StringEncoding]];
+    [parser finishFile];
+  }
+  XCTAssertEqual([cues count], (NSUInteger)3);
+  XCTAssertEqual([parser invalidFileCount], (NSUInteger)1);
+  XCTAssertEqualWithAccuracy([[cues objectAtIndex:0] startTime], 1, 1e-9);
+  XCTAssertEqualWithAccuracy([[cues objectAtIndex:1] startTime], 6.5, 1e-9);
+  XCTAssertEqualWithAccuracy([[cues objectAtIndex:2] startTime], 6.5, 1e-9);
+  XCTAssertEqualObjects([cues objectAtIndex:1], [cues objectAtIndex:2]);
+
+  // The 33-bit timestamps roll over about every 26.5 hours.
+  GMFWebVTTParser *rollover = [[GMFWebVTTParser alloc] initWithCueHandler:^(GMFCaptionCue *cue) {
+      [cues addObject:cue];
+  }];
+  NSString *beforeRollover = [NSString stringWithFormat:
+      @"WEBVTT\nX-TIMESTAMP-MAP=MPEGTS:%llu,LOCAL:00:00:00.000\n\n", (1ULL << 33) - 90000];
+  [rollover appendData:[beforeRollover dataUsingEncoding:NSUTF8StringEncoding]];
+  [rollover finishFile];
+  [rollover appendData:[@"WEBVTT\nX-TIMESTAMP-MAP=MPEGTS:90000,LOCAL:00:00:00.000\n\n"
+                        @"00:00.000 --> 00:01.000\nE\n" dataUsingEncoding:NSUTF8StringEncoding]];
+  [rollover finishFile];
+  XCTAssertEqualWithAccuracy([[cues lastObject] startTime], 2, 1e-9);
+}
+
+// Checks the lookups of |index| against a scan of |cues|.
+- (void)assertIndex:(GMFCaptionIndex *)index findsCues:(NSArray *)cues {
+  for (NSTimeInterval time = -1; time < 1100; time += 0.5) {
+    NSMutableSet *expected = [NSMutableSet set];
+    for (GMFCaptionCue *cue in cues) {
+      if ([cue startTime] <= time && time < [cue endTime]) {
+        [expected addObject:cue];
+      }
+    }
+    NSArray *found = [index cuesAtTime:time];
+    XCTAssertEqualObjects([NSSet setWithArray:found], expected, @"at %f", time);
+    for (NSUInteger i = 1; i < [found count]; i++) {
+      XCTAssertLessThanOrEqual([[found objectAtIndex:i - 1] startTime],
+                               [[found objectAtIndex:i] startTime]);
+    }
+  }
+}
+
+- (void)testIndexFindsOverlappingCues {
+  GMFCaptionIndex *index = [[GMFCaptionIndex alloc] init];
+  XCTAssertEqualObjects([index cuesAtTime:0], @[]);
+  XCTAssertEqual([index nextCueStartTimeAfterTime:0], DBL_MAX);
+
+  // Out of order, nested and touching cues, and one long one spanning the rest.
+  NSMutableArray *cues = [NSMutableArray array];
+  srandom(42);
+  for (NSUInteger i = 0; i < 500; i++) {
+    NSTimeInterval start = random() % 1000;
+    NSTimeInterval duration = 1 + random() % (i % 3 ? 5 : 60);
+    [cues addObject:[[GMFCaptionCue alloc] initWithStartTime:start
+                                                     endTime:start + duration
+                                                        text:[NSString stringWithFormat:@"%lu",
+                                                                 (unsigned long)i]]];
+  }
+  [cues addObject:[[GMFCaptionCue alloc] initWithStartTime:100 endTime:900 text:@"long"]];
+  for (GMFCaptionCue *cue in cues) {
+    XCTAssertTrue([index addCue:cue]);
+  }
+  GMFCaptionCue *copy = [[GMFCaptionCue alloc] initWithStartTime:100 endTime:900 text:@"long"];
+  XCTAssertFalse([index addCue:copy]);
+  XCTAssertEqual([index cueCount], [cues count]);
+
+  [self assertIndex:index findsCues:cues];
+  NSTimeInterval nextStartTime = DBL_MAX;
+  for (GMFCaptionCue *cue in cues) {
+    if ([cue startTime] > 100) {
+      nextStartTime = MIN(nextStartTime, [cue startTime]);
+    }
+  }
+  XCTAssertEqual([index nextCueStartTimeAfterTime:100], nextStartTime);
+
+  // A live window slides past 500.
+  NSMutableArray *keptCues = [NSMutableArray array];
+  GMFCaptionCue *removedCue = nil;
+  for (GMFCaptionCue *cue in cues) {
+    if ([cue endTime] > 500) {
+      [keptCues addObject:cue];
+    } else {
+      removedCue = removedCue ?: cue;
+    }
+  }
+  XCTAssertEqual([index removeCuesEndingBeforeTime:500], [cues count] - [keptCues count]);
+  XCTAssertEqual([index cueCount], [keptCues count]);
+  [self assertIndex:index findsCues:keptCues];
+  XCTAssertEqual([index removeCuesEndingBeforeTime:500], (NSUInteger)0);
+  XCTAssertTrue([index addCue:removedCue]);
+
+  [index removeAllCues];
+  XCTAssertEqual([index cueCount], (NSUInteger)0);
+  XCTAssertTrue([index addCue:copy]);
+}
+
+- (void)testTrackReportsOnlyChanges {
+  GMFCaptionTrack *track = [[GMFCaptionTrack alloc] init];
+  [track setDelegate:self];
+  [track appendData:[kSampleTrack dataUsingEncoding:NSUTF8StringEncoding]];
+  [track finishAppending];
+  XCTAssertEqual([[track index] cueCount], (NSUInteger)3);
+
+  [track updateWithMediaTime:0.5];
+  XCTAssertEqual([_enteredTexts count], (NSUInteger)0);
+
+  [track updateWithMediaTime:1];
+  XCTAssertEqualObjects(_enteredTexts, @[ @[ @"Once upon a time\nin a land far away" ] ]);
+  XCTAssertEqualObjects([_exitedTexts lastObject], @[]);
+
+  // Nothing comes or goes until 3.5, so these don't even look.
+  NSUInteger lookupCount = [track lookupCount];
+  for (NSTimeInterval time = 1.1; time < 3.5; time += 0.1) {
+    [track updateWithMediaTime:time];
+  }
+  XCTAssertEqual([track lookupCount], lookupCount);
+  XCTAssertEqual([_enteredTexts count], (NSUInteger)1);
+
+  [track updateWithMediaTime:3.5];
+  XCTAssertEqualObjects([_enteredTexts lastObject], @[ @"Fish & chips <3" ]);
+  XCTAssertEqual([[track activeCues] count], (NSUInteger)2);
+
+  [track updateWithMediaTime:4.5];
+  XCTAssertEqualObjects([_exitedTexts lastObject], @[ @"Once upon a time\nin a land far away" ]);
+
+  // Seeking back.
+  [track updateWithMediaTime:2];
+  XCTAssertEqualObjects([_enteredTexts lastObject], @[ @"Once upon a time\nin a land far away" ]);
+  XCTAssertEqualObjects([_exitedTexts lastObject], @[ @"Fish & chips <3" ]);
+
+  // Seeking to the end, then replaying.
+  [track updateWithMediaTime:3601];
+  XCTAssertEqualObjects([_enteredTexts lastObject], @[ @"The end" ]);
+  [track updateWithMediaTime:0];
+  XCTAssertEqualObjects([_exitedTexts lastObject], @[ @"The end" ]);
+  XCTAssertEqual([[track activeCues] count], (NSUInteger)0);
+  XCTAssertEqual([_enteredTexts count], (NSUInteger)6);
+}
+
+- (void)testSegmentCuesShowWithoutWaitingForAnUpdate {
+  GMFCaptionTrack *track = [[GMFCaptionTrack alloc] init];
+  [track setDelegate:self];
+  [track updateWithMediaTime:5];
+  NSString *segment = @"WEBVTT\n\n00:04.000 --> 00:06.000\nLive\n";
+  [track appendSegmentData:[segment dataUsingEncoding:NSUTF8StringEncoding]];
+  XCTAssertEqualObjects(_enteredTexts, @[ @[ @"Live" ] ]);
+
+  // The next segment repeats the cue, which isn't shown twice.
+  [track appendSegmentData:[segment dataUsingEncoding:NSUTF8StringEncoding]];
+  XCTAssertEqual([[track index] cueCount], (NSUInteger)1);
+  XCTAssertEqual([_enteredTexts count], (NSUInteger)1);
+}
+
+// A live subtitle playlist of 4 second segments, each with a cue in its first half, and a cue
+// running from the second segment into the third and repeated there.
+- (void)testLiveWindowDropsCuesItSlidPast {
+  GMFTestHTTPServer *server = [[GMFTestHTTPServer alloc] init];
+  XCTAssertNotNil(server);
+  for (NSUInteger i = 0; i < 5; i++) {
+    NSString *across = [NSString stringWithFormat:@"%@ --> %@\nAcross\n\n",
+                                                  [self timestamp:7],
+                                                  [self timestamp:9]];
+    NSMutableString *segment = [NSMutableString stringWithString:@"WEBVTT\n\n"];
+    if (i == 2) {
+      [segment appendString:across];
+    }
+    [segment appendFormat:@"%@ --> %@\nSegment %lu\n\n",
+                          [self timestamp:i * 4 + 0.5],
+                          [self timestamp:i * 4 + 2.5],
+                          (unsigned long)i];
+    if (i == 1) {
+      [segment appendString:across];
+    }
+    [server setBody:[segment dataUsingEncoding:NSUTF8StringEncoding]
+           MIMEType:@"text/vtt"
+            forPath:[NSString stringWithFormat:@"/%lu.vtt", (unsigned long)i]];
+  }
+  NSString *playlistFormat =
+      @"#EXTM3U\n#EXT-X-TARGETDURATION:4\n#EXT-X-MEDIA-SEQUENCE:%d\n"
+      @"#EXTINF:4.0,\n%d.vtt\n#EXTINF:4.0,\n%d.vtt\n#EXTINF:4.0,\n%d.vtt\n";
+  [server setBody:[[NSString stringWithFormat:playlistFormat, 0, 0, 1, 2]
+                      dataUsingEncoding:NSUTF8StringEncoding]
+         MIMEType:@"application/vnd.apple.mpegurl"
+          forPath:@"/live.m3u8"];
+
+  GMFVirtualClock *clock = [[GMFVirtualClock alloc] init];
+  GMFCaptionTrack *track = [[GMFCaptionTrack alloc] initWithClock:clock];
+  [track loadWithURL:[NSURL URLWithString:@"/live.m3u8" relativeToURL:[server baseURL]]];
+  [self spinRunLoopUntil:^BOOL {
+      return [[[track index] cuesAtTime:9] count] > 0;
+  }];
+  XCTAssertEqual([[track index] cueCount], (NSUInteger)4);
+
+  // The window slides by two segments.
+  [server setBody:[[NSString stringWithFormat:playlistFormat, 2, 2, 3, 4]
+                      dataUsingEncoding:NSUTF8StringEncoding]
+         MIMEType:@"application/vnd.apple.mpegurl"
+          forPath:@"/live.m3u8"];
+  [clock advanceBy:4];
+  [self spinRunLoopUntil:^BOOL {
+      return [[[track index] cuesAtTime:17] count] > 0;
+  }];
+  XCTAssertEqualObjects([[[track index] cuesAtTime:1] valueForKey:@"text"], @[]);
+  XCTAssertEqualObjects([[[track index] cuesAtTime:5] valueForKey:@"text"], @[]);
+  XCTAssertEqualObjects([[[track index] cuesAtTime:7.5] valueForKey:@"text"], @[ @"Across" ]);
+  XCTAssertEqual([[track index] cueCount], (NSUInteger)4);
+  [track stopLoading];
+  [server stop];
+}
+
+- (void)spinRunLoopUntil:(BOOL (^)(void))condition {
+  NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:5];
+  while (!condition() && [deadline timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode
+                             beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  }
+  XCTAssertTrue(condition());
+}
+
+#pragma mark Benchmarks
+
+- (void)testFeatureLengthTrackParse {
+  NSData *data = [self featureLengthTrack];
+  __block GMFCaptionTrack *track = nil;
+  [self measureBlock:^{
+      track = [[GMFCaptionTrack alloc] init];
+      [track appendData:data];
+      [track finishAppending];
+      // Includes building the tree.
+      [track updateWithMediaTime:0];
+  }];
+  XCTAssertEqual([[track index] cueCount], kFeatureCueCount);
+}
+
+// Playback from start to end with a media time update every frame.
+- (void)testFeatureLengthTrackPlayback {
+  GMFCaptionTrack *track = [[GMFCaptionTrack alloc] init];
+  [track appendData:[self featureLengthTrack]];
+  [track finishAppending];
+  NSUInteger updateCount =
+      (NSUInteger)(kFeatureCueCount * kFeatureCueInterval * kBenchmarkUpdateRate);
+  [self measureBlock:^{
+      for (NSUInteger i = 0; i < updateCount; i++) {
+        [track updateWithMediaTime:(NSTimeInterval)i / kBenchmarkUpdateRate];
+      }
+  }];
+  // Two changes per cue at most, plus the seeks back to the start.
+  XCTAssertLessThan([track lookupCount], kFeatureCueCount * 2 * 11);
+}
+
+- (void)testFeatureLengthTrackRandomLookups {
+  GMFCaptionTrack *track = [[GMFCaptionTrack alloc] init];
+  [track appendData:[self featureLengthTrack]];
+  [track finishAppending];
+  GMFCaptionIndex *index = [track index];
+  NSTimeInterval duration = kFeatureCueCount * kFeatureCueInterval;
+  __block NSUInteger found = 0;
+  [self measureBlock:^{
+      for (NSUInteger i = 0; i < kBenchmarkLookupCount; i++) {
+        found += [[index cuesAtTime:fmod(i * 7919.37, duration)] count];
+      }
+  }];
+  XCTAssertGreaterThan(found, (NSUInteger)0);
+}
+
+@end
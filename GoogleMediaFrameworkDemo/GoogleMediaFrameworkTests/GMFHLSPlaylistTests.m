@@ -0,0 +1,203 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFHLSPlaylist.h>
+
+// Segments in the benchmark playlists: a 16 hour event at 6 second segments.
+static const NSUInteger kBenchmarkSegmentCount = 10000;
+
+static NSString *const kMasterPlaylist =
+    @"#EXTM3U\n"
+    @"#EXT-X-STREAM-INF:BANDWIDTH=1280000,AVERAGE-BANDWIDTH=1000000,"
+    @"CODECS=\"avc1.4d401f,mp4a.40.2\",RESOLUTION=1280x720\n"
+    @"hi/index.m3u8\n"
+    @"#EXT-X-STREAM-INF:BANDWIDTH=640000,RESOLUTION=640x360\r\n"
+    @"lo/index.m3u8\r\n";
+
+@interface GMFHLSPlaylistTests : XCTestCase
+@end
+
+@implementation GMFHLSPlaylistTests {
+ @private
+  NSURL *_baseURL;
+}
+
+- (void)setUp {
+  [super setUp];
+  _baseURL = [NSURL URLWithString:@"https://media.example.com/stream/index.m3u8"];
+}
+
+- (GMFHLSPlaylist *)playlistWithString:(NSString *)string {
+  return [GMFHLSPlaylist playlistWithData:[string dataUsingEncoding:NSUTF8StringEncoding]
+                                  baseURL:_baseURL];
+}
+
+// Media playlist with |count| six second segments and the given extra header lines.
+- (NSMutableString *)mediaPlaylistWithHeader:(NSString *)header segmentCount:(NSUInteger)count {
+  NSMutableString *playlist = [NSMutableString stringWithFormat:
+      @"#EXTM3U\n#EXT-X-TARGETDURATION:6\n#EXT-X-MEDIA-SEQUENCE:100\n%@", header];
+  [self appendSegments:count startingAt:0 toPlaylist:playlist];
+  return playlist;
+}
+
+- (void)appendSegments:(NSUInteger)count
+            startingAt:(NSUInteger)first
+            toPlaylist:(NSMutableString *)playlist {
+  for (NSUInteger i = first; i < first + count; i++) {
+    [playlist appendFormat:@"#EXTINF:6.006,\nsegment%05lu.ts\n", (unsigned long)i];
+  }
+}
+
+- (void)testRejectsNonPlaylists {
+  XCTAssertNil([self playlistWithString:@"<html></html>"]);
+  XCTAssertNil([self playlistWithString:@""]);
+}
+
+- (void)testParsesMasterPlaylist {
+  GMFHLSPlaylist *playlist = [self playlistWithString:kMasterPlaylist];
+
+  XCTAssertTrue([playlist isMasterPlaylist]);
+  XCTAssertEqual([playlist variantCount], (NSUInteger)2);
+  GMFHLSVariant high = [playlist variantAtIndex:0];
+  XCTAssertEqual(high.bandwidth, (NSUInteger)1280000);
+  XCTAssertEqual(high.averageBandwidth, (NSUInteger)1000000);
+  XCTAssertEqual(high.width, (NSUInteger)1280);
+  XCTAssertEqual(high.height, (NSUInteger)720);
+  XCTAssertEqualObjects([[playlist URLForVariantAtIndex:1] absoluteString],
+                        @"https://media.example.com/stream/lo/index.m3u8");
+  XCTAssertEqual([playlist streamType], kGMFHLSStreamTypeUnknown);
+}
+
+- (void)testParsesMediaPlaylist {
+  NSMutableString *string = [self mediaPlaylistWithHeader:@"" segmentCount:3];
+  [string appendString:@"#EXT-X-DISCONTINUITY\n#EXTINF:4.5,\nad.ts\n#EXT-X-ENDLIST\n"];
+  GMFHLSPlaylist *playlist = [self playlistWithString:string];
+
+  XCTAssertFalse([playlist isMasterPlaylist]);
+  XCTAssertEqual([playlist streamType], kGMFHLSStreamTypeVOD);
+  XCTAssertEqual([playlist segmentCount], (NSUInteger)4);
+  XCTAssertEqual([playlist targetDuration], 6.0);
+  XCTAssertEqualWithAccuracy([playlist totalDuration], 3 * 6.006 + 4.5, 1e-9);
+  XCTAssertEqual([playlist discontinuityCount], (NSUInteger)1);
+
+  GMFHLSSegment last = [playlist segmentAtIndex:3];
+  XCTAssertTrue(last.discontinuity);
+  XCTAssertFalse([playlist segmentAtIndex:2].discontinuity);
+  XCTAssertEqual(last.sequenceNumber, (int64_t)103);
+  XCTAssertEqualWithAccuracy(last.startTime, 3 * 6.006, 1e-9);
+  XCTAssertEqualObjects([[playlist URLForSegmentAtIndex:3] absoluteString],
+                        @"https://media.example.com/stream/ad.ts");
+  XCTAssertEqual([playlist segmentIndexForTime:13], (NSUInteger)2);
+  XCTAssertEqual([playlist segmentIndexForTime:-1], (NSUInteger)0);
+  XCTAssertEqual([playlist segmentIndexForTime:1000], (NSUInteger)3);
+}
+
+- (void)testDetectsStreamTypes {
+  GMFHLSPlaylist *live = [self playlistWithString:
+      [self mediaPlaylistWithHeader:@"" segmentCount:5]];
+  XCTAssertEqual([live streamType], kGMFHLSStreamTypeLive);
+  XCTAssertTrue([live isLive]);
+
+  GMFHLSPlaylist *window = [self playlistWithString:
+      [self mediaPlaylistWithHeader:@"" segmentCount:30]];
+  XCTAssertEqual([window streamType], kGMFHLSStreamTypeDVR);
+
+  GMFHLSPlaylist *event = [self playlistWithString:
+      [self mediaPlaylistWithHeader:@"#EXT-X-PLAYLIST-TYPE:EVENT\n" segmentCount:2]];
+  XCTAssertEqual([event streamType], kGMFHLSStreamTypeDVR);
+
+  GMFHLSPlaylist *vod = [self playlistWithString:
+      [self mediaPlaylistWithHeader:@"#EXT-X-PLAYLIST-TYPE:VOD\n" segmentCount:2]];
+  XCTAssertEqual([vod streamType], kGMFHLSStreamTypeVOD);
+  XCTAssertFalse([vod isLive]);
+}
+
+- (void)testLiveSeekableRangeHoldsBackFromTheEdge {
+  GMFHLSPlaylist *live = [self playlistWithString:
+      [self mediaPlaylistWithHeader:@"" segmentCount:30]];
+
+  XCTAssertEqualWithAccuracy([live seekableRange].end, 30 * 6.006 - 3 * 6, 1e-9);
+}
+
+- (void)testAppendOnlyRefreshIsParsedIncrementally {
+  NSMutableString *string =
+      [self mediaPlaylistWithHeader:@"#EXT-X-PLAYLIST-TYPE:EVENT\n" segmentCount:10];
+  GMFHLSPlaylist *first = [self playlistWithString:string];
+  [self appendSegments:2 startingAt:10 toPlaylist:string];
+  [string appendString:@"#EXT-X-ENDLIST\n"];
+
+  GMFHLSPlaylist *refreshed =
+      [GMFHLSPlaylist playlistWithData:[string dataUsingEncoding:NSUTF8StringEncoding]
+                               baseURL:_baseURL
+                      previousPlaylist:first];
+
+  XCTAssertTrue([refreshed isIncrementallyParsed]);
+  XCTAssertEqual([refreshed segmentCount], (NSUInteger)12);
+  XCTAssertEqual([refreshed segmentAtIndex:11].sequenceNumber, (int64_t)111);
+  XCTAssertEqualObjects([[refreshed URLForSegmentAtIndex:11] lastPathComponent],
+                        @"segment00011.ts");
+  XCTAssertEqual([refreshed streamType], kGMFHLSStreamTypeVOD);
+  // The previous playlist is unchanged.
+  XCTAssertEqual([first segmentCount], (NSUInteger)10);
+}
+
+- (void)testSlidingWindowRefreshIsParsedInFull {
+  GMFHLSPlaylist *first = [self playlistWithString:
+      [self mediaPlaylistWithHeader:@"" segmentCount:5]];
+  NSMutableString *string =
+      [NSMutableString stringWithString:@"#EXTM3U\n#EXT-X-TARGETDURATION:6\n"
+                                        @"#EXT-X-MEDIA-SEQUENCE:101\n"];
+  [self appendSegments:5 startingAt:1 toPlaylist:string];
+
+  GMFHLSPlaylist *refreshed =
+      [GMFHLSPlaylist playlistWithData:[string dataUsingEncoding:NSUTF8StringEncoding]
+                               baseURL:_baseURL
+                      previousPlaylist:first];
+
+  XCTAssertFalse([refreshed isIncrementallyParsed]);
+  XCTAssertEqual([refreshed mediaSequence], (int64_t)101);
+  XCTAssertEqual([refreshed segmentAtIndex:0].sequenceNumber, (int64_t)101);
+}
+
+#pragma mark Benchmarks
+
+- (void)testBenchmarkParseLargePlaylist {
+  NSData *data = [[self mediaPlaylistWithHeader:@"#EXT-X-PLAYLIST-TYPE:VOD\n"
+                                   segmentCount:kBenchmarkSegmentCount]
+      dataUsingEncoding:NSUTF8StringEncoding];
+  [self measureBlock:^{
+      GMFHLSPlaylist *playlist = [GMFHLSPlaylist playlistWithData:data baseURL:_baseURL];
+      XCTAssertEqual([playlist segmentCount], kBenchmarkSegmentCount);
+  }];
+}
+
+- (void)testBenchmarkRefreshLargeEventPlaylist {
+  NSMutableString *string = [self mediaPlaylistWithHeader:@"#EXT-X-PLAYLIST-TYPE:EVENT\n"
+                                             segmentCount:kBenchmarkSegmentCount];
+  GMFHLSPlaylist *previous =
+      [GMFHLSPlaylist playlistWithData:[string dataUsingEncoding:NSUTF8StringEncoding]
+                               baseURL:_baseURL];
+  [self appendSegments:1 startingAt:kBenchmarkSegmentCount toPlaylist:string];
+  NSData *refresh = [string dataUsingEncoding:NSUTF8StringEncoding];
+  [self measureBlock:^{
+      GMFHLSPlaylist *playlist = [GMFHLSPlaylist playlistWithData:refresh
+                                                          baseURL:_baseURL
+                                                 previousPlaylist:previous];
+      XCTAssertEqual([playlist segmentCount], kBenchmarkSegmentCount + 1);
+  }];
+}
+
+@end
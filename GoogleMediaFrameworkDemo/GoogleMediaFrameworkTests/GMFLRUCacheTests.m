@@ -0,0 +1,96 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFLRUCache.h>
+
+@interface GMFLRUCacheTests : XCTestCase
+@end
+
+@implementation GMFLRUCacheTests {
+ @private
+  GMFLRUCache *_cache;
+}
+
+- (void)setUp {
+  [super setUp];
+  _cache = [[GMFLRUCache alloc] initWithCostLimit:100];
+}
+
+- (void)tearDown {
+  _cache = nil;
+  [super tearDown];
+}
+
+- (void)testHitsAndMissesAreCounted {
+  [_cache setObject:@"a" forKey:@"a" cost:10];
+
+  XCTAssertEqualObjects([_cache objectForKey:@"a"], @"a");
+  XCTAssertNil([_cache objectForKey:@"b"]);
+  XCTAssertEqualObjects([_cache objectForKey:@"a"], @"a");
+
+  XCTAssertEqual([_cache hitCount], 2);
+  XCTAssertEqual([_cache missCount], 1);
+
+  [_cache resetStatistics];
+  XCTAssertEqual([_cache hitCount], 0);
+}
+
+- (void)testEvictsLeastRecentlyUsedFirst {
+  [_cache setObject:@"a" forKey:@"a" cost:40];
+  [_cache setObject:@"b" forKey:@"b" cost:40];
+  // Touch "a" so "b" becomes the least recently used entry.
+  [_cache objectForKey:@"a"];
+
+  [_cache setObject:@"c" forKey:@"c" cost:40];
+
+  XCTAssertNotNil([_cache objectForKey:@"a"]);
+  XCTAssertNil([_cache objectForKey:@"b"]);
+  XCTAssertNotNil([_cache objectForKey:@"c"]);
+  XCTAssertEqual([_cache totalCost], 80);
+  XCTAssertEqual([_cache evictionCount], 1);
+}
+
+- (void)testReplacingAnEntryUpdatesTheCost {
+  [_cache setObject:@"a" forKey:@"a" cost:40];
+  [_cache setObject:@"a2" forKey:@"a" cost:10];
+
+  XCTAssertEqual([_cache count], 1);
+  XCTAssertEqual([_cache totalCost], 10);
+  XCTAssertEqualObjects([_cache objectForKey:@"a"], @"a2");
+}
+
+- (void)testOversizedEntryIsNotStored {
+  [_cache setObject:@"a" forKey:@"a" cost:10];
+  [_cache setObject:@"huge" forKey:@"huge" cost:101];
+
+  XCTAssertNil([_cache objectForKey:@"huge"]);
+  XCTAssertNotNil([_cache objectForKey:@"a"]);
+}
+
+- (void)testLoweringTheLimitEvicts {
+  for (NSUInteger i = 0; i < 10; i++) {
+    [_cache setObject:@(i) forKey:@(i) cost:10];
+  }
+
+  [_cache setCostLimit:30];
+
+  XCTAssertEqual([_cache count], 3);
+  XCTAssertEqual([_cache totalCost], 30);
+  XCTAssertNotNil([_cache objectForKey:@9]);
+  XCTAssertNil([_cache objectForKey:@0]);
+}
+
+@end
@@ -0,0 +1,224 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFLiveLatencyController.h>
+#import <GoogleMediaFramework/GMFSimulatedPlaybackBackend.h>
+#import <GoogleMediaFramework/GMFVirtualClock.h>
+
+// A live stream whose playlist is refreshed a segment at a time, with a one minute DVR window.
+static const NSTimeInterval kLiveEdgeStartTime = 100;
+static const NSTimeInterval kSegmentDuration = 6;
+static const NSTimeInterval kWindowDuration = 60;
+static const NSTimeInterval kTargetLatency = 3;
+static const NSTimeInterval kAccuracy = 1e-6;
+
+@interface GMFLiveLatencyControllerTests : XCTestCase<GMFLiveLatencyControllerDelegate>
+@end
+
+@implementation GMFLiveLatencyControllerTests {
+ @private
+  GMFVirtualClock *_clock;
+  GMFSimulatedPlaybackBackend *_backend;
+  GMFLiveLatencyController *_controller;
+  float _lowestRate;
+  float _highestRate;
+}
+
+- (void)setUp {
+  [super setUp];
+  _clock = [[GMFVirtualClock alloc] init];
+  _backend = [[GMFSimulatedPlaybackBackend alloc] initWithClock:_clock duration:0];
+  [_backend setLiveEdgeStartTime:kLiveEdgeStartTime];
+  [_backend setLiveSegmentDuration:kSegmentDuration];
+  [_backend setLiveWindowDuration:kWindowDuration];
+  _controller = [[GMFLiveLatencyController alloc] initWithClock:_clock];
+  [_controller setDelegate:self];
+  [_controller setTargetLatency:kTargetLatency];
+  _lowestRate = 1;
+  _highestRate = 1;
+}
+
+- (void)liveLatencyController:(GMFLiveLatencyController *)controller
+        didChangePlaybackRate:(float)rate {
+  _lowestRate = MIN(_lowestRate, rate);
+  _highestRate = MAX(_highestRate, rate);
+  [_backend setPlaybackRate:rate];
+}
+
+- (void)liveLatencyController:(GMFLiveLatencyController *)controller
+             shouldJumpToTime:(NSTimeInterval)time {
+  [self seekToTime:time];
+}
+
+- (void)seekToTime:(NSTimeInterval)time {
+  [_backend seekToTime:time tolerance:0 completionHandler:^(BOOL finished) {}];
+}
+
+// Loads the stream and plays it from the live point, or from the target latency behind it.
+- (void)loadAndPlayAtTarget:(BOOL)atTarget {
+  [_backend load];
+  [_clock advanceBy:0];
+  [_controller updateSeekableRange:[_backend seekableTimeRange]];
+  if (atTarget) {
+    [self seekToTime:[_controller liveTargetTime]];
+    [_clock advanceBy:0];
+  }
+  [_backend play];
+}
+
+// Plays for |seconds|, updating the controller every second the way GMFVideoPlayer does, and
+// resuming after stalls the way the state machine does.
+- (void)playFor:(NSUInteger)seconds {
+  for (NSUInteger i = 0; i < seconds; i++) {
+    [_clock advanceBy:1];
+    if ([_backend rate] == 0 && [_backend isPlaybackLikelyToKeepUp]) {
+      [_backend play];
+    }
+    [_controller updateSeekableRange:[_backend seekableTimeRange]];
+    [_controller updateWithMediaTime:[_backend currentTime]];
+  }
+}
+
+- (void)testLiveEdgeAdvancesBetweenRefreshes {
+  [self loadAndPlayAtTarget:YES];
+  [self playFor:9];
+  // The playlist last moved the window at 6 seconds.
+  XCTAssertEqualWithAccuracy([_controller seekableRange].end, kLiveEdgeStartTime + 6, kAccuracy);
+  XCTAssertEqualWithAccuracy([_controller liveEdgeTime], kLiveEdgeStartTime + 9, kAccuracy);
+  XCTAssertEqualWithAccuracy([_controller latency], kTargetLatency, kAccuracy);
+
+  // Without refreshes the estimate stops a segment past the window.
+  [_clock advanceBy:20];
+  XCTAssertEqualWithAccuracy([_controller liveEdgeTime], kLiveEdgeStartTime + 12, kAccuracy);
+}
+
+- (void)testJoiningAtTargetNeedsNoCorrection {
+  [self loadAndPlayAtTarget:YES];
+  [self playFor:120];
+  XCTAssertTrue([_controller isTracking]);
+  XCTAssertEqual([_controller rateChangeCount], (NSUInteger)0);
+  XCTAssertEqual([_controller jumpCount], (NSUInteger)0);
+  GMFLatencyHistogram *histogram = [_controller latencyHistogram];
+  XCTAssertEqual([histogram count], (uint64_t)120);
+  XCTAssertEqualWithAccuracy([histogram maximum], kTargetLatency, 0.01 * kTargetLatency);
+}
+
+- (void)testSlowsDownToFallBackToTarget {
+  [self loadAndPlayAtTarget:NO];
+  [self playFor:10];
+  XCTAssertEqual([_controller playbackRate], [_controller minimumRate]);
+
+  [self playFor:110];
+  XCTAssertEqual([_controller playbackRate], 1.0f);
+  XCTAssertEqual([_backend rate], 1.0f);
+  XCTAssertEqualWithAccuracy([_controller latency], kTargetLatency, [_controller tolerance]);
+  XCTAssertEqual(_lowestRate, [_controller minimumRate]);
+  XCTAssertEqual([_controller jumpCount], (NSUInteger)0);
+}
+
+- (void)testCatchesUpAfterShortStall {
+  [_backend addStallAtTime:kLiveEdgeStartTime + 10 duration:2];
+  [self loadAndPlayAtTarget:YES];
+  [self playFor:15];
+  // Still stalled: speeding up wouldn't help yet.
+  XCTAssertEqual([_controller playbackRate], 1.0f);
+  XCTAssertEqualWithAccuracy([_controller latency], kTargetLatency + 2, kAccuracy);
+
+  [self playFor:5];
+  XCTAssertEqual([_controller playbackRate], [_controller maximumRate]);
+  XCTAssertEqual([_backend rate], [_controller maximumRate]);
+
+  [self playFor:100];
+  XCTAssertEqual([_controller playbackRate], 1.0f);
+  XCTAssertEqualWithAccuracy([_controller latency], kTargetLatency, [_controller tolerance]);
+  XCTAssertEqual(_highestRate, [_controller maximumRate]);
+  XCTAssertEqual(_lowestRate, 1.0f);
+  XCTAssertEqual([_controller jumpCount], (NSUInteger)0);
+}
+
+- (void)testJumpsAfterLongStall {
+  [_backend addStallAtTime:kLiveEdgeStartTime + 10 duration:20];
+  [self loadAndPlayAtTarget:YES];
+  [self playFor:33];
+  // Far behind, but no jump while nothing plays.
+  XCTAssertGreaterThan([_controller latency], kTargetLatency + [_controller jumpThreshold]);
+  XCTAssertEqual([_controller jumpCount], (NSUInteger)0);
+
+  [self playFor:1];
+  XCTAssertEqual([_controller jumpCount], (NSUInteger)1);
+  XCTAssertEqual([_backend seekCount], (NSUInteger)2);
+  // The jump lands as close to the target as the window allows.
+  [self playFor:1];
+  XCTAssertLessThan([_controller latency], kTargetLatency + 2);
+
+  [self playFor:60];
+  XCTAssertEqual([_controller jumpCount], (NSUInteger)1);
+  XCTAssertEqual([_controller playbackRate], 1.0f);
+  XCTAssertEqualWithAccuracy([_controller latency], kTargetLatency, [_controller tolerance]);
+}
+
+- (void)testViewerWatchingBehindLiveIsLeftAlone {
+  [self loadAndPlayAtTarget:YES];
+  [self playFor:20];
+  [_controller viewerDidMovePlayhead];
+  [self seekToTime:kLiveEdgeStartTime - 40];
+  [_clock advanceBy:0];
+  [self playFor:20];
+  XCTAssertFalse([_controller isTracking]);
+  XCTAssertGreaterThan([_controller latency], [_controller jumpThreshold]);
+  XCTAssertEqual([_controller jumpCount], (NSUInteger)0);
+  XCTAssertEqual([_controller rateChangeCount], (NSUInteger)0);
+  XCTAssertEqual([[_controller latencyHistogram] count], (uint64_t)20);
+
+  // Back to live.
+  [_controller viewerDidMovePlayhead];
+  [self seekToTime:[_controller liveTargetTime]];
+  [_clock advanceBy:0];
+  [self playFor:1];
+  XCTAssertTrue([_controller isTracking]);
+  // The window ends a little short of the estimated edge.
+  XCTAssertLessThan([_controller latency], kTargetLatency + 2);
+}
+
+- (void)testLiveTargetTimeStaysInWindow {
+  XCTAssertFalse([_controller isTracking]);
+  XCTAssertEqual([_controller liveEdgeTime], 0.0);
+  [self loadAndPlayAtTarget:NO];
+  GMFTimeRange window = [_controller seekableRange];
+  XCTAssertEqualWithAccuracy(window.start, kLiveEdgeStartTime - kWindowDuration, kAccuracy);
+
+  [_controller setTargetLatency:kWindowDuration * 2];
+  XCTAssertEqualWithAccuracy([_controller liveTargetTime], window.start, kAccuracy);
+  [_controller setTargetLatency:0];
+  XCTAssertEqualWithAccuracy([_controller liveTargetTime], window.end, kAccuracy);
+}
+
+- (void)testReset {
+  [self loadAndPlayAtTarget:NO];
+  [self playFor:10];
+  XCTAssertNotEqual([_controller playbackRate], 1.0f);
+  [_controller reset];
+  XCTAssertFalse([_controller isTracking]);
+  XCTAssertEqual([_controller playbackRate], 1.0f);
+  XCTAssertEqual([_controller rateChangeCount], (NSUInteger)0);
+  XCTAssertEqual([[_controller latencyHistogram] count], (uint64_t)0);
+  // Updates before the next window are ignored.
+  [_controller updateWithMediaTime:[_backend currentTime]];
+  XCTAssertEqual([_controller latency], 0.0);
+}
+
+@end
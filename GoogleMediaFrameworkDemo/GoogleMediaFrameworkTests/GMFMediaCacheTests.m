@@ -0,0 +1,336 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFMediaCache.h>
+#import <GoogleMediaFramework/GMFMediaCacheResourceLoader.h>
+
+#import "GMFTestHTTPServer.h"
+
+static const NSUInteger kSlabSize = 64 * 1024;
+
+static NSString *const kMediaPlaylist =
+    @"#EXTM3U\n"
+    @"#EXT-X-TARGETDURATION:6\n"
+    @"#EXTINF:6.0,\n"
+    @"segment0.ts\n"
+    @"#EXTINF:6.0,\n"
+    @"http://other.example.com/segment1.ts\n"
+    @"#EXT-X-ENDLIST\n";
+
+@interface GMFMediaCacheTests : XCTestCase
+@end
+
+@implementation GMFMediaCacheTests {
+ @private
+  GMFTestHTTPServer *_server;
+  NSString *_directory;
+  GMFMediaCache *_cache;
+  NSData *_segment;
+}
+
+- (void)setUp {
+  [super setUp];
+  _server = [[GMFTestHTTPServer alloc] init];
+  XCTAssertNotNil(_server);
+  NSMutableData *segment = [NSMutableData dataWithLength:20000];
+  uint8_t *bytes = [segment mutableBytes];
+  for (NSUInteger i = 0; i < [segment length]; i++) {
+    bytes[i] = (uint8_t)(i * 31);
+  }
+  _segment = segment;
+  [_server setBody:_segment MIMEType:@"video/mp2t" forPath:@"/segment0.ts"];
+  [_server setBody:[kMediaPlaylist dataUsingEncoding:NSUTF8StringEncoding]
+          MIMEType:@"application/vnd.apple.mpegurl"
+           forPath:@"/index.m3u8"];
+  _directory = [NSTemporaryDirectory() stringByAppendingPathComponent:
+      [NSString stringWithFormat:@"GMFMediaCacheTests-%@", [[NSUUID UUID] UUIDString]]];
+  _cache = [self openCacheWithBudget:4 * kSlabSize];
+}
+
+- (void)tearDown {
+  _cache = nil;
+  [_server stop];
+  [[NSFileManager defaultManager] removeItemAtPath:_directory error:NULL];
+  [super tearDown];
+}
+
+- (GMFMediaCache *)openCacheWithBudget:(uint64_t)budget {
+  return [[GMFMediaCache alloc] initWithDirectory:_directory
+                                       diskBudget:budget
+                                         slabSize:kSlabSize];
+}
+
+- (NSURL *)URLForPath:(NSString *)path {
+  return [NSURL URLWithString:path relativeToURL:[_server baseURL]];
+}
+
+// Loads |range| of |URL| through |cache|, spinning the run loop until it completes.
+- (GMFMediaCacheResponse *)loadURL:(NSURL *)URL
+                             range:(GMFByteRange)range
+                           inCache:(GMFMediaCache *)cache
+                             error:(NSError **)error {
+  __block BOOL done = NO;
+  __block GMFMediaCacheResponse *result = nil;
+  __block NSError *resultError = nil;
+  [cache loadURL:URL range:range completion:^(GMFMediaCacheResponse *response, NSError *error) {
+      result = response;
+      resultError = error;
+      done = YES;
+  }];
+  NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:5];
+  while (!done && [deadline timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode
+                             beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+  }
+  XCTAssertTrue(done);
+  if (error) {
+    *error = resultError;
+  }
+  return result;
+}
+
+- (GMFMediaCacheResponse *)loadPath:(NSString *)path range:(GMFByteRange)range {
+  return [self loadURL:[self URLForPath:path] range:range inCache:_cache error:NULL];
+}
+
+- (void)testMissThenHitDoesNotDownloadAgain {
+  GMFByteRange range = GMFByteRangeMake(1000, 5000);
+  NSData *expected = [_segment subdataWithRange:NSMakeRange(1000, 5000)];
+
+  GMFMediaCacheResponse *miss = [self loadPath:@"/segment0.ts" range:range];
+  XCTAssertFalse([miss isFromCache]);
+  XCTAssertEqualObjects([miss data], expected);
+  XCTAssertEqual([miss totalLength], (int64_t)20000);
+  XCTAssertEqual([_server requestCount], (NSUInteger)1);
+
+  GMFMediaCacheResponse *hit = [self loadPath:@"/segment0.ts" range:range];
+  XCTAssertTrue([hit isFromCache]);
+  XCTAssertEqualObjects([hit data], expected);
+  XCTAssertEqualObjects([hit MIMEType], @"video/mp2t");
+  XCTAssertEqual([hit totalLength], (int64_t)20000);
+  XCTAssertEqual([_server requestCount], (NSUInteger)1);
+
+  XCTAssertEqual([_cache hitCount], (NSUInteger)1);
+  XCTAssertEqual([_cache missCount], (NSUInteger)1);
+  XCTAssertEqual([_cache bytesSaved], (uint64_t)5000);
+  XCTAssertEqual([_cache bytesStored], (uint64_t)5000);
+  XCTAssertEqualWithAccuracy([_cache hitRatio], 0.5, 1e-9);
+
+  // A different range of the same URL is a different response.
+  [self loadPath:@"/segment0.ts" range:GMFByteRangeMake(0, 1000)];
+  XCTAssertEqual([_server requestCount], (NSUInteger)2);
+}
+
+- (void)testServerIgnoringRangeIsSliced {
+  [_server setIgnoresRanges:YES];
+  GMFMediaCacheResponse *response =
+      [self loadPath:@"/segment0.ts" range:GMFByteRangeMake(19000, kGMFByteRangeToEnd)];
+  XCTAssertEqualObjects([response data], [_segment subdataWithRange:NSMakeRange(19000, 1000)]);
+  XCTAssertEqual([response totalLength], (int64_t)20000);
+}
+
+- (void)testHTTPErrorIsReported {
+  NSError *error = nil;
+  GMFMediaCacheResponse *response = [self loadURL:[self URLForPath:@"/missing.ts"]
+                                            range:GMFByteRangeMake(0, kGMFByteRangeToEnd)
+                                          inCache:_cache
+                                            error:&error];
+  XCTAssertNil(response);
+  XCTAssertEqualObjects([error domain], kGMFMediaCacheErrorDomain);
+  XCTAssertEqual([error code], (NSInteger)kGMFMediaCacheErrorHTTPStatus);
+  XCTAssertEqualObjects([[error userInfo] objectForKey:kGMFMediaCacheHTTPStatusCodeKey], @404);
+  XCTAssertEqual([_cache responseCount], (NSUInteger)0);
+}
+
+// A download far larger than a slab, held up halfway, is handed out as it arrives and isn't kept.
+- (void)testStreamedLoadDeliversBeforeCompletion {
+  NSMutableData *file = [NSMutableData dataWithLength:4 * kSlabSize];
+  memset([file mutableBytes], 0x5a, [file length]);
+  [_server setBody:file MIMEType:@"video/mp4" forPath:@"/movie.mp4"];
+  [_server setBodyDelay:0.5];
+
+  NSMutableData *received = [NSMutableData data];
+  __block NSDate *firstData = nil;
+  __block NSDate *finished = nil;
+  __block int64_t totalLength = 0;
+  __block NSError *streamError = nil;
+  [_cache streamURL:[self URLForPath:@"/movie.mp4"]
+                range:GMFByteRangeMake(0, kGMFByteRangeToEnd)
+      responseHandler:^(NSString *MIMEType, int64_t length) {
+          totalLength = length;
+      }
+          dataHandler:^(NSData *data) {
+          if (!firstData) {
+            firstData = [NSDate date];
+          }
+          [received appendData:data];
+      }
+           completion:^(NSError *error) {
+          streamError = error;
+          finished = [NSDate date];
+      }];
+  NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:5];
+  while (!finished && [deadline timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode
+                             beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  }
+  XCTAssertNotNil(finished);
+  XCTAssertNil(streamError);
+  XCTAssertEqual(totalLength, (int64_t)[file length]);
+  XCTAssertEqualObjects(received, file);
+  XCTAssertGreaterThan([finished timeIntervalSinceDate:firstData], 0.3);
+  XCTAssertEqual([_cache responseCount], (NSUInteger)0);
+}
+
+- (void)testCancelledStreamNeverCompletes {
+  [_server setBodyDelay:0.3];
+  __block NSUInteger dataCount = 0;
+  __block BOOL completed = NO;
+  __block id load = nil;
+  GMFMediaCache *cache = _cache;
+  load = [_cache streamURL:[self URLForPath:@"/segment0.ts"]
+                     range:GMFByteRangeMake(0, kGMFByteRangeToEnd)
+           responseHandler:^(NSString *MIMEType, int64_t length) {}
+               dataHandler:^(NSData *data) {
+               dataCount++;
+               [cache cancelLoad:load];
+           }
+                completion:^(NSError *error) {
+               completed = YES;
+           }];
+  XCTAssertNotNil(load);
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.6]];
+  XCTAssertEqual(dataCount, (NSUInteger)1);
+  XCTAssertFalse(completed);
+  XCTAssertEqual([_cache responseCount], (NSUInteger)0);
+  // The data handler holds the load.
+  load = nil;
+}
+
+- (void)testResponsesSurviveReopening {
+  GMFByteRange range = GMFByteRangeMake(0, kGMFByteRangeToEnd);
+  [self loadPath:@"/segment0.ts" range:range];
+  _cache = nil;
+
+  GMFMediaCache *reopened = [self openCacheWithBudget:4 * kSlabSize];
+  XCTAssertEqual([reopened responseCount], (NSUInteger)1);
+  GMFMediaCacheResponse *hit = [self loadURL:[self URLForPath:@"/segment0.ts"]
+                                       range:range
+                                     inCache:reopened
+                                       error:NULL];
+  XCTAssertTrue([hit isFromCache]);
+  XCTAssertEqualObjects([hit data], _segment);
+  XCTAssertEqual([_server requestCount], (NSUInteger)1);
+}
+
+- (void)testLeastRecentlyUsedSlabIsEvicted {
+  // Three 20 KB responses fill a 64 KB slab, so every third store opens a new slab.
+  GMFMediaCache *cache = [self openCacheWithBudget:2 * kSlabSize];
+  NSURL *base = [NSURL URLWithString:@"http://media.example.com/"];
+  for (NSUInteger i = 0; i < 6; i++) {
+    NSURL *URL = [NSURL URLWithString:[NSString stringWithFormat:@"%lu.ts", (unsigned long)i]
+                        relativeToURL:base];
+    XCTAssertTrue([cache storeData:_segment
+                          MIMEType:@"video/mp2t"
+                       totalLength:20000
+                            forURL:URL
+                             range:GMFByteRangeMake(0, kGMFByteRangeToEnd)]);
+  }
+  XCTAssertEqual([cache diskUsage], (uint64_t)(2 * kSlabSize));
+  XCTAssertEqual([cache responseCount], (NSUInteger)6);
+
+  // The seventh response needs a third slab, which evicts the first one with 0-2.ts.
+  XCTAssertTrue([cache storeData:_segment
+                        MIMEType:@"video/mp2t"
+                     totalLength:20000
+                          forURL:[NSURL URLWithString:@"6.ts" relativeToURL:base]
+                           range:GMFByteRangeMake(0, kGMFByteRangeToEnd)]);
+  XCTAssertEqual([cache diskUsage], (uint64_t)(2 * kSlabSize));
+  XCTAssertEqual([cache responseCount], (NSUInteger)4);
+  GMFByteRange whole = GMFByteRangeMake(0, kGMFByteRangeToEnd);
+  XCTAssertNil([cache cachedResponseForURL:[NSURL URLWithString:@"0.ts" relativeToURL:base]
+                                     range:whole]);
+  XCTAssertNotNil([cache cachedResponseForURL:[NSURL URLWithString:@"3.ts" relativeToURL:base]
+                                        range:whole]);
+
+  // Lowering the budget evicts immediately; below one slab nothing is stored.
+  [cache setDiskBudget:kSlabSize - 1];
+  XCTAssertEqual([cache diskUsage], (uint64_t)0);
+  XCTAssertEqual([cache responseCount], (NSUInteger)0);
+  XCTAssertFalse([cache storeData:_segment
+                         MIMEType:@"video/mp2t"
+                      totalLength:20000
+                           forURL:[NSURL URLWithString:@"7.ts" relativeToURL:base]
+                            range:whole]);
+}
+
+- (void)testHitDataOutlivesEviction {
+  NSURL *URL = [NSURL URLWithString:@"http://media.example.com/0.ts"];
+  GMFByteRange whole = GMFByteRangeMake(0, kGMFByteRangeToEnd);
+  [_cache storeData:_segment MIMEType:@"video/mp2t" totalLength:20000 forURL:URL range:whole];
+  NSData *data = [[_cache cachedResponseForURL:URL range:whole] data];
+  [_cache removeAllResponses];
+  XCTAssertEqualObjects(data, _segment);
+}
+
+- (void)testPlaylistsAreNotStored {
+  GMFByteRange whole = GMFByteRangeMake(0, kGMFByteRangeToEnd);
+  [self loadPath:@"/index.m3u8" range:whole];
+  [self loadPath:@"/index.m3u8" range:whole];
+  XCTAssertEqual([_server requestCount], (NSUInteger)2);
+  XCTAssertEqual([_cache responseCount], (NSUInteger)0);
+  XCTAssertFalse([_cache storeData:[kMediaPlaylist dataUsingEncoding:NSUTF8StringEncoding]
+                          MIMEType:@"application/x-mpegURL"
+                       totalLength:-1
+                            forURL:[self URLForPath:@"/live"]
+                             range:whole]);
+}
+
+- (void)testPlaylistRewriting {
+  NSURL *playlistURL = [NSURL URLWithString:@"https://media.example.com/stream/index.m3u8"];
+  NSData *rewritten = [GMFMediaCacheResourceLoader
+      rewritePlaylistData:[kMediaPlaylist dataUsingEncoding:NSUTF8StringEncoding]
+                  fromURL:playlistURL];
+  NSString *expected =
+      @"#EXTM3U\n"
+      @"#EXT-X-TARGETDURATION:6\n"
+      @"#EXTINF:6.0,\n"
+      @"https://media.example.com/stream/segment0.ts\n"
+      @"#EXTINF:6.0,\n"
+      @"http://other.example.com/segment1.ts\n"
+      @"#EXT-X-ENDLIST\n";
+  XCTAssertEqualObjects([[NSString alloc] initWithData:rewritten encoding:NSUTF8StringEncoding],
+                        expected);
+
+  // Variant playlists go through the loader; their segments are made absolute in turn.
+  NSData *master = [@"#EXTM3U\n#EXT-X-STREAM-INF:BANDWIDTH=800000\nlow/index.m3u8\n"
+      dataUsingEncoding:NSUTF8StringEncoding];
+  rewritten = [GMFMediaCacheResourceLoader rewritePlaylistData:master fromURL:playlistURL];
+  XCTAssertEqualObjects(
+      [[NSString alloc] initWithData:rewritten encoding:NSUTF8StringEncoding],
+      @"#EXTM3U\n#EXT-X-STREAM-INF:BANDWIDTH=800000\n"
+      @"gmfcache-https://media.example.com/stream/low/index.m3u8\n");
+
+  NSURL *cacheURL = [GMFMediaCacheResourceLoader cacheURLForURL:playlistURL];
+  XCTAssertEqualObjects([cacheURL scheme], @"gmfcache-https");
+  XCTAssertEqualObjects([GMFMediaCacheResourceLoader originalURLForURL:cacheURL], playlistURL);
+  XCTAssertNil([GMFMediaCacheResourceLoader originalURLForURL:playlistURL]);
+
+  NSURL *fileURL = [NSURL fileURLWithPath:@"/tmp/video.mp4"];
+  XCTAssertEqualObjects([GMFMediaCacheResourceLoader cacheURLForURL:fileURL], fileURL);
+}
+
+@end
@@ -0,0 +1,193 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFLRUCache.h>
+#import <GoogleMediaFramework/GMFMemoryGovernor.h>
+#import <GoogleMediaFramework/GMFPlayerPool.h>
+#import <GoogleMediaFramework/GMFVideoPlayer.h>
+#import <GoogleMediaFramework/GMFVirtualClock.h>
+
+// Records the levels it is asked to trim for.
+@interface GMFRecordingResponder : NSObject<GMFMemoryPressureResponder>
+
+@property(nonatomic, assign) uint64_t cost;
+@property(nonatomic, readonly) NSMutableArray *levels;
+
+@end
+
+@implementation GMFRecordingResponder
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _levels = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (void)trimMemoryForPressureLevel:(GMFMemoryPressureLevel)level {
+  [_levels addObject:@(level)];
+}
+
+- (uint64_t)estimatedMemoryCost {
+  return _cost;
+}
+
+@end
+
+@interface GMFMemoryGovernorTests : XCTestCase
+@end
+
+@implementation GMFMemoryGovernorTests {
+ @private
+  GMFVirtualClock *_clock;
+  GMFMemoryGovernor *_governor;
+}
+
+- (void)setUp {
+  [super setUp];
+  _clock = [[GMFVirtualClock alloc] init];
+  _governor = [[GMFMemoryGovernor alloc] initWithClock:_clock];
+}
+
+- (void)testRespondersAreToldEveryLevel {
+  GMFRecordingResponder *responder = [[GMFRecordingResponder alloc] init];
+  GMFRecordingResponder *removed = [[GMFRecordingResponder alloc] init];
+  [_governor addResponder:responder];
+  [_governor addResponder:removed];
+  [_governor removeResponder:removed];
+
+  [_governor handleMemoryPressureLevel:kGMFMemoryPressureLevelWarning];
+  XCTAssertEqual([_governor currentLevel], kGMFMemoryPressureLevelWarning);
+  [_governor handleMemoryPressureLevel:kGMFMemoryPressureLevelCritical];
+  [_governor handleMemoryPressureLevel:kGMFMemoryPressureLevelNormal];
+  XCTAssertEqualObjects([responder levels], (@[ @(kGMFMemoryPressureLevelWarning),
+                                                @(kGMFMemoryPressureLevelCritical),
+                                                @(kGMFMemoryPressureLevelNormal) ]));
+  XCTAssertEqual([[removed levels] count], (NSUInteger)0);
+  XCTAssertEqual([_governor warningCount], (NSUInteger)1);
+  XCTAssertEqual([_governor criticalCount], (NSUInteger)1);
+}
+
+- (void)testRespondersAreHeldWeakly {
+  @autoreleasepool {
+    [_governor addResponder:[[GMFRecordingResponder alloc] init]];
+  }
+  XCTAssertEqual([[_governor responders] count], (NSUInteger)0);
+  [_governor handleMemoryPressureLevel:kGMFMemoryPressureLevelCritical];
+}
+
+- (void)testLevelRelaxesToNormal {
+  GMFRecordingResponder *responder = [[GMFRecordingResponder alloc] init];
+  [_governor addResponder:responder];
+  [_governor setRelaxInterval:30];
+
+  [_governor handleMemoryPressureLevel:kGMFMemoryPressureLevelWarning];
+  [_clock advanceBy:20];
+  // A further warning restarts the interval.
+  [_governor handleMemoryPressureLevel:kGMFMemoryPressureLevelCritical];
+  [_clock advanceBy:20];
+  XCTAssertEqual([_governor currentLevel], kGMFMemoryPressureLevelCritical);
+  [_clock advanceBy:10];
+  XCTAssertEqual([_governor currentLevel], kGMFMemoryPressureLevelNormal);
+  XCTAssertEqualObjects([[responder levels] lastObject], @(kGMFMemoryPressureLevelNormal));
+  XCTAssertEqual([_clock pendingCount], (NSUInteger)0);
+}
+
+- (void)testEstimatedMemoryCostSumsResponders {
+  GMFRecordingResponder *first = [[GMFRecordingResponder alloc] init];
+  GMFRecordingResponder *second = [[GMFRecordingResponder alloc] init];
+  [first setCost:1000];
+  [second setCost:234];
+  [_governor addResponder:first];
+  [_governor addResponder:second];
+  XCTAssertEqual([_governor estimatedMemoryCost], (uint64_t)1234);
+
+  // An empty player holds no media.
+  GMFVideoPlayer *player = [[GMFVideoPlayer alloc] initWithClock:_clock];
+  [_governor addResponder:player];
+  XCTAssertEqual([player estimatedMemoryCost], (uint64_t)0);
+  XCTAssertEqual([_governor estimatedMemoryCost], (uint64_t)1234);
+}
+
+- (void)testPlayerFollowsLevel {
+  GMFVideoPlayer *player = [[GMFVideoPlayer alloc] initWithClock:_clock];
+  [_governor addResponder:player];
+  [_governor handleMemoryPressureLevel:kGMFMemoryPressureLevelCritical];
+  XCTAssertEqual([player memoryPressureLevel], kGMFMemoryPressureLevelCritical);
+  // Nothing loaded, so there is no pipeline to release.
+  XCTAssertFalse([player isPipelineReleased]);
+  [_clock advanceBy:[_governor relaxInterval]];
+  XCTAssertEqual([player memoryPressureLevel], kGMFMemoryPressureLevelNormal);
+}
+
+- (void)testCacheTrimsInTiers {
+  GMFLRUCache *cache = [[GMFLRUCache alloc] initWithCostLimit:100];
+  for (NSUInteger i = 0; i < 10; i++) {
+    [cache setObject:@(i) forKey:@(i) cost:10];
+  }
+  [cache objectForKey:@(0)];
+  [_governor addResponder:cache];
+  XCTAssertEqual([_governor estimatedMemoryCost], (uint64_t)100);
+
+  // The least recently used half goes.
+  [_governor handleMemoryPressureLevel:kGMFMemoryPressureLevelWarning];
+  XCTAssertEqual([cache totalCost], (NSUInteger)50);
+  XCTAssertNotNil([cache objectForKey:@(0)]);
+  XCTAssertNotNil([cache objectForKey:@(9)]);
+  XCTAssertNil([cache objectForKey:@(5)]);
+
+  [_governor handleMemoryPressureLevel:kGMFMemoryPressureLevelCritical];
+  XCTAssertEqual([cache count], (NSUInteger)0);
+  XCTAssertEqual([cache costLimit], (NSUInteger)100);
+}
+
+- (void)testPoolReleasesIdlePlayers {
+  GMFPlayerPool *pool = [[GMFPlayerPool alloc] initWithCapacity:4 maxDecodingPlayers:2];
+  [_governor addResponder:pool];
+  NSMutableArray *players = [NSMutableArray array];
+  for (NSUInteger i = 0; i < 4; i++) {
+    [players addObject:[pool dequeuePlayer]];
+  }
+  for (GMFVideoPlayer *player in players) {
+    [pool recyclePlayer:player];
+  }
+  GMFVideoPlayer *lastRecycled = [players lastObject];
+  [players removeAllObjects];
+
+  [_governor handleMemoryPressureLevel:kGMFMemoryPressureLevelWarning];
+  [pool resetStatistics];
+  XCTAssertEqual([pool dequeuePlayer], lastRecycled);
+  [pool dequeuePlayer];
+  [pool dequeuePlayer];
+  XCTAssertEqual([pool hitCount], (NSUInteger)2);
+  XCTAssertEqual([pool missCount], (NSUInteger)1);
+}
+
+- (void)testPoolDropsIdlePlayersWhenCritical {
+  GMFPlayerPool *pool = [[GMFPlayerPool alloc] initWithCapacity:4 maxDecodingPlayers:2];
+  [_governor addResponder:pool];
+  [pool recyclePlayer:[pool dequeuePlayer]];
+  [pool recyclePlayer:[pool dequeuePlayer]];
+
+  [_governor handleMemoryPressureLevel:kGMFMemoryPressureLevelCritical];
+  [pool resetStatistics];
+  [pool dequeuePlayer];
+  XCTAssertEqual([pool hitCount], (NSUInteger)0);
+  XCTAssertEqual([pool missCount], (NSUInteger)1);
+}
+
+@end
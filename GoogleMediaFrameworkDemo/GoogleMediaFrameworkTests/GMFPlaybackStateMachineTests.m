@@ -0,0 +1,393 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFPlaybackStateMachine.h>
+#import <GoogleMediaFramework/GMFSimulatedPlaybackBackend.h>
+#import <GoogleMediaFramework/GMFVirtualClock.h>
+
+static const NSTimeInterval kDuration = 60;
+static const NSTimeInterval kAccuracy = 1e-9;
+
+@interface GMFPlaybackStateMachineTests : XCTestCase<GMFPlaybackStateMachineDelegate>
+@end
+
+@implementation GMFPlaybackStateMachineTests {
+ @private
+  GMFVirtualClock *_clock;
+  GMFSimulatedPlaybackBackend *_backend;
+  GMFPlaybackStateMachine *_stateMachine;
+  NSMutableArray *_states;
+  NSUInteger _jumpCount;
+  // Whether |stateMachineShouldFail:| switches to another source instead of failing.
+  BOOL _failsOver;
+  NSUInteger _failureCount;
+}
+
+- (void)setUp {
+  [super setUp];
+  _clock = [[GMFVirtualClock alloc] init];
+  _backend = [[GMFSimulatedPlaybackBackend alloc] initWithClock:_clock duration:kDuration];
+  [_backend setSeekDelay:0.1];
+  _stateMachine = [[GMFPlaybackStateMachine alloc] initWithClock:_clock];
+  [_stateMachine setDelegate:self];
+  _states = [NSMutableArray array];
+}
+
+- (void)stateMachine:(GMFPlaybackStateMachine *)stateMachine
+    stateDidChangeFrom:(GMFPlayerState)fromState
+                    to:(GMFPlayerState)toState {
+  [_states addObject:@(toState)];
+}
+
+- (void)stateMachineDidJumpInTime:(GMFPlaybackStateMachine *)stateMachine {
+  _jumpCount++;
+}
+
+- (BOOL)stateMachineShouldFail:(GMFPlaybackStateMachine *)stateMachine {
+  _failureCount++;
+  if (_failsOver) {
+    // What GMFVideoPlayer does when it has another source.
+    [_stateMachine setBackend:nil];
+    [_stateMachine setState:kGMFPlayerStateLoadingContent];
+  }
+  return !_failsOver;
+}
+
+// Loads |_backend| the way GMFVideoPlayer loads a stream.
+- (void)load {
+  [_stateMachine setBackend:_backend];
+  [_stateMachine setState:kGMFPlayerStateLoadingContent];
+  [_backend load];
+}
+
+// What GMFVideoPlayer's |reset| does: drops the item and empties the player.
+- (void)reset {
+  [_stateMachine clear];
+  [_stateMachine setBackend:nil];
+  [_stateMachine setState:kGMFPlayerStateEmpty];
+}
+
+// Loads |_backend| and waits until it is paused, ready to play.
+- (void)loadAndWait {
+  [self load];
+  [_clock advanceBy:0];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStatePaused);
+  [_states removeAllObjects];
+}
+
+// Loads |_backend| and plays until it is playing.
+- (void)loadAndPlay {
+  [self load];
+  [_stateMachine play];
+  [_clock advanceBy:0];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStatePlaying);
+  [_states removeAllObjects];
+}
+
+- (void)testSlowLoadWithEarlyPlay {
+  [_backend setLoadDelay:2];
+  [_backend setStartupBufferDelay:0.5];
+  [self load];
+  [_stateMachine play];
+  XCTAssertTrue([_stateMachine pendingPlay]);
+
+  [_clock advanceBy:1.9];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStateLoadingContent);
+  [_clock advanceBy:0.1];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStateBuffering);
+  [_clock advanceBy:0.5];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStatePlaying);
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStateLoadingContent),
+                                     @(kGMFPlayerStateReadyToPlay),
+                                     @(kGMFPlayerStateBuffering),
+                                     @(kGMFPlayerStatePlaying) ]));
+
+  [_clock advanceBy:10];
+  XCTAssertEqualWithAccuracy([_backend currentTime], 10, kAccuracy);
+}
+
+- (void)testLoadWithoutPlayPauses {
+  [_backend setLoadDelay:1];
+  [self load];
+  [_clock advanceBy:1];
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStateLoadingContent),
+                                     @(kGMFPlayerStateReadyToPlay),
+                                     @(kGMFPlayerStatePaused) ]));
+  [_clock advanceBy:5];
+  XCTAssertEqual([_backend currentTime], 0.0);
+}
+
+- (void)testPauseHoldsPosition {
+  [self loadAndPlay];
+  [_clock advanceBy:3];
+  [_stateMachine pause];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStatePaused);
+  XCTAssertTrue([_stateMachine manuallyPaused]);
+  [_clock advanceBy:3];
+  XCTAssertEqualWithAccuracy([_backend currentTime], 3, kAccuracy);
+
+  [_stateMachine play];
+  XCTAssertFalse([_stateMachine manuallyPaused]);
+  [_clock advanceBy:1];
+  XCTAssertEqualWithAccuracy([_backend currentTime], 4, kAccuracy);
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStatePaused), @(kGMFPlayerStatePlaying) ]));
+}
+
+- (void)testStallBuffersAndResumes {
+  [_backend addStallAtTime:5 duration:3];
+  [self loadAndPlay];
+  [_clock advanceBy:6];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStateBuffering);
+  XCTAssertEqualWithAccuracy([_backend currentTime], 5, kAccuracy);
+
+  [_clock advanceBy:2];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStatePlaying);
+  [_clock advanceBy:1];
+  XCTAssertEqualWithAccuracy([_backend currentTime], 6, kAccuracy);
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStateBuffering), @(kGMFPlayerStatePlaying) ]));
+}
+
+- (void)testPauseDuringStallStaysPaused {
+  [_backend addStallAtTime:5 duration:3];
+  [self loadAndPlay];
+  [_clock advanceBy:6];
+  [_stateMachine pause];
+  [_clock advanceBy:10];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStatePaused);
+  XCTAssertEqualWithAccuracy([_backend currentTime], 5, kAccuracy);
+}
+
+- (void)testSeeksCompleteInOrder {
+  [self loadAndPlay];
+  [_clock advanceBy:10];
+  [_stateMachine pause];
+
+  // The first seek is slow; the ones requested meanwhile are coalesced behind it.
+  [_backend enqueueSeekDelay:3];
+  [_stateMachine seekToTime:30 mode:kGMFSeekModeFast];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStateSeeking);
+  [_stateMachine play];
+  XCTAssertTrue([_stateMachine pendingPlay]);
+  [_clock advanceBy:1];
+  [_stateMachine seekToTime:40 mode:kGMFSeekModeFast];
+  [_stateMachine seekToTime:50 mode:kGMFSeekModePrecise];
+  XCTAssertEqual([_backend seekCount], (NSUInteger)1);
+
+  [_clock advanceBy:2];
+  XCTAssertEqual([_backend seekCount], (NSUInteger)2);
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStateSeeking);
+  XCTAssertEqual(_jumpCount, (NSUInteger)0);
+
+  [_clock advanceBy:0.1];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStatePlaying);
+  XCTAssertEqual(_jumpCount, (NSUInteger)1);
+  XCTAssertEqual([[_stateMachine seekEngine] droppedCount], (NSUInteger)1);
+  XCTAssertEqual([_backend interruptedSeekCount], (NSUInteger)0);
+  [_clock advanceBy:1];
+  XCTAssertEqualWithAccuracy([_backend currentTime], 51, kAccuracy);
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStatePaused),
+                                     @(kGMFPlayerStateSeeking),
+                                     @(kGMFPlayerStatePlaying) ]));
+}
+
+- (void)testClearInterruptsSeek {
+  [self loadAndPlay];
+  [_stateMachine pause];
+  [_stateMachine seekToTime:30 mode:kGMFSeekModePrecise];
+  [_stateMachine clear];
+  [_stateMachine seekToTime:20 mode:kGMFSeekModePrecise];
+  XCTAssertEqual([_backend interruptedSeekCount], (NSUInteger)1);
+
+  [_clock advanceBy:1];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStatePaused);
+  XCTAssertEqual(_jumpCount, (NSUInteger)1);
+  XCTAssertEqualWithAccuracy([_backend currentTime], 20, kAccuracy);
+}
+
+- (void)testSeekBeforeReadyIsIgnored {
+  [_backend setLoadDelay:1];
+  [self load];
+  [_stateMachine seekToTime:30 mode:kGMFSeekModePrecise];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStateLoadingContent);
+  XCTAssertEqual([_backend seekCount], (NSUInteger)0);
+}
+
+- (void)testEndOfFile {
+  [self loadAndPlay];
+  [_clock advanceBy:kDuration + 1];
+  // AVPlayer pauses a file at its end before reporting the end.
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStatePaused), @(kGMFPlayerStateFinished) ]));
+  XCTAssertEqualWithAccuracy([_backend currentTime], kDuration, kAccuracy);
+  XCTAssertEqual(_jumpCount, (NSUInteger)1);
+}
+
+- (void)testEndOfStreamThatKeepsPlaying {
+  [_backend setPausesAtEnd:NO];
+  [self loadAndPlay];
+  [_clock advanceBy:kDuration + 1];
+  // Pausing the stream at its end mustn't take the state back to paused.
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStateFinished) ]));
+  XCTAssertEqual([_backend rate], 0.0f);
+}
+
+- (void)testReplay {
+  [self loadAndPlay];
+  [_clock advanceBy:kDuration];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStateFinished);
+
+  [_stateMachine setPendingPlay:YES];
+  [_stateMachine seekToTime:0 mode:kGMFSeekModePrecise];
+  [_clock advanceBy:0.1];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStatePlaying);
+  [_clock advanceBy:1];
+  XCTAssertEqualWithAccuracy([_backend currentTime], 1, kAccuracy);
+}
+
+- (void)testPlayPauseSeekAndPlayToEnd {
+  [self loadAndWait];
+  [_stateMachine play];
+  [_clock advanceBy:2];
+  [_stateMachine pause];
+  [_clock advanceBy:1];
+  XCTAssertEqualWithAccuracy([_backend currentTime], 2, kAccuracy);
+
+  [_stateMachine seekToTime:kDuration - 1 mode:kGMFSeekModePrecise];
+  [_clock advanceBy:0.1];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStatePaused);
+  XCTAssertEqualWithAccuracy([_backend currentTime], kDuration - 1, kAccuracy);
+
+  [_stateMachine play];
+  [_clock advanceBy:0.5];
+  XCTAssertEqualWithAccuracy([_backend currentTime], kDuration - 0.5, kAccuracy);
+  [_clock advanceBy:1];
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStatePlaying),
+                                     @(kGMFPlayerStatePaused),
+                                     @(kGMFPlayerStateSeeking),
+                                     @(kGMFPlayerStatePaused),
+                                     @(kGMFPlayerStatePlaying),
+                                     @(kGMFPlayerStatePaused),
+                                     @(kGMFPlayerStateFinished) ]));
+}
+
+- (void)testPlayDuringSeekPlaysFromTarget {
+  [self loadAndWait];
+  [_stateMachine seekToTime:kDuration / 2 mode:kGMFSeekModePrecise];
+  [_stateMachine play];
+  [_clock advanceBy:0.1];
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStateSeeking), @(kGMFPlayerStatePlaying) ]));
+  [_clock advanceBy:1];
+  XCTAssertEqualWithAccuracy([_backend currentTime], kDuration / 2 + 1, kAccuracy);
+}
+
+- (void)testSeeksOutsideTheItemLandAtItsEdges {
+  [self loadAndWait];
+  [_stateMachine seekToTime:-kDuration mode:kGMFSeekModePrecise];
+  [_clock advanceBy:0.1];
+  XCTAssertEqual([_backend currentTime], 0.0);
+
+  // Playing from past the end finishes right away.
+  [_stateMachine seekToTime:2 * kDuration mode:kGMFSeekModePrecise];
+  [_stateMachine play];
+  [_clock advanceBy:0.1];
+  XCTAssertEqualWithAccuracy([_backend currentTime], kDuration, kAccuracy);
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStateSeeking),
+                                     @(kGMFPlayerStatePaused),
+                                     @(kGMFPlayerStateSeeking),
+                                     @(kGMFPlayerStatePlaying),
+                                     @(kGMFPlayerStatePaused),
+                                     @(kGMFPlayerStateFinished) ]));
+  XCTAssertEqual(_jumpCount, (NSUInteger)3);
+}
+
+- (void)testDoublePlayAndPauseAreIgnored {
+  [self loadAndWait];
+  [_stateMachine play];
+  [_stateMachine play];
+  [_stateMachine pause];
+  [_stateMachine pause];
+  [_clock advanceBy:1];
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStatePlaying), @(kGMFPlayerStatePaused) ]));
+  XCTAssertEqual([_backend currentTime], 0.0);
+}
+
+- (void)testLoadAgainAndReset {
+  [self loadAndWait];
+  // GMFVideoPlayer resets before it loads another stream.
+  [self reset];
+  _backend = [[GMFSimulatedPlaybackBackend alloc] initWithClock:_clock duration:kDuration];
+  [self load];
+  [_clock advanceBy:0];
+  [self reset];
+  [_clock advanceBy:10];
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStateEmpty),
+                                     @(kGMFPlayerStateLoadingContent),
+                                     @(kGMFPlayerStateReadyToPlay),
+                                     @(kGMFPlayerStatePaused),
+                                     @(kGMFPlayerStateEmpty) ]));
+  XCTAssertNil([_stateMachine backend]);
+}
+
+- (void)testFailedLoad {
+  [_backend setLoadDelay:1];
+  [_backend setFailsToLoad:YES];
+  [self load];
+  [_stateMachine play];
+  [_clock advanceBy:1];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStateError);
+  XCTAssertFalse([_stateMachine pendingPlay]);
+  XCTAssertEqual(_failureCount, (NSUInteger)1);
+}
+
+- (void)testFailureDuringPlayback {
+  [self loadAndPlay];
+  [_clock advanceBy:5];
+  [_backend fail];
+  // The rate drop that follows isn't taken for a pause.
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStateError) ]));
+  XCTAssertEqual(_failureCount, (NSUInteger)1);
+}
+
+- (void)testFailureHandledByDelegate {
+  _failsOver = YES;
+  [self loadAndPlay];
+  [_clock advanceBy:5];
+  [_backend fail];
+  XCTAssertEqualObjects(_states, (@[ @(kGMFPlayerStateLoadingContent) ]));
+  XCTAssertEqual(_failureCount, (NSUInteger)1);
+}
+
+// Two hours of playback with a stall every five minutes, simulated in one go.
+- (void)testLongPlaybackWithStalls {
+  NSTimeInterval duration = 2 * 60 * 60;
+  _backend = [[GMFSimulatedPlaybackBackend alloc] initWithClock:_clock duration:duration];
+  NSUInteger stallCount = 0;
+  for (NSTimeInterval time = 300; time < duration; time += 300) {
+    [_backend addStallAtTime:time duration:2];
+    stallCount++;
+  }
+  [self loadAndPlay];
+  [_clock advanceBy:duration + stallCount * 2 + 1];
+
+  NSUInteger bufferingCount = 0;
+  for (NSNumber *state in _states) {
+    bufferingCount += [state intValue] == kGMFPlayerStateBuffering;
+  }
+  XCTAssertEqual(bufferingCount, stallCount);
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStateFinished);
+  XCTAssertEqualWithAccuracy([_backend currentTime], duration, kAccuracy);
+}
+
+@end
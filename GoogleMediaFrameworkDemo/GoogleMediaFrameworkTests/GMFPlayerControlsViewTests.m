@@ -0,0 +1,135 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFDurationFormatter.h>
+#import <GoogleMediaFramework/GMFPlayerControlsView.h>
+
+// Player ticks delivered within one display frame in the coalescing tests.
+static const NSUInteger kTicksPerFrame = 60;
+
+@interface GMFPlayerControlsViewTests : XCTestCase
+@end
+
+@implementation GMFPlayerControlsViewTests {
+ @private
+  GMFPlayerControlsView *_controlsView;
+}
+
+- (void)setUp {
+  [super setUp];
+  _controlsView = [[GMFPlayerControlsView alloc] init];
+  [_controlsView setTotalTime:600];
+  [_controlsView setMediaTime:0];
+  [_controlsView updateScrubberAndTime];
+  [_controlsView commitPendingUpdates];
+  [_controlsView resetUpdateStatistics];
+}
+
+- (void)tearDown {
+  _controlsView = nil;
+  [super tearDown];
+}
+
+- (NSString *)formattedDuration:(NSTimeInterval)seconds {
+  unichar buffer[kGMFDurationFormatterMaxLength];
+  NSUInteger length = GMFFormatDuration(GMFDurationDisplaySeconds(seconds),
+                                        buffer,
+                                        kGMFDurationFormatterMaxLength);
+  return [NSString stringWithCharacters:buffer length:length];
+}
+
+- (void)testFormatsDurations {
+  XCTAssertEqualObjects([self formattedDuration:0], @"0:00");
+  XCTAssertEqualObjects([self formattedDuration:59.6], @"1:00");
+  XCTAssertEqualObjects([self formattedDuration:605], @"10:05");
+  XCTAssertEqualObjects([self formattedDuration:3661], @"1:01:01");
+  XCTAssertEqualObjects([self formattedDuration:-3], @"0:00");
+  XCTAssertEqualObjects([self formattedDuration:NAN], @"0:00");
+  XCTAssertEqualObjects([self formattedDuration:INFINITY], @"0:00");
+}
+
+- (void)testFormatterRespectsCapacity {
+  unichar buffer[4];
+  XCTAssertEqual(GMFFormatDuration(65, buffer, 4), (NSUInteger)4);
+  XCTAssertEqual(GMFFormatDuration(605, buffer, 4), (NSUInteger)0);
+}
+
+- (void)testUpdatesWithinAFrameCommitOnce {
+  for (NSUInteger i = 1; i <= kTicksPerFrame; i++) {
+    [_controlsView setMediaTime:10 + i / 100.0];
+    [_controlsView updateScrubberAndTime];
+  }
+  [_controlsView commitPendingUpdates];
+
+  XCTAssertEqual([_controlsView commitCount], (NSUInteger)1);
+  XCTAssertEqual([_controlsView labelRebuildCount], (NSUInteger)1);
+}
+
+- (void)testUnchangedValuesDoNotCommit {
+  [_controlsView setTotalTime:600];
+  [_controlsView setMediaTime:0];
+  [_controlsView updateScrubberAndTime];
+  [_controlsView commitPendingUpdates];
+
+  XCTAssertEqual([_controlsView commitCount], (NSUInteger)0);
+}
+
+- (void)testLabelsAreRebuiltOnlyWhenTheDisplayedSecondChanges {
+  [_controlsView setMediaTime:20.1];
+  [_controlsView updateScrubberAndTime];
+  [_controlsView commitPendingUpdates];
+  [_controlsView setMediaTime:20.3];
+  [_controlsView updateScrubberAndTime];
+  [_controlsView commitPendingUpdates];
+
+  XCTAssertEqual([_controlsView commitCount], (NSUInteger)2);
+  XCTAssertEqual([_controlsView labelRebuildCount], (NSUInteger)1);
+
+  [_controlsView setMediaTime:21];
+  [_controlsView updateScrubberAndTime];
+  [_controlsView commitPendingUpdates];
+
+  XCTAssertEqual([_controlsView labelRebuildCount], (NSUInteger)2);
+}
+
+- (void)testBufferedRangesDoNotRebuildLabels {
+  [_controlsView setDownloadedTime:120];
+  [_controlsView updateScrubberAndTime];
+  [_controlsView commitPendingUpdates];
+
+  XCTAssertEqual([_controlsView commitCount], (NSUInteger)1);
+  XCTAssertEqual([_controlsView labelRebuildCount], (NSUInteger)0);
+}
+
+#pragma mark Benchmarks
+
+- (void)testBenchmarkPlaybackTicks {
+  __block NSTimeInterval mediaTime = 0;
+  [self measureBlock:^{
+      // Ten seconds of playback at 60 ticks per second, one commit per frame.
+      for (NSUInteger frame = 0; frame < 600; frame++) {
+        mediaTime += 1 / 60.0;
+        [_controlsView setMediaTime:mediaTime];
+        [_controlsView updateScrubberAndTime];
+        [_controlsView commitPendingUpdates];
+      }
+  }];
+  NSLog(@"Controls: %.1f commits/s, %.1f label rebuilds/s.",
+        [_controlsView commitsPerSecond],
+        [_controlsView labelRebuildsPerSecond]);
+}
+
+@end
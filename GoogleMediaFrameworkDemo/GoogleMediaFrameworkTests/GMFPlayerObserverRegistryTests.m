@@ -0,0 +1,194 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFPlayerObserverRegistry.h>
+
+static NSString * const kBenchmarkNotification = @"GMFPlayerObserverRegistryTestsNotification";
+
+// Number of media time ticks published per measured block.
+static const NSUInteger kBenchmarkTicks = 10000;
+
+// Stands in for a listener that has to read the time back after being notified.
+@interface GMFNotificationBenchmarkObserver : NSObject
+@property(nonatomic, assign) NSTimeInterval lastTime;
+@end
+
+@implementation GMFNotificationBenchmarkObserver
+
+- (void)mediaTimeDidChange:(NSNotification *)notification {
+  _lastTime = [[notification object] doubleValue];
+}
+
+@end
+
+@interface GMFPlayerObserverRegistryTests : XCTestCase
+@end
+
+@implementation GMFPlayerObserverRegistryTests {
+ @private
+  GMFPlayerObserverRegistry *_registry;
+}
+
+- (void)setUp {
+  [super setUp];
+  _registry = [[GMFPlayerObserverRegistry alloc] init];
+}
+
+- (void)tearDown {
+  _registry = nil;
+  [super tearDown];
+}
+
+- (void)testObserverReceivesPayload {
+  __block NSTimeInterval receivedTime = -1;
+  [_registry addObserverForEvents:GMFPlayerEventMaskForType(kGMFPlayerEventMediaTime)
+                       usingBlock:^(const GMFPlayerEvent *event) {
+      receivedTime = event->time;
+  }];
+
+  [_registry publishTime:12.5 forEvent:kGMFPlayerEventMediaTime];
+
+  XCTAssertEqual(receivedTime, 12.5);
+}
+
+- (void)testObserverOnlyReceivesSubscribedEvents {
+  __block NSUInteger stateChanges = 0;
+  __block NSUInteger otherEvents = 0;
+  [_registry addObserverForEvents:GMFPlayerEventMaskForType(kGMFPlayerEventStateChange)
+                       usingBlock:^(const GMFPlayerEvent *event) {
+      if (event->type == kGMFPlayerEventStateChange) {
+        stateChanges++;
+      } else {
+        otherEvents++;
+      }
+  }];
+
+  [_registry publishTime:1 forEvent:kGMFPlayerEventMediaTime];
+  [_registry publishTime:2 forEvent:kGMFPlayerEventBufferedTime];
+  [_registry publishStateChangeFrom:kGMFPlayerStatePaused to:kGMFPlayerStatePlaying];
+
+  XCTAssertEqual(stateChanges, 1);
+  XCTAssertEqual(otherEvents, 0);
+  XCTAssertEqual([_registry observerCountForEvent:kGMFPlayerEventMediaTime], 0);
+}
+
+- (void)testRemovedObserverIsNotCalled {
+  __block NSUInteger calls = 0;
+  id first = [_registry addObserverForEvents:kGMFPlayerEventMaskAll
+                                  usingBlock:^(const GMFPlayerEvent *event) {
+      calls++;
+  }];
+  [_registry addObserverForEvents:kGMFPlayerEventMaskAll
+                       usingBlock:^(const GMFPlayerEvent *event) {
+      calls += 10;
+  }];
+
+  [_registry removeObserver:first];
+  [_registry publishTime:1 forEvent:kGMFPlayerEventMediaTime];
+
+  XCTAssertEqual(calls, 10);
+  XCTAssertEqual([_registry observerCountForEvent:kGMFPlayerEventMediaTime], 1);
+}
+
+- (void)testObserverCanRemoveItselfWhilePublishing {
+  __block id selfRemovingObserver = nil;
+  __block NSUInteger calls = 0;
+  selfRemovingObserver =
+      [_registry addObserverForEvents:GMFPlayerEventMaskForType(kGMFPlayerEventMediaTime)
+                           usingBlock:^(const GMFPlayerEvent *event) {
+          calls++;
+          [_registry removeObserver:selfRemovingObserver];
+      }];
+  __block NSUInteger otherCalls = 0;
+  [_registry addObserverForEvents:GMFPlayerEventMaskForType(kGMFPlayerEventMediaTime)
+                       usingBlock:^(const GMFPlayerEvent *event) {
+      otherCalls++;
+  }];
+
+  [_registry publishTime:1 forEvent:kGMFPlayerEventMediaTime];
+  [_registry publishTime:2 forEvent:kGMFPlayerEventMediaTime];
+
+  XCTAssertEqual(calls, 1);
+  XCTAssertEqual(otherCalls, 2);
+  selfRemovingObserver = nil;
+}
+
+#pragma mark Fan-out benchmarks
+
+- (void)testRegistryFanOutTo1Observer {
+  [self measureRegistryFanOutWithObserverCount:1];
+}
+
+- (void)testRegistryFanOutTo10Observers {
+  [self measureRegistryFanOutWithObserverCount:10];
+}
+
+- (void)testRegistryFanOutTo100Observers {
+  [self measureRegistryFanOutWithObserverCount:100];
+}
+
+- (void)testNotificationCenterFanOutTo1Observer {
+  [self measureNotificationFanOutWithObserverCount:1];
+}
+
+- (void)testNotificationCenterFanOutTo10Observers {
+  [self measureNotificationFanOutWithObserverCount:10];
+}
+
+- (void)testNotificationCenterFanOutTo100Observers {
+  [self measureNotificationFanOutWithObserverCount:100];
+}
+
+- (void)measureRegistryFanOutWithObserverCount:(NSUInteger)observerCount {
+  __block NSTimeInterval sink = 0;
+  for (NSUInteger i = 0; i < observerCount; i++) {
+    [_registry addObserverForEvents:GMFPlayerEventMaskForType(kGMFPlayerEventMediaTime)
+                         usingBlock:^(const GMFPlayerEvent *event) {
+        sink = event->time;
+    }];
+  }
+  [self measureBlock:^{
+      for (NSUInteger tick = 0; tick < kBenchmarkTicks; tick++) {
+        [_registry publishTime:tick forEvent:kGMFPlayerEventMediaTime];
+      }
+  }];
+  XCTAssertEqual(sink, kBenchmarkTicks - 1);
+}
+
+// Baseline: what GMFPlayerViewController's media time notification costs with the same number of
+// listeners.
+- (void)measureNotificationFanOutWithObserverCount:(NSUInteger)observerCount {
+  NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+  NSMutableArray *observers = [NSMutableArray array];
+  for (NSUInteger i = 0; i < observerCount; i++) {
+    GMFNotificationBenchmarkObserver *observer = [[GMFNotificationBenchmarkObserver alloc] init];
+    [center addObserver:observer
+               selector:@selector(mediaTimeDidChange:)
+                   name:kBenchmarkNotification
+                 object:nil];
+    [observers addObject:observer];
+  }
+  [self measureBlock:^{
+      for (NSUInteger tick = 0; tick < kBenchmarkTicks; tick++) {
+        [center postNotificationName:kBenchmarkNotification object:@(tick)];
+      }
+  }];
+  for (GMFNotificationBenchmarkObserver *observer in observers) {
+    [center removeObserver:observer];
+  }
+}
+
+@end
@@ -0,0 +1,133 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFPlayerPool.h>
+#import <GoogleMediaFramework/GMFVideoPlayer.h>
+
+// Cells in the simulated feed, and how many fit on screen at once.
+static const NSUInteger kFeedCellCount = 200;
+static const NSUInteger kVisibleCellCount = 3;
+
+@interface GMFPlayerPoolTests : XCTestCase
+@end
+
+@implementation GMFPlayerPoolTests {
+ @private
+  GMFPlayerPool *_pool;
+}
+
+- (void)setUp {
+  [super setUp];
+  _pool = [[GMFPlayerPool alloc] initWithCapacity:2 maxDecodingPlayers:2];
+}
+
+- (void)testRecycledPlayersAreReused {
+  GMFVideoPlayer *first = [_pool dequeuePlayer];
+  XCTAssertEqual([_pool missCount], (NSUInteger)1);
+  [_pool recyclePlayer:first];
+  XCTAssertEqual([_pool livePlayerCount], (NSUInteger)0);
+
+  GMFVideoPlayer *second = [_pool dequeuePlayer];
+  XCTAssertEqual(second, first);
+  XCTAssertEqual([_pool hitCount], (NSUInteger)1);
+  XCTAssertEqual([second state], kGMFPlayerStateEmpty);
+  XCTAssertNil([second delegate]);
+  XCTAssertEqualWithAccuracy([_pool hitRate], 0.5, 1e-9);
+
+  // Players not from the pool are left alone.
+  GMFVideoPlayer *stranger = [[GMFVideoPlayer alloc] init];
+  [_pool recyclePlayer:stranger];
+  XCTAssertNotEqual([_pool dequeuePlayer], stranger);
+}
+
+- (void)testIdlePlayersAreCapped {
+  NSMutableArray *players = [NSMutableArray array];
+  for (NSUInteger i = 0; i < 4; i++) {
+    [players addObject:[_pool dequeuePlayer]];
+  }
+  XCTAssertEqual([_pool peakLivePlayerCount], (NSUInteger)4);
+  for (GMFVideoPlayer *player in players) {
+    [_pool recyclePlayer:player];
+  }
+  // Only |capacity| come back.
+  [_pool dequeuePlayer];
+  [_pool dequeuePlayer];
+  [_pool dequeuePlayer];
+  XCTAssertEqual([_pool hitCount], (NSUInteger)2);
+  XCTAssertEqual([_pool missCount], (NSUInteger)5);
+}
+
+- (void)testHighestPrioritiesDecode {
+  GMFVideoPlayer *a = [_pool dequeuePlayer];
+  GMFVideoPlayer *b = [_pool dequeuePlayer];
+  GMFVideoPlayer *c = [_pool dequeuePlayer];
+  // Same default priority: the latest players win.
+  XCTAssertTrue([a isDecodingSuspended]);
+  XCTAssertFalse([b isDecodingSuspended]);
+  XCTAssertFalse([c isDecodingSuspended]);
+  XCTAssertEqual([_pool decodingPlayerCount], (NSUInteger)2);
+
+  [_pool setPriority:0.9 forPlayer:a];
+  [_pool setPriority:0.5 forPlayer:b];
+  [_pool setPriority:0.1 forPlayer:c];
+  XCTAssertFalse([a isDecodingSuspended]);
+  XCTAssertFalse([b isDecodingSuspended]);
+  XCTAssertTrue([c isDecodingSuspended]);
+
+  // Off screen players never decode, even with a decoder free.
+  [_pool setPriority:0 forPlayer:b];
+  [_pool setPriority:0 forPlayer:c];
+  XCTAssertTrue([b isDecodingSuspended]);
+  XCTAssertTrue([c isDecodingSuspended]);
+  XCTAssertEqual([_pool decodingPlayerCount], (NSUInteger)1);
+
+  // A recycled player hands its decoder on.
+  [_pool setPriority:0.2 forPlayer:c];
+  [_pool setPriority:0.3 forPlayer:b];
+  [_pool recyclePlayer:a];
+  XCTAssertFalse([b isDecodingSuspended]);
+  XCTAssertFalse([c isDecodingSuspended]);
+  XCTAssertFalse([a isDecodingSuspended]);
+
+  [_pool setMaxDecodingPlayers:1];
+  XCTAssertTrue([c isDecodingSuspended]);
+  XCTAssertEqual([_pool peakDecodingPlayerCount], (NSUInteger)2);
+}
+
+// Scrolls through a feed, giving each cell a player as it appears and recycling it when it
+// leaves the screen.
+- (void)testScrollingFeed {
+  NSMutableArray *visiblePlayers = [NSMutableArray array];
+  for (NSUInteger cell = 0; cell < kFeedCellCount; cell++) {
+    GMFVideoPlayer *player = [_pool dequeuePlayer];
+    [visiblePlayers addObject:player];
+    if ([visiblePlayers count] > kVisibleCellCount) {
+      [_pool recyclePlayer:[visiblePlayers firstObject]];
+      [visiblePlayers removeObjectAtIndex:0];
+    }
+    // The cell in the middle of the screen is fully visible.
+    for (NSUInteger i = 0; i < [visiblePlayers count]; i++) {
+      [_pool setPriority:(i == 1 ? 1 : 0.5) forPlayer:[visiblePlayers objectAtIndex:i]];
+    }
+    XCTAssertLessThanOrEqual([_pool decodingPlayerCount], [_pool maxDecodingPlayers]);
+  }
+  XCTAssertEqual([_pool peakLivePlayerCount], kVisibleCellCount + 1);
+  XCTAssertEqual([_pool missCount], kVisibleCellCount + 1);
+  XCTAssertGreaterThan([_pool hitRate], 0.97);
+  XCTAssertEqual([_pool peakDecodingPlayerCount], [_pool maxDecodingPlayers]);
+}
+
+@end
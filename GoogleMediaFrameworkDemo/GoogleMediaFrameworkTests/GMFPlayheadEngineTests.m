@@ -0,0 +1,252 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFPlaybackStateMachine.h>
+#import <GoogleMediaFramework/GMFPlayheadEngine.h>
+#import <GoogleMediaFramework/GMFSimulatedPlaybackBackend.h>
+#import <GoogleMediaFramework/GMFVirtualClock.h>
+
+// Interval of the NSTimer poller GMFVideoPlayer used before the playhead engine.
+static const NSTimeInterval kLegacyPollingInterval = 0.2;
+
+@interface GMFPlayheadEngineTests : XCTestCase<GMFPlayheadEngineDataSource,
+                                               GMFPlaybackStateMachineDelegate>
+@end
+
+@implementation GMFPlayheadEngineTests {
+ @private
+  GMFVirtualClock *_clock;
+  GMFPlayheadEngine *_engine;
+  // Simulated playback: media time advances with the clock while |_playing|.
+  BOOL _playing;
+  NSTimeInterval _mediaTimeAtStart;
+  NSTimeInterval _clockTimeAtStart;
+  void (^_legacyPollerBlock)(NSTimeInterval mediaTime);
+  // Playback through a state machine, which starts and stops the engine the way GMFVideoPlayer
+  // does. Set by |playBackendWithStallAtTime:duration:|; the media time then comes from
+  // |_backend|.
+  GMFSimulatedPlaybackBackend *_backend;
+  GMFPlaybackStateMachine *_stateMachine;
+}
+
+- (void)setUp {
+  [super setUp];
+  _clock = [[GMFVirtualClock alloc] init];
+  _engine = [[GMFPlayheadEngine alloc] initWithClock:_clock];
+  [_engine setDataSource:self];
+  _playing = NO;
+  _mediaTimeAtStart = 0;
+}
+
+- (void)tearDown {
+  _legacyPollerBlock = nil;
+  _stateMachine = nil;
+  _backend = nil;
+  _engine = nil;
+  _clock = nil;
+  [super tearDown];
+}
+
+- (void)testConsumersTickAtTheirOwnRate {
+  __block NSUInteger scrubberTicks = 0;
+  __block NSUInteger analyticsTicks = 0;
+  [_engine addConsumerWithInterval:1.0 / 30 block:^(NSTimeInterval mediaTime) {
+      scrubberTicks++;
+  }];
+  [_engine addConsumerWithInterval:1.0 block:^(NSTimeInterval mediaTime) {
+      analyticsTicks++;
+  }];
+
+  [self startPlayback];
+  [_clock advanceBy:3.05];
+
+  XCTAssertEqualWithAccuracy(scrubberTicks, 91, 1);
+  XCTAssertEqual(analyticsTicks, 3);
+  // The 1 Hz consumer rides along with 30 Hz wakeups instead of adding its own.
+  XCTAssertEqualWithAccuracy([_engine wakeupCount], 91, 1);
+}
+
+- (void)testNoWakeupsWhileStopped {
+  __block NSUInteger ticks = 0;
+  [_engine addConsumerWithInterval:kLegacyPollingInterval block:^(NSTimeInterval mediaTime) {
+      ticks++;
+  }];
+
+  [self startPlayback];
+  [_clock advanceBy:1.0];
+  NSUInteger ticksWhilePlaying = ticks;
+  [self pausePlayback];
+  [_clock advanceBy:10.0];
+
+  XCTAssertEqual(ticks, ticksWhilePlaying);
+  XCTAssertEqual([_clock pendingCount], 0);
+}
+
+- (void)testRemovedConsumerIsNotCalled {
+  __block NSUInteger ticks = 0;
+  id consumer = [_engine addConsumerWithInterval:0.1 block:^(NSTimeInterval mediaTime) {
+      ticks++;
+  }];
+  [self startPlayback];
+  [_clock advanceBy:0.5];
+  [_engine removeConsumer:consumer];
+  NSUInteger ticksBeforeRemoval = ticks;
+  [_clock advanceBy:0.5];
+
+  XCTAssertEqual(ticks, ticksBeforeRemoval);
+  XCTAssertEqual([_clock pendingCount], 0);
+}
+
+- (void)testStallLatencyComparedWithPoller {
+  __block NSTimeInterval engineDetectionTime = -1;
+  __block NSTimeInterval engineStallMediaTime = -1;
+  __block NSTimeInterval engineResumeTime = -1;
+  [_engine addConsumerWithInterval:kLegacyPollingInterval block:^(NSTimeInterval mediaTime) {
+      if (mediaTime >= 1.05 && engineDetectionTime < 0) {
+        engineDetectionTime = [_clock now];
+        engineStallMediaTime = mediaTime;
+      } else if (mediaTime > 1.05 && engineResumeTime < 0) {
+        engineResumeTime = [_clock now];
+      }
+  }];
+  __block NSTimeInterval pollerDetectionTime = -1;
+  [self startLegacyPollerWithBlock:^(NSTimeInterval mediaTime) {
+      if (mediaTime >= 1.05 && pollerDetectionTime < 0) {
+        pollerDetectionTime = [_clock now];
+      }
+  }];
+
+  // The buffer runs dry at 1.05s, between two ticks, and refills half a second later.
+  [self playBackendWithStallAtTime:1.05 duration:0.5];
+  [_clock advanceBy:1.05];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStateBuffering);
+  XCTAssertFalse([_engine isRunning]);
+  [_clock advanceBy:1.0];
+
+  // The consumer learns where playback stopped when the state machine reports the stall, not
+  // at its next tick at 1.2s.
+  XCTAssertEqualWithAccuracy(engineStallMediaTime, 1.05, 1e-9);
+  NSTimeInterval engineLatency = engineDetectionTime - 1.05;
+  NSTimeInterval pollerLatency = pollerDetectionTime - 1.05;
+  XCTAssertEqualWithAccuracy(engineLatency, 0, 1e-9);
+  XCTAssertGreaterThan(pollerLatency, 0.1);
+  XCTAssertLessThanOrEqual(pollerLatency, kLegacyPollingInterval);
+  // Ticks resume a full interval after playback does.
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStatePlaying);
+  XCTAssertEqualWithAccuracy(engineResumeTime, 1.55 + kLegacyPollingInterval, 1e-9);
+}
+
+- (void)testWakeupsComparedWithPollerOverMostlyIdleSession {
+  [_engine addConsumerWithInterval:kLegacyPollingInterval block:^(NSTimeInterval mediaTime) {
+  }];
+  __block NSUInteger pollerWakeups = 0;
+  [self startLegacyPollerWithBlock:^(NSTimeInterval mediaTime) {
+      pollerWakeups++;
+  }];
+
+  // About 2s of playback followed by 8s paused.
+  [self startPlayback];
+  [_clock advanceBy:2.1];
+  [self pausePlayback];
+  [_clock advanceBy:7.95];
+
+  XCTAssertEqual(pollerWakeups, 50);
+  XCTAssertEqual([_engine wakeupCount], 10);
+}
+
+#pragma mark Helpers
+
+- (void)startPlayback {
+  _clockTimeAtStart = [_clock now];
+  _playing = YES;
+  [_engine start];
+}
+
+- (void)pausePlayback {
+  _mediaTimeAtStart = [self currentMediaTime];
+  _playing = NO;
+  [_engine stop];
+}
+
+- (NSTimeInterval)currentMediaTime {
+  if (_backend) {
+    return [_backend currentTime];
+  }
+  if (!_playing) {
+    return _mediaTimeAtStart;
+  }
+  return _mediaTimeAtStart + [_clock now] - _clockTimeAtStart;
+}
+
+// Loads a 60s item with a stall scripted at |time| and plays it through |_stateMachine|.
+- (void)playBackendWithStallAtTime:(NSTimeInterval)time duration:(NSTimeInterval)duration {
+  _backend = [[GMFSimulatedPlaybackBackend alloc] initWithClock:_clock duration:60];
+  [_backend addStallAtTime:time duration:duration];
+  _stateMachine = [[GMFPlaybackStateMachine alloc] initWithClock:_clock];
+  [_stateMachine setDelegate:self];
+  [_stateMachine setBackend:_backend];
+  [_stateMachine setState:kGMFPlayerStateLoadingContent];
+  [_backend load];
+  [_stateMachine play];
+  [_clock advanceBy:0];
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStatePlaying);
+}
+
+// Models the repeating NSTimer GMFVideoPlayer used to poll with: it fires regardless of state.
+- (void)startLegacyPollerWithBlock:(void (^)(NSTimeInterval mediaTime))block {
+  _legacyPollerBlock = [block copy];
+  [self scheduleLegacyPollerTick];
+}
+
+- (void)scheduleLegacyPollerTick {
+  __weak GMFPlayheadEngineTests *weakSelf = self;
+  [_clock scheduleBlock:^{
+      GMFPlayheadEngineTests *strongSelf = weakSelf;
+      if (!strongSelf || !strongSelf->_legacyPollerBlock) {
+        return;
+      }
+      strongSelf->_legacyPollerBlock([strongSelf currentMediaTime]);
+      [strongSelf scheduleLegacyPollerTick];
+  } afterDelay:kLegacyPollingInterval];
+}
+
+#pragma mark GMFPlaybackStateMachineDelegate
+
+// What GMFVideoPlayer does with the engine on a state change.
+- (void)stateMachine:(GMFPlaybackStateMachine *)stateMachine
+    stateDidChangeFrom:(GMFPlayerState)fromState
+                    to:(GMFPlayerState)toState {
+  if (toState == kGMFPlayerStatePlaying) {
+    [_engine start];
+  } else {
+    [_engine stop];
+  }
+  if ((toState == kGMFPlayerStatePlaying) != (fromState == kGMFPlayerStatePlaying)) {
+    [_engine notifyDiscontinuity];
+  }
+}
+
+- (void)stateMachineDidJumpInTime:(GMFPlaybackStateMachine *)stateMachine {
+  [_engine notifyDiscontinuity];
+}
+
+#pragma mark GMFPlayheadEngineDataSource
+
+- (NSTimeInterval)mediaTimeForPlayheadEngine:(GMFPlayheadEngine *)engine {
+  return [self currentMediaTime];
+}
+
+@end
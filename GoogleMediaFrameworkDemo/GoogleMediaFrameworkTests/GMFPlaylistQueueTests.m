@@ -0,0 +1,271 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFPlaybackStateMachine.h>
+#import <GoogleMediaFramework/GMFPlaylistQueue.h>
+#import <GoogleMediaFramework/GMFSimulatedPlaybackBackend.h>
+#import <GoogleMediaFramework/GMFVirtualClock.h>
+
+// Time a simulated backend takes to load an item and buffer enough to start playing.
+static const NSTimeInterval kStartupCost = 1.5;
+static const NSTimeInterval kItemDuration = 10;
+static const NSUInteger kPlaylistLength = 5;
+
+// The test case is the queue's delegate and does what GMFVideoPlayer does with it: each item is
+// prepared by loading a GMFSimulatedPlaybackBackend, which takes |kStartupCost| of virtual time,
+// and a GMFPlaybackStateMachine plays the prepared backends one after the other.
+@interface GMFPlaylistQueueTests : XCTestCase<GMFPlaylistQueueDelegate,
+                                              GMFPlaybackStateMachineDelegate,
+                                              GMFPlaybackBackendDelegate>
+@end
+
+@implementation GMFPlaylistQueueTests {
+ @private
+  GMFVirtualClock *_clock;
+  GMFPlaylistQueue *_queue;
+  // The backend loading or loaded for each item in the look-ahead window.
+  NSMapTable *_backends;
+  NSMutableArray *_preparedURLs;
+  NSMutableArray *_cancelledURLs;
+  // Playback.
+  GMFPlaybackStateMachine *_stateMachine;
+  NSUInteger _finishedItemCount;
+  // When the state machine last left the playing state between two items, or -1 while it plays.
+  NSTimeInterval _interruptionStartTime;
+  NSTimeInterval _interruptedTime;
+}
+
+- (void)setUp {
+  [super setUp];
+  _clock = [[GMFVirtualClock alloc] init];
+  _backends = [NSMapTable strongToStrongObjectsMapTable];
+  _preparedURLs = [NSMutableArray array];
+  _cancelledURLs = [NSMutableArray array];
+  _queue = [[GMFPlaylistQueue alloc] init];
+  [_queue setDelegate:self];
+  _stateMachine = [[GMFPlaybackStateMachine alloc] initWithClock:_clock];
+  [_stateMachine setDelegate:self];
+  _finishedItemCount = 0;
+  _interruptionStartTime = -1;
+  _interruptedTime = 0;
+}
+
+- (void)tearDown {
+  _stateMachine = nil;
+  _queue = nil;
+  _clock = nil;
+  [super tearDown];
+}
+
+- (NSURL *)URLForIndex:(NSUInteger)index {
+  return [NSURL URLWithString:[NSString stringWithFormat:@"http://example.com/%lu.m3u8",
+                                  (unsigned long)index]];
+}
+
+- (void)testPreparesCurrentAndLookAheadItems {
+  [_queue setLookAheadCount:2];
+  for (NSUInteger i = 0; i < 5; i++) {
+    [_queue enqueueURL:[self URLForIndex:i]];
+  }
+
+  XCTAssertEqual([_preparedURLs count], 3);
+  XCTAssertEqual([[[_queue items] objectAtIndex:3] state], kGMFPlaylistItemStateIdle);
+
+  [_clock advanceBy:kStartupCost];
+  XCTAssertEqual([[_queue currentItem] state], kGMFPlaylistItemStatePrepared);
+  GMFPlaylistItem *nextItem = [_queue nextItem];
+  XCTAssertEqual([nextItem state], kGMFPlaylistItemStatePrepared);
+  XCTAssertEqual([nextItem preparedObject], [_backends objectForKey:nextItem]);
+}
+
+- (void)testReorderCancelsItemsLeavingTheWindow {
+  for (NSUInteger i = 0; i < 4; i++) {
+    [_queue enqueueURL:[self URLForIndex:i]];
+  }
+  [_clock advanceBy:kStartupCost];
+
+  // Move the last item up next; the old next item falls out of the window.
+  [_queue moveItemAtIndex:3 toIndex:1];
+
+  XCTAssertEqualObjects(_cancelledURLs, @[ [self URLForIndex:1] ]);
+  XCTAssertEqualObjects([_preparedURLs lastObject], [self URLForIndex:3]);
+  XCTAssertEqual([[[_queue items] objectAtIndex:2] state], kGMFPlaylistItemStateIdle);
+  XCTAssertNil([[[_queue items] objectAtIndex:2] preparedObject]);
+}
+
+- (void)testRemovingPreparingItemCancelsIt {
+  [_queue enqueueURL:[self URLForIndex:0]];
+  GMFPlaylistItem *item = [_queue enqueueURL:[self URLForIndex:1]];
+
+  [_queue removeItem:item];
+  [_clock advanceBy:kStartupCost];
+
+  XCTAssertEqualObjects(_cancelledURLs, @[ [self URLForIndex:1] ]);
+  XCTAssertEqual([item state], kGMFPlaylistItemStateIdle);
+  XCTAssertEqual([_queue count], 1);
+}
+
+- (void)testAdvancePreparesNextWindow {
+  for (NSUInteger i = 0; i < 3; i++) {
+    [_queue enqueueURL:[self URLForIndex:i]];
+  }
+  XCTAssertEqual([_preparedURLs count], 2);
+
+  GMFPlaylistItem *current = [_queue advance];
+
+  XCTAssertEqualObjects([current URL], [self URLForIndex:1]);
+  XCTAssertEqualObjects(_cancelledURLs, @[ [self URLForIndex:0] ]);
+  XCTAssertEqualObjects([_preparedURLs lastObject], [self URLForIndex:2]);
+  XCTAssertEqual([_preparedURLs count], 3);
+}
+
+#pragma mark Transition gap
+
+// Today's flow: the next item is only loaded once the current one finishes.
+- (void)testTransitionGapWhenLoadingOnFinish {
+  NSTimeInterval gap = [self averageTransitionGapWithLookAhead:0];
+  XCTAssertEqualWithAccuracy(gap, kStartupCost, 1e-9);
+}
+
+- (void)testTransitionGapWithLookAhead {
+  NSTimeInterval gap = [self averageTransitionGapWithLookAhead:1];
+  NSLog(@"Average gap between items: %.3fs with look-ahead, %.3fs loading on finish.",
+        gap, kStartupCost);
+  XCTAssertEqual(gap, 0);
+}
+
+// Plays the whole playlist and returns the average time the state machine spent out of the
+// playing state from the end of one item until it reported playing the next.
+- (NSTimeInterval)averageTransitionGapWithLookAhead:(NSUInteger)lookAheadCount {
+  [_queue setLookAheadCount:lookAheadCount];
+  [_stateMachine setState:kGMFPlayerStateLoadingContent];
+  [_stateMachine play];
+  for (NSUInteger i = 0; i < kPlaylistLength; i++) {
+    [_queue enqueueURL:[self URLForIndex:i]];
+  }
+  [_clock advanceBy:kPlaylistLength * (kItemDuration + kStartupCost) + 1];
+
+  XCTAssertEqual(_finishedItemCount, kPlaylistLength);
+  XCTAssertEqual([_stateMachine state], kGMFPlayerStateFinished);
+  XCTAssertEqual([_queue count], 1);
+  XCTAssertEqual([_stateMachine backend], [[_queue currentItem] preparedObject]);
+  XCTAssertEqualWithAccuracy([[_stateMachine backend] currentTime], kItemDuration, 1e-9);
+  XCTAssertLessThan(_interruptionStartTime, 0);
+  return _interruptedTime / (kPlaylistLength - 1);
+}
+
+// What GMFVideoPlayer's |loadCurrentPlaylistItem| does once the current item is prepared.
+- (void)loadCurrentItem {
+  GMFPlaylistItem *item = [_queue currentItem];
+  if ([item state] != kGMFPlaylistItemStatePrepared) {
+    // Loading continues from |playbackBackendStatusDidChange:|.
+    return;
+  }
+  id<GMFPlaybackBackend> backend = [item preparedObject];
+  [_stateMachine setBackend:backend];
+  // The backend already loaded; AVPlayerItem reports its status when it is first observed.
+  [_stateMachine playbackBackendStatusDidChange:backend];
+}
+
+#pragma mark GMFPlaybackStateMachineDelegate
+
+- (void)stateMachine:(GMFPlaybackStateMachine *)stateMachine
+    stateDidChangeFrom:(GMFPlayerState)fromState
+                    to:(GMFPlayerState)toState {
+  if (fromState == kGMFPlayerStatePlaying && toState != kGMFPlayerStateFinished) {
+    _interruptionStartTime = [_clock now];
+  } else if (toState == kGMFPlayerStatePlaying && _interruptionStartTime >= 0) {
+    _interruptedTime += [_clock now] - _interruptionStartTime;
+    _interruptionStartTime = -1;
+  }
+}
+
+// Mirrors GMFVideoPlayer's |stateMachineShouldFinish:| and |playerCurrentItemDidChange|.
+- (BOOL)stateMachineShouldFinish:(GMFPlaybackStateMachine *)stateMachine {
+  _finishedItemCount++;
+  GMFPlaylistItem *nextItem = [_queue nextItem];
+  if ([nextItem state] == kGMFPlaylistItemStatePrepared) {
+    // The queue player had the next item buffered and keeps playing into it.
+    id<GMFPlaybackBackend> backend = [nextItem preparedObject];
+    [_queue advance];
+    [_stateMachine setBackend:backend];
+    [backend play];
+    [_stateMachine playbackBackendBufferStatusDidChange:backend];
+    return NO;
+  }
+  if (nextItem) {
+    // The next item isn't ready yet, so load it the slow way.
+    [_queue advance];
+    [_stateMachine setPendingPlay:YES];
+    [_stateMachine setState:kGMFPlayerStateLoadingContent];
+    [self loadCurrentItem];
+    return NO;
+  }
+  return YES;
+}
+
+#pragma mark GMFPlaybackBackendDelegate
+
+// Only backends that are still preparing report here; the state machine takes over the delegate
+// of the one it plays.
+- (void)playbackBackendStatusDidChange:(id<GMFPlaybackBackend>)backend {
+  for (GMFPlaylistItem *item in [[_backends keyEnumerator] allObjects]) {
+    if ([_backends objectForKey:item] != backend) {
+      continue;
+    }
+    [_queue item:item didPrepareWithObject:backend];
+    if (item == [_queue currentItem] &&
+        [_stateMachine state] == kGMFPlayerStateLoadingContent &&
+        [_stateMachine backend] != backend) {
+      [self loadCurrentItem];
+    }
+    return;
+  }
+}
+
+- (void)playbackBackendRateDidChange:(id<GMFPlaybackBackend>)backend {
+}
+
+- (void)playbackBackendBufferStatusDidChange:(id<GMFPlaybackBackend>)backend {
+}
+
+- (void)playbackBackendDidStall:(id<GMFPlaybackBackend>)backend {
+}
+
+- (void)playbackBackendDidPlayToEnd:(id<GMFPlaybackBackend>)backend {
+}
+
+#pragma mark GMFPlaylistQueueDelegate
+
+- (void)playlistQueue:(GMFPlaylistQueue *)queue prepareItem:(GMFPlaylistItem *)item {
+  [_preparedURLs addObject:[item URL]];
+  GMFSimulatedPlaybackBackend *backend =
+      [[GMFSimulatedPlaybackBackend alloc] initWithClock:_clock duration:kItemDuration];
+  [backend setLoadDelay:kStartupCost];
+  // AVQueuePlayer keeps its rate at the end of an item it has a next item for.
+  [backend setPausesAtEnd:NO];
+  [backend setDelegate:self];
+  [_backends setObject:backend forKey:item];
+  [backend load];
+}
+
+- (void)playlistQueue:(GMFPlaylistQueue *)queue cancelItem:(GMFPlaylistItem *)item {
+  // A backend still loading is released with its scheduled load.
+  [_backends removeObjectForKey:item];
+  [_cancelledURLs addObject:[item URL]];
+}
+
+@end
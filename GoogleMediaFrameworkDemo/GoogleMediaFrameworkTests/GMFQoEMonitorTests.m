@@ -0,0 +1,244 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFLatencyHistogram.h>
+#import <GoogleMediaFramework/GMFQoEMonitor.h>
+#import <GoogleMediaFramework/GMFVirtualClock.h>
+
+// Histogram values are reported to within about 3%.
+static const double kAccuracy = 0.035;
+
+@interface GMFQoEMonitorTests : XCTestCase<GMFQoEMonitorDelegate>
+@end
+
+@implementation GMFQoEMonitorTests {
+ @private
+  GMFVirtualClock *_clock;
+  GMFQoEMonitor *_monitor;
+  GMFPlayerState _state;
+  NSMutableArray *_endedSessions;
+}
+
+- (void)setUp {
+  [super setUp];
+  _clock = [[GMFVirtualClock alloc] init];
+  _monitor = [[GMFQoEMonitor alloc] initWithClock:_clock];
+  [_monitor setDelegate:self];
+  _state = kGMFPlayerStateEmpty;
+  _endedSessions = [NSMutableArray array];
+}
+
+- (void)qoeMonitor:(GMFQoEMonitor *)monitor didEndSession:(GMFQoESession *)session {
+  [_endedSessions addObject:session];
+}
+
+- (void)moveToState:(GMFPlayerState)state after:(NSTimeInterval)delay {
+  [_clock advanceBy:delay];
+  [_monitor playerStateDidChangeFrom:_state to:state];
+  _state = state;
+}
+
+// Loads content and starts playing after |timeToFirstFrame|.
+- (void)startSessionWithTimeToFirstFrame:(NSTimeInterval)timeToFirstFrame {
+  [self moveToState:kGMFPlayerStateLoadingContent after:0];
+  [self moveToState:kGMFPlayerStateReadyToPlay after:timeToFirstFrame / 2];
+  [self moveToState:kGMFPlayerStatePlaying after:timeToFirstFrame / 2];
+}
+
+#pragma mark Histogram
+
+- (void)testHistogramPercentiles {
+  GMFLatencyHistogram *histogram =
+      [[GMFLatencyHistogram alloc] initWithLowestValue:0.001 highestValue:3600];
+  for (NSUInteger i = 1; i <= 1000; i++) {
+    [histogram recordValue:i * 0.001];
+  }
+  GMFHistogramSnapshot snapshot = [histogram snapshot];
+  XCTAssertEqual(snapshot.count, (uint64_t)1000);
+  XCTAssertEqualWithAccuracy(snapshot.minimum, 0.001, 1e-12);
+  XCTAssertEqualWithAccuracy(snapshot.maximum, 1.0, 1e-12);
+  XCTAssertEqualWithAccuracy(snapshot.mean, 0.5005, 1e-9);
+  XCTAssertEqualWithAccuracy(snapshot.p50, 0.5, 0.5 * kAccuracy);
+  XCTAssertEqualWithAccuracy(snapshot.p95, 0.95, 0.95 * kAccuracy);
+  XCTAssertEqualWithAccuracy(snapshot.p99, 0.99, 0.99 * kAccuracy);
+  XCTAssertEqualWithAccuracy([histogram valueAtPercentile:100], 1.0, kAccuracy);
+  XCTAssertEqualWithAccuracy([histogram valueAtPercentile:0], 0.001, 0.001 * kAccuracy);
+}
+
+- (void)testHistogramEdgeValues {
+  GMFLatencyHistogram *histogram = [[GMFLatencyHistogram alloc] initWithLowestValue:1
+                                                                       highestValue:1024];
+  XCTAssertEqual([histogram valueAtPercentile:50], 0.0);
+  [histogram recordValue:0];
+  [histogram recordValue:0];
+  [histogram recordValue:-5];
+  [histogram recordValue:100000];
+  // Zeros stay zero, and values past the top are reported exactly through the maximum.
+  XCTAssertEqual([histogram valueAtPercentile:50], 0.0);
+  XCTAssertEqual([histogram valueAtPercentile:100], 100000.0);
+  XCTAssertEqual([histogram minimum], 0.0);
+
+  GMFLatencyHistogram *other = [[GMFLatencyHistogram alloc] initWithLowestValue:1
+                                                                   highestValue:1024];
+  [other recordValue:8];
+  [histogram addHistogram:other];
+  XCTAssertEqual([histogram count], (uint64_t)5);
+  XCTAssertEqualWithAccuracy([histogram sum], 100008.0, 1e-9);
+
+  [histogram reset];
+  XCTAssertEqual([histogram count], (uint64_t)0);
+  XCTAssertEqual([histogram snapshot].p99, 0.0);
+}
+
+- (void)testHistogramRecordingPerformance {
+  GMFLatencyHistogram *histogram =
+      [[GMFLatencyHistogram alloc] initWithLowestValue:0.001 highestValue:3600];
+  [self measureBlock:^{
+      for (NSUInteger i = 0; i < 1000000; i++) {
+        [histogram recordValue:(i % 5000) * 0.0013];
+      }
+      [histogram snapshot];
+  }];
+}
+
+#pragma mark Monitor
+
+- (void)testTimeToFirstFrame {
+  [self startSessionWithTimeToFirstFrame:1.5];
+  XCTAssertEqualWithAccuracy([[_monitor currentSession] timeToFirstFrame], 1.5, 1e-9);
+  // Pausing and playing again doesn't count as a first frame.
+  [self moveToState:kGMFPlayerStatePaused after:10];
+  [self moveToState:kGMFPlayerStatePlaying after:1];
+  GMFQoESnapshot snapshot = [_monitor snapshot];
+  XCTAssertEqual(snapshot.sessionCount, (NSUInteger)1);
+  XCTAssertEqual(snapshot.timeToFirstFrame.count, (uint64_t)1);
+  XCTAssertEqualWithAccuracy(snapshot.timeToFirstFrame.p50, 1.5, 1e-9);
+  XCTAssertEqualWithAccuracy(snapshot.totalPlayingDuration, 10, 1e-9);
+}
+
+- (void)testSeekLatency {
+  [self startSessionWithTimeToFirstFrame:1];
+  [self moveToState:kGMFPlayerStateSeeking after:5];
+  [self moveToState:kGMFPlayerStateBuffering after:0.2];
+  [self moveToState:kGMFPlayerStatePlaying after:0.3];
+  [self moveToState:kGMFPlayerStateSeeking after:5];
+  [self moveToState:kGMFPlayerStatePaused after:0.1];
+
+  GMFLatencyHistogram *seeks = [[_monitor currentSession] seekLatency];
+  XCTAssertEqual([seeks count], (uint64_t)2);
+  XCTAssertEqualWithAccuracy([seeks minimum], 0.1, 1e-9);
+  XCTAssertEqualWithAccuracy([seeks maximum], 0.5, 1e-9);
+  // Buffering after a seek is part of the seek, not a stall.
+  XCTAssertEqual([[_monitor currentSession] rebufferCount], (NSUInteger)0);
+  XCTAssertEqual([_monitor snapshot].seekLatency.count, (uint64_t)2);
+}
+
+- (void)testRebuffering {
+  [self startSessionWithTimeToFirstFrame:1];
+  [self moveToState:kGMFPlayerStateBuffering after:6];
+  [self moveToState:kGMFPlayerStatePlaying after:1];
+  [self moveToState:kGMFPlayerStateBuffering after:2];
+  // A stall the viewer pauses out of still counts.
+  [self moveToState:kGMFPlayerStatePaused after:1];
+
+  GMFQoESession *session = [_monitor currentSession];
+  XCTAssertEqual([session rebufferCount], (NSUInteger)2);
+  XCTAssertEqualWithAccuracy([session rebufferDuration], 2, 1e-9);
+  XCTAssertEqualWithAccuracy([session playingDuration], 8, 1e-9);
+  XCTAssertEqualWithAccuracy([session rebufferRatio], 0.2, 1e-9);
+  XCTAssertEqual([[session rebufferDurations] count], (uint64_t)2);
+
+  [self moveToState:kGMFPlayerStateFinished after:1];
+  XCTAssertNil([_monitor currentSession]);
+  XCTAssertEqual([_endedSessions count], (NSUInteger)1);
+  GMFQoESnapshot snapshot = [_monitor snapshot];
+  XCTAssertEqual(snapshot.rebufferCount.count, (uint64_t)1);
+  XCTAssertEqualWithAccuracy(snapshot.rebufferCount.p50, 2, 2 * kAccuracy);
+  XCTAssertEqualWithAccuracy(snapshot.rebufferRatio.p50, 0.2, 0.2 * kAccuracy);
+  XCTAssertEqualWithAccuracy(snapshot.totalRebufferDuration, 2, 1e-9);
+}
+
+- (void)testPlayheadTicksKeepDurationsCurrent {
+  [self startSessionWithTimeToFirstFrame:1];
+  [_clock advanceBy:3];
+  [_monitor playheadDidMoveToTime:3];
+  XCTAssertEqualWithAccuracy([[_monitor currentSession] playingDuration], 3, 1e-9);
+  [self moveToState:kGMFPlayerStateBuffering after:0];
+  [_clock advanceBy:2];
+  [_monitor playheadDidMoveToTime:3];
+  XCTAssertEqualWithAccuracy([[_monitor currentSession] rebufferDuration], 2, 1e-9);
+  XCTAssertEqualWithAccuracy([[_monitor currentSession] playingDuration], 3, 1e-9);
+}
+
+- (void)testAdToContentSwitchTime {
+  [self startSessionWithTimeToFirstFrame:1];
+  [_monitor adBreakDidStart];
+  [self moveToState:kGMFPlayerStatePaused after:0];
+  [_clock advanceBy:30];
+  [_monitor adBreakDidEnd];
+  [self moveToState:kGMFPlayerStatePlaying after:0.4];
+
+  GMFQoESession *session = [_monitor currentSession];
+  XCTAssertEqual([[session adToContentSwitchTime] count], (uint64_t)1);
+  XCTAssertEqualWithAccuracy([[session adToContentSwitchTime] maximum], 0.4, 1e-9);
+  // The ad break itself is neither playing nor stalled time.
+  XCTAssertEqualWithAccuracy([session playingDuration], 0, 1e-9);
+  XCTAssertEqual([_monitor snapshot].adToContentSwitchTime.count, (uint64_t)1);
+
+  // Ending a break that never started records nothing.
+  [_monitor adBreakDidEnd];
+  [self moveToState:kGMFPlayerStatePaused after:1];
+  [self moveToState:kGMFPlayerStatePlaying after:1];
+  XCTAssertEqual([[session adToContentSwitchTime] count], (uint64_t)1);
+}
+
+- (void)testPrerollAbandonsTimeToFirstFrame {
+  [self moveToState:kGMFPlayerStateLoadingContent after:0];
+  [_monitor adBreakDidStart];
+  [_clock advanceBy:15];
+  [_monitor adBreakDidEnd];
+  [self moveToState:kGMFPlayerStatePlaying after:0.5];
+
+  XCTAssertLessThan([[_monitor currentSession] timeToFirstFrame], 0);
+  GMFQoESnapshot snapshot = [_monitor snapshot];
+  XCTAssertEqual(snapshot.timeToFirstFrame.count, (uint64_t)0);
+  XCTAssertEqual(snapshot.adToContentSwitchTime.count, (uint64_t)1);
+}
+
+- (void)testSessionsAggregate {
+  [self startSessionWithTimeToFirstFrame:1];
+  [self startSessionWithTimeToFirstFrame:2];
+  [self startSessionWithTimeToFirstFrame:4];
+  // A session abandoned before its first frame adds no rebuffer count or ratio.
+  [self moveToState:kGMFPlayerStateLoadingContent after:1];
+  [self moveToState:kGMFPlayerStateEmpty after:1];
+
+  XCTAssertEqual([_endedSessions count], (NSUInteger)4);
+  GMFQoESnapshot snapshot = [_monitor snapshot];
+  XCTAssertEqual(snapshot.sessionCount, (NSUInteger)4);
+  XCTAssertEqual(snapshot.timeToFirstFrame.count, (uint64_t)3);
+  XCTAssertEqualWithAccuracy(snapshot.timeToFirstFrame.p50, 2, 2 * kAccuracy);
+  XCTAssertEqualWithAccuracy(snapshot.timeToFirstFrame.p99, 4, 1e-9);
+  XCTAssertEqual(snapshot.rebufferCount.count, (uint64_t)3);
+  XCTAssertEqual(snapshot.rebufferCount.p99, 0.0);
+
+  [_monitor resetAggregates];
+  snapshot = [_monitor snapshot];
+  XCTAssertEqual(snapshot.sessionCount, (NSUInteger)0);
+  XCTAssertEqual(snapshot.timeToFirstFrame.count, (uint64_t)0);
+}
+
+@end
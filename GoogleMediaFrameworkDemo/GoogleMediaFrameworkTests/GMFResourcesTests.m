@@ -0,0 +1,105 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFLRUCache.h>
+#import <GoogleMediaFramework/GMFPlayerOverlayView.h>
+#import <GoogleMediaFramework/GMFResources.h>
+
+// Players built per measured block, roughly one screen of a scrolling feed.
+static const NSUInteger kBenchmarkPlayers = 10;
+
+@interface GMFResourcesTests : XCTestCase
+@end
+
+@implementation GMFResourcesTests
+
+- (void)setUp {
+  [super setUp];
+  [GMFResources setCachingEnabled:YES];
+  [[GMFResources imageCache] resetStatistics];
+}
+
+- (void)tearDown {
+  [GMFResources setCachingEnabled:YES];
+  [super tearDown];
+}
+
+- (void)testImagesAreServedFromTheCache {
+  UIImage *first = [GMFResources playerBarPlayButtonImage];
+  UIImage *second = [GMFResources playerBarPlayButtonImage];
+
+  XCTAssertNotNil(first);
+  XCTAssertEqual(first, second);
+  XCTAssertTrue([[GMFResources imageCache] hitCount] >= 1);
+}
+
+- (void)testTintedImagesAreCachedPerColor {
+  UIImage *image = [GMFResources playerBarPauseButtonImage];
+  UIImage *red = [GMFResources tintedImage:image color:[UIColor redColor]];
+
+  XCTAssertEqual([GMFResources tintedImage:image color:[UIColor redColor]], red);
+  // Tinting a tinted image keys off the original resource.
+  XCTAssertEqual([GMFResources tintedImage:red color:[UIColor redColor]], red);
+  XCTAssertNotEqual([GMFResources tintedImage:image color:[UIColor blueColor]], red);
+  XCTAssertEqual([red scale], [image scale]);
+}
+
+- (void)testImagesNotFromResourcesAreStillTinted {
+  UIGraphicsBeginImageContextWithOptions(CGSizeMake(4, 4), NO, 2);
+  UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+  UIGraphicsEndImageContext();
+
+  UIImage *tinted = [GMFResources tintedImage:image color:[UIColor redColor]];
+
+  XCTAssertNotNil(tinted);
+  XCTAssertTrue(CGSizeEqualToSize([tinted size], [image size]));
+}
+
+- (void)testControlImagesKeepTheirSizeInTheAtlas {
+  [GMFResources setCachingEnabled:NO];
+  CGSize diskSize = [[GMFResources playerBarBackgroundImage] size];
+  [GMFResources setCachingEnabled:YES];
+
+  XCTAssertTrue(CGSizeEqualToSize([[GMFResources playerBarBackgroundImage] size], diskSize));
+}
+
+#pragma mark Player construction benchmarks
+
+- (void)testBenchmarkPlayerConstructionWithCache {
+  [self measurePlayerConstruction];
+  GMFLRUCache *cache = [GMFResources imageCache];
+  NSLog(@"Image cache: %lu hits, %lu misses, %lu bytes.",
+        (unsigned long)[cache hitCount],
+        (unsigned long)[cache missCount],
+        (unsigned long)[cache totalCost]);
+}
+
+- (void)testBenchmarkPlayerConstructionWithoutCache {
+  [GMFResources setCachingEnabled:NO];
+  [self measurePlayerConstruction];
+}
+
+- (void)measurePlayerConstruction {
+  UIColor *tintColor = [UIColor orangeColor];
+  [self measureBlock:^{
+      for (NSUInteger i = 0; i < kBenchmarkPlayers; i++) {
+        GMFPlayerOverlayView *overlayView = [[GMFPlayerOverlayView alloc] init];
+        [overlayView applyControlTintColor:tintColor];
+      }
+  }];
+}
+
+@end
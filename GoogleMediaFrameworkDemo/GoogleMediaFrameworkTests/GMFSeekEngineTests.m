@@ -0,0 +1,199 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFSeekEngine.h>
+#import <GoogleMediaFramework/GMFVirtualClock.h>
+
+// Histogram values are reported to within about 3%.
+static const double kAccuracy = 0.035;
+
+// Records the seeks it is asked for and completes them when told to.
+@interface GMFScriptedSeekBackend : NSObject<GMFSeekBackend>
+
+@property(nonatomic, readonly) NSMutableArray *seekTimes;
+@property(nonatomic, readonly) NSMutableArray *tolerances;
+
+- (NSUInteger)inFlightCount;
+
+// Completes the oldest outstanding seek.
+- (void)completeSeek:(BOOL)finished;
+
+@end
+
+@implementation GMFScriptedSeekBackend {
+ @private
+  NSMutableArray *_completionHandlers;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _seekTimes = [NSMutableArray array];
+    _tolerances = [NSMutableArray array];
+    _completionHandlers = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (void)seekToTime:(NSTimeInterval)time
+            tolerance:(NSTimeInterval)tolerance
+    completionHandler:(void (^)(BOOL finished))completionHandler {
+  [_seekTimes addObject:@(time)];
+  [_tolerances addObject:@(tolerance)];
+  [_completionHandlers addObject:[completionHandler copy]];
+}
+
+- (NSUInteger)inFlightCount {
+  return [_completionHandlers count];
+}
+
+- (void)completeSeek:(BOOL)finished {
+  void (^completionHandler)(BOOL) = [_completionHandlers firstObject];
+  [_completionHandlers removeObjectAtIndex:0];
+  completionHandler(finished);
+}
+
+@end
+
+@interface GMFSeekEngineTests : XCTestCase<GMFSeekEngineDelegate>
+@end
+
+@implementation GMFSeekEngineTests {
+ @private
+  GMFVirtualClock *_clock;
+  GMFScriptedSeekBackend *_backend;
+  GMFSeekEngine *_engine;
+  NSMutableArray *_finishedTimes;
+  BOOL _lastFinished;
+}
+
+- (void)setUp {
+  [super setUp];
+  _clock = [[GMFVirtualClock alloc] init];
+  _backend = [[GMFScriptedSeekBackend alloc] init];
+  _engine = [[GMFSeekEngine alloc] initWithClock:_clock];
+  [_engine setBackend:_backend];
+  [_engine setDelegate:self];
+  _finishedTimes = [NSMutableArray array];
+}
+
+- (void)seekEngine:(GMFSeekEngine *)engine
+    didFinishSeekingToTime:(NSTimeInterval)time
+                  finished:(BOOL)finished {
+  [_finishedTimes addObject:@(time)];
+  _lastFinished = finished;
+}
+
+- (void)seekToSeconds:(NSTimeInterval)seconds mode:(GMFSeekMode)mode {
+  [_engine seekToTime:seconds mode:mode];
+}
+
+- (void)testSingleSeek {
+  XCTAssertFalse([_engine isSeeking]);
+  [self seekToSeconds:12.345 mode:kGMFSeekModePrecise];
+  XCTAssertTrue([_engine isSeeking]);
+  XCTAssertEqual([_backend inFlightCount], (NSUInteger)1);
+  // Fractions of a second survive.
+  XCTAssertEqualWithAccuracy([[_backend.seekTimes firstObject] doubleValue], 12.345, 1e-9);
+  XCTAssertEqual([[_backend.tolerances firstObject] doubleValue], 0.0);
+
+  [_clock advanceBy:0.2];
+  [_backend completeSeek:YES];
+  XCTAssertFalse([_engine isSeeking]);
+  XCTAssertEqualObjects(_finishedTimes, @[ @12.345 ]);
+  XCTAssertTrue(_lastFinished);
+  XCTAssertEqual([_engine issuedCount], (NSUInteger)1);
+  XCTAssertEqual([_engine droppedCount], (NSUInteger)0);
+  XCTAssertEqualWithAccuracy([[_engine seekLatency] mean], 0.2, 0.2 * kAccuracy);
+}
+
+- (void)testFastSeeksHaveKeyframeTolerance {
+  [self seekToSeconds:5 mode:kGMFSeekModeFast];
+  XCTAssertEqual([[_backend.tolerances firstObject] doubleValue], (double)INFINITY);
+}
+
+- (void)testDragIsCoalescedToLatestTarget {
+  // A drag across the scrubber while the first fast seek is slow to complete.
+  for (NSUInteger i = 1; i <= 30; i++) {
+    [self seekToSeconds:i mode:kGMFSeekModeFast];
+    [_clock advanceBy:0.016];
+  }
+  [self seekToSeconds:31.5 mode:kGMFSeekModePrecise];
+  XCTAssertEqual([_backend inFlightCount], (NSUInteger)1);
+  XCTAssertEqualObjects(_backend.seekTimes, @[ @1 ]);
+
+  // Only the final, precise target is issued next; the rest of the drag never reaches the
+  // backend.
+  [_backend completeSeek:YES];
+  XCTAssertEqual([_finishedTimes count], (NSUInteger)0);
+  XCTAssertEqualObjects(_backend.seekTimes, (@[ @1, @31.5 ]));
+  XCTAssertEqual([[_backend.tolerances lastObject] doubleValue], 0.0);
+
+  [_backend completeSeek:YES];
+  XCTAssertEqualObjects(_finishedTimes, @[ @31.5 ]);
+  XCTAssertEqual([_engine requestedCount], (NSUInteger)31);
+  XCTAssertEqual([_engine issuedCount], (NSUInteger)2);
+  XCTAssertEqual([_engine droppedCount], (NSUInteger)29);
+  XCTAssertEqual([_engine targetTime], 31.5);
+  XCTAssertEqual([[_engine seekLatency] snapshot].count, (uint64_t)2);
+}
+
+- (void)testInterruptedSeekIsReported {
+  [self seekToSeconds:3 mode:kGMFSeekModePrecise];
+  [_backend completeSeek:NO];
+  XCTAssertEqualObjects(_finishedTimes, @[ @3 ]);
+  XCTAssertFalse(_lastFinished);
+}
+
+- (void)testCancelIgnoresInFlightCompletion {
+  [self seekToSeconds:3 mode:kGMFSeekModePrecise];
+  [self seekToSeconds:4 mode:kGMFSeekModePrecise];
+  [_engine cancel];
+  XCTAssertFalse([_engine isSeeking]);
+  [_backend completeSeek:YES];
+  XCTAssertEqual([_finishedTimes count], (NSUInteger)0);
+  XCTAssertEqualObjects(_backend.seekTimes, @[ @3 ]);
+
+  // A new seek goes straight to the backend.
+  [self seekToSeconds:5 mode:kGMFSeekModePrecise];
+  XCTAssertEqualObjects(_backend.seekTimes, (@[ @3, @5 ]));
+  [_backend completeSeek:YES];
+  XCTAssertEqualObjects(_finishedTimes, @[ @5 ]);
+}
+
+- (void)testNewBackendCancels {
+  [self seekToSeconds:3 mode:kGMFSeekModePrecise];
+  GMFScriptedSeekBackend *backend = [[GMFScriptedSeekBackend alloc] init];
+  [_engine setBackend:backend];
+  XCTAssertFalse([_engine isSeeking]);
+  [_backend completeSeek:YES];
+  XCTAssertEqual([_finishedTimes count], (NSUInteger)0);
+
+  [self seekToSeconds:8 mode:kGMFSeekModePrecise];
+  XCTAssertEqual([backend inFlightCount], (NSUInteger)1);
+  XCTAssertEqual([_backend inFlightCount], (NSUInteger)0);
+}
+
+- (void)testResetStatistics {
+  [self seekToSeconds:1 mode:kGMFSeekModeFast];
+  [_backend completeSeek:YES];
+  [_engine resetStatistics];
+  XCTAssertEqual([_engine requestedCount], (NSUInteger)0);
+  XCTAssertEqual([_engine issuedCount], (NSUInteger)0);
+  XCTAssertEqual([[_engine seekLatency] snapshot].count, (uint64_t)0);
+}
+
+@end
@@ -0,0 +1,343 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFSourceSelector.h>
+#import <GoogleMediaFramework/GMFVirtualClock.h>
+
+#import "GMFTestHTTPServer.h"
+
+static const NSTimeInterval kAccuracy = 1e-9;
+
+static NSString *const kPlaylistPath = @"/live/index.m3u8";
+
+static NSString *const kMasterPlaylist =
+    @"#EXTM3U\n"
+    @"#EXT-X-STREAM-INF:BANDWIDTH=800000\n"
+    @"low.m3u8\n"
+    @"#EXT-X-STREAM-INF:BANDWIDTH=2400000\n"
+    @"high.m3u8\n";
+
+// Response delays of the stand-in CDNs: a slow one and a fast one.
+static const NSTimeInterval kSlowCDNDelay = 0.6;
+static const NSTimeInterval kFastCDNDelay = 0.05;
+
+// Answers probes on a virtual clock, standing in for CDNs with scripted latencies and failures.
+@interface GMFStandInProber : NSObject<GMFSourceProber>
+
+@property(nonatomic, readonly) NSMutableArray *probedURLs;
+
+- (instancetype)initWithClock:(GMFVirtualClock *)clock;
+
+// Probes of |URL| answer after |latency| seconds, or fail then if |fails|. Probes of URLs without
+// a script never answer.
+- (void)setLatency:(NSTimeInterval)latency fails:(BOOL)fails forURL:(NSURL *)URL;
+
+@end
+
+@implementation GMFStandInProber {
+ @private
+  GMFVirtualClock *_clock;
+  NSMutableDictionary *_latencies;
+  NSMutableSet *_failingURLs;
+}
+
+- (instancetype)initWithClock:(GMFVirtualClock *)clock {
+  self = [super init];
+  if (self) {
+    _clock = clock;
+    _probedURLs = [NSMutableArray array];
+    _latencies = [NSMutableDictionary dictionary];
+    _failingURLs = [NSMutableSet set];
+  }
+  return self;
+}
+
+- (void)setLatency:(NSTimeInterval)latency fails:(BOOL)fails forURL:(NSURL *)URL {
+  [_latencies setObject:@(latency) forKey:URL];
+  if (fails) {
+    [_failingURLs addObject:URL];
+  }
+}
+
+- (void)probeSourceWithURL:(NSURL *)URL
+                completion:(void (^)(uint64_t bytes, NSError *error))completion {
+  [_probedURLs addObject:URL];
+  NSNumber *latency = [_latencies objectForKey:URL];
+  if (!latency) {
+    return;
+  }
+  BOOL fails = [_failingURLs containsObject:URL];
+  [_clock scheduleBlock:^{
+      NSError *error = [NSError errorWithDomain:NSURLErrorDomain
+                                           code:NSURLErrorCannotConnectToHost
+                                       userInfo:nil];
+      completion(fails ? 0 : 1024, fails ? error : nil);
+  } afterDelay:[latency doubleValue]];
+}
+
+@end
+
+@interface GMFSourceSelectorTests : XCTestCase
+@end
+
+@implementation GMFSourceSelectorTests {
+ @private
+  GMFVirtualClock *_clock;
+  GMFStandInProber *_prober;
+  GMFSourceSelector *_selector;
+  NSURL *_a;
+  NSURL *_b;
+  NSURL *_c;
+  NSMutableArray *_selections;
+  NSError *_error;
+  NSMutableArray *_servers;
+}
+
+- (void)setUp {
+  [super setUp];
+  _clock = [[GMFVirtualClock alloc] init];
+  _prober = [[GMFStandInProber alloc] initWithClock:_clock];
+  _selector = [[GMFSourceSelector alloc] initWithProber:_prober clock:_clock];
+  _a = [NSURL URLWithString:@"http://cdn-a.example.com/live/index.m3u8"];
+  _b = [NSURL URLWithString:@"http://cdn-b.example.com/live/index.m3u8"];
+  _c = [NSURL URLWithString:@"http://cdn-c.example.com/live/index.m3u8"];
+  _selections = [NSMutableArray array];
+  _servers = [NSMutableArray array];
+}
+
+- (void)tearDown {
+  for (GMFTestHTTPServer *server in _servers) {
+    [server stop];
+  }
+  [super tearDown];
+}
+
+// Starts a selection of |URLs| that records its outcome.
+- (void)selectFromURLs:(NSArray *)URLs {
+  __weak GMFSourceSelectorTests *weakSelf = self;
+  [_selector selectSourceFromURLs:URLs completion:^(NSURL *URL, NSError *error) {
+      [weakSelf didSelectSource:URL error:error];
+  }];
+}
+
+- (void)didSelectSource:(NSURL *)URL error:(NSError *)error {
+  [_selections addObject:URL ?: [NSNull null]];
+  _error = error;
+}
+
+- (void)testFastestSourceWins {
+  [_prober setLatency:0.8 fails:NO forURL:_a];
+  [_prober setLatency:0.1 fails:NO forURL:_b];
+  [_prober setLatency:0.3 fails:NO forURL:_c];
+  [self selectFromURLs:@[ _a, _b, _c ]];
+  XCTAssertEqual([[_prober probedURLs] count], (NSUInteger)3);
+  XCTAssertNil([_selector selectedSource]);
+
+  [_clock advanceBy:0.1];
+  XCTAssertEqualObjects(_selections, @[ _b ]);
+  XCTAssertEqualObjects([_selector selectedSource], _b);
+  XCTAssertEqual([[_selector selectionLatency] count], (uint64_t)1);
+  XCTAssertEqualWithAccuracy([[_selector selectionLatency] maximum], 0.1, 0.001);
+
+  // The losers still answer, and are scored for the next stream.
+  [_clock advanceBy:1];
+  XCTAssertEqual([_selections count], (NSUInteger)1);
+  XCTAssertEqualWithAccuracy([_selector probeLatencyForSource:_a], 0.8, kAccuracy);
+  XCTAssertEqualWithAccuracy([_selector probeLatencyForSource:_c], 0.3, kAccuracy);
+  XCTAssertEqualObjects([_selector rankedSources:@[ _a, _b, _c ]], (@[ _b, _c, _a ]));
+}
+
+- (void)testFailedProbeIsReplaced {
+  [_selector setRaceWidth:2];
+  [_prober setLatency:0.05 fails:YES forURL:_a];
+  [_prober setLatency:0.2 fails:NO forURL:_c];
+  [self selectFromURLs:@[ _a, _b, _c ]];
+  XCTAssertEqualObjects([_prober probedURLs], (@[ _a, _b ]));
+
+  [_clock advanceBy:0.05];
+  XCTAssertEqualObjects([_prober probedURLs], (@[ _a, _b, _c ]));
+  [_clock advanceBy:0.15];
+  XCTAssertEqual([_selections count], (NSUInteger)0);
+  [_clock advanceBy:0.05];
+  XCTAssertEqualObjects(_selections, @[ _c ]);
+  XCTAssertEqual([_selector probeFailureCount], (NSUInteger)1);
+  // The host that failed ranks last, behind the one never heard from.
+  XCTAssertEqualObjects([_selector rankedSources:@[ _a, _b, _c ]], (@[ _c, _b, _a ]));
+}
+
+- (void)testSelectionFailsWhenNoSourceAnswers {
+  [_selector setProbeTimeout:1];
+  [_prober setLatency:0.1 fails:YES forURL:_a];
+  [self selectFromURLs:@[ _a, _b, _c ]];
+  [_clock advanceBy:0.9];
+  XCTAssertEqual([_selections count], (NSUInteger)0);
+  [_clock advanceBy:0.1];
+  XCTAssertEqualObjects(_selections, @[ [NSNull null] ]);
+  XCTAssertEqualObjects([_error domain], kGMFSourceSelectorErrorDomain);
+  XCTAssertEqual([_error code], (NSInteger)kGMFSourceSelectorErrorTimedOut);
+  XCTAssertEqual([_selector probeFailureCount], (NSUInteger)3);
+  XCTAssertEqual([_selector selectionCount], (NSUInteger)0);
+  XCTAssertNil([_selector selectedSource]);
+}
+
+- (void)testNoSources {
+  [self selectFromURLs:@[]];
+  XCTAssertEqualObjects(_selections, @[ [NSNull null] ]);
+  XCTAssertEqual([_error code], (NSInteger)kGMFSourceSelectorErrorNoSources);
+}
+
+- (void)testCancelledSelectionNeverCompletes {
+  [_prober setLatency:0.1 fails:NO forURL:_a];
+  [self selectFromURLs:@[ _a, _b ]];
+  [_selector cancelSelection];
+  [_clock advanceBy:10];
+  XCTAssertEqual([_selections count], (NSUInteger)0);
+  XCTAssertEqual([_selector probeFailureCount], (NSUInteger)0);
+  XCTAssertEqualWithAccuracy([_selector probeLatencyForSource:_a], 0.1, kAccuracy);
+}
+
+- (void)testFailoverFollowsRanking {
+  [_prober setLatency:0.3 fails:NO forURL:_a];
+  [_prober setLatency:0.1 fails:NO forURL:_b];
+  [_prober setLatency:0.2 fails:NO forURL:_c];
+  [self selectFromURLs:@[ _a, _b, _c ]];
+  [_clock advanceBy:1];
+  XCTAssertEqualObjects([_selector selectedSource], _b);
+
+  XCTAssertEqualObjects([_selector failoverSourceAfterFailureOfSource:_b], _c);
+  XCTAssertEqualObjects([_selector selectedSource], _c);
+  XCTAssertEqualObjects([_selector rankedSources:@[ _a, _b, _c ]], (@[ _c, _a, _b ]));
+  XCTAssertEqualObjects([_selector failoverSourceAfterFailureOfSource:_c], _a);
+  XCTAssertNil([_selector failoverSourceAfterFailureOfSource:_a]);
+  XCTAssertEqual([_selector failoverCount], (NSUInteger)2);
+
+  // Penalties wear off.
+  [_clock advanceBy:[_selector failurePenalty]];
+  XCTAssertEqualObjects([_selector rankedSources:@[ _a, _b, _c ]], (@[ _b, _c, _a ]));
+}
+
+- (void)testMeasuredThroughputOutranksProbeLatency {
+  [_prober setLatency:0.1 fails:NO forURL:_a];
+  [_prober setLatency:0.2 fails:NO forURL:_b];
+  [self selectFromURLs:@[ _a, _b ]];
+  [_clock advanceBy:1];
+  XCTAssertEqualObjects([_selector rankedSources:@[ _a, _b ]], (@[ _a, _b ]));
+
+  // 4 MB in a second from another stream on the same host.
+  NSURL *segment = [NSURL URLWithString:@"http://cdn-b.example.com/vod/segment7.ts"];
+  [_selector recordTransferWithBytes:4 * 1024 * 1024 duration:1 fromSource:segment];
+  XCTAssertGreaterThan([_selector estimatedBitrateForSource:_b], 1e6);
+  XCTAssertEqual([_selector estimatedBitrateForSource:_a], 0.0);
+  XCTAssertEqualObjects([_selector rankedSources:@[ _a, _b ]], (@[ _b, _a ]));
+
+  [_selector resetScores];
+  XCTAssertTrue(isnan([_selector probeLatencyForSource:_a]));
+  XCTAssertEqualObjects([_selector rankedSources:@[ _b, _a ]], (@[ _b, _a ]));
+}
+
+#pragma mark Stand-in CDNs
+
+// A stand-in CDN serving a master playlist after |delay|, or failing with |errorStatusCode|.
+- (NSURL *)URLOfCDNWithDelay:(NSTimeInterval)delay errorStatusCode:(NSInteger)errorStatusCode {
+  GMFTestHTTPServer *server = [[GMFTestHTTPServer alloc] init];
+  XCTAssertNotNil(server);
+  [server setBody:[kMasterPlaylist dataUsingEncoding:NSUTF8StringEncoding]
+         MIMEType:@"application/vnd.apple.mpegurl"
+          forPath:kPlaylistPath];
+  [server setResponseDelay:delay];
+  [server setErrorStatusCode:errorStatusCode];
+  [_servers addObject:server];
+  return [NSURL URLWithString:kPlaylistPath relativeToURL:[server baseURL]];
+}
+
+// Runs a selection of |URLs| by |selector| on the main run loop. Returns the source it picked and
+// sets |elapsed| to the time it took.
+- (NSURL *)selectFromURLs:(NSArray *)URLs
+             withSelector:(GMFSourceSelector *)selector
+                  elapsed:(NSTimeInterval *)elapsed {
+  __block BOOL done = NO;
+  __block NSURL *result = nil;
+  NSDate *start = [NSDate date];
+  [selector selectSourceFromURLs:URLs completion:^(NSURL *URL, NSError *error) {
+      result = URL;
+      done = YES;
+  }];
+  NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:5];
+  while (!done && [deadline timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode
+                             beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  }
+  XCTAssertTrue(done);
+  *elapsed = -[start timeIntervalSinceNow];
+  return result;
+}
+
+- (void)spinRunLoopFor:(NSTimeInterval)duration {
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:duration]];
+}
+
+// The first source listed is slow and the second broken. Loading the first, as a single URL
+// load does, waits for the slow CDN; racing them starts on the fast one.
+- (void)testRacingStandInCDNsCutsStartupLatency {
+  NSURL *slow = [self URLOfCDNWithDelay:kSlowCDNDelay errorStatusCode:0];
+  NSURL *broken = [self URLOfCDNWithDelay:0 errorStatusCode:503];
+  NSURL *fast = [self URLOfCDNWithDelay:kFastCDNDelay errorStatusCode:0];
+  NSArray *URLs = @[ slow, broken, fast ];
+
+  GMFSourceSelector *firstSourceOnly = [[GMFSourceSelector alloc] init];
+  [firstSourceOnly setRaceWidth:1];
+  NSTimeInterval firstSourceLatency;
+  XCTAssertEqualObjects([self selectFromURLs:URLs
+                                withSelector:firstSourceOnly
+                                     elapsed:&firstSourceLatency],
+                        slow);
+
+  GMFSourceSelector *racing = [[GMFSourceSelector alloc] init];
+  NSTimeInterval racingLatency;
+  XCTAssertEqualObjects([self selectFromURLs:URLs withSelector:racing elapsed:&racingLatency],
+                        fast);
+  NSLog(@"Time to first frame spent on the source: %.2fs racing, %.2fs loading the first.",
+        racingLatency,
+        firstSourceLatency);
+  XCTAssertGreaterThanOrEqual(firstSourceLatency, kSlowCDNDelay);
+  XCTAssertLessThan(racingLatency, kSlowCDNDelay / 2);
+
+  // Once every CDN answered, the next stream starts with the fast one.
+  [self spinRunLoopFor:kSlowCDNDelay + 0.2];
+  XCTAssertEqualObjects([racing rankedSources:URLs], (@[ fast, slow, broken ]));
+}
+
+// A CDN that never answers and one that is down are tried one after the other.
+- (void)testHungAndDeadCDNsAreSkipped {
+  NSURL *hung = [self URLOfCDNWithDelay:2 errorStatusCode:0];
+  NSURL *dead = [self URLOfCDNWithDelay:0 errorStatusCode:0];
+  [[_servers lastObject] stop];
+  NSURL *fast = [self URLOfCDNWithDelay:kFastCDNDelay errorStatusCode:0];
+
+  GMFSourceSelector *selector = [[GMFSourceSelector alloc] init];
+  [selector setRaceWidth:1];
+  [selector setProbeTimeout:0.5];
+  NSTimeInterval latency;
+  XCTAssertEqualObjects([self selectFromURLs:@[ hung, dead, fast ]
+                                withSelector:selector
+                                     elapsed:&latency],
+                        fast);
+  XCTAssertEqual([selector probeFailureCount], (NSUInteger)2);
+  XCTAssertLessThan(latency, 1.5);
+}
+
+@end
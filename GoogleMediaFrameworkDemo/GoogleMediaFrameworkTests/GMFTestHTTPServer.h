@@ -0,0 +1,41 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#import <Foundation/Foundation.h>
+
+// Minimal HTTP/1.0 server on the loopback interface standing in for a CDN. Serves the bodies
+// added to it, honours single Range headers unless |ignoresRanges| is set, and counts requests.
+// Requests are answered one at a time, in the order they arrive.
+@interface GMFTestHTTPServer : NSObject
+
+@property(nonatomic, readonly) NSURL *baseURL;
+@property(atomic, assign) BOOL ignoresRanges;
+
+// Seconds each response is held back, standing in for a slow or overloaded CDN.
+@property(atomic, assign) NSTimeInterval responseDelay;
+
+// Seconds the second half of each body is held back after the first half is sent, standing in
+// for a long download.
+@property(atomic, assign) NSTimeInterval bodyDelay;
+
+// When not 0, every request is answered with this status and no body, standing in for a broken
+// CDN.
+@property(atomic, assign) NSInteger errorStatusCode;
+
+- (void)setBody:(NSData *)body MIMEType:(NSString *)MIMEType forPath:(NSString *)path;
+- (NSUInteger)requestCount;
+- (void)stop;
+
+@end
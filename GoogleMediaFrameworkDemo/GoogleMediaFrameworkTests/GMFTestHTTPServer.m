@@ -0,0 +1,176 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#import <arpa/inet.h>
+#import <netinet/in.h>
+#import <sys/socket.h>
+#import <unistd.h>
+
+#import "GMFTestHTTPServer.h"
+
+@implementation GMFTestHTTPServer {
+  int _socket;
+  NSMutableDictionary *_bodies;
+  NSMutableDictionary *_MIMETypes;
+  NSUInteger _requestCount;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _bodies = [NSMutableDictionary dictionary];
+    _MIMETypes = [NSMutableDictionary dictionary];
+    _socket = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_len = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (_socket < 0 ||
+        bind(_socket, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+        listen(_socket, 16) != 0 ||
+        getsockname(_socket, (struct sockaddr *)&address, &length) != 0) {
+      return nil;
+    }
+    _baseURL = [NSURL URLWithString:
+        [NSString stringWithFormat:@"http://127.0.0.1:%d/", ntohs(address.sin_port)]];
+    int listening = _socket;
+    __weak GMFTestHTTPServer *weakSelf = self;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        int connection;
+        while ((connection = accept(listening, NULL, NULL)) >= 0) {
+          // A client that gave up mustn't kill the test process when the answer is written.
+          int noSignal = 1;
+          setsockopt(connection, SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+          [weakSelf serveConnection:connection];
+          close(connection);
+        }
+    });
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [self stop];
+}
+
+- (void)stop {
+  if (_socket >= 0) {
+    // Makes the pending accept fail, which ends the server loop.
+    shutdown(_socket, SHUT_RDWR);
+    close(_socket);
+    _socket = -1;
+  }
+}
+
+- (void)setBody:(NSData *)body MIMEType:(NSString *)MIMEType forPath:(NSString *)path {
+  @synchronized(self) {
+    [_bodies setObject:body forKey:path];
+    [_MIMETypes setObject:MIMEType forKey:path];
+  }
+}
+
+- (NSUInteger)requestCount {
+  @synchronized(self) {
+    return _requestCount;
+  }
+}
+
+- (void)serveConnection:(int)connection {
+  NSMutableData *request = [NSMutableData data];
+  NSData *terminator = [@"\r\n\r\n" dataUsingEncoding:NSUTF8StringEncoding];
+  char buffer[4096];
+  while ([request rangeOfData:terminator options:0 range:NSMakeRange(0, [request length])]
+             .location == NSNotFound) {
+    ssize_t received = recv(connection, buffer, sizeof(buffer), 0);
+    if (received <= 0) {
+      return;
+    }
+    [request appendBytes:buffer length:(NSUInteger)received];
+  }
+
+  NSString *head = [[NSString alloc] initWithData:request encoding:NSUTF8StringEncoding];
+  NSArray *lines = [head componentsSeparatedByString:@"\r\n"];
+  NSArray *requestLine = [[lines firstObject] componentsSeparatedByString:@" "];
+  NSString *path = [requestLine count] > 1 ? [requestLine objectAtIndex:1] : @"";
+  long long first = -1;
+  long long last = -1;
+  for (NSString *line in lines) {
+    if ([[line lowercaseString] hasPrefix:@"range: bytes="]) {
+      NSScanner *scanner = [NSScanner scannerWithString:[line substringFromIndex:13]];
+      [scanner scanLongLong:&first];
+      [scanner scanString:@"-" intoString:NULL];
+      [scanner scanLongLong:&last];
+    }
+  }
+
+  NSData *body;
+  NSString *MIMEType;
+  @synchronized(self) {
+    _requestCount++;
+    body = [_bodies objectForKey:path];
+    MIMEType = [_MIMETypes objectForKey:path];
+  }
+  if ([self responseDelay] > 0) {
+    [NSThread sleepForTimeInterval:[self responseDelay]];
+  }
+  NSString *header;
+  NSInteger errorStatusCode = [self errorStatusCode];
+  if (errorStatusCode) {
+    body = [NSData data];
+    header = [NSString stringWithFormat:@"HTTP/1.0 %ld Error\r\n", (long)errorStatusCode];
+  } else if (!body) {
+    body = [NSData data];
+    header = @"HTTP/1.0 404 Not Found\r\n";
+  } else if (first >= 0 && ![self ignoresRanges]) {
+    long long total = (long long)[body length];
+    last = last < 0 ? total - 1 : MIN(last, total - 1);
+    body = [body subdataWithRange:NSMakeRange((NSUInteger)first, (NSUInteger)(last - first + 1))];
+    header = [NSString stringWithFormat:
+        @"HTTP/1.0 206 Partial Content\r\nContent-Range: bytes %lld-%lld/%lld\r\n",
+        first, last, total];
+  } else {
+    header = @"HTTP/1.0 200 OK\r\n";
+  }
+  header = [header stringByAppendingFormat:@"Content-Type: %@\r\nContent-Length: %lu\r\n\r\n",
+                                           MIMEType ?: @"text/plain", (unsigned long)[body length]];
+  NSMutableData *response = [[header dataUsingEncoding:NSUTF8StringEncoding] mutableCopy];
+  [response appendData:body];
+  NSUInteger firstPartLength = [response length] - [body length] / 2;
+  if (![self sendBytes:[response bytes] length:firstPartLength toConnection:connection]) {
+    return;
+  }
+  if ([self bodyDelay] > 0) {
+    [NSThread sleepForTimeInterval:[self bodyDelay]];
+  }
+  [self sendBytes:(const uint8_t *)[response bytes] + firstPartLength
+           length:[response length] - firstPartLength
+     toConnection:connection];
+}
+
+- (BOOL)sendBytes:(const uint8_t *)bytes length:(NSUInteger)length toConnection:(int)connection {
+  NSUInteger sent = 0;
+  while (sent < length) {
+    ssize_t written = send(connection, bytes + sent, length - sent, 0);
+    if (written <= 0) {
+      return NO;
+    }
+    sent += (NSUInteger)written;
+  }
+  return YES;
+}
+
+@end
@@ -0,0 +1,312 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFThumbnailCache.h>
+#import <GoogleMediaFramework/GMFThumbnailIndex.h>
+
+// An hour of one-second thumbnails in sprite sheets of 10x10 tiles.
+static const NSUInteger kHourThumbnailCount = 3600;
+static const NSUInteger kTilesPerSprite = 100;
+static const NSUInteger kTileWidth = 160;
+static const NSUInteger kTileHeight = 90;
+
+static const NSUInteger kBenchmarkLookupCount = 100000;
+
+// Hands out sprite objects when told to, so tests decide when loads complete.
+@interface GMFScriptedSpriteLoader : NSObject<GMFThumbnailSpriteLoader>
+
+@property(nonatomic, readonly) NSMutableArray *requestedURLs;
+
+// Completes the load of |URL| with a sprite costing |cost|, or fails it if |cost| is 0.
+- (void)finishLoadOfURL:(NSURL *)URL cost:(NSUInteger)cost;
+
+@end
+
+@implementation GMFScriptedSpriteLoader {
+ @private
+  NSMutableDictionary *_completions;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _requestedURLs = [NSMutableArray array];
+    _completions = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
+- (void)loadSpriteWithURL:(NSURL *)URL
+               completion:(void (^)(id sprite, NSUInteger cost))completion {
+  [_requestedURLs addObject:[URL absoluteString]];
+  [_completions setObject:[completion copy] forKey:[URL absoluteString]];
+}
+
+- (void)finishLoadOfURL:(NSURL *)URL cost:(NSUInteger)cost {
+  void (^completion)(id, NSUInteger) = [_completions objectForKey:[URL absoluteString]];
+  [_completions removeObjectForKey:[URL absoluteString]];
+  completion(cost ? [URL absoluteString] : nil, cost);
+}
+
+@end
+
+@interface GMFThumbnailTests : XCTestCase
+@end
+
+@implementation GMFThumbnailTests {
+ @private
+  NSURL *_baseURL;
+}
+
+- (void)setUp {
+  [super setUp];
+  _baseURL = [NSURL URLWithString:@"http://example.com/thumbs/track.vtt"];
+}
+
+- (NSString *)timestamp:(NSUInteger)seconds {
+  return [NSString stringWithFormat:@"%02lu:%02lu:%02lu.000",
+                                    (unsigned long)(seconds / 3600),
+                                    (unsigned long)(seconds / 60 % 60),
+                                    (unsigned long)(seconds % 60)];
+}
+
+// One-second cues over |count| seconds, |kTilesPerSprite| to a sheet.
+- (NSData *)trackWithThumbnailCount:(NSUInteger)count {
+  NSMutableString *track = [NSMutableString stringWithString:@"WEBVTT\n\n"];
+  for (NSUInteger i = 0; i < count; i++) {
+    NSUInteger tile = i % kTilesPerSprite;
+    [track appendFormat:@"%@ --> %@\nsprite%lu.jpg#xywh=%lu,%lu,%lu,%lu\n\n",
+                        [self timestamp:i],
+                        [self timestamp:i + 1],
+                        (unsigned long)(i / kTilesPerSprite),
+                        (unsigned long)(tile % 10 * kTileWidth),
+                        (unsigned long)(tile / 10 * kTileHeight),
+                        (unsigned long)kTileWidth,
+                        (unsigned long)kTileHeight];
+  }
+  return [track dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (GMFThumbnailIndex *)indexWithString:(NSString *)string {
+  return [GMFThumbnailIndex indexWithData:[string dataUsingEncoding:NSUTF8StringEncoding]
+                                  baseURL:_baseURL];
+}
+
+- (NSURL *)spriteURL:(NSUInteger)spriteIndex {
+  return [NSURL URLWithString:[NSString stringWithFormat:@"sprite%lu.jpg",
+                                                         (unsigned long)spriteIndex]
+                relativeToURL:_baseURL];
+}
+
+#pragma mark Index
+
+- (void)testParsesCues {
+  // Starts with a UTF-8 byte order mark.
+  NSMutableData *data = [NSMutableData dataWithBytes:"\xEF\xBB\xBF" length:3];
+  NSString *track =
+      @"WEBVTT - thumbnails\r\n"
+      @"\r\n"
+      @"NOTE generated\r\n"
+      @"\r\n"
+      @"1\r\n"
+      @"00:00.000 --> 00:05.000\r\n"
+      @"a.jpg#xywh=0,0,160,90\r\n"
+      @"\r\n"
+      @"2\r\n"
+      @"00:05.000 --> 00:10.000 align:start\r\n"
+      @"a.jpg#xywh=pixel:160,0,160,90\r\n"
+      @"\r\n"
+      @"01:00:10.500 --> 01:00:15.000\r\n"
+      @"http://cdn.example.com/b.jpg\r\n";
+  [data appendData:[track dataUsingEncoding:NSUTF8StringEncoding]];
+  GMFThumbnailIndex *index = [GMFThumbnailIndex indexWithData:data baseURL:_baseURL];
+  XCTAssertNotNil(index);
+  XCTAssertEqual([index thumbnailCount], (NSUInteger)3);
+  XCTAssertEqual([index spriteCount], (NSUInteger)2);
+
+  GMFThumbnail second = [index thumbnailAtIndex:1];
+  XCTAssertEqual(second.startTime, 5.0);
+  XCTAssertEqual(second.endTime, 10.0);
+  XCTAssertEqual(second.spriteIndex, (NSUInteger)0);
+  XCTAssertTrue(CGRectEqualToRect(second.region, CGRectMake(160, 0, 160, 90)));
+
+  GMFThumbnail third = [index thumbnailAtIndex:2];
+  XCTAssertEqualWithAccuracy(third.startTime, 3610.5, 1e-9);
+  XCTAssertEqual(third.spriteIndex, (NSUInteger)1);
+  XCTAssertTrue(CGRectIsNull(third.region));
+
+  XCTAssertEqualObjects([[index URLForSpriteAtIndex:0] absoluteString],
+                        @"http://example.com/thumbs/a.jpg");
+  XCTAssertEqualObjects([[index URLForSpriteAtIndex:1] absoluteString],
+                        @"http://cdn.example.com/b.jpg");
+}
+
+- (void)testRejectsOtherFormats {
+  XCTAssertNil([self indexWithString:@"#EXTM3U\n"]);
+  XCTAssertNil([self indexWithString:@""]);
+  GMFThumbnailIndex *empty = [self indexWithString:@"WEBVTT\n"];
+  XCTAssertEqual([empty thumbnailCount], (NSUInteger)0);
+  XCTAssertEqual([empty thumbnailIndexForTime:10], (NSUInteger)NSNotFound);
+}
+
+- (void)testReusesSpritesThatComeBack {
+  GMFThumbnailIndex *index = [self indexWithString:
+      @"WEBVTT\n\n"
+      @"00:00.000 --> 00:01.000\na.jpg#xywh=0,0,1,1\n\n"
+      @"00:01.000 --> 00:02.000\nb.jpg#xywh=0,0,1,1\n\n"
+      @"00:02.000 --> 00:03.000\na.jpg#xywh=1,0,1,1\n"];
+  XCTAssertEqual([index spriteCount], (NSUInteger)2);
+  XCTAssertEqual([index thumbnailAtIndex:2].spriteIndex, (NSUInteger)0);
+}
+
+- (void)testLookup {
+  GMFThumbnailIndex *index = [GMFThumbnailIndex indexWithData:[self trackWithThumbnailCount:300]
+                                                      baseURL:_baseURL];
+  XCTAssertEqual([index thumbnailCount], (NSUInteger)300);
+  XCTAssertEqual([index spriteCount], (NSUInteger)3);
+  XCTAssertEqual([index thumbnailIndexForTime:-5], (NSUInteger)0);
+  XCTAssertEqual([index thumbnailIndexForTime:0], (NSUInteger)0);
+  XCTAssertEqual([index thumbnailIndexForTime:41.9], (NSUInteger)41);
+  XCTAssertEqual([index thumbnailIndexForTime:42], (NSUInteger)42);
+  XCTAssertEqual([index thumbnailIndexForTime:1000], (NSUInteger)299);
+
+  GMFThumbnail thumbnail = [index thumbnailAtIndex:[index thumbnailIndexForTime:123.4]];
+  XCTAssertEqual(thumbnail.spriteIndex, (NSUInteger)1);
+  XCTAssertTrue(CGRectEqualToRect(thumbnail.region, CGRectMake(3 * 160, 2 * 90, 160, 90)));
+}
+
+- (void)testUnsortedCuesAreSorted {
+  GMFThumbnailIndex *index = [self indexWithString:
+      @"WEBVTT\n\n"
+      @"00:10.000 --> 00:20.000\nb.jpg\n\n"
+      @"00:00.000 --> 00:10.000\na.jpg\n"];
+  XCTAssertEqual([index thumbnailAtIndex:0].startTime, 0.0);
+  XCTAssertEqual([index thumbnailIndexForTime:15], (NSUInteger)1);
+}
+
+#pragma mark Cache
+
+- (void)testRequestWaitsForLoadAndDecodesAhead {
+  GMFThumbnailIndex *index = [GMFThumbnailIndex indexWithData:[self trackWithThumbnailCount:1000]
+                                                      baseURL:_baseURL];
+  GMFScriptedSpriteLoader *loader = [[GMFScriptedSpriteLoader alloc] init];
+  GMFThumbnailCache *cache = [[GMFThumbnailCache alloc] initWithIndex:index
+                                                               loader:loader
+                                                            costLimit:10];
+  __block id shownSprite = nil;
+  __block GMFThumbnail shownThumbnail;
+  void (^show)(id, GMFThumbnail) = ^(id sprite, GMFThumbnail thumbnail) {
+      shownSprite = sprite;
+      shownThumbnail = thumbnail;
+  };
+
+  [cache requestThumbnailForTime:150 completion:show];
+  XCTAssertNil(shownSprite);
+  // The requested sheet, then the next two in the default forward direction.
+  NSArray *expected = @[ [[self spriteURL:1] absoluteString],
+                         [[self spriteURL:2] absoluteString],
+                         [[self spriteURL:3] absoluteString] ];
+  XCTAssertEqualObjects(loader.requestedURLs, expected);
+  XCTAssertTrue([cache isLoadingSpriteAtIndex:2]);
+
+  [loader finishLoadOfURL:[self spriteURL:1] cost:1];
+  XCTAssertEqualObjects(shownSprite, [[self spriteURL:1] absoluteString]);
+  XCTAssertEqual(shownThumbnail.startTime, 150.0);
+
+  // Sheets decoded ahead answer right away.
+  [loader finishLoadOfURL:[self spriteURL:2] cost:1];
+  shownSprite = nil;
+  [cache requestThumbnailForTime:250 completion:show];
+  XCTAssertEqualObjects(shownSprite, [[self spriteURL:2] absoluteString]);
+  XCTAssertEqual([cache immediateCount], (NSUInteger)1);
+  // Sheet 3 is still loading, so only sheet 4 is new.
+  XCTAssertEqual([cache loadCount], (NSUInteger)4);
+  XCTAssertEqualObjects([loader.requestedURLs lastObject], [[self spriteURL:4] absoluteString]);
+}
+
+- (void)testOnlyLatestRequestIsAnswered {
+  GMFThumbnailIndex *index = [GMFThumbnailIndex indexWithData:[self trackWithThumbnailCount:1000]
+                                                      baseURL:_baseURL];
+  GMFScriptedSpriteLoader *loader = [[GMFScriptedSpriteLoader alloc] init];
+  GMFThumbnailCache *cache = [[GMFThumbnailCache alloc] initWithIndex:index
+                                                               loader:loader
+                                                            costLimit:10];
+  [cache setLookAheadCount:0];
+  NSMutableArray *shown = [NSMutableArray array];
+  void (^show)(id, GMFThumbnail) = ^(id sprite, GMFThumbnail thumbnail) {
+      [shown addObject:sprite];
+  };
+  [cache requestThumbnailForTime:50 completion:show];
+  [cache requestThumbnailForTime:550 completion:show];
+  [loader finishLoadOfURL:[self spriteURL:0] cost:1];
+  XCTAssertEqual([shown count], (NSUInteger)0);
+  [loader finishLoadOfURL:[self spriteURL:5] cost:1];
+  XCTAssertEqualObjects(shown, @[ [[self spriteURL:5] absoluteString] ]);
+
+  // A failed load answers nothing, and a cancelled request isn't answered.
+  [cache requestThumbnailForTime:650 completion:show];
+  [loader finishLoadOfURL:[self spriteURL:6] cost:0];
+  [cache requestThumbnailForTime:750 completion:show];
+  [cache cancelRequest];
+  [loader finishLoadOfURL:[self spriteURL:7] cost:1];
+  XCTAssertEqual([shown count], (NSUInteger)1);
+}
+
+- (void)testDecodesAheadBackwardAndStaysWithinBudget {
+  GMFThumbnailIndex *index = [GMFThumbnailIndex indexWithData:[self trackWithThumbnailCount:1000]
+                                                      baseURL:_baseURL];
+  GMFScriptedSpriteLoader *loader = [[GMFScriptedSpriteLoader alloc] init];
+  GMFThumbnailCache *cache = [[GMFThumbnailCache alloc] initWithIndex:index
+                                                               loader:loader
+                                                            costLimit:3];
+  void (^ignore)(id, GMFThumbnail) = ^(id sprite, GMFThumbnail thumbnail) {};
+  [cache requestThumbnailForTime:950 completion:ignore];
+  [cache requestThumbnailForTime:850 completion:ignore];
+  // Moving backward from sheet 8, sheets 7 and 6 are decoded ahead.
+  NSArray *lastTwo = [loader.requestedURLs subarrayWithRange:NSMakeRange(
+      [loader.requestedURLs count] - 2, 2)];
+  XCTAssertEqualObjects(lastTwo, (@[ [[self spriteURL:7] absoluteString],
+                                    [[self spriteURL:6] absoluteString] ]));
+
+  for (NSString *URL in [loader.requestedURLs copy]) {
+    [loader finishLoadOfURL:[NSURL URLWithString:URL] cost:1];
+  }
+  XCTAssertLessThanOrEqual([[cache sprites] totalCost], (NSUInteger)3);
+  XCTAssertGreaterThan([[cache sprites] evictionCount], (NSUInteger)0);
+}
+
+#pragma mark Benchmarks
+
+- (void)testHourLongTrackParseAndLookup {
+  NSData *data = [self trackWithThumbnailCount:kHourThumbnailCount];
+  __block GMFThumbnailIndex *index = nil;
+  [self measureBlock:^{
+      index = [GMFThumbnailIndex indexWithData:data baseURL:_baseURL];
+  }];
+  XCTAssertEqual([index thumbnailCount], kHourThumbnailCount);
+  XCTAssertEqual([index spriteCount], kHourThumbnailCount / kTilesPerSprite);
+
+  NSUInteger checksum = 0;
+  CFTimeInterval start = CFAbsoluteTimeGetCurrent();
+  for (NSUInteger i = 0; i < kBenchmarkLookupCount; i++) {
+    checksum += [index thumbnailIndexForTime:(i * 7919) % kHourThumbnailCount + 0.5];
+  }
+  CFTimeInterval elapsed = CFAbsoluteTimeGetCurrent() - start;
+  NSLog(@"GMFThumbnailIndex: %.1f ns per lookup", elapsed * 1e9 / kBenchmarkLookupCount);
+  XCTAssertGreaterThan(checksum, (NSUInteger)0);
+}
+
+@end
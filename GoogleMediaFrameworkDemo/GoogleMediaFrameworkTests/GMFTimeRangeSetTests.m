@@ -0,0 +1,201 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFTimeRangeSet.h>
+
+// Number of disjoint ranges in the benchmark set: one 1 second range every 2 seconds.
+static const NSUInteger kBenchmarkRangeCount = 5000;
+static const NSUInteger kBenchmarkQueries = 2000;
+
+@interface GMFTimeRangeSetTests : XCTestCase
+@end
+
+@implementation GMFTimeRangeSetTests {
+ @private
+  GMFTimeRangeSet *_set;
+}
+
+- (void)setUp {
+  [super setUp];
+  _set = [[GMFTimeRangeSet alloc] init];
+}
+
+- (void)tearDown {
+  _set = nil;
+  [super tearDown];
+}
+
+- (void)assertRangeAtIndex:(NSUInteger)index start:(NSTimeInterval)start end:(NSTimeInterval)end {
+  GMFTimeRange range = [_set rangeAtIndex:index];
+  XCTAssertEqual(range.start, start, @"start of range %lu", (unsigned long)index);
+  XCTAssertEqual(range.end, end, @"end of range %lu", (unsigned long)index);
+}
+
+- (void)testAddKeepsRangesSortedAndDisjoint {
+  [_set addRange:GMFTimeRangeMake(20, 30)];
+  [_set addRange:GMFTimeRangeMake(0, 5)];
+  [_set addRange:GMFTimeRangeMake(10, 12)];
+  [_set addRange:GMFTimeRangeMake(7, 7)];
+
+  XCTAssertEqual([_set count], 3);
+  [self assertRangeAtIndex:0 start:0 end:5];
+  [self assertRangeAtIndex:1 start:10 end:12];
+  [self assertRangeAtIndex:2 start:20 end:30];
+}
+
+- (void)testAddMergesOverlappingAndTouchingRanges {
+  [_set addRange:GMFTimeRangeMake(0, 5)];
+  [_set addRange:GMFTimeRangeMake(10, 12)];
+  [_set addRange:GMFTimeRangeMake(20, 30)];
+
+  [_set addRange:GMFTimeRangeMake(5, 11)];
+  XCTAssertEqual([_set count], 2);
+  [self assertRangeAtIndex:0 start:0 end:12];
+
+  [_set addRange:GMFTimeRangeMake(-1, 40)];
+  XCTAssertEqual([_set count], 1);
+  [self assertRangeAtIndex:0 start:-1 end:40];
+}
+
+- (void)testRemoveSplitsAndTrimsRanges {
+  [_set addRange:GMFTimeRangeMake(0, 10)];
+  [_set addRange:GMFTimeRangeMake(20, 30)];
+
+  [_set removeRange:GMFTimeRangeMake(4, 6)];
+  XCTAssertEqual([_set count], 3);
+  [self assertRangeAtIndex:0 start:0 end:4];
+  [self assertRangeAtIndex:1 start:6 end:10];
+
+  [_set removeRange:GMFTimeRangeMake(8, 25)];
+  XCTAssertEqual([_set count], 3);
+  [self assertRangeAtIndex:1 start:6 end:8];
+  [self assertRangeAtIndex:2 start:25 end:30];
+
+  [_set removeRange:GMFTimeRangeMake(0, 30)];
+  XCTAssertEqual([_set count], 0);
+}
+
+- (void)testQueries {
+  [_set addRange:GMFTimeRangeMake(0, 10)];
+  [_set addRange:GMFTimeRangeMake(20, 30)];
+
+  XCTAssertTrue([_set containsTime:0]);
+  XCTAssertTrue([_set containsTime:25]);
+  XCTAssertFalse([_set containsTime:10]);
+  XCTAssertFalse([_set containsTime:-1]);
+
+  XCTAssertEqual([_set endOfRangeContainingTime:22], 30);
+  XCTAssertTrue(isnan([_set endOfRangeContainingTime:15]));
+
+  XCTAssertEqual([_set durationAheadOfTime:4], 6);
+  XCTAssertEqual([_set durationAheadOfTime:15], 0);
+
+  XCTAssertEqual([_set nextGapAfterTime:4], 10);
+  XCTAssertEqual([_set nextGapAfterTime:15], 15);
+
+  XCTAssertEqual([_set totalDuration], 20);
+}
+
+- (void)testSetRangesNormalizesAndReportsChanges {
+  GMFTimeRange ranges[] = {
+    GMFTimeRangeMake(20, 30), GMFTimeRangeMake(0, 5), GMFTimeRangeMake(3, 8)
+  };
+
+  XCTAssertTrue([_set setRanges:ranges count:3]);
+  XCTAssertEqual([_set count], 2);
+  [self assertRangeAtIndex:0 start:0 end:8];
+  [self assertRangeAtIndex:1 start:20 end:30];
+
+  XCTAssertFalse([_set setRanges:ranges count:3]);
+  XCTAssertTrue([_set setRanges:ranges count:2]);
+  XCTAssertTrue([_set setRanges:NULL count:0]);
+  XCTAssertEqual([_set count], 0);
+}
+
+- (void)testCopyIsIndependent {
+  [_set addRange:GMFTimeRangeMake(0, 10)];
+  GMFTimeRangeSet *copy = [_set copy];
+  [_set removeRange:GMFTimeRangeMake(0, 5)];
+
+  XCTAssertEqual([copy endOfRangeContainingTime:1], 10);
+  XCTAssertFalse([copy isEqual:_set]);
+}
+
+#pragma mark Benchmarks
+
+- (void)testBenchmarkBuildByAddingRanges {
+  [self measureBlock:^{
+      GMFTimeRangeSet *set = [[GMFTimeRangeSet alloc] init];
+      // Add out of order so most insertions land in the middle of the array.
+      for (NSUInteger i = 0; i < kBenchmarkRangeCount; i++) {
+        NSUInteger slot = (i * 7919) % kBenchmarkRangeCount;
+        [set addRange:GMFTimeRangeMake(slot * 2, slot * 2 + 1)];
+      }
+      XCTAssertEqual([set count], kBenchmarkRangeCount);
+  }];
+}
+
+- (void)testBenchmarkBufferedEndQueries {
+  [self fillBenchmarkRanges];
+  [self measureBlock:^{
+      NSTimeInterval sink = 0;
+      for (NSUInteger i = 0; i < kBenchmarkQueries; i++) {
+        NSTimeInterval end = [_set endOfRangeContainingTime:[self benchmarkQueryTime:i]];
+        if (!isnan(end)) {
+          sink += end;
+        }
+      }
+      XCTAssertTrue(sink > 0);
+  }];
+}
+
+// Baseline: the boxed-value linear scan GMFVideoPlayer used before GMFTimeRangeSet.
+- (void)testBenchmarkBufferedEndQueriesByScanningBoxedRanges {
+  [self fillBenchmarkRanges];
+  NSMutableArray *boxedRanges = [NSMutableArray arrayWithCapacity:kBenchmarkRangeCount];
+  for (NSUInteger i = 0; i < [_set count]; i++) {
+    GMFTimeRange range = [_set rangeAtIndex:i];
+    [boxedRanges addObject:[NSValue valueWithBytes:&range objCType:@encode(GMFTimeRange)]];
+  }
+  [self measureBlock:^{
+      NSTimeInterval sink = 0;
+      for (NSUInteger i = 0; i < kBenchmarkQueries; i++) {
+        NSTimeInterval time = [self benchmarkQueryTime:i];
+        for (NSValue *value in [boxedRanges copy]) {
+          GMFTimeRange range;
+          [value getValue:&range];
+          if (time >= range.start && time < range.end) {
+            sink += range.end;
+            break;
+          }
+        }
+      }
+      XCTAssertTrue(sink > 0);
+  }];
+}
+
+- (void)fillBenchmarkRanges {
+  for (NSUInteger i = 0; i < kBenchmarkRangeCount; i++) {
+    [_set addRange:GMFTimeRangeMake(i * 2, i * 2 + 1)];
+  }
+}
+
+// Spreads queries over the whole set, hitting both ranges and gaps.
+- (NSTimeInterval)benchmarkQueryTime:(NSUInteger)query {
+  return (query * 104729) % (kBenchmarkRangeCount * 4) / 2.0;
+}
+
+@end
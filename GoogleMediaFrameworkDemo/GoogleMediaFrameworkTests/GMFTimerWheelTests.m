@@ -0,0 +1,213 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFTimerWheel.h>
+#import <GoogleMediaFramework/GMFVirtualClock.h>
+
+// Timers per measured block.
+static const NSUInteger kBenchmarkTimerCount = 1000;
+
+@interface GMFTimerWheelTests : XCTestCase
+@end
+
+@implementation GMFTimerWheelTests {
+ @private
+  GMFVirtualClock *_clock;
+  GMFTimerWheel *_wheel;
+  NSMutableArray *_firedTimes;
+}
+
+- (void)setUp {
+  [super setUp];
+  _clock = [[GMFVirtualClock alloc] init];
+  // One turn is 0.8 seconds.
+  _wheel = [[GMFTimerWheel alloc] initWithClock:_clock resolution:0.1 slotCount:8];
+  _firedTimes = [NSMutableArray array];
+}
+
+// Schedules a timer that records the delay it was given.
+- (id)scheduleRecordingTimerAfterDelay:(NSTimeInterval)delay {
+  NSMutableArray *firedTimes = _firedTimes;
+  return [_wheel scheduleBlock:^{
+      [firedTimes addObject:@(delay)];
+  } afterDelay:delay];
+}
+
+- (void)testTimersRunInDeadlineOrder {
+  [self scheduleRecordingTimerAfterDelay:0.35];
+  [self scheduleRecordingTimerAfterDelay:0.05];
+  [self scheduleRecordingTimerAfterDelay:0.3];
+  [self scheduleRecordingTimerAfterDelay:0.3];
+  XCTAssertEqual([_wheel timerCount], (NSUInteger)4);
+  // The wheel keeps a single timer of the clock.
+  XCTAssertEqual([_clock pendingCount], (NSUInteger)1);
+
+  [_clock advanceBy:1];
+  XCTAssertEqualObjects(_firedTimes, (@[ @0.05, @0.3, @0.3, @0.35 ]));
+  XCTAssertEqual([_wheel timerCount], (NSUInteger)0);
+  XCTAssertEqual([_wheel firedCount], (NSUInteger)4);
+  XCTAssertEqual([_wheel wakeupCount], (NSUInteger)3);
+  XCTAssertEqual([_clock pendingCount], (NSUInteger)0);
+}
+
+- (void)testTimersNeverRunEarlyAndAtMostOneSlotLate {
+  __block NSTimeInterval firedAt = -1;
+  [_wheel scheduleBlock:^{
+      firedAt = [_clock now];
+  } afterDelay:0.25];
+  [_clock advanceBy:0.25];
+  XCTAssertEqual(firedAt, -1.0);
+  [_clock advanceBy:0.1];
+  XCTAssertEqualWithAccuracy(firedAt, 0.3, 1e-9);
+
+  // Nothing is waiting, so a later timer is timed from now rather than from the last wakeup.
+  [_clock advanceBy:10];
+  [_wheel scheduleBlock:^{
+      firedAt = [_clock now];
+  } afterDelay:0];
+  [_clock advanceBy:1];
+  XCTAssertEqualWithAccuracy(firedAt, 10.4, 1e-9);
+}
+
+- (void)testTimersInOneSlotShareAWakeup {
+  for (NSUInteger i = 0; i < kBenchmarkTimerCount; i++) {
+    [self scheduleRecordingTimerAfterDelay:i * 0.001];
+  }
+  [_clock advanceBy:2];
+  XCTAssertEqual([_firedTimes count], kBenchmarkTimerCount);
+  XCTAssertEqualObjects(_firedTimes,
+                        [_firedTimes sortedArrayUsingSelector:@selector(compare:)]);
+  // Deadlines from 0 to 0.999 seconds fall into 10 slots.
+  XCTAssertEqual([_wheel wakeupCount], (NSUInteger)10);
+  XCTAssertEqual([_clock firedCount], (NSUInteger)10);
+}
+
+- (void)testCancelledTimersDontRun {
+  id first = [self scheduleRecordingTimerAfterDelay:0.1];
+  [self scheduleRecordingTimerAfterDelay:0.1];
+  id third = [self scheduleRecordingTimerAfterDelay:0.5];
+  [_wheel cancelScheduledBlock:first];
+  [_wheel cancelScheduledBlock:first];
+  [_wheel cancelScheduledBlock:nil];
+  XCTAssertEqual([_wheel timerCount], (NSUInteger)2);
+
+  [_clock advanceBy:0.2];
+  XCTAssertEqualObjects(_firedTimes, (@[ @0.1 ]));
+  // Cancelling the last timer also drops the clock's timer.
+  [_wheel cancelScheduledBlock:third];
+  XCTAssertEqual([_clock pendingCount], (NSUInteger)0);
+  [_clock advanceBy:1];
+  XCTAssertEqual([_firedTimes count], (NSUInteger)1);
+  XCTAssertEqual([_wheel wakeupCount], (NSUInteger)1);
+}
+
+- (void)testTimersBeyondOneTurn {
+  // Ticks 21 and 5 share slot 5.
+  [self scheduleRecordingTimerAfterDelay:2.05];
+  [self scheduleRecordingTimerAfterDelay:0.45];
+  [self scheduleRecordingTimerAfterDelay:0.25];
+
+  [_clock advanceBy:1];
+  XCTAssertEqualObjects(_firedTimes, (@[ @0.25, @0.45 ]));
+  XCTAssertEqual([_wheel timerCount], (NSUInteger)1);
+  [_clock advanceBy:1];
+  XCTAssertEqual([_firedTimes count], (NSUInteger)2);
+  [_clock advanceBy:1];
+  XCTAssertEqualObjects(_firedTimes, (@[ @0.25, @0.45, @2.05 ]));
+  // No wakeup for the turns the far timer waited through.
+  XCTAssertEqual([_wheel wakeupCount], (NSUInteger)3);
+}
+
+- (void)testTimersCanScheduleAndCancelFromTheirBlocks {
+  __block id cancelled = nil;
+  GMFTimerWheel *wheel = _wheel;
+  NSMutableArray *firedTimes = _firedTimes;
+  [_wheel scheduleBlock:^{
+      [firedTimes addObject:@"first"];
+      [wheel cancelScheduledBlock:cancelled];
+      [wheel scheduleBlock:^{
+          [firedTimes addObject:@"rescheduled"];
+      } afterDelay:0];
+  } afterDelay:0.1];
+  // Due in the same wakeup as the first, but cancelled by it.
+  cancelled = [self scheduleRecordingTimerAfterDelay:0.1];
+
+  [_clock advanceBy:0.1];
+  XCTAssertEqualObjects(_firedTimes, (@[ @"first" ]));
+  [_clock advanceBy:0.1];
+  XCTAssertEqualObjects(_firedTimes, (@[ @"first", @"rescheduled" ]));
+  XCTAssertEqual([_wheel firedCount], (NSUInteger)2);
+}
+
+- (void)testSlotCountIsRoundedUpToAPowerOfTwo {
+  GMFTimerWheel *wheel = [[GMFTimerWheel alloc] initWithClock:_clock resolution:0.1 slotCount:100];
+  XCTAssertEqual([wheel slotCount], (NSUInteger)128);
+  XCTAssertEqual([[GMFTimerWheel sharedWheel] slotCount], kGMFTimerWheelDefaultSlotCount);
+}
+
+#pragma mark Benchmarks
+
+// Arms and disarms 1000 timers, e.g. one auto-hide or watchdog per player in a long feed.
+- (void)testWheelSchedulesAndCancels1000Timers {
+  GMFTimerWheel *wheel = [[GMFTimerWheel alloc] initWithClock:[GMFRunLoopClock sharedClock]];
+  NSMutableArray *handles = [NSMutableArray arrayWithCapacity:kBenchmarkTimerCount];
+  [self measureBlock:^{
+      for (NSUInteger i = 0; i < kBenchmarkTimerCount; i++) {
+        [handles addObject:[wheel scheduleBlock:^{} afterDelay:1 + (i % 300) * 0.01]];
+      }
+      for (id handle in handles) {
+        [wheel cancelScheduledBlock:handle];
+      }
+      [handles removeAllObjects];
+  }];
+}
+
+- (void)testRunLoopClockSchedulesAndCancels1000Timers {
+  GMFRunLoopClock *clock = [GMFRunLoopClock sharedClock];
+  NSMutableArray *handles = [NSMutableArray arrayWithCapacity:kBenchmarkTimerCount];
+  [self measureBlock:^{
+      for (NSUInteger i = 0; i < kBenchmarkTimerCount; i++) {
+        [handles addObject:[clock scheduleBlock:^{} afterDelay:1 + (i % 300) * 0.01]];
+      }
+      for (id handle in handles) {
+        [clock cancelScheduledBlock:handle];
+      }
+      [handles removeAllObjects];
+  }];
+}
+
+// Runs 1000 timers spread over five seconds in virtual time, rescheduling each as it fires like a
+// repeating tick.
+- (void)testWheelFires1000Timers {
+  [self measureBlock:^{
+      GMFVirtualClock *clock = [[GMFVirtualClock alloc] init];
+      GMFTimerWheel *wheel = [[GMFTimerWheel alloc] initWithClock:clock];
+      __block NSUInteger fired = 0;
+      for (NSUInteger i = 0; i < kBenchmarkTimerCount; i++) {
+        [wheel scheduleBlock:^{
+            fired++;
+            [wheel scheduleBlock:^{
+                fired++;
+            } afterDelay:0.2];
+        } afterDelay:(i % 500) * 0.01];
+      }
+      [clock advanceBy:6];
+      XCTAssertEqual(fired, 2 * kBenchmarkTimerCount);
+      XCTAssertLessThan([wheel wakeupCount], kBenchmarkTimerCount);
+  }];
+}
+
+@end
@@ -0,0 +1,175 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <mach/mach_time.h>
+
+#import <GoogleMediaFramework/GMFTrace.h>
+
+// Beyond every level, so always compiled out.
+static const int kCompiledOutLevel = GMF_TRACE_LEVEL_VERBOSE + 1;
+
+static const NSUInteger kBenchmarkEventCount = 1000000;
+
+@interface GMFTraceTests : XCTestCase
+@end
+
+@implementation GMFTraceTests {
+ @private
+  GMFTraceEvent *_events;
+}
+
+- (void)setUp {
+  [super setUp];
+  _events = malloc(kGMFTraceCapacity * sizeof(GMFTraceEvent));
+  GMFTraceSetEnabled(YES);
+  GMFTraceReset();
+}
+
+- (void)tearDown {
+  free(_events);
+  GMFTraceSetEnabled(YES);
+  GMFTraceReset();
+  [super tearDown];
+}
+
+- (NSUInteger)copyEvents {
+  return GMFTraceCopyEvents(_events, kGMFTraceCapacity);
+}
+
+- (void)traceInScope {
+  GMF_TRACE_SCOPE(GMF_TRACE_LEVEL_INFO, "test.scope");
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "test.inside", 7);
+}
+
+- (void)testEventsAreRecordedInOrder {
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "test.first", 1);
+  GMF_TRACE_COUNTER(GMF_TRACE_LEVEL_INFO, "test.counter", 42);
+  [self traceInScope];
+
+  XCTAssertEqual([self copyEvents], (NSUInteger)5);
+  XCTAssertEqual(GMFTraceRecordedCount(), (uint64_t)5);
+  XCTAssertEqual(strcmp(_events[0].name, "test.first"), 0);
+  XCTAssertEqual(_events[0].phase, kGMFTracePhaseInstant);
+  XCTAssertEqual(_events[1].phase, kGMFTracePhaseCounter);
+  XCTAssertEqual(_events[1].value, (int64_t)42);
+  XCTAssertEqual(_events[2].phase, kGMFTracePhaseBegin);
+  XCTAssertEqual(_events[3].value, (int64_t)7);
+  XCTAssertEqual(_events[4].phase, kGMFTracePhaseEnd);
+  XCTAssertEqual(strcmp(_events[4].name, "test.scope"), 0);
+  for (NSUInteger i = 1; i < 5; i++) {
+    XCTAssertGreaterThanOrEqual(_events[i].timestamp, _events[i - 1].timestamp);
+  }
+}
+
+- (void)testRingKeepsMostRecentEvents {
+  NSUInteger total = kGMFTraceCapacity + 100;
+  for (NSUInteger i = 0; i < total; i++) {
+    GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "test.event", i);
+  }
+  XCTAssertEqual(GMFTraceRecordedCount(), (uint64_t)total);
+  XCTAssertEqual([self copyEvents], (NSUInteger)kGMFTraceCapacity);
+  XCTAssertEqual(_events[0].value, (int64_t)100);
+  XCTAssertEqual(_events[kGMFTraceCapacity - 1].value, (int64_t)(total - 1));
+
+  // Fewer than asked for come back oldest first too.
+  GMFTraceEvent lastTwo[2];
+  XCTAssertEqual(GMFTraceCopyEvents(lastTwo, 2), (NSUInteger)2);
+  XCTAssertEqual(lastTwo[0].value, (int64_t)(total - 2));
+  XCTAssertEqual(lastTwo[1].value, (int64_t)(total - 1));
+}
+
+- (void)testGating {
+  GMF_TRACE_INSTANT(kCompiledOutLevel, "test.compiledOut", 1);
+  XCTAssertEqual(GMFTraceRecordedCount(), (uint64_t)0);
+
+  GMFTraceSetEnabled(NO);
+  GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "test.disabled", 1);
+  XCTAssertFalse(GMFTraceIsEnabled());
+  XCTAssertEqual(GMFTraceRecordedCount(), (uint64_t)0);
+  GMFTraceSetEnabled(YES);
+
+  // Only the main thread writes.
+  dispatch_sync(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+      GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "test.background", 1);
+  });
+  XCTAssertEqual(GMFTraceRecordedCount(), (uint64_t)0);
+}
+
+- (void)testReaderOnAnotherThreadSeesOrderedEvents {
+  __block volatile BOOL done = NO;
+  __block NSUInteger misordered = 0;
+  dispatch_semaphore_t finished = dispatch_semaphore_create(0);
+  dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+      GMFTraceEvent *events = malloc(kGMFTraceCapacity * sizeof(GMFTraceEvent));
+      while (!done) {
+        NSUInteger count = GMFTraceCopyEvents(events, kGMFTraceCapacity);
+        for (NSUInteger i = 1; i < count; i++) {
+          if (events[i].value != events[i - 1].value + 1) {
+            misordered++;
+          }
+        }
+      }
+      free(events);
+      dispatch_semaphore_signal(finished);
+  });
+  for (NSUInteger i = 0; i < 20 * kGMFTraceCapacity; i++) {
+    GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "test.event", i);
+  }
+  done = YES;
+  dispatch_semaphore_wait(finished, DISPATCH_TIME_FOREVER);
+  XCTAssertEqual(misordered, (NSUInteger)0);
+}
+
+- (void)testChromeTraceExport {
+  [self traceInScope];
+  GMF_TRACE_COUNTER(GMF_TRACE_LEVEL_INFO, "test.counter", 3);
+
+  NSDictionary *trace = [NSJSONSerialization JSONObjectWithData:[GMFTraceExporter chromeTraceData]
+                                                        options:0
+                                                          error:NULL];
+  NSArray *events = [trace objectForKey:@"traceEvents"];
+  XCTAssertEqual([events count], (NSUInteger)4);
+  NSDictionary *begin = [events objectAtIndex:0];
+  XCTAssertEqualObjects([begin objectForKey:@"name"], @"test.scope");
+  XCTAssertEqualObjects([begin objectForKey:@"cat"], @"test");
+  XCTAssertEqualObjects([begin objectForKey:@"ph"], @"B");
+  XCTAssertEqualObjects([begin objectForKey:@"ts"], @0);
+  NSDictionary *instant = [events objectAtIndex:1];
+  XCTAssertEqualObjects([instant objectForKey:@"ph"], @"i");
+  XCTAssertEqualObjects([[instant objectForKey:@"args"] objectForKey:@"value"], @7);
+  XCTAssertEqualObjects([[events objectAtIndex:2] objectForKey:@"ph"], @"E");
+  XCTAssertEqualObjects([[events objectAtIndex:3] objectForKey:@"ph"], @"C");
+  XCTAssertGreaterThanOrEqual([[[events objectAtIndex:3] objectForKey:@"ts"] doubleValue], 0);
+
+  NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GMFTraceTests.json"];
+  XCTAssertTrue([GMFTraceExporter writeChromeTraceToPath:path error:NULL]);
+  [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)testRecordingCost {
+  mach_timebase_info_data_t timebase;
+  mach_timebase_info(&timebase);
+  [self measureBlock:^{
+      uint64_t start = mach_absolute_time();
+      for (NSUInteger i = 0; i < kBenchmarkEventCount; i++) {
+        GMF_TRACE_INSTANT(GMF_TRACE_LEVEL_INFO, "test.benchmark", i);
+      }
+      double nanoseconds = (double)(mach_absolute_time() - start) * timebase.numer / timebase.denom;
+      NSLog(@"GMFTraceRecord: %.1f ns per event", nanoseconds / kBenchmarkEventCount);
+  }];
+}
+
+@end
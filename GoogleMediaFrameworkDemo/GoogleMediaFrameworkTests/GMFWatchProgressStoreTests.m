@@ -0,0 +1,205 @@
+// Copyright 2026 Google Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#import <XCTest/XCTest.h>
+
+#import <GoogleMediaFramework/GMFWatchProgressStore.h>
+
+// Titles in the benchmarks.
+static const NSUInteger kBenchmarkTitleCount = 100000;
+
+// Sizes of the log header and of a record, per the format in GMFWatchProgressStore.h.
+static const unsigned long long kLogHeaderSize = 32;
+static const unsigned long long kLogRecordSize = 32;
+
+@interface GMFWatchProgressStoreTests : XCTestCase
+@end
+
+@implementation GMFWatchProgressStoreTests {
+ @private
+  NSString *_directory;
+  NSString *_path;
+}
+
+- (void)setUp {
+  [super setUp];
+  _directory = [NSTemporaryDirectory() stringByAppendingPathComponent:
+      [NSString stringWithFormat:@"GMFWatchProgressStoreTests-%@", [[NSUUID UUID] UUIDString]]];
+  [[NSFileManager defaultManager] createDirectoryAtPath:_directory
+                            withIntermediateDirectories:YES
+                                             attributes:nil
+                                                  error:NULL];
+  _path = [_directory stringByAppendingPathComponent:@"progress.log"];
+}
+
+- (void)tearDown {
+  [[NSFileManager defaultManager] removeItemAtPath:_directory error:NULL];
+  [super tearDown];
+}
+
+- (void)compactAndWait:(GMFWatchProgressStore *)store {
+  __block BOOL done = NO;
+  [store compactWithCompletion:^{
+      done = YES;
+  }];
+  NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:5];
+  while (!done && [deadline timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode
+                             beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+  }
+  XCTAssertTrue(done);
+}
+
+- (NSArray *)contentIDsWithCount:(NSUInteger)count {
+  NSMutableArray *contentIDs = [NSMutableArray arrayWithCapacity:count];
+  for (NSUInteger i = 0; i < count; i++) {
+    [contentIDs addObject:[NSString stringWithFormat:@"https://example.com/title%lu.m3u8",
+                                                     (unsigned long)i]];
+  }
+  return contentIDs;
+}
+
+- (void)testPositionsSurviveReopening {
+  NSTimeInterval before = [NSDate timeIntervalSinceReferenceDate];
+  GMFWatchProgressStore *store = [[GMFWatchProgressStore alloc] initWithPath:_path];
+  [store setPosition:12.5 forContentID:@"a"];
+  [store setPosition:30 forContentID:@"b"];
+  [store setPosition:40 forContentID:@"a"];
+  [store removePositionForContentID:@"b"];
+  XCTAssertEqual([store count], (NSUInteger)1);
+  XCTAssertEqual([store positionForContentID:@"a"], 40.0);
+  store = nil;
+
+  store = [[GMFWatchProgressStore alloc] initWithPath:_path];
+  XCTAssertEqual([store count], (NSUInteger)1);
+  XCTAssertEqual([store recordCount], (NSUInteger)4);
+  NSTimeInterval position = 0;
+  NSTimeInterval timestamp = 0;
+  XCTAssertTrue([store getPosition:&position timestamp:&timestamp forContentID:@"a"]);
+  XCTAssertEqual(position, 40.0);
+  XCTAssertGreaterThanOrEqual(timestamp, before);
+  XCTAssertLessThanOrEqual(timestamp, [NSDate timeIntervalSinceReferenceDate]);
+  XCTAssertFalse([store getPosition:&position timestamp:NULL forContentID:@"b"]);
+  XCTAssertEqual([store positionForContentID:@"never watched"], 0.0);
+}
+
+- (void)testTornRecordIsIgnored {
+  GMFWatchProgressStore *store = [[GMFWatchProgressStore alloc] initWithPath:_path];
+  [store setPosition:1 forContentID:@"a"];
+  [store setPosition:2 forContentID:@"b"];
+  store = nil;
+  // Half a third record, as if the app died while writing it.
+  NSFileHandle *file = [NSFileHandle fileHandleForWritingAtPath:_path];
+  uint8_t garbage[16];
+  memset(garbage, 0xab, sizeof(garbage));
+  [file seekToFileOffset:kLogHeaderSize + 2 * kLogRecordSize];
+  [file writeData:[NSData dataWithBytes:garbage length:sizeof(garbage)]];
+  [file closeFile];
+
+  store = [[GMFWatchProgressStore alloc] initWithPath:_path];
+  XCTAssertEqual([store recordCount], (NSUInteger)2);
+  XCTAssertEqual([store positionForContentID:@"b"], 2.0);
+  [store setPosition:3 forContentID:@"c"];
+  store = nil;
+
+  store = [[GMFWatchProgressStore alloc] initWithPath:_path];
+  XCTAssertEqual([store count], (NSUInteger)3);
+  XCTAssertEqual([store positionForContentID:@"c"], 3.0);
+}
+
+- (void)testFileThatIsNotALogIsReplaced {
+  [[@"not a log" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:_path atomically:YES];
+  GMFWatchProgressStore *store = [[GMFWatchProgressStore alloc] initWithPath:_path];
+  XCTAssertNotNil(store);
+  XCTAssertEqual([store count], (NSUInteger)0);
+  [store setPosition:5 forContentID:@"a"];
+  store = nil;
+  store = [[GMFWatchProgressStore alloc] initWithPath:_path];
+  XCTAssertEqual([store positionForContentID:@"a"], 5.0);
+}
+
+- (void)testLogGrows {
+  NSArray *contentIDs = [self contentIDsWithCount:10000];
+  GMFWatchProgressStore *store = [[GMFWatchProgressStore alloc] initWithPath:_path];
+  [contentIDs enumerateObjectsUsingBlock:^(NSString *contentID, NSUInteger i, BOOL *stop) {
+      [store setPosition:i forContentID:contentID];
+  }];
+  store = nil;
+
+  store = [[GMFWatchProgressStore alloc] initWithPath:_path];
+  XCTAssertEqual([store count], [contentIDs count]);
+  XCTAssertEqual([store positionForContentID:[contentIDs lastObject]], 9999.0);
+  XCTAssertEqual([store compactionCount], (NSUInteger)0);
+}
+
+- (void)testCompactionKeepsLatestPositions {
+  NSArray *contentIDs = [self contentIDsWithCount:10];
+  GMFWatchProgressStore *store = [[GMFWatchProgressStore alloc] initWithPath:_path];
+  // Compaction starts on its own partway through; the updates after that are carried over.
+  for (NSUInteger update = 0; update < 500; update++) {
+    for (NSString *contentID in contentIDs) {
+      [store setPosition:update forContentID:contentID];
+    }
+  }
+  XCTAssertTrue([store isCompacting]);
+  [self compactAndWait:store];
+  XCTAssertEqual([store compactionCount], (NSUInteger)1);
+  XCTAssertLessThan([store recordCount], (NSUInteger)5000);
+  XCTAssertEqual([store positionForContentID:[contentIDs firstObject]], 499.0);
+
+  [store removePositionForContentID:[contentIDs lastObject]];
+  [self compactAndWait:store];
+  XCTAssertEqual([store recordCount], (NSUInteger)9);
+  store = nil;
+
+  store = [[GMFWatchProgressStore alloc] initWithPath:_path];
+  XCTAssertEqual([store count], (NSUInteger)9);
+  XCTAssertEqual([store recordCount], (NSUInteger)9);
+  XCTAssertEqual([store positionForContentID:[contentIDs firstObject]], 499.0);
+  XCTAssertFalse([store getPosition:NULL timestamp:NULL forContentID:[contentIDs lastObject]]);
+  XCTAssertFalse([[NSFileManager defaultManager]
+      fileExistsAtPath:[_path stringByAppendingString:@".compacting"]]);
+}
+
+#pragma mark Benchmarks
+
+// One update per media time callback, across 100k titles.
+- (void)testWriteThroughputWith100kTitles {
+  NSArray *contentIDs = [self contentIDsWithCount:kBenchmarkTitleCount];
+  __block NSUInteger run = 0;
+  [self measureBlock:^{
+      NSString *path = [_path stringByAppendingFormat:@".%lu", (unsigned long)run++];
+      GMFWatchProgressStore *store = [[GMFWatchProgressStore alloc] initWithPath:path];
+      [contentIDs enumerateObjectsUsingBlock:^(NSString *contentID, NSUInteger i, BOOL *stop) {
+          [store setPosition:i forContentID:contentID];
+      }];
+      XCTAssertEqual([store count], kBenchmarkTitleCount);
+  }];
+}
+
+// Opening the store at launch, with 100k titles in the log.
+- (void)testIndexRebuildWith100kTitles {
+  NSArray *contentIDs = [self contentIDsWithCount:kBenchmarkTitleCount];
+  GMFWatchProgressStore *store = [[GMFWatchProgressStore alloc] initWithPath:_path];
+  [contentIDs enumerateObjectsUsingBlock:^(NSString *contentID, NSUInteger i, BOOL *stop) {
+      [store setPosition:i forContentID:contentID];
+  }];
+  store = nil;
+  [self measureBlock:^{
+      GMFWatchProgressStore *reopened = [[GMFWatchProgressStore alloc] initWithPath:_path];
+      XCTAssertEqual([reopened count], kBenchmarkTitleCount);
+  }];
+}
+
+@end